@@ -15,25 +15,6 @@ inline static std::wstring StringifyValueList(const KatanaArray* oValues);
 inline static std::wstring StringifyValue(const KatanaValue* oValue);
 inline static bool         IsTableElement(const std::wstring& wsNameTag);
 
-bool operator<(const std::vector<NSCSS::CNode> &arLeftSelectors, const std::vector<NSCSS::CNode> &arRightSelectors)
-{
-	const size_t& sizeLeftSelectors = arLeftSelectors.size();
-	const size_t& sizeRightSelectors = arRightSelectors.size();
-
-	if (sizeLeftSelectors < sizeRightSelectors)
-		return true;
-	else if (sizeLeftSelectors > sizeRightSelectors)
-		return false;
-
-	for (size_t i = 0; i < arLeftSelectors.size(); ++i)
-	{
-		if (arLeftSelectors[i] < arRightSelectors[i])
-			return true;
-	}
-
-	return false;
-}
-
 namespace NSCSS
 {
 	CStyleStorage::CStyleStorage()
@@ -51,7 +32,7 @@ namespace NSCSS
 			if (nullptr == pStyleFileData)
 				continue;
 
-			for (std::map<std::wstring, CElement*>::iterator oIter = pStyleFileData->m_mStyleData.begin(); oIter != pStyleFileData->m_mStyleData.end(); ++oIter)
+			for (TStyleData::iterator oIter = pStyleFileData->m_mStyleData.begin(); oIter != pStyleFileData->m_mStyleData.end(); ++oIter)
 				if (oIter->second != nullptr)
 					delete oIter->second;
 
@@ -196,7 +177,7 @@ namespace NSCSS
 
 		for (std::vector<TStyleFileData*>::const_reverse_iterator itIter = m_arStyleFiles.crbegin(); itIter < m_arStyleFiles.crend(); ++itIter)
 		{
-			if (m_arAllowedStyleFiles.cend() == std::find(m_arAllowedStyleFiles.cbegin(), m_arAllowedStyleFiles.cend(), (*itIter)->m_wsStyleFilepath))
+			if (m_arAllowedStyleFiles.cend() == m_arAllowedStyleFiles.find((*itIter)->m_wsStyleFilepath))
 				continue;
 
 			pFoundElement = FindSelectorFromStyleData(wsSelector, (*itIter)->m_mStyleData);
@@ -208,7 +189,7 @@ namespace NSCSS
 		return nullptr;
 	}
 
-	void CStyleStorage::AddStyles(const std::string& sStyle, std::map<std::wstring, CElement*>& mStyleData)
+	void CStyleStorage::AddStyles(const std::string& sStyle, TStyleData& mStyleData)
 	{
 		if (sStyle.empty())
 			return;
@@ -220,7 +201,7 @@ namespace NSCSS
 
 	void CStyleStorage::ClearEmbeddedStyles()
 	{
-		for (std::map<std::wstring, CElement*>::iterator oIter = m_mEmbeddedStyleData.begin(); oIter != m_mEmbeddedStyleData.end(); ++oIter)
+		for (TStyleData::iterator oIter = m_mEmbeddedStyleData.begin(); oIter != m_mEmbeddedStyleData.end(); ++oIter)
 			if (oIter->second != nullptr)
 				delete oIter->second;
 
@@ -232,7 +213,7 @@ namespace NSCSS
 		m_arAllowedStyleFiles.clear();
 	}
 
-	void CStyleStorage::GetStylesheet(const KatanaStylesheet* oStylesheet, std::map<std::wstring, CElement*>& mStyleData)
+	void CStyleStorage::GetStylesheet(const KatanaStylesheet* oStylesheet, TStyleData& mStyleData)
 	{
 		for (size_t i = 0; i < oStylesheet->imports.length; ++i)
 			GetRule((KatanaRule*)oStylesheet->imports.data[i], mStyleData);
@@ -241,7 +222,7 @@ namespace NSCSS
 			GetRule((KatanaRule*)oStylesheet->rules.data[i], mStyleData);
 	}
 
-	void CStyleStorage::GetRule(const KatanaRule* oRule, std::map<std::wstring, CElement*>& mStyleData)
+	void CStyleStorage::GetRule(const KatanaRule* oRule, TStyleData& mStyleData)
 	{
 		if ( NULL == oRule )
 			return;
@@ -257,7 +238,7 @@ namespace NSCSS
 		}
 	}
 
-	void CStyleStorage::GetStyleRule(const KatanaStyleRule* oRule, std::map<std::wstring, CElement*>& mStyleData)
+	void CStyleStorage::GetStyleRule(const KatanaStyleRule* oRule, TStyleData& mStyleData)
 	{
 		if (oRule->declarations->length == 0)
 			return;
@@ -289,7 +270,7 @@ namespace NSCSS
 					{
 						if (NULL == oFirstElement && bCreateFirst)
 						{
-							const std::map<std::wstring, CElement*>::const_iterator& oFindId = mStyleData.find(sId);
+							const TStyleData::const_iterator& oFindId = mStyleData.find(sId);
 							if (oFindId != mStyleData.end())
 							{
 								oIdElement = oFindId->second;
@@ -318,7 +299,7 @@ namespace NSCSS
 					{
 						if (NULL == oFirstElement && bCreateFirst)
 						{
-							const std::map<std::wstring, CElement*>::const_iterator& oFindClass = mStyleData.find(sClass);
+							const TStyleData::const_iterator& oFindClass = mStyleData.find(sClass);
 							if (oFindClass != mStyleData.end())
 							{
 								oClassElement = oFindClass->second;
@@ -351,7 +332,7 @@ namespace NSCSS
 					{
 						if (NULL == oFirstElement && bCreateFirst)
 						{
-							const std::map<std::wstring, CElement*>::const_iterator& oFindName = mStyleData.find(sName);
+							const TStyleData::const_iterator& oFindName = mStyleData.find(sName);
 							if (oFindName != mStyleData.end())
 							{
 								oNameElement = oFindName->second;
@@ -448,7 +429,7 @@ namespace NSCSS
 		return std::make_pair(UTF8_TO_U(std::string(oDecl->property)), sValueList);
 	}
 
-	void CStyleStorage::GetOutputData(KatanaOutput* oOutput, std::map<std::wstring, CElement*>& mStyleData)
+	void CStyleStorage::GetOutputData(KatanaOutput* oOutput, TStyleData& mStyleData)
 	{
 		if ( NULL == oOutput )
 			return;
@@ -470,9 +451,9 @@ namespace NSCSS
 		}
 	}
 
-	const CElement* CStyleStorage::FindSelectorFromStyleData(const std::wstring& wsSelector, const std::map<std::wstring, CElement*>& mStyleData) const
+	const CElement* CStyleStorage::FindSelectorFromStyleData(const std::wstring& wsSelector, const TStyleData& mStyleData) const
 	{
-		std::map<std::wstring, CElement*>::const_iterator itFound = mStyleData.find(wsSelector);
+		TStyleData::const_iterator itFound = mStyleData.find(wsSelector);
 
 		if (mStyleData.cend() != itFound)
 			return itFound->second;
@@ -506,7 +487,15 @@ namespace NSCSS
 			return true;
 		}
 
-		const std::map<std::vector<CNode>, CCompiledStyle>::iterator oItem = m_mUsedStyles.find(arSelectors);
+		unsigned int unStart = 0;
+
+		std::vector<CNode>::const_reverse_iterator itFound = std::find_if(arSelectors.crbegin() + 1, arSelectors.crend(), [](const CNode& oNode){ return !oNode.m_pCompiledStyle->Empty(); });
+
+		if (itFound != arSelectors.crend())
+			unStart = itFound.base() - arSelectors.cbegin();
+
+		const std::wstring wsStyleKey = CalculateStyleKey(arSelectors, unStart);
+		const std::unordered_map<std::wstring, CCompiledStyle>::const_iterator oItem = m_mUsedStyles.find(wsStyleKey);
 
 		if (oItem != m_mUsedStyles.end())
 		{
@@ -518,12 +507,6 @@ namespace NSCSS
 			return true;
 
 		arSelectors.back().m_pCompiledStyle->SetDpi(m_nDpi);
-		unsigned int unStart = 0;
-
-		std::vector<CNode>::const_reverse_iterator itFound = std::find_if(arSelectors.crbegin(), arSelectors.crend(), [](const CNode& oNode){ return !oNode.m_pCompiledStyle->Empty(); });
-
-		if (itFound != arSelectors.crend())
-			unStart = itFound.base() - arSelectors.cbegin();
 
 		std::vector<std::wstring> arNodes = CalculateAllNodes(arSelectors, unStart, arSelectors.size());
 		std::vector<std::wstring> arPrevNodes = CalculateAllNodes(arSelectors, 0, unStart);
@@ -574,11 +557,36 @@ namespace NSCSS
 		arSelectors.back().m_pCompiledStyle->SetID(CalculateStyleId(arSelectors.back()));
 
 		if (!arSelectors.back().m_pCompiledStyle->Empty())
-			m_mUsedStyles[arSelectors] = *arSelectors.back().m_pCompiledStyle;
+			m_mUsedStyles[wsStyleKey] = *arSelectors.back().m_pCompiledStyle;
 
 		return true;
 	}
 
+	std::wstring CCssCalculator_Private::CalculateStyleKey(const std::vector<CNode>& arSelectors, unsigned int unStart) const
+	{
+		// Стиль узла зависит только от стиля ближайшего вычисленного предка и узлов после него.
+		// Id вычисленного стиля уникален, поэтому он заменяет всю цепочку предков
+		std::wstring wsKey;
+
+		if (0 != unStart)
+		{
+			wsKey = arSelectors[unStart - 1].m_pCompiledStyle->GetId();
+
+			if (wsKey.empty())
+				unStart = 0;
+		}
+
+		for (std::vector<CNode>::const_iterator itNode = arSelectors.cbegin() + unStart; itNode != arSelectors.cend(); ++itNode)
+		{
+			wsKey += L'\x1' + itNode->m_wsName + L'\x2' + itNode->m_wsClass + L'\x2' + itNode->m_wsId + L'\x2' + itNode->m_wsStyle;
+
+			for (const std::pair<const std::wstring, std::wstring>& oAttribute : itNode->m_mAttributes)
+				wsKey += L'\x3' + oAttribute.first + L'=' + oAttribute.second;
+		}
+
+		return wsKey;
+	}
+
 	void CCssCalculator_Private::SetPageData(NSProperties::CPage &oPage, const std::map<std::wstring, std::wstring> &mData, unsigned int unLevel, bool bHardMode)
 	{
 		//TODO:: пересмотреть данный метод
@@ -629,12 +637,12 @@ namespace NSCSS
 		return arNodes;
 	}
 
-	void CCssCalculator_Private::FindPrevAndKindElements(const CElement *pElement, const std::vector<std::wstring> &arNextNodes, std::vector<const CElement*>& arFindedElements, const std::wstring &wsName, const std::vector<std::wstring> &arClasses)
+	void CCssCalculator_Private::FindPrevAndKindElements(const CElement *pElement, const std::vector<std::wstring> &arNextNodes, const CAncestorFilter& oFilter, std::vector<const CElement*>& arFindedElements, const std::wstring &wsName, const std::vector<std::wstring> &arClasses)
 	{
 		if (arNextNodes.empty())
 			return;
 
-		const std::vector<CElement*> arTempPrev = pElement->GetPrevElements(arNextNodes.cbegin(), arNextNodes.cend());
+		const std::vector<CElement*> arTempPrev = pElement->GetPrevElements(arNextNodes.cbegin(), arNextNodes.cend(), &oFilter);
 		const std::vector<CElement*> arTempKins = pElement->GetNextOfKin(wsName, arClasses);
 
 		if (!arTempPrev.empty())
@@ -673,6 +681,9 @@ namespace NSCSS
 			arNodes.pop_back();
 		}
 
+		CAncestorFilter oFilter;
+		oFilter.AddNodes(arNextNodes);
+
 		if (!wsId.empty())
 		{
 			const CElement* pFoundId = m_oStyleStorage.FindElement(wsId);
@@ -682,7 +693,7 @@ namespace NSCSS
 				if (!pFoundId->Empty())
 					arFindedElements.push_back(pFoundId);
 
-				FindPrevAndKindElements(pFoundId, arNextNodes, arFindedElements, wsName);
+				FindPrevAndKindElements(pFoundId, arNextNodes, oFilter, arFindedElements, wsName);
 			}
 		}
 
@@ -697,7 +708,7 @@ namespace NSCSS
 					if (!pFoundClass->Empty())
 						arFindedElements.push_back(pFoundClass);
 
-					FindPrevAndKindElements(pFoundClass, arNextNodes, arFindedElements, wsName);
+					FindPrevAndKindElements(pFoundClass, arNextNodes, oFilter, arFindedElements, wsName);
 				}
 			}
 		}
@@ -709,7 +720,7 @@ namespace NSCSS
 			if (!pFoundName->Empty())
 				arFindedElements.push_back(pFoundName);
 
-			FindPrevAndKindElements(pFoundName, arNextNodes, arFindedElements, wsName, arClasses);
+			FindPrevAndKindElements(pFoundName, arNextNodes, oFilter, arFindedElements, wsName, arClasses);
 		}
 
 		const CElement* pFoundAll = m_oStyleStorage.FindElement(L"*");
@@ -719,7 +730,7 @@ namespace NSCSS
 			if (!pFoundAll->Empty())
 				arFindedElements.push_back(pFoundAll);
 
-			FindPrevAndKindElements(pFoundAll, arNextNodes, arFindedElements, wsName, arClasses);
+			FindPrevAndKindElements(pFoundAll, arNextNodes, oFilter, arFindedElements, wsName, arClasses);
 		}
 
 		if (arFindedElements.size() > 1)
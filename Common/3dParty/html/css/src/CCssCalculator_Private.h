@@ -4,6 +4,7 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include "CElement.h"
 #include "StyleProperties.h"
 #include "../../katana-parser/src/katana.h"
@@ -39,16 +40,19 @@ namespace NSCSS
 
 		const CElement* FindElement(const std::wstring& wsSelector) const;
 	private:
+		// Правила, сгруппированные по крайнему правому селектору (имя тэга, .класс или #id)
+		typedef std::unordered_map<std::wstring, CElement*> TStyleData;
+
 		typedef struct
 		{
 			std::wstring m_wsStyleFilepath;
-			std::map<std::wstring, CElement*> m_mStyleData;
+			TStyleData m_mStyleData;
 		} TStyleFileData;
 
 		std::set<std::wstring> m_arEmptyStyleFiles;
 		std::set<std::wstring> m_arAllowedStyleFiles;
 		std::vector<TStyleFileData*> m_arStyleFiles;
-		std::map<std::wstring, CElement*> m_mEmbeddedStyleData;
+		TStyleData m_mEmbeddedStyleData;
 
 		#ifdef CSS_CALCULATOR_WITH_XHTML
 		typedef struct
@@ -60,12 +64,12 @@ namespace NSCSS
 		std::vector<TPageData> m_arPageDatas;
 		#endif
 	private:
-		void AddStyles(const std::string& sStyle, std::map<std::wstring, CElement*>& mStyleData);
+		void AddStyles(const std::string& sStyle, TStyleData& mStyleData);
 
-		void GetStylesheet(const KatanaStylesheet* oStylesheet, std::map<std::wstring, CElement*>& mStyleData);
-		void GetRule(const KatanaRule* oRule, std::map<std::wstring, CElement*>& mStyleData);
+		void GetStylesheet(const KatanaStylesheet* oStylesheet, TStyleData& mStyleData);
+		void GetRule(const KatanaRule* oRule, TStyleData& mStyleData);
 
-		void GetStyleRule(const KatanaStyleRule* oRule, std::map<std::wstring, CElement*>& mStyleData);
+		void GetStyleRule(const KatanaStyleRule* oRule, TStyleData& mStyleData);
 
 		std::wstring GetValueList(const KatanaArray* oValues);
 
@@ -75,26 +79,28 @@ namespace NSCSS
 		std::map<std::wstring, std::wstring> GetDeclarationList(const KatanaArray* oDeclarations) const;
 		std::pair<std::wstring, std::wstring> GetDeclaration(const KatanaDeclaration* oDecl) const;
 
-		void GetOutputData(KatanaOutput* oOutput, std::map<std::wstring, CElement*>& mStyleData);
+		void GetOutputData(KatanaOutput* oOutput, TStyleData& mStyleData);
 
-		const CElement* FindSelectorFromStyleData(const std::wstring& wsSelector, const std::map<std::wstring, CElement*>& mStyleData) const;
+		const CElement* FindSelectorFromStyleData(const std::wstring& wsSelector, const TStyleData& mStyleData) const;
 	};
 
 	class CCssCalculator_Private
 	{
 		unsigned short int m_nDpi;
-		unsigned short int m_nCountNodes;
+		unsigned int       m_nCountNodes;
 
 		CStyleStorage m_oStyleStorage;
 
 		#ifdef CSS_CALCULATOR_WITH_XHTML
-		std::map<std::vector<CNode>, CCompiledStyle> m_mUsedStyles;
+		std::unordered_map<std::wstring, CCompiledStyle> m_mUsedStyles;
+
+		std::wstring CalculateStyleKey(const std::vector<CNode>& arSelectors, unsigned int unStart) const;
 
 		void SetPageData(NSProperties::CPage& oPage, const std::map<std::wstring, std::wstring>& mData, unsigned int unLevel, bool bHardMode = false);
 		std::map<std::wstring, std::wstring> GetPageData(const std::wstring &wsPageName);
 		#endif
 
-		void FindPrevAndKindElements(const CElement* pElement, const std::vector<std::wstring>& arNextNodes, std::vector<const CElement*>& arFindedElements, const std::wstring& wsName, const std::vector<std::wstring>& arClasses = {});
+		void FindPrevAndKindElements(const CElement* pElement, const std::vector<std::wstring>& arNextNodes, const CAncestorFilter& oFilter, std::vector<const CElement*>& arFindedElements, const std::wstring& wsName, const std::vector<std::wstring>& arClasses = {});
 
 		std::wstring m_sEncoding;
 	public:
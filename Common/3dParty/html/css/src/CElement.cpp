@@ -1,12 +1,48 @@
 #include "CElement.h"
 #include <algorithm>
+#include <functional>
 #include <math.h>
 
 #include "StaticFunctions.h"
 
 namespace NSCSS
 {
+	void CAncestorFilter::Add(const std::wstring& wsSelector)
+	{
+		const size_t unHash = Hash(wsSelector);
+		m_oBits.set(unHash & 1023);
+		m_oBits.set((unHash >> 10) & 1023);
+	}
+
+	void CAncestorFilter::AddNodes(const std::vector<std::wstring>& arNodes)
+	{
+		for (const std::wstring& wsNode : arNodes)
+		{
+			if (wsNode.empty())
+				continue;
+
+			if (wsNode[0] == L'.' && wsNode.find(L' ') != std::wstring::npos)
+			{
+				for (const std::wstring& wsClass : NS_STATIC_FUNCTIONS::GetWordsW(wsNode, false, L" "))
+					Add(wsClass);
+			}
+			else
+				Add(wsNode);
+		}
+	}
+
+	bool CAncestorFilter::MayContain(size_t unHash) const
+	{
+		return m_oBits.test(unHash & 1023) && m_oBits.test((unHash >> 10) & 1023);
+	}
+
+	size_t CAncestorFilter::Hash(const std::wstring& wsSelector)
+	{
+		return std::hash<std::wstring>()(wsSelector);
+	}
+
 	CElement::CElement()
+		: m_unSelectorHash(0)
 	{
 	}
 	CElement::~CElement()
@@ -40,6 +76,7 @@ namespace NSCSS
 	{
 		m_sSelector = sSelector;
 		m_sFullSelector = m_sSelector;
+		m_unSelectorHash = CAncestorFilter::Hash(m_sSelector);
 		UpdateWeight();
 	}
 
@@ -81,7 +118,7 @@ namespace NSCSS
 		oKinElement->UpdateWeight();
 	}
 
-	std::map<std::wstring, std::wstring> CElement::GetStyle() const
+	const std::map<std::wstring, std::wstring>& CElement::GetStyle() const
 	{
 		return m_mStyle;
 	}
@@ -176,11 +213,24 @@ namespace NSCSS
 		return arElements;
 	}
 
-	std::vector<CElement *> CElement::GetPrevElements(const std::vector<std::wstring>::const_iterator& oNodesBegin, const std::vector<std::wstring>::const_iterator& oNodesEnd) const
+	bool CElement::HavePrevElementsIn(const CAncestorFilter& oFilter) const
+	{
+		for (const CElement* oPrevElement : m_arPrevElements)
+			if (oFilter.MayContain(oPrevElement->m_unSelectorHash))
+				return true;
+
+		return false;
+	}
+
+	std::vector<CElement *> CElement::GetPrevElements(const std::vector<std::wstring>::const_iterator& oNodesBegin, const std::vector<std::wstring>::const_iterator& oNodesEnd, const CAncestorFilter* pFilter) const
 	{
 		if (oNodesBegin >= oNodesEnd || m_arPrevElements.empty())
 			return std::vector<CElement*>();
 
+		// Ни одного из предыдущих селекторов нет среди предков
+		if (NULL != pFilter && !HavePrevElementsIn(*pFilter))
+			return std::vector<CElement*>();
+
 		std::vector<CElement*> arElements;
 
 		for (std::vector<std::wstring>::const_iterator iWord = oNodesBegin; iWord != oNodesEnd; ++iWord)
@@ -195,7 +245,7 @@ namespace NSCSS
 						if (oPrevElement->m_sSelector == wsClass)
 						{
 							arElements.push_back(oPrevElement);
-							std::vector<CElement*> arTempElements = oPrevElement->GetPrevElements(iWord + 1, oNodesEnd);
+							std::vector<CElement*> arTempElements = oPrevElement->GetPrevElements(iWord + 1, oNodesEnd, pFilter);
 							arElements.insert(arElements.end(), arTempElements.begin(), arTempElements.end());
 						}
 					}
@@ -208,7 +258,7 @@ namespace NSCSS
 					if (oPrevElement->m_sSelector == *iWord)
 					{
 						arElements.push_back(oPrevElement);
-						std::vector<CElement*> arTempElements = oPrevElement->GetPrevElements(iWord + 1, oNodesEnd);
+						std::vector<CElement*> arTempElements = oPrevElement->GetPrevElements(iWord + 1, oNodesEnd, pFilter);
 						arElements.insert(arElements.end(), arTempElements.begin(), arTempElements.end());
 					}
 				}
@@ -238,7 +288,7 @@ namespace NSCSS
 			m_arWeight = NS_STATIC_FUNCTIONS::GetWeightSelector(m_sFullSelector);
 	}
 
-	std::vector<unsigned short> CElement::GetWeight() const
+	const std::vector<unsigned short>& CElement::GetWeight() const
 	{
 		return m_arWeight;
 	}
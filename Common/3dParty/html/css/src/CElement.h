@@ -4,10 +4,24 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <bitset>
 #include "CNode.h"
 
 namespace NSCSS
 {
+	// Фильтр Блума по селекторам предков (имена, .классы, #id).
+	// Позволяет сразу отбросить элементы, которых точно нет среди предков
+	class CAncestorFilter
+	{
+		std::bitset<1024> m_oBits;
+	public:
+		void Add(const std::wstring& wsSelector);
+		void AddNodes(const std::vector<std::wstring>& arNodes);
+		bool MayContain(size_t unHash) const;
+
+		static size_t Hash(const std::wstring& wsSelector);
+	};
+
 	class CElement
 	{
 		std::map<std::wstring, std::wstring> m_mStyle;
@@ -17,9 +31,12 @@ namespace NSCSS
 
 		std::wstring m_sSelector;
 		std::wstring m_sFullSelector;
+		size_t       m_unSelectorHash;
 
 		std::vector<unsigned short int> m_arWeight;
 
+		bool HavePrevElementsIn(const CAncestorFilter& oFilter) const;
+
 	public:
 		CElement();
 		~CElement();
@@ -35,17 +52,17 @@ namespace NSCSS
 		void AddPrevElement(CElement* oPrevElement);
 		void AddKinElement(CElement* oKinElement);
 
-		std::map<std::wstring, std::wstring> GetStyle() const;
+		const std::map<std::wstring, std::wstring>& GetStyle() const;
 		std::map<std::wstring, std::wstring> GetFullStyle(const std::vector<CNode>& arSelectors) const;
 		std::map<std::wstring, std::wstring> GetFullStyle(const std::vector<std::wstring>& arNodes) const;
 		std::vector<CElement *> GetNextOfKin(const std::wstring& sName, const std::vector<std::wstring>& arClasses = {}) const;
-		std::vector<CElement *> GetPrevElements(const std::vector<std::wstring>::const_iterator& oNodesBegin, const std::vector<std::wstring>::const_iterator& oNodesEnd) const;
+		std::vector<CElement *> GetPrevElements(const std::vector<std::wstring>::const_iterator& oNodesBegin, const std::vector<std::wstring>::const_iterator& oNodesEnd, const CAncestorFilter* pFilter = NULL) const;
 		std::map<std::wstring, std::wstring> GetConvertStyle(const std::vector<CNode>& arNodes) const;
 
 		CElement *FindPrevElement(const std::wstring& sSelector) const;
 
 		void UpdateWeight();
-		std::vector<unsigned short int> GetWeight() const;
+		const std::vector<unsigned short int>& GetWeight() const;
 		void IncreasedWeight();
 	};
 }
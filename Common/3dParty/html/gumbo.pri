@@ -5,6 +5,7 @@ core_linux:QMAKE_CFLAGS += -std=c99
 core_windows:INCLUDEPATH += $$PWD/gumbo-parser/visualc/include
 
 HEADERS += $$files($$PWD/gumbo-parser/src/*.h, true) \
-           $$PWD/htmltoxhtml.h
+           $$PWD/htmltoxhtml.h \
+           $$PWD/gumboreader.h
 
 SOURCES += $$files($$PWD/gumbo-parser/src/*.c, true)
@@ -0,0 +1,505 @@
+#ifndef GUMBOREADER_H
+#define GUMBOREADER_H
+
+#include "htmltoxhtml.h"
+
+// Читатель дерева gumbo с интерфейсом XmlUtils::CXmlLiteReader.
+// Узлы отдаются в том же порядке и виде, что и при разборе результата prettyprint,
+// но без сериализации в xhtml и повторного разбора
+class CGumboReader
+{
+	struct TAttribute
+	{
+		std::string m_sName;
+		std::string m_sValue;
+	};
+
+	struct TNode
+	{
+		XmlUtils::XmlNodeType m_eType;
+		int         m_nDepth;
+		bool        m_bEmpty;
+		std::string m_sName;
+		std::string m_sValue;
+		size_t      m_unFirstAttribute;
+		size_t      m_unAttributesCount;
+	};
+
+	std::vector<TNode>      m_arNodes;
+	std::vector<TAttribute> m_arAttributes;
+
+	bool m_bValid;
+	long m_lNode;      // Текущий узел
+	long m_lAttribute; // Текущий атрибут текущего узла (-1 - стоим на самом узле)
+
+	std::string m_sText; // Накапливаемый текст (соседние текстовые узлы сливаются)
+	int         m_nTextDepth;
+public:
+	CGumboReader()
+		: m_bValid(false), m_lNode(-1), m_lAttribute(-1), m_nTextDepth(0)
+	{}
+
+	bool FromHtml(std::string& sFileContent, bool bNeedConvert)
+	{
+		prepareHtml(sFileContent, bNeedConvert);
+		return Parse(sFileContent);
+	}
+	bool FromMht(std::string& sFileContent)
+	{
+		sFileContent = mhtTohtml(sFileContent);
+		return Parse(sFileContent);
+	}
+
+	void Clear()
+	{
+		std::vector<TNode>().swap(m_arNodes);
+		std::vector<TAttribute>().swap(m_arAttributes);
+		m_sText.clear();
+		m_bValid     = false;
+		m_lNode      = -1;
+		m_lAttribute = -1;
+	}
+	bool IsValid() const
+	{
+		return m_bValid;
+	}
+	bool MoveToStart()
+	{
+		if (!m_bValid)
+			return false;
+
+		m_lNode      = -1;
+		m_lAttribute = -1;
+		return true;
+	}
+
+	bool Read(XmlUtils::XmlNodeType& eNodeType)
+	{
+		if (!m_bValid)
+			return false;
+
+		m_lAttribute = -1;
+		if (m_lNode + 1 >= (long)m_arNodes.size())
+		{
+			m_lNode = (long)m_arNodes.size();
+			return false;
+		}
+
+		eNodeType = m_arNodes[++m_lNode].m_eType;
+		return true;
+	}
+	bool ReadNextNode()
+	{
+		XmlUtils::XmlNodeType eNodeType = XmlUtils::XmlNodeType_None;
+
+		while (XmlUtils::XmlNodeType_Element != eNodeType)
+		{
+			if (!Read(eNodeType))
+				break;
+		}
+
+		return XmlUtils::XmlNodeType_Element == eNodeType;
+	}
+	bool ReadNextSiblingNode(int nDepth)
+	{
+		XmlUtils::XmlNodeType eNodeType = XmlUtils::XmlNodeType_None;
+
+		while (Read(eNodeType))
+		{
+			const int nCurDepth = GetDepth();
+
+			if (nCurDepth < nDepth)
+				break;
+
+			if (XmlUtils::XmlNodeType_Element == eNodeType && nCurDepth == nDepth + 1)
+				return true;
+			else if (XmlUtils::XmlNodeType_EndElement == eNodeType && nCurDepth == nDepth)
+				return false;
+		}
+
+		return false;
+	}
+	bool ReadNextSiblingNode2(int nDepth)
+	{
+		XmlUtils::XmlNodeType eNodeType = XmlUtils::XmlNodeType_None;
+
+		while (Read(eNodeType))
+		{
+			const int nCurDepth = GetDepth();
+
+			if (nCurDepth < nDepth)
+				break;
+
+			if ((XmlUtils::XmlNodeType_Element == eNodeType || IsTextType(eNodeType)) && nCurDepth == nDepth + 1)
+				return true;
+			else if (XmlUtils::XmlNodeType_EndElement == eNodeType && nCurDepth == nDepth)
+				return false;
+		}
+
+		return false;
+	}
+
+	int GetDepth() const
+	{
+		if (!m_bValid)
+			return -1;
+
+		const TNode* pNode = GetNode();
+		if (NULL == pNode)
+			return 0;
+
+		return (-1 == m_lAttribute) ? pNode->m_nDepth : pNode->m_nDepth + 1;
+	}
+	bool IsEmptyNode() const
+	{
+		const TNode* pNode = GetNode();
+		return NULL != pNode && -1 == m_lAttribute && pNode->m_bEmpty;
+	}
+
+	std::wstring GetName() const
+	{
+		const TNode* pNode = GetNode();
+		if (NULL == pNode)
+			return L"";
+
+		if (-1 != m_lAttribute)
+			return UTF8_TO_U(m_arAttributes[pNode->m_unFirstAttribute + m_lAttribute].m_sName);
+
+		if (IsTextType(pNode->m_eType))
+			return L"#text";
+
+		return UTF8_TO_U(pNode->m_sName);
+	}
+	std::wstring GetText() const
+	{
+		const TNode* pNode = GetNode();
+		if (NULL == pNode)
+			return L"";
+
+		if (-1 != m_lAttribute)
+			return UTF8_TO_U(m_arAttributes[pNode->m_unFirstAttribute + m_lAttribute].m_sValue);
+
+		return UTF8_TO_U(pNode->m_sValue);
+	}
+	std::wstring GetText2()
+	{
+		std::wstring sResult;
+
+		if (!m_bValid || IsEmptyNode())
+			return sResult;
+
+		const int nDepth = GetDepth();
+		XmlUtils::XmlNodeType eNodeType = XmlUtils::XmlNodeType_EndElement;
+		while (Read(eNodeType) && GetDepth() >= nDepth && XmlUtils::XmlNodeType_EndElement != eNodeType)
+		{
+			if (IsTextType(eNodeType))
+				sResult += GetText();
+		}
+
+		return sResult;
+	}
+	std::wstring GetOuterXml()
+	{
+		if (!m_bValid)
+			return L"";
+
+		NSStringUtils::CStringBuilder oResult;
+		WriteElement(oResult);
+
+		const int nDepth = GetDepth();
+		if (!IsEmptyNode())
+		{
+			XmlUtils::XmlNodeType eNodeType = XmlUtils::XmlNodeType_None;
+			while (Read(eNodeType))
+			{
+				if (IsTextType(eNodeType))
+					oResult.WriteEncodeXmlString(GetText().c_str());
+				else if (XmlUtils::XmlNodeType_Element == eNodeType)
+					WriteElement(oResult);
+				else if (XmlUtils::XmlNodeType_EndElement == eNodeType)
+				{
+					oResult.AddChar2Safe(wchar_t('<'), wchar_t('/'));
+					oResult.WriteEncodeXmlString(GetName().c_str());
+					oResult.AddCharSafe(wchar_t('>'));
+				}
+
+				const int nCurDepth = GetDepth();
+				if (nCurDepth < nDepth || (XmlUtils::XmlNodeType_EndElement == eNodeType && nCurDepth == nDepth))
+					break;
+			}
+		}
+
+		return oResult.GetData();
+	}
+
+	bool MoveToFirstAttribute()
+	{
+		const TNode* pNode = GetNode();
+		if (NULL == pNode || 0 == pNode->m_unAttributesCount)
+			return false;
+
+		m_lAttribute = 0;
+		return true;
+	}
+	bool MoveToNextAttribute()
+	{
+		if (-1 == m_lAttribute)
+			return MoveToFirstAttribute();
+
+		if (m_lAttribute + 1 >= (long)GetNode()->m_unAttributesCount)
+			return false;
+
+		++m_lAttribute;
+		return true;
+	}
+	bool MoveToElement()
+	{
+		if (-1 == m_lAttribute)
+			return false;
+
+		m_lAttribute = -1;
+		return true;
+	}
+private:
+	static bool IsTextType(XmlUtils::XmlNodeType eNodeType)
+	{
+		return XmlUtils::XmlNodeType_Text                   == eNodeType ||
+		       XmlUtils::XmlNodeType_Whitespace             == eNodeType ||
+		       XmlUtils::XmlNodeType_SIGNIFICANT_WHITESPACE == eNodeType ||
+		       XmlUtils::XmlNodeType_CDATA                  == eNodeType;
+	}
+
+	const TNode* GetNode() const
+	{
+		if (m_lNode < 0 || m_lNode >= (long)m_arNodes.size())
+			return NULL;
+
+		return &m_arNodes[m_lNode];
+	}
+
+	void WriteElement(NSStringUtils::CStringBuilder& oResult)
+	{
+		oResult.AddCharSafe(wchar_t('<'));
+		oResult.WriteEncodeXmlString(GetName().c_str());
+		if (MoveToFirstAttribute())
+		{
+			do
+			{
+				oResult.AddCharSafe(wchar_t(' '));
+				oResult.WriteEncodeXmlString(GetName().c_str());
+				oResult.AddChar2Safe(wchar_t('='), wchar_t('\"'));
+				oResult.WriteEncodeXmlString(GetText().c_str());
+				oResult.AddCharSafe(wchar_t('\"'));
+			} while (MoveToNextAttribute());
+			MoveToElement();
+		}
+		if (IsEmptyNode())
+			oResult.AddChar2Safe(wchar_t('/'), wchar_t('>'));
+		else
+			oResult.AddCharSafe(wchar_t('>'));
+	}
+
+	// Нормализация, которую раньше выполнял xml парсер: переводы строк в тексте приводятся к \n.
+	// Недопустимые в xml управляющие символы удаляются
+	static void NormalizeXmlText(std::string& sText)
+	{
+		std::string::iterator itWrite = sText.begin();
+		for (std::string::const_iterator itRead = sText.begin(); itRead != sText.end(); ++itRead)
+		{
+			const unsigned char chValue = *itRead;
+
+			if ('\r' == chValue)
+			{
+				if (itRead + 1 != sText.end() && '\n' == *(itRead + 1))
+					++itRead;
+				*itWrite++ = '\n';
+			}
+			else if ('\n' == chValue)
+				*itWrite++ = '\n';
+			else if (chValue >= 0x20 || '\t' == chValue)
+				*itWrite++ = chValue;
+		}
+		sText.erase(itWrite, sText.end());
+	}
+
+	static bool IsBlank(const std::string& sText)
+	{
+		return std::string::npos == sText.find_first_not_of(" \t\n\r");
+	}
+
+	bool Parse(const std::string& sFileContent)
+	{
+		Clear();
+
+		GumboOptions options = kGumboDefaultOptions;
+		GumboOutput* output = gumbo_parse_with_options(&options, sFileContent.data(), sFileContent.length());
+
+		if (output->document->v.document.has_doctype)
+		{
+			TNode oDoctype{XmlUtils::XmlNodeType_DocumentType, 0, false, output->document->v.document.name, std::string(), 0, 0};
+			m_arNodes.push_back(oDoctype);
+		}
+
+		ReadContents(output->document, 0, true);
+		FlushText();
+
+		gumbo_destroy_output(&options, output);
+
+		m_bValid = true;
+		return true;
+	}
+
+	void AddText(const std::string& sText, int nDepth)
+	{
+		if (sText.empty())
+			return;
+
+		if (m_sText.empty())
+			m_nTextDepth = nDepth;
+
+		m_sText += sText;
+	}
+
+	void FlushText()
+	{
+		if (m_sText.empty())
+			return;
+
+		TNode oText{IsBlank(m_sText) ? XmlUtils::XmlNodeType_SIGNIFICANT_WHITESPACE : XmlUtils::XmlNodeType_Text, m_nTextDepth, false, std::string(), std::string(), 0, 0};
+		oText.m_sValue.swap(m_sText);
+		m_arNodes.push_back(std::move(oText));
+	}
+
+	// Аналог prettyprint_contents
+	void ReadContents(GumboNode* node, int nDepth, bool bCheckValidNode)
+	{
+		std::string key             = "|" + get_tag_name(node) + "|";
+		bool keep_whitespace        = preserve_whitespace.find(key) != std::string::npos;
+		bool is_inline              = nonbreaking_inline.find(key) != std::string::npos;
+		bool is_like_inline         = treat_like_inline.find(key) != std::string::npos;
+
+		GumboVector* children = &node->v.element.children;
+
+		for (size_t i = 0; i < children->length; i++)
+		{
+			GumboNode* child = static_cast<GumboNode*> (children->data[i]);
+
+			if (child->type == GUMBO_NODE_TEXT)
+			{
+				std::string val(child->v.text.text);
+				remove_control_symbols(val);
+				NormalizeXmlText(val);
+				AddText(val, nDepth);
+			}
+			else if ((child->type == GUMBO_NODE_ELEMENT) || (child->type == GUMBO_NODE_TEMPLATE))
+				ReadElement(child, nDepth, bCheckValidNode);
+			else if (child->type == GUMBO_NODE_WHITESPACE)
+			{
+				if (keep_whitespace || is_inline || is_like_inline)
+				{
+					std::string val(child->v.text.text);
+					NormalizeXmlText(val);
+					AddText(val, nDepth);
+				}
+			}
+		}
+	}
+
+	// Аналог prettyprint
+	void ReadElement(GumboNode* node, int nDepth, bool bCheckValidNode)
+	{
+		std::string tagname = get_tag_name(node);
+		remove_control_symbols(tagname);
+
+		if (NodeIsUnprocessed(tagname))
+			return;
+
+		if (bCheckValidNode)
+			bCheckValidNode = !IsUnckeckedNodes(tagname);
+
+		// Неизвестный тэг пропускается, его содержимое переходит к родителю
+		if (bCheckValidNode && html_tags.end() == std::find(html_tags.begin(), html_tags.end(), tagname))
+		{
+			ReadContents(node, nDepth, bCheckValidNode);
+			return;
+		}
+
+		const bool is_empty_tag = empty_tags.find("|" + tagname + "|") != std::string::npos;
+
+		FlushText();
+
+		TNode oElement{XmlUtils::XmlNodeType_Element, nDepth, is_empty_tag, tagname, std::string(), m_arAttributes.size(), 0};
+		ReadAttributes(&node->v.element.attributes);
+		oElement.m_unAttributesCount = m_arAttributes.size() - oElement.m_unFirstAttribute;
+		m_arNodes.push_back(oElement);
+
+		// У пустого тэга нет закрывающего, поэтому его содержимое оказывается на том же уровне
+		ReadContents(node, is_empty_tag ? nDepth : nDepth + 1, bCheckValidNode);
+
+		if (!is_empty_tag)
+		{
+			FlushText();
+
+			TNode oEndElement{XmlUtils::XmlNodeType_EndElement, nDepth, false, tagname, std::string(), 0, 0};
+			m_arNodes.push_back(std::move(oEndElement));
+		}
+	}
+
+	// Аналог build_attributes. Объявления пространств имен идут первыми, как их отдавал xml парсер
+	void ReadAttributes(const GumboVector* attribs)
+	{
+		const size_t unFirst = m_arAttributes.size();
+		std::vector<std::string> arrRepeat;
+
+		for (size_t i = 0; i < attribs->length; ++i)
+		{
+			GumboAttribute* at = static_cast<GumboAttribute*>(attribs->data[i]);
+			std::string sVal(at->value);
+			std::string sName(at->name);
+
+			remove_attribute_control_symbols(sVal);
+			remove_control_symbols(sName);
+
+			bool bCheck = false;
+			size_t nBad = sName.find_first_of("+,.=?#%<>&;\"\'()[]{}");
+			while(nBad != std::string::npos)
+			{
+				sName.erase(nBad, 1);
+				nBad = sName.find_first_of("+,.=?#%<>&;\"\'()[]{}", nBad);
+				if(sName.empty())
+					break;
+				bCheck = true;
+			}
+			if(sName.empty())
+				continue;
+			while(sName.front() >= '0' && sName.front() <= '9')
+			{
+				sName.erase(0, 1);
+				if(sName.empty())
+					break;
+				bCheck = true;
+			}
+			if(bCheck)
+			{
+				GumboAttribute* check = gumbo_get_attribute(attribs, sName.c_str());
+				if(check || std::find(arrRepeat.begin(), arrRepeat.end(), sName) != arrRepeat.end())
+					continue;
+				else
+					arrRepeat.push_back(sName);
+			}
+
+			if(sName.empty())
+				continue;
+
+			TAttribute oAttribute{std::move(sName), std::move(sVal)};
+			m_arAttributes.push_back(std::move(oAttribute));
+		}
+
+		std::stable_partition(m_arAttributes.begin() + unFirst, m_arAttributes.end(), [](const TAttribute& oAttribute)
+		{
+			return "xmlns" == oAttribute.m_sName || 0 == oAttribute.m_sName.compare(0, 6, "xmlns:");
+		});
+	}
+};
+
+#endif // GUMBOREADER_H
@@ -68,7 +68,8 @@ static bool IsUnckeckedNodes(const std::string& sValue)
 	return unchecked_nodes_new.end() != std::find(unchecked_nodes_new.begin(), unchecked_nodes_new.end(), sValue);
 }
 
-static std::wstring htmlToXhtml(std::string& sFileContent, bool bNeedConvert)
+// Подготавливает html к разбору gumbo
+static void prepareHtml(std::string& sFileContent, bool bNeedConvert)
 {
 	if (bNeedConvert)
 	{ // Определение кодировки
@@ -97,6 +98,11 @@ static std::wstring htmlToXhtml(std::string& sFileContent, bool bNeedConvert)
 	while (NSStringFinder::RemoveEmptyTag(sFileContent, "title"));
 	//Избавление от <script ... />
 	while (NSStringFinder::RemoveEmptyTag(sFileContent, "script"));
+}
+
+static std::wstring htmlToXhtml(std::string& sFileContent, bool bNeedConvert)
+{
+	prepareHtml(sFileContent, bNeedConvert);
 
 	// Gumbo
 	GumboOptions options = kGumboDefaultOptions;
@@ -105,6 +111,7 @@ static std::wstring htmlToXhtml(std::string& sFileContent, bool bNeedConvert)
 	// prettyprint
 	NSStringUtils::CStringBuilderA oBuilder;
 	prettyprint(output->document, oBuilder);
+	gumbo_destroy_output(&options, output);
 
 	// Конвертирование из string utf8 в wstring
 	return UTF8_TO_U(oBuilder.GetData());
@@ -425,6 +432,7 @@ static std::wstring mhtToXhtml(std::string& sFileContent)
 	// prettyprint
 	NSStringUtils::CStringBuilderA oBuilder;
 	prettyprint(output->document, oBuilder);
+	gumbo_destroy_output(&options, output);
 
 	// Конвертирование из string utf8 в wstring
 	return UTF8_TO_U(oBuilder.GetData());
@@ -454,12 +462,21 @@ static void remove_control_symbols(std::string& text)
 	}
 }
 
-// Заменяет сущности " в text
+// В значении атрибута оставляет из управляющих символов только \t, \n, \r - остальные недопустимы в xml
+static void remove_attribute_control_symbols(std::string& text)
+{
+	text.erase(std::remove_if(text.begin(), text.end(), [](unsigned char chValue){ return chValue < 0x20 && '\t' != chValue && '\n' != chValue && '\r' != chValue; }), text.end());
+}
+
+// Заменяет сущности " в text. \t, \n, \r пишутся ссылками, иначе xml парсер заменит их пробелами
 static void substitute_xml_entities_into_attributes(std::string& text)
 {
-	remove_control_symbols(text);
+	remove_attribute_control_symbols(text);
 	substitute_xml_entities_into_text(text);
 	replace_all(text, "\"", "&quot;");
+	replace_all(text, "\t", "&#9;");
+	replace_all(text, "\n", "&#10;");
+	replace_all(text, "\r", "&#13;");
 }
 
 static std::string handle_unknown_tag(GumboStringPiece* text)
@@ -515,7 +532,6 @@ static void build_attributes(const GumboVector* attribs, NSStringUtils::CStringB
 		std::string sVal(at->value);
 		std::string sName(at->name);
 
-		remove_control_symbols(sVal);
 		remove_control_symbols(sName);
 
 		atts.WriteString(" ");
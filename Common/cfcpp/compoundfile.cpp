@@ -192,6 +192,8 @@ void CompoundFile_impl::Commit(bool releaseMemory)
     if (updateMode != CFSUpdateMode::Update)
         throw CFInvalidOperation("Cannot commit data in Read-Only update mode");
 
+    ResetReadSectorChains();
+
     _INT32 sectorSize = GetSectorSize();
 
     if (header->majorVersion != (_UINT16)CFSVersion::Ver_3)
@@ -658,6 +660,34 @@ SVector<Sector> CompoundFile_impl::GetSectorChain(_INT32 sectorID, SectorType ch
     }
 }
 
+SVector<Sector> CompoundFile_impl::GetReadSectorChain(_INT32 sectorID, SectorType chainType)
+{
+    if (chainType != SectorType::Normal && chainType != SectorType::Mini)
+        return GetSectorChain(sectorID, chainType);
+
+    auto& chains = chainType == SectorType::Mini ? readMiniChains : readNormalChains;
+    {
+        std::lock_guard<std::mutex> lock(readChainsLock);
+
+        auto found = chains.find(sectorID);
+        if (found != chains.end())
+            return found->second;
+    }
+
+    SVector<Sector> chain = GetSectorChain(sectorID, chainType);
+
+    std::lock_guard<std::mutex> lock(readChainsLock);
+    return chains.insert(std::make_pair(sectorID, chain)).first->second;
+}
+
+void CompoundFile_impl::ResetReadSectorChains()
+{
+    std::lock_guard<std::mutex> lock(readChainsLock);
+
+    readNormalChains.clear();
+    readMiniChains.clear();
+}
+
 void CompoundFile_impl::EnsureUniqueSectorIndex(_INT32 nextSectorID, std::unordered_set<_INT32> & processedSectors)
 {
     if (processedSectors.find(nextSectorID) != processedSectors.end() && this->isValidationExceptionEnabled)
@@ -891,6 +921,8 @@ void CompoundFile_impl::FreeMiniChain(SVector<Sector> &sectorChain, bool zeroSec
 
 void CompoundFile_impl::FreeMiniChain(SVector<Sector> &sectorChain, _INT32 nth_sector_to_remove, bool zeroSector)
 {
+    ResetReadSectorChains();
+
     std::vector<char> ZEROED_MINI_SECTOR(Sector::MINISECTOR_SIZE, 0);
 
     SVector<Sector> miniFAT
@@ -947,6 +979,8 @@ void CompoundFile_impl::FreeMiniChain(SVector<Sector> &sectorChain, _INT32 nth_s
 
 void CompoundFile_impl::FreeChain(SVector<Sector> &sectorChain, _INT32 nth_sector_to_remove, bool zeroSector)
 {
+    ResetReadSectorChains();
+
     SVector<Sector> FAT = GetSectorChain(-1, SectorType::FAT);
 
     SList<Sector> zeroQueue;
@@ -984,6 +1018,8 @@ void CompoundFile_impl::FreeChain(SVector<Sector> &sectorChain, bool zeroSector)
 
 void CompoundFile_impl::AllocateSectorChain(SVector<Sector> &sectorChain)
 {
+    ResetReadSectorChains();
+
     for (auto& sector : *sectorChain)
     {
         if (sector->id == -1)
@@ -1162,6 +1198,8 @@ void CompoundFile_impl::AllocateDIFATSectorChain(SVector<Sector> &FATsectorChain
 
 void CompoundFile_impl::AllocateMiniSectorChain(SVector<Sector> &sectorChain)
 {
+    ResetReadSectorChains();
+
     SVector<Sector> miniFAT
             = GetSectorChain(header->firstMiniFATSectorID, SectorType::Normal);
 
@@ -1252,6 +1290,8 @@ _INT32 CompoundFile_impl::LowSaturation(_INT32 x)
 
 void CompoundFile_impl::SetSectorChain(SVector<Sector> sectorChain)
 {
+    ResetReadSectorChains();
+
     if (sectorChain != nullptr && sectorChain.size() == 0)
         return;
 
@@ -1359,6 +1399,8 @@ void CompoundFile_impl::AppendData(std::shared_ptr<CFItem> cfItem, const std::ve
 
 void CompoundFile_impl::SetStreamLength(std::shared_ptr<CFItem> cfItem, _INT64 length)
 {
+    ResetReadSectorChains();
+
     if (cfItem->size() == length)
         return;
 
@@ -1620,20 +1662,22 @@ std::vector<BYTE> CompoundFile_impl::GetData(const CFStream *cFStream)
     SList<Sector> zeroQueue;
     if (de.lock()->getSize() < header->minSizeStandardStream)
     {
-        StreamView miniView(GetSectorChain(
+        StreamView miniView(GetReadSectorChain(
                                 de.lock()->getStartSetc(),
                                 SectorType::Mini),
                             Sector::MINISECTOR_SIZE,
                             de.lock()->getSize(),
                             zeroQueue,
-                            sourceStream);
+                            sourceStream,
+                            false,
+                            true);
 
         result.reserve(de.lock()->getSize());
         miniView.read(reinterpret_cast<char*>(result.data()), result.size());
     }
     else
     {
-        StreamView sView(GetSectorChain(de.lock()->getStartSetc(), SectorType::Normal), GetSectorSize(), de.lock()->getSize(), zeroQueue, sourceStream);
+        StreamView sView(GetReadSectorChain(de.lock()->getStartSetc(), SectorType::Normal), GetSectorSize(), de.lock()->getSize(), zeroQueue, sourceStream, false, true);
 
         result.reserve((int)de.lock()->getSize());
 
@@ -1658,11 +1702,11 @@ _INT32 CompoundFile_impl::ReadData(CFStream *cFStream, _INT64 position, std::vec
     SList<Sector> zeroQueue;
     if (de->getSize() < header->minSizeStandardStream)
     {
-        sv.reset(new StreamView(GetSectorChain(de->getStartSetc(), SectorType::Mini), Sector::MINISECTOR_SIZE, de->getSize(), zeroQueue, sourceStream));
+        sv.reset(new StreamView(GetReadSectorChain(de->getStartSetc(), SectorType::Mini), Sector::MINISECTOR_SIZE, de->getSize(), zeroQueue, sourceStream, false, true));
     }
     else
     {
-        sv.reset(new StreamView(GetSectorChain(de->getStartSetc(), SectorType::Normal), GetSectorSize(), de->getSize(), zeroQueue, sourceStream));
+        sv.reset(new StreamView(GetReadSectorChain(de->getStartSetc(), SectorType::Normal), GetSectorSize(), de->getSize(), zeroQueue, sourceStream, false, true));
     }
 
 
@@ -1683,11 +1727,11 @@ _INT32 CompoundFile_impl::ReadData(CFStream *cFStream, _INT64 position, std::vec
     SList<Sector> zeroQueue;
     if (de->getSize() < header->minSizeStandardStream)
     {
-        sv.reset(new StreamView(GetSectorChain(de->getStartSetc(), SectorType::Mini), Sector::MINISECTOR_SIZE, de->getSize(), zeroQueue, sourceStream));
+        sv.reset(new StreamView(GetReadSectorChain(de->getStartSetc(), SectorType::Mini), Sector::MINISECTOR_SIZE, de->getSize(), zeroQueue, sourceStream, false, true));
     }
     else
     {
-        sv.reset(new StreamView(GetSectorChain(de->getStartSetc(), SectorType::Normal), GetSectorSize(), de->getSize(), zeroQueue, sourceStream));
+        sv.reset(new StreamView(GetReadSectorChain(de->getStartSetc(), SectorType::Normal), GetSectorSize(), de->getSize(), zeroQueue, sourceStream, false, true));
     }
 
 
@@ -1711,13 +1755,13 @@ std::vector<BYTE> CompoundFile_impl::GetDataBySID(_INT32 sid)
         SList<Sector> zeroQueue;
         if (de->getSize() < header->minSizeStandardStream)
         {
-            StreamView miniView(GetSectorChain(de->getStartSetc(), SectorType::Mini), Sector::MINISECTOR_SIZE, de->getSize(), zeroQueue, sourceStream);
+            StreamView miniView(GetReadSectorChain(de->getStartSetc(), SectorType::Mini), Sector::MINISECTOR_SIZE, de->getSize(), zeroQueue, sourceStream, false, true);
             result.resize(de->getSize());
             miniView.read(reinterpret_cast<char*>(result.data()), result.size());
         }
         else
         {
-            StreamView sv(GetSectorChain(de->getStartSetc(), SectorType::Normal), GetSectorSize(), de->getSize(), zeroQueue, sourceStream);
+            StreamView sv(GetReadSectorChain(de->getStartSetc(), SectorType::Normal), GetSectorSize(), de->getSize(), zeroQueue, sourceStream, false, true);
             result.resize(de->getSize());
             sv.read(reinterpret_cast<char*>(result.data()), result.size());
         }
@@ -1762,6 +1806,8 @@ _GUID_ CompoundFile_impl::getGuidForStream(_INT32 sid)
 
 void CompoundFile_impl::WriteData(std::shared_ptr<CFItem> cfItem, const char* data, _INT64 position, _INT32 count)
 {
+    ResetReadSectorChains();
+
     if (data == nullptr)
         throw CFInvalidOperation("Parameter [data] cannot be null");
 
@@ -36,6 +36,7 @@
 #include "cfstorage.h"
 #include "slist.h"
 #include <unordered_set>
+#include <unordered_map>
 #include "RBTree/rbtree.h"
 #include "idirectoryentry.h"
 #include <mutex>
@@ -108,6 +109,8 @@ private:
     SVector<Sector> GetNormalSectorChain(_INT32 sectorID);
     SVector<Sector> GetMiniSectorChain(_INT32 sectorID);
     SVector<Sector> GetSectorChain(_INT32 sectorID, SectorType chainType);
+    SVector<Sector> GetReadSectorChain(_INT32 sectorID, SectorType chainType);
+    void ResetReadSectorChains();
     void EnsureUniqueSectorIndex(_INT32 nextsectorID, std::unordered_set<_INT32>  &processedSectors);
     void CommitDirectory();
     void Close(bool closeStream);
@@ -155,6 +158,10 @@ private:
 
 
     SectorCollection sectors;
+    // sector chains of streams being read, keyed by start sector; dropped on any allocation change
+    std::unordered_map<_INT32, SVector<Sector>> readNormalChains;
+    std::unordered_map<_INT32, SVector<Sector>> readMiniChains;
+    std::mutex readChainsLock;
     std::fstream stream;
     std::string fileName;
     std::shared_ptr<CFStorage> rootStorage;
@@ -60,6 +60,11 @@ bool Sector::IsStreamed()
     return  (this->id * size) + size < fileSize;
 }
 
+bool Sector::IsLoaded() const
+{
+    return !data.empty();
+}
+
 void Sector::ZeroData()
 {
     std::fill(data.begin(), data.end(), 0);
@@ -58,6 +58,7 @@ public:
     Sector(_INT32 size);
 
     bool IsStreamed();
+    bool IsLoaded() const;
     void ZeroData();
     void InitFATData();
     void ReleaseData();
@@ -31,6 +31,7 @@
  */
 #include "streamview.h"
 #include "cfexception.h"
+#include "Stream/stream_utils.h"
 #include <cmath>
 #include <algorithm>
 
@@ -49,10 +50,11 @@ StreamView::StreamView(const SVector<Sector> &sectorChain, _INT32 sectorSize, St
 }
 
 StreamView::StreamView(const SVector<Sector> &sectorChain, _INT32 sectorSize, _INT64 length,
-                       SList<Sector> &availableSectors, Stream stream, bool isFatStream) :
+                       SList<Sector> &availableSectors, Stream stream, bool isFatStream, bool isSharedChain) :
     StreamView(sectorChain, sectorSize, stream)
 {
     this->isFatStream = isFatStream;
+    this->isSharedChain = isSharedChain;
     adjustLength(length, availableSectors);
 
 }
@@ -134,55 +136,76 @@ bool StreamView::isError()
 
 _INT64 StreamView::read(char *buffer, _INT64 len)
 {
-    _INT32 nRead = 0;
-    _INT32 nToRead = 0;
-    _INT32 offset = 0;
-    if (sectorChain.empty() == false && sectorChain.size() > 0)
+    if (sectorChain.empty() || len <= 0)
+        return 0;
+
+    _INT64 nRead = 0;
+    _INT64 streamLength = -1;
+
+    while (nRead < len)
     {
-        _INT32 sectorIndex = (int)(position / (_INT64)sectorSize);
+        _INT32 sectorIndex = (_INT32)(position / (_INT64)sectorSize);
+        _INT32 sectorShift = (_INT32)(position % (_INT64)sectorSize);
 
-        nToRead = (std::min)((_INT64)sectorChain[0]->GetData().size() - ((_INT64)position % sectorSize), len);
+        if (sectorIndex >= (_INT32)sectorChain.size())
+            throw CFCorruptedFileException("The file is probably corrupted.");
 
-        if (sectorIndex < (int)sectorChain.size())
-        {
-            char* src = reinterpret_cast<char*>(sectorChain[sectorIndex]->GetData().data() + (int)(position % sectorSize));
-            char* dst = buffer + offset;
-            std::copy(src, src + nToRead, dst);
-        }
+        _INT64 nToRead = 0;
+        _INT32 runLength = contiguousRun(sectorIndex, sectorShift, len - nRead, streamLength);
 
-        nRead += nToRead;
-        sectorIndex++;
+        if (runLength > 0)
+        {
+            // Large reads of sectors following each other in the file go straight
+            // into the buffer in one call and are not cached in the sector collection
+            nToRead = (std::min)((_INT64)runLength * sectorSize - sectorShift, len - nRead);
 
-        while (nRead < (len - sectorSize))
+            stream->seek((_INT64)sectorSize + (_INT64)sectorChain[sectorIndex]->id * sectorSize + sectorShift, std::ios_base::beg);
+            stream->read(buffer + nRead, nToRead);
+        }
+        else
         {
-            nToRead = sectorSize;
-            char* src = reinterpret_cast<char*>(sectorChain[sectorIndex]->GetData().data());
-            char* dst = buffer + offset + nToRead;
-            std::copy(src, src + nToRead, dst);
+            std::vector<BYTE>& data = sectorChain[sectorIndex]->GetData();
+
+            nToRead = (std::min)((_INT64)data.size() - sectorShift, len - nRead);
+            if (nToRead <= 0)
+                throw CFCorruptedFileException("The file is probably corrupted.");
 
-            nRead += nToRead;
-            sectorIndex++;
+            char* src = reinterpret_cast<char*>(data.data() + sectorShift);
+            std::copy(src, src + nToRead, buffer + nRead);
         }
 
-        nToRead = len - nRead;
+        nRead += nToRead;
+        position += nToRead;
+    }
 
-        if (nToRead != 0)
-        {
-            if (sectorIndex > (int)sectorChain.size()) throw CFCorruptedFileException("The file is probably corrupted.");
-            char* src = reinterpret_cast<char*>(sectorChain[sectorIndex]->GetData().data());
-            char* dst = buffer + offset + nRead;
-            std::copy(src, src + nToRead, dst);
+    return nRead;
+}
 
-            nRead += nToRead;
-        }
+_INT32 StreamView::contiguousRun(_INT32 sectorIndex, _INT32 sectorShift, _INT64 count, _INT64 &streamLength)
+{
+    if (stream == nullptr || sectorSize == Sector::MINISECTOR_SIZE || count < sectorSize)
+        return 0;
+
+    _INT32 result = 0;
 
-        position += nRead;
+    for (size_t i = sectorIndex; i < sectorChain.size() && (_INT64)result * sectorSize < sectorShift + count; i++)
+    {
+        const std::shared_ptr<Sector>& sector = sectorChain[i];
+
+        if (sector->IsLoaded() || sector->type == SectorType::Mini || sector->getSize() != sectorSize || sector->id < 0)
+            break;
+        if (result > 0 && sector->id != sectorChain[i - 1]->id + 1)
+            break;
 
-        return nRead;
+        if (streamLength < 0)
+            streamLength = Length(stream);
+        if ((_INT64)(sector->id + 2) * sectorSize > streamLength)
+            break;
 
+        result++;
     }
 
-    return 0;
+    return result;
 }
 
 _INT64 StreamView::seek(_INT64 offset, std::ios_base::seekdir mode)
@@ -240,6 +263,13 @@ void StreamView::adjustLength(_INT64 value, SList<Sector> &availableSectors)
     {
         _INT32 numberSector = (int)std::ceil(((double)delta / sectorSize));
 
+        // the chain is shared with the compound file's read cache - grow a private copy
+        if (isSharedChain)
+        {
+            sectorChain = SVector<Sector>(std::make_shared<SVectorBase<Sector>>(*sectorChain));
+            isSharedChain = false;
+        }
+
         while (numberSector > 0)
         {
             std::shared_ptr<Sector> newSector;
@@ -44,7 +44,7 @@ class StreamView : public IStream
 public:
     StreamView(const SVector<Sector> &sectorChain, _INT32 sectorSize, Stream stream);
     StreamView(const SVector<Sector> &sectorChain, _INT32 sectorSize, _INT64 length,
-               SList<Sector> &availableSectors, Stream stream, bool isFatStream = false);
+               SList<Sector> &availableSectors, Stream stream, bool isFatStream = false, bool isSharedChain = false);
 
     _INT64 tell() override;
     _INT64 seek(_INT64 offset, std::ios_base::seekdir mode = std::ios::beg) override;
@@ -65,6 +65,7 @@ public:
 private:
     void adjustLength(_INT64 value);
     void adjustLength(_INT64 value, SList<Sector> &availableSectors);
+    _INT32 contiguousRun(_INT32 sectorIndex, _INT32 sectorShift, _INT64 count, _INT64 &streamLength);
 
 private:
     _INT32 sectorSize = 0;
@@ -72,6 +73,7 @@ private:
 
     SVector<Sector> sectorChain;
     bool isFatStream = false;
+    bool isSharedChain = false;
     _INT32 buf = 0;
 
     Stream stream;
@@ -3,6 +3,7 @@
 #include "tst_directoryentry.h"
 #include "tst_compondfile.h"
 #include "tst_data_set.h"
+#include "tst_readbenchmark.h"
 
 using namespace CFCPP;
 
@@ -21,6 +21,7 @@ HEADERS += \
     tst_data_set.h \
     tst_directoryentry.h \
     tst_header.h \
+    tst_readbenchmark.h \
     tst_streamrw.h
 
 SOURCES += \
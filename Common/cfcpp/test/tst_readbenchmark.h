@@ -0,0 +1,83 @@
+#pragma once
+
+#include "global.h"
+#include "../compoundfile.h"
+#include "../cfstorage.h"
+#include "../cfstream.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+
+
+// ex.ppt with an added "Pictures" stream, read back the way binary readers do - record by record.
+// The 70 MB variant is a benchmark: run it with --gtest_also_run_disabled_tests
+struct ReadBenchmarkTest : testing::Test
+{
+    wstring largeFilePath;
+    vector<BYTE> picturesData;
+
+    void CreateFile(size_t picturesLen)
+    {
+        picturesData.resize(picturesLen);
+        for (size_t i = 0; i < picturesData.size(); i++)
+            picturesData[i] = (BYTE)((i * 2654435761u) >> 13);
+
+        CompoundFile cf(sourcePath + L"ex.ppt", CFSUpdateMode::Update, 0);
+        cf.RootStorage()->AddStream(L"Pictures")->Write(picturesData, 0);
+
+        largeFilePath = InitOutPath(L"large.ppt");
+        cf.Save(largeFilePath);
+    }
+
+    void ReadAllStreams()
+    {
+        for (_INT32 chunkSize : {512, 0x10000, 0x100000})
+        {
+            CompoundFile cf(largeFilePath, CFSUpdateMode::ReadOnly, 0);
+
+            vector<BYTE> buffer(chunkSize);
+            vector<BYTE> pictures;
+            _INT64 total = 0;
+
+            auto start = std::chrono::steady_clock::now();
+
+            cf.RootStorage()->VisitEntries([&](std::shared_ptr<CFItem> item)
+            {
+                if (!item->IsStream())
+                    return;
+
+                auto stream = std::static_pointer_cast<CFStream>(item);
+                bool isPictures = stream->Name() == L"Pictures";
+
+                for (_INT64 pos = 0; pos < stream->size(); pos += chunkSize)
+                {
+                    _INT32 count = (_INT32)(std::min)((_INT64)chunkSize, stream->size() - pos);
+                    EXPECT_EQ(stream->Read(buffer, pos, count), count);
+
+                    if (isPictures)
+                        pictures.insert(pictures.end(), buffer.begin(), buffer.begin() + count);
+                    total += count;
+                }
+            }, true);
+
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            std::cout << "chunk " << chunkSize << ": " << total << " bytes in "
+                      << std::fixed << std::setprecision(1) << elapsed.count() << " ms" << std::endl;
+
+            EXPECT_EQ(pictures, picturesData);
+        }
+    }
+};
+
+TEST_F(ReadBenchmarkTest, readAllStreams)
+{
+    CreateFile(3 * 1024 * 1024 + 123);
+    ReadAllStreams();
+}
+
+TEST_F(ReadBenchmarkTest, DISABLED_readAllStreams70MB)
+{
+    CreateFile(_70MBLen);
+    ReadAllStreams();
+}
@@ -82,6 +82,322 @@ std::wstring g_overrideTmpPath = L"";
 
 #include "File.h"
 
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+// ASCII runs of UTF-8 <-> wchar_t are converted by blocks: SSE2 on x86 (always available on x64),
+// AVX2 when the processor supports it, 8 bytes at a time elsewhere.
+// The scalar code handles everything else, so the output is the same for any input.
+#if (defined(__GNUC__) && defined(__SSE2__)) || \
+	(defined(_MSC_VER) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP == 2)))
+	#include <emmintrin.h>
+	#define UTF8_CONVERTER_SSE2
+	#if defined(__GNUC__) && !defined(__ANDROID__) && (defined(__x86_64__) || defined(__i386__))
+		#include <immintrin.h>
+		#define UTF8_CONVERTER_AVX2 __attribute__((target("avx2")))
+	#elif defined(_MSC_VER)
+		#include <immintrin.h>
+		#include <intrin.h>
+		#define UTF8_CONVERTER_AVX2
+	#endif
+#endif
+
+namespace NSUtf8Ascii
+{
+	static inline unsigned int CountTrailingZeros(unsigned int nMask)
+	{
+#if defined(_MSC_VER)
+		unsigned long nIndex = 0;
+		_BitScanForward(&nIndex, nMask);
+		return (unsigned int)nIndex;
+#elif defined(__GNUC__)
+		return (unsigned int)__builtin_ctz(nMask);
+#else
+		unsigned int nIndex = 0;
+		while (0 == (nMask & 1))
+		{
+			nMask >>= 1;
+			++nIndex;
+		}
+		return nIndex;
+#endif
+	}
+
+	// Each function returns the length of the leading ASCII run that was converted.
+	// The wide output buffer may be written past that length, but never past the number of input bytes.
+	typedef size_t (*FuncToWide)(const BYTE* pSrc, size_t nCount, WCHAR* pDst);
+	typedef size_t (*FuncFromWide)(const wchar_t* pSrc, size_t nCount, BYTE* pDst);
+
+	static size_t ToWide_Scalar(const BYTE* pSrc, size_t nCount, WCHAR* pDst)
+	{
+		size_t i = 0;
+		for (; i + 8 <= nCount; i += 8)
+		{
+			unsigned long long nBlock;
+			memcpy(&nBlock, pSrc + i, 8);
+			if (0 != (nBlock & 0x8080808080808080ULL))
+				break;
+
+			for (size_t j = i; j < i + 8; ++j)
+				pDst[j] = (WCHAR)pSrc[j];
+		}
+		while (i < nCount && pSrc[i] < 0x80)
+		{
+			pDst[i] = (WCHAR)pSrc[i];
+			++i;
+		}
+		return i;
+	}
+	static size_t FromWide_Scalar(const wchar_t* pSrc, size_t nCount, BYTE* pDst)
+	{
+		size_t i = 0;
+		while (i < nCount && (unsigned int)pSrc[i] < 0x80)
+		{
+			pDst[i] = (BYTE)pSrc[i];
+			++i;
+		}
+		return i;
+	}
+
+#ifdef UTF8_CONVERTER_SSE2
+	static size_t ToWide_SSE2(const BYTE* pSrc, size_t nCount, WCHAR* pDst)
+	{
+		const __m128i oZero = _mm_setzero_si128();
+
+		size_t i = 0;
+		for (; i + 16 <= nCount; i += 16)
+		{
+			__m128i oBytes = _mm_loadu_si128((const __m128i*)(pSrc + i));
+			__m128i oLo = _mm_unpacklo_epi8(oBytes, oZero);
+			__m128i oHi = _mm_unpackhi_epi8(oBytes, oZero);
+
+			if (2 == sizeof(WCHAR))
+			{
+				_mm_storeu_si128((__m128i*)(pDst + i), oLo);
+				_mm_storeu_si128((__m128i*)(pDst + i + 8), oHi);
+			}
+			else
+			{
+				_mm_storeu_si128((__m128i*)(pDst + i), _mm_unpacklo_epi16(oLo, oZero));
+				_mm_storeu_si128((__m128i*)(pDst + i + 4), _mm_unpackhi_epi16(oLo, oZero));
+				_mm_storeu_si128((__m128i*)(pDst + i + 8), _mm_unpacklo_epi16(oHi, oZero));
+				_mm_storeu_si128((__m128i*)(pDst + i + 12), _mm_unpackhi_epi16(oHi, oZero));
+			}
+
+			unsigned int nMask = (unsigned int)_mm_movemask_epi8(oBytes);
+			if (0 != nMask)
+				return i + CountTrailingZeros(nMask);
+		}
+		return i + ToWide_Scalar(pSrc + i, nCount - i, pDst + i);
+	}
+	static size_t FromWide_SSE2(const wchar_t* pSrc, size_t nCount, BYTE* pDst)
+	{
+		const __m128i oZero = _mm_setzero_si128();
+
+		size_t i = 0;
+		for (; i + 16 <= nCount; i += 16)
+		{
+			__m128i oBytes, oIsAscii;
+			if (2 == sizeof(wchar_t))
+			{
+				const __m128i oHigh = _mm_set1_epi16((short)0xFF80);
+				__m128i o0 = _mm_loadu_si128((const __m128i*)(pSrc + i));
+				__m128i o1 = _mm_loadu_si128((const __m128i*)(pSrc + i + 8));
+
+				oIsAscii = _mm_packs_epi16(_mm_cmpeq_epi16(_mm_and_si128(o0, oHigh), oZero),
+										   _mm_cmpeq_epi16(_mm_and_si128(o1, oHigh), oZero));
+				oBytes = _mm_packus_epi16(o0, o1);
+			}
+			else
+			{
+				const __m128i oHigh = _mm_set1_epi32(~0x7F);
+				__m128i o0 = _mm_loadu_si128((const __m128i*)(pSrc + i));
+				__m128i o1 = _mm_loadu_si128((const __m128i*)(pSrc + i + 4));
+				__m128i o2 = _mm_loadu_si128((const __m128i*)(pSrc + i + 8));
+				__m128i o3 = _mm_loadu_si128((const __m128i*)(pSrc + i + 12));
+
+				oIsAscii = _mm_packs_epi16(_mm_packs_epi32(_mm_cmpeq_epi32(_mm_and_si128(o0, oHigh), oZero),
+														   _mm_cmpeq_epi32(_mm_and_si128(o1, oHigh), oZero)),
+										   _mm_packs_epi32(_mm_cmpeq_epi32(_mm_and_si128(o2, oHigh), oZero),
+														   _mm_cmpeq_epi32(_mm_and_si128(o3, oHigh), oZero)));
+				oBytes = _mm_packus_epi16(_mm_packs_epi32(o0, o1), _mm_packs_epi32(o2, o3));
+			}
+
+			unsigned int nMask = (unsigned int)_mm_movemask_epi8(oIsAscii);
+			if (0xFFFF != nMask)
+			{
+				// only the run itself - the caller's buffer may end right after the real output
+				BYTE pBlock[16];
+				_mm_storeu_si128((__m128i*)pBlock, oBytes);
+
+				unsigned int nRun = CountTrailingZeros(~nMask);
+				memcpy(pDst + i, pBlock, nRun);
+				return i + nRun;
+			}
+			_mm_storeu_si128((__m128i*)(pDst + i), oBytes);
+		}
+		return i + FromWide_Scalar(pSrc + i, nCount - i, pDst + i);
+	}
+#endif
+
+#ifdef UTF8_CONVERTER_AVX2
+	UTF8_CONVERTER_AVX2 static size_t ToWide_AVX2(const BYTE* pSrc, size_t nCount, WCHAR* pDst)
+	{
+		size_t i = 0;
+		for (; i + 32 <= nCount; i += 32)
+		{
+			__m256i oBytes = _mm256_loadu_si256((const __m256i*)(pSrc + i));
+
+			if (2 == sizeof(WCHAR))
+			{
+				_mm256_storeu_si256((__m256i*)(pDst + i), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(oBytes)));
+				_mm256_storeu_si256((__m256i*)(pDst + i + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(oBytes, 1)));
+			}
+			else
+			{
+				for (size_t j = 0; j < 32; j += 8)
+					_mm256_storeu_si256((__m256i*)(pDst + i + j), _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(pSrc + i + j))));
+			}
+
+			unsigned int nMask = (unsigned int)_mm256_movemask_epi8(oBytes);
+			if (0 != nMask)
+				return i + CountTrailingZeros(nMask);
+		}
+		return i + ToWide_SSE2(pSrc + i, nCount - i, pDst + i);
+	}
+	UTF8_CONVERTER_AVX2 static size_t FromWide_AVX2(const wchar_t* pSrc, size_t nCount, BYTE* pDst)
+	{
+		const __m256i oZero = _mm256_setzero_si256();
+
+		size_t i = 0;
+		for (; i + 32 <= nCount; i += 32)
+		{
+			__m256i oBytes, oIsAscii;
+			if (2 == sizeof(wchar_t))
+			{
+				const __m256i oHigh = _mm256_set1_epi16((short)0xFF80);
+				__m256i o0 = _mm256_loadu_si256((const __m256i*)(pSrc + i));
+				__m256i o1 = _mm256_loadu_si256((const __m256i*)(pSrc + i + 16));
+
+				// pack works inside 128-bit lanes - permute restores the order
+				oIsAscii = _mm256_permute4x64_epi64(_mm256_packs_epi16(_mm256_cmpeq_epi16(_mm256_and_si256(o0, oHigh), oZero),
+																	   _mm256_cmpeq_epi16(_mm256_and_si256(o1, oHigh), oZero)), 0xD8);
+				oBytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(o0, o1), 0xD8);
+			}
+			else
+			{
+				const __m256i oHigh = _mm256_set1_epi32(~0x7F);
+				const __m256i oOrder = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+				__m256i o0 = _mm256_loadu_si256((const __m256i*)(pSrc + i));
+				__m256i o1 = _mm256_loadu_si256((const __m256i*)(pSrc + i + 8));
+				__m256i o2 = _mm256_loadu_si256((const __m256i*)(pSrc + i + 16));
+				__m256i o3 = _mm256_loadu_si256((const __m256i*)(pSrc + i + 24));
+
+				oIsAscii = _mm256_permutevar8x32_epi32(
+							_mm256_packs_epi16(_mm256_packs_epi32(_mm256_cmpeq_epi32(_mm256_and_si256(o0, oHigh), oZero),
+																  _mm256_cmpeq_epi32(_mm256_and_si256(o1, oHigh), oZero)),
+											   _mm256_packs_epi32(_mm256_cmpeq_epi32(_mm256_and_si256(o2, oHigh), oZero),
+																  _mm256_cmpeq_epi32(_mm256_and_si256(o3, oHigh), oZero))), oOrder);
+				oBytes = _mm256_permutevar8x32_epi32(
+							_mm256_packus_epi16(_mm256_packs_epi32(o0, o1), _mm256_packs_epi32(o2, o3)), oOrder);
+			}
+
+			unsigned int nMask = (unsigned int)_mm256_movemask_epi8(oIsAscii);
+			if (0xFFFFFFFF != nMask)
+			{
+				BYTE pBlock[32];
+				_mm256_storeu_si256((__m256i*)pBlock, oBytes);
+
+				unsigned int nRun = CountTrailingZeros(~nMask);
+				memcpy(pDst + i, pBlock, nRun);
+				return i + nRun;
+			}
+			_mm256_storeu_si256((__m256i*)(pDst + i), oBytes);
+		}
+		return i + FromWide_SSE2(pSrc + i, nCount - i, pDst + i);
+	}
+
+	static bool IsAvx2Supported()
+	{
+#if defined(_MSC_VER)
+		int arInfo[4];
+		__cpuid(arInfo, 0);
+		if (arInfo[0] < 7)
+			return false;
+
+		__cpuid(arInfo, 1);
+		const int nOsXSave = 1 << 27, nAvx = 1 << 28;
+		if ((arInfo[2] & (nOsXSave | nAvx)) != (nOsXSave | nAvx))
+			return false;
+		if ((_xgetbv(0) & 6) != 6) // ymm state is saved by the OS
+			return false;
+
+		__cpuidex(arInfo, 7, 0);
+		return 0 != (arInfo[1] & (1 << 5));
+#else
+		return 0 != __builtin_cpu_supports("avx2");
+#endif
+	}
+#endif
+
+	// output buffer of the decoders - most strings are short, so one per thread is reused for them
+	class CWideBuffer
+	{
+	public:
+		CWideBuffer(LONG lSize) : m_pAllocated(NULL)
+		{
+			const size_t nCacheSize = 0x10000;
+			size_t nSize = (size_t)(std::max)(lSize, (LONG)1);
+
+			if (nSize <= nCacheSize)
+			{
+				static thread_local std::vector<WCHAR> arCache;
+				if (arCache.empty())
+					arCache.resize(nCacheSize);
+				m_pData = &arCache[0];
+			}
+			else
+			{
+				m_pData = m_pAllocated = new WCHAR[nSize];
+			}
+		}
+		~CWideBuffer()
+		{
+			if (m_pAllocated)
+				delete [] m_pAllocated;
+		}
+
+		WCHAR* m_pData;
+
+	private:
+		WCHAR* m_pAllocated;
+	};
+
+	static FuncToWide GetToWide()
+	{
+#if defined(UTF8_CONVERTER_AVX2)
+		static const FuncToWide pFunc = IsAvx2Supported() ? ToWide_AVX2 : ToWide_SSE2;
+		return pFunc;
+#elif defined(UTF8_CONVERTER_SSE2)
+		return ToWide_SSE2;
+#else
+		return ToWide_Scalar;
+#endif
+	}
+	static FuncFromWide GetFromWide()
+	{
+#if defined(UTF8_CONVERTER_AVX2)
+		static const FuncFromWide pFunc = IsAvx2Supported() ? FromWide_AVX2 : FromWide_SSE2;
+		return pFunc;
+#elif defined(UTF8_CONVERTER_SSE2)
+		return FromWide_SSE2;
+#else
+		return FromWide_Scalar;
+#endif
+	}
+}
+
 #if defined(_WIN32) || defined(_WIN32_WCE) || defined(_WIN64)
 #include <wchar.h>
 #include <windows.h>
@@ -163,9 +479,12 @@ namespace NSFile
 
 	void CUtf8Converter::GetUnicodeStringFromUTF8_4bytes( BYTE* pBuffer, LONG lCount, std::wstring& sOutput )
 	{
-		WCHAR* pUnicodeString = new WCHAR[lCount + 1];
+		NSUtf8Ascii::CWideBuffer oBuffer(lCount + 1);
+		WCHAR* pUnicodeString = oBuffer.m_pData;
 		LONG lIndexUnicode = 0;
 
+		NSUtf8Ascii::FuncToWide pAsciiToWide = NSUtf8Ascii::GetToWide();
+
 		LONG lIndex = 0;
 		while (lIndex < lCount)
 		{
@@ -173,8 +492,18 @@ namespace NSFile
 			if (0x00 == (byteMain & 0x80))
 			{
 				// 1 byte
-				pUnicodeString[lIndexUnicode++] = (WCHAR)byteMain;
-				++lIndex;
+				if ((lIndex + 1) < lCount && 0x00 == (pBuffer[lIndex + 1] & 0x80))
+				{
+					// the whole ascii run
+					LONG lRun = (LONG)pAsciiToWide(pBuffer + lIndex, (size_t)(lCount - lIndex), pUnicodeString + lIndexUnicode);
+					lIndexUnicode += lRun;
+					lIndex += lRun;
+				}
+				else
+				{
+					pUnicodeString[lIndexUnicode++] = (WCHAR)byteMain;
+					++lIndex;
+				}
 			}
 			else if (0x00 == (byteMain & 0x20))
 			{
@@ -268,16 +597,17 @@ namespace NSFile
 			}
 		}
 
-		pUnicodeString[lIndexUnicode] = 0;
-
-		sOutput.append(pUnicodeString);
-
-		delete [] pUnicodeString;
+		// as a zero-terminated string, the result ends at the first zero char
+		const WCHAR* pZero = std::char_traits<WCHAR>::find(pUnicodeString, (size_t)lIndexUnicode, 0);
+		sOutput.append(pUnicodeString, pZero ? (size_t)(pZero - pUnicodeString) : (size_t)lIndexUnicode);
 	}
 	void CUtf8Converter::GetUnicodeStringFromUTF8_2bytes( BYTE* pBuffer, LONG lCount, std::wstring& sOutput )
 	{
-		WCHAR* pUnicodeString = new WCHAR[lCount + 1];
-		WCHAR* pStart = pUnicodeString;
+		NSUtf8Ascii::CWideBuffer oBuffer(lCount + 1);
+		WCHAR* pStart = oBuffer.m_pData;
+		WCHAR* pUnicodeString = pStart;
+
+		NSUtf8Ascii::FuncToWide pAsciiToWide = NSUtf8Ascii::GetToWide();
 
 		LONG lIndex = 0;
 		while (lIndex < lCount)
@@ -286,8 +616,18 @@ namespace NSFile
 			if (0x00 == (byteMain & 0x80))
 			{
 				// 1 byte
-				*pUnicodeString++ = (WCHAR)byteMain;
-				++lIndex;
+				if ((lIndex + 1) < lCount && 0x00 == (pBuffer[lIndex + 1] & 0x80))
+				{
+					// the whole ascii run
+					LONG lRun = (LONG)pAsciiToWide(pBuffer + lIndex, (size_t)(lCount - lIndex), pUnicodeString);
+					pUnicodeString += lRun;
+					lIndex += lRun;
+				}
+				else
+				{
+					*pUnicodeString++ = (WCHAR)byteMain;
+					++lIndex;
+				}
 			}
 			else if (0x00 == (byteMain & 0x20))
 			{
@@ -381,11 +721,9 @@ namespace NSFile
 			}
 		}
 
-		*pUnicodeString++ = 0;
-
-		sOutput.append(pStart);
-
-		delete [] pStart;
+		// as a zero-terminated string, the result ends at the first zero char
+		const WCHAR* pZero = std::char_traits<WCHAR>::find(pStart, (size_t)(pUnicodeString - pStart), 0);
+		sOutput.append(pStart, (size_t)((pZero ? pZero : pUnicodeString) - pStart));
 	}
 	void CUtf8Converter::GetUnicodeStringFromUTF8( BYTE* pBuffer, LONG lCount, std::wstring& sOutput )
 	{
@@ -657,8 +995,19 @@ namespace NSFile
 		const wchar_t* pEnd = pUnicodes + lCount;
 		const wchar_t* pCur = pUnicodes;
 
+		NSUtf8Ascii::FuncFromWide pAsciiFromWide = NSUtf8Ascii::GetFromWide();
+
 		while (pCur < pEnd)
 		{
+			if ((unsigned int)*pCur < 0x80 && (pCur + 1) < pEnd && (unsigned int)pCur[1] < 0x80)
+			{
+				// the whole ascii run
+				size_t nRun = pAsciiFromWide(pCur, (size_t)(pEnd - pCur), pCodesCur);
+				pCur += nRun;
+				pCodesCur += nRun;
+				continue;
+			}
+
 			unsigned int code = (unsigned int)*pCur++;
 
 			if (code < 0x80)
@@ -725,8 +1074,19 @@ namespace NSFile
 		const wchar_t* pEnd = pUnicodes + lCount;
 		const wchar_t* pCur = pUnicodes;
 
+		NSUtf8Ascii::FuncFromWide pAsciiFromWide = NSUtf8Ascii::GetFromWide();
+
 		while (pCur < pEnd)
 		{
+			if ((unsigned int)*pCur < 0x80 && (pCur + 1) < pEnd && (unsigned int)pCur[1] < 0x80)
+			{
+				// the whole ascii run
+				size_t nRun = pAsciiFromWide(pCur, (size_t)(pEnd - pCur), pCodesCur);
+				pCur += nRun;
+				pCodesCur += nRun;
+				continue;
+			}
+
 			unsigned int code = (unsigned int)*pCur++;
 			if (code >= 0xD800 && code <= 0xDFFF && pCur < pEnd)
 			{
@@ -0,0 +1,100 @@
+/*
+ * (c) Copyright UNIVAULT TECHNOLOGIES 2026-2026
+ *
+ * This program is a free software product. You can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License (AGPL)
+ * version 3 as published by the Free Software Foundation. In accordance with
+ * Section 7(a) of the GNU AGPL its Section 15 shall be amended to the effect
+ * that UNIVAULT TECHNOLOGIES expressly excludes the warranty of non-infringement
+ * of any third-party rights.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR  PURPOSE. For
+ * details, see the GNU AGPL at: http://www.gnu.org/licenses/agpl-3.0.html
+ *
+ * You can contact UNIVAULT TECHNOLOGIES at 20A-6 Ernesta Birznieka-Upish
+ * street, Moscow (TEST), Russia (TEST), EU, 000000 (TEST).
+ *
+ * The  interactive user interfaces in modified source and object code versions
+ * of the Program must display Appropriate Legal Notices, as required under
+ * Section 5 of the GNU AGPL version 3.
+ *
+ * Pursuant to Section 7(b) of the License you must retain the original Product
+ * logo when distributing the program. Pursuant to Section 7(e) we decline to
+ * grant you any rights under trademark law for use of our trademarks.
+ *
+ * All the Product's GUI elements, including illustrations and icon sets, as
+ * well as technical writing content are licensed under the terms of the
+ * Creative Commons Attribution-ShareAlike 4.0 International. See the License
+ * terms at http://creativecommons.org/licenses/by-sa/4.0/legalcode
+ *
+ */
+#include "../../File.h"
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+// GB/s of NSFile::CUtf8Converter on typical office content: markup (pure ASCII),
+// russian text in markup (mixed) and chinese text (no ASCII runs at all).
+
+static std::wstring CreateText(const std::wstring& sPiece, size_t nSize)
+{
+	std::wstring sText;
+	while (sText.length() < nSize)
+		sText += sPiece;
+	return sText;
+}
+
+static void Run(const std::string& sName, const std::wstring& sText)
+{
+	// strings of the size the xml reader and the writers usually deal with
+	const size_t nPiece = 4096;
+	const int nRepeat = 50;
+
+	std::vector<std::string> arUtf8;
+	for (size_t nPos = 0; nPos < sText.length(); nPos += nPiece)
+		arUtf8.push_back(NSFile::CUtf8Converter::GetUtf8StringFromUnicode(sText.substr(nPos, nPiece)));
+
+	std::vector<std::wstring> arWide(arUtf8.size());
+	std::vector<std::string> arUtf8Back(arUtf8.size());
+	size_t nBytes = 0;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < nRepeat; ++i)
+	{
+		for (size_t j = 0; j < arUtf8.size(); ++j)
+			arWide[j] = NSFile::CUtf8Converter::GetUnicodeStringFromUTF8((BYTE*)arUtf8[j].c_str(), (LONG)arUtf8[j].length());
+	}
+	std::chrono::duration<double> dDecode = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < nRepeat; ++i)
+	{
+		for (size_t j = 0; j < arWide.size(); ++j)
+			arUtf8Back[j] = NSFile::CUtf8Converter::GetUtf8StringFromUnicode(arWide[j]);
+	}
+	std::chrono::duration<double> dEncode = std::chrono::steady_clock::now() - start;
+
+	for (size_t j = 0; j < arUtf8.size(); ++j)
+		nBytes += arUtf8[j].length();
+
+	double dGBytes = (double)nBytes * nRepeat / 1e9;
+
+	std::cout << std::left << std::setw(10) << sName << std::fixed << std::setprecision(2)
+			  << "utf8 -> wchar_t " << dGBytes / dDecode.count() << " GB/s, "
+			  << "wchar_t -> utf8 " << dGBytes / dEncode.count() << " GB/s"
+			  << ((arUtf8Back == arUtf8) ? "" : "  RESULTS DIFFER") << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+	const size_t nSize = 4 * 1024 * 1024;
+
+	Run("ascii", CreateText(L"<w:r><w:rPr><w:rFonts w:ascii=\"Calibri\"/><w:sz w:val=\"24\"/></w:rPr><w:t xml:space=\"preserve\">Total </w:t></w:r>", nSize));
+	Run("mixed", CreateText(L"<c r=\"B12\" t=\"s\"><v>17</v></c><si><t>\x0418\x0442\x043E\x0433\x043E \x043F\x043E \x0440\x0430\x0437\x0434\x0435\x043B\x0443</t></si>", nSize));
+	Run("cjk", CreateText(L"\x6587\x6863\x8F6C\x6362\x670D\x52A1\x5668\x652F\x6301\x591A\x79CD\x683C\x5F0F", nSize));
+
+	return 0;
+}
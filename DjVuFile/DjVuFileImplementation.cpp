@@ -41,11 +41,15 @@
 #include "../DesktopEditor/graphics/pro/Image.h"
 
 #include "../DesktopEditor/common/StringExt.h"
+#include "../DesktopEditor/graphics/BaseThread.h"
 
 #define VER_DPI		96
 #define HOR_DPI		96
+#define MAX_PDF_THREADS 8u
 
 #include <vector>
+#include <atomic>
+#include <thread>
 
 #include "../DesktopEditor/graphics/pro/js/wasm/src/serialize.h"
 
@@ -95,10 +99,10 @@ namespace NSDjvu
 			  return red;
 	  return 1;
 	}
-	static void DrawPixmap(GP<GPixmap> pImage, Aggplus::CImage* pImageRes)
+	static void DrawPixmap(GPixmap& oImage, Aggplus::CImage* pImageRes)
 	{
-		unsigned int unPixmapH = pImage->rows();
-		unsigned int unPixmapW = pImage->columns();
+		unsigned int unPixmapH = oImage.rows();
+		unsigned int unPixmapW = oImage.columns();
 		BYTE* pBufferDst = new BYTE[4 * unPixmapH * unPixmapW];
 		if (!pBufferDst)
 			return;
@@ -108,7 +112,7 @@ namespace NSDjvu
 		BYTE* pBuffer = pBufferDst;
 		for (int j = unPixmapH - 1; j >= 0; --j)
 		{
-			GPixel* pLine = pImage->operator [](j);
+			GPixel* pLine = oImage[j];
 
 			for (int i = 0; i < unPixmapW; ++i, pBuffer += 4, ++pLine)
 			{
@@ -119,6 +123,171 @@ namespace NSDjvu
 			}
 		}
 	}
+
+	// наибольшее прореживание IW44 (степень двойки), при котором картинка не меньше нужной
+	static int ComputeSubsample(int w, int h, int rw, int rh)
+	{
+		int nSubsample = 1;
+		while (nSubsample < 32 && w / (2 * nSubsample) >= rw && h / (2 * nSubsample) >= rh)
+			nSubsample *= 2;
+		return nSubsample;
+	}
+
+	// растры страницы для pdf. готовятся отдельно от записи, чтобы страницы
+	// можно было растрировать в нескольких потоках
+	class CPdfFrame
+	{
+	public:
+		// результаты libdjvu (RenderPdfFrame, под блокировкой документа).
+		// В растры переводятся без блокировки (ConvertPdfFrame), освобождаются снова под блокировкой
+		GP<GPixmap> pPixmap;   // фон (или вся страница)
+		GP<GPixmap> pFgPixmap; // передний план под маской pBitmap
+		GP<GBitmap> pBitmap;
+		bool bBitmapMask;      // pBitmap - 1bpp маска, иначе страница в оттенках серого
+		LONG lImageWidth;
+		LONG lImageHeight;
+
+		double dWidth;
+		double dHeight;
+
+		XmlUtils::CXmlNode oText;
+		double dTextKoef;
+
+		Aggplus::CImage*     pImage;       // фон (или вся страница)
+		Aggplus::CImage*     pMaskedImage; // передний план под маской
+		NSImages::CPixJbig2* pMask;
+		LONG lMaskWidth;
+		LONG lMaskHeight;
+
+		CPdfFrame()
+		{
+			bBitmapMask  = false;
+			lImageWidth  = 0;
+			lImageHeight = 0;
+			dWidth       = 0;
+			dHeight      = 0;
+			dTextKoef    = 1;
+			pImage       = NULL;
+			pMaskedImage = NULL;
+			pMask        = NULL;
+			lMaskWidth   = 0;
+			lMaskHeight  = 0;
+		}
+		void ReleaseDjVuData()
+		{
+			pPixmap   = NULL;
+			pFgPixmap = NULL;
+			pBitmap   = NULL;
+		}
+
+		CPdfFrame(const CPdfFrame&) = delete;
+		CPdfFrame& operator=(const CPdfFrame&) = delete;
+		~CPdfFrame()
+		{
+			RELEASEOBJECT(pImage);
+			RELEASEOBJECT(pMaskedImage);
+			if (pMask)
+			{
+				pMask->Destroy();
+				delete pMask;
+			}
+		}
+	};
+
+	static bool CreateMask(GBitmap& oBitmap, LONG lWidth, LONG lHeight, CPdfFrame& oFrame)
+	{
+		NSImages::CPixJbig2* pPix = new NSImages::CPixJbig2();
+		if (!pPix->Create(lWidth, lHeight, 1))
+		{
+			delete pPix;
+			return false;
+		}
+
+		for (int nY = 0; nY < lHeight; nY++)
+		{
+			BYTE* pLine = oBitmap[nY];
+			for (int nX = 0; nX < lWidth; nX++, pLine++)
+			{
+				pPix->SetPixel(nX, lHeight - 1 - nY, *pLine);
+			}
+		}
+
+		oFrame.pMask       = pPix;
+		oFrame.lMaskWidth  = lWidth;
+		oFrame.lMaskHeight = lHeight;
+		return true;
+	}
+
+	static void CreateGrayImage(GBitmap& oBitmap, LONG lImageWidth, LONG lImageHeight, CPdfFrame& oFrame)
+	{
+		int nPaletteEntries = oBitmap.get_grays();
+
+		BYTE* pBufferDst = new BYTE[4 * lImageHeight * lImageWidth];
+		if (!pBufferDst)
+			return;
+
+		oFrame.pImage = new Aggplus::CImage();
+		oFrame.pImage->Create(pBufferDst, lImageWidth, lImageHeight, 4 * lImageWidth);
+
+		unsigned int* palette = new unsigned int[nPaletteEntries];
+
+		// Create palette for the bitmap
+		int color = 0xff0000;
+		int decrement = color / (nPaletteEntries - 1);
+		for (int i = 0; i < nPaletteEntries; ++i)
+		{
+			BYTE level = (BYTE)(color >> 16);
+			palette[i] = (0xFF000000 | level << 16 | level << 8 | level);
+			color -= decrement;
+		}
+
+		unsigned int* pBuffer = (unsigned int*)pBufferDst;
+		for (int j = lImageHeight - 1; j >= 0; --j)
+		{
+			BYTE* pLine = oBitmap[j];
+
+			for (int i = 0; i < lImageWidth; ++i, ++pBuffer, ++pLine)
+			{
+				if (*pLine < nPaletteEntries)
+				{
+					*pBuffer = palette[*pLine];
+				}
+				else
+				{
+					*pBuffer = palette[0];
+				}
+			}
+		}
+
+		RELEASEARRAYOBJECTS(palette);
+	}
+
+	// перевод готовых pixmap/bitmap в растры для pdf. libdjvu не вызывается, поэтому выполняется
+	// без блокировки документа - GPixmap и GBitmap кадра принадлежат только ему и здесь только читаются
+	static void ConvertPdfFrame(CPdfFrame& oFrame)
+	{
+		if (NULL != oFrame.pPixmap)
+		{
+			oFrame.pImage = new Aggplus::CImage();
+			DrawPixmap(*oFrame.pPixmap, oFrame.pImage);
+		}
+
+		if (NULL == oFrame.pBitmap)
+			return;
+
+		if (NULL != oFrame.pFgPixmap)
+		{
+			if (CreateMask(*oFrame.pBitmap, oFrame.lImageWidth, oFrame.lImageHeight, oFrame))
+			{
+				oFrame.pMaskedImage = new Aggplus::CImage();
+				DrawPixmap(*oFrame.pFgPixmap, oFrame.pMaskedImage);
+			}
+		}
+		else if (oFrame.bBitmapMask)
+			CreateMask(*oFrame.pBitmap, oFrame.lImageWidth, oFrame.lImageHeight, oFrame);
+		else
+			CreateGrayImage(*oFrame.pBitmap, oFrame.lImageWidth, oFrame.lImageHeight, oFrame);
+	}
 }
 
 CDjVuFileImplementation::CDjVuFileImplementation(NSFonts::IApplicationFonts* pFonts)
@@ -127,12 +296,14 @@ CDjVuFileImplementation::CDjVuFileImplementation(NSFonts::IApplicationFonts* pFo
 	m_wsTempDirectory = L"";
 	SetTempDirectory(L"");
 	m_pApplicationFonts = pFonts;
+	m_oDocumentCS.InitializeCriticalSection();
 }
 CDjVuFileImplementation::~CDjVuFileImplementation()
 {
 #ifndef DISABLE_TEMP_DIRECTORY
 	NSDirectory::DeleteDirectory(m_wsTempDirectory);
 #endif
+	m_oDocumentCS.DeleteCriticalSection();
 }
 NSFonts::IApplicationFonts* CDjVuFileImplementation::GetFonts()
 {
@@ -258,32 +429,120 @@ void  CDjVuFileImplementation::DrawPageOnRenderer(IRenderer* pRenderer, int nPag
 		// белая страница
 	}
 }
+class CPdfPagesThread : public NSThreads::CBaseThread
+{
+	CDjVuFileImplementation* m_pFile;
+	int m_nFirstPage;
+	std::vector<NSDjvu::CPdfFrame>& m_arFrames;
+	std::atomic<size_t>& m_nNext;
+public:
+	CPdfPagesThread(CDjVuFileImplementation* pFile, int nFirstPage, std::vector<NSDjvu::CPdfFrame>& arFrames, std::atomic<size_t>& nNext)
+		: m_pFile(pFile), m_nFirstPage(nFirstPage), m_arFrames(arFrames), m_nNext(nNext)
+	{}
+	virtual ~CPdfPagesThread()
+	{}
+protected:
+	virtual DWORD ThreadProc()
+	{
+		for (size_t nIndex = m_nNext++; nIndex < m_arFrames.size(); nIndex = m_nNext++)
+			m_pFile->RenderPdfPage(m_nFirstPage + (int)nIndex, m_arFrames[nIndex]);
+
+		return 0;
+	}
+};
+
 void CDjVuFileImplementation::ConvertToPdf(const std::wstring& wsDstPath)
 {
 	CPdfFile oPdf(m_pApplicationFonts);
 	oPdf.CreatePdf();
-	
-	bool bBreak = false;
-	for (int nPageIndex = 0, nPagesCount = GetPagesCount(); nPageIndex < nPagesCount; nPageIndex++)
+	oPdf.StartStreaming(wsDstPath);
+
+	int nPagesCount = GetPagesCount();
+	unsigned int unThreads = (std::min)(std::thread::hardware_concurrency(), MAX_PDF_THREADS);
+
+	// страницы растрируются пачками в нескольких потоках, а в pdf пишутся по порядку,
+	// поэтому в памяти держится не больше одной пачки растров
+	int nBatch = (std::max)(1, (int)unThreads * 2);
+	for (int nBatchStart = 0; nBatchStart < nPagesCount; nBatchStart += nBatch)
 	{
-		oPdf.NewPage();
+		std::vector<NSDjvu::CPdfFrame> arFrames((std::min)(nBatch, nPagesCount - nBatchStart));
+		unsigned int unBatchThreads = (std::min)(unThreads, (unsigned int)arFrames.size());
 
-		double dPageDpiX, dPageDpiY;
-		double dWidth, dHeight;
-		GetPageInfo(nPageIndex, &dWidth, &dHeight, &dPageDpiX, &dPageDpiY);
-		dWidth  *= 25.4 / dPageDpiX;
-		dHeight *= 25.4 / dPageDpiY;
-		oPdf.put_Width(dWidth);
-		oPdf.put_Height(dHeight);
+		if (unBatchThreads < 2)
+		{
+			for (size_t nIndex = 0; nIndex < arFrames.size(); ++nIndex)
+				RenderPdfPage(nBatchStart + (int)nIndex, arFrames[nIndex]);
+		}
+		else
+		{
+			std::atomic<size_t> nNext(0);
+			std::vector<CPdfPagesThread*> arThreads;
+
+			for (unsigned int unIndex = 0; unIndex < unBatchThreads; ++unIndex)
+			{
+				arThreads.push_back(new CPdfPagesThread(this, nBatchStart, arFrames, nNext));
+				arThreads.back()->Start(0);
+			}
+
+			for (CPdfPagesThread* pThread : arThreads)
+			{
+				pThread->Stop();
+				delete pThread;
+			}
+		}
 
-		DrawPageOnRenderer(&oPdf, nPageIndex, &bBreak);
+		for (size_t nIndex = 0; nIndex < arFrames.size(); ++nIndex)
+		{
+			int nPageIndex = nBatchStart + (int)nIndex;
+			oPdf.NewPage();
+
+			double dPageDpiX, dPageDpiY;
+			double dWidth, dHeight;
+			GetPageInfo(nPageIndex, &dWidth, &dHeight, &dPageDpiX, &dPageDpiY);
+			dWidth  *= 25.4 / dPageDpiX;
+			dHeight *= 25.4 / dPageDpiY;
+			oPdf.put_Width(dWidth);
+			oPdf.put_Height(dHeight);
+
+			DrawPdfFrame(&oPdf, arFrames[nIndex]);
 #ifdef _DEBUG
-		printf("%d of %d pages\n", nPageIndex + 1, nPagesCount);
+			printf("%d of %d pages\n", nPageIndex + 1, nPagesCount);
 #endif
+		}
 	}
 
 	oPdf.SaveToFile(wsDstPath);
 }
+void CDjVuFileImplementation::RenderPdfPage(int nPageIndex, NSDjvu::CPdfFrame& oFrame)
+{
+	GP<DjVuImage> pPage;
+	try
+	{
+		{
+			// libdjvu собирается без поддержки потоков, и get_pixmap/get_bitmap страницы
+			// используют общие с документом кэши и счетчики ссылок. Поэтому все вызовы libdjvu
+			// (и освобождение ее объектов) только под блокировкой, параллельно - только перевод в растры
+			CTemporaryCS oCS(&m_oDocumentCS);
+			pPage = m_pDoc->get_page(nPageIndex);
+			pPage->wait_for_complete_decode();
+			pPage->set_rotate(0);
+
+			XmlUtils::CXmlNode oText = ParseText(pPage);
+			InitPdfFrame(pPage, nPageIndex, oText, oFrame);
+			RenderPdfFrame(pPage, oFrame);
+		}
+
+		NSDjvu::ConvertPdfFrame(oFrame);
+	}
+	catch (...)
+	{
+		// белая страница
+	}
+
+	CTemporaryCS oCS(&m_oDocumentCS);
+	oFrame.ReleaseDjVuData();
+	pPage = NULL;
+}
 std::wstring CDjVuFileImplementation::GetInfo()
 {
 	std::wstring sRes = L"{";
@@ -508,21 +767,30 @@ void CDjVuFileImplementation::CreateFrame(IRenderer* pRenderer, GP<DjVuImage>& p
 	pRenderer->EndCommand(c_nPageType);
 }
 void CDjVuFileImplementation::CreatePdfFrame(IRenderer* pRenderer, GP<DjVuImage>& pPage, int nPageIndex, XmlUtils::CXmlNode& oText)
+{
+	NSDjvu::CPdfFrame oFrame;
+	InitPdfFrame(pPage, nPageIndex, oText, oFrame);
+	RenderPdfFrame(pPage, oFrame);
+	NSDjvu::ConvertPdfFrame(oFrame);
+	oFrame.ReleaseDjVuData();
+	DrawPdfFrame(pRenderer, oFrame);
+}
+void CDjVuFileImplementation::InitPdfFrame(GP<DjVuImage>& pPage, int nPageIndex, XmlUtils::CXmlNode& oText, NSDjvu::CPdfFrame& oFrame)
 {
 	double dPageDpiX, dPageDpiY;
-	double dWidth, dHeight;
-	GetPageInfo(nPageIndex, &dWidth, &dHeight, &dPageDpiX, &dPageDpiY);
-	dWidth  *= 25.4 / dPageDpiX;
-	dHeight *= 25.4 / dPageDpiY;
-
-	pRenderer->BeginCommand(c_nPageType);
-
-	TextToRenderer(pRenderer, oText, 25.4 / pPage->get_dpi());
+	GetPageInfo(nPageIndex, &oFrame.dWidth, &oFrame.dHeight, &dPageDpiX, &dPageDpiY);
+	oFrame.dWidth  *= 25.4 / dPageDpiX;
+	oFrame.dHeight *= 25.4 / dPageDpiY;
 
+	oFrame.oText     = oText;
+	oFrame.dTextKoef = 25.4 / pPage->get_dpi();
+}
+void CDjVuFileImplementation::RenderPdfFrame(GP<DjVuImage>& pPage, NSDjvu::CPdfFrame& oFrame)
+{
 	LONG lImageWidth  = pPage->get_real_width();
 	LONG lImageHeight = pPage->get_real_height();
-	double dImageRedW = dWidth  * 72.0 / 25.4 * 2.0;
-	double dImageRedH = dHeight * 72.0 / 25.4 * 2.0;
+	double dImageRedW = oFrame.dWidth  * 72.0 / 25.4 * 2.0;
+	double dImageRedH = oFrame.dHeight * 72.0 / 25.4 * 2.0;
 	LONG lRed = std::min(lImageWidth / dImageRedW, lImageHeight / dImageRedH);
 	if (lRed > 1)
 	{
@@ -530,190 +798,75 @@ void CDjVuFileImplementation::CreatePdfFrame(IRenderer* pRenderer, GP<DjVuImage>
 		lImageHeight /= lRed;
 	}
 
-	CPdfFile* pPdf = (CPdfFile*)pRenderer;
+	oFrame.lImageWidth  = lImageWidth;
+	oFrame.lImageHeight = lImageHeight;
+
+	GRect oRectAll(0, 0, lImageWidth, lImageHeight);
 
 	if (pPage->is_legal_photo())
 	{
-		BYTE* pBufferDst = new BYTE[4 * lImageHeight * lImageWidth];
-		if (!pBufferDst)
-			return;
-
-		Aggplus::CImage oImage;
-		oImage.Create(pBufferDst, lImageWidth, lImageHeight, 4 * lImageWidth);
-
-		GRect oRectAll(0, 0, lImageWidth, lImageHeight);
-		GP<GPixmap> pImage = pPage->get_pixmap(oRectAll, oRectAll);
-
-		BYTE* pBuffer = pBufferDst;
-		for (int j = lImageHeight - 1; j >= 0; --j)
-		{
-			GPixel* pLine = pImage->operator [](j);
-
-			for (int i = 0; i < lImageWidth; ++i, pBuffer += 4, ++pLine)
-			{
-				pBuffer[0] = pLine->b;
-				pBuffer[1] = pLine->g;
-				pBuffer[2] = pLine->r;
-				pBuffer[3] = 255;
-			}
-		}
-		pRenderer->DrawImage((IGrObject*)&oImage, 0, 0, dWidth, dHeight);
+		oFrame.pPixmap = pPage->get_pixmap(oRectAll, oRectAll);
 	}
 	else if (pPage->is_legal_compound())
 	{
 		GP<IW44Image> pIW44Image = pPage->get_bg44();
 		if (NULL != pIW44Image)
 		{
-			GP<GPixmap> pBgImage = pIW44Image->get_pixmap();
-			if (NULL != pBgImage)
+			// фон восстанавливаем сразу в нужном разрешении
+			int nSubsample = NSDjvu::ComputeSubsample(pIW44Image->get_width(), pIW44Image->get_height(), lImageWidth, lImageHeight);
+			if (nSubsample > 1)
 			{
-				Aggplus::CImage oImage;
-				NSDjvu::DrawPixmap(pBgImage, &oImage);
-				pRenderer->DrawImage((IGrObject*)&oImage, 0, 0, dWidth, dHeight);
+				GRect oRectBg(0, 0, (pIW44Image->get_width() + nSubsample - 1) / nSubsample, (pIW44Image->get_height() + nSubsample - 1) / nSubsample);
+				oFrame.pPixmap = pIW44Image->get_pixmap(nSubsample, oRectBg);
 			}
+			else
+				oFrame.pPixmap = pIW44Image->get_pixmap();
 		}
 		else
-		{
-			GP<GPixmap> pBgImage = pPage->get_bgpm();
-			if (NULL != pBgImage)
-			{
-				Aggplus::CImage oImage;
-				NSDjvu::DrawPixmap(pBgImage, &oImage);
-				pRenderer->DrawImage((IGrObject*)&oImage, 0, 0, dWidth, dHeight);
-			}
-		}
-		
-		GRect oRectAll(0, 0, lImageWidth, lImageHeight);
-		GP<GPixmap> pImage = pPage->get_fgpm();
-		if (NULL == pImage)
-			pImage = pPage->get_fg_pixmap(oRectAll, oRectAll);
+			oFrame.pPixmap = pPage->get_bgpm();
 
-		if (NULL != pImage)
-		{
-			Aggplus::CImage oImage;
-			NSDjvu::DrawPixmap(pImage, &oImage);
-
-			GP<GBitmap> pBitmap = pPage->get_bitmap(oRectAll, oRectAll, 4);
-
-			NSImages::CPixJbig2 oPix;
-			if (oPix.Create(lImageWidth, lImageHeight, 1))
-			{
-				for (int nY = 0; nY < lImageHeight; nY++)
-				{
-					BYTE* pLine = pBitmap->operator [](nY);
-					for (int nX = 0; nX < lImageWidth; nX++, pLine++)
-					{
-						oPix.SetPixel(nX, lImageHeight - 1 - nY, *pLine);
-					}
-				}
+		oFrame.pFgPixmap = pPage->get_fgpm();
+		if (NULL == oFrame.pFgPixmap)
+			oFrame.pFgPixmap = pPage->get_fg_pixmap(oRectAll, oRectAll);
 
-				pPdf->DrawImageWith1bppMask((IGrObject*)&oImage, &oPix, lImageWidth, lImageHeight, 0, 0, dWidth, dHeight);
-				oPix.Destroy();
-			}
-		}
+		if (NULL != oFrame.pFgPixmap)
+			oFrame.pBitmap = pPage->get_bitmap(oRectAll, oRectAll, 4);
 	}
 	else if (pPage->is_legal_bilevel())
 	{
-		GRect oRectAll(0, 0, lImageWidth, lImageHeight);
-		GP<GBitmap> pBitmap = pPage->get_bitmap(oRectAll, oRectAll, 4);
-
-		NSImages::CPixJbig2 oPix;
-		if (oPix.Create(lImageWidth, lImageHeight, 1))
-		{
-			for (int nY = 0; nY < lImageHeight; nY++)
-			{
-				BYTE* pLine = pBitmap->operator [](nY);
-				for (int nX = 0; nX < lImageWidth; nX++, pLine++)
-				{
-					oPix.SetPixel(nX, lImageHeight - 1 - nY, *pLine);
-				}
-			}
-
-			pPdf->DrawImage1bpp(&oPix, lImageWidth, lImageHeight, 0, 0, dWidth, dHeight);
-			oPix.Destroy();
-		}
+		oFrame.pBitmap = pPage->get_bitmap(oRectAll, oRectAll, 4);
+		oFrame.bBitmapMask = true;
 	}
 	else
 	{
 		// белый фрейм??
-		//memset(pBufferDst, 0xFF, 4 * lImageWidth * lImageHeight);
-		GRect oRectAll(0, 0, lImageWidth, lImageHeight);
-		GP<GPixmap> pImage = pPage->get_pixmap(oRectAll, oRectAll);
+		oFrame.pPixmap = pPage->get_pixmap(oRectAll, oRectAll);
 
-		if (NULL != pImage)
+		if (NULL == oFrame.pPixmap)
 		{
-			Aggplus::CImage oImage;
-			NSDjvu::DrawPixmap(pImage, &oImage);
-			pRenderer->DrawImage((IGrObject*)&oImage, 0, 0, dWidth, dHeight);
+			oFrame.pBitmap = pPage->get_bitmap(oRectAll, oRectAll, 4);
+			if (NULL != oFrame.pBitmap)
+				oFrame.bBitmapMask = oFrame.pBitmap->get_grays() <= 2;
 		}
+	}
+}
+void CDjVuFileImplementation::DrawPdfFrame(IRenderer* pRenderer, NSDjvu::CPdfFrame& oFrame)
+{
+	CPdfFile* pPdf = (CPdfFile*)pRenderer;
+
+	pRenderer->BeginCommand(c_nPageType);
+
+	TextToRenderer(pRenderer, oFrame.oText, oFrame.dTextKoef);
+
+	if (oFrame.pImage)
+		pRenderer->DrawImage((IGrObject*)oFrame.pImage, 0, 0, oFrame.dWidth, oFrame.dHeight);
+
+	if (oFrame.pMask)
+	{
+		if (oFrame.pMaskedImage)
+			pPdf->DrawImageWith1bppMask((IGrObject*)oFrame.pMaskedImage, oFrame.pMask, oFrame.lMaskWidth, oFrame.lMaskHeight, 0, 0, oFrame.dWidth, oFrame.dHeight);
 		else
-		{
-			GP<GBitmap> pBitmap = pPage->get_bitmap(oRectAll, oRectAll, 4);
-			if (NULL != pBitmap)
-			{
-				int nPaletteEntries = pBitmap->get_grays();
-				if (nPaletteEntries <= 2)
-				{
-					NSImages::CPixJbig2 oPix;
-					if (oPix.Create(lImageWidth, lImageHeight, 1))
-					{
-						for (int nY = 0; nY < lImageHeight; nY++)
-						{
-							BYTE* pLine = pBitmap->operator [](nY);
-							for (int nX = 0; nX < lImageWidth; nX++, pLine++)
-							{
-								oPix.Create(nX, lImageHeight - 1 - nY, *pLine);
-							}
-						}
-
-						pPdf->DrawImage1bpp(&oPix, lImageWidth, lImageHeight, 0, 0, dWidth, dHeight);
-						oPix.Destroy();
-					}
-				}
-				else
-				{
-					BYTE* pBufferDst = new BYTE[4 * lImageHeight * lImageWidth];
-					if (!pBufferDst)
-						return;
-
-					Aggplus::CImage oImage;
-					oImage.Create(pBufferDst, lImageWidth, lImageHeight, 4 * lImageWidth);
-
-					unsigned int* palette = new unsigned int[nPaletteEntries];
-
-					// Create palette for the bitmap
-					int color = 0xff0000;
-					int decrement = color / (nPaletteEntries - 1);
-					for (int i = 0; i < nPaletteEntries; ++i)
-					{
-						BYTE level = (BYTE)(color >> 16);
-						palette[i] = (0xFF000000 | level << 16 | level << 8 | level);
-						color -= decrement;
-					}
-
-					unsigned int* pBuffer = (unsigned int*)pBufferDst;
-					for (int j = lImageHeight - 1; j >= 0; --j)
-					{
-						BYTE* pLine = pBitmap->operator [](j);
-
-						for (int i = 0; i < lImageWidth; ++i, ++pBuffer, ++pLine)
-						{
-							if (*pLine < nPaletteEntries)
-							{
-								*pBuffer = palette[*pLine];
-							}
-							else
-							{
-								*pBuffer = palette[0];
-							}
-						}
-					}
-
-					RELEASEARRAYOBJECTS(palette);
-					pRenderer->DrawImage((IGrObject*)&oImage, 0, 0, dWidth, dHeight);
-				}
-			}
-		}
+			pPdf->DrawImage1bpp(oFrame.pMask, oFrame.lMaskWidth, oFrame.lMaskHeight, 0, 0, oFrame.dWidth, oFrame.dHeight);
 	}
 
 	pRenderer->EndCommand(c_nPageType);
@@ -50,6 +50,12 @@
 #include "../DesktopEditor/xml/include/xmlutils.h"
 #include "../DesktopEditor/graphics/IRenderer.h"
 #include "../DesktopEditor/graphics/pro/Fonts.h"
+#include "../DesktopEditor/graphics/TemporaryCS.h"
+
+namespace NSDjvu
+{
+	class CPdfFrame;
+}
 
 class CDjVuFileImplementation
 {
@@ -57,6 +63,7 @@ private:
     std::wstring     m_wsTempDirectory;
 	GP<DjVuDocument> m_pDoc;
     NSFonts::IApplicationFonts* m_pApplicationFonts;
+	NSCriticalSection::CRITICAL_SECTION m_oDocumentCS;
 
 public:
 
@@ -81,12 +88,18 @@ public:
 
 	unsigned char* ConvertToPixels(int nPageIndex, int nRasterW, int nRasterH, bool bIsFlip = false);
 
+	// безопасно вызывать из нескольких потоков
+	void         RenderPdfPage(int nPageIndex, NSDjvu::CPdfFrame& oFrame);
+
 private:
 
 	unsigned char* ConvertToPixels(GP<DjVuImage>& pPage, int nRasterW, int nRasterH, bool bIsFlip = false);
 
 	void               CreateFrame(IRenderer* pRenderer, GP<DjVuImage>& pImage, int nPage, XmlUtils::CXmlNode& oText);
     void               CreatePdfFrame(IRenderer* pRenderer, GP<DjVuImage>& pImage, int nPage, XmlUtils::CXmlNode& oText);
+	void               InitPdfFrame(GP<DjVuImage>& pImage, int nPage, XmlUtils::CXmlNode& oText, NSDjvu::CPdfFrame& oFrame);
+	void               RenderPdfFrame(GP<DjVuImage>& pImage, NSDjvu::CPdfFrame& oFrame);
+	void               DrawPdfFrame(IRenderer* pRenderer, NSDjvu::CPdfFrame& oFrame);
 	XmlUtils::CXmlNode ParseText(GP<DjVuImage> pPage);
 	void               TextToRenderer(IRenderer* pRenderer, XmlUtils::CXmlNode text, double koef, bool isView = true);
 	void               DrawPageText(IRenderer* pRenderer, double* pdCoords, const std::wstring& wsText);
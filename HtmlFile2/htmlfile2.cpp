@@ -7,7 +7,7 @@
 #include <algorithm>
 #include <iostream>
 
-#include "../Common/3dParty/html/htmltoxhtml.h"
+#include "../Common/3dParty/html/gumboreader.h"
 #include "../Common/3dParty/html/css/src/CCssCalculator.h"
 #include "../Common/3dParty/html/css/src/xhtml/CDocumentStyle.h"
 #include "../Common/Network/FileTransporter/include/FileTransporter.h"
@@ -874,7 +874,7 @@ public:
 		: m_unSpan(unSpan)
 	{}
 
-	CTableCol(XmlUtils::CXmlLiteReader& oLiteReader)
+	CTableCol(CGumboReader& oLiteReader)
 		: m_unSpan(1)
 	{
 		while (oLiteReader.MoveToNextAttribute())
@@ -908,7 +908,7 @@ private:
 class CTableColgroup
 {
 public:
-	CTableColgroup(XmlUtils::CXmlLiteReader& oLiteReader)
+	CTableColgroup(CGumboReader& oLiteReader)
 		: m_unWidth(0)
 	{
 		while (oLiteReader.MoveToNextAttribute())
@@ -1448,7 +1448,7 @@ bool CanUseThisPath(const std::wstring& wsPath, const std::wstring& wsSrcPath, c
 class CHtmlFile2_Private
 {
 public:
-	XmlUtils::CXmlLiteReader m_oLightReader;   // SAX Reader
+	CGumboReader m_oLightReader;               // SAX Reader
 	NSCSS::CCssCalculator m_oStylesCalculator; // Css калькулятор
 	NSCSS::CDocumentStyle m_oXmlStyle;         // Ooxml стиль
 
@@ -1878,20 +1878,20 @@ public:
 				sFileContent.replace(nFind, nFindEnd - nFind, "1.0");
 		}
 
-		const std::wstring sRes{htmlToXhtml(sFileContent, bNeedConvert)};
+		const bool bRes = m_oLightReader.FromHtml(sFileContent, bNeedConvert);
 
 		#ifdef SAVE_NORMALIZED_HTML
 		#if 1 == SAVE_NORMALIZED_HTML
 		NSFile::CFileBinary oWriter;
 		if (oWriter.CreateFileW(m_sTmp + L"/res.html"))
 		{
-			oWriter.WriteStringUTF8(sRes);
+			oWriter.WriteStringUTF8(htmlToXhtml(sFileContent, false));
 			oWriter.CloseFile();
 		}
 		#endif
 		#endif
 
-		return m_oLightReader.FromString(sRes);
+		return bRes;
 	}
 
 	// Конвертирует mht в xhtml
@@ -1925,16 +1925,7 @@ public:
 
 			std::string sFileContent = XmlUtils::GetUtf8FromFileContent(pData, nLength);
 			RELEASEARRAYOBJECTS(pData);
-			std::wstring sRes = mhtToXhtml(sFileContent);
-			/*
-			NSFile::CFileBinary oWriter;
-			if (oWriter.CreateFileW(m_sTmp + L"/res.html"))
-			{
-				oWriter.WriteStringUTF8(sRes);
-				oWriter.CloseFile();
-			}
-			*/
-			bRes = m_oLightReader.FromString(sRes);
+			bRes = m_oLightReader.FromMht(sFileContent);
 		}
 		else
 			bRes = htmlXhtml(sSrc);
@@ -3,6 +3,12 @@
 
 #include "../OfficeUtils/src/OfficeUtils.h"
 #include "../DesktopEditor/common/Directory.h"
+#include "../../DesktopEditor/graphics/BaseThread.h"
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 // For decrypt
 #include "../../Common/3dParty/cryptopp/modes.h"
@@ -11,12 +17,16 @@
 // ----------
 
 #define DEFAULT_BUFFER_SIZE 8096
+#define MAX_SECTION_THREADS 8u
+#define MAX_SECTIONS_INFLATED_SIZE (128ull * 1024 * 1024)
 
 namespace HWP
 {
 CHWPFile::CHWPFile(const HWP_STRING& sFileName)
 	: m_sFileName(sFileName), m_oOleFile(sFileName), m_oDocInfo(this)
-{}
+{
+	m_oOleFileCS.InitializeCriticalSection();
+}
 
 CHWPFile::~CHWPFile()
 {
@@ -24,6 +34,8 @@ CHWPFile::~CHWPFile()
 
 	CLEAR_ARRAY(CHWPSection, m_arBodyTexts);
 	CLEAR_ARRAY(CHWPSection, m_arViewTexts);
+
+	m_oOleFileCS.DeleteCriticalSection();
 }
 
 std::vector<const CHWPSection*> CHWPFile::GetSections()
@@ -211,87 +223,79 @@ bool CHWPFile::GetChildStream(const HWP_STRING& sEntryName, ECompressed eCompres
 
 bool CHWPFile::Unzip(CHWPStream& oInput, CHWPStream& oBuffer)
 {
-	unsigned char* pInBuffer = new(std::nothrow) unsigned char[DEFAULT_BUFFER_SIZE];
+	// Распаковываем сразу в итоговый буфер, увеличивая его вдвое при заполнении,
+	// а не через промежуточный буфер с realloc на каждые 8 КБ
+	const unsigned long ulInputSize = oInput.SizeToEnd();
+	unsigned long ulCapacity = (std::max)(ulInputSize * 4, (unsigned long)DEFAULT_BUFFER_SIZE);
 
-	if (nullptr == pInBuffer)
-		return false;
-
-	unsigned char* pOutBuffer = new(std::nothrow) unsigned char[DEFAULT_BUFFER_SIZE];
+	BYTE* pOutBuffer = (BYTE*)malloc(ulCapacity);
 
 	if (nullptr == pOutBuffer)
-	{
-		delete[] pInBuffer;
 		return false;
-	}
 
 	CInflate oInflater;
 
-	oInflater.SetOut(pOutBuffer, DEFAULT_BUFFER_SIZE);
+	oInflater.SetOut(pOutBuffer, ulCapacity);
 	oInflater.Init2();
-	oInflater.SetIn(pInBuffer, 0);
+	oInflater.SetIn((BYTE*)oInput.GetCurPtr(), ulInputSize);
 
 	int nRes = DEFLATE_OK;
 
 	while (true)
 	{
-		const unsigned int unSize = oInput.ReadBytes((HWP_BYTE*)pInBuffer, DEFAULT_BUFFER_SIZE);
+		nRes = oInflater.Process(DEFLATE_NO_FLUSH);
 
-		oInflater.SetIn(pInBuffer, unSize);
+		if (DEFLATE_STREAM_END == nRes)
+			break;
 
-		if (0 == unSize)
+		if (DEFLATE_OK != nRes && DEFLATE_BUF_ERROR != nRes)
 			break;
 
-		while (oInflater.GetAvailIn() > 0)
+		if (0 != oInflater.GetAvailOut())
 		{
-			nRes = oInflater.Process(DEFLATE_NO_FLUSH);
-
-			if (DEFLATE_OK != nRes && DEFLATE_STREAM_END != nRes)
+			// входные данные закончились раньше конца потока
+			if (DEFLATE_BUF_ERROR == nRes || 0 == oInflater.GetAvailIn())
 				break;
 
-			if (oInflater.GetAvailOut() == 0)
-			{
-				oBuffer.WriteBytes((HWP_BYTE*)pOutBuffer, DEFAULT_BUFFER_SIZE);
-				oInflater.SetOut(pOutBuffer, DEFAULT_BUFFER_SIZE);
-			}
-
-			if (DEFLATE_STREAM_END == nRes)
-				break;
-		}
-	}
-
-	bool bEnd = false;
-
-	while (DEFLATE_OK == nRes || DEFLATE_STREAM_END == nRes)
-	{
-		nRes = oInflater.Process(DEFLATE_FINISH);
-
-		if (DEFLATE_OK != nRes && DEFLATE_STREAM_END != nRes)
-		{
-			oInflater.End();
+			continue;
 		}
 
-		if (DEFLATE_STREAM_END == nRes)
-			bEnd = true;
+		const unsigned long ulWritten = ulCapacity;
+		BYTE* pNewBuffer = (BYTE*)realloc(pOutBuffer, ulCapacity * 2);
 
-		if (oInflater.GetAvailOut() < DEFAULT_BUFFER_SIZE)
+		if (nullptr == pNewBuffer)
 		{
-			unsigned long ulSize = DEFAULT_BUFFER_SIZE - oInflater.GetAvailOut();
-			oBuffer.WriteBytes((HWP_BYTE*)pOutBuffer, ulSize);
-			oInflater.SetOut(pOutBuffer, DEFAULT_BUFFER_SIZE);
+			nRes = DEFLATE_MEM_ERROR;
+			break;
 		}
 
-		if (bEnd)
-			break;
+		pOutBuffer = pNewBuffer;
+		ulCapacity *= 2;
+		oInflater.SetOut(pOutBuffer + ulWritten, ulCapacity - ulWritten);
 	}
 
+	const unsigned long ulSize = ulCapacity - oInflater.GetAvailOut();
+
 	oInflater.End();
 
-	delete[] pInBuffer;
-	delete[] pOutBuffer;
+	const bool bResult = DEFLATE_STREAM_END == nRes;
+
+	if (bResult)
+		oInput.Skip((int)ulInputSize);
+
+	if (ulSize < ulCapacity)
+	{
+		BYTE* pNewBuffer = (BYTE*)realloc(pOutBuffer, (std::max)(ulSize, (unsigned long)1));
+
+		if (nullptr != pNewBuffer)
+			pOutBuffer = pNewBuffer;
+	}
 
-	oBuffer.MoveToStart();
+	// при ошибке, как и раньше, в буфере остается то, что успели распаковать
+	oBuffer.Clear();
+	oBuffer.SetStream((HWP_BYTE*)pOutBuffer, ulSize, false);
 
-	return DEFLATE_OK == nRes || DEFLATE_STREAM_END == nRes;
+	return bResult;
 }
 
 // Так как на всех ОС необходимо одинаковое поведение,
@@ -368,58 +372,175 @@ bool CHWPFile::Decrypt(CHWPStream& oInput, CHWPStream& oBuffer)
 	return true;
 }
 
-bool CHWPFile::GetBodyText(int nVersion)
+bool CHWPFile::ReadSection(const CDirectoryEntry& oEntry, bool bViewText, CHWPStream& oBuffer)
 {
-	VECTOR<CDirectoryEntry*> arSections{m_oOleFile.GetChildEntries(L"BodyText")};
+	CHWPStream oTempBuffer;
 
-	for (const CDirectoryEntry* pSection : arSections)
 	{
-		CHWPStream oBuffer;
+		// чтение из CompoundFile не потокобезопасно
+		CTemporaryCS oCS(&m_oOleFileCS);
 
-		if (m_oFileHeader.Compressed())
-		{
-			CHWPStream oTempBuffer;
-			if (!m_oOleFile.Read(*pSection, oTempBuffer) || !Unzip(oTempBuffer, oBuffer))
-				return false;
-		}
-		else if (!m_oOleFile.Read(*pSection, oBuffer))
-			return false;
+		if (!bViewText && !m_oFileHeader.Compressed())
+			return m_oOleFile.Read(oEntry, oBuffer);
 
-		CHWPSection *pHwpSection = new CHWPSection();
-		pHwpSection->Parse(oBuffer, m_nVersion);
-		m_arBodyTexts.push_back(pHwpSection);
+		if (!m_oOleFile.Read(oEntry, oTempBuffer))
+			return false;
 	}
 
-	return true;
+	if (!bViewText)
+		return Unzip(oTempBuffer, oBuffer);
+
+	if (!m_oFileHeader.Compressed())
+		return Decrypt(oTempBuffer, oBuffer);
+
+	CHWPStream oDecryptBuffer;
+	return Decrypt(oTempBuffer, oDecryptBuffer) && Unzip(oDecryptBuffer, oBuffer);
 }
 
-bool CHWPFile::GetViewText(int nVersion)
+CHWPSection* CHWPFile::ParseSection(const CDirectoryEntry& oEntry, bool bViewText)
+{
+	CHWPStream oBuffer;
+
+	if (!ReadSection(oEntry, bViewText, oBuffer))
+		return nullptr;
+
+	CHWPSection *pHwpSection = new CHWPSection();
+	pHwpSection->Parse(oBuffer, m_nVersion);
+	return pHwpSection;
+}
+
+// Ограничение объема секций, распаковываемых одновременно.
+// Размер распакованной секции заранее неизвестен, поэтому резервируется оценка (как начальный буфер Unzip).
+// Секция, которая больше всего лимита, распаковывается одна.
+class CSectionsInflateLimit
 {
-	VECTOR<CDirectoryEntry*> arSections{m_oOleFile.GetChildEntries(L"ViewText")};
+	std::mutex m_oMutex;
+	std::condition_variable m_oReleased;
+	unsigned long long m_ullInFlight;
+	const unsigned long long m_ullLimit;
+public:
+	CSectionsInflateLimit(unsigned long long ullLimit) : m_ullInFlight(0), m_ullLimit(ullLimit)
+	{}
 
-	for (const CDirectoryEntry* pSection : arSections)
+	static unsigned long long Estimate(const CDirectoryEntry& oEntry)
 	{
-		CHWPStream oBuffer;
+		// сжатые данные + распакованный буфер (Unzip начинает с размера в 4 раза больше)
+		return (unsigned long long)(std::max)(oEntry.GetStreamSize(), 1ll) * 5;
+	}
+
+	void Acquire(unsigned long long ullSize)
+	{
+		std::unique_lock<std::mutex> oLock(m_oMutex);
+		m_oReleased.wait(oLock, [&]{ return 0 == m_ullInFlight || m_ullInFlight + ullSize <= m_ullLimit; });
+		m_ullInFlight += ullSize;
+	}
 
-		if (m_oFileHeader.Compressed())
+	void Release(unsigned long long ullSize)
+	{
 		{
-			CHWPStream oTempDecryptBuffer, oTempBuffer;
-			if (!m_oOleFile.Read(*pSection, oTempDecryptBuffer) || !Decrypt(oTempDecryptBuffer, oTempBuffer) || !Unzip(oTempBuffer, oBuffer))
-				return false;
+			std::lock_guard<std::mutex> oLock(m_oMutex);
+			m_ullInFlight -= ullSize;
 		}
-		else
+		m_oReleased.notify_all();
+	}
+};
+
+// Секции не зависят друг от друга: каждая распаковывается и разбирается в своем потоке,
+// объем одновременно распакованных данных ограничен CSectionsInflateLimit
+class CSectionsThread : public NSThreads::CBaseThread
+{
+	CHWPFile* m_pFile;
+	const VECTOR<CDirectoryEntry*>& m_arEntries;
+	VECTOR<CHWPSection*>& m_arSections;
+	std::atomic<size_t>& m_nNext;
+	CSectionsInflateLimit& m_oLimit;
+	bool m_bViewText;
+public:
+	CSectionsThread(CHWPFile* pFile, const VECTOR<CDirectoryEntry*>& arEntries, VECTOR<CHWPSection*>& arSections, std::atomic<size_t>& nNext, CSectionsInflateLimit& oLimit, bool bViewText)
+		: m_pFile(pFile), m_arEntries(arEntries), m_arSections(arSections), m_nNext(nNext), m_oLimit(oLimit), m_bViewText(bViewText)
+	{}
+	virtual ~CSectionsThread()
+	{}
+protected:
+	virtual DWORD ThreadProc()
+	{
+		for (size_t unIndex = m_nNext++; unIndex < m_arEntries.size(); unIndex = m_nNext++)
 		{
-			CHWPStream oTempBuffer;
+			const unsigned long long ullSize = CSectionsInflateLimit::Estimate(*m_arEntries[unIndex]);
+
+			m_oLimit.Acquire(ullSize);
+			m_arSections[unIndex] = m_pFile->ParseSection(*m_arEntries[unIndex], m_bViewText);
+			m_oLimit.Release(ullSize);
 
-			if (!m_oOleFile.Read(*pSection, oTempBuffer) || !Decrypt(oTempBuffer, oBuffer))
-				return false;
+			// при ошибке остальные секции не нужны
+			if (nullptr == m_arSections[unIndex])
+				m_nNext = m_arEntries.size();
 		}
 
-		CHWPSection *pHwpSection = new CHWPSection();
-		pHwpSection->Parse(oBuffer, m_nVersion);
-		m_arViewTexts.push_back(pHwpSection);
+		return 0;
 	}
+};
 
-	return true;
+bool CHWPFile::GetSections(const HWP_STRING& sStorageName, bool bViewText, VECTOR<CHWPSection*>& arSections)
+{
+	VECTOR<CDirectoryEntry*> arEntries{m_oOleFile.GetChildEntries(sStorageName)};
+	VECTOR<CHWPSection*> arParsed(arEntries.size(), nullptr);
+
+	unsigned int unThreads = (std::min)(std::thread::hardware_concurrency(), MAX_SECTION_THREADS);
+	unThreads = (std::min)(unThreads, (unsigned int)arEntries.size());
+
+	if (unThreads < 2)
+	{
+		for (unsigned int unIndex = 0; unIndex < arEntries.size(); ++unIndex)
+		{
+			arParsed[unIndex] = ParseSection(*arEntries[unIndex], bViewText);
+
+			if (nullptr == arParsed[unIndex])
+				break;
+		}
+	}
+	else
+	{
+		std::atomic<size_t> nNext(0);
+		CSectionsInflateLimit oLimit(MAX_SECTIONS_INFLATED_SIZE);
+		VECTOR<CSectionsThread*> arThreads;
+
+		for (unsigned int unIndex = 0; unIndex < unThreads; ++unIndex)
+		{
+			arThreads.push_back(new CSectionsThread(this, arEntries, arParsed, nNext, oLimit, bViewText));
+			arThreads.back()->Start(0);
+		}
+
+		for (CSectionsThread* pThread : arThreads)
+		{
+			pThread->Stop();
+			delete pThread;
+		}
+	}
+
+	// как и при последовательном чтении, секции до первой ошибки остаются в документе
+	bool bResult = true;
+
+	for (CHWPSection* pSection : arParsed)
+	{
+		if (nullptr == pSection)
+			bResult = false;
+		else if (bResult)
+			arSections.push_back(pSection);
+		else
+			delete pSection;
+	}
+
+	return bResult;
+}
+
+bool CHWPFile::GetBodyText(int nVersion)
+{
+	return GetSections(L"BodyText", false, m_arBodyTexts);
 }
+
+bool CHWPFile::GetViewText(int nVersion)
+{
+	return GetSections(L"ViewText", true, m_arViewTexts);
 }
+}
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "HWPElements/HWPRecordBinData.h"
 #include "HWPSection.h"
 
+#include "../../DesktopEditor/graphics/TemporaryCS.h"
+
 namespace HWP
 {
 class CHWPFile
@@ -17,6 +19,7 @@ class CHWPFile
 	CHWPDocInfo       m_oDocInfo;
 	VECTOR<CHWPSection*> m_arBodyTexts;
 	VECTOR<CHWPSection*> m_arViewTexts;
+	NSCriticalSection::CRITICAL_SECTION m_oOleFileCS;
 public:
 	CHWPFile(const HWP_STRING& sFileName);
 	~CHWPFile();
@@ -33,6 +36,9 @@ public:
 	bool GetDocInfo(int nVersion);
 	bool GetComponent(const HWP_STRING& sEntryName, CHWPStream& oBuffer);
 	bool GetChildStream(const HWP_STRING& sEntryName, ECompressed eCompressed, CHWPStream& oBuffer);
+
+	// Читает, распаковывает и разбирает одну секцию, вызывается из нескольких потоков
+	CHWPSection* ParseSection(const CDirectoryEntry& oEntry, bool bViewText);
 private:
 	CDirectoryEntry* FindChildEntry(const HWP_STRING& sBasePath, const CDirectoryEntry& oBaseEntry, const HWP_STRING& sEntryName) const;
 	HWP_STRING SaveChildEntry(const HWP_STRING& sRootPath, const HWP_STRING& sEntryName, ECompressed eCompressed);
@@ -40,6 +46,9 @@ private:
 	bool Unzip(CHWPStream& oInput, CHWPStream& oBuffer);
 	bool Decrypt(CHWPStream& oInput, CHWPStream& oBuffer);
 
+	bool ReadSection(const CDirectoryEntry& oEntry, bool bViewText, CHWPStream& oBuffer);
+	bool GetSections(const HWP_STRING& sStorageName, bool bViewText, VECTOR<CHWPSection*>& arSections);
+
 	bool GetBodyText(int nVersion);
 	bool GetViewText(int nVersion);
 };
@@ -419,6 +419,7 @@ XlsConverter::XlsConverter(const std::wstring & xlsFileName, const std::wstring
 		is_older_version = true;
 	}	
     xlsx_context = new oox::xlsx_conversion_context(output_document);
+	xlsx_context->set_temp_directory(xls_global_info->tempDirectory);
 }
 
 XlsConverter::~XlsConverter() 
@@ -118,6 +118,7 @@ oox_activeX_context & xlsx_conversion_context::current_activeX()
 bool xlsx_conversion_context::start_sheet()
 {
     sheets_.push_back(xlsx_xml_worksheet::create());
+	sheets_.back()->set_temp_directory(temp_directory_);
     get_sheet_context().start_table();
 
 	return true;
@@ -300,7 +301,7 @@ void xlsx_conversion_context::end_document()
 			content->add_rel(relationship(dId, kType, dName));
        }
 /////////////////////////////////////////////////////////////////////////////////////////////////
-		sheets_[i]->write_to(content->content());
+		sheets_[i]->write_to(content->content(), content->sheet_data_file(), content->sheet_data_pos());
 
 		output_document_->get_xl_files().add_sheet(sheets_[i]->type, content);
 
@@ -63,6 +63,7 @@ public:
     ~xlsx_conversion_context();
 
     //void set_font_directory(std::wstring pathFonts);
+	void set_temp_directory(const std::wstring & path) { temp_directory_ = path; }
 
     void start_document();
     void end_document();
@@ -135,6 +136,7 @@ private:
 	std::map<int, int>					sheets_map_;
     std::vector<xlsx_xml_worksheet_ptr>	sheets_;
 
+	std::wstring						temp_directory_;
 	std::wstring						connections_;
 	std::map<std::wstring, std::wstring>query_tables_; 
 	std::map<std::wstring, std::wstring>control_props_; 
@@ -31,12 +31,185 @@
  */
 
 #include "xlsx_output_xml.h"
+#include <vector>
 #include <boost/make_shared.hpp>
 
 #include "../../Common/Utils/simple_xml_writer.h"
+#include "../../../DesktopEditor/common/File.h"
 
 namespace oox {
 
+// Buffer of serialized sheetData rows. When the buffer is full its content is appended (utf-8) to a temp file,
+// so the memory used by a sheet does not depend on the number of cells.
+class sheet_data_buf : public std::wstreambuf
+{
+public:
+	static const size_t buffer_size = 0x40000;
+
+	sheet_data_buf() : buffer_(buffer_size)
+	{
+		setp(buffer_.data(), buffer_.data() + buffer_.size());
+	}
+	~sheet_data_buf()
+	{
+		remove_file();
+	}
+	void set_temp_directory(const std::wstring & path)
+	{
+		temp_directory_ = path;
+	}
+	void clear()
+	{
+		remove_file();
+		setp(buffer_.data(), buffer_.data() + buffer_.size());
+	}
+	bool empty()
+	{
+		return file_name_.empty() && pptr() == pbase();
+	}
+	bool spilled()
+	{
+		return !file_name_.empty();
+	}
+	const wchar_t* data() { return pbase(); }
+	size_t size() { return pptr() - pbase(); }
+
+	// moves everything buffered into the temp file
+	const std::wstring & flush_to_file()
+	{
+		spill();
+		file_.CloseFile();
+		return file_name_;
+	}
+	// reads spilled content back
+	void copy_to(std::wostream & strm)
+	{
+		if (false == file_name_.empty())
+		{
+			file_.CloseFile();
+
+			NSFile::CFileBinary file;
+			if (file.OpenFile(file_name_))
+			{
+				std::vector<BYTE> chunk(buffer_size);
+				std::string tail;
+				DWORD dwRead = 0;
+				while (file.ReadFile(chunk.data(), (DWORD)chunk.size(), dwRead) && dwRead > 0)
+				{
+					tail.append((char*)chunk.data(), dwRead);
+
+					size_t complete = utf8_complete(tail);
+					strm << NSFile::CUtf8Converter::GetUnicodeStringFromUTF8((BYTE*)tail.c_str(), (LONG)complete);
+					tail.erase(0, complete);
+				}
+				file.CloseFile();
+			}
+		}
+		if (pptr() != pbase())
+		{
+			strm.write(pbase(), pptr() - pbase());
+		}
+	}
+protected:
+	virtual int_type overflow(int_type c)
+	{
+		if (false == spill())
+		{
+			size_t used = pptr() - pbase();
+			buffer_.resize(buffer_.size() * 2);
+			setp(buffer_.data(), buffer_.data() + buffer_.size());
+			pbump((int)used);
+		}
+		if (false == traits_type::eq_int_type(c, traits_type::eof()))
+		{
+			*pptr() = traits_type::to_char_type(c);
+			pbump(1);
+		}
+		return traits_type::not_eof(c);
+	}
+private:
+	bool spill()
+	{
+		if (temp_directory_.empty()) return false;
+
+		if (file_name_.empty())
+		{
+			file_name_ = NSFile::CFileBinary::CreateTempFileWithUniqueName(temp_directory_, L"sd");
+			if (file_name_.empty() || false == file_.CreateFileW(file_name_))
+			{
+				file_name_.clear();
+				temp_directory_.clear();
+				return false;
+			}
+		}
+		size_t count = pptr() - pbase();
+		size_t keep = 0;
+
+		if (sizeof(wchar_t) == 2 && count > 0 && (buffer_[count - 1] & 0xFC00) == 0xD800)
+		{
+			keep = 1; // do not split surrogate pair
+		}
+		if (count > keep)
+		{
+			BYTE* pUtf8 = NULL;
+			LONG lUtf8 = 0;
+			NSFile::CUtf8Converter::GetUtf8StringFromUnicode(buffer_.data(), (LONG)(count - keep), pUtf8, lUtf8);
+			if (pUtf8)
+			{
+				file_.WriteFile(pUtf8, (DWORD)lUtf8);
+				delete []pUtf8;
+			}
+		}
+		if (keep > 0)
+		{
+			buffer_[0] = buffer_[count - 1];
+		}
+		setp(buffer_.data(), buffer_.data() + buffer_.size());
+		pbump((int)keep);
+		return true;
+	}
+	void remove_file()
+	{
+		if (false == file_name_.empty())
+		{
+			file_.CloseFile();
+			NSFile::CFileBinary::Remove(file_name_);
+			file_name_.clear();
+		}
+	}
+	static size_t utf8_complete(const std::string & data)
+	{
+		size_t size = data.size();
+		size_t pos = size;
+		while (pos > 0 && size - pos < 4)
+		{
+			unsigned char c = (unsigned char)data[pos - 1];
+			if ((c & 0xC0) != 0x80)
+			{
+				size_t need = (c >= 0xF0) ? 4 : ((c >= 0xE0) ? 3 : ((c >= 0xC0) ? 2 : 1));
+				return (size - pos + 1 >= need) ? size : pos - 1;
+			}
+			pos--;
+		}
+		return size;
+	}
+
+	std::vector<wchar_t>	buffer_;
+	std::wstring			temp_directory_;
+	std::wstring			file_name_;
+	NSFile::CFileBinary		file_;
+};
+
+class sheet_data_stream : public std::wostream
+{
+public:
+	sheet_data_stream() : std::wostream(&buf_) {}
+
+	sheet_data_buf & buf() { return buf_; }
+private:
+	sheet_data_buf buf_;
+};
+
 
 class xlsx_xml_worksheet::Impl
 {
@@ -49,7 +222,7 @@ public:
 		cols_.clear();
 		sheetPr_.clear();
 		sheetFormatPr_.clear();
-		sheetData_.clear();
+		sheetData_.buf().clear();
 		mergeCells_.clear();
 		ole_objects_.clear();
 		activeXs_.clear();
@@ -71,7 +244,7 @@ public:
 	std::wstringstream  cols_;
 	std::wstringstream  sheetPr_;
 	std::wstringstream  sheetFormatPr_;
-    std::wstringstream  sheetData_;
+    sheet_data_stream	sheetData_;
     std::wstringstream  mergeCells_;
 	std::wstringstream  ole_objects_;
 	std::wstringstream  activeXs_;
@@ -210,7 +383,22 @@ rels & xlsx_xml_worksheet::sheet_rels()
 {
     return impl_->rels_;
 }
+void xlsx_xml_worksheet::set_temp_directory(const std::wstring & path)
+{
+	impl_->sheetData_.buf().set_temp_directory(path);
+}
 void xlsx_xml_worksheet::write_to(std::wostream & strm)
+{
+	std::wstring sheetDataFile;
+	std::streamoff sheetDataPos = 0;
+
+	write_(strm, false, sheetDataFile, sheetDataPos);
+}
+void xlsx_xml_worksheet::write_to(std::wostream & strm, std::wstring & sheetDataFile, std::streamoff & sheetDataPos)
+{
+	write_(strm, true, sheetDataFile, sheetDataPos);
+}
+void xlsx_xml_worksheet::write_(std::wostream & strm, bool bSplice, std::wstring & sheetDataFile, std::streamoff & sheetDataPos)
 {
 	std::wstring node_name;
 	switch(type)
@@ -246,11 +434,20 @@ void xlsx_xml_worksheet::write_to(std::wostream & strm)
 
             CP_XML_NODE(L"sheetData")
             {
-				if (impl_->sheetData_.rdbuf()->in_avail() != 0)
+				sheet_data_buf & sheetData = impl_->sheetData_.buf();
+				if (false == sheetData.empty())
 				{
-					impl_->sheetData_.flush();
-					CP_XML_STREAM() << impl_->sheetData_.rdbuf();
-					impl_->sheetData_.clear();
+					if (bSplice && sheetData.spilled())
+					{
+						std::wostream & out = CP_XML_STREAM();
+						
+						sheetDataFile	= sheetData.flush_to_file();
+						sheetDataPos	= out.tellp();
+					}
+					else
+					{
+						sheetData.copy_to(CP_XML_STREAM());
+					}
 				}
             }
 			CP_XML_STREAM() << impl_->sheetCalcPr_.str();
@@ -32,6 +32,7 @@
 #pragma once
 
 #include <iosfwd>
+#include <string>
 #include <boost/scoped_ptr.hpp>
 #include <boost/noncopyable.hpp>
 
@@ -78,6 +79,12 @@ public:
 	rels & sheet_rels();//hyperlink, background image, external, media ...
 
     void write_to(std::wostream & strm);
+	// sheetData rows spilled to a temp file are not copied into strm; sheetDataFile receives the file (utf-8)
+	// and sheetDataPos the offset in strm where its content must be spliced. Empty file - nothing was spilled.
+	void write_to(std::wostream & strm, std::wstring & sheetDataFile, std::streamoff & sheetDataPos);
+
+	// directory for spilling of large sheetData (rows are flushed as they are serialized)
+	void set_temp_directory(const std::wstring & path);
 
     void set_drawing_link		(std::wstring const & fileName, std::wstring const & id);
     void set_vml_drawing_link	(std::wstring const & fileName, std::wstring const & id);
@@ -92,6 +99,8 @@ public:
     static xlsx_xml_worksheet_ptr create();
 
 private:
+	void write_(std::wostream & strm, bool bSplice, std::wstring & sheetDataFile, std::streamoff & sheetDataPos);
+
     class Impl;
     boost::scoped_ptr<Impl> impl_;
 };
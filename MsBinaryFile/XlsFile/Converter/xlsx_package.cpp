@@ -138,7 +138,7 @@ _CP_PTR(activeX_content) activeX_content::create()
     return boost::make_shared<activeX_content>();
 }
 //--------------------------------------------------------------------------------------------
-sheet_content::sheet_content() : rels_(rels_file::create(L""))
+sheet_content::sheet_content() : rels_(rels_file::create(L"")), sheet_data_pos_(0)
 {
         
 }
@@ -159,6 +159,39 @@ void sheet_content::add_rels(rels & r)
 		rels_->get_rels().add(r.relationships()[i]);
 	}
 }
+void sheet_content::write(const std::wstring & fileName)
+{
+	NSFile::CFileBinary file;
+	if (false == file.CreateFileW(fileName)) return;
+
+	std::string root = "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>";
+	file.WriteFile((BYTE*)root.c_str(), root.length());
+
+	std::wstring content = content_.str();
+
+	if (sheet_data_file_.empty() || sheet_data_pos_ < 0 || sheet_data_pos_ > (std::streamoff)content.size())
+	{
+		file.WriteStringUTF8(content);
+	}
+	else
+	{
+		file.WriteStringUTF8(content.substr(0, (size_t)sheet_data_pos_));
+
+		NSFile::CFileBinary sheet_data;
+		if (sheet_data.OpenFile(sheet_data_file_))
+		{
+			std::vector<BYTE> buffer(0x100000);
+			DWORD dwRead = 0;
+			while (sheet_data.ReadFile(buffer.data(), (DWORD)buffer.size(), dwRead) && dwRead > 0)
+			{
+				file.WriteFile(buffer.data(), dwRead);
+			}
+			sheet_data.CloseFile();
+		}
+		file.WriteStringUTF8(content.substr((size_t)sheet_data_pos_));
+	}
+	file.CloseFile();
+}
 ////////////
 
 sheets_files::sheets_files()
@@ -230,7 +263,7 @@ void sheets_files::write_(std::vector<sheet_content_ptr> & sheets_, int & id,
         
 		//item->get_rel_file()->write(path.string<std::wstring>());
 
-		package::simple_element(fileName, sheets_[i]->str()).write(path);
+		sheets_[i]->write(path + FILE_SEPARATOR_STR + fileName);
 	}
 }
 
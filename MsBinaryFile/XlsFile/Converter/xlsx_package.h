@@ -64,10 +64,17 @@ public:
 	void set_rId(std::wstring rid) {rId_ = rid;}
 	std::wstring get_rId() {return rId_;}
 
+	std::wstring & sheet_data_file() { return sheet_data_file_; }
+	std::streamoff & sheet_data_pos() { return sheet_data_pos_; }
+
+	void write(const std::wstring & fileName);
 private:
 	std::wstring		rId_;
     std::wstringstream	content_;
     rels_file_ptr		rels_;
+
+	std::wstring		sheet_data_file_;
+	std::streamoff		sheet_data_pos_;
 };
 typedef _CP_PTR(sheet_content) sheet_content_ptr;
 //------------------------------------------------------------------------
@@ -39,6 +39,8 @@
 #include "../Biff_records/MulBlank.h"
 #include "../Biff_records/MulRk.h"
 
+#include "../../../../../DesktopEditor/common/File.h"
+
 namespace XLS
 {
 
@@ -65,6 +67,8 @@ const bool CELL_GROUP::loadContent(BinProcessor& proc)
             Row* row = dynamic_cast<Row*>(elements_.front().get());
             if (row)
             {
+                if (first_row_ < 0 || row->rw < first_row_) first_row_ = row->rw;
+
                 if (row->miyRw > 0 && std::abs(row->miyRw/20. - sheet_info.defaultRowHeight) > 0.001)
                 {
                     sheet_info.customRowsHeight.insert(std::make_pair(row->rw, row->miyRw / 20.));
@@ -110,6 +114,8 @@ const bool CELL_GROUP::loadContent(BinProcessor& proc)
         CELL * cell = dynamic_cast<CELL *>(elements_.front().get());
         if (cell)
         {
+            if (first_row_ < 0 || cell->RowNumber < first_row_) first_row_ = cell->RowNumber;
+
             std::map<int, GlobalWorkbookInfo::_row_info>::iterator pFindRow = sheet_info.mapRows.find(cell->RowNumber);
             if (pFindRow == sheet_info.mapRows.end())
             {
@@ -192,17 +198,20 @@ const bool CELLTABLE::loadContent(BinProcessor& proc)
 	{
 		return false;
 	}
-		
-	int count = 1 + proc.repeated(cell_group, 0, 0);
-	
-	while(!elements_.empty())
+	do
 	{
+		// строки предыдущих групп уже полные - их записи больше не нужны
+		CELL_GROUP* group = dynamic_cast<CELL_GROUP*>(elements_.back().get());
+		if (group && group->first_row_ >= 0)
+		{
+			flush_rows(group->first_row_);
+		}
 		//m_arCELLGROUP.insert(m_arCELLGROUP.begin(), elements_.back());
 		elements_.pop_back();
-		count--;
 	}
+	while (proc.optional(cell_group));
 	
-	count = proc.repeated<EntExU2>(0, 0);
+	int count = proc.repeated<EntExU2>(0, 0);
 	while(count > 0)
 	{
 		m_arEntExU2.insert(m_arEntExU2.begin(), elements_.back());
@@ -221,109 +230,214 @@ const bool CELLTABLE::saveContent(BinProcessor& proc)
 }
 
 
+void CELLTABLE::flush_rows(int row_limit)
+{
+	if (false == global_info_->bRowsTempFile) return;
+
+	GlobalWorkbookInfo::_sheet_info & sheet_info = global_info_->sheets_info[index_sheet_info_];
+	
+	if (sheet_info.mapRows.size() < rows_flush_count) return;
+
+	// строки, пришедшие не по порядку (номер не больше уже выгруженных), остаются в памяти до serialize
+	std::map<int, GlobalWorkbookInfo::_row_info>::iterator it_row = sheet_info.mapRows.upper_bound(sheet_info.rowsFileLast);
+	if (it_row == sheet_info.mapRows.end() || it_row->first >= row_limit) return;
+
+	NSFile::CFileBinary file;
+	if (sheet_info.rowsFile.empty())
+	{
+		sheet_info.rowsFile = NSFile::CFileBinary::CreateTempFileWithUniqueName(global_info_->tempDirectory, L"rows");
+		if (sheet_info.rowsFile.empty() || false == file.CreateFileW(sheet_info.rowsFile))
+		{
+			sheet_info.rowsFile.clear();
+			global_info_->bRowsTempFile = false;
+			return;
+		}
+	}
+	else
+	{
+		if (false == file.OpenFile(sheet_info.rowsFile, true))
+		{
+			global_info_->bRowsTempFile = false;
+			return;
+		}
+		file.SeekFile(0, SEEK_END);
+	}
+	// запись: номер строки, размер, xml строки в utf-8
+	while (it_row != sheet_info.mapRows.end() && it_row->first < row_limit)
+	{
+		std::wstringstream strm;
+		serialize_row(strm, it_row->first, it_row->second);
+
+		std::string xml = NSFile::CUtf8Converter::GetUtf8StringFromUnicode(strm.str());
+		_INT32 header[2] = { it_row->first, (_INT32)xml.size() };
+
+		file.WriteFile((BYTE*)header, sizeof(header));
+		file.WriteFile((BYTE*)xml.c_str(), (DWORD)xml.size());
+
+		sheet_info.rowsFileLast = it_row->first;
+		it_row = sheet_info.mapRows.erase(it_row);
+	}
+	file.CloseFile();
+}
+
 int CELLTABLE::serialize(std::wostream & stream)
 {
 	GlobalWorkbookInfo::_sheet_info & sheet_info = global_info_->sheets_info[index_sheet_info_];
 
-	CP_XML_WRITER(stream)    
-    {	
-		for (std::map<int, GlobalWorkbookInfo::_row_info>::iterator it_row = sheet_info.mapRows.begin(); it_row != sheet_info.mapRows.end(); it_row++)
+	// rows are released as soon as they are written - the cell records are not needed after serialization
+	std::map<int, GlobalWorkbookInfo::_row_info>::iterator it_row = sheet_info.mapRows.begin();
+
+	if (false == sheet_info.rowsFile.empty())
+	{
+		NSFile::CFileBinary file;
+		if (file.OpenFile(sheet_info.rowsFile))
 		{
-			Row* row = dynamic_cast<Row*>(it_row->second.row_info.get());
-			
-			if (row && it_row->second.mapCells.empty())
+			_INT32 header[2] = {};
+			DWORD dwRead = 0;
+			std::string xml;
+
+			while (file.ReadFile((BYTE*)header, sizeof(header), dwRead) && dwRead == sizeof(header) && header[1] >= 0)
 			{
-				it_row->second.row_info->serialize(stream);
+				xml.resize(header[1]);
+				if (header[1] > 0 && (false == file.ReadFile((BYTE*)&xml[0], header[1], dwRead) || dwRead != (DWORD)header[1]))
+					break;
+
+				for (; it_row != sheet_info.mapRows.end() && it_row->first < header[0]; it_row = sheet_info.mapRows.erase(it_row))
+				{
+					serialize_row(stream, it_row->first, it_row->second);
+				}
+				std::wstring row_xml = NSFile::CUtf8Converter::GetUnicodeStringFromUTF8((BYTE*)xml.c_str(), (LONG)xml.size());
+
+				if (it_row != sheet_info.mapRows.end() && it_row->first == header[0])
+				{// строка повторилась после выгрузки - ячейки дописываются в уже записанную
+					std::wstringstream cells;
+					serialize_cells(cells, it_row->second);
+
+					if (row_xml.size() > 2 && row_xml.compare(row_xml.size() - 2, 2, L"/>") == 0)
+					{
+						row_xml = row_xml.substr(0, row_xml.size() - 2) + L">" + cells.str() + L"</row>";
+					}
+					else if (row_xml.size() > 6 && row_xml.compare(row_xml.size() - 6, 6, L"</row>") == 0)
+					{
+						row_xml.insert(row_xml.size() - 6, cells.str());
+					}
+					it_row = sheet_info.mapRows.erase(it_row);
+				}
+				stream << row_xml;
 			}
-			else
-			{
-				CP_XML_NODE(L"row")
-				{	
-					CP_XML_ATTR(L"r", it_row->first + 1);
+			file.CloseFile();
+		}
+		NSFile::CFileBinary::Remove(sheet_info.rowsFile);
+		sheet_info.rowsFile.clear();
+	}
+	for (; it_row != sheet_info.mapRows.end(); it_row = sheet_info.mapRows.erase(it_row))
+	{
+		serialize_row(stream, it_row->first, it_row->second);
+	}
+	return 0;
+}
+
+void CELLTABLE::serialize_row(std::wostream & stream, int row_number, GlobalWorkbookInfo::_row_info & row_info)
+{
+	CP_XML_WRITER(stream)    
+	{
+		Row* row = dynamic_cast<Row*>(row_info.row_info.get());
+		
+		if (row && row_info.mapCells.empty())
+		{
+			row_info.row_info->serialize(stream);
+		}
+		else
+		{
+			CP_XML_NODE(L"row")
+			{	
+				CP_XML_ATTR(L"r", row_number + 1);
+				
+				if (row)
+				{
+					bool xf_set = true;
+					if (row->fGhostDirty == false) xf_set = false;
 					
-					if (row)
+					if (row->colMic >= 0 && row->colMac > row->colMic)
 					{
-						bool xf_set = true;
-						if (row->fGhostDirty == false) xf_set = false;
+						CP_XML_ATTR(L"spans", std::to_wstring(row->colMic + 1) + L":" + std::to_wstring(row->colMac));  //zero based & one based
+					}
+					if (xf_set)
+					{
+						int xf = row->ixfe_val >= global_info_->cellStyleXfs_count ? row->ixfe_val - global_info_->cellStyleXfs_count : -1/*row->ixfe_val*/;
 						
-						if (row->colMic >= 0 && row->colMac > row->colMic)
-						{
-							CP_XML_ATTR(L"spans", std::to_wstring(row->colMic + 1) + L":" + std::to_wstring(row->colMac));  //zero based & one based
-						}
-						if (xf_set)
+						if (xf < global_info_->cellXfs_count && xf >= 0)
 						{
-							int xf = row->ixfe_val >= global_info_->cellStyleXfs_count ? row->ixfe_val - global_info_->cellStyleXfs_count : -1/*row->ixfe_val*/;
-							
-							if (xf < global_info_->cellXfs_count && xf >= 0)
-							{
-								CP_XML_ATTR(L"s", xf);
-							}
-							CP_XML_ATTR(L"customFormat", true);
+							CP_XML_ATTR(L"s", xf);
 						}
-						if (row->miyRw > 0 && row->miyRw < 0x8000 && row->bValid &&
-							((row->fUnsynced && row->fGhostDirty) || !row->fGhostDirty))
-			//v8_14A_1b13.xls //Department_Sales_and_Stock_Monthly_Recap_Store_778_2019-09-03.xls
-			//Уведомления об ознакомлении.xls
-						{
-							CP_XML_ATTR(L"ht", row->miyRw / 20.);
-							if (row->fUnsynced)
-							{
-								CP_XML_ATTR(L"customHeight", true);
-							}
-							else
-							{
-							}
-						}
-						if (row->iOutLevel > 0)
-						{
-							CP_XML_ATTR(L"outlineLevel", row->iOutLevel);
-						}
-						if (row->fCollapsed)
-						{
-							CP_XML_ATTR(L"collapsed", row->fCollapsed);
-						}
-						if (row->fExAsc)
+						CP_XML_ATTR(L"customFormat", true);
+					}
+					if (row->miyRw > 0 && row->miyRw < 0x8000 && row->bValid &&
+						((row->fUnsynced && row->fGhostDirty) || !row->fGhostDirty))
+		//v8_14A_1b13.xls //Department_Sales_and_Stock_Monthly_Recap_Store_778_2019-09-03.xls
+		//Уведомления об ознакомлении.xls
+					{
+						CP_XML_ATTR(L"ht", row->miyRw / 20.);
+						if (row->fUnsynced)
 						{
-							CP_XML_ATTR(L"thickTop", true);
+							CP_XML_ATTR(L"customHeight", true);
 						}
-						if (row->fExDes)
+						else
 						{
-							CP_XML_ATTR(L"thickBot", true);
 						}
-						if (row->fDyZero)
-						{
-							CP_XML_ATTR(L"hidden", true);
-						}						
 					}
-					for ( std::map<int, BaseObjectPtr>::iterator it_cell = it_row->second.mapCells.begin(); it_cell != it_row->second.mapCells.end(); it_cell++)
+					if (row->iOutLevel > 0)
 					{
-						//if (isConcatinate_)
-						{
-							CELL* cell = dynamic_cast<CELL*>((it_cell->second).get());
-
-							MulBlank	*mulblank	= dynamic_cast<MulBlank*>(cell->elements_.begin()->get());
-							MulRk		*mulrk		= dynamic_cast<MulRk*>(cell->elements_.begin()->get());
-
-							if (mulblank || mulrk)
-							{
-								std::map<int, BaseObjectPtr>::iterator it_next_cell =  it_cell; it_next_cell++;
-								if (it_next_cell != it_row->second.mapCells.end())
-								{
-									CELL* cell_next = dynamic_cast<CELL*>((it_next_cell->second).get());
-
-									if (mulblank)	mulblank->colLast = (std::min)((int)mulblank->colLast, cell_next->ColumnNumber - 1);
-									if (mulrk)		mulrk->colLast = (std::min)((int)mulrk->colLast, cell_next->ColumnNumber - 1);
-								}
-							}
-						}
-						(it_cell->second)->serialize(CP_XML_STREAM());
+						CP_XML_ATTR(L"outlineLevel", row->iOutLevel);
+					}
+					if (row->fCollapsed)
+					{
+						CP_XML_ATTR(L"collapsed", row->fCollapsed);
+					}
+					if (row->fExAsc)
+					{
+						CP_XML_ATTR(L"thickTop", true);
+					}
+					if (row->fExDes)
+					{
+						CP_XML_ATTR(L"thickBot", true);
 					}
+					if (row->fDyZero)
+					{
+						CP_XML_ATTR(L"hidden", true);
+					}						
 				}
+				serialize_cells(CP_XML_STREAM(), row_info);
 			}
 		}
+	}
+}
 
+void CELLTABLE::serialize_cells(std::wostream & stream, GlobalWorkbookInfo::_row_info & row_info)
+{
+	for ( std::map<int, BaseObjectPtr>::iterator it_cell = row_info.mapCells.begin(); it_cell != row_info.mapCells.end(); it_cell++)
+	{
+		//if (isConcatinate_)
+		{
+			CELL* cell = dynamic_cast<CELL*>((it_cell->second).get());
+
+			MulBlank	*mulblank	= dynamic_cast<MulBlank*>(cell->elements_.begin()->get());
+			MulRk		*mulrk		= dynamic_cast<MulRk*>(cell->elements_.begin()->get());
+
+			if (mulblank || mulrk)
+			{
+				std::map<int, BaseObjectPtr>::iterator it_next_cell =  it_cell; it_next_cell++;
+				if (it_next_cell != row_info.mapCells.end())
+				{
+					CELL* cell_next = dynamic_cast<CELL*>((it_next_cell->second).get());
+
+					if (mulblank)	mulblank->colLast = (std::min)((int)mulblank->colLast, cell_next->ColumnNumber - 1);
+					if (mulrk)		mulrk->colLast = (std::min)((int)mulrk->colLast, cell_next->ColumnNumber - 1);
+				}
+			}
+		}
+		(it_cell->second)->serialize(stream);
 	}
-	return 0;
 }
 } // namespace XLS
 
@@ -54,6 +54,12 @@ public:
 
 	int serialize(std::wostream & stream);
 
+	static const size_t rows_flush_count = 1024;
+
+	void flush_rows(int row_limit);
+	void serialize_row(std::wostream & stream, int row_number, GlobalWorkbookInfo::_row_info & row_info);
+	void serialize_cells(std::wostream & stream, GlobalWorkbookInfo::_row_info & row_info);
+
 	std::vector<CellRangeRef>& shared_formulas_locations_ref_;
    
 	std::vector<BaseObjectPtr>	m_arEntExU2;
@@ -91,6 +97,8 @@ public:
 
     std::list<BaseObjectPtr>    m_DBCells;
 
+    int first_row_ = -1;
+
 private:
     std::vector<CellRangeRef>& shared_formulas_locations_ref_;
 
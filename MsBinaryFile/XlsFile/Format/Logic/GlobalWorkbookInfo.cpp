@@ -125,6 +125,7 @@ GlobalWorkbookInfo::GlobalWorkbookInfo(const unsigned short code_page, XlsConver
 	bVbaProjectExist		= false;
 	bMacrosExist			= false;
 	bWorkbookProtectExist	= false;
+	bRowsTempFile			= false;
 
 	idPivotCache = 0;	
 	currentPivotCacheRecord = 0;
@@ -99,6 +99,7 @@ public:
 	bool									bVbaProjectExist;
 	bool									bMacrosExist;
 	bool									bWorkbookProtectExist;
+	bool									bRowsTempFile; // CELLTABLE rows are moved to tempDirectory while reading
 
 	std::string								sTheme;
 
@@ -183,6 +184,8 @@ public:
 		double						defaultColumnWidth = 8.0;
 		double						defaultRowHeight = 14.4;
 		std::map<int, _row_info>	mapRows;
+		std::wstring				rowsFile;			// rows already serialized while reading CELLTABLE
+		int							rowsFileLast = -1;	// last row written to rowsFile
 		size_t						StreamPos = 0; // pose in stream for writing
 		size_t						BoundSheetPos = 0; // pose of related BoundSheet8's lbPlyPos field
 	};
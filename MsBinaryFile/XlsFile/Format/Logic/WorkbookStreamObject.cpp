@@ -105,6 +105,9 @@ const bool WorkbookStreamObject::loadContent(BinProcessor& proc)
 					GlobalsSubstream_found = true;
 					m_GlobalsSubstream = elements_.back();
 
+					// стили и имена уже прочитаны - строки листов можно сериализовать сразу при чтении
+					global_info_->bRowsTempFile = false == global_info_->tempDirectory.empty();
+
 					elements_.pop_back();
 				}
 				if (!GlobalsSubstream_found) return false;
@@ -99,6 +99,7 @@ void COFDFile::ConvertToPdf(const std::wstring& wsDstPath)
 {
 	CPdfFile oPdf(GetFonts());
 	oPdf.CreatePdf();
+	oPdf.StartStreaming(wsDstPath);
 	bool bBreak = false;
 
 	int nPagesCount = GetPagesCount();
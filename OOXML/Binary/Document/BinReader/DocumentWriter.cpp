@@ -81,12 +81,24 @@ mc:Ignorable=\"w14 w15 w16se w16cid w16 w16cex w16sdtdh wp14\">"));
 		}
 		else
 		{
-			OOX::CPath filePath = m_sDir + FILE_SEPARATOR_STR + L"word" + FILE_SEPARATOR_STR + L"document.xml";
-
 			NSFile::CFileBinary oFile;
-			oFile.CreateFileW(filePath.GetPath());
-			oFile.WriteStringUTF8(std::wstring(L"<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>"));
-			oFile.WriteStringUTF8(std::wstring(L"<w:document \
+			if (WriteBegin(oFile))
+			{
+				oFile.WriteStringUTF8(m_oContent.GetData());
+				WriteEnd(oFile);
+			}
+		}
+	}
+
+	bool DocumentWriter::WriteBegin(NSFile::CFileBinary& oFile)
+	{
+		OOX::CPath filePath = m_sDir + FILE_SEPARATOR_STR + L"word" + FILE_SEPARATOR_STR + L"document.xml";
+
+		if (!oFile.CreateFileW(filePath.GetPath()))
+			return false;
+
+		oFile.WriteStringUTF8(std::wstring(L"<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>"));
+		oFile.WriteStringUTF8(std::wstring(L"<w:document \
 xmlns:wpc=\"http://schemas.microsoft.com/office/word/2010/wordprocessingCanvas\" \
 xmlns:mc=\"http://schemas.openxmlformats.org/markup-compatibility/2006\" \
 xmlns:o=\"urn:schemas-microsoft-com:office:office\" \
@@ -111,19 +123,21 @@ xmlns:w16sdtdh=\"http://schemas.microsoft.com/office/word/2020/wordml/sdtdatahas
 xmlns:w16se=\"http://schemas.microsoft.com/office/word/2015/wordml/symex\" \
 mc:Ignorable=\"w14 w15 w16se w16cid w16 w16cex w16sdtdh wp14\">"));
 
-			oFile.WriteStringUTF8(m_oBackground.GetData());
+		oFile.WriteStringUTF8(m_oBackground.GetData());
 
-			oFile.WriteStringUTF8(std::wstring(L"<w:body>"));
-			oFile.WriteStringUTF8(m_oContent.GetData());
+		oFile.WriteStringUTF8(std::wstring(L"<w:body>"));
+		return true;
+	}
 
-			//oFile.WriteStringUTF8(WriteSectPrHdrFtr());
-			oFile.WriteStringUTF8(m_oSecPr.GetData());
+	void DocumentWriter::WriteEnd(NSFile::CFileBinary& oFile)
+	{
+		//oFile.WriteStringUTF8(WriteSectPrHdrFtr());
+		oFile.WriteStringUTF8(m_oSecPr.GetData());
 
-			oFile.WriteStringUTF8(std::wstring(L"</w:body>"));
+		oFile.WriteStringUTF8(std::wstring(L"</w:body>"));
 
-			oFile.WriteStringUTF8(std::wstring(L"</w:document>"));
-			oFile.CloseFile();
-		}
+		oFile.WriteStringUTF8(std::wstring(L"</w:document>"));
+		oFile.CloseFile();
 	}
 
 	std::wstring DocumentWriter::WriteSectPrHdrFtr()
@@ -48,6 +48,10 @@ namespace Writers
 		DocumentWriter( std::wstring sDir, HeaderFooterWriter& oHeaderFooterWriter);
 
 		void Write(bool bGlossary = false);
+
+		//word/document.xml по частям - тело пишется между ними напрямую в файл, мимо m_oContent
+		bool WriteBegin(NSFile::CFileBinary& oFile);
+		void WriteEnd(NSFile::CFileBinary& oFile);
 		
 		std::wstring WriteSectPrHdrFtr();
 	};
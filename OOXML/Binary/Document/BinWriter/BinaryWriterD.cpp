@@ -9760,6 +9760,7 @@ BinaryFileWriter::BinaryFileWriter(ParamsWriter& oParamsWriter) : m_oParamsWrite
 {
 	m_nLastFilePos = 0;
 	m_nRealTableCount = 0;
+	m_nDocumentItemsLimit = -1;
 }
 std::wstring BinaryFileWriter::WriteFileHeader(long nDataSize, int version)
 {
@@ -9827,9 +9828,12 @@ void BinaryFileWriter::intoBindoc(const std::wstring& sSrcPath)
 {
 	NSBinPptxRW::CBinaryFileWriter& oBufferedStream = m_oBcw.m_oStream;
 
-	OOX::CDocx		*pDocx = new OOX::CDocx(OOX::CPath(sSrcPath));
+	OOX::CDocx		*pDocx = new OOX::CDocx();
 	OOX::CDocxFlat	*pDocxFlat = NULL;
 
+	pDocx->m_nDocumentItemsLimit = m_nDocumentItemsLimit;
+	pDocx->Read(OOX::CPath(sSrcPath));
+
 	OOX::CDocument	*pDocument = NULL;
 	OOX::CComments	*pComments = NULL;
 
@@ -570,6 +570,7 @@ namespace BinDocxRW
 		int					m_nMainTableStart;
 	public:
 		ParamsWriter&		m_oParamsWriter;
+		int					m_nDocumentItemsLimit; // thumbnail - body elements after this number are skipped, -1 - no limit
 
 		BinaryFileWriter(ParamsWriter& oParamsWriter);
 		static std::wstring WriteFileHeader(long nDataSize, int version);
@@ -55,6 +55,9 @@ int BinDocxRW::g_nCurFormatVersion = 0;
 
 namespace BinDocxRW
 {
+	// абзацев и таблиц с запасом на первую страницу
+	static const int c_nThumbnailDocumentItems = 300;
+
 	class CPackageFile
 	{
 	public:
@@ -188,7 +191,7 @@ namespace BinDocxRW
 	};
 }
 
-BinDocxRW::CDocxSerializer::CDocxSerializer() : m_bIsMacro(false), m_bIsNoBase64Save(false), m_bIsNoBase64(false), m_bIsOForm(false)
+BinDocxRW::CDocxSerializer::CDocxSerializer() : m_bIsMacro(false), m_bIsNoBase64Save(false), m_bIsNoBase64(false), m_bIsOForm(false), m_bIsThumbnail(false)
 {
 	m_pParamsWriter		= NULL;
 	m_pCurFileWriter	= NULL;
@@ -244,6 +247,8 @@ bool BinDocxRW::CDocxSerializer::saveToFile(const std::wstring& sDstFileName, co
 	m_pParamsWriter = new ParamsWriter(&oBufferedStream, &fp, &oDrawingConverter, pEmbeddedFontsManager);
 
 	BinaryFileWriter oBinaryFileWriter(*m_pParamsWriter);
+	if (m_bIsThumbnail)
+		oBinaryFileWriter.m_nDocumentItemsLimit = c_nThumbnailDocumentItems;
 	
 	if (m_bIsNoBase64)
 	{
@@ -610,6 +615,10 @@ void BinDocxRW::CDocxSerializer::setIsNoBase64(bool val)
 {
 	m_bIsNoBase64 = val;
 }
+void BinDocxRW::CDocxSerializer::setIsThumbnail(bool val)
+{
+	m_bIsThumbnail = val;
+}
 void BinDocxRW::CDocxSerializer::setMacroEnabled(bool val)
 {
 	m_bIsMacro = val;
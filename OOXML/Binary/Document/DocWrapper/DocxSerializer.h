@@ -56,6 +56,7 @@ namespace BinDocxRW
 		bool					m_bIsNoBase64Save;
 		bool					m_bIsNoBase64;
 		bool					m_bIsOForm;
+		bool					m_bIsThumbnail;
 	public:
 		Writers::FileWriter*	m_pCurFileWriter;
 		ParamsWriter*			m_pParamsWriter;
@@ -83,6 +84,7 @@ namespace BinDocxRW
         void setIsNoBase64      (bool val);
         void setSaveChartAsImg  (bool val);
 		void setOFormEnabled	(bool val);
+		void setIsThumbnail		(bool val);// only the beginning of the document body is converted
 		
 		void setMacroEnabled	(bool val);
 		bool getMacroEnabled();
@@ -49,7 +49,10 @@
 namespace BinXlsxRW{
 	int g_nCurFormatVersion = 0;
 
-	CXlsxSerializer::CXlsxSerializer() : m_bIsMacro(false), m_bIsNoBase64(false)
+	// строк с запасом на первую страницу при печати
+	static const int c_nThumbnailRows = 500;
+
+	CXlsxSerializer::CXlsxSerializer() : m_bIsMacro(false), m_bIsNoBase64(false), m_bIsThumbnail(false)
 	{
 		m_pExternalDrawingConverter = NULL;
 	}
@@ -138,6 +141,8 @@ namespace BinXlsxRW{
 		oOfficeDrawingConverter.SetFontPicker(pFontPicker);
 
 		BinXlsxRW::BinaryFileWriter oBinaryFileWriter(fp);
+		if (m_bIsThumbnail)
+			oBinaryFileWriter.m_nThumbnailRows = c_nThumbnailRows;
 		_UINT32 result = oBinaryFileWriter.Open(sSrcPath, sDstFileName, pEmbeddedFontsManager, &oOfficeDrawingConverter, sXMLOptions, m_bIsNoBase64);
 
 		RELEASEOBJECT(pFontPicker);
@@ -282,6 +287,10 @@ namespace BinXlsxRW{
 	{
 		m_bIsNoBase64 = val;
 	}
+	void CXlsxSerializer::setIsThumbnail(bool val)
+	{
+		m_bIsThumbnail = val;
+	}
 	void CXlsxSerializer::setMacroEnabled(bool val)
 	{
 		m_bIsMacro = val;
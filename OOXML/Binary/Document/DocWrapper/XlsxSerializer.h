@@ -57,6 +57,7 @@ namespace BinXlsxRW {
 		NSBinPptxRW::CDrawingConverter* m_pExternalDrawingConverter;
 		bool m_bIsNoBase64;
 		bool m_bIsMacro;
+		bool m_bIsThumbnail;
 	public:
 		CXlsxSerializer();
 		~CXlsxSerializer();
@@ -71,6 +72,7 @@ namespace BinXlsxRW {
         void setEmbeddedFontsDir(const std::wstring& sEmbeddedFontsDir);
 		void setDrawingConverter(NSBinPptxRW::CDrawingConverter* pDrawingConverter);
 		void setIsNoBase64		(bool val);
+		void setIsThumbnail		(bool val);// only the top-left range of the active sheet is converted
 		
 		void setMacroEnabled	(bool val);
 		bool getMacroEnabled	();
@@ -4472,7 +4472,7 @@ void BinaryPersonTableWriter::WritePerson(OOX::Spreadsheet::CPerson& oPerson)
 }
 
 BinaryWorksheetTableWriter::BinaryWorksheetTableWriter(NSBinPptxRW::CBinaryFileWriter &oCBufferedStream, NSFontCutter::CEmbeddedFontsManager* pEmbeddedFontsManager, OOX::Spreadsheet::CIndexedColors* pIndexedColors, PPTX::Theme* pTheme, DocWrapper::FontProcessor& oFontProcessor, NSBinPptxRW::CDrawingConverter* pOfficeDrawingConverter) :
-  m_oBcw(oCBufferedStream), m_pEmbeddedFontsManager(pEmbeddedFontsManager), m_pIndexedColors(pIndexedColors), m_pTheme(pTheme), m_oFontProcessor(oFontProcessor), m_pOfficeDrawingConverter(pOfficeDrawingConverter)
+  m_oBcw(oCBufferedStream), m_pEmbeddedFontsManager(pEmbeddedFontsManager), m_pIndexedColors(pIndexedColors), m_pTheme(pTheme), m_oFontProcessor(oFontProcessor), m_pOfficeDrawingConverter(pOfficeDrawingConverter), m_pFileWriter(NULL)
 {
 }
 void BinaryWorksheetTableWriter::Write(OOX::Spreadsheet::CWorkbook& workbook,  std::map<std::wstring, OOX::Spreadsheet::CWorksheet*>& mapWorksheets)
@@ -4512,6 +4512,9 @@ void BinaryWorksheetTableWriter::WriteWorksheets(OOX::Spreadsheet::CWorkbook& wo
 					nCurPos = m_oBcw.WriteItemStart(c_oSerWorksheetsTypes::Worksheet);
 					WriteWorksheet(pSheet, *pFind->second);
 					m_oBcw.WriteItemWithLengthEnd(nCurPos);
+
+					if (m_pFileWriter)
+						m_pFileWriter->FlushTables();
 				}
 			}
 		}
@@ -8854,7 +8857,10 @@ BinaryFileWriter::BinaryFileWriter(DocWrapper::FontProcessor& oFontProcessor) :
 {
 	m_nLastFilePos = 0;
 	m_nLastFilePosOffset = 0;
+	m_nThumbnailRows = 0;
 	m_nRealTableCount = 0;
+	m_pTablesFile = NULL;
+	m_nTablesStart = 0;
 }
 BinaryFileWriter::~BinaryFileWriter()
 {
@@ -8908,6 +8914,7 @@ _UINT32 BinaryFileWriter::Open(const std::wstring& sInputDir, const std::wstring
                 else
                     pXlsx = new OOX::Spreadsheet::CXlsx();
 				pXlsx->m_bNeedCalcChain = false;
+				pXlsx->m_nThumbnailRows = m_nThumbnailRows;
 
 				NSBinPptxRW::CXlsbBinaryWriter oXlsbWriter;
 				oXlsbWriter.CreateFileW(sFileDst);
@@ -8936,7 +8943,9 @@ _UINT32 BinaryFileWriter::Open(const std::wstring& sInputDir, const std::wstring
 			}
 			else
 			{
-				pXlsx = new OOX::Spreadsheet::CXlsx(OOX::CPath(sInputDir));
+				pXlsx = new OOX::Spreadsheet::CXlsx();
+				pXlsx->m_nThumbnailRows = m_nThumbnailRows;
+				pXlsx->Read(OOX::CPath(sInputDir));
 			}
 		}break;
 	}		
@@ -8988,32 +8997,42 @@ _UINT32 BinaryFileWriter::Open(const std::wstring& sInputDir, const std::wstring
 			oBufferedStream.WriteStringUtf8(WriteFileHeader(0, g_nFormatVersionNoBase64));
 		}
 		int nHeaderLen = oBufferedStream.GetPosition();
+		int nMidPoint = nHeaderLen + GetMainTableSize();
 		
+		NSFile::CFileBinary oFile;
 		WriteMainTableStart(oBufferedStream);
-		WriteContent(pXlsx ? dynamic_cast<OOX::Document*>(pXlsx) : dynamic_cast<OOX::Document*>(pXlsxFlat), pEmbeddedFontsManager, pOfficeDrawingConverter);
-		WriteMainTableEnd();
-
-		BYTE* pbBinBuffer = oBufferedStream.GetBuffer();
-		int nBinBufferLen = oBufferedStream.GetPosition();
 		if (bIsNoBase64)
 		{
-			int nMidPoint = nHeaderLen + GetMainTableSize();
-			
-			NSFile::CFileBinary oFile;
+			//готовые таблицы пишутся сразу в файл, в памяти остается только заголовок и main table
 			if(0 != m_nLastFilePosOffset)
 			{
 				oFile.OpenFile(sFileDst, true);
+				//skip xlsb records written on xml reading
+				oFile.SeekFile(0, SEEK_END);
 			}
 			else
 			{
 				oFile.CreateFileW(sFileDst);
+				//reserve header and main table - заполняются в конце
+				std::vector<BYTE> arZero(nMidPoint, 0);
+				oFile.WriteFile(arZero.data(), nMidPoint);
 			}
-			//write header and main table
-			oFile.WriteFile(pbBinBuffer, nMidPoint);
-			//skip xlsb records written on xml reading
-			oFile.SeekFile(0, SEEK_END);
+			m_pTablesFile = &oFile;
+			m_nTablesStart = nMidPoint;
+		}
+		WriteContent(pXlsx ? dynamic_cast<OOX::Document*>(pXlsx) : dynamic_cast<OOX::Document*>(pXlsxFlat), pEmbeddedFontsManager, pOfficeDrawingConverter);
+		WriteMainTableEnd();
+
+		BYTE* pbBinBuffer = oBufferedStream.GetBuffer();
+		int nBinBufferLen = oBufferedStream.GetPosition();
+		if (bIsNoBase64)
+		{
+			m_pTablesFile = NULL;
 			//write other records
 			oFile.WriteFile(pbBinBuffer + nMidPoint, nBinBufferLen - nMidPoint);
+			//write header and main table
+			oFile.SeekFile(0, SEEK_SET);
+			oFile.WriteFile(pbBinBuffer, nMidPoint);
 			oFile.CloseFile();
 		}
 		else
@@ -9157,7 +9176,21 @@ void BinaryFileWriter::WriteContent(OOX::Document *pDocument, NSFontCutter::CEmb
 	//Worksheets
 		nCurPos = WriteTableStart(c_oSerTableTypes::Worksheets);
 		BinaryWorksheetTableWriter oBinaryWorksheetTableWriter(m_oBcw->m_oStream, pEmbeddedFontsManager, pIndexedColors, pXlsx->GetTheme(), m_oFontProcessor, pOfficeDrawingConverter);
-		oBinaryWorksheetTableWriter.Write(*pXlsx->m_pWorkbook, pXlsx->m_mapWorksheets); 
+		if (m_pTablesFile)
+		{
+			//листы сбрасываются в файл по одному - длина таблицы дописывается в конце
+			int nLengthPos = m_oBcw->m_oStream.GetPosition() + m_nLastFilePosOffset;
+			m_oBcw->m_oStream.WriteLONG(0);
+
+			oBinaryWorksheetTableWriter.m_pFileWriter = this;
+			oBinaryWorksheetTableWriter.WriteWorksheets(*pXlsx->m_pWorkbook, pXlsx->m_mapWorksheets);
+
+			WriteLengthAt(nLengthPos, m_oBcw->m_oStream.GetPosition() + m_nLastFilePosOffset - nLengthPos - 4);
+		}
+		else
+		{
+			oBinaryWorksheetTableWriter.Write(*pXlsx->m_pWorkbook, pXlsx->m_mapWorksheets); 
+		}
 		WriteTableEnd(nCurPos);
 	
 	//OtherTable
@@ -9181,6 +9214,38 @@ void BinaryFileWriter::WriteContent(OOX::Document *pDocument, NSFontCutter::CEmb
 	}
 }
 
+void BinaryFileWriter::FlushTables()
+{
+	if (!m_pTablesFile) return;
+
+	int nEnd = m_oBcw->m_oStream.GetPosition();
+	if (nEnd <= m_nTablesStart) return;
+
+	m_pTablesFile->WriteFile(m_oBcw->m_oStream.GetBuffer() + m_nTablesStart, nEnd - m_nTablesStart);
+	
+	//смещение в файле для позиций буфера
+	m_nLastFilePosOffset += nEnd - m_nTablesStart;
+	m_oBcw->m_oStream.SetPosition(m_nTablesStart);
+}
+void BinaryFileWriter::WriteLengthAt(int nFilePos, int nLength)
+{
+	int nBufferPos = nFilePos - m_nLastFilePosOffset;
+	if (nBufferPos >= m_nTablesStart)
+	{
+		int nCurPos = m_oBcw->m_oStream.GetPosition();
+		m_oBcw->m_oStream.SetPosition(nBufferPos);
+		m_oBcw->m_oStream.WriteLONG(nLength);
+		m_oBcw->m_oStream.SetPosition(nCurPos);
+	}
+	else
+	{
+		BYTE pLength[4] = {(BYTE)(nLength & 0xFF), (BYTE)((nLength >> 8) & 0xFF), (BYTE)((nLength >> 16) & 0xFF), (BYTE)((nLength >> 24) & 0xFF)};
+
+		m_pTablesFile->SeekFile(nFilePos, SEEK_SET);
+		m_pTablesFile->WriteFile(pLength, 4);
+		m_pTablesFile->SeekFile(0, SEEK_END);
+	}
+}
 std::wstring BinaryFileWriter::WriteFileHeader(int nDataSize, int version)
 {
     std::wstring sHeader = std::wstring(g_sFormatSignature) + L";v" + std::to_wstring(version)+ L";" + std::to_wstring(nDataSize) + L";";
@@ -9229,6 +9294,7 @@ int BinaryFileWriter::WriteTableStart(BYTE type, int nStartPos)
 }
 void BinaryFileWriter::WriteTableEnd(int nCurPos)
 {
+	FlushTables();
 	//сдвигаем позицию куда можно следующую таблицу
 	m_nLastFilePos = m_oBcw->m_oStream.GetPosition();
 	m_nRealTableCount++;
@@ -275,6 +275,8 @@ namespace BinXlsxRW
 		void WritePersonList(OOX::Spreadsheet::CPersonList& oPersonList);
 		void WritePerson(OOX::Spreadsheet::CPerson& oPerson);
 	};
+	class BinaryFileWriter;
+
 	class BinaryWorksheetTableWriter
 	{
 		BinaryCommonWriter						m_oBcw;
@@ -284,6 +286,8 @@ namespace BinXlsxRW
 		DocWrapper::FontProcessor&				m_oFontProcessor;
 		NSBinPptxRW::CDrawingConverter*			m_pOfficeDrawingConverter;
 	public:
+		BinaryFileWriter*						m_pFileWriter;	//сброс записанных листов в файл
+
 		BinaryWorksheetTableWriter(NSBinPptxRW::CBinaryFileWriter &oCBufferedStream, NSFontCutter::CEmbeddedFontsManager* pEmbeddedFontsManager, OOX::Spreadsheet::CIndexedColors* pIndexedColors, PPTX::Theme* pTheme, DocWrapper::FontProcessor& oFontProcessor, NSBinPptxRW::CDrawingConverter* pOfficeDrawingConverter);
 		
 		void Write(OOX::Spreadsheet::CWorkbook& workbook, std::map<std::wstring, OOX::Spreadsheet::CWorksheet*>& mapWorksheets);
@@ -444,8 +448,15 @@ namespace BinXlsxRW
 		int GetMainTableSize();
 
 		int m_nLastFilePosOffset;
+		int m_nThumbnailRows; // > 0 - only these rows of the active sheet are converted
+
+		void FlushTables();
 	private:
 		int WriteTableStart(BYTE type, int nStartPos = -1);
 		void WriteTableEnd(int nCurPos);
+		void WriteLengthAt(int nFilePos, int nLength);
+
+		NSFile::CFileBinary*	m_pTablesFile;
+		int						m_nTablesStart;
 	};
 }
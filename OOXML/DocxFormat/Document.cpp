@@ -318,6 +318,12 @@ namespace OOX
 	{
 		OOX::Document* document = WritingElement::m_pMainDocument;
 
+		OOX::CDocx* docx_main = dynamic_cast<OOX::CDocx*>(document);
+		int nItemsLimit = (docx_main && !docx_main->m_bGlossaryRead) ? docx_main->m_nDocumentItemsLimit : -1;
+
+		if (nItemsLimit >= 0)
+			docx_main->m_nDocumentItemsCount = 0;
+
 		while ( oReader.ReadNextSiblingNode( Depth ) )
 		{
 			std::wstring sName = XmlUtils::GetNameNoNS(oReader.GetName());
@@ -447,10 +453,22 @@ namespace OOX
 			}
 			if ( pItem )
 			{
+				if (nItemsLimit >= 0)
+				{
+					if (docx_main->m_nDocumentItemsCount >= nItemsLimit)
+					{
+						delete pItem;
+						continue;
+					}
+					docx_main->m_nDocumentItemsCount++;
+				}
 				pItem->fromXML(oReader);
 				m_arrItems.push_back( pItem );
 			}
 		}
+
+		if (nItemsLimit >= 0)
+			docx_main->m_nDocumentItemsCount = -1;
 	}
 
 	void CDocument::read(const CPath& oRootPath, const CPath& oPath)
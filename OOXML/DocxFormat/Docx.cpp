@@ -214,5 +214,7 @@ namespace OOX
 		m_pJsaProject	= NULL;
 
 		m_bGlossaryRead = false;
+		m_nDocumentItemsLimit = -1;
+		m_nDocumentItemsCount = -1;
 	}
 }
@@ -105,6 +105,11 @@ namespace OOX
 		// todooo сделать структурный объект - главный документ и подчиненные - как только появится что то  кроме glossary
 		bool m_bGlossaryRead;
 
+		// thumbnail - root elements and table rows of the main document body after this number are skipped, -1 - no limit
+		int m_nDocumentItemsLimit;
+		// read root elements and table rows of the body, -1 - body is not being read
+		int m_nDocumentItemsCount;
+
 		OOX::CCommentsExt	*m_pCommentsExt;				// word/commentsExtended.xml
 		OOX::CCommentsExtensible	*m_pCommentsExtensible;	// word/commentsExtensible.xml
 		OOX::CCommentsUserData		*m_pCommentsUserData;	// word/commentsUserData.xml
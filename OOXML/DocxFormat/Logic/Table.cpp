@@ -37,6 +37,7 @@
 #include "Annotations.h"
 #include "Sdt.h"
 #include "Hyperlink.h"
+#include "../Docx.h"
 
 namespace ComplexTypes
 {
@@ -414,6 +415,11 @@ namespace OOX
 		{
 			OOX::Document* document = WritingElement::m_pMainDocument;
 
+			//thumbnail - строки сверх лимита документа пропускаются (первая строка остается)
+			OOX::CDocx* docx_main = dynamic_cast<OOX::CDocx*>(document);
+			if (docx_main && docx_main->m_nDocumentItemsCount < 0)
+				docx_main = NULL;
+
 			while (oReader.ReadNextSiblingNode(Depth))
 			{
 				std::wstring sName = oReader.GetName();
@@ -487,6 +493,12 @@ namespace OOX
 				}
 				else if (_T("w:tr") == sName)
 				{
+					if (docx_main)
+					{
+						if (m_nCountRow > 0 && docx_main->m_nDocumentItemsCount >= docx_main->m_nDocumentItemsLimit)
+							continue;
+						docx_main->m_nDocumentItemsCount++;
+					}
 					pItem = new CTr(document);
 					m_nCountRow++;
 				}
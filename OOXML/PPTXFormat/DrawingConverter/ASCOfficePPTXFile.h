@@ -56,6 +56,7 @@ private:
 	
 	bool				m_bIsNoBase64;
 	bool				m_bIsMacro;
+	bool				m_bIsOnlyFirstSlide;
 public:
 	CPPTXFile();
 	~CPPTXFile();
@@ -78,6 +79,9 @@ public:
     
 	void SetMacroEnabled	(bool val);
 	bool GetMacroEnabled	();
+
+	// thumbnail - only the first slide with its layout and master is converted
+	void SetOnlyFirstSlide	(bool val);
 	
 	_UINT32 OpenFileToPPTY		(std::wstring bsInput, std::wstring bsOutput);
     _UINT32 OpenDirectoryToPPTY	(std::wstring bsInput, std::wstring bsOutput);
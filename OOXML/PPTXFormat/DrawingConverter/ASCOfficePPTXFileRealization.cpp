@@ -50,6 +50,7 @@ CPPTXFile::CPPTXFile()
     m_bIsUseSystemFonts = false;
 	m_bIsNoBase64 = false;
 	m_bIsMacro = false;
+	m_bIsOnlyFirstSlide = false;
 
 	m_pPptxDocument		= NULL;
 }
@@ -176,6 +177,10 @@ bool CPPTXFile::GetMacroEnabled()
 {
 	return m_bIsMacro;
 }
+void CPPTXFile::SetOnlyFirstSlide(bool val)
+{
+	m_bIsOnlyFirstSlide = val;
+}
 _UINT32 CPPTXFile::OpenFileToPPTY(std::wstring bsInput, std::wstring bsOutput)
 {
 	if (m_strTempDir.empty()) m_strTempDir = NSDirectory::GetTempPath();
@@ -201,7 +206,9 @@ _UINT32 CPPTXFile::OpenDirectoryToPPTY(std::wstring bsInput, std::wstring bsOutp
 		return AVS_FILEUTILS_ERROR_CONVERT;
 	}
 
-	bool res = m_pPptxDocument->read(pathInputDirectory.GetPath() + FILE_SEPARATOR_STR);
+	bool res = m_pPptxDocument->read(pathInputDirectory.GetPath() + FILE_SEPARATOR_STR, m_bIsOnlyFirstSlide);
+	if (res && m_bIsOnlyFirstSlide)
+		res = m_pPptxDocument->LoadFirstSlideOnly();
 	if (false == res)
 	{
 		RELEASEOBJECT(m_pPptxDocument);
@@ -34,7 +34,7 @@
 
 namespace PPTX
 {
-	FileMap::FileMap()
+	FileMap::FileMap() : m_bDeferRead(false)
 	{
 	}
 	FileMap::~FileMap()
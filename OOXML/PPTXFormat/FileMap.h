@@ -54,6 +54,9 @@ namespace PPTX
 
 		bool empty() const;
 		size_t size() const;
+
+		// slides, notes and layouts only remember their path, xml is parsed by WrapperFile::Load
+		bool m_bDeferRead;
 	};
 } // namespace PPTX
 
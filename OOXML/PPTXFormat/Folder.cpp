@@ -44,10 +44,50 @@
 #include "NotesMaster.h"
 #include "NotesSlide.h"
 
+#include "../../DesktopEditor/graphics/BaseThread.h"
+
 #include <map>
+#include <thread>
+#include <atomic>
+#include <exception>
 
 namespace PPTX
 {
+	static const size_t c_nMaxLoadThreads = 8;
+	static const size_t c_nMinPartsPerThread = 4;
+
+	class CLoadPartsThread : public NSThreads::CBaseThread
+	{
+	public:
+		CLoadPartsThread(std::vector<smart_ptr<OOX::File>>& arParts, std::atomic<size_t>& nNext) : m_arParts(arParts), m_nNext(nNext) {}
+		virtual ~CLoadPartsThread() {}
+
+		std::exception_ptr m_pError;
+
+	protected:
+		virtual DWORD ThreadProc()
+		{
+			try
+			{
+				for (size_t i = m_nNext++; i < m_arParts.size(); i = m_nNext++)
+				{
+					PPTX::WrapperFile* pFile = dynamic_cast<PPTX::WrapperFile*>(m_arParts[i].GetPointer());
+					if (pFile)
+						pFile->Load();
+				}
+			}
+			catch (...)
+			{
+				m_pError = std::current_exception();
+				m_nNext = m_arParts.size();
+			}
+			return 0;
+		}
+	private:
+		std::vector<smart_ptr<OOX::File>>& m_arParts;
+		std::atomic<size_t>& m_nNext;
+	};
+
 	Document::Document() : FileContainer(this)
 	{		
 	}
@@ -57,10 +97,11 @@ namespace PPTX
 		read(path);
 	}
 
-	bool Document::read(const OOX::CPath& path)
+	bool Document::read(const OOX::CPath& path, bool bLazy)
 	{
 		OOX::CRels rels(path);
 		PPTX::FileMap map;
+		map.m_bDeferRead = true;
         long files = CountFiles(path);
 		if(files == 0)
             return false;
@@ -100,6 +141,10 @@ namespace PPTX
                 if (pTheme.IsInit())
                     pTheme->presentation = _presentation;
             }
+
+            PPTX::WrapperFile* pWrapperFile = dynamic_cast<PPTX::WrapperFile*>(pPair->second.GetPointer());
+            if (pWrapperFile && !pWrapperFile->IsLoaded())
+                m_arDeferredParts.push_back(pPair->second);
         }
 
         for (std::map<std::wstring, smart_ptr<OOX::File>>::const_iterator pPair = map.m_map.begin(); pPair != map.m_map.end(); ++pPair)
@@ -163,6 +208,104 @@ namespace PPTX
                     pointer->ApplyRels();
             }
         }
+
+		if (!bLazy)
+			LoadParts();
+		return true;
+	}
+
+	void Document::LoadParts()
+	{
+		// masters and themes are shared and already parsed, slides, notes and layouts do not depend on each other
+		size_t nThreads = (std::min)((size_t)std::thread::hardware_concurrency(), c_nMaxLoadThreads);
+		nThreads = (std::min)(nThreads, m_arDeferredParts.size() / c_nMinPartsPerThread);
+
+		if (nThreads < 2)
+		{
+			for (size_t i = 0; i < m_arDeferredParts.size(); ++i)
+			{
+				PPTX::WrapperFile* pFile = dynamic_cast<PPTX::WrapperFile*>(m_arDeferredParts[i].GetPointer());
+				if (pFile)
+					pFile->Load();
+			}
+			m_arDeferredParts.clear();
+			return;
+		}
+
+		std::atomic<size_t> nNext(0);
+		std::vector<CLoadPartsThread*> arThreads;
+		for (size_t i = 0; i < nThreads; ++i)
+		{
+			arThreads.push_back(new CLoadPartsThread(m_arDeferredParts, nNext));
+			arThreads.back()->Start(0);
+		}
+
+		std::exception_ptr pError;
+		for (size_t i = 0; i < arThreads.size(); ++i)
+		{
+			arThreads[i]->Stop();
+			if (!pError && arThreads[i]->m_pError)
+				pError = arThreads[i]->m_pError;
+			delete arThreads[i];
+		}
+		m_arDeferredParts.clear();
+
+		if (pError)
+			std::rethrow_exception(pError);
+	}
+
+	bool Document::LoadFirstSlideOnly()
+	{
+		m_arDeferredParts.clear();
+
+		smart_ptr<PPTX::Presentation> _presentation = FileContainer::Get(OOX::Presentation::FileTypes::Presentation).smart_dynamic_cast<PPTX::Presentation>();
+		if (false == _presentation.is_init())
+			return false;
+
+		smart_ptr<PPTX::Slide> slide;
+		for (size_t i = 0; i < _presentation->sldIdLst.size(); ++i)
+		{
+			slide = ((*_presentation)[_presentation->sldIdLst[i].rid.get()]).smart_dynamic_cast<PPTX::Slide>();
+			if (slide.IsInit())
+			{
+				Logic::XmlId oFirst = _presentation->sldIdLst[i];
+				_presentation->sldIdLst.clear();
+				_presentation->sldIdLst.push_back(oFirst);
+				break;
+			}
+		}
+		if (false == slide.IsInit())
+		{
+			_presentation->sldIdLst.clear();
+			return true;
+		}
+
+		slide->Note.Release();
+		slide->Load();
+
+		if (false == slide->Layout.IsInit() || false == slide->Master.IsInit())
+			return true;
+
+		slide->Layout->Load();
+
+		std::vector<Logic::XmlId> arMasters;
+		for (size_t i = 0; i < _presentation->sldMasterIdLst.size(); ++i)
+		{
+			smart_ptr<PPTX::SlideMaster> slideMaster = ((*_presentation)[_presentation->sldMasterIdLst[i].rid.get()]).smart_dynamic_cast<PPTX::SlideMaster>();
+			if (slideMaster.operator ->() == slide->Master.operator ->())
+				arMasters.push_back(_presentation->sldMasterIdLst[i]);
+		}
+		_presentation->sldMasterIdLst = arMasters;
+
+		std::vector<Logic::XmlId> arLayouts;
+		for (size_t i = 0; i < slide->Master->sldLayoutIdLst.size(); ++i)
+		{
+			smart_ptr<PPTX::SlideLayout> slideLayout = ((*slide->Master)[slide->Master->sldLayoutIdLst[i].rid.get()]).smart_dynamic_cast<PPTX::SlideLayout>();
+			if (slideLayout.operator ->() == slide->Layout.operator ->())
+				arLayouts.push_back(slide->Master->sldLayoutIdLst[i]);
+		}
+		slide->Master->sldLayoutIdLst = arLayouts;
+
 		return true;
 	}
 
@@ -42,15 +42,26 @@ namespace PPTX
 		Document();
 		Document(const OOX::CPath& path);
 
-		bool read(const OOX::CPath& path);
+		// bLazy - slides, notes and layouts are not parsed, call WrapperFile::Load for the needed ones
+		// or LoadParts for all of them
+		bool read(const OOX::CPath& path, bool bLazy = false);
 		void write(const OOX::CPath& path);
 		void createFromTemplate(const OOX::CPath& path);
 
+		// parses all deferred parts, in parallel for large documents
+		void LoadParts();
+
+		// for thumbnails - after read(path, true) keeps only the first slide, its layout and master
+		// and parses only them, notes are dropped
+		bool LoadFirstSlideOnly();
+
 		const bool isValid(const OOX::CPath& path) const;
 
 		Presentation* main = NULL;
 
 	private:
 		long CountFiles(const OOX::CPath& path);
+
+		std::vector<smart_ptr<OOX::File>> m_arDeferredParts;
 	};
 } // namespace PPTX
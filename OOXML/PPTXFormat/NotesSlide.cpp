@@ -50,6 +50,8 @@ namespace PPTX
 	void NotesSlide::read(const OOX::CPath& filename, FileMap& map)
 	{
 		//FileContainer::read(filename, map);
+		if (DeferRead(filename, map))
+			return;
 
 		XmlUtils::CXmlNode oNode;
 		oNode.FromXmlFile(filename.m_strFilename);
@@ -101,6 +101,9 @@ namespace PPTX
 	}
 	void Slide::read(const OOX::CPath& filename, FileMap& map)
 	{
+		if (DeferRead(filename, map))
+			return;
+
 		XmlUtils::CXmlNode oNode;
 		oNode.FromXmlFile(filename.m_strFilename);
 
@@ -59,6 +59,9 @@ namespace PPTX
 	{
 		m_sOutputFilename = filename.GetFilename();
 
+		if (DeferRead(filename, map))
+			return;
+
 		XmlUtils::CXmlNode oNode;
 		oNode.FromXmlFile(filename.m_strFilename);
 
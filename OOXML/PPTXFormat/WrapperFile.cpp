@@ -38,6 +38,7 @@ namespace PPTX
 	{
 		m_written = false;
 		m_WrittenFileName = _T("");
+		m_bDeferred = false;
 	}
 	WrapperFile::~WrapperFile()
 	{
@@ -46,6 +47,29 @@ namespace PPTX
 	{
 		return;
 	}
+	bool WrapperFile::DeferRead(const OOX::CPath& filename, FileMap& map)
+	{
+		if (!map.m_bDeferRead)
+			return false;
+
+		m_oDeferredPath = filename;
+		m_bDeferred = true;
+		return true;
+	}
+	void WrapperFile::Load()
+	{
+		if (!m_bDeferred)
+			return;
+
+		m_bDeferred = false;
+
+		FileMap map;
+		read(m_oDeferredPath, map);
+	}
+	bool WrapperFile::IsLoaded() const
+	{
+		return !m_bDeferred;
+	}
 	bool WrapperFile::GetWrittenStatus()const
 	{
 		return m_written;
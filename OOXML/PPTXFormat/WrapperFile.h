@@ -55,7 +55,18 @@ namespace PPTX
 		mutable bool			m_written;
 		mutable OOX::CPath		m_WrittenFileName;
 
+		// remembers the path instead of parsing when map.m_bDeferRead is set
+		bool DeferRead(const OOX::CPath& filename, FileMap& map);
+
+	private:
+		OOX::CPath				m_oDeferredPath;
+		bool					m_bDeferred;
+
 	public:
+		// parses deferred xml (Document::read), does nothing if the file is already parsed
+		void Load();
+		bool IsLoaded() const;
+
 		bool GetWrittenStatus() const;
 		void WrittenSetFalse();
 		const OOX::CPath GetWrittenFileName() const;
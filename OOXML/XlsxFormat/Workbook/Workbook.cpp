@@ -481,9 +481,17 @@ namespace OOX
 				}
 			}
 
+			CXlsx* xlsx = dynamic_cast<CXlsx*>(File::m_pMainDocument);
+			if (xlsx && xlsx->m_nThumbnailRows > 0 && m_oSheets.IsInit() && !m_oSheets->m_arrItems.empty())
+			{
+				LONG lActiveSheet = GetActiveSheetIndex();
+				CSheet* pSheet = (lActiveSheet < (LONG)m_oSheets->m_arrItems.size()) ? m_oSheets->m_arrItems[lActiveSheet] : m_oSheets->m_arrItems.front();
+				if (pSheet && pSheet->m_oRid.IsInit())
+					xlsx->m_sThumbnailSheetRId = pSheet->m_oRid->GetValue();
+			}
+
 			IFileContainer::Read(oRootPath, oPath); //в данном случае порядок считывания важен для xlsb
 
-			CXlsx* xlsx = dynamic_cast<CXlsx*>(File::m_pMainDocument);
 			if (xlsx)
 			{
 				if (xlsx->m_pVbaProject)
@@ -4507,6 +4507,9 @@ boost::int64_t daysFrom1900 = boost::gregorian::date_duration(boost::gregorian::
 			{
 				xlsx_flat->m_nLastReadRow = 0;
 			}
+			int nRowsLimit = xlsx ? xlsx->m_nReadRowsLimit : -1;
+			int nRows = 0;
+
 			if (xlsx && xlsx->m_pXlsbWriter)
 			{
 				int nLastRow = -1;
@@ -4527,6 +4530,9 @@ boost::int64_t daysFrom1900 = boost::gregorian::date_duration(boost::gregorian::
 
 					if ( strcmp("row", sName) == 0 )
 					{
+						if (nRowsLimit >= 0 && nRows++ >= nRowsLimit)
+							continue;
+
 						nLastRow = oRow.m_nR;
 						oRow.Clean();
 						oRow.m_nR = nLastRow + 1;
@@ -4546,6 +4552,9 @@ boost::int64_t daysFrom1900 = boost::gregorian::date_duration(boost::gregorian::
 
 					if ( strcmp("row", sName) == 0 || strcmp("Row", sName) == 0)
 					{
+						if (nRowsLimit >= 0 && nRows++ >= nRowsLimit)
+							continue;
+
 						CRow *pRow = new CRow(m_pMainDocument);
 						if (pRow)
 						{
@@ -94,6 +94,9 @@ namespace OOX
 
 				xlsx->m_arWorksheets.push_back( this );
 				xlsx->m_mapWorksheets.insert( std::make_pair(rId, this) );
+
+				if (xlsx->m_nThumbnailRows > 0)
+					xlsx->m_nReadRowsLimit = (rId == xlsx->m_sThumbnailSheetRId) ? xlsx->m_nThumbnailRows : 0;
 			}
 			else
 				m_bPrepareForBinaryWriter = false;
@@ -103,6 +103,8 @@ void OOX::Spreadsheet::CXlsx::init()
     m_nLastReadRow      = 0;
     m_nLastReadCol      = -1;
     m_bNeedCalcChain    = true;
+    m_nThumbnailRows    = 0;
+    m_nReadRowsLimit    = -1;
 
     bDeleteWorkbook			= false;
     bDeleteSharedStrings	= false;
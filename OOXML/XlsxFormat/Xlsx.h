@@ -96,6 +96,11 @@ namespace OOX
 			int												m_nLastReadCol;
 			bool											m_bNeedCalcChain;// disable because it is useless but reading takes considerable time
 
+			// thumbnail - only the first m_nThumbnailRows rows of the active sheet are read, other sheets without data
+			int												m_nThumbnailRows;
+			std::wstring									m_sThumbnailSheetRId;
+			int												m_nReadRowsLimit;// of the sheet being read, -1 - no limit
+
 			std::vector<CWorksheet*>								m_arWorksheets;	//order as is
 			std::map<std::wstring, OOX::Spreadsheet::CWorksheet*>	m_mapWorksheets; //copy, for fast find - order by rId(name) 
 			
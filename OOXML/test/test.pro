@@ -26,6 +26,8 @@ SOURCES -= $$CORE_GTEST_PATH/src/gtest_main.cc
 SOURCES -= ../../../Common/OfficeFileFormatChecker2.cpp
 SOURCES -= ../../src/cextracttools.cpp
 SOURCES -= ../../src/ASCConverters.cpp
+SOURCES -= ../../src/profiler.cpp
 SOURCES += ../../Common/OfficeFileFormatChecker2.cpp
 SOURCES += $$X2T_DIR/src/cextracttools.cpp
 SOURCES += $$X2T_DIR/src/ASCConverters.cpp
+SOURCES += $$X2T_DIR/src/profiler.cpp
@@ -0,0 +1,204 @@
+/*
+ * (c) Copyright UNIVAULT TECHNOLOGIES 2026-2026
+ *
+ * This program is a free software product. You can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License (AGPL)
+ * version 3 as published by the Free Software Foundation. In accordance with
+ * Section 7(a) of the GNU AGPL its Section 15 shall be amended to the effect
+ * that UNIVAULT TECHNOLOGIES expressly excludes the warranty of non-infringement
+ * of any third-party rights.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR  PURPOSE. For
+ * details, see the GNU AGPL at: http://www.gnu.org/licenses/agpl-3.0.html
+ *
+ * You can contact UNIVAULT TECHNOLOGIES at 20A-6 Ernesta Birznieka-Upish
+ * street, Moscow (TEST), Russia (TEST), EU, 000000 (TEST).
+ *
+ * The  interactive user interfaces in modified source and object code versions
+ * of the Program must display Appropriate Legal Notices, as required under
+ * Section 5 of the GNU AGPL version 3.
+ *
+ * Pursuant to Section 7(b) of the License you must retain the original Product
+ * logo when distributing the program. Pursuant to Section 7(e) we decline to
+ * grant you any rights under trademark law for use of our trademarks.
+ *
+ * All the Product's GUI elements, including illustrations and icon sets, as
+ * well as technical writing content are licensed under the terms of the
+ * Creative Commons Attribution-ShareAlike 4.0 International. See the License
+ * terms at http://creativecommons.org/licenses/by-sa/4.0/legalcode
+ *
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+
+namespace cpdoccore {
+
+namespace formulasconvert {
+
+// Кэш результатов конвертации формул.
+// Одна и та же формула, скопированная по строкам (=A1+B1, =A2+B2, ...), отличается только номерами строк -
+// номера строк ссылок заменяются на 1 (ключ кэша), в результате конвертации номера строк также заменяются на 1 (шаблон),
+// при повторе формулы номера строк подставляются в шаблон обратно в том же порядке.
+// Кэш принадлежит экземпляру конвертера; статические экземпляры конвертеров используются из разных потоков - доступ под мьютексом.
+class formula_cache
+{
+public:
+	static const size_t max_entries = 0x10000;
+
+	// состояние конвертера после прямой конвертации - восстанавливается при попадании в кэш
+	struct entry
+	{
+		std::wstring	value;
+		std::wstring	table_name;
+		bool			table_name_set = false;
+		bool			with_table_name = false;
+		bool			with_absolute = false;
+	};
+
+	// номер строки ссылки - последовательность цифр после буквы/$, за которой не следует продолжение имени
+	static bool is_row_digits(const std::wstring & expr, size_t start, size_t end)
+	{
+		if (start == 0 || end <= start) return false;
+
+		wchar_t prev = expr[start - 1];
+		if (!((prev >= L'A' && prev <= L'Z') || (prev >= L'a' && prev <= L'z') || prev == L'$')) return false;
+
+		if (end < expr.size())
+		{
+			wchar_t next = expr[end];
+			if ((next >= L'A' && next <= L'Z') || (next >= L'a' && next <= L'z') || next == L'_' ||
+				next == L'.' || next == L'!' || next == L'\'' || next > 0x7f) return false;
+		}
+		return true;
+	}
+	static void find_rows(const std::wstring & expr, std::vector<std::pair<size_t, size_t>> & rows)
+	{
+		for (size_t i = 0; i < expr.size(); )
+		{
+			if (expr[i] < L'0' || expr[i] > L'9')
+			{
+				i++;
+				continue;
+			}
+			size_t start = i;
+			while (i < expr.size() && expr[i] >= L'0' && expr[i] <= L'9') i++;
+
+			if (is_row_digits(expr, start, i))
+				rows.push_back(std::make_pair(start, i));
+		}
+	}
+	static bool is_normalized(const std::wstring & row)
+	{
+		// 0, 01, слишком большие номера - не ссылки, оставляем как есть
+		return row[0] != L'0' && row.size() <= 7;
+	}
+	// expr -> key, rows - вырезанные номера строк
+	static std::wstring normalize(const std::wstring & expr, std::vector<std::wstring> & rows)
+	{
+		std::vector<std::pair<size_t, size_t>> pos;
+		find_rows(expr, pos);
+
+		std::wstring key;
+		key.reserve(expr.size());
+
+		size_t last = 0;
+		for (size_t i = 0; i < pos.size(); i++)
+		{
+			std::wstring row = expr.substr(pos[i].first, pos[i].second - pos[i].first);
+			if (false == is_normalized(row)) continue;
+
+			key.append(expr, last, pos[i].first - last);
+			key += L'1';
+			last = pos[i].second;
+			rows.push_back(row);
+		}
+		key.append(expr, last, std::wstring::npos);
+		return key;
+	}
+	// результат конвертации -> шаблон; false - номера строк в результате не совпадают с исходными (порядок, количество)
+	static bool make_template(const std::wstring & value, const std::vector<std::wstring> & rows, std::wstring & templ)
+	{
+		std::vector<std::pair<size_t, size_t>> pos;
+		find_rows(value, pos);
+
+		templ.clear();
+		templ.reserve(value.size());
+
+		size_t last = 0, index = 0;
+		for (size_t i = 0; i < pos.size(); i++)
+		{
+			std::wstring row = value.substr(pos[i].first, pos[i].second - pos[i].first);
+			if (false == is_normalized(row)) continue;
+
+			if (index >= rows.size() || rows[index] != row) return false;
+			index++;
+
+			templ.append(value, last, pos[i].first - last);
+			templ += L'1';
+			last = pos[i].second;
+		}
+		if (index != rows.size()) return false;
+
+		templ.append(value, last, std::wstring::npos);
+		return true;
+	}
+	// обратная подстановка номеров строк в шаблон
+	static bool denormalize(const std::wstring & templ, const std::vector<std::wstring> & rows, std::wstring & result)
+	{
+		std::vector<std::pair<size_t, size_t>> pos;
+		find_rows(templ, pos);
+
+		result.clear();
+		result.reserve(templ.size() + rows.size() * 4);
+
+		size_t last = 0, index = 0;
+		for (size_t i = 0; i < pos.size(); i++)
+		{
+			if (pos[i].second - pos[i].first != 1 || templ[pos[i].first] != L'1') continue;
+			if (index >= rows.size()) return false;
+
+			result.append(templ, last, pos[i].first - last);
+			result += rows[index++];
+			last = pos[i].second;
+		}
+		if (index != rows.size()) return false;
+
+		result.append(templ, last, std::wstring::npos);
+		return true;
+	}
+
+	bool find(const std::wstring & key, entry & e)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		std::unordered_map<std::wstring, entry>::iterator pFind = map_.find(key);
+		if (pFind == map_.end()) return false;
+
+		e = pFind->second;
+		return true;
+	}
+	void add(const std::wstring & key, const entry & e)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		if (map_.size() >= max_entries) map_.clear();
+
+		map_[key] = e;
+	}
+	void clear()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		map_.clear();
+	}
+private:
+	std::mutex								mutex_;
+	std::unordered_map<std::wstring, entry>	map_;
+};
+
+}
+}
@@ -37,10 +37,18 @@
 #include"../../OOXML/Base/Unit.h"
 #include "../Reader/Converter/xlsxconversioncontext.h"
 #include "../Reader/Converter/xlsx_utils.h"
+#include "formulasconvert_cache.h"
 
 namespace cpdoccore {
 namespace formulasconvert {
 
+	static const boost::wregex re_apersand(L"(&)|(\".*?\")|('.*?')");
+	static const boost::wregex re_braces(L"(?:(?:\\{)([^\\}]*?)(?:\\}))|(\".*?\")|('.*?')");
+	static const boost::wregex re_formula_prefix(L"^(?:[\\w]+:)?=(.+)");
+	static const boost::wregex re_quoted(L"('.*?')|(\".*?\")");
+	static const boost::wregex re_semicolons(L"(;)|(\".*?\")|('.*?')");
+	static const boost::wregex re_tilda(L"(~)|(\".*?\")|('.*?')");
+
 	class odf2oox_converter::Impl
 	{
 	public:
@@ -49,6 +57,7 @@ namespace formulasconvert {
 		static std::unordered_map<std::wstring, int> & mapExternalLink_;
 
 		std::wstring convert(const std::wstring& expr);
+		std::wstring convert_(const std::wstring& expr);
 		std::wstring convert_chart_distance(const std::wstring& expr);
 
 		std::wstring convert_list_values(const std::wstring& expr);
@@ -78,7 +87,10 @@ namespace formulasconvert {
 	
 		static bool				convert_with_absolute;
 		static bool				convert_with_TableName;
+		static bool				convert_with_external;
+		static bool				table_name_set_;
 		static std::wstring		table_name_;
+		formula_cache			cache_;
 		static std::vector<std::map<std::wstring, std::wstring>> mapReplacements;
 //-------------------------------------------------------------------------------------------------------------
 		static std::wstring replace_apersand_formater(boost::wsmatch const & what)
@@ -232,6 +244,8 @@ namespace formulasconvert {
 	bool			odf2oox_converter::Impl::convert_with_TableName = true;
 	std::wstring	odf2oox_converter::Impl::table_name_			= L"";
 	bool			odf2oox_converter::Impl::convert_with_absolute	= false;
+	bool			odf2oox_converter::Impl::convert_with_external	= false;
+	bool			odf2oox_converter::Impl::table_name_set_		= false;
 	std::vector<std::map<std::wstring, std::wstring>> odf2oox_converter::Impl::mapReplacements;
 
 	std::unordered_map<std::wstring, int> &odf2oox_converter::Impl::mapExternalLink_ = oox::xlsx_conversion_context::mapExternalLink_;
@@ -244,7 +258,7 @@ namespace formulasconvert {
 
 		workstr = boost::regex_replace(
 			workstr,
-			boost::wregex(L"('.*?')|(\".*?\")"),
+			re_quoted,
 			&convert_scobci, boost::match_default | boost::format_all);
 
 		std::vector< std::wstring > splitted;
@@ -281,7 +295,7 @@ namespace formulasconvert {
 
 	bool odf2oox_converter::Impl::find_first_ref(std::wstring const & expr, std::wstring & table, std::wstring & ref)
 	{
-                boost::wregex re(L"\\[(?:\\$)?([^\\.]+?){0,1}\\.([\\w^0-9\\$]+\\d+)(?::\\.([\\w^0-9]+\\d+)){0,1}\\]");
+                static const boost::wregex re(L"\\[(?:\\$)?([^\\.]+?){0,1}\\.([\\w^0-9\\$]+\\d+)(?::\\.([\\w^0-9]+\\d+)){0,1}\\]");
 		boost::wsmatch result;
 		bool b = boost::regex_search(expr, result, re);
 
@@ -347,6 +361,7 @@ namespace formulasconvert {
 
 		if (false == external.empty())
 		{
+			convert_with_external = true;
 			replace_tmp_back(external);
 
 			int id = -1;//add_external_link(external);
@@ -381,6 +396,7 @@ namespace formulasconvert {
 		}
 		
 		table_name_ = sheet1;
+		table_name_set_ = true;
 
 		if (convert_with_absolute)
 		{
@@ -430,6 +446,7 @@ namespace formulasconvert {
 		}
 
 		table_name_ = sheet1;
+		table_name_set_ = true;
 
 		if (convert_with_absolute)
 		{
@@ -474,7 +491,7 @@ namespace formulasconvert {
 		convert_with_absolute = bAbsoluteAlways;
 
 		//boost::wregex complexRef(L"\\[(?:\'([^\']*)\'#){0,1}\\[{0,1}(?:\\$){0,1}([^\\.]+?){0,1}\\.(\\${0,1}[\\w^0-9]*\\${0,1}\\d*)(?::(\\${0,1}[^\\.]+?){0,1}\\.(\\${0,1}[\\w^0-9]*\\${0,1}\\d*)){0,1}\\]{0,1}");
-		boost::wregex complexRef(L"(?:(?:(?:(?:\\[(.*)#)|(?:(.*)#\\[)))|(?:\\[))\
+		static const boost::wregex complexRef(L"(?:(?:(?:(?:\\[(.*)#)|(?:(.*)#\\[)))|(?:\\[))\
 (?:\\$){0,1}([^\\.]+?){0,1}\\.(\\${0,1}[\\w^0-9]*\\${0,1}\\d*)(?::(\\${0,1}[^\\.]+?){0,1}\\.(\\${0,1}[\\w^0-9]*\\${0,1}\\d*)){0,1}\\]");
 //									 [ external#  [  $   Sheet2         . A1								 : ( $   Sheet2)? . B5                    ]
 
@@ -487,7 +504,7 @@ namespace formulasconvert {
 		if (result == expr)
 		{
 			//bad formula ???
-			boost::wregex complexRef_2(L"\\$([^\\.]+?)?\\.(\\$[a-zA-Z]*\\d*)(\\:\\$[a-zA-Z]*\\d*)?");
+			static const boost::wregex complexRef_2(L"\\$([^\\.]+?)?\\.(\\$[a-zA-Z]*\\d*)(\\:\\$[a-zA-Z]*\\d*)?");
 			//	$ Sheet2  . $ A1		 : ( $   Sheet2)? . $ B5   
 
 			result = boost::regex_replace(
@@ -510,7 +527,7 @@ namespace formulasconvert {
 		convert_with_absolute = bAbsoluteAlways;
 		
 		//boost::wregex complexRef(L"\\${0,1}([^\\.]+?){0,1}\\.(\\${0,1}[a-zA-Z]+\\${0,1}\\d+)(?::\\.(\\${0,1}[a-zA-Z]+\\${0,1}\\d+)){0,1}");
-		boost::wregex complexRef(L"\\[{0,1}(?:(.*)#){0,1}\\${0,1}([^\\.\\s]+?){0,1}\\.(\\${0,1}[\\w^0-9]*\\${0,1}\\d*)(?::\\${0,1}([^\\.\\s]+?){0,1}\\.(\\${0,1}[\\w^0-9]*\\${0,1}\\d*)){0,1}\\]{0,1}");
+		static const boost::wregex complexRef(L"\\[{0,1}(?:(.*)#){0,1}\\${0,1}([^\\.\\s]+?){0,1}\\.(\\${0,1}[\\w^0-9]*\\${0,1}\\d*)(?::\\${0,1}([^\\.\\s]+?){0,1}\\.(\\${0,1}[\\w^0-9]*\\${0,1}\\d*)){0,1}\\]{0,1}");
 //									  external#  $   Sheet2         . A1								 : ( $   Sheet2)? . B5   
 	
 		const std::wstring res = boost::regex_replace(
@@ -528,7 +545,7 @@ namespace formulasconvert {
 		if (expr.empty()) return false;
 
 		boost::match_results<std::wstring::const_iterator> res;
-		if (boost::regex_search(expr, res, boost::wregex(L"^(?:[\\w]+:)?=(.+)"), boost::match_default))
+		if (boost::regex_search(expr, res, re_formula_prefix, boost::match_default))
 		{
 			expr = res[1].str();
 			while (expr.find(L"=") == 0)
@@ -546,7 +563,7 @@ namespace formulasconvert {
 		 const std::wstring res = boost::regex_replace(
 			expr,
 			//boost::wregex(L"(;)|(?:\".*?\")|(?:'.*?')"),
-			boost::wregex(L"(;)|(\".*?\")|('.*?')"),
+			re_semicolons,
 			del_quotes ? &replace_semicolons_formater_del : &replace_semicolons_formater,
 			boost::match_default | boost::format_all);
 
@@ -557,7 +574,7 @@ namespace formulasconvert {
 		 const std::wstring res = boost::regex_replace(
 			expr,
 			//boost::wregex(L"(;)|(?:\".*?\")|(?:'.*?')"),
-			boost::wregex(L"(~)|(\".*?\")|('.*?')"),
+			re_tilda,
 			&replace_semicolons_formater,
 			boost::match_default | boost::format_all);
 
@@ -568,7 +585,7 @@ namespace formulasconvert {
 		const std::wstring res = boost::regex_replace(
 			expr,
 			//boost::wregex(L"(;)|(?:\".*?\")|(?:'.*?')"),
-			boost::wregex(L"(&)|(\".*?\")|('.*?')"),
+			re_apersand,
 			&replace_apersand_formater,
 			boost::match_default | boost::format_all);
 
@@ -579,7 +596,7 @@ namespace formulasconvert {
 	{
 		 const std::wstring res = boost::regex_replace(
 			expr,
-			boost::wregex(L"(?:(?:\\{)([^\\}]*?)(?:\\}))|(\".*?\")|('.*?')"),
+			re_braces,
 			&replace_vertical_formater,
 			boost::match_default | boost::format_all);
 		 expr = res;
@@ -589,13 +606,49 @@ namespace formulasconvert {
 	{
 		 const std::wstring res = boost::regex_replace(
 			expr,
-			boost::wregex(L"(?:(?:\\{)([^\\}]*?)(?:\\}))|(\".*?\")|('.*?')"),
+			re_braces,
 			&replace_space_formater,
 			boost::match_default | boost::format_all);
 		 expr = res;
 	}
 
+	// формулы, отличающиеся только номерами строк, конвертируются один раз
 	std::wstring odf2oox_converter::Impl::convert(const std::wstring& expr)
+	{
+		std::vector<std::wstring> rows;
+		std::wstring key = formula_cache::normalize(expr, rows);
+
+		formula_cache::entry cached;
+		if (false == expr.empty() && cache_.find(key, cached))
+		{
+			std::wstring result;
+			if (formula_cache::denormalize(cached.value, rows, result))
+			{
+				if (cached.table_name_set)
+					table_name_ = cached.table_name;
+				convert_with_TableName	= cached.with_table_name;
+				convert_with_absolute	= cached.with_absolute;
+				return result;
+			}
+		}
+		convert_with_external = false;
+		table_name_set_ = false;
+
+		std::wstring result = convert_(expr);
+
+		formula_cache::entry entry;
+		if (false == expr.empty() && false == convert_with_external && formula_cache::make_template(result, rows, entry.value))
+		{
+			entry.table_name		= table_name_;
+			entry.table_name_set	= table_name_set_;
+			entry.with_table_name	= convert_with_TableName;
+			entry.with_absolute		= convert_with_absolute;
+
+			cache_.add(key, entry);
+		}
+		return result;
+	}
+	std::wstring odf2oox_converter::Impl::convert_(const std::wstring& expr)
 	{
 		std::wstring workstr = is_forbidden(expr);
 
@@ -605,7 +658,7 @@ namespace formulasconvert {
 		mapReplacements.emplace_back();
 
 		workstr = boost::regex_replace(workstr,
-			boost::wregex(L"('.*?')|(\".*?\")"),
+			re_quoted,
 			&convert_scobci, boost::match_default | boost::format_all);
 
 		workstr = replace_cells_range	(workstr, true);
@@ -648,7 +701,7 @@ namespace formulasconvert {
 
 		std::wstring workstr = boost::regex_replace(
 			expr,
-			boost::wregex(L"('.*?')|(\".*?\")"),
+			re_quoted,
 			&convert_scobci, boost::match_default | boost::format_all);
 	    
 		boost::algorithm::split(out, workstr, boost::algorithm::is_any_of(by), boost::algorithm::token_compress_on);
@@ -676,7 +729,7 @@ namespace formulasconvert {
 
 		std::wstring workstr = boost::regex_replace(
 			is_forbidden(expr),
-			boost::wregex(L"('.*?')|(\".*?\")"),
+			re_quoted,
 			&convert_scobci, boost::match_default | boost::format_all);
 	    
 		std::vector<std::wstring> distance_inp;
@@ -736,7 +789,7 @@ namespace formulasconvert {
 	}
 	std::wstring odf2oox_converter::Impl::convert_named_ref(const std::wstring& expr, bool withTableName, std::wstring separator, bool bAbsoluteAlways)
 	{
-		boost::wregex complexRef(L"('(?!\\s\\'){0,1}.*?')");// поиск того что в апострофах и замена там
+		static const boost::wregex complexRef(L"('(?!\\s\\'){0,1}.*?')");// поиск того что в апострофах и замена там
 
 		std::wstring workstr = expr;
 
@@ -744,7 +797,7 @@ namespace formulasconvert {
 
 		workstr = boost::regex_replace(
 			workstr,
-			boost::wregex(L"('.*?')|(\".*?\")"),
+			re_quoted,
 			&convert_scobci, boost::match_default | boost::format_all);
 
 		replace_named_ref(workstr, withTableName, bAbsoluteAlways);
@@ -779,7 +832,7 @@ namespace formulasconvert {
 
 			workstr = boost::regex_replace(
 				workstr,
-				boost::wregex(L"('.*?')|(\".*?\")"),
+				re_quoted,
 				&convert_scobci, boost::match_default | boost::format_all);
 		   
 			workstr = replace_cells_range(workstr, withTableName, bAbsoluteAlways);
@@ -36,11 +36,20 @@
 
 #include"../../OOXML/Base/Unit.h"
 #include "boost/lexical_cast.hpp"
+#include "formulasconvert_cache.h"
 //#include <random>
 
 namespace cpdoccore {
 namespace formulasconvert {
 
+	static const boost::wregex re_arguments(L"(?!([[:Unicode:]\\w^0-9]+\\d*\\())(((\[[0-9]+\])?[[[:Unicode:]\\w^0-9]+\\!)?\\$?[\\w^0-9]*\\$?\\d*(\\:\\$?[\\w^0-9]*\\$?\\d*){0,1})");
+	static const boost::wregex re_braces(L"(?:(?:\\{)([^\\}]*?)(?:\\}))|(\".*?\")|('.*?')");
+	static const boost::wregex re_brackets(L"(?:(?=[()])(.*?)(?=[)]))");
+	static const boost::wregex re_cell_ranges(L"(\\$?\\w+\\!)?([a-zA-Z$]+\\d{1,})\\:?([a-zA-Z$]+\\d{1,})?");
+	static const boost::wregex re_commas(L"(,)|(\".*?\")|('.*?')");
+	static const boost::wregex re_quoted(L"('.*?')|(\".*?\")");
+	static const boost::wregex re_simple_ref(L"([\\w]+\\!)?\\$?[a-zA-Z]+\\$?\\d+(\\:\\$?[a-zA-Z]+\\$?\\d+)?");
+
 	static std::wstring forbidden_formulas1[] =
 	{
 		L"NULLFORMULA()"
@@ -63,6 +72,7 @@ public:
 
     std::wstring convert(const std::wstring& expr);
 	std::wstring convert_formula(const std::wstring& expr);
+	std::wstring convert_formula_(const std::wstring& expr);
 	std::wstring convert_conditional_formula(const std::wstring& expr);
 
 	std::wstring convert_ref_distances(std::wstring const& expr, std::wstring const& separator_in, std::wstring const& separator_out);
@@ -184,6 +194,7 @@ public:
 	static bool isFindBaseCell_;
 
 	static std::wstring table_name_;
+	formula_cache cache_;
 };
 
 bool			oox2odf_converter::Impl::isFindBaseCell_ = false;
@@ -192,14 +203,14 @@ std::vector<std::map<std::wstring, std::wstring>> oox2odf_converter::Impl::mapRe
 
 void oox2odf_converter::Impl::replace_cells_range(std::wstring& expr, bool bSelect)
 {
-	boost::wregex re(L"(([:$!])+)|(\\S+\\d+)");
+	static const boost::wregex re(L"(([:$!])+)|(\\S+\\d+)");
 
 	boost::wsmatch result;
 	bool b = boost::regex_search(expr, result, re);
 
 	if (b)
 	{
-		boost::wregex re1(L"(\\$?[^\\']+\\!)?([a-zA-Z$]+\\d*)(\\:[a-zA-Z$]+\\d*)?");
+		static const boost::wregex re1(L"(\\$?[^\\']+\\!)?([a-zA-Z$]+\\d*)(\\:[a-zA-Z$]+\\d*)?");
 //                          $   Sheet2   ! $ A1                 :  $ B5    
 //                          $   Sheet2   ! $ A                  :  $ A    
 //                          $   Sheet2   ! $ 1                  :  $ 1    
@@ -402,7 +413,7 @@ bool oox2odf_converter::Impl::is_simple_ref(std::wstring const & expr)
 	if (expr.find(L";") != std::wstring::npos) return false;
 
 	boost::wsmatch match;
-	if (boost::regex_search(expr, match, boost::wregex(L"([\\w]+\\!)?\\$?[a-zA-Z]+\\$?\\d+(\\:\\$?[a-zA-Z]+\\$?\\d+)?")))
+	if (boost::regex_search(expr, match, re_simple_ref))
 	{
 		return true;
 	}
@@ -423,7 +434,7 @@ void oox2odf_converter::Impl::replace_named_ref(std::wstring & expr)
 	
 	std::wstring res1 = boost::regex_replace(
         workstr,
-		boost::wregex(L"('.*?')|(\".*?\")"),
+		re_quoted,
 		&oox2odf_converter::Impl::convert_scobci, boost::match_default | boost::format_all);
 
 	std::vector<std::wstring> distance;
@@ -462,7 +473,7 @@ void oox2odf_converter::Impl::replace_semicolons(std::wstring& expr)
      const std::wstring res = boost::regex_replace(
         expr,
         //boost::wregex(L"(;)|(?:\".*?\")|(?:'.*?')"),
-        boost::wregex(L"(,)|(\".*?\")|('.*?')"),
+        re_commas,
         &replace_semicolons_formater,
         boost::match_default | boost::format_all);
      expr = res;
@@ -484,7 +495,7 @@ void oox2odf_converter::Impl::replace_vertical(std::wstring& expr)
 {
      const std::wstring res = boost::regex_replace(
         expr,
-        boost::wregex(L"(?:(?:\\{)([^\\}]*?)(?:\\}))|(\".*?\")|('.*?')"),
+        re_braces,
         &replace_vertical_formater,
         boost::match_default | boost::format_all);
      expr = res;
@@ -494,7 +505,7 @@ void oox2odf_converter::Impl::replace_space(std::wstring& expr)
 {
      const std::wstring res = boost::regex_replace(
         expr,
-        boost::wregex(L"(?:(?:\\{)([^\\}]*?)(?:\\}))|(\".*?\")|('.*?')"),
+        re_braces,
         &replace_space_formater,
         boost::match_default | boost::format_all);
      expr = res;
@@ -567,20 +578,47 @@ std::wstring oox2odf_converter::Impl::convert(const std::wstring& expr)
     return workstr;
 }
 // (Formula) -> of:=(Formula) 
-
+// формулы, отличающиеся только номерами строк, конвертируются один раз
 std::wstring oox2odf_converter::Impl::convert_formula(const std::wstring & expr)
+{
+	if (isFindBaseCell_)
+		return convert_formula_(expr);
+
+	// результат зависит от имени текущей таблицы - оно входит в ключ
+	std::vector<std::wstring> rows;
+	std::wstring key = table_name_ + L'\n' + formula_cache::normalize(expr, rows);
+
+	formula_cache::entry cached;
+	if (cache_.find(key, cached))
+	{
+		std::wstring result;
+		if (formula_cache::denormalize(cached.value, rows, result))
+			return result;
+	}
+	std::wstring table_name = table_name_;
+
+	std::wstring result = convert_formula_(expr);
+
+	formula_cache::entry entry;
+	if (table_name == table_name_ && formula_cache::make_template(result, rows, entry.value))
+	{
+		cache_.add(key, entry);
+	}
+	return result;
+}
+std::wstring oox2odf_converter::Impl::convert_formula_(const std::wstring & expr)
 {	
     std::wstring workstr = expr;
 
 	mapReplacements.emplace_back();
 	std::wstring res1 = boost::regex_replace(
         workstr,    
-		boost::wregex(L"('.*?')|(\".*?\")"),
+		re_quoted,
 		&oox2odf_converter::Impl::convert_scobci, boost::match_default | boost::format_all);
 	
 	std::wstring res = boost::regex_replace(
 		res1,
-		boost::wregex(L"(?!([[:Unicode:]\\w^0-9]+\\d*\\())(((\[[0-9]+\])?[[[:Unicode:]\\w^0-9]+\\!)?\\$?[\\w^0-9]*\\$?\\d*(\\:\\$?[\\w^0-9]*\\$?\\d*){0,1})"),
+		re_arguments,
 		&oox2odf_converter::Impl::replace_arguments, boost::match_default | boost::format_all);
 
 	//SUBTOTAL(109,Expense31[Amount])
@@ -593,7 +631,7 @@ std::wstring oox2odf_converter::Impl::convert_formula(const std::wstring & expr)
 	
 		res = boost::regex_replace(
 			res1,	
-			boost::wregex(L"(\\$?\\w+\\!)?([a-zA-Z$]+\\d{1,})\\:?([a-zA-Z$]+\\d{1,})?"),
+			re_cell_ranges,
 			&replace_cells_range_formater1,
 			boost::match_default | boost::format_all);
 	}
@@ -621,18 +659,18 @@ std::wstring oox2odf_converter::Impl::convert_conditional_formula(const std::wst
 
 	std::wstring res1 = boost::regex_replace(
         workstr,
-		boost::wregex(L"('.*?')|(\".*?\")"),
+		re_quoted,
 		&oox2odf_converter::Impl::convert_scobci, boost::match_default | boost::format_all);
 	
 	std::wstring res = boost::regex_replace(
 		res1,
-		boost::wregex(L"(?:(?=[()])(.*?)(?=[)]))"),
+		re_brackets,
 		&oox2odf_converter::Impl::replace_arguments, boost::match_default | boost::format_all);
 
 	if (res1 == res)
 	{
 		res = boost::regex_replace(res1,	
-			boost::wregex(L"(\\$?\\w+\\!)?([a-zA-Z$]+\\d{1,})\\:?([a-zA-Z$]+\\d{1,})?"),
+			re_cell_ranges,
 			&replace_cells_range_formater1,
 			boost::match_default | boost::format_all);
 	     
@@ -570,6 +570,7 @@ HEADERS += \
         ../../DataTypes/tableoperator.h \
         \
 	../../Formulas/formulasconvert.h \
+	../../Formulas/formulasconvert_cache.h \
 	../../Reader/Format/odf_document.h \
 	../../Reader/Format/abstract_xml.h \
 	../../Reader/Format/all_elements.h \
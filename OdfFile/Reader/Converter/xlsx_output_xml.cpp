@@ -41,7 +41,7 @@ namespace oox {
 class xlsx_xml_worksheet::Impl
 {
 public:
-    Impl(std::wstring const & name, bool hidden, const std::wstring& external) : name_(name), hidden_(hidden), external_(external) {}
+    Impl(std::wstring const & name, bool hidden, const std::wstring& external) : name_(name), hidden_(hidden), external_(external), sheetDataBuf_(NULL) {}
     
 	std::wstring external_;
 	std::wstring name_;
@@ -73,6 +73,8 @@ public:
 	std::wstringstream  cols_;
     std::wstringstream  sheetFormat_;
     std::wstringstream  sheetData_;
+    std::wstringstream  sheetDataCapture_;
+    std::wstreambuf*    sheetDataBuf_;
     std::wstringstream  mergeCells_;
     std::wstringstream  hyperlinks_;
     std::wstringstream  comments_;
@@ -139,6 +141,23 @@ std::wostream & xlsx_xml_worksheet::sheetData()
 {
     return impl_->sheetData_;
 }
+void xlsx_xml_worksheet::start_sheetData_capture()
+{
+	impl_->sheetDataCapture_.str(std::wstring());
+	impl_->sheetDataBuf_ = static_cast<std::wios &>(impl_->sheetData_).rdbuf(impl_->sheetDataCapture_.rdbuf());
+}
+std::wstring xlsx_xml_worksheet::end_sheetData_capture()
+{
+	if (!impl_->sheetDataBuf_) return L"";
+
+	static_cast<std::wios &>(impl_->sheetData_).rdbuf(impl_->sheetDataBuf_);
+	impl_->sheetDataBuf_ = NULL;
+
+	std::wstring captured = impl_->sheetDataCapture_.str();
+	impl_->sheetData_ << captured;
+	
+	return captured;
+}
 std::wostream & xlsx_xml_worksheet::mergeCells()
 {
     return impl_->mergeCells_;
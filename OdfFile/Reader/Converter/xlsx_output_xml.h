@@ -56,6 +56,9 @@ public:
 	std::wostream & cols();
     std::wostream & sheetFormat();
     std::wostream & sheetData();
+	// перенаправление sheetData во временный буфер (для повторяющихся строк)
+	void start_sheetData_capture();
+	std::wstring end_sheetData_capture();
     std::wostream & hyperlinks();
     std::wostream & mergeCells();
     std::wostream & comments();
@@ -375,6 +375,21 @@ bool xlsx_table_state::is_empty_row() const
     return empty_row_;
 }
 
+void xlsx_table_state::add_repeated_rows(int count, bool bHeader, bool bBreakBefore, bool bBreakAfter)
+{//повторы строки, уже записанные по шаблону первой (или пропущенные), - без ячеек, состояние как после первой
+	for (int i = 1; (bBreakBefore || bBreakAfter) && i <= count; i++)
+	{
+		row_breaks_.push_back(current_table_row_ + i + (bBreakAfter ? 1 : 0));
+	}
+	add_empty_row(count, bHeader);
+}
+
+void xlsx_table_state::set_sheet_tail(size_t xfId, const std::wstring & ht)
+{
+	sheet_tail_style_	= xfId;
+	sheet_tail_height_	= ht;
+}
+
 std::wstring xlsx_table_state::default_row_cell_style() const
 {
     return row_default_cell_style_name_;
@@ -764,11 +779,22 @@ void xlsx_table_state::serialize_table_format (std::wostream & strm)
 			ht_s.precision(1);
 			ht_s << std::fixed << default_height;
 			
-			CP_XML_NODE(L"sheetFormatPr")
+			if (sheet_tail_height_.empty())
 			{
-				CP_XML_ATTR(L"defaultRowHeight", ht_s.str());	
+				CP_XML_NODE(L"sheetFormatPr")
+				{
+					CP_XML_ATTR(L"defaultRowHeight", ht_s.str());	
+				}
 			}
 		}  
+		if (false == sheet_tail_height_.empty())
+		{//высота незаписанных строк хвоста листа
+			CP_XML_NODE(L"sheetFormatPr")
+			{
+				CP_XML_ATTR(L"defaultRowHeight", sheet_tail_height_);	
+				CP_XML_ATTR(L"customHeight", 1);	
+			}
+		}
 	}
 
 }
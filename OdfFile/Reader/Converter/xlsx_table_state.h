@@ -157,10 +157,16 @@ public:
 
 	void non_empty_row	();
     bool is_empty_row	() const;
+	void add_repeated_rows(int count, bool bHeader, bool bBreakBefore, bool bBreakAfter);
     void end_row		();
 
 	void add_empty_row(int count, bool bHeader = false);
 
+	// строки до конца листа одним стилем - стиль колонок и высота строк по умолчанию
+	void	set_sheet_tail(size_t xfId, const std::wstring & ht);
+	bool	is_sheet_tail() const { return (bool)sheet_tail_style_; }
+	size_t	sheet_tail_style() const { return sheet_tail_style_.get_value_or(0); }
+
 	void set_end_table(){ bEndTable = true; }
 	bool get_end_table(){ return bEndTable; }
     
@@ -273,6 +279,9 @@ private:
     std::vector<unsigned int>			columns_;
     unsigned int						columns_count_;
     double								table_column_last_width_;
+
+	_CP_OPT(size_t)						sheet_tail_style_;
+	std::wstring						sheet_tail_height_;
 	
 	std::vector<std::pair<unsigned int, unsigned int>> columnsHeaders_; // start, repeate
 	std::vector<std::pair<unsigned int, unsigned int>> rowsHeaders_;
@@ -581,6 +581,10 @@ void xlsx_conversion_context::end_table()
 					CP_XML_ATTR(L"max", cMax);
 					CP_XML_ATTR(L"min", cMin);
 					//CP_XML_ATTR(L"style", 0);
+					if (get_table_context().state()->is_sheet_tail())
+					{
+						CP_XML_ATTR(L"style", get_table_context().state()->sheet_tail_style());
+					}
 					CP_XML_ATTR(L"width", lastWidht);
 					CP_XML_ATTR(L"customWidth", 1);
 				}
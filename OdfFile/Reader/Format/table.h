@@ -365,6 +365,7 @@ public:
 	bool empty_content_cells(bool bWithCellStyle = true);
 
 	bool bHeader = false;
+	bool bSheetTail = false; // повторы до конца листа - стилем колонок, строки не пишутся
 
     table_table_row_attlist		attlist_;
     office_element_ptr_array	content_; // table-table-cell or table-covered-table-cell
@@ -417,6 +418,8 @@ public:
 	bool last_cell_ = false;
 	bool empty(bool bWithStyle = true);
 
+	size_t xlsx_empty_style(oox::xlsx_conversion_context & Context);
+
     table_table_cell_attlist		attlist_;
     table_table_cell_attlist_extra	attlist_extra_;
     table_table_cell_content		content_;
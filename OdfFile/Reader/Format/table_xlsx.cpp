@@ -81,60 +81,46 @@ int table_table_cell_content::xlsx_convert(oox::xlsx_conversion_context & Contex
     return sharedStrId;
 }
 
-void table_table_row::xlsx_convert(oox::xlsx_conversion_context & Context)
+namespace {
+
+//повторы строки без значений, формул и объединений отличаются только номером строки
+bool is_template_row(const office_element_ptr_array & content)
 {
-	bool bEndTable = Context.get_table_context().state()->get_end_table();
-	
-	if (attlist_.table_number_rows_repeated_ > 1 && empty())
+	for (size_t i = 0 ; i < content.size(); i++)
 	{
-		Context.get_table_context().state()->add_empty_row(attlist_.table_number_rows_repeated_, bHeader);
-		return;
-	}
-	if (attlist_.table_number_rows_repeated_ > 0x0f00 && empty_content_cells(false) || bEndTable)//0xf000 - conv_KDZO3J3xLIbZ5fC0HR0__xlsx.ods
-	{
-		Context.get_table_context().state()->set_end_table();
-		Context.get_table_context().state()->add_empty_row(attlist_.table_number_rows_repeated_, bHeader);
-		return;		//conv_hSX8n3lVbhALjt0aafg__xlsx.ods, conv_MA2CauoNfX_7ejKS5eg__xlsx.ods
+		table_table_cell *cell = dynamic_cast<table_table_cell*>(content[i].get());
+		
+		if (!cell) return false;
+		if (!cell->empty(false)) return false;
+		if (cell->attlist_.table_content_validation_name_) return false;
+
+		const common_value_and_type_attlist & attr = cell->attlist_.common_value_and_type_attlist_;
+		
+		if (attr.office_value_type_ || attr.office_value_ || attr.office_date_value_ || attr.office_time_value_ || 
+			attr.office_boolean_value_ || attr.office_string_value_) return false;
 	}
+	return true;
+}
 
-    std::wostream & strm = Context.current_sheet().sheetData();
-///обработка чтилей для роу -
-	size_t Default_Cell_style_in_row_ = 0; 
+//строка целиком из одной пустой ячейки со стилем, повторенной на всю ширину таблицы - пишется стилем строки, без ячеек
+table_table_cell * get_uniform_row_cell(const office_element_ptr_array & content, unsigned int columns_count)
+{
+	if (content.size() != 1) return NULL;
 
-    const std::wstring rowStyleName			= attlist_.table_style_name_.get_value_or(L"");
-    const std::wstring defaultCellStyleName = attlist_.table_default_cell_style_name_.get_value_or( L"");
+	table_table_cell *cell = dynamic_cast<table_table_cell*>(content[0].get());
 
-	style_instance * instStyle_CellDefault = 
-				Context.root()->odf_context().styleContainer().style_by_name(defaultCellStyleName, style_family::TableCell, false/*false*/);
-	
-	style_table_cell_properties * prop_CellDefault = NULL;
+	if (!cell || !cell->attlist_.table_style_name_) return NULL;
+	if (cell->attlist_.table_number_columns_repeated_ < 2 || cell->attlist_.table_number_columns_repeated_ < columns_count) return NULL;
 	
-	if ((instStyle_CellDefault) && (instStyle_CellDefault->content())) 
-		prop_CellDefault = instStyle_CellDefault->content()->get_style_table_cell_properties();
-//кастомные настройки стиля ячеек в данном роу
-
-	if (prop_CellDefault) //проверим что есть вообще кастом для роу- а потом уже посчитаем стиль
-	{
-		odf_reader::style_table_cell_properties_attlist	cellFormatProperties = calc_table_cell_properties(instStyle_CellDefault);
-		Default_Cell_style_in_row_ = Context.get_style_manager().xfId(NULL,NULL, &cellFormatProperties, NULL, L"", 0, true);	
-	}
-	else //стиля ячеек для строки нет глянем что там внутри строки в последней ячейке
-	{
-		//возьмем стиль из последнего cell если он повторяющийся (тогда и ячейки вхолостую ненадо писать)
-		int ind_last_cell = content_.size()-1;
-		table_table_cell *last_cell = NULL;
-		if (ind_last_cell > 0)
-			last_cell = dynamic_cast<table_table_cell *>(content_[ind_last_cell].get());
-
-	}
-//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-	bool skip_next_row = false;
-
-    std::wstring ht		= L"";
-    double row_height	= 0.0;
+	if (false == is_template_row(content)) return NULL;
 
-	bool bBreakAfter = false, bBreakBefore = false;
+	return cell;
+}
 
+//высота и разрывы страницы из стиля строки
+void calc_row_properties(oox::xlsx_conversion_context & Context, const std::wstring & rowStyleName, 
+						 std::wstring & ht, double & row_height, bool & bBreakBefore, bool & bBreakAfter)
+{
     odf_read_context & odfContext = Context.root()->odf_context();
 
     odf_reader::style_instance * rowStyle = odfContext.styleContainer().style_by_name(rowStyleName, odf_types::style_family::TableRow,false/*false*/);
@@ -158,7 +144,7 @@ void table_table_row::xlsx_convert(oox::xlsx_conversion_context & Context)
 			ht_s << std::fixed << row_height;
 			ht = ht_s.str();    
 		}
-		if ((prop->attlist_.common_break_attlist_.fo_break_before_) && 
+		if ((prop) && (prop->attlist_.common_break_attlist_.fo_break_before_) && 
 			(prop->attlist_.common_break_attlist_.fo_break_before_->get_type() == odf_types::fo_break::Page))
 		{
 			bBreakBefore = true;
@@ -169,96 +155,360 @@ void table_table_row::xlsx_convert(oox::xlsx_conversion_context & Context)
 			bBreakAfter = true;
 		}
 	}
+}
+
+//число колонок и строк таблицы до конвертации
+unsigned int count_columns(const office_element_ptr_array & content);
+unsigned int count_rows(const office_element_ptr_array & content);
+
+unsigned int count_columns(const table_columns & columns)
+{
+	unsigned int count = 0;
+	if (table_table_columns *cols = dynamic_cast<table_table_columns*>(columns.table_table_columns_.get()))
+		count += count_columns(cols->content_);
+	return count + count_columns(columns.table_table_column_);
+}
+unsigned int count_columns(const office_element_ptr_array & content)
+{
+	unsigned int count = 0;
+	for (size_t i = 0; i < content.size(); i++)
+	{
+		if (table_table_column *column = dynamic_cast<table_table_column*>(content[i].get()))
+		{
+			count += column->attlist_.table_number_columns_repeated_;
+		}
+		else if (table_table_column_group *group = dynamic_cast<table_table_column_group*>(content[i].get()))
+		{
+			count += count_columns(group->table_columns_and_groups_.content_);
+		}
+		else if (table_columns_no_group *columns = dynamic_cast<table_columns_no_group*>(content[i].get()))
+		{
+			count += count_columns(columns->table_columns_1_);
+			if (table_table_header_columns *header = dynamic_cast<table_table_header_columns*>(columns->table_table_header_columns_.get()))
+				count += count_columns(header->content_);
+			count += count_columns(columns->table_columns_2_);
+		}
+	}
+	return count;
+}
+unsigned int count_rows(const table_rows & rows)
+{
+	if (table_table_rows *table_rows = dynamic_cast<table_table_rows*>(rows.table_table_rows_.get()))
+		return count_rows(table_rows->content_);
+	return count_rows(rows.table_table_row_);
+}
+unsigned int count_rows(const office_element_ptr_array & content)
+{
+	unsigned int count = 0;
+	for (size_t i = 0; i < content.size(); i++)
+	{
+		if (table_table_row *row = dynamic_cast<table_table_row*>(content[i].get()))
+		{
+			count += row->attlist_.table_number_rows_repeated_;
+		}
+		else if (table_table_row_group *group = dynamic_cast<table_table_row_group*>(content[i].get()))
+		{
+			count += count_rows(group->table_rows_and_groups_.content_);
+		}
+		else if (table_rows_no_group *rows = dynamic_cast<table_rows_no_group*>(content[i].get()))
+		{
+			count += count_rows(rows->table_rows_1_);
+			if (table_table_header_rows *header = dynamic_cast<table_table_header_rows*>(rows->table_table_header_rows_.get()))
+				count += count_rows(header->content_);
+			count += count_rows(rows->table_rows_2_);
+		}
+	}
+	return count;
+}
+table_table_row * get_last_row(const table_rows & rows)
+{
+	const office_element_ptr_array * content = &rows.table_table_row_;
+	if (table_table_rows *table_rows = dynamic_cast<table_table_rows*>(rows.table_table_rows_.get()))
+		content = &table_rows->content_;
+
+	return content->empty() ? NULL : dynamic_cast<table_table_row*>(content->back().get());
+}
+
+//последний повтор строк таблицы, целиком из одной пустой ячейки со стилем и до конца листа xlsx - 
+//пишется стилем колонок, сами строки не пишутся. Строки выше него при этом пишутся все (стиль колонок не должен
+//на них распространиться), поэтому хвост берется только если он длиннее всего, что выше.
+table_table_row * get_sheet_tail_row(const table_rows_and_groups & rows, unsigned int columns_count)
+{
+	if (rows.content_.empty()) return NULL;
+
+	table_rows_no_group *no_group = dynamic_cast<table_rows_no_group*>(rows.content_.back().get());
+	if (!no_group) return NULL;
+
+	table_table_row *tail = get_last_row(no_group->table_rows_2_);
+	if (!tail && !no_group->table_table_header_rows_)
+		tail = get_last_row(no_group->table_rows_1_);
+
+	if (!tail || !get_uniform_row_cell(tail->content_, columns_count)) return NULL;
+	if (tail->attlist_.table_visibility_.get_type() != table_visibility::Visible) return NULL;
+
+	const unsigned int max_rows = 0x100000;
+	const unsigned int rows_count = count_rows(rows.content_);
+	const unsigned int rows_before = rows_count - tail->attlist_.table_number_rows_repeated_;
+
+	if (rows_count < max_rows || rows_before >= tail->attlist_.table_number_rows_repeated_) return NULL;
+
+	return tail;
+}
+
+//xml первого повтора строки, разрезанный по номеру строки (r="5", r="A5", ...)
+class xlsx_row_template
+{
+public:
+	bool create(const std::wstring & xml, int row)
+	{
+		parts_.clear();
+		
+		const std::wstring row_str = std::to_wstring(row);
+		const std::wstring attr = L" r=\"";
+
+		size_t start = 0, pos = 0;
+		while ((pos = xml.find(attr, pos)) != std::wstring::npos)
+		{
+			pos += attr.size();
+			while (pos < xml.size() && xml[pos] >= L'A' && xml[pos] <= L'Z') pos++;
+
+			if (xml.compare(pos, row_str.size(), row_str) != 0) return false;
+			if (pos + row_str.size() >= xml.size() || xml[pos + row_str.size()] != L'"') return false;
+
+			parts_.push_back(xml.substr(start, pos - start));
+			pos += row_str.size();
+			start = pos;
+		}
+		parts_.push_back(xml.substr(start));
+
+		return parts_.size() > 1;
+	}
+	void write(std::wostream & strm, int row) const
+	{
+		const std::wstring row_str = std::to_wstring(row);
+		
+		strm << parts_[0];
+		for (size_t i = 1; i < parts_.size(); i++)
+		{
+			strm << row_str << parts_[i];
+		}
+	}
+private:
+	std::vector<std::wstring> parts_;
+};
+
+//пустые строки выше хвоста листа (get_sheet_tail_row) - со стилем по умолчанию вместо стиля колонок
+void write_blank_rows(std::wostream & strm, int row, unsigned int count)
+{
+	for (unsigned int i = 0; i < count; i++)
+	{
+		strm << L"<row r=\"" << (row + i) << L"\" customFormat=\"1\" s=\"0\"/>";
+	}
+}
+
+}
+
+void table_table_row::xlsx_convert(oox::xlsx_conversion_context & Context)
+{
+	const std::wstring rowStyleName = attlist_.table_style_name_.get_value_or(L"");
+
+    std::wstring ht		= L"";
+    double row_height	= 0.0;
+
+	bool bBreakAfter = false, bBreakBefore = false;
+
+	calc_row_properties(Context, rowStyleName, ht, row_height, bBreakBefore, bBreakAfter);
+
+	if (bSheetTail)
+	{//строки до конца листа записаны стилем колонок
+		Context.get_table_context().state()->add_empty_row(attlist_.table_number_rows_repeated_, bHeader);
+		Context.get_table_metrics().add_rows(attlist_.table_number_rows_repeated_, row_height);
+		return;
+	}
+	//строки за пределами листа xlsx не пишутся
+	const int max_rows = 0x100000;
+	const int row_first = Context.current_table_row() + 1;
+
+	const bool bSheetTailStyle = Context.get_table_context().state()->is_sheet_tail();
+
+    std::wostream & strm = Context.current_sheet().sheetData();
+
+	if (attlist_.table_number_rows_repeated_ > 1 && empty())
+	{
+		if (bSheetTailStyle && row_first < max_rows)
+		{
+			write_blank_rows(strm, row_first + 1, (std::min)(attlist_.table_number_rows_repeated_, (unsigned int)(max_rows - row_first)));
+		}
+		Context.get_table_context().state()->add_empty_row(attlist_.table_number_rows_repeated_, bHeader);
+		return;
+	}
+	if (row_first >= max_rows)
+	{
+		Context.get_table_context().state()->add_empty_row(attlist_.table_number_rows_repeated_, bHeader);
+		return;
+	}
+	const unsigned int rows_repeated = (std::min)(attlist_.table_number_rows_repeated_, (unsigned int)(max_rows - row_first));
+///обработка чтилей для роу -
+	size_t Default_Cell_style_in_row_ = 0; 
+
+    const std::wstring defaultCellStyleName = attlist_.table_default_cell_style_name_.get_value_or( L"");
+
+	style_instance * instStyle_CellDefault = 
+				Context.root()->odf_context().styleContainer().style_by_name(defaultCellStyleName, style_family::TableCell, false/*false*/);
+	
+	style_table_cell_properties * prop_CellDefault = NULL;
+	
+	if ((instStyle_CellDefault) && (instStyle_CellDefault->content())) 
+		prop_CellDefault = instStyle_CellDefault->content()->get_style_table_cell_properties();
+//кастомные настройки стиля ячеек в данном роу
+
+	if (prop_CellDefault) //проверим что есть вообще кастом для роу- а потом уже посчитаем стиль
+	{
+		odf_reader::style_table_cell_properties_attlist	cellFormatProperties = calc_table_cell_properties(instStyle_CellDefault);
+		Default_Cell_style_in_row_ = Context.get_style_manager().xfId(NULL,NULL, &cellFormatProperties, NULL, L"", 0, true);	
+	}
+	else //стиля ячеек для строки нет глянем что там внутри строки в последней ячейке
+	{
+		//возьмем стиль из последнего cell если он повторяющийся (тогда и ячейки вхолостую ненадо писать)
+		int ind_last_cell = content_.size()-1;
+		table_table_cell *last_cell = NULL;
+		if (ind_last_cell > 0)
+			last_cell = dynamic_cast<table_table_cell *>(content_[ind_last_cell].get());
+
+	}
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	bool skip_next_row = false;
+
 	int row_current = Context.current_table_row() + 1;
 
     bool hidden = attlist_.table_visibility_.get_type() == table_visibility::Collapse;
 	bool filter = attlist_.table_visibility_.get_type() == table_visibility::Filter;
 
-    for (unsigned int i = 0; i < attlist_.table_number_rows_repeated_; ++i)
+//повторы строки без значений пишутся копией первого, без повторного расчета стилей ячеек
+	const bool bTemplate = rows_repeated > 1 && Context.current_sheet().external_ref().empty() && is_template_row(content_);
+	
+	//строка, целиком заполненная одним стилем, - стиль строки вместо ячеек
+	table_table_cell *uniform_cell = Context.current_sheet().external_ref().empty() ? 
+				get_uniform_row_cell(content_, Context.get_table_context().columns_count()) : NULL;
+
+	xlsx_row_template row_template;
+	bool bTemplateReady = false;
+
+    for (unsigned int i = 0; i < rows_repeated; ++i)
     {
+		if (bTemplateReady || skip_next_row)
+		{//остальные повторы - одним шагом
+			const unsigned int count = rows_repeated - i;
+			const int row = Context.current_table_row() + 1;
+
+			if (bTemplateReady)
+			{
+				for (unsigned int j = 0; j < count; j++)
+				{
+					row_template.write(strm, row + j + 1);
+				}
+			}
+			else if (bSheetTailStyle)
+			{
+				write_blank_rows(strm, row + 1, count);
+			}
+			Context.get_table_context().state()->add_repeated_rows(count, bHeader, bBreakBefore, bBreakAfter);
+			break;
+		}
         Context.get_table_context().state()->start_row(rowStyleName, defaultCellStyleName, bHeader);
 		
 		if (bBreakBefore)	Context.get_table_context().state()->set_row_break_before();
 		if (bBreakAfter)	Context.get_table_context().state()->set_row_break_after();
 
-        if (!skip_next_row)
+		if (bTemplate) Context.current_sheet().start_sheetData_capture();
+
+        CP_XML_WRITER(strm)
         {
-           CP_XML_WRITER(strm)
+            CP_XML_NODE(L"row")
             {
-                CP_XML_NODE(L"row")
-                {
-                    CP_XML_ATTR(L"r", Context.current_table_row() + 1);
+                CP_XML_ATTR(L"r", Context.current_table_row() + 1);
 
-					if (false == Context.get_table_context().state()->group_rows_.empty())
-					{
-						//std::wstring str_spans = std::to_wstring(Context.get_table_context().state()->group_row_.count);
-						//str_spans = str_spans + L":";
-						int columns = Context.get_table_context().columns_count();
-						if (columns > 0x4000) columns = 0x4000;
-						std::wstring str_spans = L"1:" + std::to_wstring(columns);
-						ht = L"";
-
-						CP_XML_ATTR(L"collapsed", Context.get_table_context().state()->group_rows_.back());
-						CP_XML_ATTR(L"outlineLevel", Context.get_table_context().state()->group_rows_.size());
-						CP_XML_ATTR(L"spans", str_spans);						
-						
-						if (Context.get_table_context().state()->group_rows_.back()) hidden = false;
-					}					
+				if (false == Context.get_table_context().state()->group_rows_.empty())
+				{
+					//std::wstring str_spans = std::to_wstring(Context.get_table_context().state()->group_row_.count);
+					//str_spans = str_spans + L":";
+					int columns = Context.get_table_context().columns_count();
+					if (columns > 0x4000) columns = 0x4000;
+					std::wstring str_spans = L"1:" + std::to_wstring(columns);
+					ht = L"";
+
+					CP_XML_ATTR(L"collapsed", Context.get_table_context().state()->group_rows_.back());
+					CP_XML_ATTR(L"outlineLevel", Context.get_table_context().state()->group_rows_.size());
+					CP_XML_ATTR(L"spans", str_spans);						
+					
+					if (Context.get_table_context().state()->group_rows_.back()) hidden = false;
+				}					
 
-                    if (hidden || filter)
-                    {
-                        CP_XML_ATTR(L"hidden", 1);                        
-                    }
+                if (hidden || filter)
+                {
+                    CP_XML_ATTR(L"hidden", 1);                        
+                }
 
-                    if (!ht.empty())
-                    {
-                        CP_XML_ATTR(L"ht", ht);                                            
-                        CP_XML_ATTR(L"customHeight", 1);
-                    }
-					if (Default_Cell_style_in_row_ > 0)
-					{
-						CP_XML_ATTR(L"customFormat", 1);
-						CP_XML_ATTR(L"s", Default_Cell_style_in_row_ );
-					}
+                if (!ht.empty())
+                {
+                    CP_XML_ATTR(L"ht", ht);                                            
+                    CP_XML_ATTR(L"customHeight", 1);
+                }
+				if (uniform_cell)
+				{
+					CP_XML_ATTR(L"customFormat", 1);
+					CP_XML_ATTR(L"s", uniform_cell->xlsx_empty_style(Context));
+				}
+				else if (Default_Cell_style_in_row_ > 0)
+				{
+					CP_XML_ATTR(L"customFormat", 1);
+					CP_XML_ATTR(L"s", Default_Cell_style_in_row_ );
+				}
+				else if (bSheetTailStyle)
+				{//иначе на пустые ячейки строки распространится стиль колонок
+					CP_XML_ATTR(L"customFormat", 1);
+					CP_XML_ATTR(L"s", 0);
+				}
 
 
-                    CP_XML_STREAM();
+                CP_XML_STREAM();
 
-					for (size_t i = 0 ; i < content_.size(); i++)
-                    {
-						office_element_ptr & elm = content_[i];
+				for (size_t i = 0 ; !uniform_cell && i < content_.size(); i++)
+                {
+					office_element_ptr & elm = content_[i];
 
-						if (i  == content_.size() - 1) //mark last cell in row (for skip empty styled)
-						{
-							table_table_cell			*cell			= dynamic_cast<table_table_cell*>		(elm.get());
-							table_covered_table_cell	*covered_cell	= dynamic_cast<table_covered_table_cell*>(elm.get());
-							
-							if (cell)				cell->last_cell_			= true;
-							else if (covered_cell)	covered_cell->last_cell_	= true;
-						}
-						elm->xlsx_convert(Context);
-                    }              
+					if (i  == content_.size() - 1) //mark last cell in row (for skip empty styled)
+					{
+						table_table_cell			*cell			= dynamic_cast<table_table_cell*>		(elm.get());
+						table_covered_table_cell	*covered_cell	= dynamic_cast<table_covered_table_cell*>(elm.get());
+						
+						if (cell)				cell->last_cell_			= true;
+						else if (covered_cell)	covered_cell->last_cell_	= true;
+					}
+					elm->xlsx_convert(Context);
+                }              
 
-                }
             }
         }
+		if (uniform_cell)
+		{
+			Context.get_table_context().state()->non_empty_row();
+		}
+		if (bTemplate)
+		{
+			bTemplateReady = row_template.create(Context.current_sheet().end_sheetData_capture(), Context.current_table_row() + 1);
+		}
         Context.get_table_context().state()->end_row();        
 
 		if (Context.get_table_context().state()->is_empty_row() && Context.get_table_context().state()->group_rows_.empty())
 		{
             skip_next_row = true;  
-			if (attlist_.table_number_rows_repeated_ > 0xf000)
-				break;//Уведомление_о_вручении.ods (1 лист)
-		}
-		if (content_.size() > 0 && attlist_.table_number_rows_repeated_ > 1000)
-		{
-			table_table_cell * table_cell = dynamic_cast<table_table_cell *>(content_[0].get());
-			if ((table_cell) && (table_cell->attlist_.table_number_columns_repeated_ > 1000))
-			{
-				break;//Уведомление_о_вручении.ods  (2 лист)
-			}
 		}
     }
+	if (rows_repeated < attlist_.table_number_rows_repeated_)
+	{
+		Context.get_table_context().state()->add_empty_row(attlist_.table_number_rows_repeated_ - rows_repeated, bHeader);
+	}
 
     Context.get_table_metrics().add_rows(attlist_.table_number_rows_repeated_, !hidden ? row_height : 0.0);
 
@@ -397,8 +647,6 @@ void table_table::xlsx_convert(oox::xlsx_conversion_context & Context)
 	{
 		Context.get_table_context().set_print_area(*attlist_.table_print_ranges_);
 	}
-	table_columns_and_groups_.xlsx_convert(Context);
-
 // check last rows for equal style and empties - collapsed
 
 //<table:table-row table:style-name="ro3" table:number-rows-repeated="65353">
@@ -418,6 +666,28 @@ void table_table::xlsx_convert(oox::xlsx_conversion_context & Context)
 		rows->table_rows_1_.remove_equals_empty();
 		rows->table_rows_2_.remove_equals_empty();
 	}
+//форматированный блок до конца листа - стилем колонок, в xlsx нет повтора строк
+	if (Context.current_sheet().external_ref().empty())
+	{
+		table_table_row *tail = get_sheet_tail_row(table_rows_and_groups_, count_columns(table_columns_and_groups_.content_));
+		
+		std::wstring ht;
+		double row_height = 0.0;
+		bool bBreakBefore = false, bBreakAfter = false;
+
+		if (tail)
+		{
+			calc_row_properties(Context, tail->attlist_.table_style_name_.get_value_or(L""), ht, row_height, bBreakBefore, bBreakAfter);
+		}
+		if (tail && !bBreakBefore && !bBreakAfter)
+		{
+			table_table_cell *cell = dynamic_cast<table_table_cell*>(tail->content_[0].get());
+			
+			tail->bSheetTail = true;
+			Context.get_table_context().state()->set_sheet_tail(cell->xlsx_empty_style(Context), ht);
+		}
+	}
+	table_columns_and_groups_.xlsx_convert(Context);
 
     table_rows_and_groups_.xlsx_convert(Context);
 
@@ -537,6 +807,11 @@ void table_table_column::xlsx_convert(oox::xlsx_conversion_context & Context)
 			CP_XML_ATTR(L"max", cMax);
 			CP_XML_ATTR(L"min", (cMin + 1));
 
+			if (Context.get_table_context().state()->is_sheet_tail())
+			{
+				CP_XML_ATTR(L"style", Context.get_table_context().state()->sheet_tail_style());
+			}
+
             if (attlist_.table_style_name_)
             {
 
@@ -713,43 +988,67 @@ std::wstring CalcCellDataStyle(oox::xlsx_conversion_context & Context,
     return data_style;
 }
 
+std::wstring CalcCellNumFormat(oox::xlsx_conversion_context & Context, std::wstring const & data_style, office_value_type::type & num_format_type)
+{
+	std::wstring num_format;
+	
+	if (data_style.empty()) return num_format;
+
+	num_format = Context.get_num_format_context().find_complex_format(data_style, num_format_type);
+
+	if (num_format.empty())
+	{
+		office_element_ptr elm = Context.root()->odf_context().numberStyles().find_by_style_name(data_style);
+		number_style_base *num_style = dynamic_cast<number_style_base*>(elm.get());
+
+		if (num_style)
+		{
+			Context.get_num_format_context().start_complex_format(data_style);
+			num_style->oox_convert(Context.get_num_format_context());
+			Context.get_num_format_context().end_complex_format();
+
+			num_format = Context.get_num_format_context().get_last_format();
+			num_format_type = Context.get_num_format_context().type();
+		}
+	}
+	return num_format;
 }
 
-void table_table_cell::xlsx_convert(oox::xlsx_conversion_context & Context)
+//стиль ячейки по стилям по умолчанию, колонки, строки и самой ячейки (стили не наследуются - берется последний заданный)
+struct cell_style_calc
 {
-	bool bExternalTable = !Context.current_sheet().external_ref().empty();
-	
-	std::wostream & strm = Context.current_sheet().sheetData();
-    
-	const common_value_and_type_attlist & attr	= attlist_.common_value_and_type_attlist_;
-	std::wstring formula = attlist_.table_formula_.get_value_or(L"");
-   
-// вычислить стиль для ячейки
+	style_instance *defaultCellStyle		= NULL;
+	style_instance *defaultColumnCellStyle	= NULL;
+	style_instance *defaultRowCellStyle		= NULL;
+	style_instance *cellStyle				= NULL;
 
-    std::wstring cellStyleName		= attlist_.table_style_name_.get_value_or(L"");
-	std::wstring columnStyleName	= Context.get_table_context().default_column_cell_style();
-	std::wstring rowStyleName		= Context.get_table_context().default_row_cell_style();
+	text_format_properties_ptr			textFormatProperties;
+	paragraph_format_properties			parFormatProperties;
+	style_table_cell_properties_attlist	cellFormatProperties;
 
-	if (attlist_.table_number_columns_repeated_ > 1)
-		columnStyleName.clear(); // могут быть разные стили колонок Book 24.ods
+	std::wstring						num_format;
+	office_value_type::type				num_format_type = office_value_type::Custom;
+};
 
+void CalcCellStyle(oox::xlsx_conversion_context & Context, std::wstring const & columnStyleName, std::wstring const & rowStyleName, 
+					std::wstring const & cellStyleName, bool bHyperlink, cell_style_calc & calc)
+{
 	odf_read_context & odfContext = Context.root()->odf_context();   
 
-	style_instance *defaultCellStyle = NULL, *defaultColumnCellStyle = NULL,  *defaultRowCellStyle = NULL, *cellStyle = NULL;
 	try
 	{
-		if (is_present_hyperlink_)
+		if (bHyperlink)
 		{
-			defaultCellStyle	= odfContext.styleContainer().style_by_name(L"Hyperlink", style_family::TableCell, true);
+			calc.defaultCellStyle	= odfContext.styleContainer().style_by_name(L"Hyperlink", style_family::TableCell, true);
 		}
-		if (!defaultCellStyle)
+		if (!calc.defaultCellStyle)
 		{
-			defaultCellStyle	= odfContext.styleContainer().style_default_by_type(style_family::TableCell); 
+			calc.defaultCellStyle	= odfContext.styleContainer().style_default_by_type(style_family::TableCell); 
 		}
 
-		defaultColumnCellStyle	= odfContext.styleContainer().style_by_name(columnStyleName,	style_family::TableCell, false);
-		defaultRowCellStyle		= odfContext.styleContainer().style_by_name(rowStyleName,		style_family::TableCell, false);        
-		cellStyle				= odfContext.styleContainer().style_by_name(cellStyleName,		style_family::TableCell, false);
+		calc.defaultColumnCellStyle	= odfContext.styleContainer().style_by_name(columnStyleName,	style_family::TableCell, false);
+		calc.defaultRowCellStyle	= odfContext.styleContainer().style_by_name(rowStyleName,		style_family::TableCell, false);        
+		calc.cellStyle				= odfContext.styleContainer().style_by_name(cellStyleName,		style_family::TableCell, false);
 	}
 	catch(...)
 	{
@@ -760,54 +1059,80 @@ void table_table_cell::xlsx_convert(oox::xlsx_conversion_context & Context)
 
     // стили не наследуются
     std::vector<const style_instance *> instances;
-    instances.push_back(defaultCellStyle);
+    instances.push_back(calc.defaultCellStyle);
 
-    if (defaultColumnCellStyle)
-        instances.push_back(defaultColumnCellStyle);
+    if (calc.defaultColumnCellStyle)
+        instances.push_back(calc.defaultColumnCellStyle);
 
-    if (defaultRowCellStyle)
+    if (calc.defaultRowCellStyle)
     {
         if (instances.size() > 1)
-            instances[1] = defaultRowCellStyle;
+            instances[1] = calc.defaultRowCellStyle;
         else
-            instances.push_back(defaultRowCellStyle);
+            instances.push_back(calc.defaultRowCellStyle);
     }
 
-    if (cellStyle)
+    if (calc.cellStyle)
     {
         if (instances.size() > 1)
-            instances[1] = cellStyle;
+            instances[1] = calc.cellStyle;
         else
-            instances.push_back(cellStyle);
+            instances.push_back(calc.cellStyle);
     }
 
-    text_format_properties_ptr textFormatProperties	= calc_text_properties_content (instances);          
-	paragraph_format_properties parFormatProperties = calc_paragraph_properties_content (instances);
-    style_table_cell_properties_attlist cellFormatProperties = calc_table_cell_properties (instances);
-//-------------------------------------------------------------------------------------------------------------------------------
-	std::wstring			num_format;
-	office_value_type::type num_format_type = office_value_type::Custom;
+    calc.textFormatProperties	= calc_text_properties_content (instances);          
+	calc.parFormatProperties	= calc_paragraph_properties_content (instances);
+    calc.cellFormatProperties	= calc_table_cell_properties (instances);
 
-	if (false == data_style.empty())
-    {
-		num_format = Context.get_num_format_context().find_complex_format(data_style, num_format_type);
+	calc.num_format = CalcCellNumFormat(Context, data_style, calc.num_format_type);
+}
 
-		if (num_format.empty())
-		{
-			office_element_ptr elm = odfContext.numberStyles().find_by_style_name(data_style);
-			number_style_base *num_style = dynamic_cast<number_style_base*>(elm.get());
+}
 
-			if (num_style)
-			{
-				Context.get_num_format_context().start_complex_format(data_style);
-				num_style->oox_convert(Context.get_num_format_context());
-				Context.get_num_format_context().end_complex_format();
+size_t table_table_cell::xlsx_empty_style(oox::xlsx_conversion_context & Context)
+{//стиль пустой ячейки (без значения), повторенной на несколько колонок - как в xlsx_convert
+	cell_style_calc calc;
+	CalcCellStyle(Context, L"", Context.get_table_context().default_row_cell_style(), attlist_.table_style_name_.get_value_or(L""), false, calc);
 
-				num_format = Context.get_num_format_context().get_last_format();
-				num_format_type = Context.get_num_format_context().type();
-			}
-		}
-    }
+	oox::xlsx_cell_format cellFormat;    
+	cellFormat.set_cell_type(oox::XlsxCellType::s);
+    cellFormat.set_num_format(oox::odf_string_to_build_in(office_value_type::Custom));    
+
+	bool is_style_visible = true;
+	return Context.get_style_manager().xfId(calc.textFormatProperties, &calc.parFormatProperties, &calc.cellFormatProperties, 
+		&cellFormat, calc.num_format, calc.num_format_type, false, is_style_visible);
+}
+
+void table_table_cell::xlsx_convert(oox::xlsx_conversion_context & Context)
+{
+	bool bExternalTable = !Context.current_sheet().external_ref().empty();
+	
+	std::wostream & strm = Context.current_sheet().sheetData();
+    
+	const common_value_and_type_attlist & attr	= attlist_.common_value_and_type_attlist_;
+	std::wstring formula = attlist_.table_formula_.get_value_or(L"");
+   
+// вычислить стиль для ячейки
+
+    std::wstring cellStyleName		= attlist_.table_style_name_.get_value_or(L"");
+	std::wstring columnStyleName	= Context.get_table_context().default_column_cell_style();
+	std::wstring rowStyleName		= Context.get_table_context().default_row_cell_style();
+
+	if (attlist_.table_number_columns_repeated_ > 1)
+		columnStyleName.clear(); // могут быть разные стили колонок Book 24.ods
+
+	cell_style_calc calc;
+	CalcCellStyle(Context, columnStyleName, rowStyleName, cellStyleName, is_present_hyperlink_, calc);
+
+	style_instance *defaultColumnCellStyle	= calc.defaultColumnCellStyle;
+	style_instance *cellStyle				= calc.cellStyle;
+
+    text_format_properties_ptr			textFormatProperties	= calc.textFormatProperties;          
+	paragraph_format_properties			parFormatProperties		= calc.parFormatProperties;
+    style_table_cell_properties_attlist	cellFormatProperties	= calc.cellFormatProperties;
+//-------------------------------------------------------------------------------------------------------------------------------
+	office_value_type::type num_format_type = calc.num_format_type;
+	std::wstring			num_format		= calc.num_format;
 //------------------------------------------------------------------------
 	std::wstring			number_val;
     _CP_OPT(bool)			bool_val;
@@ -0,0 +1,97 @@
+///*
+// * (c) Copyright UNIVAULT TECHNOLOGIES 2026-2026
+// *
+// * This program is a free software product. You can redistribute it and/or
+// * modify it under the terms of the GNU Affero General Public License (AGPL)
+// * version 3 as published by the Free Software Foundation. In accordance with
+// * Section 7(a) of the GNU AGPL its Section 15 shall be amended to the effect
+// * that UNIVAULT TECHNOLOGIES expressly excludes the warranty of non-infringement
+// * of any third-party rights.
+// *
+// * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+// * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR  PURPOSE. For
+// * details, see the GNU AGPL at: http://www.gnu.org/licenses/agpl-3.0.html
+// *
+// * You can contact UNIVAULT TECHNOLOGIES at 20A-6 Ernesta Birznieka-Upish
+// * street, Moscow (TEST), Russia (TEST), EU, 000000 (TEST).
+// *
+// * The  interactive user interfaces in modified source and object code versions
+// * of the Program must display Appropriate Legal Notices, as required under
+// * Section 5 of the GNU AGPL version 3.
+// *
+// * Pursuant to Section 7(b) of the License you must retain the original Product
+// * logo when distributing the program. Pursuant to Section 7(e) we decline to
+// * grant you any rights under trademark law for use of our trademarks.
+// *
+// * All the Product's GUI elements, including illustrations and icon sets, as
+// * well as technical writing content are licensed under the terms of the
+// * Creative Commons Attribution-ShareAlike 4.0 International. See the License
+// * terms at http://creativecommons.org/licenses/by-sa/4.0/legalcode
+// *
+// */
+
+#include "gtest/gtest.h"
+
+#include "../../Formulas/formulasconvert.h"
+
+#include <vector>
+
+using namespace cpdoccore;
+
+// Формулы, скопированные по строкам, конвертируются через кэш шаблонов;
+// результат и имя таблицы должны совпадать с конвертацией новым экземпляром (без кэша).
+
+TEST(FormulasCacheTest, odf2oox_same_with_and_without_cache)
+{
+	std::vector<std::wstring> formulas;
+	for (int i = 1; i < 50; i++)
+	{
+		std::wstring row = std::to_wstring(i);
+		formulas.push_back(L"of:=[.A" + row + L"]+[.B" + row + L"]");
+		formulas.push_back(L"of:=SUM([.A" + row + L":.C" + row + L"])*2");
+		formulas.push_back(L"of:=[Sheet2.B" + row + L"]&\"x1\"");
+		formulas.push_back(L"of:=['Sheet 3'.$C$" + row + L"]/[.D" + std::to_wstring(i + 1) + L"]");
+		formulas.push_back(L"of:=IF([.A" + row + L"]>10;\"A10\";[.A" + row + L"])");
+		formulas.push_back(L"of:=1+2");
+	}
+	formulasconvert::odf2oox_converter cached;
+	for (size_t i = 0; i < formulas.size(); i++)
+	{
+		std::wstring result = cached.convert(formulas[i]);
+		std::wstring table_name = cached.get_table_name();
+
+		formulasconvert::odf2oox_converter direct;
+		EXPECT_EQ(direct.convert(formulas[i]), result) << i;
+		EXPECT_EQ(direct.get_table_name(), table_name) << i;
+	}
+}
+
+TEST(FormulasCacheTest, oox2odf_same_with_and_without_cache)
+{
+	std::vector<std::wstring> formulas;
+	for (int i = 1; i < 50; i++)
+	{
+		std::wstring row = std::to_wstring(i);
+		formulas.push_back(L"A" + row + L"+B" + row);
+		formulas.push_back(L"SUM(A" + row + L":C" + row + L")*2");
+		formulas.push_back(L"Sheet2!B" + row + L"&\"x1\"");
+		formulas.push_back(L"'Sheet 3'!$C$" + row + L"/D" + std::to_wstring(i + 1));
+		formulas.push_back(L"IF(A" + row + L">10,\"A10\",A" + row + L")");
+	}
+	const std::wstring tables[] = { L"", L"Sheet1" };
+
+	formulasconvert::oox2odf_converter cached;
+	for (size_t t = 0; t < 2; t++)
+	{
+		for (size_t i = 0; i < formulas.size(); i++)
+		{
+			cached.set_table_name(tables[t]);
+			std::wstring result = cached.convert_formula(formulas[i]);
+
+			formulasconvert::oox2odf_converter direct;
+			direct.set_table_name(tables[t]);
+			EXPECT_EQ(direct.convert_formula(formulas[i]), result) << i;
+			EXPECT_EQ(direct.get_table_name(), cached.get_table_name()) << i;
+		}
+	}
+}
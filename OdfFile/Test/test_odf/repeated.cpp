@@ -0,0 +1,135 @@
+///*
+// * (c) Copyright UNIVAULT TECHNOLOGIES 2026-2026
+// *
+// * This program is a free software product. You can redistribute it and/or
+// * modify it under the terms of the GNU Affero General Public License (AGPL)
+// * version 3 as published by the Free Software Foundation. In accordance with
+// * Section 7(a) of the GNU AGPL its Section 15 shall be amended to the effect
+// * that UNIVAULT TECHNOLOGIES expressly excludes the warranty of non-infringement
+// * of any third-party rights.
+// *
+// * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+// * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR  PURPOSE. For
+// * details, see the GNU AGPL at: http://www.gnu.org/licenses/agpl-3.0.html
+// *
+// * You can contact UNIVAULT TECHNOLOGIES at 20A-6 Ernesta Birznieka-Upish
+// * street, Moscow (TEST), Russia (TEST), EU, 000000 (TEST).
+// *
+// * The  interactive user interfaces in modified source and object code versions
+// * of the Program must display Appropriate Legal Notices, as required under
+// * Section 5 of the GNU AGPL version 3.
+// *
+// * Pursuant to Section 7(b) of the License you must retain the original Product
+// * logo when distributing the program. Pursuant to Section 7(e) we decline to
+// * grant you any rights under trademark law for use of our trademarks.
+// *
+// * All the Product's GUI elements, including illustrations and icon sets, as
+// * well as technical writing content are licensed under the terms of the
+// * Creative Commons Attribution-ShareAlike 4.0 International. See the License
+// * terms at http://creativecommons.org/licenses/by-sa/4.0/legalcode
+// *
+// */
+
+#include "gtest/gtest.h"
+
+#include "../../Reader/Converter/ConvertOO2OOX.h"
+#include "../../../DesktopEditor/common/File.h"
+#include "../../../DesktopEditor/common/Directory.h"
+
+// Лист с одной строкой данных и форматированным блоком до конца листа (1024 столбца).
+// Блок пишется стилем колонок, поэтому размер листа не зависит от числа повторов:
+// сравнивается с тем же листом без блока и с блоком, длиннее листа xlsx.
+
+namespace
+{
+	std::wstring repeated_content(unsigned int rows_repeated)
+	{
+		std::wstring content =
+			L"<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+			L"<office:document-content"
+			L" xmlns:office=\"urn:oasis:names:tc:opendocument:xmlns:office:1.0\""
+			L" xmlns:style=\"urn:oasis:names:tc:opendocument:xmlns:style:1.0\""
+			L" xmlns:text=\"urn:oasis:names:tc:opendocument:xmlns:text:1.0\""
+			L" xmlns:table=\"urn:oasis:names:tc:opendocument:xmlns:table:1.0\""
+			L" xmlns:fo=\"urn:oasis:names:tc:opendocument:xmlns:xsl-fo-compatible:1.0\""
+			L" office:version=\"1.2\">"
+			L"<office:automatic-styles>"
+			L"<style:style style:name=\"ce1\" style:family=\"table-cell\">"
+			L"<style:table-cell-properties fo:background-color=\"#ffff00\"/>"
+			L"</style:style>"
+			L"</office:automatic-styles>"
+			L"<office:body><office:spreadsheet>"
+			L"<table:table table:name=\"Sheet1\">"
+			L"<table:table-column table:number-columns-repeated=\"1024\"/>"
+			L"<table:table-row><table:table-cell office:value-type=\"float\" office:value=\"1\"><text:p>1</text:p></table:table-cell></table:table-row>";
+		if (rows_repeated > 0)
+		{
+			content += L"<table:table-row table:number-rows-repeated=\"" + std::to_wstring(rows_repeated) + L"\">"
+				L"<table:table-cell table:style-name=\"ce1\" table:number-columns-repeated=\"1024\"/>"
+				L"</table:table-row>";
+		}
+		content +=
+			L"</table:table>"
+			L"</office:spreadsheet></office:body>"
+			L"</office:document-content>";
+		return content;
+	}
+
+	const wchar_t * repeated_manifest =
+		L"<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+		L"<manifest:manifest xmlns:manifest=\"urn:oasis:names:tc:opendocument:xmlns:manifest:1.0\" manifest:version=\"1.2\">"
+		L"<manifest:file-entry manifest:full-path=\"/\" manifest:media-type=\"application/vnd.oasis.opendocument.spreadsheet\"/>"
+		L"<manifest:file-entry manifest:full-path=\"content.xml\" manifest:media-type=\"text/xml\"/>"
+		L"</manifest:manifest>";
+
+	std::wstring convert_repeated(unsigned int rows_repeated)
+	{
+		std::wstring sTemp	= NSDirectory::CreateDirectoryWithUniqueName(NSDirectory::GetTempPath());
+		std::wstring sSrc	= sTemp + FILE_SEPARATOR_STR + L"src";
+		std::wstring sDst	= sTemp + FILE_SEPARATOR_STR + L"dst";
+
+		NSDirectory::CreateDirectory(sSrc);
+		NSDirectory::CreateDirectory(sSrc + FILE_SEPARATOR_STR + L"META-INF");
+		NSDirectory::CreateDirectory(sDst);
+
+		NSFile::CFileBinary::SaveToFile(sSrc + FILE_SEPARATOR_STR + L"mimetype", L"application/vnd.oasis.opendocument.spreadsheet");
+		NSFile::CFileBinary::SaveToFile(sSrc + FILE_SEPARATOR_STR + L"content.xml", repeated_content(rows_repeated));
+		NSFile::CFileBinary::SaveToFile(sSrc + FILE_SEPARATOR_STR + L"META-INF" + FILE_SEPARATOR_STR + L"manifest.xml", repeated_manifest);
+
+		EXPECT_EQ(ConvertODF2OOXml(sSrc, sDst, L"", sTemp, L""), 0);
+
+		std::wstring sheet;
+		EXPECT_TRUE(NSFile::CFileBinary::ReadAllTextUtf8(sDst + FILE_SEPARATOR_STR + L"xl" + FILE_SEPARATOR_STR + L"worksheets" + FILE_SEPARATOR_STR + L"sheet1.xml", sheet));
+
+		NSDirectory::DeleteDirectory(sTemp);
+		return sheet;
+	}
+
+	size_t count_rows(const std::wstring & sheet)
+	{
+		size_t count = 0;
+		for (size_t pos = sheet.find(L"<row "); pos != std::wstring::npos; pos = sheet.find(L"<row ", pos + 1))
+			count++;
+		return count;
+	}
+}
+
+TEST(RepeatedRowsTest, ods2xlsx_formatted_sheet_run)
+{
+	std::wstring sheet_none	= convert_repeated(0);
+	std::wstring sheet_full	= convert_repeated(1048575);
+	std::wstring sheet_over	= convert_repeated(10000000);
+
+	// строки блока не пишутся - только строка с данными
+	EXPECT_EQ(count_rows(sheet_none), 1u);
+	EXPECT_EQ(count_rows(sheet_full), 1u);
+	EXPECT_EQ(count_rows(sheet_over), 1u);
+
+	EXPECT_EQ(sheet_full.size(), sheet_over.size());
+	EXPECT_LT(sheet_full.size(), sheet_none.size() + 1024);
+
+	// стиль блока - у колонок, строка с данными его не получает
+	EXPECT_NE(sheet_full.find(L"style=\""), std::wstring::npos);
+	EXPECT_EQ(sheet_none.find(L"style=\""), std::wstring::npos);
+	EXPECT_NE(sheet_full.find(L"<row r=\"1\" customFormat=\"1\" s=\"0\""), std::wstring::npos);
+}
@@ -31,7 +31,9 @@ HEADERS += \
 
 SOURCES += \
     test.cpp\
-    common.cpp
+    common.cpp\
+    formulas.cpp\
+    repeated.cpp
 #    entrance.cpp\
 #    motion.cpp\
 #    audio.cpp\
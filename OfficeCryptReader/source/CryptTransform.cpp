@@ -57,6 +57,10 @@
 #include "../../OOXML/Base/Base.h"
 
 #include "../../DesktopEditor/common/File.h"
+#include "../../DesktopEditor/graphics/BaseThread.h"
+
+#include <thread>
+
 static const unsigned char encrVerifierHashInputBlockKey[8]			= { 0xfe, 0xa7, 0xd2, 0x76, 0x3b, 0x4b, 0x9e, 0x79 };
 static const unsigned char encrVerifierHashValueBlockKey[8]			= { 0xd7, 0xaa, 0x0f, 0x6d, 0x30, 0x61, 0x34, 0x4e };
 static const unsigned char encrKeyValueBlockKey[8]					= { 0x14, 0x6e, 0x0b, 0xe7, 0xab, 0xac, 0xd0, 0xd6 };
@@ -559,8 +563,170 @@ bool DecryptCipher(_buf & key, _buf & iv, _buf & data_inp, _buf & data_out,  CRY
 	return true;
 }
 //------------------------------------------------------------------------------------------------------------------------------------
+#define SEGMENT_SIZE		4096
+#define MAX_STREAM_THREADS	16
+
+MessageAuthenticationCode* CreateHmac(_buf & key, CRYPT_METHOD::_hashAlgorithm algorithm)
+{
+	switch(algorithm)
+	{
+	case CRYPT_METHOD::SHA1:	return new HMAC<SHA1>(key.ptr, key.size);
+	case CRYPT_METHOD::SHA256:	return new HMAC<SHA256>(key.ptr, key.size);
+	case CRYPT_METHOD::SHA512:	return new HMAC<SHA512>(key.ptr, key.size);
+	default:
+		return NULL;
+	}
+}
+//agile segments - each 4096 bytes with own iv, independent of each other
+struct _segmentsJob
+{
+	bool							bEncrypt	= false;
+	_buf							*key		= NULL;
+	_buf							*dataSalt	= NULL;
+	CRYPT_METHOD::_hashAlgorithm	hashAlgorithm;
+	CRYPT_METHOD::_cipherAlgorithm	cipherAlgorithm;
+	int								blockSize	= 0;
+
+	unsigned char					*data_inp	= NULL;
+	unsigned char					*data_out	= NULL;
+	int								size		= 0;
+	int								size_out	= 0;
+	int								block		= 0;
+
+	void Run()
+	{
+		_buf iv;
+		int i = block, sz = SEGMENT_SIZE, pos = 0;
+
+		while (pos < size)
+		{
+			if (pos + sz > size)
+				sz = size - pos;
+
+			_buf pIndex((unsigned char*)&i, 4);
+			iv = HashAppend(*dataSalt, pIndex, hashAlgorithm);
+
+			CorrectHashSize(iv, blockSize, 0x36);
+
+			if (!bEncrypt)
+			{
+				_buf pInp(data_inp + pos, sz, false);
+				_buf pOut(data_out + pos, sz, false);
+
+				DecryptCipher(*key, iv, pInp, pOut, cipherAlgorithm);
+			}
+			else if (sz < SEGMENT_SIZE)
+			{
+				_buf pInp(SEGMENT_SIZE);
+					memcpy(pInp.ptr, data_inp + pos, sz);
+					pInp.size = sz;
+				_buf pOut(SEGMENT_SIZE);
+
+				EncryptCipher(*key, iv, pInp, pOut, cipherAlgorithm);
+
+				if (sz % PADDING_SIZE != 0)
+					sz = (sz / PADDING_SIZE + 1) * PADDING_SIZE;
+
+				memcpy(data_out + pos, pOut.ptr, sz);
+			}
+			else
+			{
+				_buf pInp(data_inp + pos, sz, false);
+				_buf pOut(data_out + pos, sz, false);
+
+				EncryptCipher(*key, iv, pInp, pOut, cipherAlgorithm);
+			}
+			pos += sz; i++;
+		}
+		size_out = pos;
+	}
+};
+class CSegmentsThread : public NSThreads::CBaseThread
+{
+public:
+	CSegmentsThread(_segmentsJob & job) : m_job(job) {}
+	virtual ~CSegmentsThread() {}
+
+protected:
+	virtual DWORD ThreadProc()
+	{
+		m_job.Run();
+		return 0;
+	}
+private:
+	_segmentsJob & m_job;
+};
+//------------------------------------------------------------------------------------------------------------------------------------
 namespace CRYPT
 {
+struct _ecmaStreamData
+{
+	_buf			key;		// agile - decrypted secret key, standart - hash key
+	_buf			dataSalt;
+	_buf			hmacKey;
+	int				block	= 0;
+	int				threads	= 1;
+
+	boost::shared_ptr<MessageAuthenticationCode> hmac;
+
+	_ecmaStreamData()
+	{
+		threads = (int)std::thread::hardware_concurrency();
+		if (threads < 1)					threads = 1;
+		if (threads > MAX_STREAM_THREADS)	threads = MAX_STREAM_THREADS;
+	}
+	void UpdateHmac(unsigned char* data, int size)
+	{
+		if (hmac && data && size > 0)
+			hmac->Update(data, size);
+	}
+	int ProcessSegments(_segmentsJob & sample, bool bHmacInput)
+	{
+		//rc4 - one key stream through all segments, sequential only
+		int count = (sample.size + SEGMENT_SIZE - 1) / SEGMENT_SIZE;
+		int jobs_count = (sample.cipherAlgorithm == CRYPT_METHOD::RC4) ? 1 : (std::min)(threads, count);
+
+		if (jobs_count < 2)
+		{
+			if (bHmacInput) UpdateHmac(sample.data_inp, sample.size);
+			sample.Run();
+			block += count;
+			return sample.size_out;
+		}
+
+		std::vector<_segmentsJob> jobs(jobs_count, sample);
+		std::vector<CSegmentsThread*> workers;
+
+		int per_job = count / jobs_count, rest = count % jobs_count, segment = 0;
+		for (int i = 0; i < jobs_count; i++)
+		{
+			int segments = per_job + (i < rest ? 1 : 0);
+			int pos = segment * SEGMENT_SIZE;
+
+			jobs[i].data_inp	= sample.data_inp + pos;
+			jobs[i].data_out	= sample.data_out + pos;
+			jobs[i].size		= (std::min)(segments * SEGMENT_SIZE, sample.size - pos);
+			jobs[i].block		= sample.block + segment;
+
+			segment += segments;
+
+			workers.push_back(new CSegmentsThread(jobs[i]));
+			workers.back()->Start(0);
+		}
+		if (bHmacInput) UpdateHmac(sample.data_inp, sample.size);
+
+		int size_out = 0;
+		for (size_t i = 0; i < workers.size(); i++)
+		{
+			workers[i]->Stop();
+			delete workers[i];
+
+			size_out += jobs[i].size_out;
+		}
+		block += count;
+		return size_out;
+	}
+};
 //-----------------------------------------------------------------------------------------------------------
 ECMADecryptor::ECMADecryptor()
 {
@@ -826,6 +992,121 @@ void ECMADecryptor::Decrypt(unsigned char* data_inp, int size, unsigned char*& d
 		DecryptCipher(hashKey, empty, pInp, pOut, cryptData.cipherAlgorithm);
 	}
 }
+bool ECMADecryptor::StartStream()
+{
+	streamData.reset();
+
+	if (!bVerify) return false;
+
+	streamData = boost::shared_ptr<_ecmaStreamData>(new _ecmaStreamData());
+
+	_buf pPassword	(password);
+	_buf pSalt		(cryptData.saltValue);
+
+	if (cryptData.bAgile)
+	{
+		_buf pBlockKey		((unsigned char*)encrKeyValueBlockKey, 8);
+		_buf pBlockHmacKey	((unsigned char*)encrDataIntegritySaltBlockKey, 8);
+		_buf pKeyValue		(cryptData.encryptedKeyValue);
+		_buf pEncHmacKey	(cryptData.encryptedHmacKey);
+
+		_buf agileKey = GenerateAgileKey( pSalt, pPassword, pBlockKey, cryptData.keySize, cryptData.spinCount, cryptData.hashAlgorithm);
+
+		if (cryptData.cipherAlgorithm == CRYPT_METHOD::RC4)
+		{
+			rc4Decryption.SetKey(agileKey.ptr, cryptData.keySize);
+		}
+		DecryptCipher( agileKey, pSalt, pKeyValue, streamData->key, cryptData.cipherAlgorithm);
+
+		streamData->dataSalt = _buf(cryptData.dataSaltValue);
+	//----
+		_buf iv1 = HashAppend(streamData->dataSalt, pBlockHmacKey, cryptData.dataHashAlgorithm);
+		CorrectHashSize(iv1, cryptData.dataBlockSize, 0x36);
+
+		DecryptCipher(streamData->key, iv1, pEncHmacKey, streamData->hmacKey, cryptData.dataCipherAlgorithm);
+
+		streamData->hmac.reset(CreateHmac(streamData->hmacKey, cryptData.dataHashAlgorithm));
+
+		if (cryptData.cipherAlgorithm == CRYPT_METHOD::RC4)
+		{
+			rc4Decryption.SetKey(streamData->key.ptr, cryptData.keySize);
+		}
+	}
+	else
+	{
+		streamData->key = GenerateHashKey(pSalt, pPassword, cryptData.hashSize, cryptData.keySize, cryptData.spinCount, cryptData.hashAlgorithm);
+
+		if (cryptData.cipherAlgorithm == CRYPT_METHOD::RC4)
+		{
+			rc4Decryption.SetKey(streamData->key.ptr, cryptData.keySize);
+		}
+	}
+	return true;
+}
+void ECMADecryptor::StreamDataIntegrity(unsigned char* data, int  size)
+{
+	if (streamData)
+		streamData->UpdateHmac(data, size);
+}
+void ECMADecryptor::DecryptStream(unsigned char* data_inp, int size, unsigned char* data_out)
+{
+	if (!streamData || !data_inp || !data_out || size <= 0) return;
+
+	if (cryptData.bAgile)
+	{
+		_segmentsJob job;
+
+		job.key				= &streamData->key;
+		job.dataSalt		= &streamData->dataSalt;
+		job.hashAlgorithm	= cryptData.dataHashAlgorithm;
+		job.cipherAlgorithm	= cryptData.cipherAlgorithm;
+		job.blockSize		= cryptData.dataBlockSize;
+		job.data_inp		= data_inp;
+		job.data_out		= data_out;
+		job.size			= size;
+		job.block			= streamData->block;
+
+		streamData->ProcessSegments(job, true);
+	}
+	else
+	{
+		_buf empty	(NULL, 0, false);
+		_buf pInp	(data_inp, size, false);
+		_buf pOut	(data_out, size, false);
+
+		DecryptCipher(streamData->key, empty, pInp, pOut, cryptData.cipherAlgorithm);
+	}
+}
+bool ECMADecryptor::EndStream()
+{
+	if (!streamData) return false;
+
+	bool result = true;
+
+	if (cryptData.bAgile)
+	{
+		result = false;
+
+		if (streamData->hmac)
+		{
+			_buf pBlockHmacValue((unsigned char*)encrDataIntegrityHmacValueBlockKey, 8);
+			_buf pEncHmacValue	(cryptData.encryptedHmacValue);
+
+			_buf iv2 = HashAppend(streamData->dataSalt, pBlockHmacValue, cryptData.dataHashAlgorithm);
+			CorrectHashSize(iv2, cryptData.dataBlockSize, 0x36);
+
+			_buf expected;
+			DecryptCipher(streamData->key, iv2, pEncHmacValue, expected, cryptData.dataCipherAlgorithm);
+
+			_buf hmac(streamData->hmac->DigestSize());
+			streamData->hmac->Final(hmac.ptr);
+
+			result = (hmac == expected);
+		}
+	}
+	streamData.reset();
+	return result;
+}
 //-----------------------------------------------------------------------------------------------------------
 void ODFWriteProtect::SetPassword (const std::wstring &password_)
 {
@@ -1272,6 +1553,142 @@ int ECMAEncryptor::Encrypt(unsigned char* data_inp_ptr, int size, unsigned char*
 	}
 	return result_size_out;
 }
+
+bool ECMAEncryptor::StartStream()
+{
+	streamData = boost::shared_ptr<_ecmaStreamData>(new _ecmaStreamData());
+
+	_buf pPassword	(password);
+	_buf pSalt		(cryptData.saltValue);
+
+	if (cryptData.bAgile)
+	{
+		_buf pBlockKey	((unsigned char*)encrKeyValueBlockKey, 8);
+		_buf pKeyValue	(cryptData.encryptedKeyValue);
+
+		_buf agileKey = GenerateAgileKey( pSalt, pPassword, pBlockKey, cryptData.keySize, cryptData.spinCount, cryptData.hashAlgorithm);
+
+		if (cryptData.cipherAlgorithm == CRYPT_METHOD::RC4)
+		{
+			rc4Decryption.SetKey(agileKey.ptr, cryptData.keySize);
+		}
+		DecryptCipher( agileKey, pSalt, pKeyValue, streamData->key, cryptData.cipherAlgorithm);
+
+		streamData->dataSalt = _buf(cryptData.dataSaltValue);
+	//----
+		RandomPool prng;
+		SecByteBlock seed(cryptData.hashSize);
+
+		OS_GenerateRandomBlock(false, seed, seed.size());
+		prng.IncorporateEntropy(seed, seed.size());
+
+		streamData->hmacKey = _buf(seed.data(), seed.size());
+		streamData->hmac.reset(CreateHmac(streamData->hmacKey, cryptData.hashAlgorithm));
+
+		if (cryptData.cipherAlgorithm == CRYPT_METHOD::RC4)
+		{
+			rc4Encryption.SetKey(streamData->key.ptr, cryptData.keySize);
+		}
+	}
+	else
+	{
+		streamData->key = GenerateHashKey(pSalt, pPassword, cryptData.hashSize, cryptData.keySize, cryptData.spinCount, cryptData.hashAlgorithm);
+
+		if (cryptData.cipherAlgorithm == CRYPT_METHOD::RC4)
+		{
+			rc4Decryption.SetKey(streamData->key.ptr, cryptData.keySize);
+			rc4Encryption.SetKey(streamData->key.ptr, cryptData.keySize);
+		}
+	}
+	return true;
+}
+void ECMAEncryptor::StreamDataIntegrity(unsigned char* data, int  size)
+{
+	if (streamData)
+		streamData->UpdateHmac(data, size);
+}
+int ECMAEncryptor::EncryptStream(unsigned char* data_inp, int size, unsigned char* data_out)
+{//data_out - size + PADDING_SIZE
+	if (!streamData || !data_inp || !data_out || size <= 0) return 0;
+
+	int size_out = size;
+
+	if (cryptData.bAgile)
+	{
+		_segmentsJob job;
+
+		job.bEncrypt		= true;
+		job.key				= &streamData->key;
+		job.dataSalt		= &streamData->dataSalt;
+		job.hashAlgorithm	= cryptData.hashAlgorithm;
+		job.cipherAlgorithm	= cryptData.cipherAlgorithm;
+		job.blockSize		= cryptData.blockSize;
+		job.data_inp		= data_inp;
+		job.data_out		= data_out;
+		job.size			= size;
+		job.block			= streamData->block;
+
+		size_out = streamData->ProcessSegments(job, false);
+
+		streamData->UpdateHmac(data_out, size_out);
+	}
+	else
+	{
+		if (cryptData.cipherAlgorithm != CRYPT_METHOD::RC4 && size_out % PADDING_SIZE != 0)
+			size_out = (size_out / PADDING_SIZE + 1) * PADDING_SIZE;
+
+		_buf empty	(NULL, 0, false);
+		_buf pInp	(data_inp, size, false);
+		_buf pOut	(data_out, size_out, false);
+
+		EncryptCipher(streamData->key, empty, pInp, pOut, cryptData.cipherAlgorithm);
+	}
+	return size_out;
+}
+bool ECMAEncryptor::EndStream()
+{
+	if (!streamData) return false;
+
+	if (cryptData.bAgile && streamData->hmac)
+	{
+		_buf pBlockHmacKey	((unsigned char*)encrDataIntegritySaltBlockKey, 8);
+		_buf pBlockHmacValue((unsigned char*)encrDataIntegrityHmacValueBlockKey, 8);
+
+		_buf iv1 = HashAppend(streamData->dataSalt, pBlockHmacKey, cryptData.hashAlgorithm);
+		CorrectHashSize(iv1, cryptData.blockSize, 0x36);
+
+		_buf iv2 = HashAppend(streamData->dataSalt, pBlockHmacValue, cryptData.hashAlgorithm);
+		CorrectHashSize(iv2, cryptData.blockSize, 0x36);
+
+		_buf hmac(streamData->hmac->DigestSize());
+		streamData->hmac->Final(hmac.ptr);
+
+		_buf & pSaltHmac = streamData->hmacKey;
+
+		if (cryptData.cipherAlgorithm == CRYPT_METHOD::RC4)
+		{
+			rc4Encryption.SetKey(streamData->key.ptr, cryptData.keySize);
+		}
+		if (pSaltHmac.size % PADDING_SIZE != 0) 
+		{
+			CorrectHashSize(pSaltHmac, (pSaltHmac.size / PADDING_SIZE + 1) * PADDING_SIZE, 0);
+		}
+		_buf pEncHmacKey;
+		EncryptCipher(streamData->key,  iv1, pSaltHmac, pEncHmacKey, cryptData.cipherAlgorithm);
+
+		if (hmac.size % PADDING_SIZE != 0) 
+		{
+			CorrectHashSize(hmac, (hmac.size / PADDING_SIZE + 1) * PADDING_SIZE, 0);
+		}
+		_buf pEncHmacValue;
+		EncryptCipher(streamData->key,  iv2, hmac, pEncHmacValue, cryptData.cipherAlgorithm);
+
+		cryptData.encryptedHmacKey		= std::string((char*)pEncHmacKey.ptr, pEncHmacKey.size);
+		cryptData.encryptedHmacValue	= std::string((char*)pEncHmacValue.ptr, pEncHmacValue.size);
+	}
+	streamData.reset();
+	return true;
+}
 //-----------------------------------------------------------------------------------------------------------
 ODFDecryptor::ODFDecryptor()
 {
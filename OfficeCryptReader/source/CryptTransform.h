@@ -183,6 +183,8 @@ private:
     _odfWriteProtectData	data;
 };
 //---------------------------------------------------------------------------------------------------
+struct _ecmaStreamData;
+
 class ECMAEncryptor 
 {
 public:
@@ -198,9 +200,17 @@ public:
 
 	void UpdateDataIntegrity(unsigned char* data, int  size);
 
+//streaming EncryptedPackage: chunks of 4096-byte segments, agile segments are encrypted in parallel
+	bool StartStream();
+	void StreamDataIntegrity(unsigned char* data, int  size);
+	int  EncryptStream(unsigned char* data, int  size, unsigned char* data_out);
+	bool EndStream();
+
 private:
 	std::wstring	password;
 	_ecmaCryptData	cryptData;
+
+	boost::shared_ptr<_ecmaStreamData> streamData;
 };
 
 class ECMADecryptor : public Decryptor
@@ -223,11 +233,20 @@ public:
 	
 	void Decrypt (unsigned char* data, int  size, unsigned char*& data_out, unsigned long start_iv_block);
 
+//streaming EncryptedPackage: chunks of 4096-byte segments, agile segments are decrypted in parallel,
+//the data integrity hmac is computed over the encrypted bytes meanwhile
+	bool StartStream();
+	void StreamDataIntegrity(unsigned char* data, int  size);
+	void DecryptStream(unsigned char* data, int  size, unsigned char* data_out);
+	bool EndStream();
+
 private:
 
 	std::wstring	password;
 	_ecmaCryptData	cryptData;
 	bool			bVerify;
+
+	boost::shared_ptr<_ecmaStreamData> streamData;
 };
 
 class ODFDecryptor
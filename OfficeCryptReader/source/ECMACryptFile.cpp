@@ -44,6 +44,8 @@
 #include "simple_xml_writer.h"
 #include "../../Common/cfcpp/compoundfile.h"
 
+#define STREAM_CHUNK_SIZE 0x400000 // 1024 segments of 4096
+
 //CRYPT::_ecmaCryptData cryptDataGlobal; for Test
 
 #define USE_MSSTORAGE
@@ -758,40 +760,49 @@ bool ECMACryptFile::EncryptOfficeFile(const std::wstring &file_name_inp, const s
 	NSFile::CFileBinary file;
 	if (!file.OpenFile(file_name_inp)) return false;
 
-	_UINT64 lengthFileSize = file.GetFileSize();
-	DWORD lengthData = lengthFileSize, lengthDataRead = 0 ;
-
-	unsigned char* data = new unsigned char[lengthData];
-	unsigned char* data_out	= NULL;
-	
-	file.ReadFile(data, lengthData, lengthDataRead);
-
-	file.CloseFile();
-	
-	lengthData = cryptor.Encrypt(data, lengthData, data_out);
-
-	delete[]data; data = NULL;
-	
-	if (NULL == data_out)
+	if (!cryptor.StartStream())
 	{
+		file.CloseFile();
 		return false;
 	}
-	cryptor.UpdateDataIntegrity(data_out, lengthData);	
-	
-	bool bLargeFile = (lengthData > 3 * 1024 * 1024);
+	_UINT64 lengthFileSize = file.GetFileSize();
 
 //-------------------------------------------------------------------
     CFCPP::CompoundFile *pStorageNew =  new CFCPP::CompoundFile(CFCPP::Ver_3, CFCPP::Default);
 //-------------------------------------------------------------------
     std::shared_ptr<CFCPP::CFStream> oPackage = pStorageNew->RootStorage()->AddStream(L"EncryptedPackage");
-    oPackage->Write((char*)data_out, 0, lengthData);
 
-	if (data_out)
+	unsigned char* data		= new unsigned char[STREAM_CHUNK_SIZE];
+	unsigned char* data_out	= new unsigned char[8 + STREAM_CHUNK_SIZE + 16]; // realsize + chunk + padding
+
+	memcpy(data_out, (unsigned char*)&lengthFileSize, 8);
+	cryptor.StreamDataIntegrity(data_out, 8);
+
+	_INT64 position = 0;
+	int offset = 8;
+
+	DWORD lengthDataRead = 0;
+	while (file.ReadFile(data, STREAM_CHUNK_SIZE, lengthDataRead) && lengthDataRead > 0)
 	{
-		delete []data_out;
-		data_out = NULL;
-	}	
-	
+		int lengthData = cryptor.EncryptStream(data, lengthDataRead, data_out + offset);
+
+		oPackage->Write((char*)data_out, position, offset + lengthData);
+		position += offset + lengthData;
+		offset = 0;
+
+		if (lengthDataRead < STREAM_CHUNK_SIZE) break;
+	}
+	if (offset > 0)
+	{
+		oPackage->Write((char*)data_out, 0, offset);
+	}
+	file.CloseFile();
+
+	delete []data;
+	delete []data_out;
+
+	cryptor.EndStream();
+
 	cryptor.GetCryptData(cryptData);
 
     std::shared_ptr<CFCPP::CFStream> oInfo = pStorageNew->RootStorage()->AddStream(L"EncryptionInfo");
@@ -975,35 +986,67 @@ bool ECMACryptFile::DecryptOfficeFile(const std::wstring &file_name_inp, const s
 	}
 //------------------------------------------------------------------------------------------------------------
 	pStream = new POLE::Stream(pStorage, L"EncryptedPackage");
-	if ((pStream) && (pStream->size() > 0))
+	if ((pStream) && (pStream->size() > 0) && decryptor.StartStream())
 	{
-		_UINT64 lengthData, lengthRead = pStream->size();
-
-		unsigned char* data = new unsigned char[lengthRead];
-		unsigned char* data_out	= NULL;
-		
-		_UINT64 readTrue = pStream->read(data, lengthRead); 
-		_UINT64 readData = readTrue - 8;
+		//in place - the source storage is still being read
+		std::wstring file_name_tmp = file_name_out;
+		if (file_name_out == file_name_inp)
+		{
+			file_name_tmp = NSFile::CFileBinary::CreateTempFileWithUniqueName(NSFile::GetDirectoryName(file_name_out), L"dec");
+		}
 
-		lengthData = (std::min)(*((_UINT64*)data), readData);
+		unsigned char header[8] = {};
+		_UINT64 readHeader = pStream->read(header, 8);
+		_UINT64 lengthData = 0, lengthWrite = 0;
 
-		decryptor.Decrypt(data + 8, (int)readData, data_out, 0);
+		if (readHeader == 8)
+		{
+			lengthData = (std::min)(*((_UINT64*)header), (_UINT64)(pStream->size() - 8));
+		}
+		decryptor.StreamDataIntegrity(header, (int)readHeader);
 
-		if (data_out)
+		NSFile::CFileBinary f;
+		bool bWrite = (readHeader == 8 && f.CreateFileW(file_name_tmp));
+		if (bWrite)
 		{
-			NSFile::CFileBinary f;
-            f.CreateFileW(file_name_out);
-			f.WriteFile(data_out, lengthData);
+			unsigned char* data		= new unsigned char[STREAM_CHUNK_SIZE];
+			unsigned char* data_out	= new unsigned char[STREAM_CHUNK_SIZE];
+
+			_UINT64 readData = 0;
+			while ((readData = pStream->read(data, STREAM_CHUNK_SIZE)) > 0)
+			{
+				decryptor.DecryptStream(data, (int)readData, data_out);
+
+				_UINT64 writeData = (std::min)(readData, (_UINT64)(lengthData - lengthWrite));
+				if (writeData > 0)
+				{
+					f.WriteFile(data_out, (DWORD)writeData);
+					lengthWrite += writeData;
+				}
+				if (readData < STREAM_CHUNK_SIZE) break;
+			}
 			f.CloseFile();
 
+			delete []data;
 			delete []data_out;
-			result = true;
 		}
+		bDataIntegrity = decryptor.EndStream();
 
-		bDataIntegrity = decryptor.CheckDataIntegrity(data, readTrue);
-		
 		delete pStream;
-		delete []data;
+
+		if (file_name_tmp != file_name_out)
+		{
+			delete pStorage; pStorage = NULL;
+
+			result = bWrite && NSFile::CFileBinary::Move(file_name_tmp, file_name_out);
+
+			if (!result && NSFile::CFileBinary::Exists(file_name_tmp))
+				NSFile::CFileBinary::Remove(file_name_tmp);
+		}
+		else if (!bWrite)
+		{
+			result = false;
+		}
 	}
 //-------------------------------------------------------------------
 	delete pStorage;
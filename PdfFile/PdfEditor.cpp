@@ -300,6 +300,7 @@ PdfWriter::CExtGrState* CreateExtGState(Object* oState)
 	PdfWriter::CExtGrState* pState = new PdfWriter::CExtGrState(NULL);
 	return pState;
 }
+PdfWriter::CObjectBase* RawStreamToCObject(Ref oRef, Object* obj, PdfWriter::CDocument* pDoc, XRef* xref, CObjectsManager* pManager, int nStartRefID);
 PdfWriter::CObjectBase* DictToCDictObject2(Object* obj, PdfWriter::CDocument* pDoc, XRef* xref, CObjectsManager* pManager, int nStartRefID, int nAddObjToXRef = 0, bool bUndecodedStream = true)
 {
 	PdfWriter::CObjectBase* pBase = NULL;
@@ -429,7 +430,11 @@ PdfWriter::CObjectBase* DictToCDictObject2(Object* obj, PdfWriter::CDocument* pD
 		}
 
 		obj->fetch(xref, &oTemp);
-		pBase = DictToCDictObject2(&oTemp, pDoc, xref, pManager, nStartRefID, nObjNum, bUndecodedStream);
+		// Поток переносится байтами исходного файла, разбор словаря - запасной путь
+		if (bUndecodedStream && oTemp.isStream())
+			pBase = RawStreamToCObject(obj->getRef(), &oTemp, pDoc, xref, pManager, nStartRefID);
+		if (!pBase)
+			pBase = DictToCDictObject2(&oTemp, pDoc, xref, pManager, nStartRefID, nObjNum, bUndecodedStream);
 		oTemp.free();
 		break;
 	}
@@ -471,15 +476,19 @@ PdfWriter::CObjectBase* DictToCDictObject2(Object* obj, PdfWriter::CDocument* pD
 		}
 		pBase = pDict;
 
-		PdfWriter::CStream* pStream = new PdfWriter::CMemoryStream(nLength);
+		PdfWriter::CStream* pStream = new PdfWriter::CMemoryStream(nLength > 0 ? nLength : STREAM_BUF_SIZ);
 		pDict->SetStream(pStream);
 		Stream* pOStream = bUndecodedStream ? obj->getStream()->getUndecodedStream() : obj->getStream();
 		pOStream->reset();
-		int nChar = pOStream->getChar();
-		while (nChar != EOF)
+
+		// Данные потока переносятся блоками, без разбора и декодирования фильтров.
+		// Для незашифрованного файла getBlock читает исходный диапазон байт напрямую
+		char pBuffer[STREAM_BUF_SIZ];
+		int nRead = pOStream->getBlock(pBuffer, STREAM_BUF_SIZ);
+		while (nRead > 0)
 		{
-			pStream->WriteChar(nChar);
-			nChar = pOStream->getChar();
+			pStream->Write((BYTE*)pBuffer, nRead);
+			nRead = pOStream->getBlock(pBuffer, STREAM_BUF_SIZ);
 		}
 		break;
 	}
@@ -496,6 +505,154 @@ PdfWriter::CObjectBase* DictToCDictObject2(Object* obj, PdfWriter::CDocument* pD
 
 	return pBase;
 }
+struct TRawSpan
+{
+	GFileOffset nStart;
+	GFileOffset nEnd;
+	Ref oRef;
+	bool bLength;
+};
+PdfWriter::CObjectBase* RawStreamToCObject(Ref oRef, Object* obj, PdfWriter::CDocument* pDoc, XRef* xref, CObjectsManager* pManager, int nStartRefID)
+{
+	// Только незашифрованный объект верхнего уровня, не из потока объектов
+	if (xref->isEncrypted() || oRef.num < 0 || oRef.num >= xref->getSize())
+		return NULL;
+	XRefEntry* pEntry = xref->getEntry(oRef.num);
+	if (pEntry->type != xrefEntryUncompressed || pEntry->gen != oRef.gen)
+		return NULL;
+
+	BaseStream* pBaseStream = obj->getStream()->getBaseStream();
+	Object oNull;
+	oNull.initNull();
+	Lexer* pLexer = new Lexer(xref, pBaseStream->makeSubStream(xref->getStart() + pEntry->offset, gFalse, 0, &oNull));
+
+	// Заголовок "N G obj"
+	Object oToken;
+	bool bValid = pLexer->getObj(&oToken)->isInt() && oToken.getInt() == oRef.num;
+	oToken.free();
+	bValid = bValid && pLexer->getObj(&oToken)->isInt() && oToken.getInt() == oRef.gen;
+	oToken.free();
+	bValid = bValid && pLexer->getObj(&oToken)->isCmd("obj");
+	oToken.free();
+
+	// Словарь потока просматривается лексером: запоминаются ссылки N G R и значение Length.
+	// Строки пришлось бы шифровать при записи, такие словари идут запасным путем
+	GFileOffset nBodyStart = pLexer->getPos(), nBodyEnd = -1, nPos = nBodyStart;
+	std::vector<TRawSpan> arrSpans;
+	GFileOffset arrIntStart[2] = { -1, -1 }, nLengthValue = -1;
+	int arrInt[2] = { 0, 0 }, nDepth = 0;
+	bool bKey = false, bLength = false;
+	while (bValid && nBodyEnd < 0)
+	{
+		GFileOffset nStart = nPos;
+		pLexer->getObj(&oToken);
+		nPos = pLexer->getPos();
+		if (oToken.isError() || oToken.isEOF() || oToken.isString() || (nDepth == 0 && !oToken.isCmd("<<")))
+			bValid = false;
+		else if (oToken.isCmd("<<") || oToken.isCmd("["))
+		{
+			++nDepth;
+			bKey = oToken.isCmd("<<") && nDepth == 1;
+		}
+		else if (oToken.isCmd(">>") || oToken.isCmd("]"))
+		{
+			if (--nDepth == 0)
+				nBodyEnd = nPos;
+			bKey = nDepth == 1;
+		}
+		else if (oToken.isCmd("R"))
+		{
+			bValid = arrIntStart[0] >= 0 && arrIntStart[1] >= 0;
+			if (bValid && arrIntStart[0] == nLengthValue)
+				arrSpans.back().nEnd = nPos;
+			else if (bValid)
+				arrSpans.push_back({ arrIntStart[0], nPos, { arrInt[0], arrInt[1] }, false });
+			bKey = nDepth == 1;
+		}
+		else if (nDepth == 1 && bKey && oToken.isName())
+		{
+			bLength = oToken.isName("Length");
+			if (bLength)
+				arrSpans.push_back({ nStart, -1, { 0, 0 }, true });
+			bKey = false;
+		}
+		else
+		{
+			if (bLength)
+			{
+				bValid = oToken.isInt();
+				nLengthValue = nStart;
+				arrSpans.back().nEnd = nPos;
+				bLength = false;
+			}
+			bKey = nDepth == 1;
+		}
+
+		arrIntStart[0] = arrIntStart[1];
+		arrInt[0] = arrInt[1];
+		arrIntStart[1] = oToken.isInt() ? nStart : -1;
+		arrInt[1] = oToken.isInt() ? oToken.getInt() : 0;
+		oToken.free();
+	}
+	bValid = bValid && pLexer->getObj(&oToken)->isCmd("stream");
+	oToken.free();
+	delete pLexer;
+
+	bool bHasLength = false;
+	for (int i = 0; i < arrSpans.size(); ++i)
+		bHasLength = bHasLength || (arrSpans[i].bLength && arrSpans[i].nEnd > 0);
+	if (!bValid || !bHasLength)
+		return NULL;
+
+	int nBodyLen = nBodyEnd - nBodyStart;
+	BYTE* pBody = new BYTE[nBodyLen];
+	oNull.initNull();
+	Stream* pBodyStream = pBaseStream->makeSubStream(nBodyStart, gTrue, nBodyLen, &oNull);
+	pBodyStream->reset();
+	bValid = pBodyStream->getBlock((char*)pBody, nBodyLen) == nBodyLen;
+	pBodyStream->close();
+	delete pBodyStream;
+	if (!bValid)
+	{
+		RELEASEARRAYOBJECTS(pBody);
+		return NULL;
+	}
+
+	// Данные потока переносятся блоками без декодирования
+	PdfWriter::CStream* pStream = new PdfWriter::CMemoryStream(STREAM_BUF_SIZ);
+	Stream* pOStream = obj->getStream()->getUndecodedStream();
+	pOStream->reset();
+	char pBuffer[STREAM_BUF_SIZ];
+	int nRead = pOStream->getBlock(pBuffer, STREAM_BUF_SIZ);
+	while (nRead > 0)
+	{
+		pStream->Write((BYTE*)pBuffer, nRead);
+		nRead = pOStream->getBlock(pBuffer, STREAM_BUF_SIZ);
+	}
+
+	// Объект регистрируется до перевода ссылок, как и в DictToCDictObject2
+	PdfWriter::CRawObject* pRaw = new PdfWriter::CRawObject(pBody, nBodyLen, pStream);
+	pDoc->AddObject(pRaw);
+	pManager->AddObj(oRef.num + nStartRefID, pRaw);
+
+	for (int i = 0; i < arrSpans.size(); ++i)
+	{
+		const TRawSpan& oSpan = arrSpans[i];
+		if (oSpan.bLength)
+		{
+			pRaw->SetLength(oSpan.nStart - nBodyStart, oSpan.nEnd - oSpan.nStart);
+			continue;
+		}
+
+		Object oRefObj;
+		oRefObj.initRef(oSpan.oRef.num, oSpan.oRef.gen);
+		PdfWriter::CObjectBase* pObj = DictToCDictObject2(&oRefObj, pDoc, xref, pManager, nStartRefID);
+		oRefObj.free();
+		pRaw->AddRef(oSpan.nStart - nBodyStart, oSpan.nEnd - oSpan.nStart, pObj);
+	}
+
+	return pRaw;
+}
 void AddWidgetParent(PdfWriter::CDocument* pDoc, CObjectsManager* pManager, PdfWriter::CObjectBase* pObj)
 {
 	if (pObj->GetType() != PdfWriter::object_type_DICT)
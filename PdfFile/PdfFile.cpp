@@ -40,6 +40,7 @@
 
 #include "OnlineOfficeBinToPdf.h"
 #include "SrcWriter/Document.h"
+#include "SrcReader/FontCache.h"
 
 class CPdfFile_Private
 {
@@ -199,6 +200,15 @@ void CPdfFile::ToXml(const std::wstring& sFile, bool bSaveStreams)
 		m_pInternal->pReader->ToXml(sFile, bSaveStreams);
 }
 
+void CPdfFile::SetFontCacheLimit(unsigned int unLimit)
+{
+	PdfReader::CFontCache::GetInstance()->SetLimit(unLimit);
+}
+void CPdfFile::GetFontCacheStat(unsigned int& unCount, unsigned int& unSize)
+{
+	unCount = (unsigned int)PdfReader::CFontCache::GetInstance()->GetCount();
+	unSize  = (unsigned int)PdfReader::CFontCache::GetInstance()->GetSize();
+}
 bool CPdfFile::GetMetaData(const std::wstring& sFile, const std::wstring& sMetaName, BYTE** pMetaData, DWORD& nMetaLength)
 {
 	NSFile::CFileBinary oFile;
@@ -531,6 +541,12 @@ int CPdfFile::SaveToFile(const std::wstring& wsPath)
 		return 1;
 	return m_pInternal->pWriter->SaveToFile(wsPath);
 }
+bool CPdfFile::StartStreaming(const std::wstring& wsPath)
+{
+	if (!m_pInternal->pWriter)
+		return false;
+	return m_pInternal->pWriter->StartStreaming(wsPath);
+}
 void CPdfFile::SetPassword(const std::wstring& wsPassword)
 {
 	if (m_pInternal->pWriter)
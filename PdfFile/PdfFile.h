@@ -111,6 +111,10 @@ public:
 	void ToXml(const std::wstring& sFile, bool bSaveStreams = false);
 
 	static bool GetMetaData(const std::wstring& sFile, const std::wstring& sMetaName, BYTE** pMetaData, DWORD& nMetaLength);
+	// Ограничение (в байтах) общего на процесс кэша разобранных шрифтов и CMap, 0 - кэш отключен
+	static void SetFontCacheLimit(unsigned int unLimit);
+	// Число записей и занимаемый объем (в байтах) этого кэша
+	static void GetFontCacheStat(unsigned int& unCount, unsigned int& unSize);
 	virtual bool LoadFromFile  (const std::wstring& file, const std::wstring& options = L"", const std::wstring& owner_password = L"", const std::wstring& user_password = L"");
 	virtual bool LoadFromMemory(BYTE* data, DWORD length, const std::wstring& options = L"", const std::wstring& owner_password = L"", const std::wstring& user_password = L"");
 	virtual NSFonts::IApplicationFonts* GetFonts();
@@ -122,6 +126,9 @@ public:
 
 	virtual int GetPagesCount();
 	virtual void GetPageInfo(int nPageIndex, double* pdWidth, double* pdHeight, double* pdDpiX, double* pdDpiY);
+	// GetPageInfo и DrawPageOnRenderer можно вызывать одновременно из нескольких потоков для одного загруженного документа,
+	// если у каждого потока свой pRenderer и pParams у всех одинаковые.
+	// Загрузка, MergePages/UnmergePages, RedactPage и редактирование в это время недопустимы
 	virtual void DrawPageOnRenderer(IRenderer* pRenderer, int nPageIndex, bool* pBreak, COfficeDrawingPageParams* pParams = NULL);
 	virtual std::wstring GetInfo();
 	virtual BYTE* GetStructure();
@@ -151,6 +158,8 @@ public:
 
 	void CreatePdf    (bool isPDFA = false);
 	int  SaveToFile   (const std::wstring& wsPath);
+	// законченные страницы пишутся в wsPath сразу, SaveToFile дописывает остальное
+	bool StartStreaming(const std::wstring& wsPath);
 	void RotatePage   (int nRotate);
 	void SetPassword  (const std::wstring& wsPassword);
 	void SetDocumentID(const std::wstring& wsDocumentID);
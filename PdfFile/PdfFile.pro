@@ -61,14 +61,17 @@ SOURCES += \
 	SrcReader/RendererOutputDev.cpp \
     SrcReader/Adaptors.cpp \
     SrcReader/PdfAnnot.cpp \
-    SrcReader/GfxClip.cpp
+    SrcReader/GfxClip.cpp \
+    SrcReader/FontCache.cpp
 
 HEADERS += \
 	SrcReader/RendererOutputDev.h \
     SrcReader/Adaptors.h \
     SrcReader/MemoryUtils.h \
     SrcReader/PdfAnnot.h \
-    SrcReader/GfxClip.h
+    SrcReader/GfxClip.h \
+    SrcReader/FontCache.h \
+    SrcReader/LRUCache.h
 
 # Base fonts
 HEADERS += \
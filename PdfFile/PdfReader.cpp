@@ -214,6 +214,8 @@ CPdfRedact::~CPdfRedact()
 CPdfReader::CPdfReader(NSFonts::IApplicationFonts* pAppFonts)
 {
 	m_nFileLength  = 0;
+	m_bFontManagerBusy = false;
+	m_oFontManagersCS.InitializeCriticalSection();
 
 	globalParams  = new GlobalParamsAdaptor(NULL);
 #ifndef _DEBUG
@@ -242,6 +244,7 @@ CPdfReader::~CPdfReader()
 
 	RELEASEOBJECT(globalParams);
 	RELEASEINTERFACE(m_pFontManager);
+	m_oFontManagersCS.DeleteCriticalSection();
 }
 void CPdfReader::Clear()
 {
@@ -252,6 +255,34 @@ void CPdfReader::Clear()
 	for (CPdfRedact* pRedact : m_vRedact)
 		delete pRedact;
 	m_vRedact.clear();
+
+	for (NSFonts::IFontManager* pFontManager : m_arrFontManagers)
+		RELEASEINTERFACE(pFontManager);
+	m_arrFontManagers.clear();
+}
+NSFonts::IFontManager* CPdfReader::AcquireFontManager()
+{
+	CTemporaryCS oCS(&m_oFontManagersCS);
+	if (!m_bFontManagerBusy)
+	{
+		m_bFontManagerBusy = true;
+		return m_pFontManager;
+	}
+	if (!m_arrFontManagers.empty())
+	{
+		NSFonts::IFontManager* pFontManager = m_arrFontManagers.back();
+		m_arrFontManagers.pop_back();
+		return pFontManager;
+	}
+	return InitFontManager(m_pFontManager->GetApplication());
+}
+void CPdfReader::ReleaseFontManager(NSFonts::IFontManager* pFontManager)
+{
+	CTemporaryCS oCS(&m_oFontManagersCS);
+	if (pFontManager == m_pFontManager)
+		m_bFontManagerBusy = false;
+	else
+		m_arrFontManagers.push_back(pFontManager);
 }
 void CPdfReader::CleanUp()
 {
@@ -814,22 +845,25 @@ void CPdfReader::DrawPageOnRenderer(IRenderer* pRenderer, int _nPageIndex, bool*
 	if (nPageIndex < 0 || !pDoc || !pFontList)
 		return;
 
-	for (int i = 0 ; i < m_vRedact.size(); ++i)
+	// XRef, Catalog и список шрифтов документа общие для всех потоков (xpdf собран с MULTITHREADED),
+	// Gfx, RendererOutputDev и менеджер шрифтов - свои для каждого вызова
+	NSFonts::IFontManager* pFontManager = AcquireFontManager();
 	{
-		if (m_vRedact[i]->m_nPageIndex == _nPageIndex)
-			((GlobalParamsAdaptor*)globalParams)->AddRedact(m_vRedact[i]->m_arrRedactBox);
-	}
-
-	PdfReader::RendererOutputDev oRendererOut(pRenderer, m_pFontManager, pFontList);
-	oRendererOut.NewPDF(pDoc->getXRef());
-	oRendererOut.SetBreak(pbBreak);
-	int nRotate = 0;
+		PdfReader::RendererOutputDev oRendererOut(pRenderer, pFontManager, pFontList);
+		oRendererOut.NewPDF(pDoc->getXRef());
+		oRendererOut.SetBreak(pbBreak);
+		for (int i = 0 ; i < m_vRedact.size(); ++i)
+		{
+			if (m_vRedact[i]->m_nPageIndex == _nPageIndex)
+				oRendererOut.AddRedact(m_vRedact[i]->m_arrRedactBox);
+		}
+		int nRotate = 0;
 #ifdef BUILDING_WASM_MODULE
-	nRotate = -pDoc->getPageRotate(nPageIndex);
+		nRotate = -pDoc->getPageRotate(nPageIndex);
 #endif
-	pDoc->displayPage(&oRendererOut, nPageIndex, 72.0, 72.0, nRotate, gFalse, gTrue, gFalse);
-
-	((GlobalParamsAdaptor*)globalParams)->ClearRedact();
+		pDoc->displayPage(&oRendererOut, nPageIndex, 72.0, 72.0, nRotate, gFalse, gTrue, gFalse);
+	}
+	ReleaseFontManager(pFontManager);
 
 	LONG lRendererType = 0;
 	pRenderer->get_Type(&lRendererType);
@@ -96,6 +96,7 @@ public:
 	bool RedactPage(int nPageIndex, double* arrRedactBox, int nLengthX8, BYTE* pChanges, int nLength);
 	bool UndoRedact();
 	void GetPageInfo(int nPageIndex, double* pdWidth, double* pdHeight, double* pdDpiX, double* pdDpiY);
+	// Может вызываться одновременно из нескольких потоков для разных рендереров (см. CPdfFile::DrawPageOnRenderer)
 	void DrawPageOnRenderer(IRenderer* pRenderer, int nPageIndex, bool* pBreak);
 	std::wstring GetInfo();
 	std::wstring GetFontPath(const std::wstring& wsFontName, bool bSave = true);
@@ -125,9 +126,15 @@ public:
 
 private:
 	void Clear();
+	NSFonts::IFontManager* AcquireFontManager();
+	void ReleaseFontManager(NSFonts::IFontManager* pFontManager);
 
 	std::wstring           m_wsTempFolder;
 	NSFonts::IFontManager* m_pFontManager;
+	// Менеджер шрифтов не потокобезопасен, поэтому параллельные DrawPageOnRenderer берут свободный из пула
+	bool                                m_bFontManagerBusy;
+	std::vector<NSFonts::IFontManager*> m_arrFontManagers;
+	NSCriticalSection::CRITICAL_SECTION m_oFontManagersCS;
 	DWORD                  m_nFileLength;
 	int                    m_eError;
 	std::vector<CPdfReaderContext*> m_vPDFContext;
@@ -248,6 +248,13 @@ int CPdfWriter::SaveToMemory(BYTE** pData, int* pLength)
 
 	return 0;
 }
+bool CPdfWriter::StartStreaming(const std::wstring& wsPath)
+{
+	if (!IsValid())
+		return false;
+
+	return m_pDocument->StartStreaming(wsPath);
+}
 void CPdfWriter::SetDocumentInfo(const std::wstring& wsTitle, const std::wstring& wsCreator, const std::wstring& wsSubject, const std::wstring& wsKeywords)
 {
 	if (!IsValid())
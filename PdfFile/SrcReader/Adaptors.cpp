@@ -182,26 +182,22 @@ bool GlobalParamsAdaptor::GetCMap(const char* sName, char*& pData, unsigned int&
     return false;
 }
 
-void GlobalParamsAdaptor::AddRedact(const std::vector<double>& arrRedactBox)
-{
-	m_arrRedactBox.insert(m_arrRedactBox.end(), arrRedactBox.begin(), arrRedactBox.end());
-}
 double crossProduct(double x1, double y1, double x2, double y2, double x3, double y3)
 {
 	return (x2 - x1) * (y3 - y1) - (y2 - y1) * (x3 - x1);
 }
-bool GlobalParamsAdaptor::InRedact(double dX, double dY)
+bool GlobalParamsAdaptor::InRedact(const std::vector<double>& arrRedactBox, double dX, double dY)
 {
-	for (int i = 0; i < m_arrRedactBox.size(); i += 8)
+	for (int i = 0; i < arrRedactBox.size(); i += 8)
 	{
-		double x1 = m_arrRedactBox[i + 0];
-		double y1 = m_arrRedactBox[i + 1];
-		double x2 = m_arrRedactBox[i + 2];
-		double y2 = m_arrRedactBox[i + 3];
-		double x3 = m_arrRedactBox[i + 6];
-		double y3 = m_arrRedactBox[i + 7];
-		double x4 = m_arrRedactBox[i + 4];
-		double y4 = m_arrRedactBox[i + 5];
+		double x1 = arrRedactBox[i + 0];
+		double y1 = arrRedactBox[i + 1];
+		double x2 = arrRedactBox[i + 2];
+		double y2 = arrRedactBox[i + 3];
+		double x3 = arrRedactBox[i + 6];
+		double y3 = arrRedactBox[i + 7];
+		double x4 = arrRedactBox[i + 4];
+		double y4 = arrRedactBox[i + 5];
 
 		if (x1 == x2 && x2 == x3 && x3 == x4 && y1 == y2 && y2 == y3 && y3 == y4)
 		{
@@ -225,10 +221,6 @@ bool GlobalParamsAdaptor::InRedact(double dX, double dY)
 	}
 	return false;
 }
-void GlobalParamsAdaptor::ClearRedact()
-{
-	m_arrRedactBox.clear();
-}
 
 bool operator==(const Ref &a, const Ref &b)
 {
@@ -61,7 +61,6 @@ private:
     DWORD m_nCMapDataLength;
 
     bool m_bDrawFormField;
-	std::vector<double> m_arrRedactBox;
 
 public:
     GlobalParamsAdaptor(const char *filename) : GlobalParams(filename)
@@ -95,9 +94,7 @@ public:
 	void setDrawFormField(bool bDrawFormField) { m_bDrawFormField = bDrawFormField; }
     bool getDrawFormField() { return m_bDrawFormField; }
 
-	void AddRedact(const std::vector<double>& arrRedactBox);
-	bool InRedact(double dX, double dY);
-	void ClearRedact();
+	static bool InRedact(const std::vector<double>& arrRedactBox, double dX, double dY);
 private:
 
 	void AddNameToUnicode(const char* sFile);
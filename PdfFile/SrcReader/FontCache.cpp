@@ -0,0 +1,140 @@
+/*
+ * (c) Copyright UNIVAULT TECHNOLOGIES 2026-2026
+ *
+ * This program is a free software product. You can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License (AGPL)
+ * version 3 as published by the Free Software Foundation. In accordance with
+ * Section 7(a) of the GNU AGPL its Section 15 shall be amended to the effect
+ * that UNIVAULT TECHNOLOGIES expressly excludes the warranty of non-infringement
+ * of any third-party rights.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR  PURPOSE. For
+ * details, see the GNU AGPL at: http://www.gnu.org/licenses/agpl-3.0.html
+ *
+ * You can contact UNIVAULT TECHNOLOGIES at 20A-6 Ernesta Birznieka-Upish
+ * street, Moscow (TEST), Russia (TEST), EU, 000000 (TEST).
+ *
+ * The  interactive user interfaces in modified source and object code versions
+ * of the Program must display Appropriate Legal Notices, as required under
+ * Section 5 of the GNU AGPL version 3.
+ *
+ * Pursuant to Section 7(b) of the License you must retain the original Product
+ * logo when distributing the program. Pursuant to Section 7(e) we decline to
+ * grant you any rights under trademark law for use of our trademarks.
+ *
+ * All the Product's GUI elements, including illustrations and icon sets, as
+ * well as technical writing content are licensed under the terms of the
+ * Creative Commons Attribution-ShareAlike 4.0 International. See the License
+ * terms at http://creativecommons.org/licenses/by-sa/4.0/legalcode
+ *
+ */
+#include "FontCache.h"
+#include "../lib/goo/gmem.h"
+#include "../lib/xpdf/CMap.h"
+#include "../lib/xpdf/CharCodeToUnicode.h"
+
+#include "../../Common/3dParty/cryptopp/sha.h"
+
+#include <string.h>
+
+#define FONT_CACHE_DEFAULT_LIMIT (64 * 1024 * 1024)
+
+namespace PdfReader
+{
+	CFontCache* CFontCache::GetInstance()
+	{
+		static CFontCache oInstance;
+		return &oInstance;
+	}
+	std::string CFontCache::GetKey(const char* sType, const char* pData, int nLen, const std::string& sExtra)
+	{
+		unsigned char arrDigest[CryptoPP::SHA256::DIGESTSIZE];
+		CryptoPP::SHA256 oHash;
+		oHash.CalculateDigest(arrDigest, (const unsigned char*)pData, nLen > 0 ? nLen : 0);
+
+		std::string sKey(sType);
+		sKey += '\n';
+		sKey += sExtra;
+		sKey += '\n';
+		sKey.append((const char*)arrDigest, CryptoPP::SHA256::DIGESTSIZE);
+		return sKey;
+	}
+	CFontCache::CFontCache() : CLRUCache(FONT_CACHE_DEFAULT_LIMIT)
+	{
+	}
+	CFontCache::~CFontCache()
+	{
+		Clear();
+	}
+	CMap* CFontCache::GetCMap(const std::string& sKey)
+	{
+		return (CMap*)Get(sKey, entryCMap);
+	}
+	CharCodeToUnicode* CFontCache::GetToUnicode(const std::string& sKey)
+	{
+		return (CharCodeToUnicode*)Get(sKey, entryToUnicode);
+	}
+	char* CFontCache::GetFontFile(const std::string& sKey, int* pnLen)
+	{
+		size_t nSize = 0;
+		char* pData = (char*)Get(sKey, entryFontFile, &nSize);
+		if (pData)
+			*pnLen = (int)nSize;
+		return pData;
+	}
+	void CFontCache::AddCMap(const std::string& sKey, CMap* pCMap, size_t nSize)
+	{
+		if (pCMap && Add(sKey, entryCMap, pCMap, nSize))
+			pCMap->incRefCnt();
+	}
+	void CFontCache::AddToUnicode(const std::string& sKey, CharCodeToUnicode* pToUnicode, size_t nSize)
+	{
+		if (pToUnicode && Add(sKey, entryToUnicode, pToUnicode, nSize))
+			pToUnicode->incRefCnt();
+	}
+	void CFontCache::AddFontFile(const std::string& sKey, const char* pData, int nLen)
+	{
+		if (!pData || nLen <= 0)
+			return;
+
+		char* pCopy = (char*)gmalloc(nLen);
+		memcpy(pCopy, pData, nLen);
+		if (!Add(sKey, entryFontFile, pCopy, nLen))
+			gfree(pCopy);
+	}
+	void* CFontCache::Acquire(int nType, void* pObject, size_t nSize)
+	{
+		switch (nType)
+		{
+		case entryCMap:
+			((CMap*)pObject)->incRefCnt();
+			return pObject;
+		case entryToUnicode:
+			((CharCodeToUnicode*)pObject)->incRefCnt();
+			return pObject;
+		case entryFontFile:
+		{
+			char* pCopy = (char*)gmalloc((int)nSize);
+			memcpy(pCopy, pObject, nSize);
+			return pCopy;
+		}
+		}
+		return NULL;
+	}
+	void CFontCache::Release(int nType, void* pObject)
+	{
+		switch (nType)
+		{
+		case entryCMap:
+			((CMap*)pObject)->decRefCnt();
+			break;
+		case entryToUnicode:
+			((CharCodeToUnicode*)pObject)->decRefCnt();
+			break;
+		case entryFontFile:
+			gfree(pObject);
+			break;
+		}
+	}
+}
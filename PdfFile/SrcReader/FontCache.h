@@ -0,0 +1,82 @@
+/*
+ * (c) Copyright UNIVAULT TECHNOLOGIES 2026-2026
+ *
+ * This program is a free software product. You can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License (AGPL)
+ * version 3 as published by the Free Software Foundation. In accordance with
+ * Section 7(a) of the GNU AGPL its Section 15 shall be amended to the effect
+ * that UNIVAULT TECHNOLOGIES expressly excludes the warranty of non-infringement
+ * of any third-party rights.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR  PURPOSE. For
+ * details, see the GNU AGPL at: http://www.gnu.org/licenses/agpl-3.0.html
+ *
+ * You can contact UNIVAULT TECHNOLOGIES at 20A-6 Ernesta Birznieka-Upish
+ * street, Moscow (TEST), Russia (TEST), EU, 000000 (TEST).
+ *
+ * The  interactive user interfaces in modified source and object code versions
+ * of the Program must display Appropriate Legal Notices, as required under
+ * Section 5 of the GNU AGPL version 3.
+ *
+ * Pursuant to Section 7(b) of the License you must retain the original Product
+ * logo when distributing the program. Pursuant to Section 7(e) we decline to
+ * grant you any rights under trademark law for use of our trademarks.
+ *
+ * All the Product's GUI elements, including illustrations and icon sets, as
+ * well as technical writing content are licensed under the terms of the
+ * Creative Commons Attribution-ShareAlike 4.0 International. See the License
+ * terms at http://creativecommons.org/licenses/by-sa/4.0/legalcode
+ *
+ */
+#ifndef _PDF_READER_FONT_CACHE_H
+#define _PDF_READER_FONT_CACHE_H
+
+#include "LRUCache.h"
+
+class CMap;
+class CharCodeToUnicode;
+
+namespace PdfReader
+{
+	//-------------------------------------------------------------------------------------------------------------------------------
+	// CFontCache - общий на процесс кэш разобранных CMap, ToUnicode и данных внедренных шрифтов.
+	// Ключ строится по SHA-256 исходных данных, поэтому одинаковые шрифты и CMap из разных страниц
+	// и разных документов разбираются один раз. Размер ограничен, вытесняются давно не использованные записи.
+	//-------------------------------------------------------------------------------------------------------------------------------
+	class CFontCache : public CLRUCache
+	{
+	public:
+		static CFontCache* GetInstance();
+		static std::string GetKey(const char* sType, const char* pData, int nLen, const std::string& sExtra = "");
+
+		// Возвращают объект с увеличенным счетчиком ссылок, либо NULL
+		CMap* GetCMap(const std::string& sKey);
+		CharCodeToUnicode* GetToUnicode(const std::string& sKey);
+		// Возвращает копию данных (память gmalloc), либо NULL
+		char* GetFontFile(const std::string& sKey, int* pnLen);
+
+		// Кэш берет свою ссылку на объект, nSize - примерный занимаемый объем
+		void AddCMap(const std::string& sKey, CMap* pCMap, size_t nSize);
+		void AddToUnicode(const std::string& sKey, CharCodeToUnicode* pToUnicode, size_t nSize);
+		void AddFontFile(const std::string& sKey, const char* pData, int nLen);
+
+	private:
+		enum EEntryType
+		{
+			entryCMap,
+			entryToUnicode,
+			entryFontFile
+		};
+
+		CFontCache();
+		~CFontCache();
+		CFontCache(const CFontCache&);
+		CFontCache& operator=(const CFontCache&);
+
+		virtual void* Acquire(int nType, void* pObject, size_t nSize);
+		virtual void  Release(int nType, void* pObject);
+	};
+}
+
+#endif // _PDF_READER_FONT_CACHE_H
@@ -0,0 +1,160 @@
+/*
+ * (c) Copyright UNIVAULT TECHNOLOGIES 2026-2026
+ *
+ * This program is a free software product. You can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License (AGPL)
+ * version 3 as published by the Free Software Foundation. In accordance with
+ * Section 7(a) of the GNU AGPL its Section 15 shall be amended to the effect
+ * that UNIVAULT TECHNOLOGIES expressly excludes the warranty of non-infringement
+ * of any third-party rights.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR  PURPOSE. For
+ * details, see the GNU AGPL at: http://www.gnu.org/licenses/agpl-3.0.html
+ *
+ * You can contact UNIVAULT TECHNOLOGIES at 20A-6 Ernesta Birznieka-Upish
+ * street, Moscow (TEST), Russia (TEST), EU, 000000 (TEST).
+ *
+ * The  interactive user interfaces in modified source and object code versions
+ * of the Program must display Appropriate Legal Notices, as required under
+ * Section 5 of the GNU AGPL version 3.
+ *
+ * Pursuant to Section 7(b) of the License you must retain the original Product
+ * logo when distributing the program. Pursuant to Section 7(e) we decline to
+ * grant you any rights under trademark law for use of our trademarks.
+ *
+ * All the Product's GUI elements, including illustrations and icon sets, as
+ * well as technical writing content are licensed under the terms of the
+ * Creative Commons Attribution-ShareAlike 4.0 International. See the License
+ * terms at http://creativecommons.org/licenses/by-sa/4.0/legalcode
+ *
+ */
+#ifndef _PDF_READER_LRU_CACHE_H
+#define _PDF_READER_LRU_CACHE_H
+
+#include <list>
+#include <map>
+#include <string>
+#include "../../DesktopEditor/graphics/TemporaryCS.h"
+
+namespace PdfReader
+{
+	//-------------------------------------------------------------------------------------------------------------------------------
+	// CLRUCache - потокобезопасный кэш объектов с ограничением суммарного размера, вытесняются давно не использованные записи.
+	// Кэш не знает типов объектов: выдача и освобождение реализуются наследником в Acquire/Release.
+	// Наследник обязан вызвать Clear() в своем деструкторе.
+	//-------------------------------------------------------------------------------------------------------------------------------
+	class CLRUCache
+	{
+	public:
+		CLRUCache(size_t nLimit) : m_nSize(0), m_nLimit(nLimit)
+		{
+			m_oCS.InitializeCriticalSection();
+		}
+		virtual ~CLRUCache()
+		{
+			m_oCS.DeleteCriticalSection();
+		}
+
+		// Ограничение в байтах, 0 - кэш отключен
+		void SetLimit(size_t nLimit)
+		{
+			CTemporaryCS oCS(&m_oCS);
+			m_nLimit = nLimit;
+			Shrink(m_nLimit);
+		}
+		size_t GetLimit()
+		{
+			CTemporaryCS oCS(&m_oCS);
+			return m_nLimit;
+		}
+		size_t GetSize()
+		{
+			CTemporaryCS oCS(&m_oCS);
+			return m_nSize;
+		}
+		size_t GetCount()
+		{
+			CTemporaryCS oCS(&m_oCS);
+			return m_mEntries.size();
+		}
+		void Clear()
+		{
+			CTemporaryCS oCS(&m_oCS);
+			Shrink(0);
+		}
+
+	protected:
+		// Возвращает результат Acquire для найденной записи, либо NULL
+		void* Get(const std::string& sKey, int nType, size_t* pnSize = NULL)
+		{
+			CTemporaryCS oCS(&m_oCS);
+
+			std::map<std::string, TEntry>::iterator oPos = m_mEntries.find(sKey);
+			if (m_mEntries.end() == oPos || oPos->second.nType != nType)
+				return NULL;
+
+			TEntry& oEntry = oPos->second;
+			m_lLRU.splice(m_lLRU.begin(), m_lLRU, oEntry.itLRU);
+			if (pnSize)
+				*pnSize = oEntry.nSize;
+			return Acquire(nType, oEntry.pObject, oEntry.nSize);
+		}
+		// При успехе объект переходит во владение кэша и будет освобожден через Release
+		bool Add(const std::string& sKey, int nType, void* pObject, size_t nSize)
+		{
+			CTemporaryCS oCS(&m_oCS);
+
+			// Записи больше всего кэша не добавляем, уже имеющиеся не заменяем
+			if (0 == m_nLimit || nSize > m_nLimit || m_mEntries.end() != m_mEntries.find(sKey))
+				return false;
+
+			Shrink(m_nLimit - nSize);
+
+			m_lLRU.push_front(sKey);
+			TEntry& oEntry = m_mEntries[sKey];
+			oEntry.nType   = nType;
+			oEntry.pObject = pObject;
+			oEntry.nSize   = nSize;
+			oEntry.itLRU   = m_lLRU.begin();
+			m_nSize += nSize;
+			return true;
+		}
+
+		// Вызываются под блокировкой кэша
+		virtual void* Acquire(int nType, void* pObject, size_t nSize) = 0;
+		virtual void  Release(int nType, void* pObject) = 0;
+
+	private:
+		struct TEntry
+		{
+			int    nType;
+			void*  pObject;
+			size_t nSize;
+			std::list<std::string>::iterator itLRU;
+		};
+
+		CLRUCache(const CLRUCache&);
+		CLRUCache& operator=(const CLRUCache&);
+
+		void Shrink(size_t nLimit)
+		{
+			while (m_nSize > nLimit && !m_lLRU.empty())
+			{
+				std::map<std::string, TEntry>::iterator oPos = m_mEntries.find(m_lLRU.back());
+				m_nSize -= oPos->second.nSize;
+				Release(oPos->second.nType, oPos->second.pObject);
+				m_mEntries.erase(oPos);
+				m_lLRU.pop_back();
+			}
+		}
+
+		std::map<std::string, TEntry>       m_mEntries;
+		std::list<std::string>              m_lLRU; // В начале - недавно использованные
+		size_t                              m_nSize;
+		size_t                              m_nLimit;
+		NSCriticalSection::CRITICAL_SECTION m_oCS;
+	};
+}
+
+#endif // _PDF_READER_LRU_CACHE_H
@@ -293,15 +293,16 @@ namespace PdfReader
 
 		bool bResult = (NULL != (pEntry = Lookup(oRef)));
 
+		RELEASEOBJECT(pCS);
+
 		if (bResult)
 		{
-			// Шрифт нашелся, но пока им пользоваться нельзя, потому что он загружается в параллельном потоке
+			// Шрифт нашелся, но пока им пользоваться нельзя, потому что он загружается в параллельном потоке.
+			// Ждем вне критической секции, чтобы не останавливать поиск других шрифтов
 			while (!pEntry->bAvailable)
 				NSThreads::Sleep(10);
 		}
 
-		RELEASEOBJECT(pCS);
-
 		return bResult;
 	}
 	bool CPdfFontList::Find2(Ref oRef, TFontEntry** ppEntry)
@@ -310,13 +311,6 @@ namespace PdfReader
 
 		bool bResult = (NULL != ((*ppEntry) = Lookup(oRef)));
 
-		if (bResult)
-		{
-			// Шрифт нашелся, но пока им пользоваться нельзя, потому что он загружается в параллельном потоке
-			while (!(*ppEntry)->bAvailable)
-				NSThreads::Sleep(10);
-		}
-
 		if (!bResult)
 		{
 			(*ppEntry) = Add(oRef, std::wstring(), NULL, NULL, 0, 0);
@@ -325,6 +319,13 @@ namespace PdfReader
 
 		RELEASEOBJECT(pCS);
 
+		if (bResult)
+		{
+			// Шрифт нашелся, но пока им пользоваться нельзя, потому что он загружается в параллельном потоке
+			while (!(*ppEntry)->bAvailable)
+				NSThreads::Sleep(10);
+		}
+
 		return bResult;
 	}
 	TFontEntry* CPdfFontList::Add(Ref oRef, const std::wstring& wsFileName, int* pCodeToGID, int* pCodeToUnicode, unsigned int unLenGID, unsigned int unLenUnicode)
@@ -347,6 +348,8 @@ namespace PdfReader
 	}
 	void CPdfFontList::Remove(Ref oRef)
 	{
+		CTemporaryCS oCS(&m_oCS);
+
 		CRefFontMap::iterator oPos = m_oFontMap.find(oRef);
 		if (m_oFontMap.end() != oPos)
 		{
@@ -376,6 +379,8 @@ namespace PdfReader
 	}
 	bool CPdfFontList::GetFont(Ref* pRef, TFontEntry* pEntry)
 	{
+		CTemporaryCS oCS(&m_oCS);
+
 		TFontEntry* pFindEntry = Lookup(*pRef);
 		if (NULL == pFindEntry)
 			return false;
@@ -903,10 +908,13 @@ namespace PdfReader
 				oMemoryFontStream.load(oStreamObject);
 				NSFonts::NSApplicationFontStream::GetGlobalMemoryStorage()->Add(wsTempFileName, oMemoryFontStream.m_pData, (LONG)oMemoryFontStream.m_nSize, true);
 #else
-				int nChar;
-				while ((nChar = oStreamObject.streamGetChar()) != EOF)
+				// Раскодированный шрифт берется из общего кэша (CFontCache), если такой уже встречался
+				int nFontLen = 0;
+				char* pFontBuf = pFont->readEmbFontFile(pXref, &nFontLen);
+				if (pFontBuf)
 				{
-					fputc(nChar, pTempFile);
+					fwrite(pFontBuf, 1, nFontLen, pTempFile);
+					gfree(pFontBuf);
 				}
 				fclose(pTempFile);
 #endif
@@ -1694,6 +1702,7 @@ namespace PdfReader
 
 		RendererOutputDev* m_pRendererOut = new RendererOutputDev(pRenderer, m_pFontManager, m_pFontList);
 		m_pRendererOut->NewPDF(gfx->getDoc()->getXRef());
+		m_pRendererOut->AddRedact(m_arrRedactBox);
 
 		Gfx* m_gfx = new Gfx(gfx->getDoc(), m_pRendererOut, -1, pResourcesDict, dDpiX, dDpiY, &box, NULL, 0);
 		m_gfx->display(pStream);
@@ -2386,7 +2395,7 @@ namespace PdfReader
 		Transform(pGState->getCTM(), dX + dDx, dY + dDy, &endX, &endY);
 		double dCenterX = (startX + endX) / 2;
 		double dCenterY = (startY + endY) / 2;
-		if (((GlobalParamsAdaptor*)globalParams)->InRedact(dCenterX, dCenterY))
+		if (GlobalParamsAdaptor::InRedact(m_arrRedactBox, dCenterX, dCenterY))
 			return;
 
 		double* pCTM   = pGState->getCTM();
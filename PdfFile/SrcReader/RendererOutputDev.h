@@ -42,6 +42,8 @@
 
 #include "GfxClip.h"
 #include <stack>
+#include <vector>
+#include <atomic>
 
 namespace PdfReader
 {
@@ -54,8 +56,27 @@ namespace PdfReader
 		int*         pCodeToUnicode; // Таблица код - юникодное значение
 		unsigned int unLenGID;
 		unsigned int unLenUnicode;
-		bool         bAvailable;     // Доступен ли шрифт. Сделано для многопотоковости
-		
+		std::atomic<bool> bAvailable; // Доступен ли шрифт. Сделано для многопотоковости
+
+		TFontEntry() : pCodeToGID(NULL), pCodeToUnicode(NULL), unLenGID(0), unLenUnicode(0), bAvailable(false)
+		{
+		}
+		TFontEntry(const TFontEntry& oOther) : bAvailable(false)
+		{
+			*this = oOther;
+		}
+		// Копия (GetFont) получает снимок полей, флаг читается атомарно
+		TFontEntry& operator=(const TFontEntry& oOther)
+		{
+			wsFilePath     = oOther.wsFilePath;
+			wsFontName     = oOther.wsFontName;
+			pCodeToGID     = oOther.pCodeToGID;
+			pCodeToUnicode = oOther.pCodeToUnicode;
+			unLenGID       = oOther.unLenGID;
+			unLenUnicode   = oOther.unLenUnicode;
+			bAvailable.store(oOther.bAvailable.load());
+			return *this;
+		}
 	};
 
 	class CPdfFontList
@@ -242,6 +263,11 @@ namespace PdfReader
 		{
 			m_pbBreak = pbBreak;
 		}
+		// Области Redact хранятся в устройстве, а не в globalParams, чтобы разные страницы можно было рисовать параллельно
+		void AddRedact(const std::vector<double>& arrRedactBox)
+		{
+			m_arrRedactBox.insert(m_arrRedactBox.end(), arrRedactBox.begin(), arrRedactBox.end());
+		}
 		static NSFonts::CFontInfo* GetFontByParams(XRef* pXref, NSFonts::IFontManager* pFontManager, GfxFont* pFont, std::wstring& wsFontBaseName);
 		static void GetFont(XRef* pXref, NSFonts::IFontManager* pFontManager, CPdfFontList *pFontList, GfxFont* pFont, std::wstring& wsFileName, std::wstring& wsFontName);
 		static void CheckFontStylePDF(std::wstring& sName, bool& bBold, bool& bItalic);
@@ -295,6 +321,8 @@ namespace PdfReader
 
         bool                          m_bDrawOnlyText; // Special option for html-renderer
 
+		std::vector<double>           m_arrRedactBox;
+
 	};
 }
 
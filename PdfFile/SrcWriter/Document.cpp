@@ -68,6 +68,9 @@ namespace PdfWriter
 {
 	const char* c_sPdfHeader = "%PDF-1.7\015%\315\312\322\251\015";
 	const char* c_sPdfAHeader = "%PDF-1.4\015%\315\312\322\251\015";
+	// Место под заголовок при потоковой записи: PDF/A и DocumentID могут быть заданы
+	// после начала записи, поэтому заголовок переписывается при сохранении
+	const unsigned int c_unStreamingHeaderSize = 512;
 	//----------------------------------------------------------------------------------------
 	// CDocument
 	//----------------------------------------------------------------------------------------
@@ -97,6 +100,7 @@ namespace PdfWriter
 		m_bPDFAConformance	= false;
 		m_pAcroForm         = NULL;
 		m_pFieldsResources  = NULL;
+		m_pOutputStream     = NULL;
 	}
 	CDocument::~CDocument()
 	{
@@ -180,6 +184,10 @@ namespace PdfWriter
 	}
     void CDocument::Close()
 	{
+		// Несохраненный файл потоковой записи не является корректным PDF
+		if (m_pOutputStream)
+			StopStreaming();
+
 		// Все объекты удаляются внутри CXref
 		RELEASEOBJECT(m_pXref);
 
@@ -222,6 +230,41 @@ namespace PdfWriter
 	}
 	bool CDocument::SaveToFile(const std::wstring& wsPath)
 	{
+		if (m_pOutputStream)
+		{
+			// Уже записанные объекты не зашифрованы
+			std::string sHeader = GetHeader();
+			if (m_bEncrypt || sHeader.length() + 3 > c_unStreamingHeaderSize)
+			{
+				StopStreaming();
+				return false;
+			}
+
+			if (m_pJbig2)
+				m_pJbig2->FlushStreams();
+
+			SaveToStream(m_pOutputStream);
+
+			m_pOutputStream->Seek(0, SeekSet);
+			WriteStreamingHeader(m_pOutputStream, sHeader);
+			RELEASEOBJECT(m_pOutputStream);
+
+			std::wstring wsOutputPath = m_wsOutputPath;
+			m_wsOutputPath.clear();
+
+			if (wsPath != wsOutputPath)
+			{
+				bool bCopied = NSFile::CFileBinary::Copy(wsOutputPath, wsPath);
+				NSFile::CFileBinary::Remove(wsOutputPath);
+				if (!bCopied)
+					return false;
+			}
+
+			Sign(wsPath, m_pXref->GetSizeXRef());
+
+			return true;
+		}
+
 		CFileStream* pStream = new CFileStream();
 		if (!pStream || !pStream->OpenFile(wsPath, true))
 			return false;
@@ -238,6 +281,9 @@ namespace PdfWriter
 	}
 	bool CDocument::SaveToMemory(BYTE** pData, int* pLength)
 	{
+		if (m_pOutputStream)
+			return false;
+
 		CMemoryStream* pStream = new CMemoryStream();
 		if (!pStream)
 			return false;
@@ -253,22 +299,68 @@ namespace PdfWriter
 		pStream->ClearWithoutAttack();
 		return true;
 	}
-    void CDocument::SaveToStream(CStream* pStream)
+	bool CDocument::StartStreaming(const std::wstring& wsPath)
 	{
-		m_pCatalog->AddMetadata(m_pXref, m_pInfo);
+		// Законченные страницы сразу пишутся в файл, в памяти остаются таблица xref,
+		// словари страниц и общие ресурсы (шрифты дописываются при сохранении)
+		if (!m_pXref || m_pOutputStream || m_bEncrypt || GetHeader().length() + 3 > c_unStreamingHeaderSize)
+			return false;
 
-		// Пишем заголовок
-		if (IsPDFA())
-			pStream->WriteStr(c_sPdfAHeader);
-		else
-			pStream->WriteStr(c_sPdfHeader);
-		
-		if (false == m_wsDocumentID.empty())
+		CFileStream* pStream = new CFileStream();
+		if (!pStream->OpenFile(wsPath, true))
 		{
-			std::string sDocumentID = "%DocumentID " + NSFile::CUtf8Converter::GetUtf8StringFromUnicode(m_wsDocumentID);
-			pStream->WriteStr(sDocumentID.c_str());
+			delete pStream;
+			return false;
 		}
 
+		// Окончательный заголовок пишется на это место в SaveToFile
+		WriteStreamingHeader(pStream, GetHeader());
+
+		m_pOutputStream = pStream;
+		m_wsOutputPath  = wsPath;
+		return true;
+	}
+	bool CDocument::IsStreaming() const
+	{
+		return NULL != m_pOutputStream;
+	}
+	void CDocument::StopStreaming()
+	{
+		RELEASEOBJECT(m_pOutputStream);
+		if (!m_wsOutputPath.empty())
+			NSFile::CFileBinary::Remove(m_wsOutputPath);
+		m_wsOutputPath.clear();
+	}
+	std::string CDocument::GetHeader() const
+	{
+		std::string sHeader = IsPDFA() ? c_sPdfAHeader : c_sPdfHeader;
+
+		if (false == m_wsDocumentID.empty())
+			sHeader += "%DocumentID " + NSFile::CUtf8Converter::GetUtf8StringFromUnicode(m_wsDocumentID);
+
+		return sHeader;
+	}
+    void CDocument::WriteHeader(CStream* pStream)
+	{
+		pStream->WriteStr(GetHeader().c_str());
+	}
+	void CDocument::WriteStreamingHeader(CStream* pStream, const std::string& sHeader)
+	{
+		// Заголовок дополняется комментарием до фиксированного размера c_unStreamingHeaderSize
+		std::string sBlock = sHeader + "\015%";
+		if (sBlock.length() < c_unStreamingHeaderSize)
+			sBlock.append(c_unStreamingHeaderSize - 1 - sBlock.length(), ' ');
+		sBlock += "\015";
+		pStream->Write((const BYTE*)sBlock.c_str(), (unsigned int)sBlock.length());
+	}
+    void CDocument::SaveToStream(CStream* pStream)
+	{
+		m_pCatalog->AddMetadata(m_pXref, m_pInfo);
+
+		// Пишем заголовок (при потоковой записи он уже записан)
+		if (pStream != m_pOutputStream)
+			WriteHeader(pStream);
+
 		// Добавляем в Trailer необходимые элементы 
 		m_pTrailer->Add("Root", m_pCatalog);
 		m_pTrailer->Add("Info", m_pInfo);
@@ -354,6 +446,9 @@ namespace PdfWriter
 	}
     CPage* CDocument::AddPage()
 	{
+		if (m_pOutputStream && m_pCurPage)
+			m_pCurPage->Flush(m_pXref, m_pOutputStream);
+
 		CPage* pPage = new CPage(m_pXref, m_pPageTree, this);
 		m_pPageTree->AddPage(pPage);
 		m_pCurPage = pPage;
@@ -107,6 +107,9 @@ namespace PdfWriter
 		void              Close();
 		bool              SaveToFile(const std::wstring& wsPath);
 		bool              SaveToMemory(BYTE** pData, int* pLength);
+		bool              StartStreaming(const std::wstring& wsPath);
+		bool              IsStreaming() const;
+		void              StopStreaming();
 		bool              SaveNewWithPassword(CXref* pXref, CXref* _pXref, const std::wstring& wsPath, const std::wstring& wsOwnerPassword, const std::wstring& wsUserPassword, CDictObject* pTrailer);
 			              
         void              SetPasswords(const std::wstring & wsOwnerPassword, const std::wstring & wsUserPassword);
@@ -220,6 +223,9 @@ namespace PdfWriter
         FT_Library        GetFreeTypeLibrary();
 		CExtGrState*      FindExtGrState(double dAlphaStroke = -1, double dAlphaFill = -1, EBlendMode eMode = blendmode_Unknown, int nStrokeAdjustment = -1);
 		void              SaveToStream(CStream* pStream);
+		std::string       GetHeader() const;
+		void              WriteHeader(CStream* pStream);
+		void              WriteStreamingHeader(CStream* pStream, const std::string& sHeader);
 		void              PrepareEncryption();
 		CDictObject*      CreatePageLabel(EPageNumStyle eStyle, unsigned int unFirstPage, const char* sPrefix);
 		CShading*         CreateShading(CPage* pPage, double *pPattern, bool bAxial, unsigned char* pColors, unsigned char* pAlphas, double* pPoints, int nCount, CExtGrState*& pExtGrState);
@@ -306,6 +312,8 @@ namespace PdfWriter
 		FT_Library                         m_pFreeTypeLibrary;
 		bool                               m_bPDFAConformance;
 		std::wstring                       m_wsDocumentID;
+		CStream*                           m_pOutputStream; // файл потоковой записи
+		std::wstring                       m_wsOutputPath;
 		CDictObject*                       m_pAcroForm;
 		CResourcesDict*                    m_pFieldsResources;
 		std::vector<CRadioGroupField*>     m_vRadioGroups;
@@ -105,6 +105,7 @@ namespace PdfWriter
 		case object_type_DICT:   pStream->Write((CDictObject*)this, pEncrypt); break;
 		case object_type_BOOLEAN:pStream->Write((CBoolObject*)this); break;
 		case object_type_NULL:   pStream->WriteStr("null"); break;
+		case object_type_RAW:    ((CRawObject*)this)->WriteToStream(pStream, pEncrypt); break;
 		}
 	}
 	void CObjectBase::Write     (CStream* pStream, CEncrypt* pEncrypt)
@@ -290,6 +291,77 @@ namespace PdfWriter
 			m_pObject = NULL;
 	}
 	//----------------------------------------------------------------------------------------
+	// CRawObject
+	//----------------------------------------------------------------------------------------
+	CRawObject::CRawObject(BYTE* pBody, unsigned int unBodyLen, CStream* pStream)
+	{
+		m_pBody     = pBody;
+		m_unBodyLen = unBodyLen;
+		m_pStream   = pStream;
+	}
+	CRawObject::~CRawObject()
+	{
+		for (int i = 0; i < m_arrRefs.size(); ++i)
+			RELEASE_OBJECT(m_arrRefs[i].pRef);
+		RELEASEARRAYOBJECTS(m_pBody);
+		RELEASEOBJECT(m_pStream);
+	}
+	void CRawObject::AddRef(unsigned int unOffset, unsigned int unLen, CObjectBase* pObject)
+	{
+		TRawRef oRef = { unOffset, unLen, pObject ? new CProxyObject(pObject) : NULL, false };
+		m_arrRefs.push_back(oRef);
+	}
+	void CRawObject::SetLength(unsigned int unOffset, unsigned int unLen)
+	{
+		TRawRef oRef = { unOffset, unLen, NULL, true };
+		m_arrRefs.push_back(oRef);
+	}
+	void CRawObject::WriteToStream(CStream* pStream, CEncrypt* pEncrypt)
+	{
+		// Length зависит от шифрования, поэтому данные готовятся до записи словаря
+		CStream* pData = m_pStream;
+		CMemoryStream* pEncrypted = NULL;
+		if (pEncrypt && m_pStream)
+		{
+			pEncrypt->Reset();
+			pEncrypted = new CMemoryStream();
+			pEncrypted->WriteStream(m_pStream, STREAM_FILTER_NONE, pEncrypt);
+			pData = pEncrypted;
+		}
+
+		unsigned int unPos = 0;
+		for (int i = 0; i < m_arrRefs.size(); ++i)
+		{
+			const TRawRef& oRef = m_arrRefs[i];
+			pStream->Write(m_pBody + unPos, oRef.unOffset - unPos);
+			if (oRef.bLength)
+			{
+				pStream->WriteStr(" /Length ");
+				pStream->WriteUInt(pData ? pData->Size() : 0);
+			}
+			else
+			{
+				CObjectBase* pObject = oRef.pRef ? oRef.pRef->Get() : NULL;
+				pStream->WriteChar(' ');
+				if (pObject && pObject->IsIndirect())
+					oRef.pRef->Write(pStream, NULL);
+				else
+					pStream->WriteStr("null");
+			}
+			unPos = oRef.unOffset + oRef.unLen;
+		}
+		pStream->Write(m_pBody + unPos, m_unBodyLen - unPos);
+
+		if (pData)
+		{
+			pStream->WriteStr("\012stream\015\012");
+			pStream->WriteStream(pData, STREAM_FILTER_NONE, NULL);
+			pStream->WriteStr("\012endstream");
+		}
+
+		RELEASEOBJECT(pEncrypted);
+	}
+	//----------------------------------------------------------------------------------------
 	// CArrayObject
 	//----------------------------------------------------------------------------------------
     void CArrayObject::Add(CObjectBase* pObject, bool bPushBack)
@@ -798,6 +870,7 @@ namespace PdfWriter
 		m_unAddr        = 0;
 		m_pPrev         = NULL;
 		m_pTrailer      = NULL;
+		m_unNumbered    = 0;
 
 		if (0 == m_unStartOffset)
 		{
@@ -808,6 +881,7 @@ namespace PdfWriter
 			pEntry->unByteOffset = 0;
 			pEntry->unGenNo      = MAX_GENERATION_NUM;
 			pEntry->pObject      = NULL;
+			pEntry->bWritten     = false;
 			m_arrEntries.push_back(pEntry);
 		}
 
@@ -820,6 +894,7 @@ namespace PdfWriter
 		m_unAddr        = 0;
 		m_pPrev         = NULL;
 		m_pTrailer      = NULL;
+		m_unNumbered    = 0;
 
 		// Добавляем удаляемый элемент в таблицу xref
 		// он должен иметь вид 0000000000 gen+1 f
@@ -828,6 +903,7 @@ namespace PdfWriter
 		pEntry->unByteOffset = 0;
 		pEntry->unGenNo      = unRemoveGen + 1 > MAX_GENERATION_NUM ? MAX_GENERATION_NUM : unRemoveGen + 1;
 		pEntry->pObject      = NULL;
+		pEntry->bWritten     = false;
 		m_arrEntries.push_back(pEntry);
 
 		m_pTrailer = new CDictObject();
@@ -929,6 +1005,7 @@ namespace PdfWriter
 		pEntry->unByteOffset = 0;
 		pEntry->unGenNo      = 0;
 		pEntry->pObject      = pObject;
+		pEntry->bWritten     = false;
 		pObject->SetIndirect();
 		pObject->SetXrefEntry(pEntry);
 	}
@@ -960,6 +1037,7 @@ namespace PdfWriter
 		pEntry->unByteOffset = 0;
 		pEntry->unGenNo      = unObjectGen;
 		pEntry->pObject      = pObject;
+		pEntry->bWritten     = false;
 		pObject->SetRef(m_unStartOffset + m_arrEntries.size() - 1, pEntry->unGenNo);
 		pObject->SetIndirect();
 		pObject->SetXrefEntry(pEntry);
@@ -981,6 +1059,16 @@ namespace PdfWriter
 				if (pObject)
 					delete pObject;
 
+				// После потоковой записи номера объектов менять нельзя, запись только освобождаем
+				if (unIndex < m_unNumbered)
+				{
+					pEntry->nEntryType = FREE_ENTRY;
+					pEntry->unGenNo    = 1;
+					pEntry->pObject    = NULL;
+					pEntry->pRefObj.clear();
+					break;
+				}
+
 				m_arrEntries.erase(m_arrEntries.begin() + unIndex);
 				delete pEntry;
 				break;
@@ -1004,6 +1092,67 @@ namespace PdfWriter
 		pStream->WriteUInt(m_unAddr);
 		pStream->WriteStr("\012%%EOF\012");
 	}
+    void CXref::WriteEntry(CStream* pStream, CEncrypt* pEncrypt, TXrefEntry* pEntry, unsigned int unObjId)
+	{
+		char sBuf[SHORT_BUFFER_SIZE];
+		char* pBuf = sBuf;
+		char* pEndPtr = sBuf + SHORT_BUFFER_SIZE - 1;
+
+		unsigned int unGenNo = pEntry->unGenNo;
+
+		pEntry->unByteOffset = pStream->Tell();
+
+		if (pEncrypt)
+			pEncrypt->InitKey(unObjId, unGenNo);
+
+		pBuf = ItoA(pBuf, unObjId, pEndPtr);
+		*pBuf++ = ' ';
+		pBuf = ItoA(pBuf, unGenNo, pEndPtr);
+		StrCpy(pBuf, " obj\012", pEndPtr);
+
+		pStream->WriteStr(sBuf);
+		pEntry->pObject->WriteValue(pStream, pEncrypt);
+		pStream->WriteStr("\012endobj\012");
+	}
+    void CXref::Flush(CObjectBase* pObject, CStream* pStream)
+	{
+		// Только для нового документа: номер объекта равен его индексу в таблице,
+		// поэтому номера, попавшие в файл, дальше не меняются
+		if (!pObject || m_pPrev || 0 != m_unStartOffset)
+			return;
+
+		TXrefEntry* pEntry = pObject->GetXrefEntry();
+		if (!pEntry || IN_USE_ENTRY != pEntry->nEntryType || pEntry->bWritten)
+			return;
+
+		for (unsigned int unCount = m_arrEntries.size(); m_unNumbered < unCount; ++m_unNumbered)
+		{
+			TXrefEntry* pCur = m_arrEntries.at(m_unNumbered);
+			if (pCur->nEntryType != FREE_ENTRY && pCur->pObject->GetObjId() == 0)
+				pCur->pObject->SetRef(m_unNumbered, pCur->unGenNo);
+		}
+
+		WriteEntry(pStream, NULL, pEntry, pObject->GetObjId());
+		pEntry->bWritten = true;
+
+		if (object_type_DICT == pObject->GetType())
+		{
+			CDictObject* pDict = (CDictObject*)pObject;
+
+			// Length известна только после записи потока
+			CObjectBase* pLength = pDict->Get("Length");
+			if (pLength && pLength->IsIndirect())
+				Flush(pLength, pStream);
+
+			// Данные потока больше не нужны, в памяти остается только словарь
+			CStream* pData = pDict->GetStream();
+			if (pData)
+			{
+				pDict->SetStream(NULL);
+				delete pData;
+			}
+		}
+	}
     void CXref::WriteToStream(CStream* pStream, CEncrypt* pEncrypt, bool bStream)
 	{
 		char sBuf[SHORT_BUFFER_SIZE];
@@ -1035,25 +1184,9 @@ namespace PdfWriter
 						pNextFreeObj->unByteOffset = pXref->m_unStartOffset + unIndex;
 					pNextFreeObj = pEntry;
 				}
-				else
+				else if (!pEntry->bWritten)
 				{
-					unsigned int unObjId = pXref->m_unStartOffset + unIndex;
-					unsigned int unGenNo = pEntry->unGenNo;
-
-					pEntry->unByteOffset = pStream->Tell();
-
-					if (pEncrypt)
-						pEncrypt->InitKey(unObjId, unGenNo);
-
-					pBuf = sBuf;
-					pBuf = ItoA(pBuf, unObjId, pEndPtr);
-					*pBuf++ = ' ';
-					pBuf = ItoA(pBuf, unGenNo, pEndPtr);
-					StrCpy(pBuf, " obj\012", pEndPtr);
-
-					pStream->WriteStr(sBuf);
-					pEntry->pObject->WriteValue(pStream, pEncrypt);
-					pStream->WriteStr("\012endobj\012");
+					WriteEntry(pStream, pEncrypt, pEntry, pXref->m_unStartOffset + unIndex);
 				}
 			}
 			pXref = pXref->m_pPrev;
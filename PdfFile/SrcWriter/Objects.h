@@ -60,6 +60,7 @@ namespace PdfWriter
 		object_type_ARRAY       = 0x10,
 		object_type_DICT        = 0x11,
 		object_type_PROXY       = 0x12,
+		object_type_RAW         = 0x13,
 		object_type_PATTERN_REF = 0xFA,
 		object_type_FUNC_REF	= 0xF2,
 		object_type_MASK_FORM   = 0xF3,
@@ -501,6 +502,35 @@ namespace PdfWriter
 		unsigned int                        m_unPredictor;
 		CStream*                            m_pStream;
 	};
+	class CRawObject : public CObjectBase
+	{
+	public:
+		// Тело объекта копируется из исходного файла как есть,
+		// при записи заменяются только ссылки "N G R" и значение Length
+		CRawObject(BYTE* pBody, unsigned int unBodyLen, CStream* pStream);
+		virtual ~CRawObject();
+		EObjectType GetType() const
+		{
+			return object_type_RAW;
+		}
+		void AddRef(unsigned int unOffset, unsigned int unLen, CObjectBase* pObject);
+		void SetLength(unsigned int unOffset, unsigned int unLen);
+		void WriteToStream(CStream* pStream, CEncrypt* pEncrypt);
+
+	private:
+		struct TRawRef
+		{
+			unsigned int  unOffset;
+			unsigned int  unLen;
+			CProxyObject* pRef;
+			bool          bLength;
+		};
+
+		BYTE*                m_pBody;
+		unsigned int         m_unBodyLen;
+		CStream*             m_pStream;
+		std::vector<TRawRef> m_arrRefs;
+	};
 	struct TXrefEntry
 	{
 		char         nEntryType;
@@ -508,6 +538,7 @@ namespace PdfWriter
 		unsigned int unGenNo;
 		CObjectBase* pObject;
 		std::vector<CProxyObject*> pRefObj;
+		bool         bWritten; // объект уже записан потоковой записью
 	};
 	class CXref
 	{
@@ -524,6 +555,7 @@ namespace PdfWriter
 		void         Add(CObjectBase* pObject, unsigned int unObjectGen);
 		void         Remove(CObjectBase* pObject);
 		void         WriteToStream(CStream* pStream, CEncrypt* pEncrypt, bool bStream = false);
+		void         Flush(CObjectBase* pObject, CStream* pStream);
 		void         SetPrev(CXref* pPrev)
 		{
 			m_pPrev  = pPrev;
@@ -553,6 +585,7 @@ namespace PdfWriter
 	private:
 
 		void        WriteTrailer(CStream* pStream);
+		void        WriteEntry(CStream* pStream, CEncrypt* pEncrypt, TXrefEntry* pEntry, unsigned int unObjId);
 
 	private:
 		std::vector<TXrefEntry*> m_arrEntries;
@@ -561,6 +594,7 @@ namespace PdfWriter
 		CXref*                   m_pPrev;
 		CDictObject*             m_pTrailer;
 		CDocument*               m_pDocument;
+		unsigned int             m_unNumbered; // объекты с номерами, зафиксированными потоковой записью
 	};
 }
 
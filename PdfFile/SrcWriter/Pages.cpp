@@ -406,7 +406,7 @@ namespace PdfWriter
 				m_pContents->Add(pNewContents);
 				Add("Contents", m_pContents);
 			}
-			else if (pContents->GetType() == object_type_DICT)
+			else if (pContents->GetType() == object_type_DICT || pContents->GetType() == object_type_RAW)
 			{
 				m_pContents = new CArrayObject();
 				m_pContents->Add(pContents);
@@ -1664,6 +1664,58 @@ namespace PdfWriter
 		SetFilter(STREAM_FILTER_FLATE_DECODE);
 #endif
 	}
+	void CPage::Flush(CXref* pXref, CStream* pStream)
+	{
+		// Страница закончена: содержимое и картинки пишем сразу, в памяти остается только словарь страницы
+		BeforeWrite();
+
+		if (m_pContents)
+		{
+			for (int i = 0; i < m_pContents->GetCount(); ++i)
+			{
+				CObjectBase* pObj = m_pContents->Get(i);
+				if (pObj && pObj->GetType() == object_type_DICT)
+					pXref->Flush(pObj, pStream);
+			}
+		}
+		m_pStream = NULL;
+
+		CResourcesDict* pResources = GetResourcesItem();
+		CObjectBase* pXObjects = pResources ? pResources->Get("XObject") : NULL;
+		if (!pXObjects || pXObjects->GetType() != object_type_DICT)
+			return;
+
+		auto IsImage = [](CObjectBase* pObj)
+		{
+			if (!pObj || pObj->GetType() != object_type_DICT || ((CDictObject*)pObj)->GetDictType() != dict_type_XOBJECT)
+				return false;
+
+			// JBIG2 потоки заполняются только при сохранении документа
+			if (((CDictObject*)pObj)->GetFilter() & STREAM_FILTER_JBIG2_DECODE)
+				return false;
+
+			CObjectBase* pSubtype = ((CDictObject*)pObj)->Get("Subtype");
+			return pSubtype && pSubtype->GetType() == object_type_NAME && 0 == StrCmp(((CNameObject*)pSubtype)->Get(), "Image");
+		};
+
+		for (auto const &oIter : ((CDictObject*)pXObjects)->GetDict())
+		{
+			CObjectBase* pObj = oIter.second;
+			if (pObj && object_type_PROXY == pObj->GetType())
+				pObj = ((CProxyObject*)pObj)->Get();
+
+			if (!IsImage(pObj))
+				continue;
+
+			CObjectBase* pSMask = ((CDictObject*)pObj)->Get("SMask");
+			CObjectBase* pMask  = ((CDictObject*)pObj)->Get("Mask");
+			pXref->Flush(pObj, pStream);
+			if (IsImage(pSMask))
+				pXref->Flush(pSMask, pStream);
+			if (IsImage(pMask))
+				pXref->Flush(pMask, pStream);
+		}
+	}
 	void CPage::ClearContentFull(CXref* pXref)
 	{
 		if (m_pContents)
@@ -193,6 +193,7 @@ namespace PdfWriter
         int       GetRotate();
 		void      ClearContent(CXref* pXref);
 		void      ClearContentFull(CXref* pXref);
+		void      Flush(CXref* pXref, CStream* pStream);
 		CResourcesDict* GetResourcesItem();
 
 	private:
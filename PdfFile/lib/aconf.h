@@ -55,8 +55,11 @@
 
 /*
  * Enable multithreading support.
+ * Нужно для одновременной отрисовки разных страниц одного PDFDoc (см. CPdfFile::DrawPageOnRenderer)
  */
-//#define MULTITHREADED
+#ifndef BUILDING_WASM_MODULE
+#define MULTITHREADED 1
+#endif
 
 /*
  * Enable C++ exceptions.
@@ -28,6 +28,7 @@
 #include "CMap.h"
 
 #include "../../SrcReader/Adaptors.h"
+#include "../../SrcReader/FontCache.h"
 
 //------------------------------------------------------------------------
 
@@ -83,6 +84,15 @@ CMap *CMap::parse(CMapCache *cache, GString *collectionA,
     char* pDataCMap = NULL;
     unsigned int nSizeCMap = 0;
     if (((GlobalParamsAdaptor*)globalParams)->GetCMap(cMapNameA->getCString(), pDataCMap, nSizeCMap)) {
+      // parsed CMaps are shared through the process-wide font cache
+      // (unless it is disabled)
+      std::string sKey;
+      if (PdfReader::CFontCache::GetInstance()->GetLimit() > 0) {
+        sKey = PdfReader::CFontCache::GetKey("CMap", pDataCMap, (int)nSizeCMap,
+                                             std::string(collectionA->getCString()) + '/' + cMapNameA->getCString());
+        if ((cMap = PdfReader::CFontCache::GetInstance()->GetCMap(sKey)))
+          return cMap;
+      }
       Object obj;
       obj.initNull();
       BaseStream *str = new MemStream(pDataCMap, 0, nSizeCMap, &obj);
@@ -91,6 +101,9 @@ CMap *CMap::parse(CMapCache *cache, GString *collectionA,
       cMap = new CMap(collectionA->copy(), cMapNameA->copy());
       cMap->parse2(cache, &getCharFromStream, str);
       delete str;
+      if (!sKey.empty()) {
+        PdfReader::CFontCache::GetInstance()->AddCMap(sKey, cMap, cMap->getMemorySize());
+      }
       return cMap;
     }
   }
@@ -122,17 +135,52 @@ CMap *CMap::parse(CMapCache *cache, GString *collectionA,
 CMap *CMap::parse(CMapCache *cache, GString *collectionA, Stream *str) {
   Object obj1;
   CMap *cMap;
+  GString *buf;
+  std::string sKey;
+  char buf2[4096];
+  int n;
+
+  // embedded CMaps are shared through the process-wide font cache, keyed
+  // by the stream data, the collection and the UseCMap name; with the
+  // cache disabled the stream is parsed directly, without the copy
+  buf = NULL;
+  str->getDict()->lookup("UseCMap", &obj1);
+  if ((obj1.isNull() || obj1.isName()) &&
+      PdfReader::CFontCache::GetInstance()->GetLimit() > 0) {
+    buf = new GString();
+    str->reset();
+    while ((n = str->getBlock(buf2, sizeof(buf2))) > 0) {
+      buf->append(buf2, n);
+    }
+    str->close();
+    sKey = PdfReader::CFontCache::GetKey("CMapStream", buf->getCString(), buf->getLength(),
+                                         std::string(collectionA->getCString()) + '/' + (obj1.isName() ? obj1.getName() : ""));
+    if ((cMap = PdfReader::CFontCache::GetInstance()->GetCMap(sKey))) {
+      obj1.free();
+      delete buf;
+      return cMap;
+    }
+  }
 
   cMap = new CMap(collectionA->copy(), NULL);
 
-  if (!str->getDict()->lookup("UseCMap", &obj1)->isNull()) {
+  if (!obj1.isNull()) {
     cMap->useCMap(cache, &obj1);
   }
   obj1.free();
 
-  str->reset();
-  cMap->parse2(cache, &getCharFromStream, str);
-  str->close();
+  if (buf) {
+    obj1.initNull();
+    MemStream *memStr = new MemStream(buf->getCString(), 0, buf->getLength(), &obj1);
+    cMap->parse2(cache, &getCharFromStream, memStr);
+    delete memStr;
+    PdfReader::CFontCache::GetInstance()->AddCMap(sKey, cMap, cMap->getMemorySize());
+    delete buf;
+  } else {
+    str->reset();
+    cMap->parse2(cache, &getCharFromStream, str);
+    str->close();
+  }
   return cMap;
 }
 
@@ -350,6 +398,35 @@ void CMap::freeCMapVector(CMapVectorEntry *vec) {
   gfree(vec);
 }
 
+size_t CMap::getMemorySize() {
+  size_t size;
+
+  size = sizeof(CMap);
+  if (collection) {
+    size += collection->getLength();
+  }
+  if (cMapName) {
+    size += cMapName->getLength();
+  }
+  if (vector) {
+    size += getCMapVectorSize(vector);
+  }
+  return size;
+}
+
+size_t CMap::getCMapVectorSize(CMapVectorEntry *vec) {
+  size_t size;
+  int i;
+
+  size = 256 * sizeof(CMapVectorEntry);
+  for (i = 0; i < 256; ++i) {
+    if (vec[i].isVector) {
+      size += getCMapVectorSize(vec[i].vector);
+    }
+  }
+  return size;
+}
+
 void CMap::incRefCnt() {
 #if MULTITHREADED
   gAtomicIncrement(&refCnt);
@@ -66,6 +66,9 @@ public:
   // Return the writing mode (0=horizontal, 1=vertical).
   int getWMode() { return wMode; }
 
+  // Return the approximate number of bytes used by the parsed CMap.
+  size_t getMemorySize();
+
 private:
 
   void parse2(CMapCache *cache, int (*getCharFunc)(void *), void *data);
@@ -76,6 +79,7 @@ private:
   void copyVector(CMapVectorEntry *dest, CMapVectorEntry *src);
   void addCIDs(Guint start, Guint end, Guint nBytes, CID firstCID);
   void freeCMapVector(CMapVectorEntry *vec);
+  size_t getCMapVectorSize(CMapVectorEntry *vec);
 
   GString *collection;
   GString *cMapName;
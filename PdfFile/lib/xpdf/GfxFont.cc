@@ -25,6 +25,7 @@
 #include "Error.h"
 #include "Object.h"
 #include "Dict.h"
+#include "XRef.h"
 #include "GlobalParams.h"
 #include "CMap.h"
 #include "CharCodeToUnicode.h"
@@ -36,6 +37,8 @@
 #include "FoFiTrueType.h"
 #include "GfxFont.h"
 
+#include "../../SrcReader/FontCache.h"
+
 //------------------------------------------------------------------------
 
 struct Base14FontMapEntry {
@@ -515,11 +518,13 @@ void GfxFont::readFontDescriptor(XRef *xref, Dict *fontDict) {
 }
 
 CharCodeToUnicode *GfxFont::readToUnicodeCMap(Dict *fontDict, int nBits,
-					      CharCodeToUnicode *ctu) {
+					      CharCodeToUnicode *ctu,
+					      GBool shared) {
   GString *buf;
   Object obj1;
   char buf2[4096];
   int n;
+  std::string sKey;
 
   if (!fontDict->lookup("ToUnicode", &obj1)->isStream()) {
     obj1.free();
@@ -537,6 +542,16 @@ CharCodeToUnicode *GfxFont::readToUnicodeCMap(Dict *fontDict, int nBits,
   obj1.free();
   if (ctu) {
     ctu->mergeCMap(buf, nBits);
+  } else if (shared && PdfReader::CFontCache::GetInstance()->GetLimit() > 0) {
+    sKey = PdfReader::CFontCache::GetKey("ToUnicode", buf->getCString(),
+					 buf->getLength(), nBits == 8 ? "8" : "16");
+    if (!(ctu = PdfReader::CFontCache::GetInstance()->GetToUnicode(sKey))) {
+      ctu = CharCodeToUnicode::parseCMap(buf, nBits);
+      if (ctu) {
+	PdfReader::CFontCache::GetInstance()->AddToUnicode(sKey, ctu,
+	    buf->getLength() + ctu->getLength() * sizeof(Unicode));
+      }
+    }
   } else {
     ctu = CharCodeToUnicode::parseCMap(buf, nBits);
   }
@@ -840,11 +855,61 @@ GfxFontLoc *GfxFont::getExternalFont(GString *path, int fontNum,
   return fontLoc;
 }
 
+// Build the font cache key for an embedded font file: the raw
+// (undecoded) stream data plus its filters.  Returns false for streams
+// with decode parameters, which are not cached.
+static GBool getEmbFontFileKey(Stream *str, std::string &key) {
+  Object obj1, obj2;
+  std::string filters;
+  Stream *rawStr;
+  GString *buf;
+  char buf2[4096];
+  int n, i;
+
+  if (!str->getDict()->lookup("DecodeParms", &obj1)->isNull()) {
+    obj1.free();
+    return gFalse;
+  }
+  obj1.free();
+  str->getDict()->lookup("Filter", &obj1);
+  if (obj1.isName()) {
+    filters = obj1.getName();
+  } else if (obj1.isArray()) {
+    for (i = 0; i < obj1.arrayGetLength(); ++i) {
+      if (!obj1.arrayGet(i, &obj2)->isName()) {
+	obj2.free();
+	obj1.free();
+	return gFalse;
+      }
+      filters += obj2.getName();
+      filters += ' ';
+      obj2.free();
+    }
+  } else if (!obj1.isNull()) {
+    obj1.free();
+    return gFalse;
+  }
+  obj1.free();
+
+  rawStr = str->getUndecodedStream();
+  buf = new GString();
+  rawStr->reset();
+  while ((n = rawStr->getBlock(buf2, sizeof(buf2))) > 0) {
+    buf->append(buf2, n);
+  }
+  rawStr->close();
+  key = PdfReader::CFontCache::GetKey("FontFile", buf->getCString(),
+				      buf->getLength(), filters);
+  delete buf;
+  return gTrue;
+}
+
 char *GfxFont::readEmbFontFile(XRef *xref, int *len) {
   char *buf;
   Object obj1, obj2;
   Stream *str;
   int size, n;
+  std::string sKey;
 
   obj1.initRef(embFontID.num, embFontID.gen);
   obj1.fetch(xref, &obj2);
@@ -857,6 +922,17 @@ char *GfxFont::readEmbFontFile(XRef *xref, int *len) {
   }
   str = obj2.getStream();
 
+  // decoded font files are shared through the process-wide font cache;
+  // the raw data of encrypted files depends on the file key, so those
+  // are never cached; with the cache disabled the raw data is not hashed
+  if (PdfReader::CFontCache::GetInstance()->GetLimit() > 0 &&
+      !xref->isEncrypted() && getEmbFontFileKey(str, sKey) &&
+      (buf = PdfReader::CFontCache::GetInstance()->GetFontFile(sKey, len))) {
+    obj2.free();
+    obj1.free();
+    return buf;
+  }
+
   size = 4096;
   buf = (char *)gmalloc(size);
   *len = 0;
@@ -875,6 +951,10 @@ char *GfxFont::readEmbFontFile(XRef *xref, int *len) {
   } while (n == 4096);
   str->close();
 
+  if (!sKey.empty()) {
+    PdfReader::CFontCache::GetInstance()->AddFontFile(sKey, buf, *len);
+  }
+
   obj2.free();
   obj1.free();
 
@@ -1705,9 +1785,14 @@ GfxCIDFont::GfxCIDFont(XRef *xref, const char *tagA, Ref idA, GString *nameA,
   obj2.free();
   obj1.free();
 
-  // look for a ToUnicode CMap
+  // look for a Unicode-to-Unicode mapping
+  utu = name ? globalParams->getUnicodeToUnicode(name)
+             : (CharCodeToUnicode *)NULL;
+
+  // look for a ToUnicode CMap (it's modified below if there is a
+  // Unicode-to-Unicode mapping, otherwise it can be shared)
   hasKnownCollection = gFalse;
-  if (!(ctu = readToUnicodeCMap(fontDict, 16, NULL))) {
+  if (!(ctu = readToUnicodeCMap(fontDict, 16, NULL, !utu))) {
     ctuUsesCharCode = gFalse;
 
     // use an identity mapping for the "Adobe-Identity" and
@@ -1729,8 +1814,7 @@ GfxCIDFont::GfxCIDFont(XRef *xref, const char *tagA, Ref idA, GString *nameA,
     }
   }
 
-  // look for a Unicode-to-Unicode mapping
-  if (name && (utu = globalParams->getUnicodeToUnicode(name))) {
+  if (utu) {
     if (ctu) {
       if (ctu->isIdentity()) {
 	ctu->decRefCnt();
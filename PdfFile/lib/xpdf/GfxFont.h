@@ -218,8 +218,12 @@ protected:
 
   static GfxFontType getFontType(XRef *xref, Dict *fontDict, Ref *embID);
   void readFontDescriptor(XRef *xref, Dict *fontDict);
+  // If <shared> is set (and <ctu> is NULL), the parsed CMap may be
+  // taken from / put into the process-wide font cache, so the caller
+  // must not modify it.
   CharCodeToUnicode *readToUnicodeCMap(Dict *fontDict, int nBits,
-				       CharCodeToUnicode *ctu);
+				       CharCodeToUnicode *ctu,
+				       GBool shared = gFalse);
   static GfxFontLoc *getExternalFont(GString *path, int fontNum,
 				     double oblique, GBool cid);
 
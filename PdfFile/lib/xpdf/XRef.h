@@ -124,6 +124,7 @@ public:
   // Direct access.
   int getSize() { return size; }
   XRefEntry *getEntry(int i) { return &entries[i]; }
+  GFileOffset getStart() { return start; }
   Object *getTrailerDict() { return &trailerDict; }
 
 private:
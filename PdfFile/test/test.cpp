@@ -39,6 +39,10 @@
 #include "../../DesktopEditor/raster/BgraFrame.h"
 #include "../../DjVuFile/DjVu.h"
 #include "../PdfFile.h"
+#include "../SrcReader/LRUCache.h"
+
+#include <thread>
+#include <cstdlib>
 
 class CPdfFileTest : public testing::Test
 {
@@ -309,6 +313,362 @@ TEST_F(CPdfFileTest, PdfToPdf)
 	pdfFile->SaveToFile(wsDstFile);
 }
 
+TEST_F(CPdfFileTest, StreamingToPdf)
+{
+	std::wstring wsStreamFile = NSFile::GetProcessDirectory() + L"/resStream.pdf";
+	std::wstring wsPlainFile  = NSFile::GetProcessDirectory() + L"/resPlain.pdf";
+	std::wstring wsDocumentID = L"{STREAMING-TEST}";
+
+	// DocumentID задается после начала потоковой записи и должен попасть в заголовок
+	for (int nFile = 0; nFile < 2; ++nFile)
+	{
+		RELEASEOBJECT(pdfFile);
+		pdfFile = new CPdfFile(pApplicationFonts);
+		pdfFile->SetTempDirectory(wsTempDir);
+		pdfFile->CreatePdf();
+
+		if (0 == nFile)
+			ASSERT_TRUE(pdfFile->StartStreaming(wsStreamFile));
+		pdfFile->SetDocumentID(wsDocumentID);
+
+		for (int i = 0; i < 5; ++i)
+		{
+			pdfFile->NewPage();
+			pdfFile->BeginCommand(c_nPageType);
+			pdfFile->put_Width(100 + 10 * i);
+			pdfFile->put_Height(150);
+			DrawSmth();
+			pdfFile->EndCommand(c_nPageType);
+		}
+
+		ASSERT_EQ(0, pdfFile->SaveToFile(0 == nFile ? wsStreamFile : wsPlainFile));
+	}
+
+	std::string sHeader;
+	{
+		BYTE* pData = NULL;
+		DWORD dwSize = 0;
+		ASSERT_TRUE(NSFile::CFileBinary::ReadAllBytes(wsStreamFile, &pData, dwSize));
+		sHeader = std::string((char*)pData, std::min((DWORD)512, dwSize));
+		RELEASEARRAYOBJECTS(pData);
+	}
+	EXPECT_EQ(0, sHeader.find("%PDF-1.7"));
+	EXPECT_NE(std::string::npos, sHeader.find("%DocumentID {STREAMING-TEST}"));
+
+	CPdfFile oStream(pApplicationFonts), oPlain(pApplicationFonts);
+	ASSERT_TRUE(oStream.LoadFromFile(wsStreamFile));
+	ASSERT_TRUE(oPlain.LoadFromFile(wsPlainFile));
+	ASSERT_EQ(oPlain.GetPagesCount(), oStream.GetPagesCount());
+
+	for (int i = 0; i < oPlain.GetPagesCount(); ++i)
+	{
+		double dW1, dH1, dW2, dH2, dDpiX, dDpiY;
+		oPlain.GetPageInfo(i, &dW1, &dH1, &dDpiX, &dDpiY);
+		oStream.GetPageInfo(i, &dW2, &dH2, &dDpiX, &dDpiY);
+		EXPECT_DOUBLE_EQ(dW1, dW2);
+		EXPECT_DOUBLE_EQ(dH1, dH2);
+
+		std::wstring wsPage = std::to_wstring(i) + L".png";
+		oPlain.ConvertToRaster(i, strDirOut + L"/plain" + wsPage, 4);
+		oStream.ConvertToRaster(i, strDirOut + L"/stream" + wsPage, 4);
+
+		CBgraFrame oFrame1, oFrame2;
+		ASSERT_TRUE(oFrame1.OpenFile(strDirOut + L"/plain" + wsPage));
+		ASSERT_TRUE(oFrame2.OpenFile(strDirOut + L"/stream" + wsPage));
+		ASSERT_EQ(oFrame1.get_Width(), oFrame2.get_Width());
+		ASSERT_EQ(oFrame1.get_Height(), oFrame2.get_Height());
+		EXPECT_EQ(0, memcmp(oFrame1.get_Data(), oFrame2.get_Data(), 4 * oFrame1.get_Width() * oFrame1.get_Height()));
+	}
+}
+
+TEST_F(CPdfFileTest, StreamingWithPassword)
+{
+	std::wstring wsStreamFile = NSFile::GetProcessDirectory() + L"/resStreamPassword.pdf";
+
+	pdfFile->CreatePdf();
+	ASSERT_TRUE(pdfFile->StartStreaming(wsStreamFile));
+
+	for (int i = 0; i < 2; ++i)
+	{
+		pdfFile->NewPage();
+		pdfFile->BeginCommand(c_nPageType);
+		pdfFile->put_Width(100);
+		pdfFile->put_Height(150);
+		DrawSmth();
+		pdfFile->EndCommand(c_nPageType);
+	}
+
+	// Уже записанные страницы не зашифрованы, недописанный файл удаляется
+	pdfFile->SetPassword(L"123456");
+	EXPECT_NE(0, pdfFile->SaveToFile(wsStreamFile));
+	EXPECT_FALSE(NSFile::CFileBinary::Exists(wsStreamFile));
+}
+
+TEST_F(CPdfFileTest, ConcurrentRender)
+{
+	std::wstring wsFile = NSFile::GetProcessDirectory() + L"/resConcurrent.pdf";
+	const wchar_t* arrFonts[] = { L"Arial", L"Times New Roman", L"Courier New", L"Verdana" };
+	const int nPages = 4, nThreads = 8, nRasterW = 400, nRasterH = 600;
+
+	// Каждая страница со своим набором шрифтов, чтобы потоки одновременно загружали одни и те же шрифты
+	pdfFile->CreatePdf();
+	for (int i = 0; i < nPages; ++i)
+	{
+		pdfFile->NewPage();
+		pdfFile->BeginCommand(c_nPageType);
+		pdfFile->put_Width(100);
+		pdfFile->put_Height(150);
+		for (int j = 0; j < 4; ++j)
+		{
+			pdfFile->put_FontName(arrFonts[(i + j) % 4]);
+			pdfFile->put_FontSize(12 + j);
+			pdfFile->CommandDrawText(L"Concurrent render " + std::to_wstring(i * 4 + j), 10, 20 + 25 * j, 80, 10);
+		}
+		DrawSmth();
+		pdfFile->EndCommand(c_nPageType);
+	}
+	ASSERT_EQ(0, pdfFile->SaveToFile(wsFile));
+
+	CPdfFile oReader(pApplicationFonts);
+	ASSERT_TRUE(oReader.LoadFromFile(wsFile));
+	ASSERT_EQ(nPages, oReader.GetPagesCount());
+
+	// Эталон - однопоточная отрисовка отдельным экземпляром документа
+	CPdfFile oEtalonReader(pApplicationFonts);
+	ASSERT_TRUE(oEtalonReader.LoadFromFile(wsFile));
+	std::vector<BYTE*> arrEtalon;
+	for (int i = 0; i < nPages; ++i)
+		arrEtalon.push_back(oEtalonReader.ConvertToPixels(i, nRasterW, nRasterH));
+
+	std::vector<int> arrMismatch(nThreads, 0);
+	std::vector<std::thread> arrThreads;
+	for (int t = 0; t < nThreads; ++t)
+	{
+		arrThreads.emplace_back([&, t]()
+		{
+			for (int n = 0; n < nPages; ++n)
+			{
+				int nPage = (n + t) % nPages;
+				BYTE* pData = oReader.ConvertToPixels(nPage, nRasterW, nRasterH);
+				if (!pData || !arrEtalon[nPage] || 0 != memcmp(pData, arrEtalon[nPage], 4 * nRasterW * nRasterH))
+					++arrMismatch[t];
+				RELEASEARRAYOBJECTS(pData);
+			}
+		});
+	}
+	for (std::thread& oThread : arrThreads)
+		oThread.join();
+
+	for (int t = 0; t < nThreads; ++t)
+		EXPECT_EQ(0, arrMismatch[t]) << "thread " << t;
+	for (BYTE* pData : arrEtalon)
+		RELEASEARRAYOBJECTS(pData);
+}
+
+// Кэш целых чисел: выдача возвращает сам объект, освобождение удаляет его
+class CTestLRUCache : public PdfReader::CLRUCache
+{
+public:
+	CTestLRUCache(size_t nLimit) : PdfReader::CLRUCache(nLimit), nReleased(0) {}
+	~CTestLRUCache() { Clear(); }
+
+	int* GetInt(const std::string& sKey)
+	{
+		return (int*)Get(sKey, 0);
+	}
+	bool AddInt(const std::string& sKey, int nValue, size_t nSize)
+	{
+		int* pValue = new int(nValue);
+		if (Add(sKey, 0, pValue, nSize))
+			return true;
+		delete pValue;
+		return false;
+	}
+
+	int nReleased;
+
+protected:
+	virtual void* Acquire(int nType, void* pObject, size_t nSize) { return pObject; }
+	virtual void  Release(int nType, void* pObject) { delete (int*)pObject; ++nReleased; }
+};
+
+TEST(CLRUCacheTest, HitMiss)
+{
+	CTestLRUCache oCache(100);
+	EXPECT_EQ((int*)NULL, oCache.GetInt("a"));
+
+	EXPECT_TRUE(oCache.AddInt("a", 1, 10));
+	ASSERT_NE((int*)NULL, oCache.GetInt("a"));
+	EXPECT_EQ(1, *oCache.GetInt("a"));
+	EXPECT_EQ((int*)NULL, oCache.GetInt("b"));
+
+	// Имеющаяся запись не заменяется
+	EXPECT_FALSE(oCache.AddInt("a", 2, 10));
+	EXPECT_EQ(1, *oCache.GetInt("a"));
+	EXPECT_EQ(1, (int)oCache.GetCount());
+	EXPECT_EQ(10, (int)oCache.GetSize());
+}
+
+TEST(CLRUCacheTest, Eviction)
+{
+	CTestLRUCache oCache(30);
+	EXPECT_TRUE(oCache.AddInt("a", 1, 10));
+	EXPECT_TRUE(oCache.AddInt("b", 2, 10));
+	EXPECT_TRUE(oCache.AddInt("c", 3, 10));
+
+	// Обращение к "a" делает давно не использованной "b"
+	EXPECT_NE((int*)NULL, oCache.GetInt("a"));
+	EXPECT_TRUE(oCache.AddInt("d", 4, 10));
+	EXPECT_EQ((int*)NULL, oCache.GetInt("b"));
+	EXPECT_NE((int*)NULL, oCache.GetInt("a"));
+	EXPECT_NE((int*)NULL, oCache.GetInt("c"));
+	EXPECT_NE((int*)NULL, oCache.GetInt("d"));
+	EXPECT_EQ(1, oCache.nReleased);
+
+	// Большая запись вытесняет несколько давних
+	EXPECT_TRUE(oCache.AddInt("e", 5, 20));
+	EXPECT_EQ((int*)NULL, oCache.GetInt("a"));
+	EXPECT_EQ((int*)NULL, oCache.GetInt("c"));
+	EXPECT_NE((int*)NULL, oCache.GetInt("d"));
+	EXPECT_NE((int*)NULL, oCache.GetInt("e"));
+	EXPECT_EQ(30, (int)oCache.GetSize());
+	EXPECT_EQ(3, oCache.nReleased);
+}
+
+TEST(CLRUCacheTest, Limit)
+{
+	CTestLRUCache oCache(30);
+	EXPECT_TRUE(oCache.AddInt("a", 1, 10));
+	EXPECT_TRUE(oCache.AddInt("b", 2, 10));
+
+	// Запись больше всего кэша не добавляется и ничего не вытесняет
+	EXPECT_FALSE(oCache.AddInt("big", 3, 31));
+	EXPECT_EQ(2, (int)oCache.GetCount());
+	EXPECT_EQ(0, oCache.nReleased);
+
+	// Уменьшение ограничения вытесняет давние записи
+	oCache.SetLimit(15);
+	EXPECT_EQ((int*)NULL, oCache.GetInt("a"));
+	EXPECT_NE((int*)NULL, oCache.GetInt("b"));
+	EXPECT_EQ(10, (int)oCache.GetSize());
+
+	// 0 - кэш отключен
+	oCache.SetLimit(0);
+	EXPECT_EQ(0, (int)oCache.GetCount());
+	EXPECT_EQ(0, (int)oCache.GetSize());
+	EXPECT_FALSE(oCache.AddInt("a", 1, 1));
+	EXPECT_EQ((int*)NULL, oCache.GetInt("a"));
+	EXPECT_EQ(2, oCache.nReleased);
+}
+
+// Тексты ссылок страницы - по ним видно, как ToUnicode отображает текст в юникод
+std::vector<std::string> GetLinkTexts(CPdfFile& oFile, int nPageIndex)
+{
+	std::vector<std::string> arrTexts;
+	BYTE* pLinks = oFile.GetLinks(nPageIndex);
+	if (!pLinks)
+		return arrTexts;
+
+	unsigned int nLength = 0, nPos = 4;
+	memcpy(&nLength, pLinks, 4);
+	while (nPos + 4 <= nLength)
+	{
+		unsigned int nTextLength = 0;
+		memcpy(&nTextLength, pLinks + nPos, 4);
+		nPos += 4;
+		arrTexts.push_back(std::string((char*)pLinks + nPos, nTextLength));
+		// Dest, X, Y, W, H
+		nPos += nTextLength + 5 * sizeof(double);
+	}
+	RELEASEMEM(pLinks);
+	return arrTexts;
+}
+// Пользовательский конфиг xpdf (unicodeToUnicode) читается из домашней папки, возвращает прежнее значение
+std::string SetHomeDirectory(const std::string& sDir)
+{
+	const char* sOld = getenv("HOME");
+	std::string sRes = sOld ? sOld : "";
+#ifdef _WIN32
+	_putenv_s("HOME", sDir.c_str());
+#else
+	if (sDir.empty())
+		unsetenv("HOME");
+	else
+		setenv("HOME", sDir.c_str(), 1);
+#endif
+	return sRes;
+}
+
+TEST_F(CPdfFileTest, FontCacheReload)
+{
+	std::wstring wsFile = NSFile::GetProcessDirectory() + L"/resFontCache.pdf";
+
+	pdfFile->CreatePdf();
+	pdfFile->NewPage();
+	pdfFile->BeginCommand(c_nPageType);
+	pdfFile->put_Width(100);
+	pdfFile->put_Height(50);
+	pdfFile->put_FontName(L"Arial");
+	pdfFile->put_FontSize(10);
+	pdfFile->CommandDrawText(L"www.abc.com", 10, 20, 80, 10);
+	pdfFile->EndCommand(c_nPageType);
+	ASSERT_EQ(0, pdfFile->SaveToFile(wsFile));
+
+	// Кэш общий на процесс - очищаем его после предыдущих тестов
+	CPdfFile::SetFontCacheLimit(0);
+	CPdfFile::SetFontCacheLimit(64 * 1024 * 1024);
+
+	unsigned int unCount = 0, unSize = 0, unCount2 = 0, unSize2 = 0;
+	{
+		CPdfFile oReader(pApplicationFonts);
+		ASSERT_TRUE(oReader.LoadFromFile(wsFile));
+		EXPECT_EQ(std::vector<std::string>{ "www.abc.com" }, GetLinkTexts(oReader, 0));
+	}
+	CPdfFile::GetFontCacheStat(unCount, unSize);
+	EXPECT_LT(0u, unCount);
+
+	// Повторная загрузка того же файла берет все из кэша
+	{
+		CPdfFile oReader(pApplicationFonts);
+		ASSERT_TRUE(oReader.LoadFromFile(wsFile));
+		EXPECT_EQ(std::vector<std::string>{ "www.abc.com" }, GetLinkTexts(oReader, 0));
+	}
+	CPdfFile::GetFontCacheStat(unCount2, unSize2);
+	EXPECT_EQ(unCount, unCount2);
+	EXPECT_EQ(unSize, unSize2);
+
+	// С Unicode-to-Unicode отображением (a -> b) ToUnicode изменяется, поэтому разбирается заново, а не берется из кэша.
+	// Имена шрифтов писателя имеют вид XXXXXX+Name
+	std::wstring wsHomeDir = wsTempDir + L"/home";
+	NSDirectory::CreateDirectory(wsHomeDir);
+	NSFile::CFileBinary::SaveToFile(wsHomeDir + L"/utu.txt", L"0061 0062\n");
+#ifdef _WIN32
+	std::wstring wsConfig = wsHomeDir + L"/xpdfrc";
+#else
+	std::wstring wsConfig = wsHomeDir + L"/.xpdfrc";
+#endif
+	NSFile::CFileBinary::SaveToFile(wsConfig, L"unicodeToUnicode + \"" + wsHomeDir + L"/utu.txt\"\n");
+
+	std::string sOldHome = SetHomeDirectory(U_TO_UTF8(wsHomeDir));
+	{
+		CPdfFile oReader(pApplicationFonts);
+		EXPECT_TRUE(oReader.LoadFromFile(wsFile));
+		EXPECT_EQ(std::vector<std::string>{ "www.bbc.com" }, GetLinkTexts(oReader, 0));
+	}
+	SetHomeDirectory(sOldHome);
+	NSDirectory::DeleteDirectory(wsHomeDir);
+
+	// Общий ToUnicode из кэша остался прежним
+	{
+		CPdfFile oReader(pApplicationFonts);
+		ASSERT_TRUE(oReader.LoadFromFile(wsFile));
+		EXPECT_EQ(std::vector<std::string>{ "www.abc.com" }, GetLinkTexts(oReader, 0));
+	}
+	CPdfFile::GetFontCacheStat(unCount2, unSize2);
+	EXPECT_EQ(unCount, unCount2);
+	EXPECT_EQ(unSize, unSize2);
+}
+
 TEST_F(CPdfFileTest, SetMetaData)
 {
 	GTEST_SKIP();
@@ -17,4 +17,6 @@ ADD_DEPENDENCY(UnicodeConverter, kernel, graphics, PdfFile, DjVuFile, ooxmlsigna
 
 SOURCES += test.cpp
 
+core_linux:LIBS += -lpthread
+
 DESTDIR = $$PWD/build
@@ -713,39 +713,41 @@ void RtfParagraphReader::ExitReader(RtfDocument& oDocument, RtfReader& oReader)
 
 bool RtfBorderCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader& oReader, std::string sCommand, bool hasParameter, int parameter, RtfBorder& oOutput)
 {
-	if( "brdrs"			== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrs;
-	else if( "brdrth"			== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrth;
-	else if( "brdrsh"			== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrsh;
-	else if( "brdrdb"			== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrdb;
-	else if( "brdrdot"			== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrdot;
-	else if( "brdrdash"			== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrdash;
-	else if( "brdrhair"			== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrhair;
-	else if( "brdrdashsm"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrdashsm;
-	else if( "brdrdashd"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrdashd;
-	else if( "brdrdashdd"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrdashdd;
-	else if( "brdrdashdot"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrdashdot;
-	else if( "brdrdashdotdot"	== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrdashdot;
-	else if( "brdrtriple"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrtriple;
-	else if( "brdrtnthsg"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrtnthsg;
-	else if( "brdrthtnsg"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrthtnsg;
-	else if( "brdrtnthtnsg"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrtnthtnsg;
-	else if( "brdrtnthmg"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrtnthmg;
-	else if( "brdrthtnmg"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrthtnmg;
-	else if( "brdrtnthtnmg"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrtnthtnmg;
-	else if( "brdrtnthlg"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrtnthlg;
-	else if( "brdrthtnlg"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrthtnlg;
-	else if( "brdrtnthtnlg"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrtnthtnlg;
-	else if( "brdrwavy"			== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrwavy;
-	else if( "brdrwavydb"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrwavydb;
-	else if( "brdrdashdotstr"	== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrdashdotstr;
-	else if( "brdremboss"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdremboss;
-	else if( "brdrengrave"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrengrave;
-	else if( "brdroutset"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdroutset;
-	else if( "brdrinset"		== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrinset;
-	else if( "brdrnone"			== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrnone;
-	else if( "brdrnil"			== sCommand )	oOutput.m_eType = RtfBorder::bt_none;
-	else if( "brdrn"			== sCommand )	oOutput.m_eType = RtfBorder::bt_brdrnone;
-	else if( "brdrw"			== sCommand )
+	switch (oReader.m_eKeyword)
+	{
+	case RtfKeyword::kw_brdrs:	oOutput.m_eType = RtfBorder::bt_brdrs; break;
+	case RtfKeyword::kw_brdrth:	oOutput.m_eType = RtfBorder::bt_brdrth; break;
+	case RtfKeyword::kw_brdrsh:	oOutput.m_eType = RtfBorder::bt_brdrsh; break;
+	case RtfKeyword::kw_brdrdb:	oOutput.m_eType = RtfBorder::bt_brdrdb; break;
+	case RtfKeyword::kw_brdrdot:	oOutput.m_eType = RtfBorder::bt_brdrdot; break;
+	case RtfKeyword::kw_brdrdash:	oOutput.m_eType = RtfBorder::bt_brdrdash; break;
+	case RtfKeyword::kw_brdrhair:	oOutput.m_eType = RtfBorder::bt_brdrhair; break;
+	case RtfKeyword::kw_brdrdashsm:	oOutput.m_eType = RtfBorder::bt_brdrdashsm; break;
+	case RtfKeyword::kw_brdrdashd:	oOutput.m_eType = RtfBorder::bt_brdrdashd; break;
+	case RtfKeyword::kw_brdrdashdd:	oOutput.m_eType = RtfBorder::bt_brdrdashdd; break;
+	case RtfKeyword::kw_brdrdashdot:	oOutput.m_eType = RtfBorder::bt_brdrdashdot; break;
+	case RtfKeyword::kw_brdrdashdotdot:	oOutput.m_eType = RtfBorder::bt_brdrdashdot; break;
+	case RtfKeyword::kw_brdrtriple:	oOutput.m_eType = RtfBorder::bt_brdrtriple; break;
+	case RtfKeyword::kw_brdrtnthsg:	oOutput.m_eType = RtfBorder::bt_brdrtnthsg; break;
+	case RtfKeyword::kw_brdrthtnsg:	oOutput.m_eType = RtfBorder::bt_brdrthtnsg; break;
+	case RtfKeyword::kw_brdrtnthtnsg:	oOutput.m_eType = RtfBorder::bt_brdrtnthtnsg; break;
+	case RtfKeyword::kw_brdrtnthmg:	oOutput.m_eType = RtfBorder::bt_brdrtnthmg; break;
+	case RtfKeyword::kw_brdrthtnmg:	oOutput.m_eType = RtfBorder::bt_brdrthtnmg; break;
+	case RtfKeyword::kw_brdrtnthtnmg:	oOutput.m_eType = RtfBorder::bt_brdrtnthtnmg; break;
+	case RtfKeyword::kw_brdrtnthlg:	oOutput.m_eType = RtfBorder::bt_brdrtnthlg; break;
+	case RtfKeyword::kw_brdrthtnlg:	oOutput.m_eType = RtfBorder::bt_brdrthtnlg; break;
+	case RtfKeyword::kw_brdrtnthtnlg:	oOutput.m_eType = RtfBorder::bt_brdrtnthtnlg; break;
+	case RtfKeyword::kw_brdrwavy:	oOutput.m_eType = RtfBorder::bt_brdrwavy; break;
+	case RtfKeyword::kw_brdrwavydb:	oOutput.m_eType = RtfBorder::bt_brdrwavydb; break;
+	case RtfKeyword::kw_brdrdashdotstr:	oOutput.m_eType = RtfBorder::bt_brdrdashdotstr; break;
+	case RtfKeyword::kw_brdremboss:	oOutput.m_eType = RtfBorder::bt_brdremboss; break;
+	case RtfKeyword::kw_brdrengrave:	oOutput.m_eType = RtfBorder::bt_brdrengrave; break;
+	case RtfKeyword::kw_brdroutset:	oOutput.m_eType = RtfBorder::bt_brdroutset; break;
+	case RtfKeyword::kw_brdrinset:	oOutput.m_eType = RtfBorder::bt_brdrinset; break;
+	case RtfKeyword::kw_brdrnone:	oOutput.m_eType = RtfBorder::bt_brdrnone; break;
+	case RtfKeyword::kw_brdrnil:	oOutput.m_eType = RtfBorder::bt_none; break;
+	case RtfKeyword::kw_brdrn:	oOutput.m_eType = RtfBorder::bt_brdrnone; break;
+	case RtfKeyword::kw_brdrw:
 	{
 		if( true == hasParameter )
 		{
@@ -753,8 +755,8 @@ bool RtfBorderCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader& oReader
 			if( RtfBorder::bt_none == oOutput.m_eType )
 				oOutput.m_eType = RtfBorder::bt_brdrs;
 		}
-	}
-	else if( "brsp" == sCommand )
+	}break;
+	case RtfKeyword::kw_brsp:
 	{
 		if( true == hasParameter )
 		{
@@ -762,8 +764,8 @@ bool RtfBorderCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader& oReader
 			if( RtfBorder::bt_none == oOutput.m_eType )
 				oOutput.m_eType = RtfBorder::bt_brdrs;
 		}
-	}
-	else if( "brdrcf" == sCommand )
+	}break;
+	case RtfKeyword::kw_brdrcf:
 	{
 		if( true == hasParameter )
 		{
@@ -771,9 +773,10 @@ bool RtfBorderCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader& oReader
 			if( RtfBorder::bt_none == oOutput.m_eType )
 				oOutput.m_eType = RtfBorder::bt_brdrs;
 		}
-	}
-	else
+	}break;
+	default:
 		return false;
+	}
 	return true;
 }
 
@@ -975,166 +978,196 @@ bool RtfSectionCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader& oReade
 
 bool RtfShadingCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader& oReader,  std::string sCommand, bool hasParameter, int parameter, RtfShading& oOutput )
 {
-	if		( "bghoriz"	== sCommand )	oOutput.m_eType = RtfShading::st_chbghoriz;
-	else if ( "bgvert"		== sCommand )	oOutput.m_eType = RtfShading::st_chbgvert;
-	else if ( "bgfdiag"	== sCommand )	oOutput.m_eType = RtfShading::st_chbgfdiag;
-	else if ( "bgbdiag"	== sCommand )	oOutput.m_eType = RtfShading::st_chbgbdiag;
-	else if ( "bgcross"	== sCommand )	oOutput.m_eType = RtfShading::st_chbgcross;
-	else if ( "bgdcross"	== sCommand )	oOutput.m_eType = RtfShading::st_chbgdcross;
-	else if ( "bgdkhoriz"	== sCommand )	oOutput.m_eType = RtfShading::st_chbgdkhoriz;
-	else if ( "bgdkvert"	== sCommand )	oOutput.m_eType = RtfShading::st_chbgdkvert;
-	else if ( "bgdkfdiag"	== sCommand )	oOutput.m_eType = RtfShading::st_chbgdkfdiag;
-	else if ( "bgdkbdiag"	== sCommand )	oOutput.m_eType = RtfShading::st_chbgdkbdiag;
-	else if ( "bgdkcross"	== sCommand )	oOutput.m_eType = RtfShading::st_chbgdkcross;
-	else if ( "bgdkdcross"	== sCommand )	oOutput.m_eType = RtfShading::st_chbgdkdcross;
-	else if ( "cfpat"		== sCommand )
+	switch (oReader.m_eKeyword)
+	{
+	case RtfKeyword::kw_bghoriz:	oOutput.m_eType = RtfShading::st_chbghoriz; break;
+	case RtfKeyword::kw_bgvert:	oOutput.m_eType = RtfShading::st_chbgvert; break;
+	case RtfKeyword::kw_bgfdiag:	oOutput.m_eType = RtfShading::st_chbgfdiag; break;
+	case RtfKeyword::kw_bgbdiag:	oOutput.m_eType = RtfShading::st_chbgbdiag; break;
+	case RtfKeyword::kw_bgcross:	oOutput.m_eType = RtfShading::st_chbgcross; break;
+	case RtfKeyword::kw_bgdcross:	oOutput.m_eType = RtfShading::st_chbgdcross; break;
+	case RtfKeyword::kw_bgdkhoriz:	oOutput.m_eType = RtfShading::st_chbgdkhoriz; break;
+	case RtfKeyword::kw_bgdkvert:	oOutput.m_eType = RtfShading::st_chbgdkvert; break;
+	case RtfKeyword::kw_bgdkfdiag:	oOutput.m_eType = RtfShading::st_chbgdkfdiag; break;
+	case RtfKeyword::kw_bgdkbdiag:	oOutput.m_eType = RtfShading::st_chbgdkbdiag; break;
+	case RtfKeyword::kw_bgdkcross:	oOutput.m_eType = RtfShading::st_chbgdkcross; break;
+	case RtfKeyword::kw_bgdkdcross:	oOutput.m_eType = RtfShading::st_chbgdkdcross; break;
+	case RtfKeyword::kw_cfpat:
 	{
 		if ( hasParameter )
 			oOutput.m_nForeColor = parameter;
-	}
-	else if ( "cbpat" == sCommand )
+	}break;
+	case RtfKeyword::kw_cbpat:
 	{
 		if ( hasParameter )
 			oOutput.m_nBackColor = parameter;
-	}
-	else if ( "shading" == sCommand )
+	}break;
+	case RtfKeyword::kw_shading:
 	{
 		if ( hasParameter )
 			oOutput.m_nValue = parameter;
-	}
-	else
+	}break;
+	default:
 		return false;
+	}
 	return true;
 }
 bool RtfShadingCellCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader& oReader, std::string sCommand, bool hasParameter, int parameter, RtfShading& oOutput)
 {
 	//для свойст таблицы и для стилей таблицы
-	if ( "clshdrawnil" == sCommand )
+	RtfKeyword::_Keyword eKeyword = oReader.m_eKeyword;
+
+	switch (eKeyword)
+	{
+	case RtfKeyword::kw_clshdrawnil:
 		oOutput.m_eType = RtfShading::st_clshdrawnil;
-	else if ( "rawclbgvert" == sCommand || "clbgvert" == sCommand || "tsbgvert" == sCommand )
+		break;
+	case RtfKeyword::kw_rawclbgvert: case RtfKeyword::kw_clbgvert: case RtfKeyword::kw_tsbgvert:
 		oOutput.m_eType = RtfShading::st_chbgvert;
-	else if ( "rawclbgfdiag" == sCommand || "clbgfdiag" == sCommand || "tsbgfdiag" == sCommand )
+		break;
+	case RtfKeyword::kw_rawclbgfdiag: case RtfKeyword::kw_clbgfdiag: case RtfKeyword::kw_tsbgfdiag:
 		oOutput.m_eType = RtfShading::st_chbgfdiag;
-	else if ( "rawclbgbdiag" == sCommand || "clbgbdiag" == sCommand || "tsbgbdiag" == sCommand )
+		break;
+	case RtfKeyword::kw_rawclbgbdiag: case RtfKeyword::kw_clbgbdiag: case RtfKeyword::kw_tsbgbdiag:
 		oOutput.m_eType = RtfShading::st_chbgbdiag;
-	else if ( "rawclbgcross" == sCommand || "clbgcross" == sCommand || "tsbgcross" == sCommand )
+		break;
+	case RtfKeyword::kw_rawclbgcross: case RtfKeyword::kw_clbgcross: case RtfKeyword::kw_tsbgcross:
 		oOutput.m_eType = RtfShading::st_chbgcross;
-	else if ( "rawclbgdcross" == sCommand || "clbgdcross" == sCommand || "tsbgdcross" == sCommand )
+		break;
+	case RtfKeyword::kw_rawclbgdcross: case RtfKeyword::kw_clbgdcross: case RtfKeyword::kw_tsbgdcross:
 		oOutput.m_eType = RtfShading::st_chbgdcross;
-	else if ( "rawclbgdkhor" == sCommand || "clbgdkhor" == sCommand || "tsbgdkhor" == sCommand )
+		break;
+	case RtfKeyword::kw_rawclbgdkhor: case RtfKeyword::kw_clbgdkhor: case RtfKeyword::kw_tsbgdkhor:
 		oOutput.m_eType = RtfShading::st_chbgdkhoriz;
-	else if ( "rawclbgdkvert" == sCommand || "clbgdkvert" == sCommand || "tsbgdkvert" == sCommand )
+		break;
+	case RtfKeyword::kw_rawclbgdkvert: case RtfKeyword::kw_clbgdkvert: case RtfKeyword::kw_tsbgdkvert:
 		oOutput.m_eType = RtfShading::st_chbgdkvert;
-	else if ( "rawclbgdkfdiag" == sCommand || "clbgdkfdiag" == sCommand || "tsbgdkfdiag" == sCommand )
+		break;
+	case RtfKeyword::kw_rawclbgdkfdiag: case RtfKeyword::kw_clbgdkfdiag: case RtfKeyword::kw_tsbgdkfdiag:
 		oOutput.m_eType = RtfShading::st_chbgdkfdiag;
-	else if ( "rawclbgdkbdiag" == sCommand || "clbgdkbdiag" == sCommand || "tsbgdkbdiag" == sCommand )
+		break;
+	case RtfKeyword::kw_rawclbgdkbdiag: case RtfKeyword::kw_clbgdkbdiag: case RtfKeyword::kw_tsbgdkbdiag:
 		oOutput.m_eType = RtfShading::st_chbgdkbdiag;
-	else if ( "rawclbgdkcross" == sCommand || "clbgdkcross" == sCommand || "tsbgdkcross" == sCommand )
+		break;
+	case RtfKeyword::kw_rawclbgdkcross: case RtfKeyword::kw_clbgdkcross: case RtfKeyword::kw_tsbgdkcross:
 		oOutput.m_eType = RtfShading::st_chbgdkcross;
-	else if ( "rawclbgdkdcross" == sCommand || "clbgdkdcross" == sCommand || "tsbgdkdcross" == sCommand )
+		break;
+	case RtfKeyword::kw_rawclbgdkdcross: case RtfKeyword::kw_clbgdkdcross: case RtfKeyword::kw_tsbgdkdcross:
 		oOutput.m_eType = RtfShading::st_chbgdkdcross;
+		break;
 	
-	COMMAND_RTF_INT ( "clcfpat",		oOutput.m_nForeColor, sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "clcbpat",		oOutput.m_nBackColor, sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "clcfpatraw",	oOutput.m_nForeColor, sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "clcbpatraw",	oOutput.m_nBackColor, sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tscellcfpat",	oOutput.m_nForeColor, sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tscellcbpat",	oOutput.m_nBackColor, sCommand, hasParameter, parameter )
-
-	COMMAND_RTF_INT ( "clshdng",		oOutput.m_nValue, sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "clshdngraw",	oOutput.m_nValue, sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tscellpct",		oOutput.m_nValue, sCommand, hasParameter, parameter )
-			else
-			return false;
+	CASE_RTF_INT( clcfpat,		oOutput.m_nForeColor, hasParameter, parameter )
+	CASE_RTF_INT( clcbpat,		oOutput.m_nBackColor, hasParameter, parameter )
+	CASE_RTF_INT( clcfpatraw,	oOutput.m_nForeColor, hasParameter, parameter )
+	CASE_RTF_INT( clcbpatraw,	oOutput.m_nBackColor, hasParameter, parameter )
+	CASE_RTF_INT( tscellcfpat,	oOutput.m_nForeColor, hasParameter, parameter )
+	CASE_RTF_INT( tscellcbpat,	oOutput.m_nBackColor, hasParameter, parameter )
+
+	CASE_RTF_INT( clshdng,		oOutput.m_nValue, hasParameter, parameter )
+	CASE_RTF_INT( clshdngraw,	oOutput.m_nValue, hasParameter, parameter )
+	CASE_RTF_INT( tscellpct,		oOutput.m_nValue, hasParameter, parameter )
+	default:
+		return false;
+	}
 
-	if (sCommand == "clshdng")		oReader.m_oState->m_oCellProperty.m_nShadingPctFrom = 1;
-	if (sCommand == "clshdngraw")	oReader.m_oState->m_oCellProperty.m_nShadingPctFrom = 2;
+	if (RtfKeyword::kw_clshdng == eKeyword)			oReader.m_oState->m_oCellProperty.m_nShadingPctFrom = 1;
+	if (RtfKeyword::kw_clshdngraw == eKeyword)		oReader.m_oState->m_oCellProperty.m_nShadingPctFrom = 2;
 	return true;
 }
 
 bool RtfShadingCharCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader& oReader, std::string sCommand, bool hasParameter, int parameter, RtfShading& oOutput )
 {
-	if		( "chbghoriz"		== sCommand )		oOutput.m_eType = RtfShading::st_chbghoriz;
-	else if ( "chbgvert"		== sCommand )		oOutput.m_eType = RtfShading::st_chbgvert;
-	else if ( "chbgfdiag"		== sCommand )		oOutput.m_eType = RtfShading::st_chbgfdiag;
-	else if ( "chbgbdiag"		== sCommand )		oOutput.m_eType = RtfShading::st_chbgbdiag;
-	else if ( "chbgcross"		== sCommand )		oOutput.m_eType = RtfShading::st_chbgcross;
-	else if ( "chbgdcross"		== sCommand )		oOutput.m_eType = RtfShading::st_chbgdcross;
-	else if ( "chbgdkhoriz"	== sCommand )		oOutput.m_eType = RtfShading::st_chbgdkhoriz;
-	else if ( "chbgdkvert"		== sCommand )		oOutput.m_eType = RtfShading::st_chbgdkvert;
-	else if ( "chbgdkfdiag"	== sCommand )		oOutput.m_eType = RtfShading::st_chbgdkfdiag;
-	else if ( "chbgdkbdiag"	== sCommand )		oOutput.m_eType = RtfShading::st_chbgdkbdiag;
-	else if ( "chbgdkcross"	== sCommand )		oOutput.m_eType = RtfShading::st_chbgdkcross;
-	else if ( "chbgdkdcross"	== sCommand )		oOutput.m_eType = RtfShading::st_chbgdkdcross;
-	else if ( "chcfpat"		== sCommand )
+	switch (oReader.m_eKeyword)
+	{
+	case RtfKeyword::kw_chbghoriz:	oOutput.m_eType = RtfShading::st_chbghoriz; break;
+	case RtfKeyword::kw_chbgvert:	oOutput.m_eType = RtfShading::st_chbgvert; break;
+	case RtfKeyword::kw_chbgfdiag:	oOutput.m_eType = RtfShading::st_chbgfdiag; break;
+	case RtfKeyword::kw_chbgbdiag:	oOutput.m_eType = RtfShading::st_chbgbdiag; break;
+	case RtfKeyword::kw_chbgcross:	oOutput.m_eType = RtfShading::st_chbgcross; break;
+	case RtfKeyword::kw_chbgdcross:	oOutput.m_eType = RtfShading::st_chbgdcross; break;
+	case RtfKeyword::kw_chbgdkhoriz:	oOutput.m_eType = RtfShading::st_chbgdkhoriz; break;
+	case RtfKeyword::kw_chbgdkvert:	oOutput.m_eType = RtfShading::st_chbgdkvert; break;
+	case RtfKeyword::kw_chbgdkfdiag:	oOutput.m_eType = RtfShading::st_chbgdkfdiag; break;
+	case RtfKeyword::kw_chbgdkbdiag:	oOutput.m_eType = RtfShading::st_chbgdkbdiag; break;
+	case RtfKeyword::kw_chbgdkcross:	oOutput.m_eType = RtfShading::st_chbgdkcross; break;
+	case RtfKeyword::kw_chbgdkdcross:	oOutput.m_eType = RtfShading::st_chbgdkdcross; break;
+	case RtfKeyword::kw_chcfpat:
 	{
 		if ( hasParameter )
 			oOutput.m_nForeColor = parameter;
-	}
-	else if ( "chcbpat" == sCommand )
+	}break;
+	case RtfKeyword::kw_chcbpat:
 	{
 		if ( hasParameter )
 			oOutput.m_nBackColor = parameter;
-	}
-	else if ( "chshdng" == sCommand )
+	}break;
+	case RtfKeyword::kw_chshdng:
 	{
 		if ( hasParameter )
 			oOutput.m_nValue = parameter;
-	}
-	else
+	}break;
+	default:
 		return false;
+	}
 	return true;
 }
 
 bool RtfShadingRowCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader& oReader, std::string sCommand, bool hasParameter, int parameter, RtfShading& oOutput)
 {
-	if		( "trbghoriz"	== sCommand )		oOutput.m_eType = RtfShading::st_chbghoriz;
-	else if ( "trbgvert"	== sCommand )		oOutput.m_eType = RtfShading::st_chbgvert;
-	else if	( "trbgfdiag"	== sCommand )		oOutput.m_eType = RtfShading::st_chbgfdiag;
-	else if	( "trbgbdiag"	== sCommand )		oOutput.m_eType = RtfShading::st_chbgbdiag;
-	else if	( "trbgcross"	== sCommand )		oOutput.m_eType = RtfShading::st_chbgcross;
-	else if	( "trbgdcross"	== sCommand )		oOutput.m_eType = RtfShading::st_chbgdcross;
-	else if	( "trbgdkhor"	== sCommand )		oOutput.m_eType = RtfShading::st_chbgdkhoriz;
-	else if	( "trbgdkvert"	== sCommand )		oOutput.m_eType = RtfShading::st_chbgdkvert;
-	else if	( "trbgdkfdiag"	== sCommand )		oOutput.m_eType = RtfShading::st_chbgdkfdiag;
-	else if	( "trbgdkbdiag"	== sCommand )		oOutput.m_eType = RtfShading::st_chbgdkbdiag;
-	else if	( "trbgdkcross"	== sCommand )		oOutput.m_eType = RtfShading::st_chbgdkcross;
-	else if	( "trbgdkdcross"== sCommand )		oOutput.m_eType = RtfShading::st_chbgdkdcross;
-	else if	( "trcfpat"		== sCommand )
+	switch (oReader.m_eKeyword)
+	{
+	case RtfKeyword::kw_trbghoriz:	oOutput.m_eType = RtfShading::st_chbghoriz; break;
+	case RtfKeyword::kw_trbgvert:	oOutput.m_eType = RtfShading::st_chbgvert; break;
+	case RtfKeyword::kw_trbgfdiag:	oOutput.m_eType = RtfShading::st_chbgfdiag; break;
+	case RtfKeyword::kw_trbgbdiag:	oOutput.m_eType = RtfShading::st_chbgbdiag; break;
+	case RtfKeyword::kw_trbgcross:	oOutput.m_eType = RtfShading::st_chbgcross; break;
+	case RtfKeyword::kw_trbgdcross:	oOutput.m_eType = RtfShading::st_chbgdcross; break;
+	case RtfKeyword::kw_trbgdkhor:	oOutput.m_eType = RtfShading::st_chbgdkhoriz; break;
+	case RtfKeyword::kw_trbgdkvert:	oOutput.m_eType = RtfShading::st_chbgdkvert; break;
+	case RtfKeyword::kw_trbgdkfdiag:	oOutput.m_eType = RtfShading::st_chbgdkfdiag; break;
+	case RtfKeyword::kw_trbgdkbdiag:	oOutput.m_eType = RtfShading::st_chbgdkbdiag; break;
+	case RtfKeyword::kw_trbgdkcross:	oOutput.m_eType = RtfShading::st_chbgdkcross; break;
+	case RtfKeyword::kw_trbgdkdcross:	oOutput.m_eType = RtfShading::st_chbgdkdcross; break;
+	case RtfKeyword::kw_trcfpat:
 	{
 		if ( hasParameter )
 			oOutput.m_nForeColor = parameter;
-	}
-	else if ( "trcbpat" == sCommand )
+	}break;
+	case RtfKeyword::kw_trcbpat:
 	{
 		if ( hasParameter )
 			oOutput.m_nBackColor = parameter;
-	}
-	else if ( "trshdng" == sCommand )
+	}break;
+	case RtfKeyword::kw_trshdng:
 	{
 		if ( hasParameter )
 			oOutput.m_nValue = parameter;
-	}
-	else
+	}break;
+	default:
 		return false;
+	}
 	return true;
 }	
 bool RtfCharPropsCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader& oReader, std::string sCommand, bool hasParameter, int parameter, RtfCharProperty * charProps, bool bLookOnBorder)
 {
 	if (!charProps) return false;
 
-	if ( "plain" == sCommand )
+	RtfKeyword::_Keyword eKeyword = oReader.m_eKeyword;
+
+	if ( RtfKeyword::kw_plain == eKeyword )
 		charProps->SetDefaultRtf();
 
-	COMMAND_RTF_INT	( "animtext"	,	charProps->m_nAnimated,			sCommand, hasParameter, parameter)
-	COMMAND_RTF_BOOL( "b"			,	charProps->m_bBold,				sCommand, hasParameter, parameter)
-	COMMAND_RTF_BOOL( "caps"		,	charProps->m_bCaps,				sCommand, hasParameter, parameter)
-	COMMAND_RTF_INT	( "charscalex"	,	charProps->m_nScalex,			sCommand, hasParameter, parameter)
+	switch (eKeyword)
+	{
+	CASE_RTF_INT( animtext,	charProps->m_nAnimated, hasParameter, parameter)
+	CASE_RTF_BOOL( b,	charProps->m_bBold, hasParameter, parameter)
+	CASE_RTF_BOOL( caps,	charProps->m_bCaps, hasParameter, parameter)
+	CASE_RTF_INT( charscalex,	charProps->m_nScalex, hasParameter, parameter)
     //COMMAND_RTF_INT	( "cs"			,	charProps->m_nCharStyle,		sCommand, hasParameter, parameter)
-	COMMAND_RTF_INT	( "down"		,	charProps->m_nDown,				sCommand, hasParameter, parameter)
-	COMMAND_RTF_BOOL( "embo"		,	charProps->m_bEmbo,				sCommand, hasParameter, parameter)
-	COMMAND_RTF_INT	( "expndtw"		,	charProps->m_nCharacterSpacing,	sCommand, hasParameter, parameter)
-    else if ("cs" == sCommand)
+	CASE_RTF_INT( down,	charProps->m_nDown, hasParameter, parameter)
+	CASE_RTF_BOOL( embo,	charProps->m_bEmbo, hasParameter, parameter)
+	CASE_RTF_INT( expndtw,	charProps->m_nCharacterSpacing, hasParameter, parameter)
+    case RtfKeyword::kw_cs:
     {
         if (true == hasParameter)
             charProps->m_nCharStyle = parameter;
@@ -1144,34 +1177,37 @@ bool RtfCharPropsCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader& oRea
         charProps->m_eUnderStyle = RtfCharProperty::uls_none;
         charProps->m_bBold = 0;
 #endif
-    }
+    }break;
 
-	else if ( "expnd" == sCommand )
+	case RtfKeyword::kw_expnd:
 	{
 		if ( hasParameter )
 			charProps->m_nCharacterSpacing  = 5 * parameter; //quater -points
-	}
-	COMMAND_RTF_INT	( "fittext"		, charProps->m_nFitText, sCommand, hasParameter, parameter)
-	else if ("f" == sCommand && hasParameter)
+	}break;
+	CASE_RTF_INT( fittext, charProps->m_nFitText, hasParameter, parameter)
+	case RtfKeyword::kw_f:
 	{
+		if (false == hasParameter)
+			return false;
+
 		charProps->m_nFont = parameter;
 		
 		if (false == charProps->m_bListLevel)
 			oReader.m_nDefFont = charProps->m_nFont; //reset
-	}
-	COMMAND_RTF_INT	( "fs"			, charProps->m_nFontSize, sCommand, hasParameter, parameter)
-	COMMAND_RTF_BOOL( "fcs"			, charProps->m_nComplexScript, sCommand, hasParameter, parameter)
-	COMMAND_RTF_BOOL( "i"			, charProps->m_bItalic, sCommand, hasParameter, parameter)
-	COMMAND_RTF_BOOL( "impr"		, charProps->m_bImprint, sCommand, hasParameter, parameter)
-	COMMAND_RTF_INT	( "kerning"		, charProps->m_nKerning, sCommand, hasParameter, parameter)
-	else if ( "ltrch" == sCommand )
+	}break;
+	CASE_RTF_INT( fs, charProps->m_nFontSize, hasParameter, parameter)
+	CASE_RTF_BOOL( fcs, charProps->m_nComplexScript, hasParameter, parameter)
+	CASE_RTF_BOOL( i, charProps->m_bItalic, hasParameter, parameter)
+	CASE_RTF_BOOL( impr, charProps->m_bImprint, hasParameter, parameter)
+	CASE_RTF_INT( kerning, charProps->m_nKerning, hasParameter, parameter)
+	case RtfKeyword::kw_ltrch:
 	{
 		if ( false == hasParameter || 0 != parameter )
 			charProps->m_bRightToLeft  = 0;
 		else
 			charProps->m_bRightToLeft  = 1;
-	}
-    else if ("rtlch" == sCommand)
+	}break;
+    case RtfKeyword::kw_rtlch:
     {
         if ( false == hasParameter || 0 != parameter )
         {
@@ -1180,99 +1216,102 @@ bool RtfCharPropsCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader& oRea
         }
         else
             charProps->m_bRightToLeft  = 0;
-    }
+    }break;
     //COMMAND_RTF_BOOL( "rtlch",		charProps->m_bRightToLeft,	sCommand, hasParameter, parameter)
-    COMMAND_RTF_INT	( "lang",		charProps->m_nLanguage,		sCommand, hasParameter, parameter)
-	COMMAND_RTF_INT	( "langfe",		charProps->m_nLanguageAsian,sCommand, hasParameter, parameter)
+    CASE_RTF_INT( lang,		charProps->m_nLanguage, hasParameter, parameter)
+	CASE_RTF_INT( langfe,		charProps->m_nLanguageAsian, hasParameter, parameter)
 	
-	COMMAND_RTF_BOOL( "outl",		charProps->m_bOutline,		sCommand, hasParameter, parameter)
-	COMMAND_RTF_BOOL( "scaps",		charProps->m_bScaps,		sCommand, hasParameter, parameter)
-	COMMAND_RTF_BOOL( "shad",		charProps->m_bShadow,		sCommand, hasParameter, parameter)
-	COMMAND_RTF_BOOL( "strike",		charProps->m_bStrike,		sCommand, hasParameter, parameter)
-	COMMAND_RTF_BOOL( "striked",	charProps->m_nStriked,		sCommand, hasParameter, parameter)
-	COMMAND_RTF_BOOL( "sub",		charProps->m_bSub,			sCommand, hasParameter, parameter)
-	COMMAND_RTF_BOOL( "super",		charProps->m_bSuper,		sCommand, hasParameter, parameter)
-	COMMAND_RTF_INT ( "highlight",	charProps->m_nHightlited,	sCommand, hasParameter, parameter)
-	else if ( "cf" == sCommand )
+	CASE_RTF_BOOL( outl,		charProps->m_bOutline, hasParameter, parameter)
+	CASE_RTF_BOOL( scaps,		charProps->m_bScaps, hasParameter, parameter)
+	CASE_RTF_BOOL( shad,		charProps->m_bShadow, hasParameter, parameter)
+	CASE_RTF_BOOL( strike,		charProps->m_bStrike, hasParameter, parameter)
+	CASE_RTF_BOOL( striked,	charProps->m_nStriked, hasParameter, parameter)
+	CASE_RTF_BOOL( sub,		charProps->m_bSub, hasParameter, parameter)
+	CASE_RTF_BOOL( super,		charProps->m_bSuper, hasParameter, parameter)
+	CASE_RTF_INT( highlight,	charProps->m_nHightlited, hasParameter, parameter)
+	case RtfKeyword::kw_cf:
 	{
 		if ( hasParameter )
 			charProps->m_nForeColor = parameter;
 		else
 			charProps->m_nForeColor = PROP_DEF; //auto?
-	}
-	else if ( "ul" == sCommand )
+	}break;
+	case RtfKeyword::kw_ul:
 	{
 		if ( hasParameter && 0 == parameter)
 			charProps->m_eUnderStyle = RtfCharProperty::uls_none;
 		else
 			charProps->m_eUnderStyle = RtfCharProperty::uls_Single;
-	}
-    else if ( "uld" == sCommand )
+	}break;
+    case RtfKeyword::kw_uld:
     {
         if ( hasParameter && 0 == parameter)
             charProps->m_eUnderStyle = RtfCharProperty::uls_none;
         else
             charProps->m_eUnderStyle = RtfCharProperty::uls_Dotted;
-    }
+    }break;
 	//COMMAND_RTF_BOOL( "ul", charProps->m_bUnderline, sCommand, hasParameter, parameter)
-	COMMAND_RTF_INT ( "ulc",		charProps->m_nUnderlineColor, sCommand, hasParameter, parameter)
+	CASE_RTF_INT( ulc,		charProps->m_nUnderlineColor, hasParameter, parameter)
     //COMMAND_RTF_INT ( "uld",		charProps->m_eUnderStyle,	sCommand, true, RtfCharProperty::uls_Dotted)
-	COMMAND_RTF_INT ( "uldash",		charProps->m_eUnderStyle,	sCommand, true, RtfCharProperty::uls_Dashed)
-	COMMAND_RTF_INT ( "uldashd",	charProps->m_eUnderStyle,	sCommand, true, RtfCharProperty::uls_Dash_dotted)
-	COMMAND_RTF_INT ( "uldashdd",	charProps->m_eUnderStyle,	sCommand, true, RtfCharProperty::uls_Dash_dot_dotted)
-	COMMAND_RTF_INT ( "uldb",		charProps->m_eUnderStyle,	sCommand, true, RtfCharProperty::uls_Double)
-	COMMAND_RTF_INT ( "ulhwave",	charProps->m_eUnderStyle,	sCommand, true, RtfCharProperty::uls_Heavy_wave)
-	COMMAND_RTF_INT ( "ulldash",	charProps->m_eUnderStyle,	sCommand, true, RtfCharProperty::uls_Long_dashe)
-	COMMAND_RTF_INT ( "ulnone",		charProps->m_eUnderStyle,	sCommand, true, RtfCharProperty::uls_none)
-	COMMAND_RTF_INT ( "ulth",		charProps->m_eUnderStyle,	sCommand, true, RtfCharProperty::uls_Thick)
-	COMMAND_RTF_INT ( "ulthd",		charProps->m_eUnderStyle,	sCommand, true, RtfCharProperty::uls_Thick_dotted)
-	COMMAND_RTF_INT ( "ulthdash",	charProps->m_eUnderStyle,	sCommand, true, RtfCharProperty::uls_Thick_dashed)
-	COMMAND_RTF_INT ( "ulthdashd",	charProps->m_eUnderStyle,	sCommand, true, RtfCharProperty::uls_Thick_dash_dotted)
-	COMMAND_RTF_INT ( "ulthdashdd",	charProps->m_eUnderStyle,	sCommand, true, RtfCharProperty::uls_Thick_dash_dot_dotted)
-	COMMAND_RTF_INT ( "ulthldash",	charProps->m_eUnderStyle,	sCommand, true, RtfCharProperty::uls_Thick_long_dashed)
-	COMMAND_RTF_INT ( "ululdbwave",	charProps->m_eUnderStyle,	sCommand, true, RtfCharProperty::uls_Double_wave)
-	COMMAND_RTF_INT ( "ulw",		charProps->m_eUnderStyle,	sCommand, true, RtfCharProperty::uls_Word)
-	COMMAND_RTF_INT ( "ulwave",		charProps->m_eUnderStyle,	sCommand, true, RtfCharProperty::uls_Wave)
-
-	COMMAND_RTF_INT ( "up",			charProps->m_nUp,			sCommand, hasParameter, parameter)
-
-	COMMAND_RTF_INT ( "crauth",		charProps->m_nCrAuth,		sCommand, hasParameter, parameter)
-	COMMAND_RTF_INT ( "crdate",		charProps->m_nCrDate,		sCommand, hasParameter, parameter)
-	COMMAND_RTF_INT ( "insrsid",	charProps->m_nInsrsid,		sCommand, hasParameter, parameter)
-
-	COMMAND_RTF_INT ( "revauth",	charProps->m_nRevauth,		sCommand, hasParameter, parameter)
-	COMMAND_RTF_INT ( "revdttm",	charProps->m_nRevdttm,		sCommand, hasParameter, parameter)
-	COMMAND_RTF_INT ( "revauthdel",	charProps->m_nRevauthDel,	sCommand, hasParameter, parameter)
-	COMMAND_RTF_INT ( "revdttmdel",	charProps->m_nRevdttmDel,	sCommand, hasParameter, parameter)
-
-	else if ( "revised" == sCommand )
+	CASE_RTF_INT( uldash,		charProps->m_eUnderStyle, true, RtfCharProperty::uls_Dashed)
+	CASE_RTF_INT( uldashd,	charProps->m_eUnderStyle, true, RtfCharProperty::uls_Dash_dotted)
+	CASE_RTF_INT( uldashdd,	charProps->m_eUnderStyle, true, RtfCharProperty::uls_Dash_dot_dotted)
+	CASE_RTF_INT( uldb,		charProps->m_eUnderStyle, true, RtfCharProperty::uls_Double)
+	CASE_RTF_INT( ulhwave,	charProps->m_eUnderStyle, true, RtfCharProperty::uls_Heavy_wave)
+	CASE_RTF_INT( ulldash,	charProps->m_eUnderStyle, true, RtfCharProperty::uls_Long_dashe)
+	CASE_RTF_INT( ulnone,		charProps->m_eUnderStyle, true, RtfCharProperty::uls_none)
+	CASE_RTF_INT( ulth,		charProps->m_eUnderStyle, true, RtfCharProperty::uls_Thick)
+	CASE_RTF_INT( ulthd,		charProps->m_eUnderStyle, true, RtfCharProperty::uls_Thick_dotted)
+	CASE_RTF_INT( ulthdash,	charProps->m_eUnderStyle, true, RtfCharProperty::uls_Thick_dashed)
+	CASE_RTF_INT( ulthdashd,	charProps->m_eUnderStyle, true, RtfCharProperty::uls_Thick_dash_dotted)
+	CASE_RTF_INT( ulthdashdd,	charProps->m_eUnderStyle, true, RtfCharProperty::uls_Thick_dash_dot_dotted)
+	CASE_RTF_INT( ulthldash,	charProps->m_eUnderStyle, true, RtfCharProperty::uls_Thick_long_dashed)
+	CASE_RTF_INT( ululdbwave,	charProps->m_eUnderStyle, true, RtfCharProperty::uls_Double_wave)
+	CASE_RTF_INT( ulw,		charProps->m_eUnderStyle, true, RtfCharProperty::uls_Word)
+	CASE_RTF_INT( ulwave,		charProps->m_eUnderStyle, true, RtfCharProperty::uls_Wave)
+
+	CASE_RTF_INT( up,			charProps->m_nUp, hasParameter, parameter)
+
+	CASE_RTF_INT( crauth,		charProps->m_nCrAuth, hasParameter, parameter)
+	CASE_RTF_INT( crdate,		charProps->m_nCrDate, hasParameter, parameter)
+	CASE_RTF_INT( insrsid,	charProps->m_nInsrsid, hasParameter, parameter)
+
+	CASE_RTF_INT( revauth,	charProps->m_nRevauth, hasParameter, parameter)
+	CASE_RTF_INT( revdttm,	charProps->m_nRevdttm, hasParameter, parameter)
+	CASE_RTF_INT( revauthdel,	charProps->m_nRevauthDel, hasParameter, parameter)
+	CASE_RTF_INT( revdttmdel,	charProps->m_nRevdttmDel, hasParameter, parameter)
+
+	case RtfKeyword::kw_revised:
 	{
 		charProps->m_nRevised = 1;
-	}
-	else if ( "v" == sCommand )
+	}break;
+	case RtfKeyword::kw_v:
 	{
 		charProps->m_bHidden = 1;
-	}
-	else if ( "deleted" == sCommand )
+	}break;
+	case RtfKeyword::kw_deleted:
 	{
 		charProps->m_nDeleted = 1;
-	}
-	else if ( "nosupersub" == sCommand )
+	}break;
+	case RtfKeyword::kw_nosupersub:
 	{
 		charProps->m_bSub	= 0;
 		charProps->m_bSuper  = 0;
-	}
-	else if ( "nosectexpand" == sCommand )
+	}break;
+	case RtfKeyword::kw_nosectexpand:
 	{
 		charProps->m_nCharacterSpacing  = PROP_DEF;
-	}
+	}break;
 #ifdef USE_STYLE_COLOR
-    else if (("sbasedon" == sCommand) && (charProps->m_bBold == PROP_DEF))
+    case RtfKeyword::kw_sbasedon:
     {
+        if (charProps->m_bBold != PROP_DEF)
+            return false;
+
         charProps->m_bBold = 0;
-    }
+    }break;
 #endif
-	else
+	default:
 	{
 		if (RtfShadingCharCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, charProps->m_poShading))
 			return true;
@@ -1287,25 +1326,36 @@ bool RtfCharPropsCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader& oRea
 		{
 			charProps->m_bAssociated = true;
 			sCommand = sCommand.substr(1);
-			return ExecuteCommand(oDocument, oReader, sCommand, hasParameter, parameter, charProps, bLookOnBorder);
+
+			//keyword без префикса 'a' - единственное место, где номер ищется заново
+			RtfKeyword::_Keyword eTokenKeyword = oReader.m_eKeyword;
+			oReader.m_eKeyword = RtfKeyword::Find(sCommand);
+
+			bool bResult = ExecuteCommand(oDocument, oReader, sCommand, hasParameter, parameter, charProps, bLookOnBorder);
+
+			oReader.m_eKeyword = eTokenKeyword;
+			return bResult;
 		}
 		
 		return false;
 	}
+	}
 	return true;
 }
 bool RtfParagraphPropsCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader& oReader,  std::string sCommand, bool hasParameter, int parameter, RtfParagraphProperty * paragraphProps)
 {
 	if (!paragraphProps) return false;
 
-	if ( "pard" == sCommand )
+	switch (oReader.m_eKeyword)
+	{
+	case RtfKeyword::kw_pard:
 	{
 		paragraphProps->SetDefaultRtf();
-	}
-	COMMAND_RTF_INT	( "outlinelevel",		paragraphProps->m_nOutlinelevel,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "hyphpar",			paragraphProps->m_bAutoHyphenation,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "contextualspace",	paragraphProps->m_bContextualSpacing,	sCommand, hasParameter, parameter )
-	else if ( "intbl" == sCommand )
+	}break;
+	CASE_RTF_INT( outlinelevel,		paragraphProps->m_nOutlinelevel, hasParameter, parameter )
+	CASE_RTF_BOOL( hyphpar,			paragraphProps->m_bAutoHyphenation, hasParameter, parameter )
+	CASE_RTF_BOOL( contextualspace,	paragraphProps->m_bContextualSpacing, hasParameter, parameter )
+	case RtfKeyword::kw_intbl:
 	{
 		if ( hasParameter && 0 == parameter )
 		{
@@ -1319,9 +1369,11 @@ bool RtfParagraphPropsCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader&
 			if ( PROP_DEF == paragraphProps->m_nItap)
 				paragraphProps->m_nItap = 1;
 		}
-	}
-	else if ( "itap" == sCommand && hasParameter)
+	}break;
+	case RtfKeyword::kw_itap:
 	{
+		if (false == hasParameter)
+			return false;
 		//if (parameter == 0 && paragraphProps->m_bInTable && paragraphProps->m_nItap > 0)
 		//{
 		//
@@ -1329,55 +1381,58 @@ bool RtfParagraphPropsCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader&
 		//}
 		//else
 		paragraphProps->m_nItap = parameter;
-	}
-	COMMAND_RTF_BOOL( "keep",	paragraphProps->m_bKeep,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "keepn", paragraphProps->m_bKeepNext, sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "pagebb", paragraphProps->m_bPageBB,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT	( "s",		paragraphProps->m_nStyle,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT	( "qc",	paragraphProps->m_eAlign,	sCommand, true, RtfParagraphProperty::pa_qc )
-	COMMAND_RTF_INT	( "qj",	paragraphProps->m_eAlign,	sCommand, true, RtfParagraphProperty::pa_qj )
-	COMMAND_RTF_INT	( "ql",	paragraphProps->m_eAlign,	sCommand, true, RtfParagraphProperty::pa_ql )
-	COMMAND_RTF_INT	( "qr",	paragraphProps->m_eAlign,	sCommand, true, RtfParagraphProperty::pa_qr )
-	COMMAND_RTF_INT	( "qd",	paragraphProps->m_eAlign,	sCommand, true, RtfParagraphProperty::pa_qd )
-
-	else if ( "qk0" == sCommand )
+	}break;
+	CASE_RTF_BOOL( keep,	paragraphProps->m_bKeep, hasParameter, parameter )
+	CASE_RTF_BOOL( keepn, paragraphProps->m_bKeepNext, hasParameter, parameter )
+	CASE_RTF_BOOL( pagebb, paragraphProps->m_bPageBB, hasParameter, parameter )
+	CASE_RTF_INT( s,		paragraphProps->m_nStyle, hasParameter, parameter )
+	CASE_RTF_INT( qc,	paragraphProps->m_eAlign, true, RtfParagraphProperty::pa_qc )
+	CASE_RTF_INT( qj,	paragraphProps->m_eAlign, true, RtfParagraphProperty::pa_qj )
+	CASE_RTF_INT( ql,	paragraphProps->m_eAlign, true, RtfParagraphProperty::pa_ql )
+	CASE_RTF_INT( qr,	paragraphProps->m_eAlign, true, RtfParagraphProperty::pa_qr )
+	CASE_RTF_INT( qd,	paragraphProps->m_eAlign, true, RtfParagraphProperty::pa_qd )
+	case RtfKeyword::kw_qk:
 	{
-		switch( parameter )
+		if ( hasParameter )
 		{
-		case 0:		paragraphProps->m_eAlign= RtfParagraphProperty::pa_qk0;		break;
-		case 10:	paragraphProps->m_eAlign = RtfParagraphProperty::pa_qk10;	break;
-		case 20:	paragraphProps->m_eAlign = RtfParagraphProperty::pa_qk20;	break;
-
+			switch( parameter )
+			{
+			case 0:		paragraphProps->m_eAlign = RtfParagraphProperty::pa_qk0;	break;
+			case 10:	paragraphProps->m_eAlign = RtfParagraphProperty::pa_qk10;	break;
+			case 20:	paragraphProps->m_eAlign = RtfParagraphProperty::pa_qk20;	break;
+			default:
+				break;
+			}
 		}
-	}
-	COMMAND_RTF_INT ( "faauto",		paragraphProps->m_eFontAlign,		sCommand, true, RtfParagraphProperty::fa_faauto )
-	COMMAND_RTF_INT ( "fahang",		paragraphProps->m_eFontAlign,		sCommand, true, RtfParagraphProperty::fa_fahang )
-	COMMAND_RTF_INT ( "facenter",	paragraphProps->m_eFontAlign,		sCommand, true, RtfParagraphProperty::fa_facenter )
-	COMMAND_RTF_INT ( "faroman",	paragraphProps->m_eFontAlign,		sCommand, true, RtfParagraphProperty::fa_faroman )
-	COMMAND_RTF_INT ( "favar",		paragraphProps->m_eFontAlign,		sCommand, true, RtfParagraphProperty::fa_favar )
-	COMMAND_RTF_INT ( "fafixed",	paragraphProps->m_eFontAlign,		sCommand, true, RtfParagraphProperty::fa_fafixed )
-	COMMAND_RTF_INT ( "fi",			paragraphProps->m_nIndFirstLine,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "li",			paragraphProps->m_nIndLeft,			sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "ri",			paragraphProps->m_nIndRight,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "lin",		paragraphProps->m_nIndStart,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "rin",		paragraphProps->m_nIndEnd,			sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "adjustright",paragraphProps->m_bIndRightAuto,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "indmirror",	paragraphProps->m_bIndMirror,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "sb",			paragraphProps->m_nSpaceBefore,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "sa",			paragraphProps->m_nSpaceAfter,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "sbauto",		paragraphProps->m_nSpaceBeforeAuto,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "saauto",		paragraphProps->m_nSpaceAfterAuto,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "lisb",		paragraphProps->m_nSpaceBeforeLine,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "lisa",		paragraphProps->m_nSpaceAfterLine,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "slmult",		paragraphProps->m_nSpaceMultiLine,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "ilvl",		paragraphProps->m_nListLevel,		sCommand, hasParameter, parameter )
-
-	COMMAND_RTF_BOOL( "absnoovrlp",	paragraphProps->m_bOverlap,			sCommand, hasParameter, parameter )
+	}break;
+	CASE_RTF_INT( faauto,		paragraphProps->m_eFontAlign, true, RtfParagraphProperty::fa_faauto )
+	CASE_RTF_INT( fahang,		paragraphProps->m_eFontAlign, true, RtfParagraphProperty::fa_fahang )
+	CASE_RTF_INT( facenter,	paragraphProps->m_eFontAlign, true, RtfParagraphProperty::fa_facenter )
+	CASE_RTF_INT( faroman,	paragraphProps->m_eFontAlign, true, RtfParagraphProperty::fa_faroman )
+	CASE_RTF_INT( favar,		paragraphProps->m_eFontAlign, true, RtfParagraphProperty::fa_favar )
+	CASE_RTF_INT( fafixed,	paragraphProps->m_eFontAlign, true, RtfParagraphProperty::fa_fafixed )
+	CASE_RTF_INT( fi,			paragraphProps->m_nIndFirstLine, hasParameter, parameter )
+	CASE_RTF_INT( li,			paragraphProps->m_nIndLeft, hasParameter, parameter )
+	CASE_RTF_INT( ri,			paragraphProps->m_nIndRight, hasParameter, parameter )
+	CASE_RTF_INT( lin,		paragraphProps->m_nIndStart, hasParameter, parameter )
+	CASE_RTF_INT( rin,		paragraphProps->m_nIndEnd, hasParameter, parameter )
+	CASE_RTF_BOOL( adjustright,paragraphProps->m_bIndRightAuto, hasParameter, parameter )
+	CASE_RTF_BOOL( indmirror,	paragraphProps->m_bIndMirror, hasParameter, parameter )
+	CASE_RTF_INT( sb,			paragraphProps->m_nSpaceBefore, hasParameter, parameter )
+	CASE_RTF_INT( sa,			paragraphProps->m_nSpaceAfter, hasParameter, parameter )
+	CASE_RTF_INT( sbauto,		paragraphProps->m_nSpaceBeforeAuto, hasParameter, parameter )
+	CASE_RTF_INT( saauto,		paragraphProps->m_nSpaceAfterAuto, hasParameter, parameter )
+	CASE_RTF_INT( lisb,		paragraphProps->m_nSpaceBeforeLine, hasParameter, parameter )
+	CASE_RTF_INT( lisa,		paragraphProps->m_nSpaceAfterLine, hasParameter, parameter )
+	CASE_RTF_INT( slmult,		paragraphProps->m_nSpaceMultiLine, hasParameter, parameter )
+	CASE_RTF_INT( ilvl,		paragraphProps->m_nListLevel, hasParameter, parameter )
+
+	CASE_RTF_BOOL( absnoovrlp,	paragraphProps->m_bOverlap, hasParameter, parameter )
 //changes
-	COMMAND_RTF_INT ( "prdate",		paragraphProps->m_nPrDate,			sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "prauth",		paragraphProps->m_nPrAuth,			sCommand, hasParameter, parameter )
+	CASE_RTF_INT( prdate,		paragraphProps->m_nPrDate, hasParameter, parameter )
+	CASE_RTF_INT( prauth,		paragraphProps->m_nPrAuth, hasParameter, parameter )
 
-	else if ( "sl" == sCommand )
+	case RtfKeyword::kw_sl:
 	{
 		if ( hasParameter )
 		{
@@ -1385,18 +1440,11 @@ bool RtfParagraphPropsCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader&
 			if ( PROP_DEF == paragraphProps->m_nSpaceMultiLine )
 				paragraphProps->m_nSpaceMultiLine = 0;
 		}
-	}
-	else if ( "rtlpar" == sCommand )		paragraphProps->m_bRtl = 1;
-	else if ( "ltrpar" == sCommand )		paragraphProps->m_bRtl = 0;
-	COMMAND_RTF_BOOL( "nowwrap", paragraphProps->m_bNoWordWrap, sCommand, hasParameter, parameter )
-	else if ( "nowwrap" == sCommand )
-	{
-		if ( hasParameter && 0 == parameter)
-			paragraphProps->m_bSnapToGrid = 1;
-		else
-			paragraphProps->m_bSnapToGrid = 0;
-	}
-	else if ( "ls" == sCommand )
+	}break;
+	case RtfKeyword::kw_rtlpar:	paragraphProps->m_bRtl = 1; break;
+	case RtfKeyword::kw_ltrpar:	paragraphProps->m_bRtl = 0; break;
+	CASE_RTF_BOOL( nowwrap, paragraphProps->m_bNoWordWrap, hasParameter, parameter )
+	case RtfKeyword::kw_ls:
 	{
 		if ( hasParameter )
 		{
@@ -1404,54 +1452,55 @@ bool RtfParagraphPropsCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader&
 			if ( PROP_DEF == paragraphProps->m_nListLevel )
 				paragraphProps->m_nListLevel = 0;
 		}
-	}
+	}break;
 //Frame
-	COMMAND_RTF_INT ( "absw",			paragraphProps->m_oFrame.m_nWidth,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "absh",			paragraphProps->m_oFrame.m_nHeight,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "phmrg",			paragraphProps->m_oFrame.m_eHRef,		sCommand, true, RtfFrame::hr_phmrg )
-	COMMAND_RTF_INT ( "phpg",			paragraphProps->m_oFrame.m_eHRef,		sCommand, true, RtfFrame::hr_phpg )
-	COMMAND_RTF_INT ( "phcol",			paragraphProps->m_oFrame.m_eHRef,		sCommand, true, RtfFrame::hr_phcol )
-	COMMAND_RTF_INT ( "posx",			paragraphProps->m_oFrame.m_nHPos,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "posnegx",		paragraphProps->m_oFrame.m_nHPos,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "posxc",			paragraphProps->m_oFrame.m_eHPos,		sCommand, true, RtfFrame::hp_posxc )
-	COMMAND_RTF_INT ( "posxi",			paragraphProps->m_oFrame.m_eHPos,		sCommand, true, RtfFrame::hp_posxi )
-	COMMAND_RTF_INT ( "posxo",			paragraphProps->m_oFrame.m_eHPos,		sCommand, true, RtfFrame::hp_posxo )
-	COMMAND_RTF_INT ( "posxl",			paragraphProps->m_oFrame.m_eHPos,		sCommand, true, RtfFrame::hp_posxl )
-	COMMAND_RTF_INT ( "posxr",			paragraphProps->m_oFrame.m_eHPos,		sCommand, true, RtfFrame::hp_posxr )
-	COMMAND_RTF_INT ( "pvmrg",			paragraphProps->m_oFrame.m_eVRef,		sCommand, true, RtfFrame::vr_pvmrg )
-	COMMAND_RTF_INT ( "pvpg",			paragraphProps->m_oFrame.m_eVRef,		sCommand, true, RtfFrame::vr_pvpg )
-	COMMAND_RTF_INT ( "pvpara",			paragraphProps->m_oFrame.m_eVRef,		sCommand, true, RtfFrame::vr_pvpara )
-	COMMAND_RTF_INT ( "posy",			paragraphProps->m_oFrame.m_nVPos,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "posnegy",		paragraphProps->m_oFrame.m_nVPos,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "posyt",			paragraphProps->m_oFrame.m_eVPos,		sCommand, true, RtfFrame::vp_posyt )
-	COMMAND_RTF_INT ( "posyil",			paragraphProps->m_oFrame.m_eVPos,		sCommand, true, RtfFrame::vp_posyil )
-	COMMAND_RTF_INT ( "posyb",			paragraphProps->m_oFrame.m_eVPos,		sCommand, true, RtfFrame::vp_posyb )
-	COMMAND_RTF_INT ( "posyc",			paragraphProps->m_oFrame.m_eVPos,		sCommand, true, RtfFrame::vp_posyc )
-	COMMAND_RTF_INT ( "posyin",			paragraphProps->m_oFrame.m_eVPos,		sCommand, true, RtfFrame::vp_posyin )
-	COMMAND_RTF_INT ( "posyout",		paragraphProps->m_oFrame.m_eVPos,		sCommand, true, RtfFrame::vp_posyout )
-	COMMAND_RTF_BOOL( "abslock",		paragraphProps->m_oFrame.m_bLockAnchor, sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "wrapdefault",	paragraphProps->m_oFrame.m_eWrap,		sCommand, true, RtfFrame::tw_wrapdefault )
-	COMMAND_RTF_INT ( "wraparound",		paragraphProps->m_oFrame.m_eWrap,		sCommand, true, RtfFrame::tw_wraparound )
-	COMMAND_RTF_INT ( "wraptight",		paragraphProps->m_oFrame.m_eWrap,		sCommand, true, RtfFrame::tw_wraptight )
-	COMMAND_RTF_INT ( "wrapthrough",	paragraphProps->m_oFrame.m_eWrap,		sCommand, true, RtfFrame::tw_wrapthrough )
-	COMMAND_RTF_INT ( "dropcapt",		paragraphProps->m_oFrame.m_DropcapType, sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "dropcapli",		paragraphProps->m_oFrame.m_DropcapLines, sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "dxfrtext",		paragraphProps->m_oFrame.m_nAllSpace,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "dfrmtxtx",		paragraphProps->m_oFrame.m_nHorSpace,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "dfrmtxty",		paragraphProps->m_oFrame.m_nVerSpace,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "frmtxlrtb",		paragraphProps->m_eTextFollow,			sCommand, true, RtfParagraphProperty::tf_frmtxlrtb )
-	COMMAND_RTF_INT ( "frmtxtbrl",		paragraphProps->m_eTextFollow,			sCommand, true, RtfParagraphProperty::tf_frmtxtbrl )
-	COMMAND_RTF_INT ( "frmtxbtlr",		paragraphProps->m_eTextFollow,			sCommand, true, RtfParagraphProperty::tf_frmtxbtlr )
-	COMMAND_RTF_INT ( "frmtxlrtbv",		paragraphProps->m_eTextFollow,			sCommand, true, RtfParagraphProperty::tf_frmtxlrtbv )
-	COMMAND_RTF_INT ( "frmtxtbrlv",		paragraphProps->m_eTextFollow,			sCommand, true, RtfParagraphProperty::tf_frmtxtbrlv )
-
-	else
+	CASE_RTF_INT( absw,			paragraphProps->m_oFrame.m_nWidth, hasParameter, parameter )
+	CASE_RTF_INT( absh,			paragraphProps->m_oFrame.m_nHeight, hasParameter, parameter )
+	CASE_RTF_INT( phmrg,			paragraphProps->m_oFrame.m_eHRef, true, RtfFrame::hr_phmrg )
+	CASE_RTF_INT( phpg,			paragraphProps->m_oFrame.m_eHRef, true, RtfFrame::hr_phpg )
+	CASE_RTF_INT( phcol,			paragraphProps->m_oFrame.m_eHRef, true, RtfFrame::hr_phcol )
+	CASE_RTF_INT( posx,			paragraphProps->m_oFrame.m_nHPos, hasParameter, parameter )
+	CASE_RTF_INT( posnegx,		paragraphProps->m_oFrame.m_nHPos, hasParameter, parameter )
+	CASE_RTF_INT( posxc,			paragraphProps->m_oFrame.m_eHPos, true, RtfFrame::hp_posxc )
+	CASE_RTF_INT( posxi,			paragraphProps->m_oFrame.m_eHPos, true, RtfFrame::hp_posxi )
+	CASE_RTF_INT( posxo,			paragraphProps->m_oFrame.m_eHPos, true, RtfFrame::hp_posxo )
+	CASE_RTF_INT( posxl,			paragraphProps->m_oFrame.m_eHPos, true, RtfFrame::hp_posxl )
+	CASE_RTF_INT( posxr,			paragraphProps->m_oFrame.m_eHPos, true, RtfFrame::hp_posxr )
+	CASE_RTF_INT( pvmrg,			paragraphProps->m_oFrame.m_eVRef, true, RtfFrame::vr_pvmrg )
+	CASE_RTF_INT( pvpg,			paragraphProps->m_oFrame.m_eVRef, true, RtfFrame::vr_pvpg )
+	CASE_RTF_INT( pvpara,			paragraphProps->m_oFrame.m_eVRef, true, RtfFrame::vr_pvpara )
+	CASE_RTF_INT( posy,			paragraphProps->m_oFrame.m_nVPos, hasParameter, parameter )
+	CASE_RTF_INT( posnegy,		paragraphProps->m_oFrame.m_nVPos, hasParameter, parameter )
+	CASE_RTF_INT( posyt,			paragraphProps->m_oFrame.m_eVPos, true, RtfFrame::vp_posyt )
+	CASE_RTF_INT( posyil,			paragraphProps->m_oFrame.m_eVPos, true, RtfFrame::vp_posyil )
+	CASE_RTF_INT( posyb,			paragraphProps->m_oFrame.m_eVPos, true, RtfFrame::vp_posyb )
+	CASE_RTF_INT( posyc,			paragraphProps->m_oFrame.m_eVPos, true, RtfFrame::vp_posyc )
+	CASE_RTF_INT( posyin,			paragraphProps->m_oFrame.m_eVPos, true, RtfFrame::vp_posyin )
+	CASE_RTF_INT( posyout,		paragraphProps->m_oFrame.m_eVPos, true, RtfFrame::vp_posyout )
+	CASE_RTF_BOOL( abslock,		paragraphProps->m_oFrame.m_bLockAnchor, hasParameter, parameter )
+	CASE_RTF_INT( wrapdefault,	paragraphProps->m_oFrame.m_eWrap, true, RtfFrame::tw_wrapdefault )
+	CASE_RTF_INT( wraparound,		paragraphProps->m_oFrame.m_eWrap, true, RtfFrame::tw_wraparound )
+	CASE_RTF_INT( wraptight,		paragraphProps->m_oFrame.m_eWrap, true, RtfFrame::tw_wraptight )
+	CASE_RTF_INT( wrapthrough,	paragraphProps->m_oFrame.m_eWrap, true, RtfFrame::tw_wrapthrough )
+	CASE_RTF_INT( dropcapt,		paragraphProps->m_oFrame.m_DropcapType, hasParameter, parameter )
+	CASE_RTF_INT( dropcapli,		paragraphProps->m_oFrame.m_DropcapLines, hasParameter, parameter )
+	CASE_RTF_INT( dxfrtext,		paragraphProps->m_oFrame.m_nAllSpace, hasParameter, parameter )
+	CASE_RTF_INT( dfrmtxtx,		paragraphProps->m_oFrame.m_nHorSpace, hasParameter, parameter )
+	CASE_RTF_INT( dfrmtxty,		paragraphProps->m_oFrame.m_nVerSpace, hasParameter, parameter )
+	CASE_RTF_INT( frmtxlrtb,		paragraphProps->m_eTextFollow, true, RtfParagraphProperty::tf_frmtxlrtb )
+	CASE_RTF_INT( frmtxtbrl,		paragraphProps->m_eTextFollow, true, RtfParagraphProperty::tf_frmtxtbrl )
+	CASE_RTF_INT( frmtxbtlr,		paragraphProps->m_eTextFollow, true, RtfParagraphProperty::tf_frmtxbtlr )
+	CASE_RTF_INT( frmtxlrtbv,		paragraphProps->m_eTextFollow, true, RtfParagraphProperty::tf_frmtxlrtbv )
+	CASE_RTF_INT( frmtxtbrlv,		paragraphProps->m_eTextFollow, true, RtfParagraphProperty::tf_frmtxtbrlv )
+
+	default:
 	{
 		if (RtfShadingCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, oReader.m_oState->m_oParagraphProp.m_oShading ))
 			return true;
 
 		return false;
 	}
+	}
 	return true;
 }
 
@@ -1459,32 +1508,34 @@ bool RtfTableCellPropsCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader&
 {
 	if (!cellProps) return false;
 
-	COMMAND_RTF_BOOL( "clmgf",		cellProps->m_bMergeFirst,			sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "clmrg",		cellProps->m_bMerge,				sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "clvmgf",		cellProps->m_bMergeFirstVertical,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "clvmrg",		cellProps->m_bMergeVertical,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "clFitText",	cellProps->m_bFitText,				sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "clNoWrap",	cellProps->m_bNoWrap,				sCommand, hasParameter, parameter )
+	switch (oReader.m_eKeyword)
+	{
+	CASE_RTF_BOOL( clmgf,		cellProps->m_bMergeFirst, hasParameter, parameter )
+	CASE_RTF_BOOL( clmrg,		cellProps->m_bMerge, hasParameter, parameter )
+	CASE_RTF_BOOL( clvmgf,		cellProps->m_bMergeFirstVertical, hasParameter, parameter )
+	CASE_RTF_BOOL( clvmrg,		cellProps->m_bMergeVertical, hasParameter, parameter )
+	CASE_RTF_BOOL( clFitText,	cellProps->m_bFitText, hasParameter, parameter )
+	CASE_RTF_BOOL( clNoWrap,	cellProps->m_bNoWrap, hasParameter, parameter )
 //https://www.office-forums.com/threads/rtf-file-weirdness-clpadt-vs-clpadl.2163500/
-	COMMAND_RTF_INT ( "clpadft",	cellProps->m_ePaddingLeftUnit,		sCommand, hasParameter, parameter )	//перепутаны top & left
-	COMMAND_RTF_INT ( "clpadt",		cellProps->m_nPaddingLeft,			sCommand, hasParameter, parameter )	//перепутаны top & left
-	COMMAND_RTF_INT ( "clpadfl",	cellProps->m_ePaddingTopUnit,		sCommand, hasParameter, parameter )	//перепутаны top & left
-	COMMAND_RTF_INT ( "clpadl",		cellProps->m_nPaddingTop,			sCommand, hasParameter, parameter )	//перепутаны top & left
-	COMMAND_RTF_INT ( "clpadfr",	cellProps->m_ePaddingRightUnit,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "clpadr",		cellProps->m_nPaddingRight,			sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "clpadfb",	cellProps->m_ePaddingBottomUnit,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "clpadb",		cellProps->m_nPaddingBottom,		sCommand, hasParameter, parameter )
-
-	COMMAND_RTF_INT ( "clspfl",		cellProps->m_eSpacingLeftUnit,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "clspl",		cellProps->m_nSpacingLeft,			sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "clspft",		cellProps->m_eSpacingTopUnit,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "clspt",		cellProps->m_nSpacingTop,			sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "clspfr",		cellProps->m_eSpacingRightUnit,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "clspr",		cellProps->m_nSpacingRight,			sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "clspfb",		cellProps->m_eSpacingBottomUnit,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "clspb",		cellProps->m_nSpacingBottom,		sCommand, hasParameter, parameter )
-
-			else if ( "clftsWidth" == sCommand  )
+	CASE_RTF_INT( clpadft,	cellProps->m_ePaddingLeftUnit, hasParameter, parameter )	//перепутаны top & left
+	CASE_RTF_INT( clpadt,		cellProps->m_nPaddingLeft, hasParameter, parameter )	//перепутаны top & left
+	CASE_RTF_INT( clpadfl,	cellProps->m_ePaddingTopUnit, hasParameter, parameter )	//перепутаны top & left
+	CASE_RTF_INT( clpadl,		cellProps->m_nPaddingTop, hasParameter, parameter )	//перепутаны top & left
+	CASE_RTF_INT( clpadfr,	cellProps->m_ePaddingRightUnit, hasParameter, parameter )
+	CASE_RTF_INT( clpadr,		cellProps->m_nPaddingRight, hasParameter, parameter )
+	CASE_RTF_INT( clpadfb,	cellProps->m_ePaddingBottomUnit, hasParameter, parameter )
+	CASE_RTF_INT( clpadb,		cellProps->m_nPaddingBottom, hasParameter, parameter )
+
+	CASE_RTF_INT( clspfl,		cellProps->m_eSpacingLeftUnit, hasParameter, parameter )
+	CASE_RTF_INT( clspl,		cellProps->m_nSpacingLeft, hasParameter, parameter )
+	CASE_RTF_INT( clspft,		cellProps->m_eSpacingTopUnit, hasParameter, parameter )
+	CASE_RTF_INT( clspt,		cellProps->m_nSpacingTop, hasParameter, parameter )
+	CASE_RTF_INT( clspfr,		cellProps->m_eSpacingRightUnit, hasParameter, parameter )
+	CASE_RTF_INT( clspr,		cellProps->m_nSpacingRight, hasParameter, parameter )
+	CASE_RTF_INT( clspfb,		cellProps->m_eSpacingBottomUnit, hasParameter, parameter )
+	CASE_RTF_INT( clspb,		cellProps->m_nSpacingBottom, hasParameter, parameter )
+
+	case RtfKeyword::kw_clftsWidth:
 	{
 		if ( hasParameter )
 		{
@@ -1498,38 +1549,39 @@ bool RtfTableCellPropsCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader&
 				break;
 			}
 		}
-	}
-	COMMAND_RTF_INT ( "clwWidth",	cellProps->m_nWidth,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "clhidemark",	cellProps->m_bHideMark,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "clvertalt",	cellProps->m_eAlign,		sCommand, true, RtfCellProperty::ca_Top )
-	COMMAND_RTF_INT ( "clvertalc",	cellProps->m_eAlign,		sCommand, true, RtfCellProperty::ca_Center )
-	COMMAND_RTF_INT ( "clvertalb",	cellProps->m_eAlign,		sCommand, true, RtfCellProperty::ca_Bottom )
-	COMMAND_RTF_INT ( "cltxlrtb",	cellProps->m_oCellFlow,		sCommand, true, RtfCellProperty::cf_lrtb )
-	COMMAND_RTF_INT ( "cltxtbrl",	cellProps->m_oCellFlow,		sCommand, true, RtfCellProperty::cf_tbrl )
-	COMMAND_RTF_INT ( "cltxbtlr",	cellProps->m_oCellFlow,		sCommand, true, RtfCellProperty::cf_btlr )
-	COMMAND_RTF_INT ( "cltxlrtbv",	cellProps->m_oCellFlow,		sCommand, true, RtfCellProperty::cf_lrtbv )
-	COMMAND_RTF_INT ( "cltxtbrlv",	cellProps->m_oCellFlow,		sCommand, true, RtfCellProperty::cf_tbrlv )
+	}break;
+	CASE_RTF_INT( clwWidth,	cellProps->m_nWidth, hasParameter, parameter )
+	CASE_RTF_BOOL( clhidemark,	cellProps->m_bHideMark, hasParameter, parameter )
+	CASE_RTF_INT( clvertalt,	cellProps->m_eAlign, true, RtfCellProperty::ca_Top )
+	CASE_RTF_INT( clvertalc,	cellProps->m_eAlign, true, RtfCellProperty::ca_Center )
+	CASE_RTF_INT( clvertalb,	cellProps->m_eAlign, true, RtfCellProperty::ca_Bottom )
+	CASE_RTF_INT( cltxlrtb,	cellProps->m_oCellFlow, true, RtfCellProperty::cf_lrtb )
+	CASE_RTF_INT( cltxtbrl,	cellProps->m_oCellFlow, true, RtfCellProperty::cf_tbrl )
+	CASE_RTF_INT( cltxbtlr,	cellProps->m_oCellFlow, true, RtfCellProperty::cf_btlr )
+	CASE_RTF_INT( cltxlrtbv,	cellProps->m_oCellFlow, true, RtfCellProperty::cf_lrtbv )
+	CASE_RTF_INT( cltxtbrlv,	cellProps->m_oCellFlow, true, RtfCellProperty::cf_tbrlv )
 
 			//table style
-	COMMAND_RTF_INT ( "tscellpaddfl",	cellProps->m_ePaddingLeftUnit,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tscellpaddl",	cellProps->m_nPaddingLeft,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tscellpaddft",	cellProps->m_ePaddingTopUnit,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tscellpaddt",	cellProps->m_nPaddingTop,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tscellpaddfr",	cellProps->m_ePaddingRightUnit,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tscellpaddr",	cellProps->m_nPaddingRight,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tscellpaddfb",	cellProps->m_ePaddingBottomUnit,sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tscellpaddb",	cellProps->m_nPaddingBottom,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tsnowrap",		cellProps->m_bNoWrap,			sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tsvertalt",		cellProps->m_eAlign,			sCommand, true, RtfCellProperty::ca_Top )
-	COMMAND_RTF_INT ( "tsvertalc",		cellProps->m_eAlign,			sCommand, true, RtfCellProperty::ca_Center )
-	COMMAND_RTF_INT ( "tsvertalb",		cellProps->m_eAlign,			sCommand, true, RtfCellProperty::ca_Bottom )
-			else
+	CASE_RTF_INT( tscellpaddfl,	cellProps->m_ePaddingLeftUnit, hasParameter, parameter )
+	CASE_RTF_INT( tscellpaddl,	cellProps->m_nPaddingLeft, hasParameter, parameter )
+	CASE_RTF_INT( tscellpaddft,	cellProps->m_ePaddingTopUnit, hasParameter, parameter )
+	CASE_RTF_INT( tscellpaddt,	cellProps->m_nPaddingTop, hasParameter, parameter )
+	CASE_RTF_INT( tscellpaddfr,	cellProps->m_ePaddingRightUnit, hasParameter, parameter )
+	CASE_RTF_INT( tscellpaddr,	cellProps->m_nPaddingRight, hasParameter, parameter )
+	CASE_RTF_INT( tscellpaddfb,	cellProps->m_ePaddingBottomUnit, hasParameter, parameter )
+	CASE_RTF_INT( tscellpaddb,	cellProps->m_nPaddingBottom, hasParameter, parameter )
+	CASE_RTF_BOOL( tsnowrap,		cellProps->m_bNoWrap, hasParameter, parameter )
+	CASE_RTF_INT( tsvertalt,		cellProps->m_eAlign, true, RtfCellProperty::ca_Top )
+	CASE_RTF_INT( tsvertalc,		cellProps->m_eAlign, true, RtfCellProperty::ca_Center )
+	CASE_RTF_INT( tsvertalb,		cellProps->m_eAlign, true, RtfCellProperty::ca_Bottom )
+	default:
 	{
 		if (RtfShadingCellCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, cellProps->m_oShading ))
 			return true;
 		
 		return false;
 	}
+	}
 	return true;
 }
 
@@ -1537,73 +1589,75 @@ bool RtfTableRowPropsCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader&
 {
 	if (!rowProps) return false;
 	
-	if ( "trowd" == sCommand )
+	switch (oReader.m_eKeyword)
+	{
+	case RtfKeyword::kw_trowd:
 	{
 		rowProps->SetDefaultRtf();
-	}
-	else if ( "nesttableprops" == sCommand )
+	}break;
+	case RtfKeyword::kw_nesttableprops:
 	{
 		rowProps->SetDefaultRtf();
-	}
+	}break;
 	
-	COMMAND_RTF_INT	( "irow",			rowProps->m_nIndex,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT	( "irowband",		rowProps->m_nBandIndex,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "lastrow",		rowProps->m_bLastRow,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "trhdr",			rowProps->m_bIsHeader,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "trkeep",			rowProps->m_bKeep,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "trkeepfollow",	rowProps->m_bKeep,		sCommand, hasParameter, parameter )
-
-	COMMAND_RTF_INT	( "trql",			rowProps->m_eJust,		sCommand, true, RtfRowProperty::rj_trql )
-	COMMAND_RTF_INT	( "trqr",			rowProps->m_eJust,		sCommand, true, RtfRowProperty::rj_trqr )
-	COMMAND_RTF_INT	( "trqc",			rowProps->m_eJust,		sCommand, true, RtfRowProperty::rj_trqc )
-
-	COMMAND_RTF_INT	( "trrh",			rowProps->m_nHeight,				sCommand, hasParameter, parameter )
-
-	COMMAND_RTF_INT ( "trftsWidth",		rowProps->m_eWidthUnit,				sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trwWidth",		rowProps->m_nWidth,					sCommand, hasParameter, parameter )
-
-	COMMAND_RTF_INT ( "trftsWidthB",	rowProps->m_eWidthStartInvCellUnit, sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trwWidthB",		rowProps->m_nWidthStartInvCell,		sCommand, hasParameter, parameter )
-
-	COMMAND_RTF_INT ( "trftsWidthA",	rowProps->m_eWidthEndInvCellUnit,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trwWidthA",		rowProps->m_nWidthEndInvCell,		sCommand, hasParameter, parameter )
-
-	COMMAND_RTF_BOOL( "taprtl",			rowProps->m_bBidi,				sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trautofit",		rowProps->m_nAutoFit,			sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trgaph",			rowProps->m_nGraph,				sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tblind",			rowProps->nTableIndent,			sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tblindtype",		rowProps->eTableIndentUnit,		sCommand, hasParameter, parameter )
-
-	COMMAND_RTF_INT ( "tdfrmtxtLeft",	rowProps->m_nWrapLeft,			sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tdfrmtxtRight",	rowProps->m_nWrapRight,			sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tdfrmtxtTop",	rowProps->m_nWrapTop,			sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tdfrmtxtBottom", rowProps->m_nWrapBottom,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tabsnoovrlp",	rowProps->m_bOverlap,			sCommand, hasParameter, parameter )
-
-	COMMAND_RTF_INT ( "tphmrg",			rowProps->m_eHRef, sCommand, true, RtfTableProperty::hr_phmrg )
-	COMMAND_RTF_INT ( "tphpg",			rowProps->m_eHRef, sCommand, true, RtfTableProperty::hr_phpg )
-	COMMAND_RTF_INT ( "tphcol",			rowProps->m_eHRef, sCommand, true, RtfTableProperty::hr_phcol )
-	COMMAND_RTF_INT ( "tposx",			rowProps->m_nHPos, sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tposnegx",		rowProps->m_nHPos, sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tposxc",			rowProps->m_eHPos, sCommand, true, RtfTableProperty::hp_posxc )
-	COMMAND_RTF_INT ( "tposxi",			rowProps->m_eHPos, sCommand, true, RtfTableProperty::hp_posxi )
-	COMMAND_RTF_INT ( "tposxo",			rowProps->m_eHPos, sCommand, true, RtfTableProperty::hp_posxo )
-	COMMAND_RTF_INT ( "tposxl",			rowProps->m_eHPos, sCommand, true, RtfTableProperty::hp_posxl )
-	COMMAND_RTF_INT ( "tposxr",			rowProps->m_eHPos, sCommand, true, RtfTableProperty::hp_posxr )
-
-	COMMAND_RTF_INT ( "tpvmrg",			rowProps->m_eVRef, sCommand, true, RtfTableProperty::vr_pvmrg )
-	COMMAND_RTF_INT ( "tpvpg",			rowProps->m_eVRef, sCommand, true, RtfTableProperty::vr_pvpg )
-	COMMAND_RTF_INT ( "tpvpara",		rowProps->m_eVRef, sCommand, true, RtfTableProperty::vr_pvpara )
-	COMMAND_RTF_INT ( "tposy",			rowProps->m_nVPos, sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tposnegy",		rowProps->m_nVPos, sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tposyt",			rowProps->m_eVPos, sCommand, true, RtfTableProperty::vp_posyt )
-	COMMAND_RTF_INT ( "tposyil",		rowProps->m_eVPos, sCommand, true, RtfTableProperty::vp_posyil )
-	COMMAND_RTF_INT ( "tposyb",			rowProps->m_eVPos, sCommand, true, RtfTableProperty::vp_posyb )
-	COMMAND_RTF_INT ( "tposyc",			rowProps->m_eVPos, sCommand, true, RtfTableProperty::vp_posyc )
-	COMMAND_RTF_INT ( "tposyin",		rowProps->m_eVPos, sCommand, true, RtfTableProperty::vp_posyin )
-	COMMAND_RTF_INT ( "tposyout",		rowProps->m_eVPos, sCommand, true, RtfTableProperty::vp_posyout )
-
-	else if ( "trleft" == sCommand )
+	CASE_RTF_INT( irow,			rowProps->m_nIndex, hasParameter, parameter )
+	CASE_RTF_INT( irowband,		rowProps->m_nBandIndex, hasParameter, parameter )
+	CASE_RTF_BOOL( lastrow,		rowProps->m_bLastRow, hasParameter, parameter )
+	CASE_RTF_BOOL( trhdr,			rowProps->m_bIsHeader, hasParameter, parameter )
+	CASE_RTF_BOOL( trkeep,			rowProps->m_bKeep, hasParameter, parameter )
+	CASE_RTF_BOOL( trkeepfollow,	rowProps->m_bKeep, hasParameter, parameter )
+
+	CASE_RTF_INT( trql,			rowProps->m_eJust, true, RtfRowProperty::rj_trql )
+	CASE_RTF_INT( trqr,			rowProps->m_eJust, true, RtfRowProperty::rj_trqr )
+	CASE_RTF_INT( trqc,			rowProps->m_eJust, true, RtfRowProperty::rj_trqc )
+
+	CASE_RTF_INT( trrh,			rowProps->m_nHeight, hasParameter, parameter )
+
+	CASE_RTF_INT( trftsWidth,		rowProps->m_eWidthUnit, hasParameter, parameter )
+	CASE_RTF_INT( trwWidth,		rowProps->m_nWidth, hasParameter, parameter )
+
+	CASE_RTF_INT( trftsWidthB,	rowProps->m_eWidthStartInvCellUnit, hasParameter, parameter )
+	CASE_RTF_INT( trwWidthB,		rowProps->m_nWidthStartInvCell, hasParameter, parameter )
+
+	CASE_RTF_INT( trftsWidthA,	rowProps->m_eWidthEndInvCellUnit, hasParameter, parameter )
+	CASE_RTF_INT( trwWidthA,		rowProps->m_nWidthEndInvCell, hasParameter, parameter )
+
+	CASE_RTF_BOOL( taprtl,			rowProps->m_bBidi, hasParameter, parameter )
+	CASE_RTF_INT( trautofit,		rowProps->m_nAutoFit, hasParameter, parameter )
+	CASE_RTF_INT( trgaph,			rowProps->m_nGraph, hasParameter, parameter )
+	CASE_RTF_INT( tblind,			rowProps->nTableIndent, hasParameter, parameter )
+	CASE_RTF_INT( tblindtype,		rowProps->eTableIndentUnit, hasParameter, parameter )
+
+	CASE_RTF_INT( tdfrmtxtLeft,	rowProps->m_nWrapLeft, hasParameter, parameter )
+	CASE_RTF_INT( tdfrmtxtRight,	rowProps->m_nWrapRight, hasParameter, parameter )
+	CASE_RTF_INT( tdfrmtxtTop,	rowProps->m_nWrapTop, hasParameter, parameter )
+	CASE_RTF_INT( tdfrmtxtBottom, rowProps->m_nWrapBottom, hasParameter, parameter )
+	CASE_RTF_BOOL( tabsnoovrlp,	rowProps->m_bOverlap, hasParameter, parameter )
+
+	CASE_RTF_INT( tphmrg,			rowProps->m_eHRef, true, RtfTableProperty::hr_phmrg )
+	CASE_RTF_INT( tphpg,			rowProps->m_eHRef, true, RtfTableProperty::hr_phpg )
+	CASE_RTF_INT( tphcol,			rowProps->m_eHRef, true, RtfTableProperty::hr_phcol )
+	CASE_RTF_INT( tposx,			rowProps->m_nHPos, hasParameter, parameter )
+	CASE_RTF_INT( tposnegx,		rowProps->m_nHPos, hasParameter, parameter )
+	CASE_RTF_INT( tposxc,			rowProps->m_eHPos, true, RtfTableProperty::hp_posxc )
+	CASE_RTF_INT( tposxi,			rowProps->m_eHPos, true, RtfTableProperty::hp_posxi )
+	CASE_RTF_INT( tposxo,			rowProps->m_eHPos, true, RtfTableProperty::hp_posxo )
+	CASE_RTF_INT( tposxl,			rowProps->m_eHPos, true, RtfTableProperty::hp_posxl )
+	CASE_RTF_INT( tposxr,			rowProps->m_eHPos, true, RtfTableProperty::hp_posxr )
+
+	CASE_RTF_INT( tpvmrg,			rowProps->m_eVRef, true, RtfTableProperty::vr_pvmrg )
+	CASE_RTF_INT( tpvpg,			rowProps->m_eVRef, true, RtfTableProperty::vr_pvpg )
+	CASE_RTF_INT( tpvpara,		rowProps->m_eVRef, true, RtfTableProperty::vr_pvpara )
+	CASE_RTF_INT( tposy,			rowProps->m_nVPos, hasParameter, parameter )
+	CASE_RTF_INT( tposnegy,		rowProps->m_nVPos, hasParameter, parameter )
+	CASE_RTF_INT( tposyt,			rowProps->m_eVPos, true, RtfTableProperty::vp_posyt )
+	CASE_RTF_INT( tposyil,		rowProps->m_eVPos, true, RtfTableProperty::vp_posyil )
+	CASE_RTF_INT( tposyb,			rowProps->m_eVPos, true, RtfTableProperty::vp_posyb )
+	CASE_RTF_INT( tposyc,			rowProps->m_eVPos, true, RtfTableProperty::vp_posyc )
+	CASE_RTF_INT( tposyin,		rowProps->m_eVPos, true, RtfTableProperty::vp_posyin )
+	CASE_RTF_INT( tposyout,		rowProps->m_eVPos, true, RtfTableProperty::vp_posyout )
+
+	case RtfKeyword::kw_trleft:
 	{
 		if ( hasParameter )
 		{
@@ -1616,62 +1670,46 @@ bool RtfTableRowPropsCommand::ExecuteCommand(RtfDocument& oDocument, RtfReader&
 					rowProps->eTableIndentUnit = 3;
 			}
 		}
-	}
-	COMMAND_RTF_INT ( "trwWidth", rowProps->m_nWidth, sCommand, hasParameter, parameter )
-	else if ( "trftsWidth" == sCommand )
-	{
-		if ( hasParameter )
-		{
-			switch( parameter )
-			{
-			case 0: rowProps->m_eWidthUnit = mu_none;		break;
-			case 1: rowProps->m_eWidthUnit = mu_Auto;		break;
-			case 2: rowProps->m_eWidthUnit = mu_Percent;	break;
-			case 3: rowProps->m_eWidthUnit = mu_Twips;		break;
-			default:
-				break;
-			}
-		}
-	}
-	COMMAND_RTF_INT ( "trpaddb",	rowProps->m_nDefCellMarBottom,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trpaddl",	rowProps->m_nDefCellMarLeft,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trpaddr",	rowProps->m_nDefCellMarRight,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trpaddt",	rowProps->m_nDefCellMarTop,			sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trpaddfb",	rowProps->m_eDefCellMarBottomUnit,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trpaddfl",	rowProps->m_eDefCellMarLeftUnit,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trpaddfr",	rowProps->m_eDefCellMarRightUnit,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trpaddft",	rowProps->m_eDefCellMarTopUnit,		sCommand, hasParameter, parameter )
-
-	COMMAND_RTF_INT ( "trspdb",		rowProps->m_nDefCellSpBottom,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trspdl",		rowProps->m_nDefCellSpLeft,			sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trspdr",		rowProps->m_nDefCellSpRight,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trspdt",		rowProps->m_nDefCellSpTop,			sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trspdfb",	rowProps->m_eDefCellSpBottomUnit,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trspdfl",	rowProps->m_eDefCellSpLeftUnit,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trspdfr",	rowProps->m_eDefCellSpRightUnit,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trspdft",	rowProps->m_eDefCellSpTopUnit,		sCommand, hasParameter, parameter )
-
-	COMMAND_RTF_INT ( "ts",			rowProps->m_nStyle,					sCommand, hasParameter, parameter )
-
-	COMMAND_RTF_INT ( "tbllkhdrrows",	rowProps->m_bAutoFirstRow,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tbllklastrow",	rowProps->m_bAutoLastRow,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tbllkhdrcols",	rowProps->m_bAutoFirstCol,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tbllklastcol",	rowProps->m_bAutoLastCol,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tbllknorowband",	rowProps->m_bAutoNoRowBand,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tbllknocolband",	rowProps->m_bAutoNoColBand,		sCommand, hasParameter, parameter )
-
-	COMMAND_RTF_INT ( "tscbandsh",		rowProps->m_nRowBandSize,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "tscbandsv",		rowProps->m_nColBandSize,	sCommand, hasParameter, parameter )
-
-	COMMAND_RTF_INT ( "trdate",			rowProps->m_nTrDate,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_INT ( "trauth",			rowProps->m_nTrAuth,		sCommand, hasParameter, parameter )
-
-	else if ( "rtlrow" == sCommand ) rowProps->m_nRightToLeft = 1;
-	else if ( "ltrrow" == sCommand ) rowProps->m_nRightToLeft = 0;
-
-	else
+	}break;
+	CASE_RTF_INT( trpaddb,	rowProps->m_nDefCellMarBottom, hasParameter, parameter )
+	CASE_RTF_INT( trpaddl,	rowProps->m_nDefCellMarLeft, hasParameter, parameter )
+	CASE_RTF_INT( trpaddr,	rowProps->m_nDefCellMarRight, hasParameter, parameter )
+	CASE_RTF_INT( trpaddt,	rowProps->m_nDefCellMarTop, hasParameter, parameter )
+	CASE_RTF_INT( trpaddfb,	rowProps->m_eDefCellMarBottomUnit, hasParameter, parameter )
+	CASE_RTF_INT( trpaddfl,	rowProps->m_eDefCellMarLeftUnit, hasParameter, parameter )
+	CASE_RTF_INT( trpaddfr,	rowProps->m_eDefCellMarRightUnit, hasParameter, parameter )
+	CASE_RTF_INT( trpaddft,	rowProps->m_eDefCellMarTopUnit, hasParameter, parameter )
+
+	CASE_RTF_INT( trspdb,		rowProps->m_nDefCellSpBottom, hasParameter, parameter )
+	CASE_RTF_INT( trspdl,		rowProps->m_nDefCellSpLeft, hasParameter, parameter )
+	CASE_RTF_INT( trspdr,		rowProps->m_nDefCellSpRight, hasParameter, parameter )
+	CASE_RTF_INT( trspdt,		rowProps->m_nDefCellSpTop, hasParameter, parameter )
+	CASE_RTF_INT( trspdfb,	rowProps->m_eDefCellSpBottomUnit, hasParameter, parameter )
+	CASE_RTF_INT( trspdfl,	rowProps->m_eDefCellSpLeftUnit, hasParameter, parameter )
+	CASE_RTF_INT( trspdfr,	rowProps->m_eDefCellSpRightUnit, hasParameter, parameter )
+	CASE_RTF_INT( trspdft,	rowProps->m_eDefCellSpTopUnit, hasParameter, parameter )
+
+	CASE_RTF_INT( ts,			rowProps->m_nStyle, hasParameter, parameter )
+
+	CASE_RTF_INT( tbllkhdrrows,	rowProps->m_bAutoFirstRow, hasParameter, parameter )
+	CASE_RTF_INT( tbllklastrow,	rowProps->m_bAutoLastRow, hasParameter, parameter )
+	CASE_RTF_INT( tbllkhdrcols,	rowProps->m_bAutoFirstCol, hasParameter, parameter )
+	CASE_RTF_INT( tbllklastcol,	rowProps->m_bAutoLastCol, hasParameter, parameter )
+	CASE_RTF_INT( tbllknorowband,	rowProps->m_bAutoNoRowBand, hasParameter, parameter )
+	CASE_RTF_INT( tbllknocolband,	rowProps->m_bAutoNoColBand, hasParameter, parameter )
+
+	CASE_RTF_INT( tscbandsh,		rowProps->m_nRowBandSize, hasParameter, parameter )
+	CASE_RTF_INT( tscbandsv,		rowProps->m_nColBandSize, hasParameter, parameter )
+
+	CASE_RTF_INT( trdate,			rowProps->m_nTrDate, hasParameter, parameter )
+	CASE_RTF_INT( trauth,			rowProps->m_nTrAuth, hasParameter, parameter )
+
+	case RtfKeyword::kw_rtlrow:	rowProps->m_nRightToLeft = 1; break;
+	case RtfKeyword::kw_ltrrow:	rowProps->m_nRightToLeft = 0; break;
+
+	default:
 		return false;
-	
+	}
 	return true;
 }
 
@@ -2687,13 +2725,10 @@ bool RtfOleBinReader::ExecuteCommand(RtfDocument& oDocument, RtfReader& oReader,
 		if ( hasParameter )
 			nDataSize  = parameter;
 
-		BYTE *pData = NULL;
-
-		oReader.m_oLex.ReadBytes( parameter, &pData );
+		const BYTE *pData = oReader.m_oLex.ReadBytes( nDataSize );
 
-		m_arData.push_back(std::string((char*)pData, nDataSize));
-
-		RELEASEOBJECT(pData);
+		if (pData)
+			m_arData.push_back(std::string((const char*)pData, nDataSize));
 	}
 	return true;
 }
@@ -3311,20 +3346,26 @@ bool RtfOldListReader::ExecuteCommand( RtfDocument& oDocument, RtfReader& oReade
 	return true;
 }
 
+RtfHEXStringReader::RtfHEXStringReader()
+{
+	m_pHexData = &m_arData;
+}
 void RtfHEXStringReader::ExecuteTextInternal2(RtfDocument& oDocument, RtfReader& oReader, std::string & sKey, int& nSkipChars)
 {
 	if (oReader.m_oState->m_sCurText.empty()) return;
-	sHexString += oReader.m_oState->m_sCurText;
+
+	int nHalf = -1;
+	RtfUtility::DecodeHex((const BYTE*)oReader.m_oState->m_sCurText.c_str(), oReader.m_oState->m_sCurText.length(), m_arData, nHalf);
 
 	oReader.m_oState->m_sCurText.clear();
 }
 void RtfHEXStringReader::ExitReader(RtfDocument& oDocument, RtfReader& oReader)
 {
-	if (sHexString.empty()) return;
+	if (m_arData.empty()) return;
 
-	int nDataSize = sHexString.size() / 2;
+	int nDataSize = (int)m_arData.size();
 	unsigned char *pData = new unsigned char[nDataSize];
-	RtfUtility::DecodeHexString(sHexString, pData);
+	memcpy(pData, m_arData.data(), nDataSize);
 
 	pDataArray = std::make_pair(boost::shared_array<unsigned char>(pData), nDataSize);
 }
@@ -3787,13 +3828,12 @@ std::wstring RtfPictureReader::PLACEABLEMETAHEADER::ByteToString( BYTE* pbData,
 
 RtfPictureReader::RtfPictureReader( RtfReader& oReader, RtfShape& oShape ) : m_oShape(oShape)
 {
-	m_bBin = false;
-	m_pbBin = NULL;
+	m_pBin = NULL;
 	m_nBinLength = 0;
+	m_pHexData = &m_arData;
 }
 RtfPictureReader::~RtfPictureReader()
 {
-	RELEASEARRAYOBJECTS(m_pbBin);
 }
 bool RtfPictureReader::ExecuteCommand(RtfDocument& oDocument, RtfReader& oReader,  std::string sCommand, bool hasParameter, int parameter)
 {
@@ -3876,9 +3916,8 @@ bool RtfPictureReader::ExecuteCommand(RtfDocument& oDocument, RtfReader& oReader
 		if ( hasParameter )
 		{
 			//читаем картинку как бинарник длиной parameter
-			m_bBin = true;
-			m_nBinLength = parameter;
-			oReader.m_oLex.ReadBytes( parameter, &m_pbBin );//читаем сразу байты, потому что если между ними и был пробел, то он пропустится в RtfLex::parseKeyword
+			m_pBin = oReader.m_oLex.ReadBytes( parameter );//читаем сразу байты, потому что если между ними и был пробел, то он пропустится в RtfLex::parseKeyword
+			m_nBinLength = m_pBin ? parameter : 0;
 		}
 	}
 	else if ("brdrt" == sCommand)		m_eInternalState = is_borderTop;
@@ -3910,7 +3949,11 @@ bool RtfPictureReader::ExecuteCommand(RtfDocument& oDocument, RtfReader& oReader
 }
 void RtfPictureReader::ExecuteText(RtfDocument& oDocument, RtfReader& oReader, std::wstring sText)
 {
-	m_sData += sText;
+	//основной hex текст декодирует лексер, сюда попадает только собранный из управляющих символов
+	std::string sHex(sText.begin(), sText.end());
+
+	int nHalf = -1;
+	RtfUtility::DecodeHex((const BYTE*)sHex.c_str(), sHex.length(), m_arData, nHalf);
 }
 void RtfPictureReader::ExitReader( RtfDocument& oDocument, RtfReader& oReader )
 {
@@ -3923,15 +3966,30 @@ void RtfPictureReader::ExitReader( RtfDocument& oDocument, RtfReader& oReader )
 			oPLACEABLEMETAHEADER.Right	= long( (m_oShape.m_oPicture->m_dScaleX / 100.0) * m_oShape.m_oPicture->m_nWidthGoal * ( 96.0 / 1440 ) ); //to pixel
 			oPLACEABLEMETAHEADER.Bottom = long( (m_oShape.m_oPicture->m_dScaleY / 100.0) * m_oShape.m_oPicture->m_nHeightGoal * ( 96.0 / 1440 ) );
 			oPLACEABLEMETAHEADER.CalculateChecksum();
-			m_sData = oPLACEABLEMETAHEADER.ToString() + m_sData;
+
+			std::wstring sHeader = oPLACEABLEMETAHEADER.ToString();
+			std::string sHeaderHex(sHeader.begin(), sHeader.end());
+
+			std::vector<BYTE> arHeader;
+			int nHalf = -1;
+			RtfUtility::DecodeHex((const BYTE*)sHeaderHex.c_str(), sHeaderHex.length(), arHeader, nHalf);
+			m_arData.insert(m_arData.begin(), arHeader.begin(), arHeader.end());
 		}
 	}
 
 	std::wstring sTempFile = Utils::CreateTempFile( oReader.m_sTempFolder );
-	if(m_bBin)
-		RtfUtility::WriteDataToFileBinary( sTempFile, m_pbBin, m_nBinLength );
+	if (m_pBin)
+		RtfUtility::WriteDataToFileBinary( sTempFile, (BYTE*)m_pBin, m_nBinLength );
 	else
-		RtfUtility::WriteDataToFile( sTempFile, m_sData );
+	{
+		NSFile::CFileBinary file;
+		if (file.CreateFileW(sTempFile))
+		{
+			if (!m_arData.empty())
+				file.WriteFile(m_arData.data(), (DWORD)m_arData.size());
+			file.CloseFile();
+		}
+	}
 
 	if( RtfPicture::dt_none ==  m_oShape.m_oPicture->eDataType )
 		m_oShape.m_oPicture->eDataType = RtfPicture::GetPictureType( sTempFile );
@@ -4252,17 +4310,21 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 	m_bPar			= false;
 	bool bContinue	= false;
 
-	if ("pard" == sCommand)
+	RtfKeyword::_Keyword eKeyword = oReader.m_eKeyword;
+
+	if (RtfKeyword::kw_pard == eKeyword)
 	{
 		oReader.m_oState->m_oCurOldList.SetDefault();
 	}
-	else if ( "tcelld" == sCommand)
+	else if (RtfKeyword::kw_tcelld == eKeyword)
 	{
 		oReader.m_oState->m_oCellProperty.SetDefaultRtf();
 	}
 	
 	//----------------------------------------------------------------------------------
-	if ( "par" == sCommand )
+	switch (eKeyword)
+	{
+	case RtfKeyword::kw_par:
 	{
 		m_bPar = true;
 		m_oCurParagraph->m_oProperty	= oReader.m_oState->m_oParagraphProp;
@@ -4274,8 +4336,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		m_oCurParagraph = RtfParagraphPtr(new RtfParagraph());
 
 		return true;
-	}
-	else if ( "cell" == sCommand  || "nestcell" == sCommand )
+	}break;
+	case RtfKeyword::kw_cell: case RtfKeyword::kw_nestcell:
 	{
 		//пример п 9 п 12.rtf
 		//XXT_RV_VNP.rtf
@@ -4296,8 +4358,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		m_oCurParagraph = RtfParagraphPtr(new RtfParagraph());
 
 		return true;
-	}
-	else if ( "row" == sCommand || "nestrow" == sCommand)
+	}break;
+	case RtfKeyword::kw_row: case RtfKeyword::kw_nestrow:
 	{
 		m_oCurParagraph->m_oProperty	= oReader.m_oState->m_oParagraphProp;
 		m_oCurParagraph->m_oOldList		= RtfOldListPtr( new RtfOldList() );
@@ -4308,8 +4370,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		m_oCurParagraph = RtfParagraphPtr(new RtfParagraph());
 
 		return true;
-	}
-	else if ( "cellx" == sCommand )
+	}break;
+	case RtfKeyword::kw_cellx:
 	{
 		if ( hasParameter)
 		{
@@ -4326,16 +4388,16 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		//		oReader.m_oState->m_oCellProperty.SetDefaultRtf();
 		//	}
 		//}
-	}
-	else if ( "nonesttables" == sCommand )
+	}break;
+	case RtfKeyword::kw_nonesttables:
 	{
 		oAbstrReader.Skip( oDocument, oReader );
-	}
-	else if ( "listtext" == sCommand )
+	}break;
+	case RtfKeyword::kw_listtext:
 	{
 		oAbstrReader.Skip( oDocument, oReader );
-	}
-	else if ( "pntext" == sCommand )
+	}break;
+	case RtfKeyword::kw_pntext:
 	{
 //пропускаем списки office 95, если есть списки office 2007
 		if ( oDocument.m_oListTable.GetCount() > 0 )
@@ -4352,8 +4414,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 					oReader.m_oState->m_oCurOldList.m_oText = boost::static_pointer_cast<RtfParagraph, ITextItem>( piCurContainer ) ;
 			}
 		}
-	}
-	else if ( "pn" == sCommand )
+	}break;
+	case RtfKeyword::kw_pn:
 	{
 		if ( oDocument.m_oListTable.GetCount() > 0 )
 			oAbstrReader.Skip( oDocument, oReader );
@@ -4382,19 +4444,19 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 				oDocument.m_aOldLists.push_back( oNewOldList );
 			}
 		}
-	}
+	}break;
 
-	COMMAND_RTF_INT	( "uc",	oReader.m_oState->m_nUnicodeClean, sCommand, hasParameter, parameter)
+	CASE_RTF_INT( uc,	oReader.m_oState->m_nUnicodeClean, hasParameter, parameter)
 			//Tab todoooo перенести в ParagrProps (trackchanges)
-	COMMAND_RTF_INT ( "tldot",		m_oCurTab.m_eLeader,	sCommand, true, RtfTab::tl_dot )
-	COMMAND_RTF_INT ( "tlmdot",		m_oCurTab.m_eLeader,	sCommand, true, RtfTab::tl_mdot )
-	COMMAND_RTF_INT ( "tlhyph",		m_oCurTab.m_eLeader,	sCommand, true, RtfTab::tl_hyph )
-	COMMAND_RTF_INT ( "tlul",		m_oCurTab.m_eLeader,	sCommand, true, RtfTab::tl_ul )
-	COMMAND_RTF_INT ( "tlth",		m_oCurTab.m_eLeader,	sCommand, true, RtfTab::tl_ul )
-	COMMAND_RTF_INT ( "tqr",		m_oCurTab.m_eKind ,		sCommand, true, RtfTab::tk_tqr )
-	COMMAND_RTF_INT ( "tqc",		m_oCurTab.m_eKind ,		sCommand, true, RtfTab::tk_tqc )
-	COMMAND_RTF_INT ( "tqdec",		m_oCurTab.m_eKind ,		sCommand, true, RtfTab::tk_tqdec )
-	else if ( "tb" == sCommand )
+	CASE_RTF_INT( tldot,		m_oCurTab.m_eLeader, true, RtfTab::tl_dot )
+	CASE_RTF_INT( tlmdot,		m_oCurTab.m_eLeader, true, RtfTab::tl_mdot )
+	CASE_RTF_INT( tlhyph,		m_oCurTab.m_eLeader, true, RtfTab::tl_hyph )
+	CASE_RTF_INT( tlul,		m_oCurTab.m_eLeader, true, RtfTab::tl_ul )
+	CASE_RTF_INT( tlth,		m_oCurTab.m_eLeader, true, RtfTab::tl_ul )
+	CASE_RTF_INT( tqr,		m_oCurTab.m_eKind , true, RtfTab::tk_tqr )
+	CASE_RTF_INT( tqc,		m_oCurTab.m_eKind , true, RtfTab::tk_tqc )
+	CASE_RTF_INT( tqdec,		m_oCurTab.m_eKind , true, RtfTab::tk_tqdec )
+	case RtfKeyword::kw_tb:
 	{
 		if ( hasParameter )
 		{
@@ -4411,8 +4473,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 			oReader.m_oState->m_oParagraphProp.m_oTabs.m_aTabs.push_back( m_oCurTab );
 			m_oCurTab.SetDefault();
 		}
-	}
-	else if ( "tx" == sCommand )
+	}break;
+	case RtfKeyword::kw_tx:
 	{
 		if ( hasParameter )
 		{
@@ -4428,9 +4490,11 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 			oReader.m_oState->m_oParagraphProp.m_oTabs.m_aTabs.push_back( m_oCurTab );
 			m_oCurTab.SetDefault();
 		}
-	}
-	else
+	}break;
+	default:
 		bContinue = true;
+		break;
+	}
 
 	if (false == bContinue) // compiler limit : blocks nested too deeply
 	{
@@ -4439,68 +4503,68 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 	}
 	bContinue = false;
 	//tableStyleProp
-	if ( "*" == sCommand )
-		;
-	COMMAND_RTF_INT ( "yts",			oReader.m_oState->m_oParagraphProp.m_nTableStyle,		sCommand, hasParameter, parameter )
+	switch (eKeyword)
+	{
+	CASE_RTF_INT( yts,			oReader.m_oState->m_oParagraphProp.m_nTableStyle, hasParameter, parameter )
 
-	COMMAND_RTF_BOOL( "tscfirstrow",	oReader.m_oState->m_oParagraphProp.m_bStyleFirstRow,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscfirstrow",	oReader.m_oState->m_oCellProperty.m_bStyleFirstRow,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscfirstrow",	oReader.m_oState->m_oRowProperty.m_bStyleFirstRow,		sCommand, hasParameter, parameter )
+	CASE_RTF_BOOL( tscfirstrow,	oReader.m_oState->m_oParagraphProp.m_bStyleFirstRow, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscfirstrow,	oReader.m_oState->m_oCellProperty.m_bStyleFirstRow, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscfirstrow,	oReader.m_oState->m_oRowProperty.m_bStyleFirstRow, hasParameter, parameter )
 
-	COMMAND_RTF_BOOL( "tsclastrow",		oReader.m_oState->m_oParagraphProp.m_bStyleLastRow,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tsclastrow",		oReader.m_oState->m_oCellProperty.m_bStyleLastRow,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tsclastrow",		oReader.m_oState->m_oRowProperty.m_bStyleLastRow,		sCommand, hasParameter, parameter )
+	CASE_RTF_BOOL( tsclastrow,		oReader.m_oState->m_oParagraphProp.m_bStyleLastRow, hasParameter, parameter )
+	//CASE_RTF_BOOL( tsclastrow,		oReader.m_oState->m_oCellProperty.m_bStyleLastRow, hasParameter, parameter )
+	//CASE_RTF_BOOL( tsclastrow,		oReader.m_oState->m_oRowProperty.m_bStyleLastRow, hasParameter, parameter )
 
-	COMMAND_RTF_BOOL( "tscfirstcol",	oReader.m_oState->m_oParagraphProp.m_bStyleFirstCollumn, sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscfirstcol",	oReader.m_oState->m_oCellProperty.m_bStyleFirstCol,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscfirstcol",	oReader.m_oState->m_oRowProperty.m_bStyleFirstCol,		sCommand, hasParameter, parameter )
+	CASE_RTF_BOOL( tscfirstcol,	oReader.m_oState->m_oParagraphProp.m_bStyleFirstCollumn, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscfirstcol,	oReader.m_oState->m_oCellProperty.m_bStyleFirstCol, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscfirstcol,	oReader.m_oState->m_oRowProperty.m_bStyleFirstCol, hasParameter, parameter )
 
-	COMMAND_RTF_BOOL( "tsclastcol",		oReader.m_oState->m_oParagraphProp.m_bStyleLastCollumn, sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tsclastcol",		oReader.m_oState->m_oCellProperty.m_bStyleLastCol,		sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tsclastcol",		oReader.m_oState->m_oRowProperty.m_bStyleLastCol,		sCommand, hasParameter, parameter )
+	CASE_RTF_BOOL( tsclastcol,		oReader.m_oState->m_oParagraphProp.m_bStyleLastCollumn, hasParameter, parameter )
+	//CASE_RTF_BOOL( tsclastcol,		oReader.m_oState->m_oCellProperty.m_bStyleLastCol, hasParameter, parameter )
+	//CASE_RTF_BOOL( tsclastcol,		oReader.m_oState->m_oRowProperty.m_bStyleLastCol, hasParameter, parameter )
 
-	COMMAND_RTF_BOOL( "tscbandhorzodd", oReader.m_oState->m_oParagraphProp.m_bStyleOddRowBand, sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscbandhorzodd", oReader.m_oState->m_oCellProperty.m_bStyleOddRowBand,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscbandhorzodd", oReader.m_oState->m_oRowProperty.m_bStyleOddRowBand,	sCommand, hasParameter, parameter )
+	CASE_RTF_BOOL( tscbandhorzodd, oReader.m_oState->m_oParagraphProp.m_bStyleOddRowBand, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscbandhorzodd, oReader.m_oState->m_oCellProperty.m_bStyleOddRowBand, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscbandhorzodd, oReader.m_oState->m_oRowProperty.m_bStyleOddRowBand, hasParameter, parameter )
 
-	COMMAND_RTF_BOOL( "tscbandhorzeven", oReader.m_oState->m_oParagraphProp.m_bStyleEvenRowBand,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscbandhorzeven", oReader.m_oState->m_oCellProperty.m_bStyleEvenRowBand,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscbandhorzeven", oReader.m_oState->m_oRowProperty.m_bStyleEvenRowBand,		sCommand, hasParameter, parameter )
+	CASE_RTF_BOOL( tscbandhorzeven, oReader.m_oState->m_oParagraphProp.m_bStyleEvenRowBand, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscbandhorzeven, oReader.m_oState->m_oCellProperty.m_bStyleEvenRowBand, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscbandhorzeven, oReader.m_oState->m_oRowProperty.m_bStyleEvenRowBand, hasParameter, parameter )
 
-	COMMAND_RTF_BOOL( "tscbandvertodd", oReader.m_oState->m_oParagraphProp.m_bStyleOddColBand, sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscbandvertodd", oReader.m_oState->m_oCellProperty.m_bStyleOddColBand,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscbandvertodd", oReader.m_oState->m_oRowProperty.m_bStyleOddColBand,	sCommand, hasParameter, parameter )
+	CASE_RTF_BOOL( tscbandvertodd, oReader.m_oState->m_oParagraphProp.m_bStyleOddColBand, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscbandvertodd, oReader.m_oState->m_oCellProperty.m_bStyleOddColBand, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscbandvertodd, oReader.m_oState->m_oRowProperty.m_bStyleOddColBand, hasParameter, parameter )
 
-	COMMAND_RTF_BOOL( "tscbandverteven", oReader.m_oState->m_oParagraphProp.m_bStyleEvenColBand,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscbandverteven", oReader.m_oState->m_oCellProperty.m_bStyleEvenColBand,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscbandverteven", oReader.m_oState->m_oRowProperty.m_bStyleEvenColBand,		sCommand, hasParameter, parameter )
+	CASE_RTF_BOOL( tscbandverteven, oReader.m_oState->m_oParagraphProp.m_bStyleEvenColBand, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscbandverteven, oReader.m_oState->m_oCellProperty.m_bStyleEvenColBand, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscbandverteven, oReader.m_oState->m_oRowProperty.m_bStyleEvenColBand, hasParameter, parameter )
 
-	COMMAND_RTF_BOOL( "tscnwcell", oReader.m_oState->m_oParagraphProp.m_bStyleNWCell,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscnwcell", oReader.m_oState->m_oCellProperty.m_bStyleNWCell,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscnwcell", oReader.m_oState->m_oRowProperty.m_bStyleNWCell,	sCommand, hasParameter, parameter )
+	CASE_RTF_BOOL( tscnwcell, oReader.m_oState->m_oParagraphProp.m_bStyleNWCell, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscnwcell, oReader.m_oState->m_oCellProperty.m_bStyleNWCell, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscnwcell, oReader.m_oState->m_oRowProperty.m_bStyleNWCell, hasParameter, parameter )
 
-	COMMAND_RTF_BOOL( "tscnecell", oReader.m_oState->m_oParagraphProp.m_bStyleNECell,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscnecell", oReader.m_oState->m_oCellProperty.m_bStyleNECell,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscnecell", oReader.m_oState->m_oRowProperty.m_bStyleNECell,	sCommand, hasParameter, parameter )
+	CASE_RTF_BOOL( tscnecell, oReader.m_oState->m_oParagraphProp.m_bStyleNECell, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscnecell, oReader.m_oState->m_oCellProperty.m_bStyleNECell, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscnecell, oReader.m_oState->m_oRowProperty.m_bStyleNECell, hasParameter, parameter )
 
-	COMMAND_RTF_BOOL( "tscswcell", oReader.m_oState->m_oParagraphProp.m_bStyleSWCell,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscswcell", oReader.m_oState->m_oCellProperty.m_bStyleSWCell,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscswcell", oReader.m_oState->m_oRowProperty.m_bStyleSWCell,	sCommand, hasParameter, parameter )
+	CASE_RTF_BOOL( tscswcell, oReader.m_oState->m_oParagraphProp.m_bStyleSWCell, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscswcell, oReader.m_oState->m_oCellProperty.m_bStyleSWCell, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscswcell, oReader.m_oState->m_oRowProperty.m_bStyleSWCell, hasParameter, parameter )
 
-	COMMAND_RTF_BOOL( "tscsecell", oReader.m_oState->m_oParagraphProp.m_bStyleSECell,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscsecell", oReader.m_oState->m_oCellProperty.m_bStyleSECell,	sCommand, hasParameter, parameter )
-	COMMAND_RTF_BOOL( "tscsecell", oReader.m_oState->m_oRowProperty.m_bStyleSECell,	sCommand, hasParameter, parameter )
+	CASE_RTF_BOOL( tscsecell, oReader.m_oState->m_oParagraphProp.m_bStyleSECell, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscsecell, oReader.m_oState->m_oCellProperty.m_bStyleSECell, hasParameter, parameter )
+	//CASE_RTF_BOOL( tscsecell, oReader.m_oState->m_oRowProperty.m_bStyleSECell, hasParameter, parameter )
 			//Math
-			else if ( "mmath" == sCommand )
+	case RtfKeyword::kw_mmath:
 	{
 		RtfMathPtr		pNewMath	( new RtfMath() );
 		RtfMathReader	oMathReader	( pNewMath );
 		
 		oAbstrReader.StartSubReader( oMathReader, oDocument, oReader );
 		m_oCurParagraph->AddItem(pNewMath);
-	}
+	}break;
 	//Drawing
-	else if ( "shp" == sCommand )
+	case RtfKeyword::kw_shp:
 	{
 		RtfShapePtr oNewShape ( new RtfShape() );
 		oNewShape->m_oCharProperty = oReader.m_oState->m_oCharProp;
@@ -4510,8 +4574,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		
 		if ( oNewShape->IsValid() )
 			m_oCurParagraph->AddItem( oNewShape );
-	}
-	else if ( "do" == sCommand )
+	}break;
+	case RtfKeyword::kw_do:
 	{
 		RtfShapePtr oNewShape ( new RtfShape() );
 		oNewShape->m_oCharProperty = oReader.m_oState->m_oCharProp;
@@ -4521,8 +4585,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		
 		if ( oNewShape->IsValid() )
 			m_oCurParagraph->AddItem( oNewShape );
-	}
-	else if ( "shppict" == sCommand )
+	}break;
+	case RtfKeyword::kw_shppict:
 	{
 		RtfShapePtr oNewShape ( new RtfShape() );
 		oNewShape->m_oCharProperty = oReader.m_oState->m_oCharProp;
@@ -4532,8 +4596,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 
 		if ( oNewShape->IsValid() )
 			m_oCurParagraph->AddItem( oNewShape );
-	}
-	else if ( "pict" == sCommand )
+	}break;
+	case RtfKeyword::kw_pict:
 	{
 		RtfShapePtr oNewShape ( new RtfShape() );
 		oNewShape->m_oCharProperty		= oReader.m_oState->m_oCharProp;
@@ -4554,8 +4618,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 
 		if ( oNewShape->IsValid() )
 			m_oCurParagraph->AddItem( oNewShape );
-	}
-	else if ( "shpgrp" == sCommand )
+	}break;
+	case RtfKeyword::kw_shpgrp:
 	{
 		RtfShapePtr oNewShape ( new RtfShape() );
 		
@@ -4568,12 +4632,12 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		
 		if ( oNewShape->IsValid() )
 			m_oCurParagraph->AddItem( oNewShape );
-	}
-	else if ( "nonshppict" == sCommand )
+	}break;
+	case RtfKeyword::kw_nonshppict:
 	{
 		oAbstrReader.Skip( oDocument, oReader );
-	}
-	else if ( "field" == sCommand )
+	}break;
+	case RtfKeyword::kw_field:
 	{
 		RtfFieldPtr		oNewField		(new RtfField());
 		RtfFieldReader	oFieldReader	( *oNewField );
@@ -4582,8 +4646,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		
 		if ( oNewField->IsValid() )
 			m_oCurParagraph->AddItem( oNewField );
-	}
-	else if ( "object" == sCommand )
+	}break;
+	case RtfKeyword::kw_object:
 	{
 		RtfOlePtr oNewOleObject = RtfOlePtr( new RtfOle() );
 		oNewOleObject->m_oCharProperty = oReader.m_oState->m_oCharProp;
@@ -4593,8 +4657,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		
 		if ( oNewOleObject->IsValid() )
 			m_oCurParagraph->AddItem( oNewOleObject );
-	}
-	else if ( "bkmkstart" == sCommand )
+	}break;
+	case RtfKeyword::kw_bkmkstart:
 	{
 		RtfBookmarkStartPtr		pNewBookmarkStart	( new RtfBookmarkStart() );
 		RtfBookmarkStartReader	oBookmarkStartReader( *pNewBookmarkStart );
@@ -4602,8 +4666,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		oAbstrReader.StartSubReader( oBookmarkStartReader, oDocument, oReader );
 		if ( pNewBookmarkStart->IsValid() )
 			m_oCurParagraph->AddItem( pNewBookmarkStart );
-	}
-	else if ( "bkmkend" == sCommand )
+	}break;
+	case RtfKeyword::kw_bkmkend:
 	{
 		RtfBookmarkEndPtr		pNewBookmarkEnd		( new RtfBookmarkEnd() );
 		RtfBookmarkEndReader	oBookmarkEndReader	( *pNewBookmarkEnd );
@@ -4612,8 +4676,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		
 		if ( pNewBookmarkEnd->IsValid() )
 			m_oCurParagraph->AddItem( pNewBookmarkEnd );
-	}
-	else if ( "atrfstart" == sCommand )
+	}break;
+	case RtfKeyword::kw_atrfstart:
 	{
 		RtfAnnotElemPtr		pNewAnnotElem		( new RtfAnnotElem(1) );
 		RtfAnnotElemReader	oAnnotElemReader	( *pNewAnnotElem );
@@ -4622,8 +4686,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		
 		if ( pNewAnnotElem->IsValid() )
 			m_oCurParagraph->AddItem( pNewAnnotElem );
-	}
-	else if ( "atrfend" == sCommand )
+	}break;
+	case RtfKeyword::kw_atrfend:
 	{
 		RtfAnnotElemPtr		pNewAnnotElem		( new RtfAnnotElem(2) );
 		RtfAnnotElemReader	oAnnotElemReader	( *pNewAnnotElem );
@@ -4633,8 +4697,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		if ( pNewAnnotElem->IsValid() )
 			m_oCurParagraph->AddItem( pNewAnnotElem );
 
-	}
-	else if ( "annotation" == sCommand )
+	}break;
+	case RtfKeyword::kw_annotation:
 	{
 		RtfAnnotationPtr	pNewAnnot		( new RtfAnnotation() );
 		RtfAnnotationReader	oAnnotReader	( *pNewAnnot );
@@ -4643,8 +4707,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		
 		if ( pNewAnnot->IsValid() )
 			m_oCurParagraph->AddItem( pNewAnnot );
-	}
-	else if ( "atnid" == sCommand )
+	}break;
+	case RtfKeyword::kw_atnid:
 	{
 		RtfAnnotElemPtr		pNewAnnotElem	( new RtfAnnotElem(5) );
 		RtfAnnotElemReader	oAnnotElemReader( *pNewAnnotElem );
@@ -4653,8 +4717,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		
 		if ( pNewAnnotElem->IsValid() )
 			m_oCurParagraph->AddItem( pNewAnnotElem );
-	}
-	else if ( "atnauthor" == sCommand )
+	}break;
+	case RtfKeyword::kw_atnauthor:
 	{
 		RtfAnnotElemPtr		pNewAnnotElem	( new RtfAnnotElem(4) );
 		RtfAnnotElemReader	oAnnotElemReader( *pNewAnnotElem );
@@ -4663,8 +4727,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		
 		if ( pNewAnnotElem->IsValid() )
 			m_oCurParagraph->AddItem( pNewAnnotElem );
-	}
-	else if ( "atnref" == sCommand )
+	}break;
+	case RtfKeyword::kw_atnref:
 	{
 		RtfAnnotElemPtr		pNewAnnotElem		( new RtfAnnotElem(3) );
 		RtfAnnotElemReader	oAnnotElemReader	( *pNewAnnotElem );
@@ -4674,8 +4738,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		if ( pNewAnnotElem->IsValid() )
 			m_oCurParagraph->AddItem( pNewAnnotElem );
 
-	}
-	else if ( "footnote" == sCommand )
+	}break;
+	case RtfKeyword::kw_footnote:
 	{
 		RtfFootnotePtr pNewFootnote ( new RtfFootnote() );
 		pNewFootnote->m_oCharProp = oReader.m_oState->m_oCharProp;
@@ -4685,7 +4749,7 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		
 		if ( pNewFootnote->IsValid() )
 			m_oCurParagraph->AddItem( pNewFootnote );
-	}
+	}break;
 	//else if ( "chatn" == sCommand )
 	//{
 	//	RtfCharSpecialPtr pNewChar ( new RtfCharSpecial() );
@@ -4694,15 +4758,15 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 	//	pNewChar->m_eType = RtfCharSpecial::rsc_chatn;
 	//	m_oCurParagraph->AddItem( pNewChar );
 	//}
-	else if ( "chpgn" == sCommand ) //todooo - other special
+	case RtfKeyword::kw_chpgn:	//todooo - other special
 	{//header & footer
 		RtfCharSpecialPtr pNewChar ( new RtfCharSpecial() );
 		
 		pNewChar->m_oProperty = oReader.m_oState->m_oCharProp;
 		pNewChar->m_eType = RtfCharSpecial::rsc_chpgn;
 		m_oCurParagraph->AddItem( pNewChar );
-	}
-	else if ( "chftn" == sCommand )
+	}break;
+	case RtfKeyword::kw_chftn:
 	{
 		if ( 1 == oReader.m_nFootnote )
 		{
@@ -4720,8 +4784,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 			pNewChar->m_eType = RtfCharSpecial::rsc_chftnEnd;
 			m_oCurParagraph->AddItem( pNewChar );
 		}
-	}
-	else if ( "chftnsep" == sCommand || "chftnsepc" == sCommand )
+	}break;
+	case RtfKeyword::kw_chftnsep: case RtfKeyword::kw_chftnsepc:
 	{
 		RtfCharSpecialPtr pNewChar ( new RtfCharSpecial() );
 		
@@ -4730,8 +4794,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		
 		if		( "chftnsep"	== sCommand )	pNewChar->m_eType = RtfCharSpecial::rsc_chftnsep;
 		else if ( "chftnsepc"	== sCommand )	pNewChar->m_eType = RtfCharSpecial::rsc_chftnsepc;
-	}//specialChars
-	else if ( "page" == sCommand  )
+	}break;//specialChars
+	case RtfKeyword::kw_page:
 	{
 		RtfCharSpecialPtr pNewChar ( new RtfCharSpecial() );
 		
@@ -4747,10 +4811,10 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		//m_oCurParagraph->m_oProperty.m_oCharProperty = oReader.m_oState->m_oCharProp;
 		//AddItem( m_oCurParagraph, oReader, false, false );
 		//m_oCurParagraph = RtfParagraphPtr(new RtfParagraph());
-	}
-	COMMAND_RTF_SPECIAL_CHAR( "column",	m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_column )
-	COMMAND_RTF_SPECIAL_CHAR( "line",	m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_line )
-	else if ( "lbr" == sCommand )
+	}break;
+	CASE_RTF_SPECIAL_CHAR( column,	m_oCurParagraph, hasParameter, RtfCharSpecial::rsc_column )
+	CASE_RTF_SPECIAL_CHAR( line,	m_oCurParagraph, hasParameter, RtfCharSpecial::rsc_line )
+	case RtfKeyword::kw_lbr:
 	{
 		if ( hasParameter )
 		{
@@ -4760,12 +4824,12 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 			pNewChar->m_oProperty		= oReader.m_oState->m_oCharProp;
 			m_oCurParagraph->AddItem( pNewChar );
 		}
-	}
-	COMMAND_RTF_SPECIAL_CHAR( "softpage",	m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_softpage )
-	COMMAND_RTF_SPECIAL_CHAR( "softcol",	m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_softcol )
-	COMMAND_RTF_SPECIAL_CHAR( "softline",	m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_softline )
+	}break;
+	CASE_RTF_SPECIAL_CHAR( softpage,	m_oCurParagraph, hasParameter, RtfCharSpecial::rsc_softpage )
+	CASE_RTF_SPECIAL_CHAR( softcol,	m_oCurParagraph, hasParameter, RtfCharSpecial::rsc_softcol )
+	CASE_RTF_SPECIAL_CHAR( softline,	m_oCurParagraph, hasParameter, RtfCharSpecial::rsc_softline )
 
-			else if ( "softlheight" == sCommand )
+	case RtfKeyword::kw_softlheight:
 	{
 		if ( hasParameter )
 		{
@@ -4774,40 +4838,42 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 			pNewChar->m_oProperty		= oReader.m_oState->m_oCharProp;
 			m_oCurParagraph->AddItem( pNewChar );
 		}
-	}
-	COMMAND_RTF_SPECIAL_CHAR( "tab", m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_tab )
+	}break;
+	CASE_RTF_SPECIAL_CHAR( tab, m_oCurParagraph, hasParameter, RtfCharSpecial::rsc_tab )
 
-			else if ( "emdash" == sCommand )
+	case RtfKeyword::kw_emdash:
 			ExecuteNumberChar( oDocument, oReader, oAbstrReader, 151, 0xD0 ); // bullet Word for Windows - 151	; Apple Macintosh - 0xD0
-	else if ( "endash" == sCommand )
+			break;
+	case RtfKeyword::kw_endash:
 		ExecuteNumberChar( oDocument, oReader, oAbstrReader, 150, 0xD1 ); // bullet Word for Windows - 150	; Apple Macintosh - 0xD1
+		break;
 	
-	COMMAND_RTF_SPECIAL_CHAR( "emspace", m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_emspace )
-	COMMAND_RTF_SPECIAL_CHAR( "enspace", m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_enspace )
-	COMMAND_RTF_SPECIAL_CHAR( "qmspace", m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_qmspace )
+	CASE_RTF_SPECIAL_CHAR( emspace, m_oCurParagraph, hasParameter, RtfCharSpecial::rsc_emspace )
+	CASE_RTF_SPECIAL_CHAR( enspace, m_oCurParagraph, hasParameter, RtfCharSpecial::rsc_enspace )
+	CASE_RTF_SPECIAL_CHAR( qmspace, m_oCurParagraph, hasParameter, RtfCharSpecial::rsc_qmspace )
 
-			else if ( "bullet" == sCommand )
+	case RtfKeyword::kw_bullet:
 			ExecuteNumberChar( oDocument, oReader, oAbstrReader, 149, 0xA5 ); // bullet Word for Windows - 149	; Apple Macintosh - 0xA5
-	else if ( "lquote" == sCommand )
+			break;
+	case RtfKeyword::kw_lquote:
 		ExecuteNumberChar( oDocument, oReader, oAbstrReader, 145, 0xD4 ); // bullet Word for Windows - 145	; Apple Macintosh - 0xD4
-	else if ( "rquote" == sCommand )
+		break;
+	case RtfKeyword::kw_rquote:
 		ExecuteNumberChar( oDocument, oReader, oAbstrReader, 146, 0xD5 ); // bullet Word for Windows - 146	; Apple Macintosh - 0xD5
-	else if ( "ldblquote" == sCommand )
+		break;
+	case RtfKeyword::kw_ldblquote:
 		ExecuteNumberChar( oDocument, oReader, oAbstrReader, 147, 0xD2 ); // bullet Word for Windows - 147	; Apple Macintosh - 0xD2
-	else if ( "rdblquote" == sCommand )
+		break;
+	case RtfKeyword::kw_rdblquote:
 		ExecuteNumberChar( oDocument, oReader, oAbstrReader, 148, 0xD3 ); // bullet Word for Windows - 148	; Apple Macintosh - 0xD3
+		break;
 	
-	COMMAND_RTF_SPECIAL_CHAR( "|",		m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_Formula )
-	COMMAND_RTF_SPECIAL_CHAR( "~",		m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_NonBrSpace )
-	COMMAND_RTF_SPECIAL_CHAR( "-",		m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_OptHyphen )
-	COMMAND_RTF_SPECIAL_CHAR( "_",		m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_NonBrHyphen )
-	COMMAND_RTF_SPECIAL_CHAR( ":",		m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_SubEntry )
-	COMMAND_RTF_SPECIAL_CHAR( "zwbo",	m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_zwbo )
-	COMMAND_RTF_SPECIAL_CHAR( "zwnbo", m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_zwnbo )
-	COMMAND_RTF_SPECIAL_CHAR( "zwj",	m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_zwj )
-	COMMAND_RTF_SPECIAL_CHAR( "zwnj",	m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_zwnj )
-
-			else if ( "oldcprops"  == sCommand )
+	CASE_RTF_SPECIAL_CHAR( zwbo,	m_oCurParagraph, hasParameter, RtfCharSpecial::rsc_zwbo )
+	CASE_RTF_SPECIAL_CHAR( zwnbo, m_oCurParagraph, hasParameter, RtfCharSpecial::rsc_zwnbo )
+	CASE_RTF_SPECIAL_CHAR( zwj,	m_oCurParagraph, hasParameter, RtfCharSpecial::rsc_zwj )
+	CASE_RTF_SPECIAL_CHAR( zwnj,	m_oCurParagraph, hasParameter, RtfCharSpecial::rsc_zwnj )
+
+	case RtfKeyword::kw_oldcprops:
 	{
 		RtfCharPropertyPtr props ( new RtfCharProperty() );
 		RtfTrackerChangesReader oOldPropReader(props);
@@ -4816,8 +4882,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		{
 			oReader.m_oState->m_oCharProp.m_pOldCharProp = props;
 		}
-	}
-	else if ( "oldpprops"  == sCommand )
+	}break;
+	case RtfKeyword::kw_oldpprops:
 	{
 		RtfParagraphPropertyPtr props ( new RtfParagraphProperty() );
 		RtfTrackerChangesReader oOldPropReader(props);
@@ -4826,8 +4892,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		{
 			oReader.m_oState->m_oParagraphProp.m_pOldParagraphProp = props;
 		}
-	}
-	else if ( "oldsprops"  == sCommand )
+	}break;
+	case RtfKeyword::kw_oldsprops:
 	{
 		RtfSectionPropertyPtr props ( new RtfSectionProperty() );
 		RtfTrackerChangesReader oOldPropReader(props);
@@ -4836,8 +4902,8 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		{
 			oReader.m_oCurSectionProp.m_pOldSectionProp = props;
 		}
-	}
-	else if ( "oldtprops"  == sCommand )
+	}break;
+	case RtfKeyword::kw_oldtprops:
 	{
 		RtfRowPropertyPtr props ( new RtfRowProperty() );
 		RtfTrackerChangesReader oOldPropReader(props);
@@ -4846,126 +4912,136 @@ bool RtfParagraphPropDestination::ExecuteCommand(RtfDocument& oDocument, RtfRead
 		{
 			oReader.m_oState->m_oRowProperty.m_pOldRowProperty = props;
 		}
-	}
-	else if ( "chbrdr"	== sCommand )		m_eInternalState = is_charBorder;
-	else if ( "brdrt"	== sCommand )		m_eInternalState = is_borderTop;
-	else if ( "brdrb"	== sCommand )		m_eInternalState = is_borderBottom;
-	else if ( "brdrl"	== sCommand )		m_eInternalState = is_borderLeft;
-	else if ( "brdrr"	== sCommand )		m_eInternalState = is_borderRight;
+	}break;
+	case RtfKeyword::kw_chbrdr:	m_eInternalState = is_charBorder; break;
+	case RtfKeyword::kw_brdrt:	m_eInternalState = is_borderTop; break;
+	case RtfKeyword::kw_brdrb:	m_eInternalState = is_borderBottom; break;
+	case RtfKeyword::kw_brdrl:	m_eInternalState = is_borderLeft; break;
+	case RtfKeyword::kw_brdrr:	m_eInternalState = is_borderRight; break;
 	//else if ( "brdrbtw" == sCommand )		m_eInternalState = is_borderRight;
-	else if ( "brdrbar" == sCommand )		m_eInternalState = is_borderBar;
-	else if ( "box"	== sCommand )			m_eInternalState = is_borderBox;
-
-	else if ( "cldglu" == sCommand )		m_eInternalState = is_borderCellLR;
-	else if ( "cldgll" == sCommand )		m_eInternalState = is_borderCellRL;
-	else if ( "clbrdrl" == sCommand )		m_eInternalState = is_borderCellLeft;
-	else if ( "clbrdrt" == sCommand )		m_eInternalState = is_borderCellTop;
-	else if ( "clbrdrr" == sCommand )		m_eInternalState = is_borderCellRight;
-	else if ( "clbrdrb" == sCommand )		m_eInternalState = is_borderCellBottom;
-
-	else if ( "tsbrdrdgl" == sCommand )		m_eInternalState = is_borderCellLR;
-	else if ( "tsbrdrdgr" == sCommand )		m_eInternalState = is_borderCellRL;
-
-	else if ( "trbrdrl" == sCommand )		m_eInternalState = is_borderRowLeft;
-	else if ( "trbrdrr" == sCommand )		m_eInternalState = is_borderRowRight;
-	else if ( "trbrdrt" == sCommand )		m_eInternalState = is_borderRowTop;
-	else if ( "trbrdrb" == sCommand )		m_eInternalState = is_borderRowBottom;
-	else if ( "trbrdrv" == sCommand )		m_eInternalState = is_borderRowVer;
-	else if ( "trbrdrh" == sCommand )		m_eInternalState = is_borderRowHor;
-
-	else if ( "tsbrdrh" == sCommand ) 		m_eInternalState = is_borderRowHor;
-	else if ( "tsbrdrv" == sCommand )		m_eInternalState = is_borderRowVer;
-	else if ( "tsbrdrl" == sCommand )		m_eInternalState = is_borderRowLeft;
-	else if ( "tsbrdrt" == sCommand )		m_eInternalState = is_borderRowTop;
-	else if ( "tsbrdrr" == sCommand )		m_eInternalState = is_borderRowRight;
-	else if ( "tsbrdrb" == sCommand )		m_eInternalState = is_borderRowBottom;
-	else
-	{
-		bool bResult = false;
-
-		switch(m_eInternalState)
+	case RtfKeyword::kw_brdrbar:	m_eInternalState = is_borderBar; break;
+	case RtfKeyword::kw_box:	m_eInternalState = is_borderBox; break;
+
+	case RtfKeyword::kw_cldglu:	m_eInternalState = is_borderCellLR; break;
+	case RtfKeyword::kw_cldgll:	m_eInternalState = is_borderCellRL; break;
+	case RtfKeyword::kw_clbrdrl:	m_eInternalState = is_borderCellLeft; break;
+	case RtfKeyword::kw_clbrdrt:	m_eInternalState = is_borderCellTop; break;
+	case RtfKeyword::kw_clbrdrr:	m_eInternalState = is_borderCellRight; break;
+	case RtfKeyword::kw_clbrdrb:	m_eInternalState = is_borderCellBottom; break;
+
+	case RtfKeyword::kw_tsbrdrdgl:	m_eInternalState = is_borderCellLR; break;
+	case RtfKeyword::kw_tsbrdrdgr:	m_eInternalState = is_borderCellRL; break;
+
+	case RtfKeyword::kw_trbrdrl:	m_eInternalState = is_borderRowLeft; break;
+	case RtfKeyword::kw_trbrdrr:	m_eInternalState = is_borderRowRight; break;
+	case RtfKeyword::kw_trbrdrt:	m_eInternalState = is_borderRowTop; break;
+	case RtfKeyword::kw_trbrdrb:	m_eInternalState = is_borderRowBottom; break;
+	case RtfKeyword::kw_trbrdrv:	m_eInternalState = is_borderRowVer; break;
+	case RtfKeyword::kw_trbrdrh:	m_eInternalState = is_borderRowHor; break;
+
+	case RtfKeyword::kw_tsbrdrh:	m_eInternalState = is_borderRowHor; break;
+	case RtfKeyword::kw_tsbrdrv:	m_eInternalState = is_borderRowVer; break;
+	case RtfKeyword::kw_tsbrdrl:	m_eInternalState = is_borderRowLeft; break;
+	case RtfKeyword::kw_tsbrdrt:	m_eInternalState = is_borderRowTop; break;
+	case RtfKeyword::kw_tsbrdrr:	m_eInternalState = is_borderRowRight; break;
+	case RtfKeyword::kw_tsbrdrb:	m_eInternalState = is_borderRowBottom; break;
+	default:
+		if ( "*" == sCommand )
+			;
+		COMMAND_RTF_SPECIAL_CHAR( "|",		m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_Formula )
+		COMMAND_RTF_SPECIAL_CHAR( "~",		m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_NonBrSpace )
+		COMMAND_RTF_SPECIAL_CHAR( "-",		m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_OptHyphen )
+		COMMAND_RTF_SPECIAL_CHAR( "_",		m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_NonBrHyphen )
+		COMMAND_RTF_SPECIAL_CHAR( ":",		m_oCurParagraph, sCommand, hasParameter, RtfCharSpecial::rsc_SubEntry )
+		else
 		{
-		case is_borderBar:
-			bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, oReader.m_oState->m_oParagraphProp.m_oBorderBar );
-			break;
-		case is_borderBottom:
-			bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, oReader.m_oState->m_oParagraphProp.m_oBorderBottom );
-			break;
-		case is_borderBox:
-			bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, oReader.m_oState->m_oParagraphProp.m_oBorderBox );
-			break;
-		case is_borderLeft:
-			bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, oReader.m_oState->m_oParagraphProp.m_oBorderLeft );
-			break;
-		case is_borderRight:
-			bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, oReader.m_oState->m_oParagraphProp.m_oBorderRight );
-			break;
-		case is_borderTop:
-			bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, oReader.m_oState->m_oParagraphProp.m_oBorderTop );
-			break;
-			//----------------
-		case is_borderCellBottom:
-			bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oCellProperty.m_oBorderBottom );
-			break;
-		case is_borderCellLeft:
-			bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter,oReader.m_oState->m_oCellProperty.m_oBorderLeft );
-			break;
-		case is_borderCellRight:
-			bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oCellProperty.m_oBorderRight );
-			break;
-		case is_borderCellTop:
-			bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oCellProperty.m_oBorderTop );
-			break;
-		case is_borderCellLR:
-			bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oCellProperty.m_oBorderDiagonalLR );
-			break;
-		case is_borderCellRL:
-			bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oCellProperty.m_oBorderDiagonalRL );
-			break;
-			//----------
-		case is_borderRowBottom :
-			bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oRowProperty.m_oBorderBottom );
-			break;
-		case is_borderRowHor :
-			bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter,oReader.m_oState->m_oRowProperty.m_oBorderHor );
-			break;
-		case is_borderRowLeft :
-			bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oRowProperty.m_oBorderLeft );
-			break;
-		case is_borderRowRight :
-			bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oRowProperty.m_oBorderRight );
-			break;
-		case is_borderRowTop :
-			bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oRowProperty.m_oBorderTop );
-			break;
-		case is_borderRowVer :
-			bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oRowProperty.m_oBorderVert );
-			break;
-		default:
-			break;
-		}
-		if ( bResult )	return true;
+			bool bResult = false;
 
-		if (RtfShadingRowCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oRowProperty.m_oShading ))
-			return true;
-		
-		if ( is_charBorder == m_eInternalState )
-			if (RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter,  oReader.m_oState->m_oCharProp.m_poBorder))
+			switch(m_eInternalState)
+			{
+			case is_borderBar:
+				bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, oReader.m_oState->m_oParagraphProp.m_oBorderBar );
+				break;
+			case is_borderBottom:
+				bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, oReader.m_oState->m_oParagraphProp.m_oBorderBottom );
+				break;
+			case is_borderBox:
+				bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, oReader.m_oState->m_oParagraphProp.m_oBorderBox );
+				break;
+			case is_borderLeft:
+				bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, oReader.m_oState->m_oParagraphProp.m_oBorderLeft );
+				break;
+			case is_borderRight:
+				bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, oReader.m_oState->m_oParagraphProp.m_oBorderRight );
+				break;
+			case is_borderTop:
+				bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, oReader.m_oState->m_oParagraphProp.m_oBorderTop );
+				break;
+				//----------------
+			case is_borderCellBottom:
+				bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oCellProperty.m_oBorderBottom );
+				break;
+			case is_borderCellLeft:
+				bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter,oReader.m_oState->m_oCellProperty.m_oBorderLeft );
+				break;
+			case is_borderCellRight:
+				bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oCellProperty.m_oBorderRight );
+				break;
+			case is_borderCellTop:
+				bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oCellProperty.m_oBorderTop );
+				break;
+			case is_borderCellLR:
+				bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oCellProperty.m_oBorderDiagonalLR );
+				break;
+			case is_borderCellRL:
+				bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oCellProperty.m_oBorderDiagonalRL );
+				break;
+				//----------
+			case is_borderRowBottom :
+				bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oRowProperty.m_oBorderBottom );
+				break;
+			case is_borderRowHor :
+				bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter,oReader.m_oState->m_oRowProperty.m_oBorderHor );
+				break;
+			case is_borderRowLeft :
+				bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oRowProperty.m_oBorderLeft );
+				break;
+			case is_borderRowRight :
+				bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oRowProperty.m_oBorderRight );
+				break;
+			case is_borderRowTop :
+				bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oRowProperty.m_oBorderTop );
+				break;
+			case is_borderRowVer :
+				bResult = RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oRowProperty.m_oBorderVert );
+				break;
+			default:
+				break;
+			}
+			if ( bResult )	return true;
+
+			if (RtfShadingRowCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter, oReader.m_oState->m_oRowProperty.m_oShading ))
+				return true;
+			
+			if ( is_charBorder == m_eInternalState )
+				if (RtfBorderCommand::ExecuteCommand( oDocument, oReader,sCommand, hasParameter, parameter,  oReader.m_oState->m_oCharProp.m_poBorder))
+					return true;
+			
+			if (RtfTableRowPropsCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, &oReader.m_oState->m_oRowProperty ))
+				return true;
+			
+			if (RtfTableCellPropsCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, &oReader.m_oState->m_oCellProperty ))
 				return true;
-		
-		if (RtfTableRowPropsCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, &oReader.m_oState->m_oRowProperty ))
-			return true;
-		
-		if (RtfTableCellPropsCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, &oReader.m_oState->m_oCellProperty ))
-			return true;
 
-		if (RtfParagraphPropsCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, &oReader.m_oState->m_oParagraphProp ))
-			return true;
-		
-		if (RtfCharPropsCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, &oReader.m_oState->m_oCharProp ))
-			return true;
+			if (RtfParagraphPropsCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, &oReader.m_oState->m_oParagraphProp ))
+				return true;
+			
+			if (RtfCharPropsCommand::ExecuteCommand( oDocument, oReader, sCommand, hasParameter, parameter, &oReader.m_oState->m_oCharProp ))
+				return true;
 
-		return false;
+			return false;
+		}
+		break;
 	}
 	m_oCurParagraph->SetValid(true);
 	return true;
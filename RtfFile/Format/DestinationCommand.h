@@ -69,6 +69,29 @@
 	pNewChar->m_oProperty = oReader.m_oState->m_oCharProp;\
 	target->AddItem( pNewChar );\
 	}
+//то же для switch по номеру keyword (oReader.m_eKeyword)
+#define CASE_RTF_BOOL( keyword, target, hasParameter, parameter )\
+	case RtfKeyword::kw_##keyword:\
+{\
+	if( true == hasParameter && 0 == parameter)\
+	target = 0;\
+	else\
+	target = 1;\
+	}break;
+#define CASE_RTF_INT( keyword, target, hasParameter, parameter )\
+	case RtfKeyword::kw_##keyword:\
+{\
+	if( true == hasParameter )\
+	target = parameter;\
+	}break;
+#define CASE_RTF_SPECIAL_CHAR( keyword, target, hasParameter, parameter )\
+	case RtfKeyword::kw_##keyword:\
+{\
+	RtfCharSpecialPtr pNewChar ( new RtfCharSpecial() );\
+	pNewChar->m_eType = parameter;\
+	pNewChar->m_oProperty = oReader.m_oState->m_oCharProp;\
+	target->AddItem( pNewChar );\
+	}break;
 //Command не имеет состояний
 #include "math.h"
 
@@ -162,10 +185,12 @@ public:
 class RtfHEXStringReader : public RtfAbstractReader
 {
 private:
-	std::string sHexString;
+	std::vector<BYTE> m_arData;
 public: 
 	std::pair<boost::shared_array<unsigned char>, int> pDataArray;
 
+	RtfHEXStringReader();
+
 	virtual void ExecuteTextInternal2(RtfDocument& oDocument, RtfReader& oReader, std::string & sKey, int& nSkipChars);
 	void ExitReader(RtfDocument& oDocument, RtfReader& oReader);
 };
@@ -289,9 +314,8 @@ private:
 	_InternalState	m_eInternalState; private:
 	RtfShape&		m_oShape;
 	std::wstring	m_sFile;
-	std::wstring	m_sData;
-	bool			m_bBin;
-	BYTE*			m_pbBin;
+	std::vector<BYTE> m_arData;		//hex данные, декодируются лексером
+	const BYTE*		m_pBin;			//\binN - без копирования, в буфере лексера
 	size_t			m_nBinLength;
 public:
 	RtfPictureReader( RtfReader& oReader, RtfShape& oShape );
@@ -0,0 +1,66 @@
+/*
+ * (c) Copyright UNIVAULT TECHNOLOGIES 2026-2026
+ *
+ * This program is a free software product. You can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License (AGPL)
+ * version 3 as published by the Free Software Foundation. In accordance with
+ * Section 7(a) of the GNU AGPL its Section 15 shall be amended to the effect
+ * that UNIVAULT TECHNOLOGIES expressly excludes the warranty of non-infringement
+ * of any third-party rights.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR  PURPOSE. For
+ * details, see the GNU AGPL at: http://www.gnu.org/licenses/agpl-3.0.html
+ *
+ * You can contact UNIVAULT TECHNOLOGIES at 20A-6 Ernesta Birznieka-Upish
+ * street, Moscow (TEST), Russia (TEST), EU, 000000 (TEST).
+ *
+ * The  interactive user interfaces in modified source and object code versions
+ * of the Program must display Appropriate Legal Notices, as required under
+ * Section 5 of the GNU AGPL version 3.
+ *
+ * Pursuant to Section 7(b) of the License you must retain the original Product
+ * logo when distributing the program. Pursuant to Section 7(e) we decline to
+ * grant you any rights under trademark law for use of our trademarks.
+ *
+ * All the Product's GUI elements, including illustrations and icon sets, as
+ * well as technical writing content are licensed under the terms of the
+ * Creative Commons Attribution-ShareAlike 4.0 International. See the License
+ * terms at http://creativecommons.org/licenses/by-sa/4.0/legalcode
+ *
+ */
+
+#include "RtfKeyword.h"
+
+#include <string.h>
+
+RtfKeyword::_Keyword RtfKeyword::Find(const char* sKey, size_t nLength)
+{
+	unsigned int nHash = 2166136261u;
+	for (size_t i = 0; i < nLength; ++i)
+		nHash = (nHash ^ (unsigned char)sKey[i]) * 16777619u;
+
+	switch (nHash)
+	{
+#define RTF_KEYWORD(name)\
+	case RtfKeywordHash(#name):\
+		return (sizeof(#name) - 1 == nLength && 0 == memcmp(sKey, #name, nLength)) ? kw_##name : kw_unknown;
+		RTF_KEYWORDS
+#undef RTF_KEYWORD
+	default:
+		break;
+	}
+	return kw_unknown;
+}
+const char* RtfKeyword::Name(_Keyword eKeyword)
+{
+	switch (eKeyword)
+	{
+#define RTF_KEYWORD(name) case kw_##name: return #name;
+		RTF_KEYWORDS
+#undef RTF_KEYWORD
+	default:
+		break;
+	}
+	return "";
+}
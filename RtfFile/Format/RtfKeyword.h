@@ -0,0 +1,239 @@
+/*
+ * (c) Copyright UNIVAULT TECHNOLOGIES 2026-2026
+ *
+ * This program is a free software product. You can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License (AGPL)
+ * version 3 as published by the Free Software Foundation. In accordance with
+ * Section 7(a) of the GNU AGPL its Section 15 shall be amended to the effect
+ * that UNIVAULT TECHNOLOGIES expressly excludes the warranty of non-infringement
+ * of any third-party rights.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR  PURPOSE. For
+ * details, see the GNU AGPL at: http://www.gnu.org/licenses/agpl-3.0.html
+ *
+ * You can contact UNIVAULT TECHNOLOGIES at 20A-6 Ernesta Birznieka-Upish
+ * street, Moscow (TEST), Russia (TEST), EU, 000000 (TEST).
+ *
+ * The  interactive user interfaces in modified source and object code versions
+ * of the Program must display Appropriate Legal Notices, as required under
+ * Section 5 of the GNU AGPL version 3.
+ *
+ * Pursuant to Section 7(b) of the License you must retain the original Product
+ * logo when distributing the program. Pursuant to Section 7(e) we decline to
+ * grant you any rights under trademark law for use of our trademarks.
+ *
+ * All the Product's GUI elements, including illustrations and icon sets, as
+ * well as technical writing content are licensed under the terms of the
+ * Creative Commons Attribution-ShareAlike 4.0 International. See the License
+ * terms at http://creativecommons.org/licenses/by-sa/4.0/legalcode
+ *
+ */
+#pragma once
+
+#include <string>
+
+// Все управляющие слова, которые разбирают читатели DestinationCommand.
+// Каждое слово получает свой номер (RtfKeyword::kw_<слово>), по нему идет switch.
+// Номер ищется через хэш от строки; совпадение хэшей двух слов списка
+// даст ошибку компиляции (повтор case в RtfKeyword::Find), т.е. хэш совершенный.
+// Новое слово достаточно добавить в список.
+#define RTF_KEYWORDS \
+	RTF_KEYWORD(absh) RTF_KEYWORD(abslock) RTF_KEYWORD(absnoovrlp) RTF_KEYWORD(absw) RTF_KEYWORD(adjustright) RTF_KEYWORD(aenddoc) \
+	RTF_KEYWORD(aendnotes) RTF_KEYWORD(aftnbj) RTF_KEYWORD(aftnnalc) RTF_KEYWORD(aftnnar) RTF_KEYWORD(aftnnauc) RTF_KEYWORD(aftnnchi) \
+	RTF_KEYWORD(aftnncnum) RTF_KEYWORD(aftnndbar) RTF_KEYWORD(aftnndbnum) RTF_KEYWORD(aftnndbnumd) RTF_KEYWORD(aftnndbnumk) RTF_KEYWORD(aftnndbnumt) \
+	RTF_KEYWORD(aftnnganada) RTF_KEYWORD(aftnngbnum) RTF_KEYWORD(aftnngbnumd) RTF_KEYWORD(aftnngbnumk) RTF_KEYWORD(aftnngbnuml) RTF_KEYWORD(aftnnrlc) \
+	RTF_KEYWORD(aftnnruc) RTF_KEYWORD(aftnnzodiac) RTF_KEYWORD(aftnnzodiacd) RTF_KEYWORD(aftnnzodiacl) RTF_KEYWORD(aftnrestart) RTF_KEYWORD(aftnrstcont) \
+	RTF_KEYWORD(aftnsep) RTF_KEYWORD(aftnsepc) RTF_KEYWORD(aftnstart) RTF_KEYWORD(aftntj) RTF_KEYWORD(animtext) RTF_KEYWORD(annotation) \
+	RTF_KEYWORD(ansi) RTF_KEYWORD(ansicpg) RTF_KEYWORD(atnauthor) RTF_KEYWORD(atndate) RTF_KEYWORD(atnid) RTF_KEYWORD(atnparent) \
+	RTF_KEYWORD(atnref) RTF_KEYWORD(atrfend) RTF_KEYWORD(atrfstart) RTF_KEYWORD(author) RTF_KEYWORD(b) RTF_KEYWORD(background) \
+	RTF_KEYWORD(bgbdiag) RTF_KEYWORD(bgcross) RTF_KEYWORD(bgdcross) RTF_KEYWORD(bgdkbdiag) RTF_KEYWORD(bgdkcross) RTF_KEYWORD(bgdkdcross) \
+	RTF_KEYWORD(bgdkfdiag) RTF_KEYWORD(bgdkhoriz) RTF_KEYWORD(bgdkvert) RTF_KEYWORD(bgfdiag) RTF_KEYWORD(bghoriz) RTF_KEYWORD(bgvert) \
+	RTF_KEYWORD(bin) RTF_KEYWORD(binfsxn) RTF_KEYWORD(binsxn) RTF_KEYWORD(bkmkcolf) RTF_KEYWORD(bkmkcoll) RTF_KEYWORD(bkmkend) \
+	RTF_KEYWORD(bkmkstart) RTF_KEYWORD(blue) RTF_KEYWORD(box) RTF_KEYWORD(brdrart) RTF_KEYWORD(brdrb) RTF_KEYWORD(brdrbar) \
+	RTF_KEYWORD(brdrbtw) RTF_KEYWORD(brdrcf) RTF_KEYWORD(brdrdash) RTF_KEYWORD(brdrdashd) RTF_KEYWORD(brdrdashdd) RTF_KEYWORD(brdrdashdot) \
+	RTF_KEYWORD(brdrdashdotdot) RTF_KEYWORD(brdrdashdotstr) RTF_KEYWORD(brdrdashsm) RTF_KEYWORD(brdrdb) RTF_KEYWORD(brdrdot) RTF_KEYWORD(brdremboss) \
+	RTF_KEYWORD(brdrengrave) RTF_KEYWORD(brdrhair) RTF_KEYWORD(brdrinset) RTF_KEYWORD(brdrl) RTF_KEYWORD(brdrn) RTF_KEYWORD(brdrnil) \
+	RTF_KEYWORD(brdrnone) RTF_KEYWORD(brdroutset) RTF_KEYWORD(brdrr) RTF_KEYWORD(brdrs) RTF_KEYWORD(brdrsh) RTF_KEYWORD(brdrt) \
+	RTF_KEYWORD(brdrth) RTF_KEYWORD(brdrthtnlg) RTF_KEYWORD(brdrthtnmg) RTF_KEYWORD(brdrthtnsg) RTF_KEYWORD(brdrtnthlg) RTF_KEYWORD(brdrtnthmg) \
+	RTF_KEYWORD(brdrtnthsg) RTF_KEYWORD(brdrtnthtnlg) RTF_KEYWORD(brdrtnthtnmg) RTF_KEYWORD(brdrtnthtnsg) RTF_KEYWORD(brdrtriple) RTF_KEYWORD(brdrw) \
+	RTF_KEYWORD(brdrwavy) RTF_KEYWORD(brdrwavydb) RTF_KEYWORD(brsp) RTF_KEYWORD(bullet) RTF_KEYWORD(buptim) RTF_KEYWORD(caccentfive) \
+	RTF_KEYWORD(caccentfour) RTF_KEYWORD(caccentone) RTF_KEYWORD(caccentsix) RTF_KEYWORD(caccentthree) RTF_KEYWORD(caccenttwo) RTF_KEYWORD(caps) \
+	RTF_KEYWORD(category) RTF_KEYWORD(cbackgroundone) RTF_KEYWORD(cbackgroundtwo) RTF_KEYWORD(cbpat) RTF_KEYWORD(cell) RTF_KEYWORD(cellx) \
+	RTF_KEYWORD(cf) RTF_KEYWORD(cfollowedhyperlink) RTF_KEYWORD(cfpat) RTF_KEYWORD(charscalex) RTF_KEYWORD(chatn) RTF_KEYWORD(chbgbdiag) \
+	RTF_KEYWORD(chbgcross) RTF_KEYWORD(chbgdcross) RTF_KEYWORD(chbgdkbdiag) RTF_KEYWORD(chbgdkcross) RTF_KEYWORD(chbgdkdcross) RTF_KEYWORD(chbgdkfdiag) \
+	RTF_KEYWORD(chbgdkhoriz) RTF_KEYWORD(chbgdkvert) RTF_KEYWORD(chbgfdiag) RTF_KEYWORD(chbghoriz) RTF_KEYWORD(chbgvert) RTF_KEYWORD(chbrdr) \
+	RTF_KEYWORD(chcbpat) RTF_KEYWORD(chcfpat) RTF_KEYWORD(chftn) RTF_KEYWORD(chftnsep) RTF_KEYWORD(chftnsepc) RTF_KEYWORD(chpgn) \
+	RTF_KEYWORD(chshdng) RTF_KEYWORD(chyperlink) RTF_KEYWORD(clbgbdiag) RTF_KEYWORD(clbgcross) RTF_KEYWORD(clbgdcross) RTF_KEYWORD(clbgdkbdiag) \
+	RTF_KEYWORD(clbgdkcross) RTF_KEYWORD(clbgdkdcross) RTF_KEYWORD(clbgdkfdiag) RTF_KEYWORD(clbgdkhor) RTF_KEYWORD(clbgdkvert) RTF_KEYWORD(clbgfdiag) \
+	RTF_KEYWORD(clbgvert) RTF_KEYWORD(clbrdrb) RTF_KEYWORD(clbrdrl) RTF_KEYWORD(clbrdrr) RTF_KEYWORD(clbrdrt) RTF_KEYWORD(clcbpat) \
+	RTF_KEYWORD(clcbpatraw) RTF_KEYWORD(clcfpat) RTF_KEYWORD(clcfpatraw) RTF_KEYWORD(cldgll) RTF_KEYWORD(cldglu) RTF_KEYWORD(clFitText) \
+	RTF_KEYWORD(clftsWidth) RTF_KEYWORD(clhidemark) RTF_KEYWORD(clmgf) RTF_KEYWORD(clmrg) RTF_KEYWORD(clNoWrap) RTF_KEYWORD(clpadb) \
+	RTF_KEYWORD(clpadfb) RTF_KEYWORD(clpadfl) RTF_KEYWORD(clpadfr) RTF_KEYWORD(clpadft) RTF_KEYWORD(clpadl) RTF_KEYWORD(clpadr) \
+	RTF_KEYWORD(clpadt) RTF_KEYWORD(clshdng) RTF_KEYWORD(clshdngraw) RTF_KEYWORD(clshdrawnil) RTF_KEYWORD(clspb) RTF_KEYWORD(clspfb) \
+	RTF_KEYWORD(clspfl) RTF_KEYWORD(clspfr) RTF_KEYWORD(clspft) RTF_KEYWORD(clspl) RTF_KEYWORD(clspr) RTF_KEYWORD(clspt) \
+	RTF_KEYWORD(cltxbtlr) RTF_KEYWORD(cltxlrtb) RTF_KEYWORD(cltxlrtbv) RTF_KEYWORD(cltxtbrl) RTF_KEYWORD(cltxtbrlv) RTF_KEYWORD(clvertalb) \
+	RTF_KEYWORD(clvertalc) RTF_KEYWORD(clvertalt) RTF_KEYWORD(clvmgf) RTF_KEYWORD(clvmrg) RTF_KEYWORD(clwWidth) RTF_KEYWORD(cmaindarkone) \
+	RTF_KEYWORD(cmaindarktwo) RTF_KEYWORD(cmainlightone) RTF_KEYWORD(cmainlighttwo) RTF_KEYWORD(colno) RTF_KEYWORD(colorschememapping) RTF_KEYWORD(colortbl) \
+	RTF_KEYWORD(cols) RTF_KEYWORD(colsr) RTF_KEYWORD(colsx) RTF_KEYWORD(column) RTF_KEYWORD(colw) RTF_KEYWORD(comment) \
+	RTF_KEYWORD(company) RTF_KEYWORD(contextualspace) RTF_KEYWORD(cpg) RTF_KEYWORD(crauth) RTF_KEYWORD(crdate) RTF_KEYWORD(creatim) \
+	RTF_KEYWORD(cs) RTF_KEYWORD(cshade) RTF_KEYWORD(ctextone) RTF_KEYWORD(ctexttwo) RTF_KEYWORD(ctint) RTF_KEYWORD(datafield) \
+	RTF_KEYWORD(datastore) RTF_KEYWORD(defchp) RTF_KEYWORD(deff) RTF_KEYWORD(deflang) RTF_KEYWORD(deflangfe) RTF_KEYWORD(defpap) \
+	RTF_KEYWORD(deftab) RTF_KEYWORD(deleted) RTF_KEYWORD(dfrmtxtx) RTF_KEYWORD(dfrmtxty) RTF_KEYWORD(dghorigin) RTF_KEYWORD(dghshow) \
+	RTF_KEYWORD(dghspace) RTF_KEYWORD(dgmargin) RTF_KEYWORD(dgsnap) RTF_KEYWORD(dgvorigin) RTF_KEYWORD(dgvshow) RTF_KEYWORD(dgvspace) \
+	RTF_KEYWORD(do) RTF_KEYWORD(dobxcolumn) RTF_KEYWORD(dobxmargin) RTF_KEYWORD(dobxpage) RTF_KEYWORD(dobymargin) RTF_KEYWORD(dobypage) \
+	RTF_KEYWORD(dobypara) RTF_KEYWORD(doccomm) RTF_KEYWORD(dodhgt) RTF_KEYWORD(dofblwtxt) RTF_KEYWORD(dofhdr) RTF_KEYWORD(doinst) \
+	RTF_KEYWORD(dolockanchor) RTF_KEYWORD(dorslt) RTF_KEYWORD(down) RTF_KEYWORD(dowr) RTF_KEYWORD(dowrk) RTF_KEYWORD(doz) \
+	RTF_KEYWORD(dparc) RTF_KEYWORD(dpcallout) RTF_KEYWORD(dpellipse) RTF_KEYWORD(dpfillbgcb) RTF_KEYWORD(dpfillbgcg) RTF_KEYWORD(dpfillbgcr) \
+	RTF_KEYWORD(dpfillfgcb) RTF_KEYWORD(dpfillfgcg) RTF_KEYWORD(dpfillfgcr) RTF_KEYWORD(dpfillpat) RTF_KEYWORD(dpline) RTF_KEYWORD(dplinecob) \
+	RTF_KEYWORD(dplinecog) RTF_KEYWORD(dplinecor) RTF_KEYWORD(dplinedash) RTF_KEYWORD(dplinedot) RTF_KEYWORD(dplinehollow) RTF_KEYWORD(dplinew) \
+	RTF_KEYWORD(dppolygon) RTF_KEYWORD(dppolyline) RTF_KEYWORD(dprect) RTF_KEYWORD(dproundr) RTF_KEYWORD(dptxbx) RTF_KEYWORD(dptxbxmar) \
+	RTF_KEYWORD(dptxbxtext) RTF_KEYWORD(dpx) RTF_KEYWORD(dpxsize) RTF_KEYWORD(dpy) RTF_KEYWORD(dpysize) RTF_KEYWORD(dropcapli) \
+	RTF_KEYWORD(dropcapt) RTF_KEYWORD(ds) RTF_KEYWORD(dxfrtext) RTF_KEYWORD(dy) RTF_KEYWORD(edmins) RTF_KEYWORD(embo) \
+	RTF_KEYWORD(emdash) RTF_KEYWORD(emfblip) RTF_KEYWORD(emspace) RTF_KEYWORD(endash) RTF_KEYWORD(enddoc) RTF_KEYWORD(endnhere) \
+	RTF_KEYWORD(endnotes) RTF_KEYWORD(enspace) RTF_KEYWORD(expnd) RTF_KEYWORD(expndtw) RTF_KEYWORD(f) RTF_KEYWORD(faauto) \
+	RTF_KEYWORD(facenter) RTF_KEYWORD(facingp) RTF_KEYWORD(fafixed) RTF_KEYWORD(fahang) RTF_KEYWORD(falt) RTF_KEYWORD(faroman) \
+	RTF_KEYWORD(favar) RTF_KEYWORD(fbidi) RTF_KEYWORD(fbimajor) RTF_KEYWORD(fbiminor) RTF_KEYWORD(fcharset) RTF_KEYWORD(fcs) \
+	RTF_KEYWORD(fdbmajor) RTF_KEYWORD(fdbminor) RTF_KEYWORD(fdecor) RTF_KEYWORD(ffdefres) RTF_KEYWORD(ffdeftext) RTF_KEYWORD(ffentrymcr) \
+	RTF_KEYWORD(ffexitmcr) RTF_KEYWORD(ffformat) RTF_KEYWORD(ffhaslistbox) RTF_KEYWORD(ffhelptext) RTF_KEYWORD(ffhps) RTF_KEYWORD(ffl) \
+	RTF_KEYWORD(ffmaxlen) RTF_KEYWORD(ffname) RTF_KEYWORD(ffownhelp) RTF_KEYWORD(ffownstat) RTF_KEYWORD(ffprot) RTF_KEYWORD(ffrecalc) \
+	RTF_KEYWORD(ffres) RTF_KEYWORD(ffsize) RTF_KEYWORD(ffstattext) RTF_KEYWORD(fftype) RTF_KEYWORD(fftypetx) RTF_KEYWORD(fhimajor) \
+	RTF_KEYWORD(fhiminor) RTF_KEYWORD(fi) RTF_KEYWORD(field) RTF_KEYWORD(fittext) RTF_KEYWORD(fldalt) RTF_KEYWORD(flddirty) \
+	RTF_KEYWORD(fldedit) RTF_KEYWORD(fldinst) RTF_KEYWORD(fldlock) RTF_KEYWORD(fldpriv) RTF_KEYWORD(fldrslt) RTF_KEYWORD(flomajor) \
+	RTF_KEYWORD(flominor) RTF_KEYWORD(fmodern) RTF_KEYWORD(fnil) RTF_KEYWORD(fonttbl) RTF_KEYWORD(footer) RTF_KEYWORD(footerf) \
+	RTF_KEYWORD(footerl) RTF_KEYWORD(footerr) RTF_KEYWORD(footery) RTF_KEYWORD(footnote) RTF_KEYWORD(formfield) RTF_KEYWORD(fprq) \
+	RTF_KEYWORD(frmtxbtlr) RTF_KEYWORD(frmtxlrtb) RTF_KEYWORD(frmtxlrtbv) RTF_KEYWORD(frmtxtbrl) RTF_KEYWORD(frmtxtbrlv) RTF_KEYWORD(froman) \
+	RTF_KEYWORD(fs) RTF_KEYWORD(fscript) RTF_KEYWORD(fswiss) RTF_KEYWORD(ftech) RTF_KEYWORD(ftnalt) RTF_KEYWORD(ftnbj) \
+	RTF_KEYWORD(ftnnalc) RTF_KEYWORD(ftnnar) RTF_KEYWORD(ftnnauc) RTF_KEYWORD(ftnnchi) RTF_KEYWORD(ftnncnum) RTF_KEYWORD(ftnndbar) \
+	RTF_KEYWORD(ftnndbnum) RTF_KEYWORD(ftnndbnumd) RTF_KEYWORD(ftnndbnumk) RTF_KEYWORD(ftnndbnumt) RTF_KEYWORD(ftnnganada) RTF_KEYWORD(ftnngbnum) \
+	RTF_KEYWORD(ftnngbnumd) RTF_KEYWORD(ftnngbnumk) RTF_KEYWORD(ftnngbnuml) RTF_KEYWORD(ftnnrlc) RTF_KEYWORD(ftnnruc) RTF_KEYWORD(ftnnzodiac) \
+	RTF_KEYWORD(ftnnzodiacd) RTF_KEYWORD(ftnnzodiacl) RTF_KEYWORD(ftnrestart) RTF_KEYWORD(ftnrstcont) RTF_KEYWORD(ftnrstpg) RTF_KEYWORD(ftnsep) \
+	RTF_KEYWORD(ftnsepc) RTF_KEYWORD(ftnstart) RTF_KEYWORD(ftntj) RTF_KEYWORD(green) RTF_KEYWORD(gutter) RTF_KEYWORD(gutterprl) \
+	RTF_KEYWORD(guttersxn) RTF_KEYWORD(header) RTF_KEYWORD(headerf) RTF_KEYWORD(headerl) RTF_KEYWORD(headerr) RTF_KEYWORD(headery) \
+	RTF_KEYWORD(highlight) RTF_KEYWORD(hlinkbase) RTF_KEYWORD(hr) RTF_KEYWORD(htmautsp) RTF_KEYWORD(hyphauto) RTF_KEYWORD(hyphcaps) \
+	RTF_KEYWORD(hyphconsec) RTF_KEYWORD(hyphhotz) RTF_KEYWORD(hyphpar) RTF_KEYWORD(i) RTF_KEYWORD(id) RTF_KEYWORD(ilvl) \
+	RTF_KEYWORD(impr) RTF_KEYWORD(indmirror) RTF_KEYWORD(info) RTF_KEYWORD(insrsid) RTF_KEYWORD(intbl) RTF_KEYWORD(irow) \
+	RTF_KEYWORD(irowband) RTF_KEYWORD(itap) RTF_KEYWORD(jclisttab) RTF_KEYWORD(jpegblip) RTF_KEYWORD(keep) RTF_KEYWORD(keepn) \
+	RTF_KEYWORD(kerning) RTF_KEYWORD(keywords) RTF_KEYWORD(landscape) RTF_KEYWORD(lang) RTF_KEYWORD(langfe) RTF_KEYWORD(lastrow) \
+	RTF_KEYWORD(latentstyles) RTF_KEYWORD(lbr) RTF_KEYWORD(ldblquote) RTF_KEYWORD(levelfollow) RTF_KEYWORD(levelindent) RTF_KEYWORD(leveljc) \
+	RTF_KEYWORD(leveljcn) RTF_KEYWORD(levellegal) RTF_KEYWORD(levelnfc) RTF_KEYWORD(levelnfcn) RTF_KEYWORD(levelnorestart) RTF_KEYWORD(levelnumbers) \
+	RTF_KEYWORD(levelpicture) RTF_KEYWORD(levelspace) RTF_KEYWORD(levelstartat) RTF_KEYWORD(leveltext) RTF_KEYWORD(lfolevel) RTF_KEYWORD(li) \
+	RTF_KEYWORD(lin) RTF_KEYWORD(line) RTF_KEYWORD(linebetcol) RTF_KEYWORD(linecont) RTF_KEYWORD(linemod) RTF_KEYWORD(lineppage) \
+	RTF_KEYWORD(linerestart) RTF_KEYWORD(linestarts) RTF_KEYWORD(linex) RTF_KEYWORD(lisa) RTF_KEYWORD(lisb) RTF_KEYWORD(list) \
+	RTF_KEYWORD(listhybrid) RTF_KEYWORD(listid) RTF_KEYWORD(listlevel) RTF_KEYWORD(listname) RTF_KEYWORD(listoverride) RTF_KEYWORD(listoverrideformat) \
+	RTF_KEYWORD(listoverridestartat) RTF_KEYWORD(listoverridetable) RTF_KEYWORD(listpicture) RTF_KEYWORD(listsimple) RTF_KEYWORD(listtable) RTF_KEYWORD(listtemplateid) \
+	RTF_KEYWORD(listtext) RTF_KEYWORD(lndscpsxn) RTF_KEYWORD(lquote) RTF_KEYWORD(ls) RTF_KEYWORD(lsdlocked) RTF_KEYWORD(lsdlockeddef) \
+	RTF_KEYWORD(lsdlockedexcept) RTF_KEYWORD(lsdpriority) RTF_KEYWORD(lsdprioritydef) RTF_KEYWORD(lsdqformat) RTF_KEYWORD(lsdqformatdef) RTF_KEYWORD(lsdsemihidden) \
+	RTF_KEYWORD(lsdsemihiddendef) RTF_KEYWORD(lsdstimax) RTF_KEYWORD(lsdunhideused) RTF_KEYWORD(lsdunhideuseddef) RTF_KEYWORD(ltrch) RTF_KEYWORD(ltrpar) \
+	RTF_KEYWORD(ltrrow) RTF_KEYWORD(lvltentative) RTF_KEYWORD(mac) RTF_KEYWORD(macpict) RTF_KEYWORD(manager) RTF_KEYWORD(margb) \
+	RTF_KEYWORD(margbsxn) RTF_KEYWORD(margl) RTF_KEYWORD(marglsxn) RTF_KEYWORD(margmirror) RTF_KEYWORD(margmirsxn) RTF_KEYWORD(margr) \
+	RTF_KEYWORD(margrsxn) RTF_KEYWORD(margt) RTF_KEYWORD(margtsxn) RTF_KEYWORD(mbrkBin) RTF_KEYWORD(mbrkBinSub) RTF_KEYWORD(mctrlPr) \
+	RTF_KEYWORD(mdefJc) RTF_KEYWORD(min) RTF_KEYWORD(mintLim) RTF_KEYWORD(mLim) RTF_KEYWORD(mmath) RTF_KEYWORD(mmathFont) \
+	RTF_KEYWORD(mmathPict) RTF_KEYWORD(mmathPr) RTF_KEYWORD(mnaryLim) RTF_KEYWORD(mo) RTF_KEYWORD(nestcell) RTF_KEYWORD(nestrow) \
+	RTF_KEYWORD(nesttableprops) RTF_KEYWORD(nofchars) RTF_KEYWORD(nofcharsws) RTF_KEYWORD(nofpages) RTF_KEYWORD(nofwords) RTF_KEYWORD(nonesttables) \
+	RTF_KEYWORD(nonshppict) RTF_KEYWORD(nosectexpand) RTF_KEYWORD(nosupersub) RTF_KEYWORD(nowwrap) RTF_KEYWORD(objclass) RTF_KEYWORD(objdata) \
+	RTF_KEYWORD(object) RTF_KEYWORD(objemb) RTF_KEYWORD(objh) RTF_KEYWORD(objlink) RTF_KEYWORD(objw) RTF_KEYWORD(ogutter) \
+	RTF_KEYWORD(oldcprops) RTF_KEYWORD(oldpprops) RTF_KEYWORD(oldsprops) RTF_KEYWORD(oldtprops) RTF_KEYWORD(operator) RTF_KEYWORD(outl) \
+	RTF_KEYWORD(outlinelevel) RTF_KEYWORD(page) RTF_KEYWORD(pagebb) RTF_KEYWORD(panose) RTF_KEYWORD(paperh) RTF_KEYWORD(paperw) \
+	RTF_KEYWORD(par) RTF_KEYWORD(pard) RTF_KEYWORD(pc) RTF_KEYWORD(pca) RTF_KEYWORD(pgbrdrb) RTF_KEYWORD(pgbrdrfoot) \
+	RTF_KEYWORD(pgbrdrhead) RTF_KEYWORD(pgbrdrl) RTF_KEYWORD(pgbrdropt) RTF_KEYWORD(pgbrdrr) RTF_KEYWORD(pgbrdrsna) RTF_KEYWORD(pgbrdrsnap) \
+	RTF_KEYWORD(pgbrdrt) RTF_KEYWORD(pghsxn) RTF_KEYWORD(pgncont) RTF_KEYWORD(pgndec) RTF_KEYWORD(pgnlcrm) RTF_KEYWORD(pgnrestart) \
+	RTF_KEYWORD(pgnstarts) RTF_KEYWORD(pgnucrm) RTF_KEYWORD(pgnx) RTF_KEYWORD(pgny) RTF_KEYWORD(pgwsxn) RTF_KEYWORD(phcol) \
+	RTF_KEYWORD(phmrg) RTF_KEYWORD(phpg) RTF_KEYWORD(piccropb) RTF_KEYWORD(piccropl) RTF_KEYWORD(piccropr) RTF_KEYWORD(piccropt) \
+	RTF_KEYWORD(pich) RTF_KEYWORD(pichgoal) RTF_KEYWORD(picprop) RTF_KEYWORD(picscaled) RTF_KEYWORD(picscalex) RTF_KEYWORD(picscaley) \
+	RTF_KEYWORD(pict) RTF_KEYWORD(picw) RTF_KEYWORD(picwgoal) RTF_KEYWORD(plain) RTF_KEYWORD(pn) RTF_KEYWORD(pnb) \
+	RTF_KEYWORD(pncaps) RTF_KEYWORD(pnf) RTF_KEYWORD(pnfs) RTF_KEYWORD(pngblip) RTF_KEYWORD(pnhang) RTF_KEYWORD(pni) \
+	RTF_KEYWORD(pnindent) RTF_KEYWORD(pnlvlblt) RTF_KEYWORD(pnqc) RTF_KEYWORD(pnql) RTF_KEYWORD(pnqr) RTF_KEYWORD(pnsp) \
+	RTF_KEYWORD(pnstart) RTF_KEYWORD(pnstrike) RTF_KEYWORD(pntext) RTF_KEYWORD(pntxtb) RTF_KEYWORD(pnul) RTF_KEYWORD(pnuld) \
+	RTF_KEYWORD(pnuldash) RTF_KEYWORD(pnuldashdd) RTF_KEYWORD(pnuldb) RTF_KEYWORD(pnulnone) RTF_KEYWORD(pnulth) RTF_KEYWORD(pnulwave) \
+	RTF_KEYWORD(posnegx) RTF_KEYWORD(posnegy) RTF_KEYWORD(posx) RTF_KEYWORD(posxc) RTF_KEYWORD(posxi) RTF_KEYWORD(posxl) \
+	RTF_KEYWORD(posxo) RTF_KEYWORD(posxr) RTF_KEYWORD(posy) RTF_KEYWORD(posyb) RTF_KEYWORD(posyc) RTF_KEYWORD(posyil) \
+	RTF_KEYWORD(posyin) RTF_KEYWORD(posyout) RTF_KEYWORD(posyt) RTF_KEYWORD(prauth) RTF_KEYWORD(prdate) RTF_KEYWORD(printim) \
+	RTF_KEYWORD(pvmrg) RTF_KEYWORD(pvpara) RTF_KEYWORD(pvpg) RTF_KEYWORD(qc) RTF_KEYWORD(qd) RTF_KEYWORD(qj) \
+	RTF_KEYWORD(qk) RTF_KEYWORD(ql) RTF_KEYWORD(qmspace) RTF_KEYWORD(qr) RTF_KEYWORD(rawclbgbdiag) RTF_KEYWORD(rawclbgcross) RTF_KEYWORD(rawclbgdcross) \
+	RTF_KEYWORD(rawclbgdkbdiag) RTF_KEYWORD(rawclbgdkcross) RTF_KEYWORD(rawclbgdkdcross) RTF_KEYWORD(rawclbgdkfdiag) RTF_KEYWORD(rawclbgdkhor) RTF_KEYWORD(rawclbgdkvert) \
+	RTF_KEYWORD(rawclbgfdiag) RTF_KEYWORD(rawclbgvert) RTF_KEYWORD(rdblquote) RTF_KEYWORD(red) RTF_KEYWORD(result) RTF_KEYWORD(revauth) \
+	RTF_KEYWORD(revauthdel) RTF_KEYWORD(revdttm) RTF_KEYWORD(revdttmdel) RTF_KEYWORD(revised) RTF_KEYWORD(revtbl) RTF_KEYWORD(revtim) \
+	RTF_KEYWORD(ri) RTF_KEYWORD(rin) RTF_KEYWORD(row) RTF_KEYWORD(rquote) RTF_KEYWORD(rsidtable) RTF_KEYWORD(rtf) \
+	RTF_KEYWORD(rtlch) RTF_KEYWORD(rtldoc) RTF_KEYWORD(rtlgutter) RTF_KEYWORD(rtlpar) RTF_KEYWORD(rtlrow) RTF_KEYWORD(rtlsect) \
+	RTF_KEYWORD(s) RTF_KEYWORD(sa) RTF_KEYWORD(saauto) RTF_KEYWORD(saftnnalc) RTF_KEYWORD(saftnnar) RTF_KEYWORD(saftnnauc) \
+	RTF_KEYWORD(saftnnchi) RTF_KEYWORD(saftnnchosung) RTF_KEYWORD(saftnncnum) RTF_KEYWORD(saftnndbar) RTF_KEYWORD(saftnndbnum) RTF_KEYWORD(saftnndbnumd) \
+	RTF_KEYWORD(saftnndbnumk) RTF_KEYWORD(saftnndbnumt) RTF_KEYWORD(saftnnganada) RTF_KEYWORD(saftnngbnum) RTF_KEYWORD(saftnngbnumd) RTF_KEYWORD(saftnngbnumk) \
+	RTF_KEYWORD(saftnngbnuml) RTF_KEYWORD(saftnnrlc) RTF_KEYWORD(saftnnruc) RTF_KEYWORD(saftnnzodiac) RTF_KEYWORD(saftnnzodiacd) RTF_KEYWORD(saftnnzodiacl) \
+	RTF_KEYWORD(saftnrestart) RTF_KEYWORD(saftnrstcont) RTF_KEYWORD(saftnstart) RTF_KEYWORD(sb) RTF_KEYWORD(sbasedon) RTF_KEYWORD(sbauto) \
+	RTF_KEYWORD(sbkcol) RTF_KEYWORD(sbkeven) RTF_KEYWORD(sbknone) RTF_KEYWORD(sbkodd) RTF_KEYWORD(sbkpage) RTF_KEYWORD(scaps) \
+	RTF_KEYWORD(scompose) RTF_KEYWORD(sec) RTF_KEYWORD(sect) RTF_KEYWORD(sectd) RTF_KEYWORD(sftnbj) RTF_KEYWORD(sftnnalc) \
+	RTF_KEYWORD(sftnnar) RTF_KEYWORD(sftnnauc) RTF_KEYWORD(sftnnchi) RTF_KEYWORD(sftnnchosung) RTF_KEYWORD(sftnncnum) RTF_KEYWORD(sftnndbar) \
+	RTF_KEYWORD(sftnndbnum) RTF_KEYWORD(sftnndbnumd) RTF_KEYWORD(sftnndbnumk) RTF_KEYWORD(sftnndbnumt) RTF_KEYWORD(sftnnganada) RTF_KEYWORD(sftnngbnum) \
+	RTF_KEYWORD(sftnngbnumd) RTF_KEYWORD(sftnngbnumk) RTF_KEYWORD(sftnngbnuml) RTF_KEYWORD(sftnnrlc) RTF_KEYWORD(sftnnruc) RTF_KEYWORD(sftnnzodiac) \
+	RTF_KEYWORD(sftnnzodiacd) RTF_KEYWORD(sftnnzodiacl) RTF_KEYWORD(sftnrestart) RTF_KEYWORD(sftnrstcont) RTF_KEYWORD(sftnrstpg) RTF_KEYWORD(sftnstart) \
+	RTF_KEYWORD(sftntj) RTF_KEYWORD(shad) RTF_KEYWORD(shading) RTF_KEYWORD(shidden) RTF_KEYWORD(shp) RTF_KEYWORD(shpbottom) \
+	RTF_KEYWORD(shpbxcolumn) RTF_KEYWORD(shpbxignore) RTF_KEYWORD(shpbxmargin) RTF_KEYWORD(shpbxpage) RTF_KEYWORD(shpbyignore) RTF_KEYWORD(shpbymargin) \
+	RTF_KEYWORD(shpbypage) RTF_KEYWORD(shpbypara) RTF_KEYWORD(shpfblwtxt) RTF_KEYWORD(shpfhdr) RTF_KEYWORD(shpgrp) RTF_KEYWORD(shpinst) \
+	RTF_KEYWORD(shpleft) RTF_KEYWORD(shplid) RTF_KEYWORD(shplockanchor) RTF_KEYWORD(shppict) RTF_KEYWORD(shpright) RTF_KEYWORD(shprslt) \
+	RTF_KEYWORD(shptop) RTF_KEYWORD(shptxt) RTF_KEYWORD(shpwr) RTF_KEYWORD(shpwrk) RTF_KEYWORD(shpz) RTF_KEYWORD(sl) \
+	RTF_KEYWORD(slink) RTF_KEYWORD(slmult) RTF_KEYWORD(slocked) RTF_KEYWORD(sn) RTF_KEYWORD(snext) RTF_KEYWORD(softcol) \
+	RTF_KEYWORD(softlheight) RTF_KEYWORD(softline) RTF_KEYWORD(softpage) RTF_KEYWORD(sp) RTF_KEYWORD(spersonal) RTF_KEYWORD(spriority) \
+	RTF_KEYWORD(sqformat) RTF_KEYWORD(srauth) RTF_KEYWORD(srdate) RTF_KEYWORD(sreply) RTF_KEYWORD(ssemihidden) RTF_KEYWORD(stextflow) \
+	RTF_KEYWORD(strike) RTF_KEYWORD(striked) RTF_KEYWORD(stylesheet) RTF_KEYWORD(sub) RTF_KEYWORD(subject) RTF_KEYWORD(sunhideused) \
+	RTF_KEYWORD(super) RTF_KEYWORD(sv) RTF_KEYWORD(svgpict) RTF_KEYWORD(tab) RTF_KEYWORD(tabsnoovrlp) RTF_KEYWORD(taprtl) \
+	RTF_KEYWORD(tb) RTF_KEYWORD(tblind) RTF_KEYWORD(tblindtype) RTF_KEYWORD(tbllkhdrcols) RTF_KEYWORD(tbllkhdrrows) RTF_KEYWORD(tbllklastcol) \
+	RTF_KEYWORD(tbllklastrow) RTF_KEYWORD(tbllknocolband) RTF_KEYWORD(tbllknorowband) RTF_KEYWORD(tcelld) RTF_KEYWORD(tdfrmtxtBottom) RTF_KEYWORD(tdfrmtxtLeft) \
+	RTF_KEYWORD(tdfrmtxtRight) RTF_KEYWORD(tdfrmtxtTop) RTF_KEYWORD(themedata) RTF_KEYWORD(themelang) RTF_KEYWORD(themelangcs) RTF_KEYWORD(themelangfe) \
+	RTF_KEYWORD(title) RTF_KEYWORD(titlepg) RTF_KEYWORD(tldot) RTF_KEYWORD(tlhyph) RTF_KEYWORD(tlmdot) RTF_KEYWORD(tlth) \
+	RTF_KEYWORD(tlul) RTF_KEYWORD(tphcol) RTF_KEYWORD(tphmrg) RTF_KEYWORD(tphpg) RTF_KEYWORD(tposnegx) RTF_KEYWORD(tposnegy) \
+	RTF_KEYWORD(tposx) RTF_KEYWORD(tposxc) RTF_KEYWORD(tposxi) RTF_KEYWORD(tposxl) RTF_KEYWORD(tposxo) RTF_KEYWORD(tposxr) \
+	RTF_KEYWORD(tposy) RTF_KEYWORD(tposyb) RTF_KEYWORD(tposyc) RTF_KEYWORD(tposyil) RTF_KEYWORD(tposyin) RTF_KEYWORD(tposyout) \
+	RTF_KEYWORD(tposyt) RTF_KEYWORD(tpvmrg) RTF_KEYWORD(tpvpara) RTF_KEYWORD(tpvpg) RTF_KEYWORD(tqc) RTF_KEYWORD(tqdec) \
+	RTF_KEYWORD(tqr) RTF_KEYWORD(trauth) RTF_KEYWORD(trautofit) RTF_KEYWORD(trbgbdiag) RTF_KEYWORD(trbgcross) RTF_KEYWORD(trbgdcross) \
+	RTF_KEYWORD(trbgdkbdiag) RTF_KEYWORD(trbgdkcross) RTF_KEYWORD(trbgdkdcross) RTF_KEYWORD(trbgdkfdiag) RTF_KEYWORD(trbgdkhor) RTF_KEYWORD(trbgdkvert) \
+	RTF_KEYWORD(trbgfdiag) RTF_KEYWORD(trbghoriz) RTF_KEYWORD(trbgvert) RTF_KEYWORD(trbrdrb) RTF_KEYWORD(trbrdrh) RTF_KEYWORD(trbrdrl) \
+	RTF_KEYWORD(trbrdrr) RTF_KEYWORD(trbrdrt) RTF_KEYWORD(trbrdrv) RTF_KEYWORD(trcbpat) RTF_KEYWORD(trcfpat) RTF_KEYWORD(trdate) \
+	RTF_KEYWORD(trftsWidth) RTF_KEYWORD(trftsWidthA) RTF_KEYWORD(trftsWidthB) RTF_KEYWORD(trgaph) RTF_KEYWORD(trhdr) RTF_KEYWORD(trkeep) \
+	RTF_KEYWORD(trkeepfollow) RTF_KEYWORD(trleft) RTF_KEYWORD(trowd) RTF_KEYWORD(trpaddb) RTF_KEYWORD(trpaddfb) RTF_KEYWORD(trpaddfl) \
+	RTF_KEYWORD(trpaddfr) RTF_KEYWORD(trpaddft) RTF_KEYWORD(trpaddl) RTF_KEYWORD(trpaddr) RTF_KEYWORD(trpaddt) RTF_KEYWORD(trqc) \
+	RTF_KEYWORD(trql) RTF_KEYWORD(trqr) RTF_KEYWORD(trrh) RTF_KEYWORD(trshdng) RTF_KEYWORD(trspdb) RTF_KEYWORD(trspdfb) \
+	RTF_KEYWORD(trspdfl) RTF_KEYWORD(trspdfr) RTF_KEYWORD(trspdft) RTF_KEYWORD(trspdl) RTF_KEYWORD(trspdr) RTF_KEYWORD(trspdt) \
+	RTF_KEYWORD(trwWidth) RTF_KEYWORD(trwWidthA) RTF_KEYWORD(trwWidthB) RTF_KEYWORD(ts) RTF_KEYWORD(tsbgbdiag) RTF_KEYWORD(tsbgcross) \
+	RTF_KEYWORD(tsbgdcross) RTF_KEYWORD(tsbgdkbdiag) RTF_KEYWORD(tsbgdkcross) RTF_KEYWORD(tsbgdkdcross) RTF_KEYWORD(tsbgdkfdiag) RTF_KEYWORD(tsbgdkhor) \
+	RTF_KEYWORD(tsbgdkvert) RTF_KEYWORD(tsbgfdiag) RTF_KEYWORD(tsbghoriz) RTF_KEYWORD(tsbgvert) RTF_KEYWORD(tsbrdrb) RTF_KEYWORD(tsbrdrdgl) \
+	RTF_KEYWORD(tsbrdrdgr) RTF_KEYWORD(tsbrdrh) RTF_KEYWORD(tsbrdrl) RTF_KEYWORD(tsbrdrr) RTF_KEYWORD(tsbrdrt) RTF_KEYWORD(tsbrdrv) \
+	RTF_KEYWORD(tscbandhorzeven) RTF_KEYWORD(tscbandhorzodd) RTF_KEYWORD(tscbandsh) RTF_KEYWORD(tscbandsv) RTF_KEYWORD(tscbandverteven) RTF_KEYWORD(tscbandvertodd) \
+	RTF_KEYWORD(tscellcbpat) RTF_KEYWORD(tscellcfpat) RTF_KEYWORD(tscellpaddb) RTF_KEYWORD(tscellpaddfb) RTF_KEYWORD(tscellpaddfl) RTF_KEYWORD(tscellpaddfr) \
+	RTF_KEYWORD(tscellpaddft) RTF_KEYWORD(tscellpaddl) RTF_KEYWORD(tscellpaddr) RTF_KEYWORD(tscellpaddt) RTF_KEYWORD(tscellpct) RTF_KEYWORD(tscfirstcol) \
+	RTF_KEYWORD(tscfirstrow) RTF_KEYWORD(tsclastcol) RTF_KEYWORD(tsclastrow) RTF_KEYWORD(tscnecell) RTF_KEYWORD(tscnwcell) RTF_KEYWORD(tscsecell) \
+	RTF_KEYWORD(tscswcell) RTF_KEYWORD(tsnowrap) RTF_KEYWORD(tsvertalb) RTF_KEYWORD(tsvertalc) RTF_KEYWORD(tsvertalt) RTF_KEYWORD(tx) \
+	RTF_KEYWORD(u) RTF_KEYWORD(uc) RTF_KEYWORD(ul) RTF_KEYWORD(ulc) RTF_KEYWORD(uld) RTF_KEYWORD(uldash) \
+	RTF_KEYWORD(uldashd) RTF_KEYWORD(uldashdd) RTF_KEYWORD(uldb) RTF_KEYWORD(ulhwave) RTF_KEYWORD(ulldash) RTF_KEYWORD(ulnone) \
+	RTF_KEYWORD(ulth) RTF_KEYWORD(ulthd) RTF_KEYWORD(ulthdash) RTF_KEYWORD(ulthdashd) RTF_KEYWORD(ulthdashdd) RTF_KEYWORD(ulthldash) \
+	RTF_KEYWORD(ululdbwave) RTF_KEYWORD(ulw) RTF_KEYWORD(ulwave) RTF_KEYWORD(up) RTF_KEYWORD(useltbaln) RTF_KEYWORD(v) \
+	RTF_KEYWORD(vern) RTF_KEYWORD(version) RTF_KEYWORD(vertalb) RTF_KEYWORD(vertalc) RTF_KEYWORD(vertalj) RTF_KEYWORD(vertalt) \
+	RTF_KEYWORD(viewbksp) RTF_KEYWORD(viewscale) RTF_KEYWORD(wmetafile) RTF_KEYWORD(wraparound) RTF_KEYWORD(wrapdefault) RTF_KEYWORD(wrapthrough) \
+	RTF_KEYWORD(wraptight) RTF_KEYWORD(yr) RTF_KEYWORD(yts) RTF_KEYWORD(zwbo) RTF_KEYWORD(zwj) RTF_KEYWORD(zwnbo) \
+	RTF_KEYWORD(zwnj)
+
+class RtfKeyword
+{
+public:
+	typedef enum
+	{
+		kw_unknown = 0,
+#define RTF_KEYWORD(name) kw_##name,
+		RTF_KEYWORDS
+#undef RTF_KEYWORD
+		kw_count
+	} _Keyword;
+
+	static _Keyword Find(const char* sKey, size_t nLength);
+	static _Keyword Find(const std::string& sKey)
+	{
+		return Find(sKey.c_str(), sKey.length());
+	}
+	static const char* Name(_Keyword eKeyword);
+};
+
+// FNV-1a; constexpr - для меток case, вычисляется при компиляции
+constexpr unsigned int RtfKeywordHash(const char* sKey, unsigned int nHash = 2166136261u)
+{
+	return *sKey ? RtfKeywordHash(sKey + 1, (nHash ^ (unsigned char)*sKey) * 16777619u) : nHash;
+}
@@ -72,33 +72,15 @@ bool StringStream::SetSource( std::wstring sPath  )
 	srcFile.CloseFile();
 	return true;
 }
-void StringStream::getBytes( int nCount, BYTE** pbData )
+//без копирования - указатель в буфер файла, действителен до Clear/putString
+const BYTE* StringStream::getSpan( int nCount )
 {
-	if( m_nPosAbs + nCount < m_nSizeAbs )
-	{
-		(*pbData) = new BYTE[nCount];
-		memcpy( (*pbData), (m_aBuffer + m_nPosAbs + 1), nCount);
-		m_nPosAbs += nCount;
-	}
-}
-int StringStream::getc()
-{
-	int nResult = EOF;
-	if( m_nPosAbs + 1 < m_nSizeAbs )
-	{
-		m_nPosAbs++;
-		nResult = m_aBuffer[ m_nPosAbs ];
-	}
-	return nResult;
-}
-void StringStream::ungetc()
-{
-	//в проекте используется ungetcб только после getc
-	//поэтому проблем с выходом в 0 нет
-	//if( m_nPosAbs + 2 < m_nSizeAbs )
-	{
-		m_nPosAbs--;	//взять любой txt переименовать в rtf - зацикливание
-	}
+	if( nCount < 0 || m_nPosAbs + nCount >= m_nSizeAbs )
+		return NULL;
+
+	const BYTE* pData = m_aBuffer + m_nPosAbs + 1;
+	m_nPosAbs += nCount;
+	return pData;
 }
 void StringStream::putString( std::string sText )
 {
@@ -130,15 +112,11 @@ LONG64 StringStream::getSize()
 
 RtfLex::RtfLex()
 {
-	m_oFileWriter = NULL;
-	m_nReadBufSize = 1024 * 1024 * 5; // 5мб
-	m_caReadBuffer = new char[m_nReadBufSize];
+	m_pHexData = NULL;
+	m_nHexHalf = -1;
 }
 RtfLex::~RtfLex()
 {
-	if (m_caReadBuffer) delete []m_caReadBuffer;
-	m_caReadBuffer = NULL;
-	RELEASEOBJECT( m_oFileWriter );
 }
 double RtfLex::GetProgress()
 {
@@ -146,15 +124,7 @@ double RtfLex::GetProgress()
 }
 bool RtfLex::SetSource( std::wstring sPath )
 {
-	if (false == m_oStream.SetSource(sPath)) return false;
-
-	if (m_oStream.getSize() > m_nReadBufSize)
-	{
-		m_nReadBufSize = (int)m_oStream.getSize() ;
-		if (m_caReadBuffer) delete []m_caReadBuffer;
-		m_caReadBuffer = new char[m_nReadBufSize];
-	}
-	return true;
+	return m_oStream.SetSource(sPath);
 }
 void RtfLex::CloseSource()
 {
@@ -164,9 +134,9 @@ RtfToken RtfLex::NextCurToken()
 {
 	return m_oCurToken;
 }
-void RtfLex::ReadBytes( int nCount, BYTE** pbData )
+const BYTE* RtfLex::ReadBytes( int nCount )
 {
-	m_oStream.getBytes(nCount, pbData);
+	return m_oStream.getSpan(nCount);
 }
 RtfToken RtfLex::NextToken()
 {
@@ -194,10 +164,10 @@ RtfToken RtfLex::NextToken()
 			break;
 		default:
 			m_oCurToken.Type = RtfToken::Text;
-			if( NULL == m_oFileWriter )
+			if( NULL == m_pHexData )
 				parseText(c, m_oCurToken);
 			else
-				parseTextFile(c, m_oCurToken);
+				parseHexText(c, m_oCurToken);
 			break;
 		}
 	}
@@ -215,9 +185,6 @@ void RtfLex::putString( std::string sText )
 }
 void RtfLex::parseKeyword(RtfToken& token)
 {
-	std::string palabraClave;
-
-	std::wstring parametroStr ;
 	int parametroInt = 0;
 
 	int c = m_oStream.getc();
@@ -239,11 +206,13 @@ void RtfLex::parseKeyword(RtfToken& token)
 			{
 				token.Type = RtfToken::Keyword;
 				token.Key = std::string("tab");
+				token.KeywordId = RtfKeyword::kw_tab;
 			}
             else if( c == '\n'|| c == '\r' )
 			{
 				token.Type = RtfToken::Keyword;
 				token.Key = std::string("par");
+				token.KeywordId = RtfKeyword::kw_par;
 			}
 			else
 			{
@@ -275,20 +244,19 @@ void RtfLex::parseKeyword(RtfToken& token)
 		}
 		return;
 	}
-	c = m_oStream.getc();
-	m_oStream.ungetc();
-
-	while (RtfUtility::IsAlpha(c))
-	{
-		m_oStream.getc();
-		palabraClave += (char)c;
+	//слово и параметр разбираются прямо по буферу
+	const unsigned char* pStart = m_oStream.getCurrent();
+	const unsigned char* pEnd	= pStart + m_oStream.getAvailable();
+	const unsigned char* pCur	= pStart;
 
-		c = m_oStream.getc();
-		m_oStream.ungetc();
-	}
+	while (pCur < pEnd && RtfUtility::IsAlpha(*pCur))
+		pCur++;
 
 	token.Type = RtfToken::Keyword;
-	token.Key = palabraClave;
+	token.Key.assign((const char*)pStart, pCur - pStart);
+	token.KeywordId = RtfKeyword::Find((const char*)pStart, pCur - pStart);
+
+	c = pCur < pEnd ? *pCur : EOF;
 
 	if (RtfUtility::IsDigit(c) || c == '-')
 	{
@@ -297,48 +265,28 @@ void RtfLex::parseKeyword(RtfToken& token)
 		if (c == '-')
 		{
 			negativo = true;
-
-			m_oStream.getc();
+			pCur++;
 		}
 
-		c = m_oStream.getc();
-		m_oStream.ungetc();
-		while (RtfUtility::IsDigit(c))
-		{
-			m_oStream.getc();
-			parametroStr += c;
-
-			c = m_oStream.getc();
-			m_oStream.ungetc();
-		}
-		try
+		const unsigned char* pDigits = pCur;
+		ULONG64 nValue = 0;
+		while (pCur < pEnd && RtfUtility::IsDigit(*pCur))
 		{
-			parametroInt = XmlUtils::GetInteger(parametroStr);
-		}
-		catch (...)
-		{
-			try
-			{
-				parametroInt = (int)XmlUtils::GetInteger64(parametroStr);
-			}
-			catch (...)
-			{
-			}
+			nValue = nValue * 10 + (*pCur - '0');
+			pCur++;
 		}
+		c = pCur < pEnd ? *pCur : EOF;
+
+		//число длиннее 64 бит - некорректное, 0
+		if (pCur - pDigits < 19)
+			parametroInt = (int)nValue;
 
 		if (negativo)
 			parametroInt = -parametroInt;
 
-		//if (c == ' ' || c == '\\' || c == '}' || c == '{' || c == '\"' || c == ';')
-		{
-			token.Parameter = parametroInt;
-		}
-		//else
-		//{
-		//	token.HasParameter = false;
-		//	//token.Parameter = 0;
-		//}
+		token.Parameter = parametroInt;
 	}
+	m_oStream.skip(pCur - pStart);
 
 	if (c == ' ')
 	{
@@ -347,87 +295,42 @@ void RtfLex::parseKeyword(RtfToken& token)
 }
 void RtfLex::parseText(int car, RtfToken& token)
 {
-	int nTempBufPos = 0; //1 мб
+	//текст берется кусками между переводами строк, без посимвольного копирования
+	const unsigned char* pCur	= m_oStream.getCurrent() - 1;
+	const unsigned char* pEnd	= pCur + 1 + m_oStream.getAvailable();
+	const unsigned char* pStart	= pCur;
 
-	int c = car;
-	//while ((isalnum(c) || c == '"'|| c == ':'|| c == '/' || c == '.') &&c != '\\' && c != '}' && c != '{' && c != Eof) // иправиЃEЃEрвьD усЃEвиЃE
-	//while (c != '\\' && c != '}' && c != '{' && c != Eof)
-	//while (c != ';' &&c ! = '\\' && c != '}' && c != '{' && c != EOF)
-	while (c != '\\' && c != '}' && c != '{' && c != EOF)
+	while (pCur < pEnd)
 	{
-		if( nTempBufPos >= m_nReadBufSize )
+		unsigned char c = *pCur;
+		if (c == '\\' || c == '}' || c == '{')
+			break;
+		//Se ignoran los retornos de carro, tabuladores y caracteres nulos
+		if (c == '\r' || c == '\n')
 		{
-			m_caReadBuffer[nTempBufPos++] = '\0';
-			token.Key += m_caReadBuffer ;
-			nTempBufPos = 0;
+			if (pCur > pStart)
+				token.Key.append((const char*)pStart, pCur - pStart);
+			pStart = pCur + 1;
 		}
-		m_caReadBuffer[nTempBufPos++] = (char)c;
-
-		c = m_oStream.getc();
-		//Se ignoran los retornos de carro, tabuladores y caracteres nulos
-		while (c == '\r' || c == '\n')
-			c = m_oStream.getc();
-	}
-	if (c != EOF)
-	{
-		m_oStream.ungetc();
+		pCur++;
 	}
-	if( nTempBufPos > 0 )
-	{
-		m_caReadBuffer[nTempBufPos++] = '\0';
-		token.Key += m_caReadBuffer ;
-	}
-}
-bool RtfLex::GetNextChar( int& nChar )
-{
-	int c = m_oStream.getc();
-	m_oStream.ungetc();
-	//Se ignoran los retornos de carro, tabuladores y caracteres nulos
-	while (c == '\r' || c == '\n')
-	{
-		m_oStream.getc();
-		c = m_oStream.getc();
-		m_oStream.ungetc();
-	}
-	if( c != '\\' && c != '}' && c != '{' && c != EOF )
-	{
-		m_oStream.getc();
-		nChar = c;
-		return true;
-	}
-	else
-		return false;
+	if (pCur > pStart)
+		token.Key.append((const char*)pStart, pCur - pStart);
+
+	//первый символ уже прочитан
+	m_oStream.skip(pCur - m_oStream.getCurrent());
 }
-void RtfLex::parseTextFile(int car, RtfToken& token)
+void RtfLex::parseHexText(int car, RtfToken& token)
 {
-	if (NULL == m_oFileWriter) return;
+	//hex данные (картинки и т.п.) - сразу в байты, минуя строку токена
+	const unsigned char* pCur	= m_oStream.getCurrent() - 1;
+	const unsigned char* pEnd	= pCur + 1 + m_oStream.getAvailable();
+	const unsigned char* pStart	= pCur;
 
-	try
-	{
-		int nFirst = car;
-		int nSecond = 0;
-		if( true == GetNextChar( nSecond ) )
-		{
-			BYTE byteByte = 10 * RtfUtility::ToByte( nFirst ) + RtfUtility::ToByte( nSecond  );
-			m_oFileWriter->Write( &byteByte, 1 );
-			while( true )
-			{
-				bool bContinue = false;
-				if (true == GetNextChar(nFirst))
-				{
-					if (true == GetNextChar(nSecond))
-					{
-						byteByte = 10 * Strings::ToDigit(nFirst) + Strings::ToDigit(nSecond);
-						m_oFileWriter->Write(&byteByte, 1);
-						bContinue = true;
-					}
-				}
-				if ( false == bContinue)
-					break;
-			}
-		}
-	}
-	catch(...)
-	{
-	}
+	while (pCur < pEnd && *pCur != '\\' && *pCur != '}' && *pCur != '{')
+		pCur++;
+
+	RtfUtility::DecodeHex(pStart, pCur - pStart, *m_pHexData, m_nHexHalf);
+
+	m_oStream.skip(pCur - m_oStream.getCurrent());
 }
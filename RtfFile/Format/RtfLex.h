@@ -35,6 +35,7 @@
 #include "Utils.h"
 #include "Basic.h"
 
+//весь файл читается одним блоком, лексер работает прямо по буферу
 class StringStream
 {
 private: 
@@ -50,11 +51,35 @@ public:
 	void Clear();
 
 	bool SetSource( std::wstring sPath  );
-	void getBytes( int nCount, BYTE** pbData );
-	int getc();
-	void ungetc();
+	const BYTE* getSpan( int nCount );
 	void putString( std::string sText );
 
+	inline int getc()
+	{
+		if( m_nPosAbs + 1 < m_nSizeAbs )
+			return m_aBuffer[ ++m_nPosAbs ];
+		return EOF;
+	}
+	inline void ungetc()
+	{
+		//в проекте используется ungetc только после getc
+		//поэтому проблем с выходом в 0 нет
+		m_nPosAbs--;	//взять любой txt переименовать в rtf - зацикливание
+	}
+	//непрочитанный остаток буфера - начинается со следующего символа
+	inline const unsigned char* getCurrent()
+	{
+		return m_aBuffer + m_nPosAbs + 1;
+	}
+	inline LONG64 getAvailable()
+	{
+		return m_nSizeAbs - m_nPosAbs - 1;
+	}
+	inline void skip( LONG64 nCount )
+	{
+		m_nPosAbs += nCount;
+	}
+
 	LONG64 getCurPosition();
 	LONG64 getSize();
 };
@@ -66,9 +91,8 @@ private:
 	RtfToken		m_oCurToken;
 
 public: 
-	NFileWriter::CBufferedFileWriter* m_oFileWriter;
-	char* m_caReadBuffer;
-	int m_nReadBufSize;
+	std::vector<BYTE>* m_pHexData;	//если задан - текст декодируется из hex сразу сюда (картинки, данные объектов)
+	int m_nHexHalf;					//незаконченный полубайт между кусками hex
 
 	RtfLex();
 	~RtfLex();
@@ -77,7 +101,7 @@ public:
 	bool SetSource( std::wstring sPath );
 	void CloseSource();
 	RtfToken NextCurToken();
-	void ReadBytes( int nCount, BYTE** pbData );
+	const BYTE* ReadBytes( int nCount );
 	RtfToken NextToken();
 	void putString( std::string sText );
 
@@ -85,6 +109,5 @@ private:
 	void parseKeyword(RtfToken& token);
 	void parseText(int car, RtfToken& token);
 
-	bool GetNextChar( int& nChar );
-	void parseTextFile(int car, RtfToken& token);
+	void parseHexText(int car, RtfToken& token);
 };
@@ -62,6 +62,7 @@ RtfReader::RtfReader(RtfDocument& oDocument, std::wstring sFilename ) : m_oDocum
 	m_nDefFont = PROP_DEF;
 	m_nDefLang = PROP_DEF;
 	m_nDefLangAsian = PROP_DEF;
+	m_eKeyword = RtfKeyword::kw_unknown;
 	m_convertationManager = NULL;
 }
 bool RtfReader::Load()
@@ -108,7 +109,7 @@ RtfAbstractReader::RtfAbstractReader()
 	m_bSkip = false;
 	m_nSkipChars = 0;
 	m_nCurGroups = 1;
-	m_oFileWriter = NULL;
+	m_pHexData = NULL;
 	m_bStopReader = false;
 
 	m_bUseGlobalCodepage = false;
@@ -148,6 +149,10 @@ bool RtfAbstractReader::StartSubReader( RtfAbstractReader& poNewReader, RtfDocum
 }
 void RtfAbstractReader::Skip( RtfDocument& oDocument, RtfReader& oReader )
 {
+	//пропускаемый текст не должен попасть в hex данные
+	std::vector<BYTE>* poOldHexData = oReader.m_oLex.m_pHexData;
+	oReader.m_oLex.m_pHexData = NULL;
+
 	int cGroup = 1;
 	while( cGroup >= 1 )
 	{
@@ -159,6 +164,8 @@ void RtfAbstractReader::Skip( RtfDocument& oDocument, RtfReader& oReader )
 		else if(m_oTok.Type == RtfToken::Eof)
 			break;
 	}
+	oReader.m_oLex.m_pHexData = poOldHexData;
+
 	PopState( oDocument, oReader );
 }
 bool RtfAbstractReader::ExecuteCommand( RtfDocument& oDocument, RtfReader& oReader, std::string sKey, bool bHasPar, int nPar )
@@ -176,8 +183,9 @@ void RtfAbstractReader::ExitReader2( RtfDocument& oDocument, RtfReader& oReader
 }
 bool RtfAbstractReader::RtfAbstractReader::Parse(RtfDocument& oDocument, RtfReader& oReader)
 {
-	NFileWriter::CBufferedFileWriter* poOldWriter = oReader.m_oLex.m_oFileWriter;
-	oReader.m_oLex.m_oFileWriter = m_oFileWriter;
+	std::vector<BYTE>* poOldHexData = oReader.m_oLex.m_pHexData;
+	oReader.m_oLex.m_pHexData = m_pHexData;
+	oReader.m_oLex.m_nHexHalf = -1;
 
 	int res = 0;
 	m_oTok = oReader.m_oLex.NextCurToken();
@@ -203,13 +211,14 @@ bool RtfAbstractReader::RtfAbstractReader::Parse(RtfDocument& oDocument, RtfRead
 		case RtfToken::Keyword:
 		{
 			ExecuteTextInternal2(oDocument, oReader, m_oTok.Key, m_nSkipChars);
-			if (m_oTok.Key == "u")
+			if (RtfKeyword::kw_u == m_oTok.KeywordId)
 			{
 				ExecuteText(oDocument, oReader, ExecuteTextInternal(oDocument, oReader, m_oTok.Key, m_oTok.HasParameter, m_oTok.Parameter, m_nSkipChars));
 				break;
 			}
 			else
 			{
+				oReader.m_eKeyword = m_oTok.KeywordId;
 				if (true == m_bSkip)
 				{
 					if (false == ExecuteCommand(oDocument, oReader, m_oTok.Key, m_oTok.HasParameter, m_oTok.Parameter))
@@ -252,7 +261,8 @@ bool RtfAbstractReader::RtfAbstractReader::Parse(RtfDocument& oDocument, RtfRead
 			m_oTok = oReader.m_oLex.NextToken();
 	}
 
-	oReader.m_oLex.m_oFileWriter = poOldWriter;
+	oReader.m_oLex.m_pHexData = poOldHexData;
+	oReader.m_oLex.m_nHexHalf = -1;
 
 	return true;
 }
@@ -63,6 +63,7 @@ public:
     ReaderStatePtr      m_oState;
     RtfSectionProperty  m_oCurSectionProp;
     RtfLex              m_oLex;
+    RtfKeyword::_Keyword m_eKeyword; //номер исполняемого keyword (RtfToken::KeywordId) для ExecuteCommand
     int                 m_nFootnote; //толко для симовола chftn. основано на том что вложенных footnote быть не может
     int                 m_nDefFont;
 	int					m_nDefLang;
@@ -86,7 +87,7 @@ private:
 class RtfAbstractReader
 {
 public:
-	NFileWriter::CBufferedFileWriter* m_oFileWriter;
+	std::vector<BYTE>* m_pHexData;	//куда лексеру сразу декодировать hex текст (NULL - обычный текст)
 
 	RtfAbstractReader();
 
@@ -36,6 +36,7 @@ RtfToken::RtfToken()
 {
 	Type = None;
 	Key = "";
+	KeywordId = RtfKeyword::kw_unknown;
 	HasParameter = false;
 	Parameter = 0;
 }
@@ -33,6 +33,8 @@
 
 #include <string>
 
+#include "RtfKeyword.h"
+
 class RtfToken
 {
 public:
@@ -40,6 +42,7 @@ public:
 	
 	RtfTokenType Type;
     std::string Key;
+	RtfKeyword::_Keyword KeywordId;	// номер Key для Keyword, kw_unknown для прочих
 	bool HasParameter;
 	int Parameter;
 
@@ -32,6 +32,12 @@
 
 #include "Utils.h"
 
+#if (defined(__GNUC__) && defined(__SSE2__)) || \
+	(defined(_WIN32) && (_M_IX86_FP == 2 || defined(_M_X64)))
+	#include <emmintrin.h>
+	#define RTF_HEX_SSE2
+#endif
+
 //------------------------------------------------------------------------------------------------------
 
 std::wstring Convert::ToString(_INT32 i)
@@ -315,42 +321,71 @@ void RtfUtility::WriteDataToFileBinary(std::wstring& sFilename, BYTE* pbData, si
 	file.WriteFile(pbData, (DWORD)nLength);
 	file.CloseFile();
 }
-void RtfUtility::WriteDataToFile(std::wstring& sFilename, std::wstring& sData)
-{
-	NSFile::CFileBinary file;
-
-	if (false == file.CreateFileW(sFilename)) return;
-
-	wchar_t * buf  = (wchar_t *)sData.c_str();
-	size_t nLengthText	= sData.length();
-	size_t nLengthData	= nLengthText/2;
-
-	BYTE * buf2 = new BYTE[ nLengthData];
-	BYTE nByte=0;
-
-	for (size_t i = 0; i < nLengthData ; i++ )
+static const signed char g_arHexDigits[256] =
+{
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1, -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,  0, 1, 2, 3, 4, 5, 6, 7, 8, 9,-1,-1,-1,-1,-1,-1,
+	-1,10,11,12,13,14,15,-1,-1,-1,-1,-1,-1,-1,-1,-1, -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,10,11,12,13,14,15,-1,-1,-1,-1,-1,-1,-1,-1,-1, -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1, -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1, -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1, -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1, -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1
+};
+//pData - не меньше (nLength + 1) / 2 байт; символы не из 0-9a-fA-F пропускаются
+//nHalf - старший полубайт, оставшийся от предыдущего куска (-1 - нет)
+size_t RtfUtility::DecodeHex( const BYTE* pHex, size_t nLength, BYTE* pData, int& nHalf )
+{
+	BYTE* pOut = pData;
+	size_t i = 0;
+
+	while (i < nLength)
 	{
-		nByte = ToByte( buf[2 * i] ) << 4;
-		nByte |= ToByte( buf[2 * i + 1] );
-		buf2[i] = nByte;
-	}
-	file.WriteFile(buf2 ,(DWORD)nLengthData);
-	delete[] buf2;
-	file.CloseFile();
+#ifdef RTF_HEX_SSE2
+		//по 16 символов -> 8 байт, если в блоке только hex цифры
+		if (nHalf < 0 && i + 16 <= nLength)
+		{
+			__m128i vHex	= _mm_loadu_si128((const __m128i*)(pHex + i));
+			__m128i vLower	= _mm_or_si128(vHex, _mm_set1_epi8(0x20));
+
+			__m128i vDigit	= _mm_and_si128(_mm_cmpgt_epi8(vHex, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(vHex, _mm_set1_epi8('9' + 1)));
+			__m128i vAlpha	= _mm_and_si128(_mm_cmpgt_epi8(vLower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(vLower, _mm_set1_epi8('f' + 1)));
+
+			if (0xFFFF == _mm_movemask_epi8(_mm_or_si128(vDigit, vAlpha)))
+			{
+				__m128i vNibble = _mm_or_si128(_mm_and_si128(vDigit, _mm_sub_epi8(vHex, _mm_set1_epi8('0'))),
+											   _mm_andnot_si128(vDigit, _mm_sub_epi8(vLower, _mm_set1_epi8('a' - 10))));
+				//в каждом 16-битном слове: младший байт - старший полубайт, старший байт - младший
+				__m128i vByte = _mm_or_si128(_mm_and_si128(_mm_slli_epi16(vNibble, 4), _mm_set1_epi16(0x00F0)), _mm_srli_epi16(vNibble, 8));
+
+				_mm_storel_epi64((__m128i*)pOut, _mm_packus_epi16(vByte, vByte));
+				pOut += 8;
+				i += 16;
+				continue;
+			}
+		}
+#endif
+		int nDigit = g_arHexDigits[pHex[i++]];
+		if (nDigit < 0)
+			continue;
 
+		if (nHalf < 0)
+			nHalf = nDigit;
+		else
+		{
+			*pOut++ = (BYTE)((nHalf << 4) | nDigit);
+			nHalf = -1;
+		}
+	}
+	return pOut - pData;
 }
-void RtfUtility::DecodeHexString( std::string sHexText, BYTE *&pData )
+void RtfUtility::DecodeHex( const BYTE* pHex, size_t nLength, std::vector<BYTE>& arData, int& nHalf )
 {
-	if (sHexText.empty()) return;
-	if (!pData) return;
+	size_t nOldSize = arData.size();
+	arData.resize(nOldSize + nLength / 2 + 1);
 
-	for( size_t i = 0; i < sHexText.length() -1 ; i+=2 )
-	{
-		int byte1 = ToByte( sHexText[i] );
-		int byte2 = ToByte(sHexText[i + 1] );
-		int cChar = (byte1 << 4) + byte2;
-		pData[i/2] = (BYTE)cChar;
-	}
+	size_t nDecoded = DecodeHex(pHex, nLength, arData.data() + nOldSize, nHalf);
+	arData.resize(nOldSize + nDecoded);
 }
 BYTE RtfUtility::ToByte( wchar_t cChar )
 {
@@ -209,8 +209,8 @@ public:
 	static float Emu2Pt(int emu);
 	static int Pt2Emu(int emu);
 	static void WriteDataToFileBinary(std::wstring& sFilename, BYTE* pbData, size_t nLength);
-	static void WriteDataToFile(std::wstring& sFilename, std::wstring& sData);
-	static void DecodeHexString( std::string sHexText, BYTE *&pData );
+	static size_t DecodeHex( const BYTE* pHex, size_t nLength, BYTE* pData, int& nHalf );
+	static void DecodeHex( const BYTE* pHex, size_t nLength, std::vector<BYTE>& arData, int& nHalf );
 	static BYTE ToByte( wchar_t cChar );
 	static bool IsAlpha( int nChar );
 	static bool IsDigit( int nChar );
@@ -53,6 +53,7 @@ SOURCES += \
 	../../Format/RtfTable.cpp \
 	../../Format/IdGenerator.cpp \
 	../../Format/Ole1FormatReader.cpp \
+	../../Format/RtfKeyword.cpp \
 	../../Format/RtfLex.cpp \
 	../../Format/RtfTableCell.cpp \
 	../../Format/RtfTableRow.cpp \
@@ -127,6 +128,7 @@ HEADERS += \
 	../../Format/RtfErrors.h \
 	../../Format/RtfField.h \
 	../../Format/RtfGlobalTables.h \
+	../../Format/RtfKeyword.h \
 	../../Format/RtfLex.h \
 	../../Format/RtfMath.h \
 	../../Format/RtfOle.h \
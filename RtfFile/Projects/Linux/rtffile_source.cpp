@@ -48,6 +48,7 @@
 #include "../../Format/RtfTable.cpp"
 #include "../../Format/IdGenerator.cpp"
 #include "../../Format/Ole1FormatReader.cpp"
+#include "../../Format/RtfKeyword.cpp"
 #include "../../Format/RtfLex.cpp"
 #include "../../Format/RtfTableCell.cpp"
 #include "../../Format/RtfTableRow.cpp"
@@ -0,0 +1,149 @@
+/*
+ * (c) Copyright UNIVAULT TECHNOLOGIES 2026-2026
+ *
+ * This program is a free software product. You can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License (AGPL)
+ * version 3 as published by the Free Software Foundation. In accordance with
+ * Section 7(a) of the GNU AGPL its Section 15 shall be amended to the effect
+ * that UNIVAULT TECHNOLOGIES expressly excludes the warranty of non-infringement
+ * of any third-party rights.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR  PURPOSE. For
+ * details, see the GNU AGPL at: http://www.gnu.org/licenses/agpl-3.0.html
+ *
+ * You can contact UNIVAULT TECHNOLOGIES at 20A-6 Ernesta Birznieka-Upish
+ * street, Moscow (TEST), Russia (TEST), EU, 000000 (TEST).
+ *
+ * The  interactive user interfaces in modified source and object code versions
+ * of the Program must display Appropriate Legal Notices, as required under
+ * Section 5 of the GNU AGPL version 3.
+ *
+ * Pursuant to Section 7(b) of the License you must retain the original Product
+ * logo when distributing the program. Pursuant to Section 7(e) we decline to
+ * grant you any rights under trademark law for use of our trademarks.
+ *
+ * All the Product's GUI elements, including illustrations and icon sets, as
+ * well as technical writing content are licensed under the terms of the
+ * Creative Commons Attribution-ShareAlike 4.0 International. See the License
+ * terms at http://creativecommons.org/licenses/by-sa/4.0/legalcode
+ *
+ */
+
+#include "../Format/ConvertationManager.h"
+#include "../Format/RtfKeyword.h"
+
+#include "../../DesktopEditor/common/File.h"
+#include "../../DesktopEditor/common/Directory.h"
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+// rtf, плотный по управляющим словам - как выгрузки из старых систем
+static std::string GenerateKeywordDenseRtf(size_t nSize)
+{
+	std::string sRtf = "{\\rtf1\\ansi\\ansicpg1252\\deff0\\deflang1033"
+		"{\\fonttbl{\\f0\\froman\\fcharset0 Times New Roman;}{\\f1\\fswiss\\fcharset0 Arial;}}"
+		"{\\colortbl;\\red0\\green0\\blue0;\\red255\\green0\\blue0;}"
+		"\\paperw11906\\paperh16838\\margl1440\\margr1440\\margt1440\\margb1440\n";
+
+	const std::string sRow =
+		"\\pard\\plain\\ltrpar\\ql\\li0\\ri0\\sb0\\sa200\\sl276\\slmult1\\widctlpar\\wrapdefault\\aspalpha\\faauto"
+		"\\rin0\\lin0\\itap0\\rtlch\\fcs1\\af0\\afs24\\alang1025\\ltrch\\fcs0\\f0\\fs24\\lang1033\\langfe1033"
+		"{\\rtlch\\fcs1\\af1\\ltrch\\fcs0\\b\\i\\ul\\cf2\\insrsid1 Lorem}\\b0\\i0\\ulnone\\cf1 ipsum "
+		"{\\f1\\fs20\\charscalex90\\expndtw-2\\strike dolor}\\strike0 sit amet\\tab\\par\n";
+
+	sRtf.reserve(nSize + sRow.length() + 1);
+	while (sRtf.length() < nSize)
+		sRtf += sRow;
+	sRtf += "}";
+
+	return sRtf;
+}
+
+static void BenchmarkKeywordLookup()
+{
+	const int nRounds = 2000;
+	size_t nFound = 0;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < nRounds; ++i)
+	{
+		for (int k = RtfKeyword::kw_unknown + 1; k < RtfKeyword::kw_count; ++k)
+		{
+			if (k == RtfKeyword::Find(RtfKeyword::Name((RtfKeyword::_Keyword)k)))
+				++nFound;
+		}
+	}
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::cout << "keyword lookup: " << nFound << " of " << (size_t)nRounds * (RtfKeyword::kw_count - 1) << " found in "
+			  << std::fixed << std::setprecision(1) << elapsed.count() << " ms" << std::endl;
+}
+
+static bool BenchmarkConvert(const std::wstring& sSrcFile, size_t nFileSize)
+{
+	std::wstring sTempDir = NSDirectory::CreateDirectoryWithUniqueName(NSDirectory::GetTempPath());
+	std::wstring sDstDir = sTempDir + L"/docx";
+	NSDirectory::CreateDirectory(sDstDir);
+
+	RtfConvertationManager oConverter;
+	oConverter.m_sTempFolder = sTempDir;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	_UINT32 nResult = oConverter.ConvertRtfToOOX(sSrcFile, sDstDir);
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+	NSDirectory::DeleteDirectory(sTempDir);
+
+	std::cout << "rtf -> docx: " << nFileSize << " bytes in " << std::fixed << std::setprecision(1) << elapsed.count() << " ms ("
+			  << std::setprecision(2) << (nFileSize / 1048576.) / (elapsed.count() / 1000.) << " MB/s)" << std::endl;
+
+	return 0 == nResult;
+}
+
+// test [file.rtf | size_in_MB]
+int main(int argc, char** argv)
+{
+	BenchmarkKeywordLookup();
+
+	std::wstring sSrcFile;
+	bool bGenerated = false;
+
+	std::string sArg = argc > 1 ? argv[1] : "";
+	if (!sArg.empty() && NSFile::CFileBinary::Exists(NSFile::CUtf8Converter::GetUnicodeStringFromUTF8((BYTE*)sArg.c_str(), (LONG)sArg.length())))
+	{
+		sSrcFile = NSFile::CUtf8Converter::GetUnicodeStringFromUTF8((BYTE*)sArg.c_str(), (LONG)sArg.length());
+	}
+	else
+	{
+		size_t nSizeMB = sArg.empty() ? 32 : (size_t)std::stoul(sArg);
+		std::string sRtf = GenerateKeywordDenseRtf(nSizeMB * 1024 * 1024);
+
+		sSrcFile = NSFile::CFileBinary::CreateTempFileWithUniqueName(NSDirectory::GetTempPath(), L"rtf");
+		NSFile::CFileBinary oFile;
+		if (!oFile.CreateFileW(sSrcFile))
+			return 1;
+		oFile.WriteFile((BYTE*)sRtf.c_str(), (DWORD)sRtf.length());
+		oFile.CloseFile();
+
+		bGenerated = true;
+	}
+
+	NSFile::CFileBinary oFile;
+	long nFileSize = 0;
+	if (oFile.OpenFile(sSrcFile))
+	{
+		nFileSize = oFile.GetFileSize();
+		oFile.CloseFile();
+	}
+
+	bool bResult = BenchmarkConvert(sSrcFile, (size_t)nFileSize);
+
+	if (bGenerated)
+		NSFile::CFileBinary::Remove(sSrcFile);
+
+	return bResult ? 0 : 2;
+}
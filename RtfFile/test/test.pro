@@ -0,0 +1,28 @@
+QT -= core
+QT -= gui
+
+TARGET = test
+CONFIG += console
+CONFIG -= app_bundle
+TEMPLATE = app
+
+CORE_ROOT_DIR = $$PWD/../..
+PWD_ROOT_DIR = $$PWD
+include($$CORE_ROOT_DIR/Common/base.pri)
+include($$CORE_ROOT_DIR/Common/3dParty/boost/boost.pri)
+include($$CORE_ROOT_DIR/Common/3dParty/icu/icu.pri)
+
+DEFINES += UNICODE _UNICODE DONT_WRITE_EMBEDDED_FONTS
+
+LIBS += -L$$CORE_BUILDS_LIBRARIES_PATH -lCryptoPPLib
+LIBS += -L$$CORE_BOOST_LIBS
+
+ADD_DEPENDENCY(RtfFormatLib, PPTXFormatLib, DocxFormatLib, BinDocument, XlsbFormatLib, CompoundFileLib)
+ADD_DEPENDENCY(kernel, graphics, UnicodeConverter)
+
+core_windows:LIBS += -lgdi32 -ladvapi32 -luser32 -lshell32
+core_linux:LIBS += -ldl
+
+SOURCES += main.cpp
+
+DESTDIR = $$PWD/build/$$CORE_BUILDS_PLATFORM_PREFIX
@@ -19,4 +19,6 @@ include($$CORE_ROOT_DIR/Common/3dParty/icu/icu.pri)
 
 ADD_DEPENDENCY(kernel, graphics, UnicodeConverter)
 
+core_windows:LIBS += -lPsapi
+
 DESTDIR = $$CORE_BUILDS_BINARY_PATH
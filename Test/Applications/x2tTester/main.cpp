@@ -39,5 +39,6 @@ int main(int argc, char** argv)
 	SetConsoleOutputCP(currConsoleCP);
 #endif
 
-	return 0;
+	// benchmark regressions fail the run
+	return tester.GetRegressionsCount() > 0 ? 1 : 0;
 }
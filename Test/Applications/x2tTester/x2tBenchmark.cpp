@@ -0,0 +1,394 @@
+#include "x2tBenchmark.h"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include "../../../DesktopEditor/common/File.h"
+#include "../../../DesktopEditor/common/Directory.h"
+
+namespace
+{
+	bool ReadJson(const std::string& data, boost::property_tree::ptree& root)
+	{
+		try
+		{
+			std::istringstream stream(data);
+			boost::property_tree::read_json(stream, root);
+		}
+		catch (const boost::property_tree::json_parser_error&)
+		{
+			return false;
+		}
+		return true;
+	}
+
+	void WriteJsonString(std::string& out, const std::string& str)
+	{
+		static const char hex[] = "0123456789abcdef";
+
+		out += '"';
+		for (unsigned char c : str)
+		{
+			if (c == '"' || c == '\\')
+			{
+				out += '\\';
+				out += (char)c;
+			}
+			else if (c < 0x20)
+			{
+				out += "\\u00";
+				out += hex[c >> 4];
+				out += hex[c & 0x0F];
+			}
+			else
+				out += (char)c;
+		}
+		out += '"';
+	}
+	void WriteJsonString(std::string& out, const std::wstring& str)
+	{
+		WriteJsonString(out, U_TO_UTF8(str));
+	}
+	void WriteJsonNumber(std::string& out, const char* name, unsigned long long value, bool bIsLast = false)
+	{
+		out += '"';
+		out += name;
+		out += "\": ";
+		out += std::to_string(value);
+		if (!bIsLast)
+			out += ", ";
+	}
+
+	std::wstring GetPercentDiff(unsigned long long base, unsigned long long curr)
+	{
+		if (base == 0)
+			return L"new";
+
+		long long diff = ((long long)curr - (long long)base) * 100 / (long long)base;
+		return (diff >= 0 ? L"+" : L"") + std::to_wstring(diff) + L"%";
+	}
+}
+
+CBenchmark::Result::Result() : runs(0), wallTime(0), cpuTime(0), peakMemory(0), leftoverTempSize(0), inputSize(0), outputSize(0)
+{
+}
+
+CBenchmark::CBenchmark()
+{
+	m_resultsCS.InitializeCriticalSection();
+	m_bIsBaselineLoaded = false;
+
+	m_timeThreshold = 10;
+	m_memoryThreshold = 10;
+	m_sizeThreshold = 5;
+	m_minTime = 100;
+}
+CBenchmark::~CBenchmark()
+{
+	m_resultsCS.DeleteCriticalSection();
+}
+
+void CBenchmark::SetTimeThreshold(double percent)
+{
+	m_timeThreshold = percent;
+}
+void CBenchmark::SetMemoryThreshold(double percent)
+{
+	m_memoryThreshold = percent;
+}
+void CBenchmark::SetSizeThreshold(double percent)
+{
+	m_sizeThreshold = percent;
+}
+void CBenchmark::SetMinTime(unsigned long long minTime)
+{
+	m_minTime = minTime;
+}
+
+void CBenchmark::AddResult(const Result& result)
+{
+	CTemporaryCS CS(&m_resultsCS);
+	m_results.push_back(result);
+}
+
+bool CBenchmark::LoadBaseline(const std::wstring& path)
+{
+	m_baseline.clear();
+	m_bIsBaselineLoaded = false;
+
+	std::string data;
+	if (!NSFile::CFileBinary::ReadAllTextUtf8A(path, data))
+		return false;
+
+	boost::property_tree::ptree root;
+	if (!ReadJson(data, root))
+		return false;
+
+	boost::optional<boost::property_tree::ptree&> files = root.get_child_optional("files");
+	if (!files)
+		return false;
+
+	for (auto& item : *files)
+	{
+		const boost::property_tree::ptree& file = item.second;
+
+		Result result;
+		result.inputFile = UTF8_TO_U(file.get<std::string>("input", ""));
+		result.direction = UTF8_TO_U(file.get<std::string>("direction", ""));
+		result.exitCode = UTF8_TO_U(file.get<std::string>("exitCode", ""));
+		result.runs = file.get<int>("runs", 0);
+		result.wallTime = file.get<unsigned long long>("wallTime", 0);
+		result.cpuTime = file.get<unsigned long long>("cpuTime", 0);
+		result.peakMemory = file.get<unsigned long long>("peakMemory", 0);
+		result.leftoverTempSize = file.get<unsigned long long>("leftoverTempSize", 0);
+		result.inputSize = file.get<unsigned long long>("inputSize", 0);
+		result.outputSize = file.get<unsigned long long>("outputSize", 0);
+		m_baseline.push_back(result);
+	}
+
+	m_bIsBaselineLoaded = true;
+	return true;
+}
+bool CBenchmark::IsBaselineLoaded() const
+{
+	return m_bIsBaselineLoaded;
+}
+
+bool CBenchmark::IsTimeRegression(unsigned long long base, unsigned long long curr) const
+{
+	return curr > base + m_minTime && IsRegression(base, curr, m_timeThreshold);
+}
+bool CBenchmark::IsRegression(unsigned long long base, unsigned long long curr, double threshold) const
+{
+	return (double)curr > (double)base * (1.0 + threshold / 100.0);
+}
+
+std::vector<std::wstring> CBenchmark::Compare() const
+{
+	CTemporaryCS CS(&m_resultsCS);
+	std::vector<std::wstring> regressions;
+
+	std::map<std::wstring, const Result*> baseline;
+	for (auto& result : m_baseline)
+		baseline[result.inputFile + L" " + result.direction] = &result;
+
+	// memory differences less than 1mb are noise
+	const unsigned long long min_memory = 1024 * 1024;
+
+	for (auto& result : m_results)
+	{
+		auto it = baseline.find(result.inputFile + L" " + result.direction);
+		if (it == baseline.end())
+			continue;
+
+		const Result& base = *it->second;
+		std::wstring name = result.inputFile + L" (" + result.direction + L"): ";
+
+		if (result.exitCode != L"0")
+		{
+			if (base.exitCode == L"0")
+				regressions.push_back(name + L"failed with " + result.exitCode);
+			continue;
+		}
+
+		if (base.exitCode != L"0")
+			continue;
+
+		if (IsTimeRegression(base.wallTime, result.wallTime))
+			regressions.push_back(name + L"wall time " + std::to_wstring(base.wallTime) + L" -> " +
+								  std::to_wstring(result.wallTime) + L" ms (" + GetPercentDiff(base.wallTime, result.wallTime) + L")");
+
+		if (IsTimeRegression(base.cpuTime, result.cpuTime))
+			regressions.push_back(name + L"cpu time " + std::to_wstring(base.cpuTime) + L" -> " +
+								  std::to_wstring(result.cpuTime) + L" ms (" + GetPercentDiff(base.cpuTime, result.cpuTime) + L")");
+
+		if (result.peakMemory > base.peakMemory + min_memory && IsRegression(base.peakMemory, result.peakMemory, m_memoryThreshold))
+			regressions.push_back(name + L"peak memory " + std::to_wstring(base.peakMemory) + L" -> " +
+								  std::to_wstring(result.peakMemory) + L" bytes (" + GetPercentDiff(base.peakMemory, result.peakMemory) + L")");
+
+		if (result.leftoverTempSize > base.leftoverTempSize + min_memory && IsRegression(base.leftoverTempSize, result.leftoverTempSize, m_memoryThreshold))
+			regressions.push_back(name + L"leftover temp size " + std::to_wstring(base.leftoverTempSize) + L" -> " +
+								  std::to_wstring(result.leftoverTempSize) + L" bytes (" + GetPercentDiff(base.leftoverTempSize, result.leftoverTempSize) + L")");
+
+		if (IsRegression(base.outputSize, result.outputSize, m_sizeThreshold))
+			regressions.push_back(name + L"output size " + std::to_wstring(base.outputSize) + L" -> " +
+								  std::to_wstring(result.outputSize) + L" bytes (" + GetPercentDiff(base.outputSize, result.outputSize) + L")");
+	}
+
+	// tail latency of the whole direction
+	std::vector<DirectionSummary> base_summaries = GetSummaries(m_baseline);
+	for (auto& summary : GetSummaries(m_results))
+	{
+		for (auto& base : base_summaries)
+		{
+			if (base.direction != summary.direction)
+				continue;
+
+			if (IsTimeRegression(base.wallTimeP95, summary.wallTimeP95))
+				regressions.push_back(summary.direction + L": wall time p95 " + std::to_wstring(base.wallTimeP95) + L" -> " +
+									  std::to_wstring(summary.wallTimeP95) + L" ms (" + GetPercentDiff(base.wallTimeP95, summary.wallTimeP95) + L")");
+
+			if (IsTimeRegression(base.cpuTimeP95, summary.cpuTimeP95))
+				regressions.push_back(summary.direction + L": cpu time p95 " + std::to_wstring(base.cpuTimeP95) + L" -> " +
+									  std::to_wstring(summary.cpuTimeP95) + L" ms (" + GetPercentDiff(base.cpuTimeP95, summary.cpuTimeP95) + L")");
+			break;
+		}
+	}
+
+	return regressions;
+}
+
+bool CBenchmark::WriteResults(const std::wstring& path, const std::vector<std::wstring>& regressions) const
+{
+	CTemporaryCS CS(&m_resultsCS);
+
+	std::vector<Result> results = m_results;
+	std::sort(results.begin(), results.end(), [](const Result& r1, const Result& r2) {
+		return r1.inputFile == r2.inputFile ? r1.direction < r2.direction : r1.inputFile < r2.inputFile;
+	});
+
+	std::string out = "{\n\"files\": [";
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const Result& result = results[i];
+		out += (i == 0) ? "\n" : ",\n";
+
+		out += "\t{\"input\": ";
+		WriteJsonString(out, result.inputFile);
+		out += ", \"direction\": ";
+		WriteJsonString(out, result.direction);
+		out += ", \"exitCode\": ";
+		WriteJsonString(out, result.exitCode);
+		out += ", ";
+
+		WriteJsonNumber(out, "runs", result.runs);
+		WriteJsonNumber(out, "wallTime", result.wallTime);
+		WriteJsonNumber(out, "cpuTime", result.cpuTime);
+		WriteJsonNumber(out, "peakMemory", result.peakMemory);
+		WriteJsonNumber(out, "leftoverTempSize", result.leftoverTempSize);
+		WriteJsonNumber(out, "inputSize", result.inputSize);
+		WriteJsonNumber(out, "outputSize", result.outputSize);
+
+		// embed the x2t profile only if it is a valid json object
+		size_t phases_begin = result.phases.find_first_not_of(" \t\r\n");
+		boost::property_tree::ptree phases;
+		out += "\"phases\": ";
+		if (phases_begin != std::string::npos && result.phases[phases_begin] == '{' && ReadJson(result.phases, phases))
+			out += result.phases.substr(phases_begin, result.phases.rfind('}') - phases_begin + 1);
+		else
+			out += "null";
+		out += "}";
+	}
+	out += "\n],\n\"directions\": [";
+
+	std::vector<DirectionSummary> summaries = GetSummaries(results);
+	for (size_t i = 0; i < summaries.size(); ++i)
+	{
+		const DirectionSummary& summary = summaries[i];
+		out += (i == 0) ? "\n" : ",\n";
+
+		out += "\t{\"direction\": ";
+		WriteJsonString(out, summary.direction);
+		out += ", ";
+
+		WriteJsonNumber(out, "count", summary.count);
+		WriteJsonNumber(out, "failed", summary.failed);
+		WriteJsonNumber(out, "wallTimeP50", summary.wallTimeP50);
+		WriteJsonNumber(out, "wallTimeP95", summary.wallTimeP95);
+		WriteJsonNumber(out, "cpuTimeP95", summary.cpuTimeP95);
+		WriteJsonNumber(out, "peakMemoryMax", summary.peakMemoryMax, true);
+		out += "}";
+	}
+	out += "\n],\n\"regressions\": [";
+
+	for (size_t i = 0; i < regressions.size(); ++i)
+	{
+		out += (i == 0) ? "\n\t" : ",\n\t";
+		WriteJsonString(out, regressions[i]);
+	}
+	out += "\n]\n}\n";
+
+	NSFile::CFileBinary file;
+	if (!file.CreateFileW(path))
+		return false;
+
+	file.WriteFile((BYTE*)out.c_str(), (DWORD)out.size());
+	file.CloseFile();
+	return true;
+}
+
+std::vector<CBenchmark::DirectionSummary> CBenchmark::GetSummaries(const std::vector<Result>& results)
+{
+	std::map<std::wstring, std::vector<const Result*>> directions;
+	for (auto& result : results)
+		directions[result.direction].push_back(&result);
+
+	std::vector<DirectionSummary> summaries;
+	for (auto& direction : directions)
+	{
+		DirectionSummary summary;
+		summary.direction = direction.first;
+		summary.count = (int)direction.second.size();
+		summary.failed = 0;
+		summary.peakMemoryMax = 0;
+
+		// failed conversions are not timed
+		std::vector<unsigned long long> wall_times;
+		std::vector<unsigned long long> cpu_times;
+		for (auto& result : direction.second)
+		{
+			if (result->exitCode != L"0")
+			{
+				summary.failed++;
+				continue;
+			}
+			wall_times.push_back(result->wallTime);
+			cpu_times.push_back(result->cpuTime);
+			summary.peakMemoryMax = (std::max)(summary.peakMemoryMax, result->peakMemory);
+		}
+
+		summary.wallTimeP50 = GetPercentile(wall_times, 50);
+		summary.wallTimeP95 = GetPercentile(wall_times, 95);
+		summary.cpuTimeP95 = GetPercentile(cpu_times, 95);
+		summaries.push_back(summary);
+	}
+	return summaries;
+}
+
+unsigned long long CBenchmark::GetDirectorySize(const std::wstring& directory)
+{
+	unsigned long long size = 0;
+	if (!NSDirectory::Exists(directory))
+		return size;
+
+	std::vector<std::wstring> files = NSDirectory::GetFiles(directory, true);
+	for (auto& file : files)
+	{
+		NSFile::CFileBinary b_file;
+		if (b_file.OpenFile(file))
+		{
+			size += b_file.GetFileSize();
+			b_file.CloseFile();
+		}
+	}
+	return size;
+}
+unsigned long long CBenchmark::GetMedian(std::vector<unsigned long long> values)
+{
+	return GetPercentile(values, 50);
+}
+unsigned long long CBenchmark::GetPercentile(std::vector<unsigned long long> values, int percent)
+{
+	if (values.empty())
+		return 0;
+
+	std::sort(values.begin(), values.end());
+	size_t rank = (values.size() * percent + 99) / 100;
+	if (rank > 0)
+		--rank;
+	return values[(std::min)(rank, values.size() - 1)];
+}
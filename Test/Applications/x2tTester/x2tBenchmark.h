@@ -0,0 +1,93 @@
+#ifndef X2T_BENCHMARK_H
+#define X2T_BENCHMARK_H
+
+#include <string>
+#include <vector>
+
+#include "../../../DesktopEditor/graphics/TemporaryCS.h"
+
+// collects per-file measurements of x2t runs, writes them as json
+// and compares them with a stored baseline (json of a previous run)
+class CBenchmark
+{
+public:
+	struct Result
+	{
+		std::wstring inputFile;  // path relative to the input directory
+		std::wstring direction;  // e.g. "xlsx-pdf"
+		std::wstring exitCode;
+		int runs;
+
+		// medians of all runs
+		unsigned long long wallTime;   // ms
+		unsigned long long cpuTime;    // ms
+
+		// maximums of all runs
+		unsigned long long peakMemory; // bytes
+		unsigned long long leftoverTempSize; // bytes left in the temp directory after x2t exits
+
+		unsigned long long inputSize;
+		unsigned long long outputSize;
+
+		// x2t profile report (json object), empty if x2t did not write it
+		std::string phases;
+
+		Result();
+	};
+
+	CBenchmark();
+	~CBenchmark();
+
+	// thresholds in percent
+	void SetTimeThreshold(double percent);
+	void SetMemoryThreshold(double percent);
+	void SetSizeThreshold(double percent);
+
+	// time differences less than this are noise (ms)
+	void SetMinTime(unsigned long long minTime);
+
+	void AddResult(const Result& result);
+
+	bool LoadBaseline(const std::wstring& path);
+	bool IsBaselineLoaded() const;
+
+	// returns descriptions of all regressions against the baseline
+	std::vector<std::wstring> Compare() const;
+
+	bool WriteResults(const std::wstring& path, const std::vector<std::wstring>& regressions) const;
+
+	static unsigned long long GetDirectorySize(const std::wstring& directory);
+	static unsigned long long GetMedian(std::vector<unsigned long long> values);
+
+	// nearest-rank percentile
+	static unsigned long long GetPercentile(std::vector<unsigned long long> values, int percent);
+
+private:
+	struct DirectionSummary
+	{
+		std::wstring direction;
+		int count;
+		int failed;
+		unsigned long long wallTimeP50;
+		unsigned long long wallTimeP95;
+		unsigned long long cpuTimeP95;
+		unsigned long long peakMemoryMax;
+	};
+
+	static std::vector<DirectionSummary> GetSummaries(const std::vector<Result>& results);
+
+	bool IsTimeRegression(unsigned long long base, unsigned long long curr) const;
+	bool IsRegression(unsigned long long base, unsigned long long curr, double threshold) const;
+
+	mutable NSCriticalSection::CRITICAL_SECTION m_resultsCS;
+	std::vector<Result> m_results;
+	std::vector<Result> m_baseline;
+	bool m_bIsBaselineLoaded;
+
+	double m_timeThreshold;
+	double m_memoryThreshold;
+	double m_sizeThreshold;
+	unsigned long long m_minTime;
+};
+
+#endif // X2T_BENCHMARK_H
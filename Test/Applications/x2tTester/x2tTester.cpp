@@ -330,8 +330,17 @@ Cx2tTester::Cx2tTester(const std::wstring& configPath)
 	m_extractFormatsList = CFormatsList::GetExtractExts();
 	m_timeout = 5 * 60; // 5 min
 
+	m_bBenchmark = false;
+	m_benchmarkRuns = 1;
+	m_bIsBenchmarkIntermediateTempDir = false;
+	m_regressionsCount = 0;
+	m_pBenchmark = new CBenchmark();
+
 	SetConfig(configPath);
 
+	if (!m_bBenchmark)
+		RELEASEOBJECT(m_pBenchmark);
+
 	m_errorsXmlDirectory = m_outputDirectory + FILE_SEPARATOR_STR + L"_errors";
 	m_troughConversionDirectory = m_outputDirectory + FILE_SEPARATOR_STR + L"_t";
 	m_tempDirectory = m_outputDirectory + FILE_SEPARATOR_STR + L"_temp";
@@ -371,6 +380,13 @@ Cx2tTester::Cx2tTester(const std::wstring& configPath)
 		m_reportFile += L"_" + timestamp + L"." + report_ext;
 	}
 
+	// benchmark results near the report by default
+	if(m_bBenchmark && m_benchmarkResultFile.empty())
+	{
+		std::wstring report_ext = NSFile::GetFileExtention(m_reportFile);
+		m_benchmarkResultFile = m_reportFile.substr(0, m_reportFile.size() - report_ext.size()) + L"json";
+	}
+
 	if(NSFile::CFileBinary::Exists(m_reportFile))
 		NSFile::CFileBinary::Remove(m_reportFile);
 
@@ -394,6 +410,8 @@ Cx2tTester::~Cx2tTester()
 	m_outputCS.DeleteCriticalSection();
 	m_reportStream.CloseFile();
 
+	RELEASEOBJECT(m_pBenchmark);
+
 	for(auto&& val : m_deleteLaterFiles)
 		NSFile::CFileBinary::Remove(val);
 
@@ -432,6 +450,20 @@ void Cx2tTester::SetConfig(const std::wstring& configPath)
 			else if(name == L"defaultCsvTxtEncoding" && !node.GetText().empty()) m_defaultCsvTxtEndcoding = node.GetText();
 			else if(name == L"extract" && !node.GetText().empty()) m_bExtract = std::stoi(node.GetText());
 			else if(name == L"convertBeforeExtract" && !node.GetText().empty()) m_bConvertBeforeExtract = std::stoi(node.GetText());
+			else if(name == L"benchmark" && !node.GetText().empty()) m_bBenchmark = std::stoi(node.GetText());
+			else if(name == L"benchmarkRuns" && !node.GetText().empty()) m_benchmarkRuns = (std::max)(1, std::stoi(node.GetText()));
+			else if(name == L"benchmarkResult" && !node.GetText().empty()) m_benchmarkResultFile = node.GetText();
+			else if(name == L"benchmarkBaseline" && !node.GetText().empty()) m_benchmarkBaselineFile = node.GetText();
+			else if(name == L"benchmarkTimeThreshold" && !node.GetText().empty()) m_pBenchmark->SetTimeThreshold(std::stod(node.GetText()));
+			else if(name == L"benchmarkMemoryThreshold" && !node.GetText().empty()) m_pBenchmark->SetMemoryThreshold(std::stod(node.GetText()));
+			else if(name == L"benchmarkSizeThreshold" && !node.GetText().empty()) m_pBenchmark->SetSizeThreshold(std::stod(node.GetText()));
+			else if(name == L"benchmarkMinTime" && !node.GetText().empty()) m_pBenchmark->SetMinTime(std::stoul(node.GetText()));
+			else if(name == L"benchmarkIntermediateTempDir")
+			{
+				// empty value keeps intermediate packages in the temp dir of x2t
+				m_bIsBenchmarkIntermediateTempDir = true;
+				m_benchmarkIntermediateTempDir = node.GetText();
+			}
 			else if(name == L"defaultCsvDelimiter" && !node.GetText().empty()) m_defaultCsvDelimiter = (wchar_t)std::stoi(node.GetText(), nullptr, 16);
 			else if(name == L"inputFilesList" && !node.GetText().empty())
 			{
@@ -518,6 +550,13 @@ void Cx2tTester::Start()
 
 	NSDirectory::CreateDirectory(m_errorsXmlDirectory);
 
+	// load baseline before conversions to fail early
+	if(m_pBenchmark && !m_benchmarkBaselineFile.empty() && !m_pBenchmark->LoadBaseline(m_benchmarkBaselineFile))
+	{
+		std::cerr << "Benchmark baseline is not open!" << std::endl;
+		exit(-1);
+	}
+
 	// check fonts
 	CApplicationFontsWorker fonts_worker;
 	fonts_worker.m_sDirectory = m_fontsDirectory;
@@ -629,6 +668,32 @@ void Cx2tTester::Start()
 
 	Convert(files);
 	WriteTime();
+
+	if(m_pBenchmark)
+		WriteBenchmark();
+}
+
+int Cx2tTester::GetRegressionsCount() const
+{
+	return m_regressionsCount;
+}
+void Cx2tTester::WriteBenchmark()
+{
+	std::vector<std::wstring> regressions;
+	if(m_pBenchmark->IsBaselineLoaded())
+		regressions = m_pBenchmark->Compare();
+
+	m_regressionsCount = (int)regressions.size();
+
+	if(!m_pBenchmark->WriteResults(m_benchmarkResultFile, regressions))
+		std::cerr << "Benchmark result file is not open!" << std::endl;
+
+	if(!m_pBenchmark->IsBaselineLoaded())
+		return;
+
+	std::cout << "Regressions: " << regressions.size() << std::endl;
+	for(auto& regression : regressions)
+		std::cout << U_TO_UTF8(regression) << std::endl;
 }
 
 void Cx2tTester::Convert(const std::vector<std::wstring>& files, bool bNoDirectory, bool bTrough)
@@ -758,6 +823,22 @@ void Cx2tTester::Convert(const std::vector<std::wstring>& files, bool bNoDirecto
 		converter->SetTimeout(m_timeout);
 		converter->SetFilesCount(files.size(), i + 1);
 		converter->SetSaveEnvironment(m_bSaveEnvironment);
+
+		if(m_pBenchmark)
+		{
+			// files are compared with the baseline by path relative to input directory
+			std::wstring input_relative_file = input_subfolders + L"/" + input_filename;
+#ifdef WIN32
+			NSStringUtils::string_replace(input_relative_file, L"\\", L"/");
+#endif
+			if(input_relative_file.find(L"/") == 0)
+				input_relative_file.erase(0, 1);
+
+			converter->SetBenchmark(input_relative_file, m_benchmarkRuns);
+			if(m_bIsBenchmarkIntermediateTempDir)
+				converter->SetIntermediateTempDir(m_benchmarkIntermediateTempDir);
+		}
+
 		converter->DestroyOnFinish();
 		m_currentProc++;
 
@@ -908,7 +989,7 @@ std::vector<std::wstring> Cx2tTester::ParseExtensionsString(std::wstring extensi
 	return exts;
 }
 
-CConverter::CConverter(Cx2tTester* internal) : m_internal(internal)
+CConverter::CConverter(Cx2tTester* internal) : m_internal(internal), m_benchmarkRuns(1), m_bIsIntermediateTempDir(false)
 {
 }
 CConverter::~CConverter()
@@ -982,6 +1063,16 @@ void CConverter::SetSaveEnvironment(bool bSaveEnvironment)
 {
 	m_bSaveEnvironment = bSaveEnvironment;
 }
+void CConverter::SetBenchmark(const std::wstring& inputRelativeFile, int runs)
+{
+	m_inputRelativeFile = inputRelativeFile;
+	m_benchmarkRuns = runs;
+}
+void CConverter::SetIntermediateTempDir(const std::wstring& intermediateTempDir)
+{
+	m_bIsIntermediateTempDir = true;
+	m_intermediateTempDir = intermediateTempDir;
+}
 
 
 DWORD CConverter::ThreadProc()
@@ -1087,6 +1178,30 @@ DWORD CConverter::ThreadProc()
 			builder.WriteString(L"</m_sPassword>");
 		}
 
+		// separate temp directory (x2t does not delete an external one) and phase timings
+		std::wstring temp_directory;
+		std::wstring profile_file;
+		if(m_internal->m_pBenchmark)
+		{
+			temp_directory = m_outputFilesDirectory + FILE_SEPARATOR_STR + input_filename + L"_" + output_ext + L"_temp";
+			profile_file = m_outputFilesDirectory + FILE_SEPARATOR_STR + input_filename + L"_" + output_ext + L"_profile.json";
+
+			builder.WriteString(L"<m_sTempDir>");
+			builder.WriteEncodeXmlString(temp_directory);
+			builder.WriteString(L"</m_sTempDir>");
+
+			builder.WriteString(L"<m_sProfileFile>");
+			builder.WriteEncodeXmlString(profile_file);
+			builder.WriteString(L"</m_sProfileFile>");
+
+			if(m_bIsIntermediateTempDir)
+			{
+				builder.WriteString(L"<m_sIntermediateTempDir>");
+				builder.WriteEncodeXmlString(m_intermediateTempDir);
+				builder.WriteString(L"</m_sIntermediateTempDir>");
+			}
+		}
+
 		builder.WriteString(L"<m_sJsonParams>{&quot;spreadsheetLayout&quot;:{&quot;gridLines&quot;:true,&quot;headings&quot;:true,&quot;fitToHeight&quot;:1,&quot;fitToWidth&quot;:1,&quot;orientation&quot;:&quot;landscape&quot;}}</m_sJsonParams>");
 		builder.WriteString(L"</Root>");
 
@@ -1113,7 +1228,48 @@ DWORD CConverter::ThreadProc()
 #endif // WIN32
 
 		bool is_timeout = false;
-		int exit_code = NSX2T::Convert(NSFile::GetDirectoryName(m_x2tPath), xml_params_file, m_timeout, &is_timeout, m_bSaveEnvironment);
+		int exit_code = 0;
+
+		CBenchmark::Result benchmark_result;
+		if(m_internal->m_pBenchmark)
+		{
+			std::vector<unsigned long long> wall_times;
+			std::vector<unsigned long long> cpu_times;
+
+			for(int run = 0; run < m_benchmarkRuns; run++)
+			{
+				if(NSDirectory::Exists(temp_directory))
+					NSDirectory::DeleteDirectory(temp_directory);
+				NSDirectory::CreateDirectories(temp_directory);
+				NSFile::CFileBinary::Remove(profile_file);
+
+				NSX2T::CProcessStat stat;
+				unsigned long time_run_start = NSTimers::GetTickCount();
+				exit_code = NSX2T::Convert(NSFile::GetDirectoryName(m_x2tPath), xml_params_file, m_timeout, &is_timeout, m_bSaveEnvironment, &stat);
+
+				wall_times.push_back(NSTimers::GetTickCount() - time_run_start);
+				cpu_times.push_back(stat.nCpuTime);
+				benchmark_result.peakMemory = (std::max)(benchmark_result.peakMemory, stat.nPeakMemory);
+				benchmark_result.leftoverTempSize = (std::max)(benchmark_result.leftoverTempSize, CBenchmark::GetDirectorySize(temp_directory));
+				benchmark_result.runs++;
+
+				// no reason to repeat failed conversion
+				if(exit_code || is_timeout)
+					break;
+			}
+
+			benchmark_result.wallTime = CBenchmark::GetMedian(wall_times);
+			benchmark_result.cpuTime = CBenchmark::GetMedian(cpu_times);
+
+			// phases of the last run
+			NSFile::CFileBinary::ReadAllTextUtf8A(profile_file, benchmark_result.phases);
+			NSFile::CFileBinary::Remove(profile_file);
+			NSDirectory::DeleteDirectory(temp_directory);
+		}
+		else
+		{
+			exit_code = NSX2T::Convert(NSFile::GetDirectoryName(m_x2tPath), xml_params_file, m_timeout, &is_timeout, m_bSaveEnvironment);
+		}
 
 		bool exist;
 		if(output_format & AVS_OFFICESTUDIO_FILE_IMAGE)
@@ -1156,6 +1312,21 @@ DWORD CConverter::ThreadProc()
 			}
 		}
 
+		if(m_internal->m_pBenchmark)
+		{
+			benchmark_result.inputFile = m_inputRelativeFile;
+			benchmark_result.direction = m_inputExt + L"-" + output_ext.substr(1, output_ext.size() - 1);
+			if(is_timeout)
+				benchmark_result.exitCode = L"TIMEOUT";
+			else if(!exit_code && !exist)
+				benchmark_result.exitCode = L"NOT EXIST";
+			else
+				benchmark_result.exitCode = std::to_wstring(exit_code);
+			benchmark_result.inputSize = input_size;
+			benchmark_result.outputSize = output_size;
+			m_internal->m_pBenchmark->AddResult(benchmark_result);
+		}
+
 		// save param xml of error conversion
 		if(!ok)
 		{
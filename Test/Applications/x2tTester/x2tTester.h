@@ -21,6 +21,8 @@
 #include "../../../OfficeUtils/src/OfficeUtils.h"
 #include "../../../UnicodeConverter/UnicodeConverter_Encodings.h"
 
+#include "x2tBenchmark.h"
+
 class CFormatsList
 {
 public:
@@ -96,6 +98,9 @@ public:
 	void SetConfig(const std::wstring& configPath);
 	void Start();
 
+	// benchmark mode: number of regressions against the baseline
+	int GetRegressionsCount() const;
+
 	void WriteReportHeader();
 	void WriteReport(const Report& report);
 	void WriteReports(const std::vector<Report>& reports);
@@ -114,11 +119,15 @@ public:
 	int m_currentProc;
 	int m_maxProc;
 
+	// not null in benchmark mode
+	CBenchmark* m_pBenchmark;
+
 private:
 	// parse string like "docx txt" into vector
 	std::vector<std::wstring> ParseExtensionsString(std::wstring extensions, const CFormatsList& fl);
 	void Convert(const std::vector<std::wstring>& files, bool bNoDirectory = false, bool bTrough = false);
 	void Extract(const std::vector<std::wstring>& files);
+	void WriteBenchmark();
 
 	// takes from config
 	std::wstring m_reportFile;
@@ -173,6 +182,15 @@ private:
 
 	// convert to docx before extract
 	bool m_bConvertBeforeExtract;
+
+	// benchmark mode
+	bool m_bBenchmark;
+	int m_benchmarkRuns;
+	std::wstring m_benchmarkResultFile;
+	std::wstring m_benchmarkBaselineFile;
+	bool m_bIsBenchmarkIntermediateTempDir;
+	std::wstring m_benchmarkIntermediateTempDir;
+	int m_regressionsCount;
 };
 
 // generates temp xml, convert, calls m_internal->writeReport
@@ -198,6 +216,8 @@ public:
 	void SetTimeout(unsigned long timeout);
 	void SetFilesCount(int totalFiles, int currFile);
 	void SetSaveEnvironment(bool bSaveEnvironment);
+	void SetBenchmark(const std::wstring& inputRelativeFile, int runs);
+	void SetIntermediateTempDir(const std::wstring& intermediateTempDir);
 
 	virtual DWORD ThreadProc();
 
@@ -205,6 +225,12 @@ private:
 	Cx2tTester* m_internal;
 	std::wstring m_inputFile;
 
+	// benchmark mode (m_internal->m_pBenchmark)
+	std::wstring m_inputRelativeFile;
+	int m_benchmarkRuns;
+	bool m_bIsIntermediateTempDir;
+	std::wstring m_intermediateTempDir;
+
 	std::wstring m_outputFilesDirectory;
 	std::vector<std::wstring> m_outputExts;
 	std::wstring m_inputExt;
@@ -11,14 +11,17 @@ SOURCES += \
     $$PWD/../../../../core/OOXML/Base/unicode_util.cpp
 
 
-HEADERS += x2tTester.h
-SOURCES += main.cpp x2tTester.cpp
+HEADERS += x2tTester.h x2tBenchmark.h
+SOURCES += main.cpp x2tTester.cpp x2tBenchmark.cpp
 
 CORE_ROOT_DIR = $$PWD/../../../../core
 PWD_ROOT_DIR = $$PWD
 include($$PWD/../../../Common/base.pri)
 include($$CORE_ROOT_DIR/Common/3dParty/icu/icu.pri)
+include($$CORE_ROOT_DIR/Common/3dParty/boost/boost.pri)
 
 ADD_DEPENDENCY(kernel, graphics, UnicodeConverter)
 
+core_windows:LIBS += -lPsapi
+
 DESTDIR = $$CORE_BUILDS_BINARY_PATH
@@ -44,6 +44,13 @@
 #include "../../OOXML/DocxFormat/Logic/Paragraph.h"
 #include "../../OOXML/DocxFormat/Logic/Run.h"
 
+#include "../../DesktopEditor/common/File.h"
+#include "../../DesktopEditor/common/StringBuilder.h"
+
+#include <algorithm>
+
+#define TXT_FLUSH_SIZE 0x100000 // символов в буфере до сброса в файл
+
 namespace Txt2Docx
 {
 	class Converter_Impl
@@ -52,6 +59,9 @@ namespace Txt2Docx
 		Converter_Impl(int encoding);
 
 		void convert();
+		void convert(const std::wstring& path, NSFile::CFileBinary& oFile);
+
+		static void InitProperties(ComplexTypes::Word::CSpacing& space, ComplexTypes::Word::CFonts& font);
 
 		Txt::File		m_inputFile;
 		OOX::CDocument	m_outputFile;
@@ -149,6 +159,11 @@ namespace Txt2Docx
 		return converter_->convert();
 	}
 
+	void Converter::convert(const std::wstring& path, NSFile::CFileBinary & file)
+	{
+		return converter_->convert(path, file);
+	}
+
 	void Converter::read(const std::wstring& path)
 	{
 		return converter_->m_inputFile.read(path);
@@ -171,6 +186,81 @@ namespace Txt2Docx
 		
 	}
 
+	void Converter_Impl::InitProperties(ComplexTypes::Word::CSpacing& space, ComplexTypes::Word::CFonts& font)
+	{
+		space.m_oAfter.Init();		space.m_oAfter->FromString(L"0");
+		space.m_oLine.Init();		space.m_oLine->FromString(L"240");
+		space.m_oLineRule.Init();	space.m_oLineRule->SetValue(SimpleTypes::linespacingruleAuto);
+
+		font.m_sAscii.Init();	*font.m_sAscii	= L"Courier New";
+		font.m_sHAnsi.Init();	*font.m_sHAnsi	= L"Courier New";
+		font.m_sCs.Init();		*font.m_sCs		= L"Courier New";
+	}
+
+	void Converter_Impl::convert(const std::wstring& path, NSFile::CFileBinary& oFile)
+	{
+		if (!m_inputFile.openLines(path))
+			return;
+
+		//свойства у всех абзацев одинаковые - xml для них строится один раз, тем же кодом что и в convert()
+		ComplexTypes::Word::CSpacing	space;
+		ComplexTypes::Word::CFonts		font;
+
+		InitProperties(space, font);
+
+		OOX::Logic::CParagraphProperty	pPr;
+		OOX::Logic::CRunProperty		rPr;
+
+		rPr.m_oRFonts	= font;
+		pPr.m_oSpacing	= space;
+		pPr.m_oRPr		= rPr;
+
+		const std::wstring sParagraphStart	= L"<w:p>" + pPr.toXML();
+		const std::wstring sParagraphEnd	= L"</w:p>";
+		const std::wstring sTextStart		= L"<w:r>" + rPr.toXML() + L"<w:t xml:space=\"preserve\">";
+		const std::wstring sTextEnd			= L"</w:t></w:r>";
+		const std::wstring sTab				= L"<w:r><w:tab/></w:r>";
+
+		NSStringUtils::CStringBuilder oWriter;
+		std::wstring line;
+
+		while (m_inputFile.readLine(line))
+		{
+			oWriter.WriteString(sParagraphStart);
+
+			line.erase(std::remove(line.begin(), line.end(), L'\x08'), line.end());
+
+			size_t start = 0;
+			for (size_t pos = line.find(L'\x09'); pos != std::wstring::npos; pos = line.find(L'\x09', start))
+			{
+				if (pos > start)
+				{
+					oWriter.WriteString(sTextStart);
+					oWriter.WriteString(XmlUtils::EncodeXmlString(line.substr(start, pos - start)));
+					oWriter.WriteString(sTextEnd);
+				}
+				oWriter.WriteString(sTab);
+				start = pos + 1;
+			}
+			if (start < line.length())
+			{
+				oWriter.WriteString(sTextStart);
+				oWriter.WriteString(XmlUtils::EncodeXmlString(start > 0 ? line.substr(start) : line));
+				oWriter.WriteString(sTextEnd);
+			}
+			oWriter.WriteString(sParagraphEnd);
+
+			if (oWriter.GetCurSize() > TXT_FLUSH_SIZE)
+			{
+				oFile.WriteStringUTF8(oWriter.GetData());
+				oWriter.ClearNoAttack();
+			}
+		}
+		oFile.WriteStringUTF8(oWriter.GetData());
+
+		m_inputFile.closeLines();
+	}
+
 	void Converter_Impl::convert()
 	{
 		//smart_ptr<OOX::File> pFile = m_outputFile.Find(OOX::FileTypes::Document);
@@ -182,13 +272,7 @@ namespace Txt2Docx
 			ComplexTypes::Word::CSpacing	space;
 			ComplexTypes::Word::CFonts		font;
 			
-			space.m_oAfter.Init();		space.m_oAfter->FromString(L"0");
-			space.m_oLine.Init();		space.m_oLine->FromString(L"240");
-			space.m_oLineRule.Init();	space.m_oLineRule->SetValue(SimpleTypes::linespacingruleAuto);
-			
-			font.m_sAscii.Init();	*font.m_sAscii	= L"Courier New";
-			font.m_sHAnsi.Init();	*font.m_sHAnsi	= L"Courier New";
-			font.m_sCs.Init();		*font.m_sCs		= L"Courier New";
+			InitProperties(space, font);
 
 			for (size_t i = 0; i < m_inputFile.m_listContent.size(); ++i)
 			{
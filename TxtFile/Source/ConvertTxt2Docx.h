@@ -37,6 +37,10 @@ namespace NSStringUtils
 {
 	class CStringBuilder;
 }
+namespace NSFile
+{
+	class CFileBinary;
+}
 
 namespace Txt2Docx
 {
@@ -52,6 +56,9 @@ namespace Txt2Docx
 		void read	(const std::wstring& path);
 		void write	(NSStringUtils::CStringBuilder & stringWriter/*const std::wstring& path*/);
 
+		//потоковый вариант read + convert + write: абзацы пишутся в открытый document.xml по мере чтения
+		void convert(const std::wstring& path, NSFile::CFileBinary & file);
+
 	private:
 		Converter_Impl * converter_;
 	};
@@ -17,12 +17,14 @@ LIBS += -L$$CORE_BOOST_LIBS
 SOURCES += \
     $$CORE_ROOT_DIR/Common/OfficeFileFormatChecker2.cpp \
     $$CORE_ROOT_DIR/X2tConverter/src/cextracttools.cpp \
-    $$CORE_ROOT_DIR/X2tConverter/src/ASCConverters.cpp
+    $$CORE_ROOT_DIR/X2tConverter/src/ASCConverters.cpp \
+    $$CORE_ROOT_DIR/X2tConverter/src/profiler.cpp
 
 HEADERS += \
     $$CORE_ROOT_DIR/Common/OfficeFileFormatChecker.h \
     $$CORE_ROOT_DIR/X2tConverter/src/cextracttools.h \
-    $$CORE_ROOT_DIR/X2tConverter/src/ASCConverters.h
+    $$CORE_ROOT_DIR/X2tConverter/src/ASCConverters.h \
+    $$CORE_ROOT_DIR/X2tConverter/src/profiler.h
 
 LIBS += -L$$CORE_BUILDS_LIBRARIES_PATH -lVbaFormatLib
 LIBS += -L$$CORE_BUILDS_LIBRARIES_PATH -lOdfFormatLib
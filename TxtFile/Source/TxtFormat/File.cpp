@@ -86,10 +86,7 @@ namespace NSEncoding
 			const NSUnicodeConverter::EncodindId& oEncodindId = NSUnicodeConverter::Encodings[code_page];
 			NSUnicodeConverter::CUnicodeConverter oUnicodeConverter;
 
-			for (std::vector<std::string>::const_iterator iter = lines.begin(); iter != lines.end(); iter++)
-			{
-				result.push_back(oUnicodeConverter.toUnicode(*iter, oEncodindId.Name));
-			}
+			result = oUnicodeConverter.toUnicode(lines, oEncodindId.Name);
 		}
 		return result;
 	}
@@ -109,10 +106,7 @@ namespace NSEncoding
 			const NSUnicodeConverter::EncodindId& oEncodindId = NSUnicodeConverter::Encodings[code_page];
 			NSUnicodeConverter::CUnicodeConverter oUnicodeConverter;
 
-			for (std::vector<std::wstring>::const_iterator iter = lines.begin(); iter != lines.end(); iter++)
-			{
-				result.push_back(oUnicodeConverter.fromUnicode(*iter, oEncodindId.Name));
-			}
+			result = oUnicodeConverter.fromUnicode(lines, oEncodindId.Name);
 		}
 		return result;
 	}
@@ -121,11 +115,12 @@ namespace NSEncoding
 namespace Txt
 {
 
-	File::File()
+	File::File() : m_listContentSize(0), m_nEncoding(-1), m_pLinesFile(NULL), m_nLinesCodePage(46), m_pLinesConverter(NULL)
 	{
 	}
 	File::~File()
 	{
+		closeLines();
 		m_listContent.clear();
 	}
 	void File::read(const std::wstring& filename, int code_page) // насильственное чтение в кодировке
@@ -153,24 +148,45 @@ namespace Txt
 	{
 		m_listContent.clear();
 
+		if (openLines(filename))
+		{
+			std::wstring line;
+			while (readLine(line))
+			{
+				m_listContent.push_back(line);
+			}
+		}
+		closeLines();
+
+		m_listContentSize = (int)m_listContent.size();
+	}
+
+	bool File::openLines(const std::wstring& filename)
+	{
+		closeLines();
+
 		if (filename.empty())
-			return;
+			return false;
 
-		TxtFile file(filename);
+		m_pLinesFile = new TxtFile(filename);
 		
 		//читаем юникод чтобы можно было выкинуть невалидные символы
+		bool result = false;
 
-		if (file.isUtf8())
+		if (m_pLinesFile->isUtf8())
 		{
-			m_listContent = NSEncoding::transformToUnicode(file.readUtf8(), 46); //65001 Unicode (UTF-8)
+			m_nLinesCodePage = 46; //65001 Unicode (UTF-8)
+			result = m_pLinesFile->openLines(3, false, false);
 		}
-		else if (file.isUnicode())
+		else if (m_pLinesFile->isUnicode())
 		{
-			m_listContent = file.readUnicode();
+			m_nLinesCodePage = -2;
+			result = m_pLinesFile->openLines(2, true, false);
 		}
-		else if (file.isBigEndian())
+		else if (m_pLinesFile->isBigEndian())
 		{
-			m_listContent = file.readBigEndian();
+			m_nLinesCodePage = -2;
+			result = m_pLinesFile->openLines(2, true, true);
 		}
 		//проверка убрана, потому что она работает в редких случаюх: если в первой строке есть английские символы
 		//далее не делается проверка BigEndian или LittleEndian
@@ -179,14 +195,49 @@ namespace Txt
 		//	listContentUnicode = file.readUnicodeWithOutBOM();
 		else
 		{
-			int nCodePage = m_nEncoding;
-			if (-1 == nCodePage) nCodePage = 46;
-			else if (1000 == nCodePage) nCodePage = -1;
+			m_nLinesCodePage = m_nEncoding;
+			if (-1 == m_nLinesCodePage) m_nLinesCodePage = 46;
+			else if (1000 == m_nLinesCodePage) m_nLinesCodePage = -1;
 
-			m_listContent = NSEncoding::transformToUnicode(file.readAnsiOrCodePage(), nCodePage);
+			result = m_pLinesFile->openLines(0, false, false);
 		}
-		
-		m_listContentSize = file.getLinesCount();
+
+		if (!result)
+			closeLines();
+		else if (m_nLinesCodePage >= 0)
+			m_pLinesConverter = new NSUnicodeConverter::CUnicodeConverter();
+
+		return result;
+	}
+
+	bool File::readLine(std::wstring& line)
+	{
+		if (m_pLinesFile == NULL || !m_pLinesFile->readLine(m_sLineBytes))
+			return false;
+
+		if (-2 == m_nLinesCodePage)
+			line = NSFile::CUtf8Converter::GetWStringFromUTF16((unsigned short*)m_sLineBytes.c_str(), (LONG)(m_sLineBytes.length() / 2));
+		else if (-1 == m_nLinesCodePage)
+			line = NSEncoding::ansi2unicode(m_sLineBytes);
+		else
+			line = m_pLinesConverter->toUnicode(m_sLineBytes, NSUnicodeConverter::Encodings[m_nLinesCodePage].Name);
+
+		return true;
+	}
+
+	void File::closeLines()
+	{
+		if (m_pLinesFile)
+		{
+			delete m_pLinesFile;
+			m_pLinesFile = NULL;
+		}
+		if (m_pLinesConverter)
+		{
+			delete m_pLinesConverter;
+			m_pLinesConverter = NULL;
+		}
+		std::string().swap(m_sLineBytes);
 	}
 
 	bool File::write(const std::wstring& filename) const
@@ -34,6 +34,13 @@
 #include <vector>
 #include <string>
 
+class TxtFile;
+
+namespace NSUnicodeConverter
+{
+	class CUnicodeConverter;
+}
+
 namespace Txt
 {
 	class File
@@ -54,9 +61,20 @@ namespace Txt
 		bool writeAnsi		(const std::wstring& filename) const;
 		
 		const bool isValid	(const std::wstring& filename) const;
+
+		//потоковое чтение без m_listContent - кодировка определяется как в read, строки декодируются по одной
+		bool openLines		(const std::wstring& filename);
+		bool readLine		(std::wstring& line);
+		void closeLines		();
 		
 		std::vector<std::wstring>	m_listContent;			//unicode  (ранее было utf8)
 		int							m_listContentSize;		//для вывода процентов конвертации
 		int							m_nEncoding;
+
+	private:
+		TxtFile*								m_pLinesFile;
+		int										m_nLinesCodePage;	//-2 - UTF-16, -1 - локаль
+		NSUnicodeConverter::CUnicodeConverter*	m_pLinesConverter;
+		std::string								m_sLineBytes;
 	};
 } // namespace Txt
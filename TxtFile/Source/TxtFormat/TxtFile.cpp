@@ -35,13 +35,131 @@
 
 static const std::string BadSymbols = "\x0A\x0B\x0C\x0D\x0E\x0F\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19";
 
-TxtFile::TxtFile(const std::wstring & path) : m_path(path), m_linesCount(0)
+#define TXT_CHUNK_SIZE 0x100000 // четный - символы UTF-16 не разрываются между кусками
+
+TxtFile::TxtFile(const std::wstring & path) : m_path(path), m_linesCount(0),
+	m_pFile(NULL), m_chunkPos(0), m_chunkSize(0), m_unicode(false), m_bigEndian(false), m_skipLF(false), m_eof(true)
+{
+}
+TxtFile::~TxtFile()
 {
+	closeLines();
 }
 const int TxtFile::getLinesCount()
 {
 	return m_linesCount;
 }
+bool TxtFile::openLines(long header_size, bool unicode, bool big_endian)
+{
+	closeLines();
+
+	m_pFile = new NSFile::CFileBinary();
+	if (m_pFile->OpenFile(m_path) == false)
+	{
+		closeLines();
+		return false;
+	}
+	m_unicode	= unicode;
+	m_bigEndian	= big_endian;
+	m_skipLF	= false;
+	m_chunkPos	= m_chunkSize = 0;
+
+	long file_size = m_pFile->GetFileSize();
+	m_eof = (unicode && file_size < 3); // как в readUnicodeFromBytes
+
+	if (header_size > 0 && header_size <= file_size)
+		m_pFile->SeekFile(header_size);
+
+	m_chunk.resize(TXT_CHUNK_SIZE);
+	return true;
+}
+void TxtFile::closeLines()
+{
+	if (m_pFile)
+	{
+		m_pFile->CloseFile();
+		delete m_pFile;
+		m_pFile = NULL;
+	}
+	std::vector<char>().swap(m_chunk);
+	m_chunkPos = m_chunkSize = 0;
+	m_eof = true;
+}
+bool TxtFile::readChunk()
+{
+	if (m_pFile == NULL) return false;
+
+	DWORD dwRead = 0;
+	m_pFile->ReadFile((BYTE*)&m_chunk[0], (DWORD)m_chunk.size(), dwRead);
+
+	m_chunkPos	= 0;
+	m_chunkSize	= dwRead;
+
+	if (m_unicode)
+	{
+		m_chunkSize &= ~(size_t)1; // нечетный байт в конце файла отбрасывается
+
+		if (m_bigEndian)
+		{
+			for (size_t i = 0; i < m_chunkSize; i += 2)
+			{
+				char v			= m_chunk[i];
+				m_chunk[i]		= m_chunk[i + 1];
+				m_chunk[i + 1]	= v;
+			}
+		}
+	}
+	return m_chunkSize > 0;
+}
+bool TxtFile::readLine(std::string & line)
+{
+	line.clear();
+
+	if (m_eof) return false;
+
+	const size_t char_size = m_unicode ? 2 : 1;
+
+	while (true)
+	{
+		if (m_chunkPos >= m_chunkSize && !readChunk())
+		{
+			//last
+			m_eof = true;
+			m_linesCount++;
+			return true;
+		}
+
+		const char* data = &m_chunk[0];
+
+		if (m_skipLF)
+		{
+			m_skipLF = false;
+			if (0x0a == data[m_chunkPos] && (!m_unicode || 0x00 == data[m_chunkPos + 1]))
+			{
+				m_chunkPos += char_size;
+				continue;
+			}
+		}
+
+		size_t end_pos = m_chunkPos;
+		for (; end_pos < m_chunkSize; end_pos += char_size)
+		{
+			BYTE cCurChar = data[end_pos];
+			if ((0x0a == cCurChar || 0x0d == cCurChar) && (!m_unicode || 0x00 == data[end_pos + 1]))
+				break;
+		}
+		line.append(data + m_chunkPos, data + end_pos);
+
+		if (end_pos < m_chunkSize)
+		{
+			m_skipLF	= (0x0d == data[end_pos]);
+			m_chunkPos	= end_pos + char_size;
+			m_linesCount++;
+			return true;
+		}
+		m_chunkPos = end_pos;
+	}
+}
 const std::vector<std::string> TxtFile::readAnsiOrCodePage() // == readUtf8withoutPref также
 {
     std::vector<std::string> result;
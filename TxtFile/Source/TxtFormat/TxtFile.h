@@ -36,10 +36,16 @@
 #include <string>
 #include <vector>
 
+namespace NSFile
+{
+	class CFileBinary;
+}
+
 class TxtFile
 {
 public:
 	TxtFile(const std::wstring & path);
+	~TxtFile();
 
     const std::vector<std::string>	readAnsiOrCodePage();
     const std::vector<std::wstring>	readUnicodeFromBytes(char *file_data, long file_size);
@@ -59,9 +65,26 @@ public:
 
 	const int	getLinesCount();
 
+	//построчное чтение кусками фиксированного размера - в памяти только текущая строка
+	//unicode - строки из 2-х байтовых символов (возвращаются в UTF-16LE)
+	bool openLines	(long header_size, bool unicode, bool big_endian);
+	bool readLine	(std::string & line);
+	void closeLines	();
+
 private:
+	bool readChunk	();
+
 	std::wstring	m_path;
 	int				m_linesCount;
+
+	NSFile::CFileBinary*	m_pFile;
+	std::vector<char>		m_chunk;
+	size_t					m_chunkPos;
+	size_t					m_chunkSize;
+	bool					m_unicode;
+	bool					m_bigEndian;
+	bool					m_skipLF;	//последняя строка кончилась на CR - LF в начале следующего куска не считается
+	bool					m_eof;
 };
 
 #endif // UTILITY_TXT_FILE_INCLUDE_H_
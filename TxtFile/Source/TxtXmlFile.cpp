@@ -101,17 +101,19 @@ _UINT32 CTxtXmlFile::txt_LoadFromFile(const std::wstring & sSrcFileName, const s
 		int encoding  = ParseTxtOptions(sXMLOptions);
 
 		Txt2Docx::Converter converter( encoding);
-		converter.read(sSrcFileName);
-		converter.convert();
-		converter.write(pDocxWriter->get_document_writer().m_oContent);
+
+		NSFile::CFileBinary oDocumentFile;
+		if (pDocxWriter->get_document_writer().WriteBegin(oDocumentFile)) //overwrite document.xml
+		{
+			converter.convert(sSrcFileName, oDocumentFile);
+			pDocxWriter->get_document_writer().WriteEnd(oDocumentFile);
+		}
 	}
 	catch(...)
 	{
 		return AVS_FILEUTILS_ERROR_CONVERT;
 	}
 
-	pDocxWriter->get_document_writer().Write(); //overwrite document.xml
-
 	delete pDocxWriter;
 	pDocxWriter = NULL;
 
@@ -46,6 +46,10 @@
 #include <windows.h>
 #endif
 
+#include <map>
+#include <vector>
+#include <string.h>
+
 #ifndef TRUE
 #define TRUE 1
 #endif
@@ -58,6 +62,383 @@ std::string g_overrideIcuDataPath = "";
 
 namespace NSUnicodeConverter
 {
+	// Opened ICU converters of the current thread. ucnv_open loads and parses
+	// the mapping table, which costs far more than converting a short string,
+	// so every converter is opened once per name/code page and only reset between calls.
+	class CConverterPool
+	{
+	public:
+		struct CItem
+		{
+			UConverter*		Converter;
+			UConverterType	Type;
+			bool			AsciiSuperset; // 0x00-0x7F map to themselves in both directions
+			std::wstring	SingleByte; // byte -> char table of a stateless single-byte converter, empty otherwise
+		};
+
+		CConverterPool() : m_pLastItem(NULL)
+		{
+		}
+		~CConverterPool()
+		{
+			for (std::map<std::string, CItem>::iterator it = m_mapNames.begin(); it != m_mapNames.end(); ++it)
+				Close(it->second);
+			for (std::map<int, CItem>::iterator it = m_mapCodePages.begin(); it != m_mapCodePages.end(); ++it)
+				Close(it->second);
+		}
+
+		static CConverterPool& Get()
+		{
+			static thread_local CConverterPool oPool;
+			return oPool;
+		}
+
+		// Converter is NULL if the name is unknown - failures are cached too
+		CItem* Open(const char* converterName)
+		{
+			if (NULL == converterName)
+				converterName = "";
+
+			if (m_pLastItem && m_sLastName == converterName)
+				return Reset(m_pLastItem);
+
+			std::map<std::string, CItem>::iterator it = m_mapNames.find(converterName);
+			if (it == m_mapNames.end())
+			{
+				UErrorCode status = U_ZERO_ERROR;
+				UConverter* conv = ucnv_open(*converterName ? converterName : NULL, &status);
+				it = m_mapNames.insert(std::make_pair(std::string(converterName), Create(U_SUCCESS(status) ? conv : NULL))).first;
+			}
+			m_sLastName = converterName;
+			m_pLastItem = &it->second;
+			return Reset(m_pLastItem);
+		}
+		CItem* Open(int nCodePage)
+		{
+			std::map<int, CItem>::iterator it = m_mapCodePages.find(nCodePage);
+			if (it == m_mapCodePages.end())
+			{
+				UErrorCode status = U_ZERO_ERROR;
+				UConverter* conv = ucnv_openCCSID(nCodePage, UCNV_UNKNOWN, &status);
+				it = m_mapCodePages.insert(std::make_pair(nCodePage, Create(U_SUCCESS(status) ? conv : NULL))).first;
+			}
+			return Reset(&it->second);
+		}
+
+		UChar* GetBuffer(size_t nSize)
+		{
+			if (m_arBuffer.size() < nSize + 1)
+				m_arBuffer.resize(nSize + 1);
+			return &m_arBuffer[0];
+		}
+
+	private:
+		static CItem Create(UConverter* conv)
+		{
+			CItem oItem;
+			oItem.Converter		= conv;
+			oItem.Type			= conv ? ucnv_getType(conv) : UCNV_UNSUPPORTED_CONVERTER;
+			oItem.AsciiSuperset	= false;
+
+			switch (oItem.Type)
+			{
+			case UCNV_SBCS:
+			case UCNV_MBCS:
+			case UCNV_LATIN_1:
+			case UCNV_UTF8:
+			case UCNV_US_ASCII:
+			{
+				// a round trip of the whole range also rejects stateful (SI/SO, escape) encodings
+				char pAscii[128];
+				UChar pUnicode[128];
+				char pBack[128];
+				for (int i = 0; i < 128; ++i)
+					pAscii[i] = (char)i;
+
+				UErrorCode status = U_ZERO_ERROR;
+				int32_t nLen = ucnv_toUChars(conv, pUnicode, 128, pAscii, 128, &status);
+				bool bEqual = (U_SUCCESS(status) && 128 == nLen);
+				for (int i = 0; bEqual && i < 128; ++i)
+					bEqual = (pUnicode[i] == (UChar)i);
+
+				if (bEqual)
+				{
+					nLen = ucnv_fromUChars(conv, pBack, 128, pUnicode, 128, &status);
+					bEqual = (U_SUCCESS(status) && 128 == nLen && 0 == memcmp(pAscii, pBack, 128));
+				}
+				oItem.AsciiSuperset = bEqual;
+				ucnv_reset(conv);
+
+				if (UCNV_SBCS == oItem.Type)
+					oItem.SingleByte = CreateSingleByteTable(conv);
+				break;
+			}
+			default:
+				break;
+			}
+			return oItem;
+		}
+		static std::wstring CreateSingleByteTable(UConverter* conv)
+		{
+			// every byte is converted on its own, exactly as inside a string -
+			// unmapped bytes get the same substitution character
+			std::wstring sTable(256, 0);
+			for (int i = 0; i < 256; ++i)
+			{
+				char ch = (char)i;
+				UChar pUnicode[2];
+				UErrorCode status = U_ZERO_ERROR;
+				int32_t nLen = ucnv_toUChars(conv, pUnicode, 2, &ch, 1, &status);
+				if (U_FAILURE(status) || 1 != nLen || U16_IS_SURROGATE(pUnicode[0]))
+					return std::wstring();
+
+				sTable[i] = (wchar_t)pUnicode[0];
+			}
+			ucnv_reset(conv);
+			return sTable;
+		}
+		static CItem* Reset(CItem* pItem)
+		{
+			if (pItem->Converter)
+				ucnv_reset(pItem->Converter);
+			return pItem;
+		}
+		static void Close(CItem& oItem)
+		{
+			if (oItem.Converter)
+				ucnv_close(oItem.Converter);
+			oItem.Converter = NULL;
+		}
+
+		std::map<std::string, CItem>	m_mapNames;
+		std::map<int, CItem>			m_mapCodePages;
+
+		std::string						m_sLastName;
+		CItem*							m_pLastItem;
+
+		std::vector<UChar>				m_arBuffer;
+	};
+
+	static bool IsAscii(const char* sInput, const unsigned int& nInputLen)
+	{
+		for (unsigned int i = 0; i < nInputLen; ++i)
+		{
+			if (sInput[i] & 0x80)
+				return false;
+		}
+		return true;
+	}
+	static bool IsAscii(const wchar_t* sInput, const unsigned int& nInputLen)
+	{
+		for (unsigned int i = 0; i < nInputLen; ++i)
+		{
+			if ((unsigned int)sInput[i] >= 0x80)
+				return false;
+		}
+		return true;
+	}
+
+	// strict UTF-8 -> wchar_t (UTF-16 or UTF-32); false on malformed input, which is left to ICU substitution
+	static bool Utf8ToWide(const char* sInput, const unsigned int& nInputLen, std::wstring& sRes)
+	{
+		const unsigned char* pCur = (const unsigned char*)sInput;
+		const unsigned char* pEnd = pCur + nInputLen;
+
+		sRes.resize(nInputLen);
+		wchar_t* pOut = sRes.empty() ? NULL : &sRes[0];
+		size_t nOut = 0;
+
+		while (pCur < pEnd)
+		{
+			unsigned int code = *pCur++;
+			if (code < 0x80)
+			{
+				pOut[nOut++] = (wchar_t)code;
+				continue;
+			}
+
+			int nTrail = 0;
+			unsigned int nMin = 0;
+			if ((code & 0xE0) == 0xC0)		{ nTrail = 1; nMin = 0x80;		code &= 0x1F; }
+			else if ((code & 0xF0) == 0xE0)	{ nTrail = 2; nMin = 0x800;		code &= 0x0F; }
+			else if ((code & 0xF8) == 0xF0)	{ nTrail = 3; nMin = 0x10000;	code &= 0x07; }
+			else
+				return false;
+
+			if (pEnd - pCur < nTrail)
+				return false;
+
+			for (int i = 0; i < nTrail; ++i)
+			{
+				if ((*pCur & 0xC0) != 0x80)
+					return false;
+				code = (code << 6) | (*pCur++ & 0x3F);
+			}
+			if (code < nMin || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF))
+				return false;
+
+			if (2 == sizeof(wchar_t) && code >= 0x10000)
+			{
+				// 4 input bytes always give 2 units - the buffer is big enough
+				code -= 0x10000;
+				pOut[nOut++] = (wchar_t)(0xD800 | (code >> 10));
+				pOut[nOut++] = (wchar_t)(0xDC00 | (code & 0x3FF));
+			}
+			else
+				pOut[nOut++] = (wchar_t)code;
+		}
+		sRes.resize(nOut);
+		return true;
+	}
+	// strict wchar_t -> UTF-8; false on unpaired surrogates and out-of-range values
+	static bool WideToUtf8(const wchar_t* sInput, const unsigned int& nInputLen, std::string& sRes)
+	{
+		sRes.resize((size_t)nInputLen * 4);
+		char* pOut = sRes.empty() ? NULL : &sRes[0];
+		size_t nOut = 0;
+
+		for (unsigned int i = 0; i < nInputLen; ++i)
+		{
+			unsigned int code = (unsigned int)sInput[i];
+			if (code >= 0xD800 && code <= 0xDFFF)
+			{
+				if (2 != sizeof(wchar_t) || code >= 0xDC00 || i + 1 >= nInputLen)
+					return false;
+
+				unsigned int low = (unsigned int)sInput[i + 1];
+				if (low < 0xDC00 || low > 0xDFFF)
+					return false;
+
+				code = 0x10000 + (((code & 0x3FF) << 10) | (low & 0x3FF));
+				++i;
+			}
+
+			if (code < 0x80)
+			{
+				pOut[nOut++] = (char)code;
+			}
+			else if (code < 0x800)
+			{
+				pOut[nOut++] = (char)(0xC0 | (code >> 6));
+				pOut[nOut++] = (char)(0x80 | (code & 0x3F));
+			}
+			else if (code < 0x10000)
+			{
+				pOut[nOut++] = (char)(0xE0 | (code >> 12));
+				pOut[nOut++] = (char)(0x80 | ((code >> 6) & 0x3F));
+				pOut[nOut++] = (char)(0x80 | (code & 0x3F));
+			}
+			else if (code <= 0x10FFFF)
+			{
+				pOut[nOut++] = (char)(0xF0 | (code >> 18));
+				pOut[nOut++] = (char)(0x80 | ((code >> 12) & 0x3F));
+				pOut[nOut++] = (char)(0x80 | ((code >> 6) & 0x3F));
+				pOut[nOut++] = (char)(0x80 | (code & 0x3F));
+			}
+			else
+				return false;
+		}
+		sRes.resize(nOut);
+		return true;
+	}
+
+	static void ToUnicode(CConverterPool::CItem* pItem, const char* sInput, const unsigned int& nInputLen, std::wstring& sRes)
+	{
+		if (pItem->AsciiSuperset && IsAscii(sInput, nInputLen))
+		{
+			sRes.assign(sInput, sInput + nInputLen);
+			return;
+		}
+		if (UCNV_LATIN_1 == pItem->Type)
+		{
+			sRes.assign((const unsigned char*)sInput, (const unsigned char*)sInput + nInputLen);
+			return;
+		}
+		if (!pItem->SingleByte.empty())
+		{
+			const wchar_t* pTable = pItem->SingleByte.c_str();
+			sRes.resize(nInputLen);
+			for (unsigned int i = 0; i < nInputLen; ++i)
+				sRes[i] = pTable[(unsigned char)sInput[i]];
+			return;
+		}
+		if (UCNV_UTF8 == pItem->Type && Utf8ToWide(sInput, nInputLen, sRes))
+			return;
+
+		UConverter* conv = pItem->Converter;
+		UErrorCode status = U_ZERO_ERROR;
+
+		const char* source = sInput;
+		const char* sourceLimit = source + nInputLen;
+
+		unsigned int uBufSize = (nInputLen / (uint8_t)ucnv_getMinCharSize(conv));
+
+		UChar* targetStart = CConverterPool::Get().GetBuffer(uBufSize);
+		UChar* target = targetStart;
+		UChar* targetLimit = target + uBufSize;
+
+		sRes.clear();
+		ucnv_toUnicode(conv, &target, targetLimit, &source, sourceLimit, NULL, TRUE, &status);
+		if (U_SUCCESS(status))
+		{
+			size_t nTargetSize = target - targetStart;
+			sRes.resize(nTargetSize * 2);// UTF-16 uses 2 code-points per char
+			int32_t nResLen = 0;
+
+			u_strToWCS(sRes.empty() ? NULL : &sRes[0], (int32_t)sRes.size(), &nResLen, targetStart, (int32_t)nTargetSize, &status);
+			if (U_SUCCESS(status))
+			{
+				sRes.resize((size_t)nResLen);
+			}
+			else
+			{
+				sRes.clear();
+			}
+		}
+	}
+	static void FromUnicode(CConverterPool::CItem* pItem, const wchar_t* sInput, const unsigned int& nInputLen, std::string& sRes)
+	{
+		if (pItem->AsciiSuperset && IsAscii(sInput, nInputLen))
+		{
+			sRes.resize(nInputLen);
+			for (unsigned int i = 0; i < nInputLen; ++i)
+				sRes[i] = (char)sInput[i];
+			return;
+		}
+		if (UCNV_UTF8 == pItem->Type && WideToUtf8(sInput, nInputLen, sRes))
+			return;
+
+		UConverter* conv = pItem->Converter;
+		UErrorCode status = U_ZERO_ERROR;
+
+		sRes.clear();
+
+		int32_t nUCharCapacity = (int32_t)nInputLen;// UTF-16 uses 2 code-points per char
+
+		UChar* pUChar = CConverterPool::Get().GetBuffer((size_t)nUCharCapacity);
+		const UChar* pUCharStart = pUChar;
+		int32_t nUCharLength = 0;
+
+		u_strFromWCS(pUChar, nUCharCapacity, &nUCharLength, sInput, (int32_t)nInputLen, &status);
+		if (U_SUCCESS(status))
+		{
+			const UChar* pUCharLimit = pUCharStart + nUCharLength;
+			sRes.resize((uint32_t)nUCharLength * (uint8_t)ucnv_getMaxCharSize(conv));// UTF-16 uses 2 code-points per char
+			char *sResStart = sRes.empty() ? NULL : &sRes[0];
+			char *sResCur = sResStart;
+			const char *sResLimit = sResCur + sRes.size();
+
+			ucnv_fromUnicode(conv, &sResCur, sResLimit, &pUCharStart, pUCharLimit, NULL, TRUE, &status);
+			if (U_SUCCESS(status))
+			{
+				sRes.resize(sResCur - sResStart);
+			}
+			else
+			{
+				sRes.clear();
+			}
+		}
+	}
 	class CUnicodeConverter_Private
 	{
 	public:
@@ -161,44 +542,16 @@ namespace NSUnicodeConverter
 #endif
 		}
 
-		static std::string fromUnicode(const wchar_t* sInput, const unsigned int& nInputLen, const char* converterName)
+		std::string fromUnicode(const wchar_t* sInput, const unsigned int& nInputLen, const char* converterName)
+		{
+			return fromUnicode(CConverterPool::Get().Open(converterName), sInput, nInputLen);
+		}
+		std::string fromUnicode(CConverterPool::CItem* pItem, const wchar_t* sInput, const unsigned int& nInputLen)
 		{
 			std::string sRes = "";
-			UErrorCode status = U_ZERO_ERROR;
-			UConverter* conv = ucnv_open(converterName, &status);
-			if (U_SUCCESS(status))
+			if (pItem->Converter)
 			{
-				int32_t nUCharCapacity = (int32_t)nInputLen;// UTF-16 uses 2 code-points per char
-
-				//UChar* pUChar = new UChar[nUCharCapacity];
-				UChar* pUChar = (UChar*)malloc((uint32_t)nUCharCapacity * sizeof(UChar));
-				if (pUChar)
-				{
-					const UChar* pUCharStart = pUChar;
-					int32_t nUCharLength = 0;
-
-					u_strFromWCS(pUChar, nUCharCapacity, &nUCharLength, sInput, (int32_t)nInputLen, &status);
-					if (U_SUCCESS(status))
-					{
-						const UChar* pUCharLimit = pUCharStart + nUCharLength;
-						sRes.resize((uint32_t)nUCharLength * (uint8_t)ucnv_getMaxCharSize(conv));// UTF-16 uses 2 code-points per char
-						char *sResStart = &sRes[0];
-						char *sResCur = sResStart;
-						const char *sResLimit = sResCur + sRes.size();
-
-						ucnv_fromUnicode(conv, &sResCur, sResLimit, &pUCharStart, pUCharLimit, NULL, TRUE, &status);
-						if (U_SUCCESS(status))
-						{
-							sRes.resize(sResCur - sResStart);
-						}
-						else
-						{
-							sRes.clear();
-						}
-					}
-					//delete []pUCharStart;
-				}
-				ucnv_close(conv);
+				FromUnicode(pItem, sInput, nInputLen, sRes);
 			}
 
 			if (sRes.empty() && nInputLen > 0)
@@ -209,47 +562,15 @@ namespace NSUnicodeConverter
 			return sRes;
 		}
 		std::wstring toUnicode(const char* sInput, const unsigned int& nInputLen, int nCodePage, bool isExact)
+		{
+			return toUnicode(CConverterPool::Get().Open(nCodePage), sInput, nInputLen, nCodePage, isExact);
+		}
+		std::wstring toUnicode(CConverterPool::CItem* pItem, const char* sInput, const unsigned int& nInputLen, int nCodePage, bool isExact)
 		{
 			std::wstring sRes = L"";
-			UErrorCode status = U_ZERO_ERROR;
-			UConverter* conv = ucnv_openCCSID(nCodePage, UCNV_UNKNOWN, &status);
-			if (U_SUCCESS(status))
+			if (pItem->Converter)
 			{
-//UConverter* conv = ucnv_openCCSID(5347, UCNV_IBM, &status);
-				if (U_SUCCESS(status))
-				{
-					const char* source = sInput;
-					const char* sourceLimit = source + nInputLen;
-
-					unsigned int uBufSize = (nInputLen / (uint8_t)ucnv_getMinCharSize(conv));
-
-					UChar* targetStart = new UChar[uBufSize * sizeof(UChar)];
-					if (targetStart)
-					{
-						UChar* target = targetStart;
-						UChar* targetLimit = target + uBufSize;
-
-						ucnv_toUnicode(conv, &target, targetLimit, &source, sourceLimit, NULL, TRUE, &status);
-						if (U_SUCCESS(status))
-						{
-							size_t nTargetSize = target - targetStart;
-							sRes.resize(nTargetSize * 2);// UTF-16 uses 2 code-points per char
-							int32_t nResLen = 0;
-
-							u_strToWCS(&sRes[0], (int32_t)sRes.size(), &nResLen, targetStart, (int32_t)nTargetSize, &status);
-							if (U_SUCCESS(status))
-							{
-								sRes.resize((size_t)nResLen);
-							}
-							else
-							{
-								sRes.clear();
-							}
-						}
-						delete []targetStart;
-					}
-					ucnv_close(conv);
-				}
+				ToUnicode(pItem, sInput, nInputLen, sRes);
 			}
 			else
 			{//10008 & other
@@ -264,47 +585,15 @@ namespace NSUnicodeConverter
 			return sRes;
 		}
 		std::wstring toUnicode(const char* sInput, const unsigned int& nInputLen, const char* converterName, bool isExact)
+		{
+			return toUnicode(CConverterPool::Get().Open(converterName), sInput, nInputLen, isExact);
+		}
+		std::wstring toUnicode(CConverterPool::CItem* pItem, const char* sInput, const unsigned int& nInputLen, bool isExact)
 		{
 			std::wstring sRes = L"";
-			UErrorCode status = U_ZERO_ERROR;
-			UConverter* conv = ucnv_open(converterName, &status);
-			if (U_SUCCESS(status))
+			if (pItem->Converter)
 			{
-//UConverter* conv = ucnv_openCCSID(5347, UCNV_IBM, &status);
-				if (U_SUCCESS(status))
-				{
-					const char* source = sInput;
-					const char* sourceLimit = source + nInputLen;
-
-					unsigned int uBufSize = (nInputLen / (uint8_t)ucnv_getMinCharSize(conv));
-
-					UChar* targetStart = new UChar[uBufSize * sizeof(UChar)];
-					if (targetStart)
-					{
-						UChar* target = targetStart;
-						UChar* targetLimit = target + uBufSize;
-
-						ucnv_toUnicode(conv, &target, targetLimit, &source, sourceLimit, NULL, TRUE, &status);
-						if (U_SUCCESS(status))
-						{
-							size_t nTargetSize = target - targetStart;
-							sRes.resize(nTargetSize * 2);// UTF-16 uses 2 code-points per char
-							int32_t nResLen = 0;
-
-							u_strToWCS(&sRes[0], (int32_t)sRes.size(), &nResLen, targetStart, (int32_t)nTargetSize, &status);
-							if (U_SUCCESS(status))
-							{
-								sRes.resize((size_t)nResLen);
-							}
-							else
-							{
-								sRes.clear();
-							}
-						}
-						delete []targetStart;
-					}
-					ucnv_close(conv);
-				}
+				ToUnicode(pItem, sInput, nInputLen, sRes);
 			}
 
 			if (isExact && sRes.empty() && nInputLen > 0)
@@ -487,6 +776,46 @@ namespace NSUnicodeConverter
 	{
 		return this->toUnicode(sInput.c_str(), (unsigned int)sInput.size(), nCodePage, isExact);
 	}
+
+	std::vector<std::string> CUnicodeConverter::fromUnicode(const std::vector<std::wstring>& arSrc, const char* converterName)
+	{
+		std::vector<std::string> arResult(arSrc.size());
+
+		CConverterPool::CItem* pItem = CConverterPool::Get().Open(converterName);
+		for (size_t i = 0; i < arSrc.size(); ++i)
+		{
+			arResult[i] = m_pInternal->fromUnicode(pItem, arSrc[i].c_str(), (unsigned int)arSrc[i].size());
+		}
+		return arResult;
+	}
+	std::vector<std::wstring> CUnicodeConverter::toUnicode(const std::vector<std::string>& arSrc, const char* converterName, bool isExact)
+	{
+		std::vector<std::wstring> arResult(arSrc.size());
+
+		CConverterPool::CItem* pItem = CConverterPool::Get().Open(converterName);
+		for (size_t i = 0; i < arSrc.size(); ++i)
+		{
+			arResult[i] = m_pInternal->toUnicode(pItem, arSrc[i].c_str(), (unsigned int)arSrc[i].size(), isExact);
+		}
+		return arResult;
+	}
+	std::vector<std::wstring> CUnicodeConverter::toUnicode(const std::vector<std::string>& arSrc, int nCodePage, bool isExact)
+	{
+		std::vector<std::wstring> arResult(arSrc.size());
+
+		CConverterPool::CItem* pItem = CConverterPool::Get().Open(nCodePage);
+		for (size_t i = 0; i < arSrc.size(); ++i)
+		{
+			const std::string& sInput = arSrc[i];
+			if (sInput.empty())
+				continue;
+
+			arResult[i] = m_pInternal->toUnicode(pItem, sInput.c_str(), (unsigned int)sInput.size(), nCodePage, isExact);
+			if (arResult[i].empty())
+				arResult[i] = m_pInternal->convert_string(sInput.c_str(), (unsigned int)sInput.size(), nCodePage);
+		}
+		return arResult;
+	}
 	std::string CUnicodeConverter::SASLprepToUtf8(const std::wstring &sSrc)
 	{
 		return m_pInternal->SASLprepToUtf8(sSrc.c_str(), sSrc.length());
@@ -40,6 +40,7 @@
 #endif
 
 #include <string>
+#include <vector>
 #include "UnicodeConverter_Encodings.h"
 
 namespace NSUnicodeConverter
@@ -60,6 +61,11 @@ namespace NSUnicodeConverter
         std::wstring toUnicode(const char* sInput, const unsigned int& nInputLen, int nCodePage, bool isExact = false);
         std::wstring toUnicode(const std::string& sSrc, int nCodePage, bool isExact = false);
 
+        // many short strings of one encoding (text runs, cells, records) - the converter is looked up once
+        std::vector<std::string> fromUnicode(const std::vector<std::wstring>& arSrc, const char* converterName);
+        std::vector<std::wstring> toUnicode(const std::vector<std::string>& arSrc, const char* converterName, bool isExact = false);
+        std::vector<std::wstring> toUnicode(const std::vector<std::string>& arSrc, int nCodePage, bool isExact = false);
+
         std::string SASLprepToUtf8(const std::wstring &sSrc);
 
         // use this only for static icu builds
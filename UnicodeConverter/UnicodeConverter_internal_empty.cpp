@@ -119,6 +119,28 @@ namespace NSUnicodeConverter
     {
         return this->toUnicode(sInput.c_str(), (unsigned int)sInput.size(), nCodePage, isExact);
     }
+
+    std::vector<std::string> CUnicodeConverter::fromUnicode(const std::vector<std::wstring>& arSrc, const char* converterName)
+    {
+        std::vector<std::string> arResult(arSrc.size());
+        for (size_t i = 0; i < arSrc.size(); ++i)
+            arResult[i] = this->fromUnicode(arSrc[i], converterName);
+        return arResult;
+    }
+    std::vector<std::wstring> CUnicodeConverter::toUnicode(const std::vector<std::string>& arSrc, const char* converterName, bool isExact)
+    {
+        std::vector<std::wstring> arResult(arSrc.size());
+        for (size_t i = 0; i < arSrc.size(); ++i)
+            arResult[i] = this->toUnicode(arSrc[i], converterName, isExact);
+        return arResult;
+    }
+    std::vector<std::wstring> CUnicodeConverter::toUnicode(const std::vector<std::string>& arSrc, int nCodePage, bool isExact)
+    {
+        std::vector<std::wstring> arResult(arSrc.size());
+        for (size_t i = 0; i < arSrc.size(); ++i)
+            arResult[i] = this->toUnicode(arSrc[i], nCodePage, isExact);
+        return arResult;
+    }
     std::string CUnicodeConverter::SASLprepToUtf8(const std::wstring &sSrc)
     {
         return m_pInternal->SASLprepToUtf8(sSrc.c_str(), sSrc.length());
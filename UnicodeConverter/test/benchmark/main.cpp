@@ -0,0 +1,132 @@
+/*
+ * (c) Copyright UNIVAULT TECHNOLOGIES 2026-2026
+ *
+ * This program is a free software product. You can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License (AGPL)
+ * version 3 as published by the Free Software Foundation. In accordance with
+ * Section 7(a) of the GNU AGPL its Section 15 shall be amended to the effect
+ * that UNIVAULT TECHNOLOGIES expressly excludes the warranty of non-infringement
+ * of any third-party rights.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR  PURPOSE. For
+ * details, see the GNU AGPL at: http://www.gnu.org/licenses/agpl-3.0.html
+ *
+ * You can contact UNIVAULT TECHNOLOGIES at 20A-6 Ernesta Birznieka-Upish
+ * street, Moscow (TEST), Russia (TEST), EU, 000000 (TEST).
+ *
+ * The  interactive user interfaces in modified source and object code versions
+ * of the Program must display Appropriate Legal Notices, as required under
+ * Section 5 of the GNU AGPL version 3.
+ *
+ * Pursuant to Section 7(b) of the License you must retain the original Product
+ * logo when distributing the program. Pursuant to Section 7(e) we decline to
+ * grant you any rights under trademark law for use of our trademarks.
+ *
+ * All the Product's GUI elements, including illustrations and icon sets, as
+ * well as technical writing content are licensed under the terms of the
+ * Creative Commons Attribution-ShareAlike 4.0 International. See the License
+ * terms at http://creativecommons.org/licenses/by-sa/4.0/legalcode
+ *
+ */
+#include "../../UnicodeConverter.h"
+#include "../../../DesktopEditor/common/File.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+// Text of a .doc with a single-byte code page is converted piece by piece, as
+// DocFileFormat::FormatUtils::GetSTLCollectionFromBytes does: a new CUnicodeConverter
+// and one toUnicode call per piece (a run or a paragraph, tens of bytes).
+//
+// usage: benchmark [file with 8-bit text] [code page]   (default: generated windows-1251 text)
+
+static double Measure(const std::function<void()>& func)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    func();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+    int nCodePage = (argc > 2) ? std::atoi(argv[2]) : 1251;
+
+    std::string sText;
+    if (argc > 1)
+    {
+        BYTE* pData = NULL;
+        DWORD nLen = 0;
+        if (!NSFile::CFileBinary::ReadAllBytes(NSFile::CUtf8Converter::GetUnicodeStringFromUTF8((BYTE*)argv[1], (LONG)strlen(argv[1])), &pData, nLen))
+        {
+            std::cout << "can't read " << argv[1] << std::endl;
+            return 1;
+        }
+        sText.assign((char*)pData, nLen);
+        RELEASEARRAYOBJECTS(pData);
+    }
+    else
+    {
+        // russian prose: cyrillic words, spaces, punctuation, some latin and digits
+        const char* arWords[] = { "\xcf\xf0\xe8\xea\xe0\xe7", "\xee\xf2", "2024", "\xe3\xee\xe4\xe0,", "Word",
+                                  "\xe4\xee\xea\xf3\xec\xe5\xed\xf2", "\xe8", "\xf2\xe0\xe1\xeb\xe8\xf6\xe0.", "(1)", "\xf1\xf2\xf0\xe0\xed\xe8\xf6\xe0" };
+        for (int i = 0; sText.length() < 8 * 1024 * 1024; ++i)
+        {
+            sText += arWords[(i * 7 + i / 3) % 10];
+            sText += ' ';
+        }
+    }
+
+    std::map<int, std::string>::const_iterator pFind = NSUnicodeConverter::mapEncodingsICU.find(nCodePage);
+    std::string sCodePage = (pFind != NSUnicodeConverter::mapEncodingsICU.end()) ? pFind->second : "CP1250";
+
+    // pieces of 8..72 bytes
+    std::vector<std::string> arPieces;
+    for (size_t nPos = 0, i = 0; nPos < sText.length(); ++i)
+    {
+        size_t nLen = 8 + (i * 37) % 65;
+        arPieces.push_back(sText.substr(nPos, nLen));
+        nPos += nLen;
+    }
+
+    std::vector<std::wstring> arSingle(arPieces.size());
+    std::vector<std::wstring> arBatch;
+
+    double dSingle = Measure([&]()
+    {
+        for (size_t i = 0; i < arPieces.size(); ++i)
+        {
+            NSUnicodeConverter::CUnicodeConverter oConverter;
+            arSingle[i] = oConverter.toUnicode(arPieces[i].c_str(), (unsigned int)arPieces[i].length(), sCodePage.c_str());
+        }
+    });
+    double dBatch = Measure([&]()
+    {
+        NSUnicodeConverter::CUnicodeConverter oConverter;
+        arBatch = oConverter.toUnicode(arPieces, sCodePage.c_str());
+    });
+
+    std::vector<std::string> arBack;
+    double dFrom = Measure([&]()
+    {
+        NSUnicodeConverter::CUnicodeConverter oConverter;
+        arBack = oConverter.fromUnicode(arBatch, sCodePage.c_str());
+    });
+
+    std::cout << sCodePage << ": " << sText.length() << " bytes, " << arPieces.size() << " pieces" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "toUnicode per piece:   " << dSingle << " ms" << std::endl;
+    std::cout << "toUnicode batch:       " << dBatch << " ms" << std::endl;
+    std::cout << "fromUnicode batch:     " << dFrom << " ms" << std::endl;
+
+    bool bEqual = (arSingle == arBatch) && (arBack == arPieces);
+    std::cout << (bEqual ? "results are equal" : "RESULTS DIFFER") << std::endl;
+
+    return bEqual ? 0 : 1;
+}
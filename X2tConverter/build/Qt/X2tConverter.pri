@@ -65,12 +65,14 @@ DEPENDPATH += $$PWD/../../../OOXML/Binary/Document
 SOURCES += \
 	../../../Common/OfficeFileFormatChecker2.cpp \
 	../../src/cextracttools.cpp \
-	../../src/ASCConverters.cpp
+	../../src/ASCConverters.cpp \
+	../../src/profiler.cpp
 
 HEADERS += \
 	../../../Common/OfficeFileFormatChecker.h \
 	../../src/cextracttools.h \
-	../../src/ASCConverters.h
+	../../src/ASCConverters.h \
+	../../src/profiler.h
 
 HEADERS += \
 	../../src/lib/common.h \
@@ -144,6 +146,7 @@ include($$PWD/../../../Common/3dParty/boost/boost.pri)
 
 core_windows {
     LIBS += -lAdvapi32
+    LIBS += -lPsapi
 }
 ########################################################
 
@@ -118,6 +118,7 @@ namespace NExtractTools
 	_UINT32 convertmailmerge(const InputParamsMailMerge& oMailMergeSend,
 							 const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("convertmailmerge");
 		if (NULL == oMailMergeSend.mailFormat || NULL == oMailMergeSend.recordFrom || NULL == oMailMergeSend.recordTo)
 			return AVS_FILEUTILS_ERROR_CONVERT;
 
@@ -154,7 +155,10 @@ namespace NExtractTools
 		// посылаем выходную папку sFileFromDir, чтобы файлы лежали на одном уровне с папкой media, важно для дальнейшей конвертации в docx, pdf
 		std::wstring sXml = getDoctXml(NSDoctRenderer::DoctRendererFormat::FormatFile::DOCT, eTypeTo, sFrom, sFileFromDir, sImagesDirectory, convertParams.m_sThemesDir, -1, sMailMergeXml, params);
 		std::wstring sResult;
-		oDoctRenderer.Execute(sXml, sResult);
+		{
+			X2T_PROFILE_SCOPE("doctrenderer");
+			oDoctRenderer.Execute(sXml, sResult);
+		}
 		if (-1 != sResult.find(_T("error")))
 		{
 			std::wcerr << _T("DoctRenderer:") << sResult << std::endl;
@@ -253,6 +257,7 @@ namespace NExtractTools
 	// from docxDir
 	_UINT32 fromDocxDir(const std::wstring &sFrom, const std::wstring &sTo, int nFormatTo, InputParams &params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("fromDocxDir");
 		_UINT32 nRes = 0;
 		std::wstring sFromWithChanges = sFrom;
 		bool bIsNeedDoct = false;
@@ -442,6 +447,7 @@ namespace NExtractTools
 
 	_UINT32 fromDoctBin(const std::wstring& sFrom, const std::wstring& sTo, int nFormatTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("fromDoctBin");
 		_UINT32 nRes = 0;
 		if (AVS_OFFICESTUDIO_FILE_TEAMLAB_DOCY == nFormatTo)
 		{
@@ -511,6 +517,7 @@ namespace NExtractTools
 	}
 	_UINT32 fromDocument(const std::wstring& sFrom, int nFormatFrom, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("fromDocument");
 		std::wstring sTo = *params.m_sFileTo;
 		int nFormatTo = AVS_OFFICESTUDIO_FILE_UNKNOWN;
 		if (NULL != params.m_nFormatTo)
@@ -721,6 +728,7 @@ namespace NExtractTools
 	// from xlsxDir
 	_UINT32 fromXlsbXlsxDir(const std::wstring &sFrom, const std::wstring &sTo, int nFormatTo, InputParams &params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("fromXlsbXlsxDir");
 		_UINT32 nRes = S_OK;
 		if (AVS_OFFICESTUDIO_FILE_OTHER_OOXML == nFormatTo)
 		{
@@ -792,6 +800,7 @@ namespace NExtractTools
 	}
 	_UINT32 fromXlsxDir(const std::wstring& sFrom, const std::wstring& sTo, int nFormatTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("fromXlsxDir");
 		_UINT32 nRes = 0;
 		if (0 != (AVS_OFFICESTUDIO_FILE_SPREADSHEET & nFormatTo) && AVS_OFFICESTUDIO_FILE_SPREADSHEET_CSV != nFormatTo)
 		{
@@ -866,6 +875,7 @@ namespace NExtractTools
 	}
 	_UINT32 fromXlstBin(const std::wstring& sFrom, const std::wstring& sTo, int nFormatTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("fromXlstBin");
 		_UINT32 nRes = 0;
 		if (AVS_OFFICESTUDIO_FILE_TEAMLAB_XLSY == nFormatTo)
 		{
@@ -922,6 +932,7 @@ namespace NExtractTools
 	}
 	_UINT32 fromSpreadsheet(const std::wstring& sFrom, int nFormatFrom, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("fromSpreadsheet");
 		std::wstring sTo = *params.m_sFileTo;
 		int nFormatTo = AVS_OFFICESTUDIO_FILE_UNKNOWN;
 		if (NULL != params.m_nFormatTo)
@@ -1088,6 +1099,7 @@ namespace NExtractTools
 	// from pptx
 	_UINT32 fromPptxDir(const std::wstring& sFrom, const std::wstring& sTo, int nFormatTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("fromPptxDir");
 		_UINT32 nRes = 0;
 		if (0 != (AVS_OFFICESTUDIO_FILE_PRESENTATION & nFormatTo))
 		{
@@ -1222,6 +1234,7 @@ namespace NExtractTools
 	}
 	_UINT32 fromPpttBin(const std::wstring& sFrom, const std::wstring& sTo, int nFormatTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("fromPpttBin");
 		_UINT32 nRes = 0;
 		if (AVS_OFFICESTUDIO_FILE_TEAMLAB_PPTY == nFormatTo)
 		{
@@ -1274,6 +1287,7 @@ namespace NExtractTools
 	}
 	_UINT32 fromPresentation(const std::wstring& sFrom, int nFormatFrom, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("fromPresentation");
 		std::wstring sTo	= *params.m_sFileTo;
 
 		int nFormatTo = AVS_OFFICESTUDIO_FILE_UNKNOWN;
@@ -1390,6 +1404,7 @@ namespace NExtractTools
 	// from T
 	_UINT32 fromT(const std::wstring& sFrom, int nFormatFrom, const std::wstring& sTo, int nFormatTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("fromT");
 		_UINT32 nRes = 0;
 		if (0 != (AVS_OFFICESTUDIO_FILE_CANVAS & nFormatTo))
 		{
@@ -1420,6 +1435,7 @@ namespace NExtractTools
 	// draw
 	_UINT32 fromVsdxDir(const std::wstring& sFrom, const std::wstring& sTo, int nFormatTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("fromVsdxDir");
 		_UINT32 nRes = 0;
 		if (0 != (AVS_OFFICESTUDIO_FILE_DRAW & nFormatTo))
 		{
@@ -1488,6 +1504,7 @@ namespace NExtractTools
 	}
 	_UINT32 fromVsdtBin(const std::wstring& sFrom, const std::wstring& sTo, int nFormatTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("fromVsdtBin");
 		_UINT32 nRes = 0;
 		if (AVS_OFFICESTUDIO_FILE_TEAMLAB_VSDY == nFormatTo)
 		{
@@ -1540,6 +1557,7 @@ namespace NExtractTools
 
 	_UINT32 fromDraw(const std::wstring& sFrom, int nFormatFrom, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("fromDraw");
 		std::wstring sTo	= *params.m_sFileTo;
 		int nFormatTo = AVS_OFFICESTUDIO_FILE_UNKNOWN;
 		if (NULL != params.m_nFormatTo)
@@ -1649,14 +1667,20 @@ namespace NExtractTools
 				NSFile::CFileBinary::SetTempPath(sGlobalTempDir);
 			return AVS_FILEUTILS_ERROR_CONVERT_LIMITS;
 		}
+		NSProfiler::CSession oProfileSession(oInputParams.hasProfile(), oInputParams.getProfileFile(), oInputParams.getProfileTraceFile());
+
 		_CP_LOG << L"doct initialize" << std::endl;
 
 #ifndef BUILD_X2T_AS_LIBRARY_DYLIB
-		NSDoctRenderer::CDocBuilder::Initialize();
+		{
+			X2T_PROFILE_SCOPE("initialize");
+			NSDoctRenderer::CDocBuilder::Initialize();
+		}
 #endif
 
 		_CP_LOG << L"start conversion" << std::endl;
 		_UINT32 result = 0;
+		NSProfiler::CScope oConvertScope("convert");
 		switch (conversion)
 		{
 		case TCD_NON_AUTO:
@@ -2304,11 +2328,14 @@ namespace NExtractTools
 			result = AVS_FILEUTILS_ERROR_CONVERT_PARAMS;
 		}break;
 		}
+		oConvertScope.End();
 
 		// delete temp dir
-		if (!bExternalTempDir)
 		{
-			NSDirectory::DeleteDirectory(oConvertParams.m_sTempDir);
+			X2T_PROFILE_SCOPE("cleanup");
+			removeIntermediateDirs(oConvertParams);
+			if (!bExternalTempDir)
+				NSDirectory::DeleteDirectory(oConvertParams.m_sTempDir);
 		}
 
 		if (!sGlobalTempDir.empty())
@@ -2317,7 +2344,10 @@ namespace NExtractTools
 		_CP_LOG << L"end conversion and start dispose doctrenderer" << std::endl;
 		// clean up v8
 #ifndef BUILD_X2T_AS_LIBRARY_DYLIB
-		NSDoctRenderer::CDocBuilder::Dispose();
+		{
+			X2T_PROFILE_SCOPE("dispose");
+			NSDoctRenderer::CDocBuilder::Dispose();
+		}
 #endif
 		_CP_LOG << L"finish" << std::endl;
 
@@ -33,6 +33,7 @@
 #include "../../DesktopEditor/common/StringBuilder.h"
 #include "../../OfficeUtils/src/OfficeUtils.h"
 #include "cextracttools.h"
+#include "profiler.h"
 
 namespace NExtractTools
 {
@@ -852,6 +853,7 @@ namespace NExtractTools
 		std::wstring& sBinTo,
 		const InputParams& params, const ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("apply_changes");
 		std::wstring sBinDir = NSDirectory::GetFolderPath(sBinFrom);
 		std::wstring sChangesDir = sBinDir + FILE_SEPARATOR_STR + L"changes";
 		if (NSDirectory::Exists(sChangesDir))
@@ -867,7 +869,10 @@ namespace NExtractTools
 			{
 				std::wstring sXml = getDoctXml(eType, eType, sBinFrom, sBinTo, sImagesDirectory, convertParams.m_sThemesDir, nChangeIndex, L"", params);
 				std::wstring sResult;
-				oDoctRenderer.Execute(sXml, sResult);
+				{
+					X2T_PROFILE_SCOPE("doctrenderer");
+					oDoctRenderer.Execute(sXml, sResult);
+				}
 				bool bContinue = false;
 				if (!sResult.empty() && -1 != sResult.find(L"error"))
 				{
@@ -488,6 +488,9 @@ namespace NExtractTools
 
 		std::wstring m_sPdfOformMetaName;
 		std::wstring m_sPdfOformMetaData;
+
+		// intermediate packages placed into the intermediate temp dir (see createIntermediateDir)
+		std::vector<std::wstring> m_arIntermediateTempDirs;
 	};
 
 	class InputParams
@@ -523,6 +526,9 @@ namespace NExtractTools
 		boost::unordered_map<int, std::vector<InputLimit>> m_mapInputLimits;
 		bool* m_bIsPDFA;
 		std::wstring* m_sConvertToOrigin;
+		std::wstring* m_sProfileFile;
+		std::wstring* m_sProfileTraceFile;
+		std::wstring* m_sIntermediateTempDir;
 		// output params
 		mutable bool m_bOutputConvertCorrupted;
 		mutable bool m_bMacro;
@@ -559,6 +565,9 @@ namespace NExtractTools
 			m_bIsNoBase64 = NULL;
 			m_bIsPDFA = NULL;
 			m_sConvertToOrigin = NULL;
+			m_sProfileFile = NULL;
+			m_sProfileTraceFile = NULL;
+			m_sIntermediateTempDir = NULL;
 
 			m_bOutputConvertCorrupted = false;
 			m_bMacro = false;
@@ -594,6 +603,9 @@ namespace NExtractTools
 			RELEASEOBJECT(m_bIsNoBase64);
 			RELEASEOBJECT(m_bIsPDFA);
 			RELEASEOBJECT(m_sConvertToOrigin);
+			RELEASEOBJECT(m_sProfileFile);
+			RELEASEOBJECT(m_sProfileTraceFile);
+			RELEASEOBJECT(m_sIntermediateTempDir);
 		}
 
 		bool FromXmlFile(const std::wstring& sFilename)
@@ -792,6 +804,21 @@ namespace NExtractTools
 									RELEASEOBJECT(m_sConvertToOrigin);
 									m_sConvertToOrigin = new std::wstring(sValue);
 								}
+								else if (_T("m_sProfileFile") == sName)
+								{
+									RELEASEOBJECT(m_sProfileFile);
+									m_sProfileFile = new std::wstring(sValue);
+								}
+								else if (_T("m_sProfileTraceFile") == sName)
+								{
+									RELEASEOBJECT(m_sProfileTraceFile);
+									m_sProfileTraceFile = new std::wstring(sValue);
+								}
+								else if (_T("m_sIntermediateTempDir") == sName)
+								{
+									RELEASEOBJECT(m_sIntermediateTempDir);
+									m_sIntermediateTempDir = new std::wstring(sValue);
+								}
 							}
 							else if (_T("m_nCsvDelimiterChar") == sName)
 							{
@@ -876,10 +903,34 @@ namespace NExtractTools
 		{
 			return (NULL != m_bIsPDFA) ? (*m_bIsPDFA) : false;
 		}
+		// image of the first page only - converters may skip everything that is not on it
+		bool getIsThumbnailFirstPage() const
+		{
+			if (NULL == m_oThumbnail || NULL == m_nFormatTo || 0 == (AVS_OFFICESTUDIO_FILE_IMAGE & *m_nFormatTo))
+				return false;
+			return NULL == m_oThumbnail->first || true == *m_oThumbnail->first;
+		}
 		std::wstring getConvertToOrigin() const
 		{
 			return (NULL != m_sConvertToOrigin) ? (*m_sConvertToOrigin) : L"";
 		}
+		bool hasProfile() const
+		{
+			return NULL != m_sProfileFile || NULL != m_sProfileTraceFile;
+		}
+		std::wstring getProfileFile() const
+		{
+			return (NULL != m_sProfileFile) ? (*m_sProfileFile) : L"";
+		}
+		std::wstring getProfileTraceFile() const
+		{
+			return (NULL != m_sProfileTraceFile) ? (*m_sProfileTraceFile) : L"";
+		}
+		// directory for intermediate ooxml packages of chained conversions (e.g. tmpfs /dev/shm), empty - temp dir (default)
+		std::wstring getIntermediateTempDir() const
+		{
+			return (NULL != m_sIntermediateTempDir) ? (*m_sIntermediateTempDir) : L"";
+		}
 		bool needConvertToOrigin(long nFormatFrom) const
 		{
 			COfficeFileFormatChecker FileFormatChecker;
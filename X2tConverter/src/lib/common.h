@@ -33,17 +33,23 @@
 
 #include "../ASCConverters.h"
 #include "../cextracttools.h"
+#include "../profiler.h"
 
 #include "../../../DesktopEditor/common/Directory.h"
 #include "../../../OfficeUtils/src/OfficeUtils.h"
 
 #include "../../../DesktopEditor/graphics/pro/Fonts.h"
 
+#if defined(_LINUX) && !defined(_MAC)
+#include <sys/statvfs.h>
+#endif
+
 namespace NExtractTools
 {
 	// COMMON FUNCTIONS
 	NSFonts::IApplicationFonts* createApplicationFonts(InputParams& params)
 	{
+		X2T_PROFILE_SCOPE("fonts");
 		NSFonts::IApplicationFonts* pFonts = NSFonts::NSApplication::Create();
 
 		std::wstring sFontPath = params.getFontPath();
@@ -73,6 +79,101 @@ namespace NExtractTools
 		return sDir + FILE_SEPARATOR_STR + sName;
 	}
 
+	unsigned long long getDirectorySize(const std::wstring& sDir)
+	{
+		unsigned long long nSize = 0;
+		std::vector<std::wstring> arFiles = NSDirectory::GetFiles(sDir, true);
+		for (const std::wstring& sFile : arFiles)
+		{
+			NSFile::CFileBinary oFile;
+			if (oFile.OpenFile(sFile))
+			{
+				nSize += oFile.GetFileSize();
+				oFile.CloseFile();
+			}
+		}
+		return nSize;
+	}
+
+	unsigned long long getFreeSpace(const std::wstring& sDir)
+	{
+#if defined(_LINUX) && !defined(_MAC)
+		struct statvfs oStat;
+		if (0 == statvfs(U_TO_UTF8(sDir).c_str(), &oStat))
+			return (unsigned long long)oStat.f_bavail * oStat.f_frsize;
+#endif
+		return 0;
+	}
+
+	// Directory for the intermediate ooxml package of chained conversions (odf, doc, xls, rtf -> ooxml -> editor bin).
+	// The package is still written to files and parsed back. If m_sIntermediateTempDir is given (e.g. a tmpfs mount)
+	// and has room for it, the package is placed there, otherwise into the temp dir.
+	std::wstring createIntermediateDir(const std::wstring& sFrom, const std::wstring& sName, InputParams& params, ConvertParams& convertParams)
+	{
+		std::wstring sIntermediateTempDir = params.getIntermediateTempDir();
+		if (!sIntermediateTempDir.empty() && NSDirectory::Exists(sIntermediateTempDir))
+		{
+			unsigned long long nSourceSize = 0;
+			NSFile::CFileBinary oFile;
+			if (oFile.OpenFile(sFrom))
+			{
+				nSourceSize = oFile.GetFileSize();
+				oFile.CloseFile();
+			}
+
+			// unpacked ooxml is several times larger than the source, keep a reserve for the rest of the system
+			const unsigned long long nReserve = 256 * 1024 * 1024;
+			if (getFreeSpace(sIntermediateTempDir) > 10 * nSourceSize + nReserve)
+			{
+				std::wstring sIntermediateDir = NSDirectory::CreateDirectoryWithUniqueName(sIntermediateTempDir);
+				if (!sIntermediateDir.empty())
+				{
+					convertParams.m_arIntermediateTempDirs.push_back(sIntermediateDir);
+
+					std::wstring sDir = combinePath(sIntermediateDir, sName);
+					NSDirectory::CreateDirectory(sDir);
+					return sDir;
+				}
+			}
+		}
+
+		std::wstring sDir = combinePath(convertParams.m_sTempDir, sName);
+		NSDirectory::CreateDirectory(sDir);
+		return sDir;
+	}
+	// frees the intermediate temp dir (tmpfs space) as soon as the package is consumed
+	void releaseIntermediateDir(const std::wstring& sDir, ConvertParams& convertParams)
+	{
+		bool bIsIntermediateTempDir = false;
+		std::wstring sParentDir = NSDirectory::GetFolderPath(sDir);
+		for (std::vector<std::wstring>::iterator iter = convertParams.m_arIntermediateTempDirs.begin(); iter != convertParams.m_arIntermediateTempDirs.end(); ++iter)
+		{
+			if (*iter == sParentDir)
+			{
+				bIsIntermediateTempDir = true;
+				convertParams.m_arIntermediateTempDirs.erase(iter);
+				break;
+			}
+		}
+
+		if (NSProfiler::IsEnabled())
+		{
+			unsigned long long nSize = getDirectorySize(sDir);
+			X2T_PROFILE_COUNTER("intermediate.bytes", (long long)nSize);
+			if (bIsIntermediateTempDir)
+				X2T_PROFILE_COUNTER("intermediate.tmpfsBytes", (long long)nSize);
+		}
+
+		if (bIsIntermediateTempDir)
+			NSDirectory::DeleteDirectory(sParentDir);
+	}
+	void removeIntermediateDirs(ConvertParams& convertParams)
+	{
+		for (const std::wstring& sDir : convertParams.m_arIntermediateTempDirs)
+			NSDirectory::DeleteDirectory(sDir);
+		convertParams.m_arIntermediateTempDirs.clear();
+	}
+
 	_UINT32 processEncryptionError(_UINT32 hRes, const std::wstring& sFrom, InputParams& params)
 	{
 		if (AVS_ERROR_DRM == hRes)
@@ -157,11 +258,15 @@ namespace NExtractTools
 	// zip methods
 	_UINT32 dir2zip(const std::wstring& sFrom, const std::wstring& sTo, bool bSorted, int method, short level, bool bDateTime)
 	{
+		X2T_PROFILE_SCOPE("zip");
+		X2T_PROFILE_COUNTER("zip.archives", 1);
 		COfficeUtils oCOfficeUtils(NULL);
 		return (S_OK == oCOfficeUtils.CompressFileOrDirectory(sFrom, sTo, bSorted, method, level, bDateTime)) ? 0 : AVS_FILEUTILS_ERROR_CONVERT;
 	}
 	_UINT32 zip2dir(const std::wstring& sFrom, const std::wstring& sTo)
 	{
+		X2T_PROFILE_SCOPE("unzip");
+		X2T_PROFILE_COUNTER("unzip.archives", 1);
 		COfficeUtils oCOfficeUtils(NULL);
 		return (S_OK == oCOfficeUtils.ExtractToDirectory(sFrom, sTo, NULL, 0)) ? 0 : AVS_FILEUTILS_ERROR_CONVERT;
 	}
@@ -226,8 +331,7 @@ namespace NExtractTools
 
 			if (SUCCEEDED_X2T(nRes))
 			{
-				COfficeUtils oCOfficeUtils(NULL);
-				nRes = (S_OK == oCOfficeUtils.CompressFileOrDirectory(sOOTDir, sTo)) ? nRes : AVS_FILEUTILS_ERROR_CONVERT;
+				nRes = (0 == dir2zip(sOOTDir, sTo)) ? nRes : AVS_FILEUTILS_ERROR_CONVERT;
 			}
 
 			return nRes;
@@ -245,8 +349,7 @@ namespace NExtractTools
 			NSDirectory::CreateDirectory(sOOTDir);
 
 			// unzip doct to folder
-			COfficeUtils oCOfficeUtils(NULL);
-			if (S_OK != oCOfficeUtils.ExtractToDirectory(sFrom, sOOTDir, NULL, 0))
+			if (0 != zip2dir(sFrom, sOOTDir))
 				return AVS_FILEUTILS_ERROR_CONVERT;
 
 			return func(sOOTFileEditor, sTo, params, convertParams);
@@ -267,8 +370,7 @@ namespace NExtractTools
 			_UINT32 nRes = func(sFrom, sUnpackedResult, params, convertParams);
 			if (SUCCEEDED_X2T(nRes))
 			{
-				COfficeUtils oCOfficeUtils(NULL);
-				nRes = (S_OK == oCOfficeUtils.CompressFileOrDirectory(sUnpackedResult, sTo, true)) ? 0 : AVS_FILEUTILS_ERROR_CONVERT;
+				nRes = dir2zip(sUnpackedResult, sTo, true);
 			}
 			return nRes;
 		}
@@ -277,8 +379,7 @@ namespace NExtractTools
 		_UINT32 ooxml2ooxml_replace_content_type(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams,
 												 const std::wstring& sSourceCT, const std::wstring& sDestCT)
 		{
-			COfficeUtils oCOfficeUtils(NULL);
-			if (S_OK == oCOfficeUtils.ExtractToDirectory(sFrom, sTo, NULL, 0))
+			if (0 == zip2dir(sFrom, sTo))
 			{
 				std::wstring sContentTypesPath = combinePath(sTo, L"[Content_Types].xml");
 				if (NSFile::CFileBinary::Exists(sContentTypesPath))
@@ -426,8 +527,7 @@ namespace NExtractTools
 		_UINT32 ooxmlm2ooml_dir(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams,
 								const OOXML_DOCUMENT_TYPE& type, const OOXML_DOCUMENT_SUBTYPE& documentType)
 		{
-			COfficeUtils oCOfficeUtils(NULL);
-			if (S_OK == oCOfficeUtils.ExtractToDirectory(sFrom, sTo, NULL, 0))
+			if (0 == zip2dir(sFrom, sTo))
 			{
 				return ooxmlm_dir2ooxml_dir(sFrom, sTo, params, convertParams, type, documentType);
 			}
@@ -455,8 +555,7 @@ namespace NExtractTools
 				}
 				else
 				{
-					COfficeUtils oCOfficeUtils(NULL);
-					hRes = (S_OK == oCOfficeUtils.CompressFileOrDirectory(sOOXMLDir, sTo, false)) ? 0 : AVS_FILEUTILS_ERROR_CONVERT;
+					hRes = dir2zip(sOOXMLDir, sTo, false);
 				}
 			}
 			else if (AVS_ERROR_DRM == hRes)
@@ -484,8 +583,7 @@ namespace NExtractTools
 			std::wstring sOOXMLDir = combinePath(convertParams.m_sTempDir, prefix + L"_unpacked");
 			NSDirectory::CreateDirectory(sOOXMLDir);
 
-			COfficeUtils oCOfficeUtils(NULL);
-			if (S_OK == oCOfficeUtils.ExtractToDirectory(sFrom, sOOXMLDir, NULL, 0))
+			if (0 == zip2dir(sFrom, sOOXMLDir))
 			{
 				return func_dir2format(sOOXMLDir, sTo, params, convertParams);
 			}
@@ -45,14 +45,14 @@ namespace NExtractTools
 		_UINT32 nRes = mscrypt2oot_bin(sFrom, sResultOotFileEditor, params, convertParams);
 		if (SUCCEEDED_X2T(nRes))
 		{
-			COfficeUtils oCOfficeUtils(NULL);
-			nRes = (S_OK == oCOfficeUtils.CompressFileOrDirectory(sResultOotDir, sTo)) ? nRes : AVS_FILEUTILS_ERROR_CONVERT;
+			nRes = (0 == dir2zip(sResultOotDir, sTo)) ? nRes : AVS_FILEUTILS_ERROR_CONVERT;
 		}
 
 		return nRes;
 	}
 	_UINT32 mscrypt2oot_bin(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("mscrypt2oot_bin");
 		//decrypt to temp file
 		std::wstring password = params.getPassword();
 		std::wstring sResultDecryptFile = combinePath(convertParams.m_sTempDir, L"uncrypt_file.oox");
@@ -133,16 +133,19 @@ namespace NExtractTools
 	}
 	_UINT32 mitcrypt2oox(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("mitcrypt2oox");
 		// todo
 		return AVS_FILEUTILS_ERROR_CONVERT_DRM_UNSUPPORTED;
 	}
 	_UINT32 mitcrypt2oot_bin(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("mitcrypt2oot_bin");
 		// todo
 		return AVS_FILEUTILS_ERROR_CONVERT_DRM_UNSUPPORTED;
 	}
 	_UINT32 mscrypt2oox(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("mscrypt2oox");
 		std::wstring password = params.getPassword();
 
 		ECMACryptFile cryptReader;
@@ -165,6 +168,7 @@ namespace NExtractTools
 	}
 	_UINT32 oox2mscrypt(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("oox2mscrypt");
 		std::wstring password = params.getSavePassword();
 		std::wstring documentID = params.getDocumentID();
 
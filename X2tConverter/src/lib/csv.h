@@ -41,6 +41,7 @@ namespace NExtractTools
 {
 	_UINT32 csv2xlsx_dir(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("csv2xlsx_dir");
 		params.m_bMacro = false;
 
 		OOX::Spreadsheet::CXlsx oXlsx;
@@ -69,6 +70,7 @@ namespace NExtractTools
 	}
 	_UINT32 xlsx_dir2csv(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("xlsx_dir2csv");
 		std::wstring sResultXlstDir   = combinePath(convertParams.m_sTempDir, L"xlst_unpacked");
 		std::wstring sResultXlstFileEditor = combinePath(sResultXlstDir, L"Editor.bin");
 
@@ -100,6 +102,7 @@ namespace NExtractTools
 
 	_UINT32 csv2xlst_bin(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("csv2xlst_bin");
 		params.m_bMacro = false;
 
 		// Save to file (from temp dir)
@@ -117,6 +120,7 @@ namespace NExtractTools
 	}
 	_UINT32 xlst_bin2csv(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("xlst_bin2csv");
 		_UINT32 nRes = 0;
 
 		std::wstring sTargetBin;
@@ -174,8 +178,7 @@ namespace NExtractTools
 		NSDirectory::CreateDirectory(sTempUnpackedXLST);
 
 		// unzip xlst to folder
-		COfficeUtils oCOfficeUtils(NULL);
-		if (S_OK != oCOfficeUtils.ExtractToDirectory(sFrom, sTempUnpackedXLST, NULL, 0))
+		if (0 != zip2dir(sFrom, sTempUnpackedXLST))
 			return AVS_FILEUTILS_ERROR_CONVERT;
 
 		BinXlsxRW::CXlsxSerializer oCXlsxSerializer;
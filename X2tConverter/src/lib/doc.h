@@ -43,6 +43,7 @@ namespace NExtractTools
 {
 	_UINT32 doc2docx_dir(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("doc2docx_dir");
 		COfficeDocFile docFile;
 
 		docFile.m_sTempFolder = convertParams.m_sTempDir;
@@ -67,13 +68,14 @@ namespace NExtractTools
 	}
 	_UINT32 docx_dir2doc(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("docx_dir2doc");
 		return AVS_FILEUTILS_ERROR_CONVERT;
 	}
 
 	_UINT32 doc2doct_bin(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
-		std::wstring sResultDocxDir = combinePath(convertParams.m_sTempDir, L"docx_unpacked");
-		NSDirectory::CreateDirectory(sResultDocxDir);
+		X2T_PROFILE_SCOPE("doc2doct_bin");
+		std::wstring sResultDocxDir = createIntermediateDir(sFrom, L"docx_unpacked", params, convertParams);
 
 		COfficeDocFile docFile;
 		docFile.m_sTempFolder = convertParams.m_sTempDir;
@@ -81,11 +83,16 @@ namespace NExtractTools
 
 		params.m_bMacro = true;
 
-		_UINT32 nRes = docFile.LoadFromFile(sFrom, sResultDocxDir, params.getPassword(), params.m_bMacro);
+		_UINT32 nRes = 0;
+		{
+			X2T_PROFILE_SCOPE("to_oox");
+			nRes = docFile.LoadFromFile(sFrom, sResultDocxDir, params.getPassword(), params.m_bMacro);
+		}
 
 		nRes = processEncryptionError(nRes, sFrom, params);
 		if (SUCCEEDED_X2T(nRes))
 		{
+			X2T_PROFILE_SCOPE("oox_to_bin");
 			BinDocxRW::CDocxSerializer m_oCDocxSerializer;
 
 			m_oCDocxSerializer.setFontDir(params.getFontPath());
@@ -94,11 +101,13 @@ namespace NExtractTools
 
 			nRes =  m_oCDocxSerializer.saveToFile (sTo, sResultDocxDir, xml_options, convertParams.m_sTempDir) ? 0 : AVS_FILEUTILS_ERROR_CONVERT;
 		}
+		releaseIntermediateDir(sResultDocxDir, convertParams);
 		return nRes;
 	}
 
 	_UINT32 doc2docm_dir(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("doc2docm_dir");
 		COfficeDocFile docFile;
 		docFile.m_sTempFolder = convertParams.m_sTempDir;
 		docFile.m_nUserLCID = (NULL != params.m_nLcid) ? *params.m_nLcid : -1;
@@ -42,8 +42,7 @@ namespace NExtractTools
 		std::wstring sTempUnpackedDOCX = combinePath(convertParams.m_sTempDir, L"docx_unpacked");
 		NSDirectory::CreateDirectory(sTempUnpackedDOCX);
 
-		COfficeUtils oCOfficeUtils(NULL);
-		if (S_OK != oCOfficeUtils.ExtractToDirectory(sFrom, sTempUnpackedDOCX, NULL, 0))
+		if (0 != zip2dir(sFrom, sTempUnpackedDOCX))
 		{
 			// check crypt
 			COfficeFileFormatChecker OfficeFileFormatChecker;
@@ -71,6 +70,7 @@ namespace NExtractTools
 	}
 	_UINT32 docx_dir2doct_bin(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("docx_dir2doct_bin");
 		_UINT32 nRes = S_OK;
 		if (params.needConvertToOrigin(AVS_OFFICESTUDIO_FILE_DOCUMENT_DOCX) && !convertParams.m_sTempParamOOXMLFile.empty())
 		{
@@ -84,6 +84,7 @@ namespace NExtractTools
 
 			m_oCDocxSerializer.setIsNoBase64(params.getIsNoBase64());
 			m_oCDocxSerializer.setFontDir(params.getFontPath());
+			m_oCDocxSerializer.setIsThumbnail(params.getIsThumbnailFirstPage());
 
 			// bool bRes = m_oCDocxSerializer.saveToFile (sResDoct, sSrcDocx, sTemp);
 			nRes = m_oCDocxSerializer.saveToFile(sTo, sFrom, params.getXmlOptions(), convertParams.m_sTempDir) ? 0 : AVS_FILEUTILS_ERROR_CONVERT;
@@ -150,6 +151,7 @@ namespace NExtractTools
 	}
 	_UINT32 doct_bin2docx_dir(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("doct_bin2docx_dir");
 		_UINT32 nRes = 0;
 		std::wstring sTargetBin;
 		if (params.getFromChanges())
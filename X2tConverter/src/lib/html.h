@@ -80,6 +80,7 @@ namespace NExtractTools
 	}
 	_UINT32 html_array2docx_dir(const std::vector<std::wstring> &arFiles, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("html_array2docx_dir");
 		params.m_bMacro = false;
 
 		CHtmlFile2 oFile;
@@ -153,6 +154,7 @@ namespace NExtractTools
 	// doct_bin => html
 	_UINT32 doct_bin2html_internal(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("doct_bin2html_internal");
 		_UINT32 nRes = 0;
 		if (params.getFromChanges())
 			params.setFromChanges(false);
@@ -169,7 +171,10 @@ namespace NExtractTools
 									   sFrom, sHtmlFile, sImagesDirectory, convertParams.m_sThemesDir, -1, L"", params);
 
 		std::wstring sResult;
-		oDoctRenderer.Execute(sXml, sResult);
+		{
+			X2T_PROFILE_SCOPE("doctrenderer");
+			oDoctRenderer.Execute(sXml, sResult);
+		}
 		
 		if (sResult.find(L"error") != std::wstring::npos)
 		{
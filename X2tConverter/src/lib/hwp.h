@@ -9,6 +9,7 @@ namespace NExtractTools
 	template <typename OpenMethod>
 	_UINT32 hwp_file2docx(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams, OpenMethod openMethod, bool bConvertToDir)
 	{
+		X2T_PROFILE_SCOPE("hwp_file2docx");
 		CHWPFile oFile;
 
 		oFile.SetTempDirectory(convertParams.m_sTempDir);
@@ -38,6 +38,7 @@ namespace NExtractTools
 {
 	_UINT32 iworkformat2odf(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams, IWorkFileType eVerificationType)
 	{
+		X2T_PROFILE_SCOPE("iworkformat2odf");
 		CIWorkFile oFile;
 		oFile.SetTmpDirectory(convertParams.m_sTempDir);
 
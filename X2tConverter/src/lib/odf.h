@@ -59,13 +59,13 @@ namespace NExtractTools
 	}
 	_UINT32 odf2oox_dir(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("odf2oox_dir");
 		_UINT32 nRes = 0;
 
 		std::wstring sTempUnpackedOdf = combinePath(convertParams.m_sTempDir, L"odf_unpacked");
 		NSDirectory::CreateDirectory(sTempUnpackedOdf);
 
-		COfficeUtils oCOfficeUtils(NULL);
-		if (S_OK == oCOfficeUtils.ExtractToDirectory(sFrom, sTempUnpackedOdf, NULL, 0))
+		if (0 == zip2dir(sFrom, sTempUnpackedOdf))
 		{
 			nRes = ConvertODF2OOXml(sTempUnpackedOdf, sTo, params.getFontPath(), convertParams.m_sTempDir, params.getPassword());
 
@@ -84,25 +84,28 @@ namespace NExtractTools
 	}
 	_UINT32 odf2oot_bin(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("odf2oot_bin");
 		std::wstring sTempUnpackedOdf = combinePath(convertParams.m_sTempDir, L"odf_unpacked");
-		std::wstring sTempUnpackedOox = combinePath(convertParams.m_sTempDir, L"oox_unpacked");
 
 		NSDirectory::CreateDirectory(sTempUnpackedOdf);
 
 		_UINT32 nRes = 0;
 
-		COfficeUtils oCOfficeUtils(NULL);
-		if (S_OK == oCOfficeUtils.ExtractToDirectory(sFrom, sTempUnpackedOdf, NULL, 0))
+		if (0 == zip2dir(sFrom, sTempUnpackedOdf))
 		{
-			NSDirectory::CreateDirectory(sTempUnpackedOox);
+			std::wstring sTempUnpackedOox = createIntermediateDir(sFrom, L"oox_unpacked", params, convertParams);
 
-			nRes = ConvertODF2OOXml(sTempUnpackedOdf, sTempUnpackedOox, params.getFontPath(), convertParams.m_sTempDir, params.getPassword());
+			{
+				X2T_PROFILE_SCOPE("to_oox");
+				nRes = ConvertODF2OOXml(sTempUnpackedOdf, sTempUnpackedOox, params.getFontPath(), convertParams.m_sTempDir, params.getPassword());
+			}
 			
 			params.m_bMacro = false; // todooo ������� ��������� �������� odf
 			
 			nRes = processEncryptionError(nRes, sFrom, params);
 			if (SUCCEEDED_X2T(nRes))
 			{
+				X2T_PROFILE_SCOPE("oox_to_bin");
 				COfficeFileFormatChecker OfficeFileFormatChecker;
 
 				if (OfficeFileFormatChecker.isOOXFormatFile(sTempUnpackedOox, true))
@@ -116,7 +119,7 @@ namespace NExtractTools
 					case AVS_OFFICESTUDIO_FILE_DOCUMENT_OFORM:
 					case AVS_OFFICESTUDIO_FILE_DOCUMENT_DOCXF:
 					{
-						return docx_dir2doct_bin(sTempUnpackedOox, sTo, params, convertParams);
+						nRes = docx_dir2doct_bin(sTempUnpackedOox, sTo, params, convertParams);
 					}
 					break;
 					case AVS_OFFICESTUDIO_FILE_SPREADSHEET_XLSX:
@@ -127,7 +130,7 @@ namespace NExtractTools
 					{
 						const std::wstring &sXmlOptions = params.getXmlOptions();
 						convertParams.m_bTempIsXmlOptions = false;
-						return xlsx_dir2xlst_bin(sTempUnpackedOox, sTo, params, convertParams);
+						nRes = xlsx_dir2xlst_bin(sTempUnpackedOox, sTo, params, convertParams);
 					}
 					break;
 					case AVS_OFFICESTUDIO_FILE_PRESENTATION_PPTX:
@@ -137,7 +140,7 @@ namespace NExtractTools
 					case AVS_OFFICESTUDIO_FILE_PRESENTATION_POTM:
 					case AVS_OFFICESTUDIO_FILE_PRESENTATION_PPSM:
 					{
-						return pptx_dir2pptt_bin(sTempUnpackedOox, sTo, params, convertParams);
+						nRes = pptx_dir2pptt_bin(sTempUnpackedOox, sTo, params, convertParams);
 					}
 					break;
 					default:
@@ -148,6 +151,7 @@ namespace NExtractTools
 					}
 				}
 			}
+			releaseIntermediateDir(sTempUnpackedOox, convertParams);
 		}
 		else
 		{
@@ -164,6 +168,7 @@ namespace NExtractTools
 	}
 	_UINT32 odf_flat2oox_dir(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("odf_flat2oox_dir");
 		_UINT32 nRes = ConvertODF2OOXml(sFrom, sTo, params.getFontPath(), convertParams.m_sTempDir, params.getPassword());
 		params.m_bMacro = false; // todooo ������� ��������� �������� odf
 		
@@ -176,21 +181,27 @@ namespace NExtractTools
 	}
 	_UINT32 odf_flat2oot_bin(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
-		std::wstring sTempUnpackedOox = combinePath(convertParams.m_sTempDir, L"oox_unpacked");
-		NSDirectory::CreateDirectory(sTempUnpackedOox);
+		X2T_PROFILE_SCOPE("odf_flat2oot_bin");
+		std::wstring sTempUnpackedOox = createIntermediateDir(sFrom, L"oox_unpacked", params, convertParams);
 
-		_UINT32 nRes = ConvertODF2OOXml(sFrom, sTempUnpackedOox, params.getFontPath(), convertParams.m_sTempDir, params.getPassword());
+		_UINT32 nRes = 0;
+		{
+			X2T_PROFILE_SCOPE("to_oox");
+			nRes = ConvertODF2OOXml(sFrom, sTempUnpackedOox, params.getFontPath(), convertParams.m_sTempDir, params.getPassword());
+		}
 		params.m_bMacro = false; // todooo ������� ��������� �������� odf
 
 		nRes = processEncryptionError(nRes, sFrom, params);
 		if (SUCCEEDED_X2T(nRes))
 		{
+			X2T_PROFILE_SCOPE("oox_to_bin");
 			BinDocxRW::CDocxSerializer m_oCDocxSerializer;
 
 			m_oCDocxSerializer.setFontDir(params.getFontPath());
 
 			nRes = m_oCDocxSerializer.saveToFile(sTo, sTempUnpackedOox, params.getXmlOptions(), convertParams.m_sTempDir) ? 0 : AVS_FILEUTILS_ERROR_CONVERT;
 		}
+		releaseIntermediateDir(sTempUnpackedOox, convertParams);
 
 		return nRes;
 	}
@@ -201,8 +212,7 @@ namespace NExtractTools
 		std::wstring sTempUnpackedDOCX = combinePath(convertParams.m_sTempDir, L"docx_unpacked");
 		NSDirectory::CreateDirectory(sTempUnpackedDOCX);
 
-		COfficeUtils oCOfficeUtils(NULL);
-		if (S_OK == oCOfficeUtils.ExtractToDirectory(sFrom, sTempUnpackedDOCX, NULL, 0))
+		if (0 == zip2dir(sFrom, sTempUnpackedDOCX))
 		{
 			convertParams.m_bIsTemplate = false;
 			return docx_dir2odt(sTempUnpackedDOCX, sTo, params, convertParams); // add Template ????
@@ -211,6 +221,7 @@ namespace NExtractTools
 	}
 	_UINT32 docx_dir2odt(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("docx_dir2odt");
 		std::wstring sTempUnpackedODT = combinePath(convertParams.m_sTempDir, L"odt_unpacked");
 		NSDirectory::CreateDirectory(sTempUnpackedODT);
 
@@ -225,8 +236,7 @@ namespace NExtractTools
 			converter.convert();
 			converter.write(sTempUnpackedODT, convertParams.m_sTempDir, password, documentID);
 
-			COfficeUtils oCOfficeUtils(NULL);
-			nRes = (S_OK == oCOfficeUtils.CompressFileOrDirectory(sTempUnpackedODT, sTo, false, password.empty() ? Z_DEFLATED : 0)) ? 0 : AVS_FILEUTILS_ERROR_CONVERT;
+			nRes = (0 == dir2zip(sTempUnpackedODT, sTo, false, password.empty() ? Z_DEFLATED : 0)) ? 0 : AVS_FILEUTILS_ERROR_CONVERT;
 		}
 		catch (...)
 		{
@@ -241,8 +251,7 @@ namespace NExtractTools
 		std::wstring sTempUnpackedXLSX = combinePath(convertParams.m_sTempDir, L"xlsx_unpacked");
 		NSDirectory::CreateDirectory(sTempUnpackedXLSX);
 
-		COfficeUtils oCOfficeUtils(NULL);
-		if (S_OK == oCOfficeUtils.ExtractToDirectory(sFrom, sTempUnpackedXLSX, NULL, 0))
+		if (0 == zip2dir(sFrom, sTempUnpackedXLSX))
 		{
 			convertParams.m_bIsTemplate = false;
 			return xlsx_dir2ods(sTempUnpackedXLSX, sTo, params, convertParams); // add Template ???
@@ -251,6 +260,7 @@ namespace NExtractTools
 	}
 	_UINT32 xlsx_dir2ods(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("xlsx_dir2ods");
 		std::wstring sTempUnpackedODS = combinePath(convertParams.m_sTempDir, L"ods_unpacked");
 		NSDirectory::CreateDirectory(sTempUnpackedODS);
 
@@ -264,8 +274,7 @@ namespace NExtractTools
 		converter.convert();
 		converter.write(sTempUnpackedODS, convertParams.m_sTempDir, password, documentID);
 
-		COfficeUtils oCOfficeUtils(NULL);
-		nRes = (S_OK == oCOfficeUtils.CompressFileOrDirectory(sTempUnpackedODS, sTo, false, password.empty() ? Z_DEFLATED : 0)) ? 0 : AVS_FILEUTILS_ERROR_CONVERT;
+		nRes = (0 == dir2zip(sTempUnpackedODS, sTo, false, password.empty() ? Z_DEFLATED : 0)) ? 0 : AVS_FILEUTILS_ERROR_CONVERT;
 
 		return nRes;
 	}
@@ -276,8 +285,7 @@ namespace NExtractTools
 		std::wstring sTempUnpackedPPTX = combinePath(convertParams.m_sTempDir, L"pptx_unpacked");
 		NSDirectory::CreateDirectory(sTempUnpackedPPTX);
 
-		COfficeUtils oCOfficeUtils(NULL);
-		if (S_OK == oCOfficeUtils.ExtractToDirectory(sFrom, sTempUnpackedPPTX, NULL, 0))
+		if (0 == zip2dir(sFrom, sTempUnpackedPPTX))
 		{
 			convertParams.m_bIsTemplate = false;
 			return pptx_dir2odp(sTempUnpackedPPTX, sTo, params, convertParams); // add template ???
@@ -287,6 +295,7 @@ namespace NExtractTools
 	// pptx_dir -> odp
 	_UINT32 pptx_dir2odp(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("pptx_dir2odp");
 		std::wstring sTempUnpackedODP = combinePath(convertParams.m_sTempDir, L"odp_unpacked");
 		NSDirectory::CreateDirectory(sTempUnpackedODP);
 
@@ -301,8 +310,7 @@ namespace NExtractTools
 			converter.convert();
 			converter.write(sTempUnpackedODP, convertParams.m_sTempDir, password, documentID);
 
-			COfficeUtils oCOfficeUtils(NULL);
-			nRes = (S_OK == oCOfficeUtils.CompressFileOrDirectory(sTempUnpackedODP, sTo, false, password.empty() ? Z_DEFLATED : 0)) ? 0 : AVS_FILEUTILS_ERROR_CONVERT;
+			nRes = (0 == dir2zip(sTempUnpackedODP, sTo, false, password.empty() ? Z_DEFLATED : 0)) ? 0 : AVS_FILEUTILS_ERROR_CONVERT;
 		}
 		catch (...)
 		{
@@ -316,15 +324,13 @@ namespace NExtractTools
 		std::wstring sTempUnpackedOdf = combinePath(convertParams.m_sTempDir, L"odf_unpacked");
 		NSDirectory::CreateDirectory(sTempUnpackedOdf);
 
-		COfficeUtils oCOfficeUtils(NULL);
-		if (S_OK != oCOfficeUtils.ExtractToDirectory(sFrom, sTempUnpackedOdf, NULL, 0))
+		if (0 != zip2dir(sFrom, sTempUnpackedOdf))
 			return AVS_FILEUTILS_ERROR_CONVERT;
 
 		_UINT32 nRes = ConvertOTF2ODF(sTempUnpackedOdf);
 		if (SUCCEEDED_X2T(nRes))
 		{
-			COfficeUtils oCOfficeUtils(NULL);
-			nRes = (S_OK == oCOfficeUtils.CompressFileOrDirectory(sTempUnpackedOdf, sTo, true)) ? nRes : AVS_FILEUTILS_ERROR_CONVERT;
+			nRes = (0 == dir2zip(sTempUnpackedOdf, sTo, true)) ? nRes : AVS_FILEUTILS_ERROR_CONVERT;
 		}
 		return nRes;
 	}
@@ -345,8 +351,7 @@ namespace NExtractTools
 			converter.convert();
 			converter.write(sTempUnpackedODT, convertParams.m_sTempDir, password, documentID);
 
-			COfficeUtils oCOfficeUtils(NULL);
-			nRes = (S_OK == oCOfficeUtils.CompressFileOrDirectory(sTempUnpackedODT, sTo, false, password.empty() ? Z_DEFLATED : 0)) ? 0 : AVS_FILEUTILS_ERROR_CONVERT;
+			nRes = (0 == dir2zip(sTempUnpackedODT, sTo, false, password.empty() ? Z_DEFLATED : 0)) ? 0 : AVS_FILEUTILS_ERROR_CONVERT;
 		}
 		catch (...)
 		{
@@ -48,6 +48,7 @@ namespace NExtractTools
 {
 	_UINT32 bin2pdf(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("bin2pdf");
 		NSFonts::IApplicationFonts* pApplicationFonts = createApplicationFonts(params);
 
 		CPdfFile pdfWriter(pApplicationFonts);
@@ -82,6 +83,7 @@ namespace NExtractTools
 
 	_UINT32 bin2image(unsigned char* pBuffer, long lBufferLen, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("bin2image");
 		NSFonts::IApplicationFonts* pApplicationFonts = createApplicationFonts(params);
 		NSOnlineOfficeBinToPdf::CMetafileToRenderterRaster imageWriter(NULL);
 
@@ -139,8 +141,7 @@ namespace NExtractTools
 		_UINT32 nRes = imageWriter.ConvertBuffer(pBuffer, lBufferLen) ? 0 : AVS_FILEUTILS_ERROR_CONVERT;
 		if (!sThumbnailDir.empty())
 		{
-			COfficeUtils oCOfficeUtils(NULL);
-			nRes = S_OK == oCOfficeUtils.CompressFileOrDirectory(sThumbnailDir, sTo) ? nRes : AVS_FILEUTILS_ERROR_CONVERT;
+			nRes = 0 == dir2zip(sThumbnailDir, sTo) ? nRes : AVS_FILEUTILS_ERROR_CONVERT;
 		}
 		RELEASEOBJECT(pApplicationFonts);
 		return nRes;
@@ -191,6 +192,7 @@ namespace NExtractTools
 	_UINT32 doct_bin2pdf(NSDoctRenderer::DoctRendererFormat::FormatFile eFromType,
 						 const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("doct_bin2pdf");
 		NSDoctRenderer::DoctRendererFormat::FormatFile eToType = NSDoctRenderer::DoctRendererFormat::FormatFile::PDF;
 
 		std::wstring sFileDir         = NSDirectory::GetFolderPath(sFrom);
@@ -200,7 +202,10 @@ namespace NExtractTools
 		NSDoctRenderer::CDoctrenderer oDoctRenderer(NULL != params.m_sAllFontsPath ? *params.m_sAllFontsPath : L"");
 		std::wstring sXml = getDoctXml(eFromType, eToType, sFrom, sPdfBinFile, sImagesDirectory, convertParams.m_sThemesDir, -1, L"", params);
 		std::wstring sResult;
-		oDoctRenderer.Execute(sXml, sResult);
+		{
+			X2T_PROFILE_SCOPE("doctrenderer");
+			oDoctRenderer.Execute(sXml, sResult);
+		}
 
 		_UINT32 nRes = 0;
 		if (sResult.find(L"error") != std::wstring::npos)
@@ -256,6 +261,7 @@ namespace NExtractTools
 	_UINT32 doct_bin2image(NSDoctRenderer::DoctRendererFormat::FormatFile eFromType,
 						   const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("doct_bin2image");
 		NSDoctRenderer::DoctRendererFormat::FormatFile eToType = NSDoctRenderer::DoctRendererFormat::FormatFile::IMAGE;
 
 		std::wstring sFileDir         = NSDirectory::GetFolderPath(sFrom);
@@ -265,7 +271,10 @@ namespace NExtractTools
 		NSDoctRenderer::CDoctrenderer oDoctRenderer(NULL != params.m_sAllFontsPath ? *params.m_sAllFontsPath : L"");
 		std::wstring sXml = getDoctXml(eFromType, eToType, sFrom, sPdfBinFile, sImagesDirectory, convertParams.m_sThemesDir, -1, L"", params);
 		std::wstring sResult;
-		oDoctRenderer.Execute(sXml, sResult);
+		{
+			X2T_PROFILE_SCOPE("doctrenderer");
+			oDoctRenderer.Execute(sXml, sResult);
+		}
 
 		_UINT32 nRes = 0;
 		if (-1 != sResult.find(_T("error")))
@@ -431,6 +440,7 @@ namespace NExtractTools
 								 const std::wstring& sTo, InputParams& params, ConvertParams& convertParams,
 								 NSFonts::IApplicationFonts* pApplicationFonts)
 	{
+		X2T_PROFILE_SCOPE("PdfDjvuXpsToRenderer");
 		_UINT32 nRes = 0;
 		IOfficeDrawingFile* pReader = createDrawingFile(pApplicationFonts, nFormatFrom);
 		if (!pReader)
@@ -504,6 +514,7 @@ namespace NExtractTools
 							  const std::wstring& sTo, InputParams& params, ConvertParams& convertParams,
 							  NSFonts::IApplicationFonts* pApplicationFonts)
 	{
+		X2T_PROFILE_SCOPE("PdfDjvuXpsToImage");
 		_UINT32 nRes = 0;
 		IOfficeDrawingFile* pReader = createDrawingFile(pApplicationFonts, nFormatFrom);
 		if (!pReader)
@@ -625,8 +636,7 @@ namespace NExtractTools
 			// zip
 			if (!bIsOnlyFirst && bIsZip)
 			{
-				COfficeUtils oCOfficeUtils(NULL);
-				nRes = S_OK == oCOfficeUtils.CompressFileOrDirectory(sThumbnailDir, sTo) ? nRes : AVS_FILEUTILS_ERROR_CONVERT;
+				nRes = 0 == dir2zip(sThumbnailDir, sTo) ? nRes : AVS_FILEUTILS_ERROR_CONVERT;
 			}
 		}
 		else
@@ -741,7 +751,10 @@ namespace NExtractTools
 
 				std::wstring sResult = L"";
 				oDoctRenderer.SetAdditionalParam(NSDoctRenderer::AdditionalParamType::DRAWINGFILE, (void*)&oPdfResult);
-				oDoctRenderer.Execute(sXml, sResult);
+				{
+					X2T_PROFILE_SCOPE("doctrenderer");
+					oDoctRenderer.Execute(sXml, sResult);
+				}
 
 				if (NSFile::CFileBinary::Exists(sPdfFileCompiledChanges))
 					bIsCompiledChanges = applyCompiledChangesPdf(&oPdfResult, sPdfFileCompiledChanges, oConvertParams, sTo);
@@ -800,6 +813,7 @@ namespace NExtractTools
 							  const std::wstring& sTo_, int nFormatTo,
 							  InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("fromCrossPlatform");
 		std::wstring sTo = sTo_;
 		_UINT32 nRes = 0;
 		NSFonts::IApplicationFonts *pApplicationFonts = createApplicationFonts(params);
@@ -930,7 +944,10 @@ namespace NExtractTools
 												   L"", sWatermarkTmp, L"", convertParams.m_sThemesDir, -1, L"", params);
 
 					std::wstring sResult = L"";
-					oDoctRenderer.Execute(sXml, sResult);
+					{
+						X2T_PROFILE_SCOPE("doctrenderer");
+						oDoctRenderer.Execute(sXml, sResult);
+					}
 
 					if (sResult.empty())
 					{
@@ -1117,6 +1134,7 @@ namespace NExtractTools
 						  const std::wstring& sTo, int nFormatTo,
 						  InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("fromCanvasPdf");
 		_UINT32 nRes = 0;
 		if (AVS_OFFICESTUDIO_FILE_CROSSPLATFORM_PDF == nFormatTo)
 		{
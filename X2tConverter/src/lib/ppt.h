@@ -39,6 +39,7 @@ namespace NExtractTools
 {
 	inline _UINT32 ppt2pptx_dir_macro(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams, const bool& bIsMacro)
 	{
+		X2T_PROFILE_SCOPE("ppt2pptx_dir_macro");
 		COfficePPTFile pptFile;
 		pptFile.put_TempDirectory(convertParams.m_sTempDir);
 
@@ -59,6 +60,7 @@ namespace NExtractTools
 
 	_UINT32 ppt2pptt_bin(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("ppt2pptt_bin");
 		// unzip pptx to temp folder
 		std::wstring sTempUnpackedPPTX = combinePath(convertParams.m_sTempDir, L"pptx_unpacked") + FILE_SEPARATOR_STR; // leading slash is very important!
 		NSDirectory::CreateDirectory(sTempUnpackedPPTX);
@@ -44,8 +44,7 @@ namespace NExtractTools
 		NSDirectory::CreateDirectory(sTempUnpackedPPTX);
 
 			   // unzip pptx to folder
-		COfficeUtils oCOfficeUtils(NULL);
-		if (S_OK != oCOfficeUtils.ExtractToDirectory(sFrom, sTempUnpackedPPTX, NULL, 0))
+		if (0 != zip2dir(sFrom, sTempUnpackedPPTX))
 		{
 			// check crypt
 			COfficeFileFormatChecker OfficeFileFormatChecker;
@@ -75,6 +74,7 @@ namespace NExtractTools
 	}
 	_UINT32 pptx_dir2pptt_bin(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("pptx_dir2pptt_bin");
 		_UINT32 nRes = 0;
 		std::wstring sToDir = NSDirectory::GetFolderPath(sTo);
 		if (params.needConvertToOrigin(AVS_OFFICESTUDIO_FILE_PRESENTATION_PPTX) && !convertParams.m_sTempParamOOXMLFile.empty())
@@ -91,6 +91,7 @@ namespace NExtractTools
 				pptx_file->SetIsNoBase64(params.getIsNoBase64());
 				pptx_file->put_TempDirectory(convertParams.m_sTempDir);
 				pptx_file->SetFontDir(params.getFontPath());
+				pptx_file->SetOnlyFirstSlide(params.getIsThumbnailFirstPage());
 				nRes = (S_OK == pptx_file->OpenFileToPPTY(sFrom, sTo)) ? nRes : AVS_FILEUTILS_ERROR_CONVERT;
 
 				delete pptx_file;
@@ -151,6 +152,7 @@ namespace NExtractTools
 	}
 	_UINT32 pptt_bin2pptx_dir(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("pptt_bin2pptx_dir");
 		_UINT32 nRes = 0;
 
 		std::wstring sTargetBin;
@@ -39,6 +39,7 @@ namespace NExtractTools
 {
 	_UINT32 rtf2docx_dir(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("rtf2docx_dir");
 		params.m_bMacro = false;
 		
 		RtfConvertationManager rtfConvert;
@@ -55,6 +56,7 @@ namespace NExtractTools
 	}
 	_UINT32 docx_dir2rtf(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("docx_dir2rtf");
 		// docx folder to rtf
 		RtfConvertationManager rtfConvert;
 		rtfConvert.m_sTempFolder = convertParams.m_sTempDir;
@@ -67,30 +69,37 @@ namespace NExtractTools
 
 	_UINT32 rtf2doct_bin(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("rtf2doct_bin");
 		params.m_bMacro = false;
 
-		std::wstring sResultDocxDir = combinePath(convertParams.m_sTempDir, L"docx_unpacked");
-		NSDirectory::CreateDirectory(sResultDocxDir);
+		std::wstring sResultDocxDir = createIntermediateDir(sFrom, L"docx_unpacked", params, convertParams);
 
 		RtfConvertationManager rtfConvert;
 		rtfConvert.m_sTempFolder = convertParams.m_sTempDir;
 		rtfConvert.m_nUserLCID = (NULL != params.m_nLcid) ? *params.m_nLcid : -1;
 
-		if (rtfConvert.ConvertRtfToOOX(sFrom, sResultDocxDir) == 0)
+		_UINT32 res = AVS_FILEUTILS_ERROR_CONVERT;
+		bool bIsOox = false;
+		{
+			X2T_PROFILE_SCOPE("to_oox");
+			bIsOox = (rtfConvert.ConvertRtfToOOX(sFrom, sResultDocxDir) == 0);
+		}
+		if (bIsOox)
 		{
+			X2T_PROFILE_SCOPE("oox_to_bin");
 			BinDocxRW::CDocxSerializer m_oCDocxSerializer;
 
 			m_oCDocxSerializer.setFontDir(params.getFontPath());
 
 			std::wstring sXmlOptions;
-			_UINT32 res = m_oCDocxSerializer.saveToFile(sTo, sResultDocxDir, sXmlOptions, convertParams.m_sTempDir) ? 0 : AVS_FILEUTILS_ERROR_CONVERT;
-
-			return res;
+			res = m_oCDocxSerializer.saveToFile(sTo, sResultDocxDir, sXmlOptions, convertParams.m_sTempDir) ? 0 : AVS_FILEUTILS_ERROR_CONVERT;
 		}
-		return AVS_FILEUTILS_ERROR_CONVERT;
+		releaseIntermediateDir(sResultDocxDir, convertParams);
+		return res;
 	}
 	_UINT32 doct_bin2rtf(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("doct_bin2rtf");
 		_UINT32 nRes = 0;
 		std::wstring sResultDocxDir = combinePath(convertParams.m_sTempDir, L"docx_unpacked");
 		NSDirectory::CreateDirectory(sResultDocxDir);
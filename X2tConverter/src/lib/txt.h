@@ -39,6 +39,7 @@ namespace NExtractTools
 {
 	_UINT32 txt2docx_dir(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("txt2docx_dir");
 		params.m_bMacro = false; 
 
 		CTxtXmlFile txtFile;
@@ -47,12 +48,14 @@ namespace NExtractTools
 	}
 	_UINT32 docx_dir2txt(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("docx_dir2txt");
 		CTxtXmlFile txtFile;
 		return txtFile.txt_SaveToFile(sTo, sFrom, params.getXmlOptions());
 	}
 
 	_UINT32 txt2doct_bin(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("txt2doct_bin");
 		std::wstring sResultDocxDir = combinePath(convertParams.m_sTempDir, L"docx_unpacked");
 		NSDirectory::CreateDirectory(sResultDocxDir);
 
@@ -46,8 +46,7 @@ namespace NExtractTools
 		std::wstring sTempUnpackedVSDX = combinePath(convertParams.m_sTempDir, L"vsdx_unpacked");
 		NSDirectory::CreateDirectory(sTempUnpackedVSDX);
 
-		COfficeUtils oCOfficeUtils(NULL);
-		if (S_OK != oCOfficeUtils.ExtractToDirectory(sFrom, sTempUnpackedVSDX, NULL, 0))
+		if (0 != zip2dir(sFrom, sTempUnpackedVSDX))
 		{
 			//check crypt
 			COfficeFileFormatChecker OfficeFileFormatChecker;
@@ -80,6 +79,7 @@ namespace NExtractTools
 	}
 	_UINT32 vsdx_dir2vsdt_bin(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("vsdx_dir2vsdt_bin");
 		_UINT32 nRes = S_OK;
 		std::wstring sToDir = NSDirectory::GetFolderPath(sTo);
 		if (params.needConvertToOrigin(AVS_OFFICESTUDIO_FILE_DRAW_VSDX) && !convertParams.m_sTempParamOOXMLFile.empty())
@@ -142,6 +142,7 @@ namespace NExtractTools
 	}
 	_UINT32 vsdt_bin2vsdx_dir(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("vsdt_bin2vsdx_dir");
 		_UINT32 nRes = 0;
 
 		std::wstring sTargetBin;
@@ -39,6 +39,7 @@ namespace NExtractTools
 {
 	_UINT32 xls2xlsm_dir_macro(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams, const bool& bIsMacro)
 	{
+		X2T_PROFILE_SCOPE("xls2xlsm_dir_macro");
 		params.m_bMacro = bIsMacro;
 
 		int lcid = (NULL != params.m_nLcid) ? *params.m_nLcid : -1;
@@ -59,24 +60,30 @@ namespace NExtractTools
 
 	_UINT32 xls2xlst_bin(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
-		std::wstring sResultXlsxDir = combinePath(convertParams.m_sTempDir, L"xlsx_unpacked");
-		NSDirectory::CreateDirectory(sResultXlsxDir);
+		X2T_PROFILE_SCOPE("xls2xlst_bin");
+		std::wstring sResultXlsxDir = createIntermediateDir(sFrom, L"xlsx_unpacked", params, convertParams);
 
 		params.m_bMacro = true;
 
 		int lcid = (NULL != params.m_nLcid) ? *params.m_nLcid : -1;
 
-		_UINT32 nRes = ConvertXls2Xlsx(sFrom, sResultXlsxDir, params.getPassword(), params.getFontPath(), convertParams.m_sTempDir, lcid, params.m_bMacro);
+		_UINT32 nRes = 0;
+		{
+			X2T_PROFILE_SCOPE("to_oox");
+			nRes = ConvertXls2Xlsx(sFrom, sResultXlsxDir, params.getPassword(), params.getFontPath(), convertParams.m_sTempDir, lcid, params.m_bMacro);
+		}
 
 		nRes = processEncryptionError(nRes, sFrom, params);
 		if (SUCCEEDED_X2T(nRes))
 		{
+			X2T_PROFILE_SCOPE("oox_to_bin");
 			BinXlsxRW::CXlsxSerializer oCXlsxSerializer;
 
 			oCXlsxSerializer.setFontDir(params.getFontPath());
 
-			return oCXlsxSerializer.saveToFile(sTo, sResultXlsxDir, params.getXmlOptions());
+			nRes = oCXlsxSerializer.saveToFile(sTo, sResultXlsxDir, params.getXmlOptions());
 		}
+		releaseIntermediateDir(sResultXlsxDir, convertParams);
 		return nRes;
 	}
 
@@ -50,8 +50,7 @@ namespace NExtractTools
 		std::wstring sTempUnpackedXLSX = combinePath(convertParams.m_sTempDir, L"xlsx_unpacked");
 		NSDirectory::CreateDirectory(sTempUnpackedXLSX);
 
-		COfficeUtils oCOfficeUtils(NULL);
-		if (S_OK != oCOfficeUtils.ExtractToDirectory(sFrom, sTempUnpackedXLSX, NULL, 0))
+		if (0 != zip2dir(sFrom, sTempUnpackedXLSX))
 		{
 			//check crypt
 			COfficeFileFormatChecker OfficeFileFormatChecker;
@@ -133,6 +132,7 @@ namespace NExtractTools
 	}
 	_UINT32 xlsx_dir2xlst_bin(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("xlsx_dir2xlst_bin");
 		_UINT32 nRes = S_OK;
 		std::wstring sToDir = NSDirectory::GetFolderPath(sTo);
 		if (params.needConvertToOrigin(AVS_OFFICESTUDIO_FILE_SPREADSHEET_XLSX) && !convertParams.m_sTempParamOOXMLFile.empty())
@@ -146,6 +146,7 @@ namespace NExtractTools
 			// Save to file (from temp dir)
 			oCXlsxSerializer.setIsNoBase64(params.getIsNoBase64());
 			oCXlsxSerializer.setFontDir(params.getFontPath());
+			oCXlsxSerializer.setIsThumbnail(params.getIsThumbnailFirstPage());
 
 			nRes = oCXlsxSerializer.saveToFile(sTo, sFrom, convertParams.m_bTempIsXmlOptions ? params.getXmlOptions() : L"");
 		}
@@ -156,6 +157,7 @@ namespace NExtractTools
 	}
 	_UINT32 xlsx_dir2xlsb_dir(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("xlsx_dir2xlsb_dir");
 		const OOX::CPath oox_path(sFrom);
 
 		OOX::Spreadsheet::CXlsb oXlsb;
@@ -173,6 +175,7 @@ namespace NExtractTools
 	}
 	_UINT32 xlst_bin2xlsb_dir(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("xlst_bin2xlsb_dir");
 
 		_UINT32 nRes = 0;
 		
@@ -250,6 +253,7 @@ namespace NExtractTools
 	}
 	_UINT32 xlst_bin2xlsx_dir(const std::wstring& sFrom, const std::wstring &sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("xlst_bin2xlsx_dir");
 		_UINT32 nRes = 0;
 
 		std::wstring sTargetBin;
@@ -332,6 +336,7 @@ namespace NExtractTools
 	}
 	_UINT32 xlsb2xlsx_dir(const std::wstring& sFrom, const std::wstring& sTo, InputParams& params, ConvertParams& convertParams)
 	{
+		X2T_PROFILE_SCOPE("xlsb2xlsx_dir");
 		std::wstring sTempUnpackedXLSB = combinePath(convertParams.m_sTempDir, L"xlsb_unpacked");
 		NSDirectory::CreateDirectory(sTempUnpackedXLSB);
 
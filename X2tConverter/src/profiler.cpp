@@ -0,0 +1,414 @@
+/*
+ * (c) Copyright UNIVAULT TECHNOLOGIES 2026-2026
+ *
+ * This program is a free software product. You can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License (AGPL)
+ * version 3 as published by the Free Software Foundation. In accordance with
+ * Section 7(a) of the GNU AGPL its Section 15 shall be amended to the effect
+ * that UNIVAULT TECHNOLOGIES expressly excludes the warranty of non-infringement
+ * of any third-party rights.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR  PURPOSE. For
+ * details, see the GNU AGPL at: http://www.gnu.org/licenses/agpl-3.0.html
+ *
+ * You can contact UNIVAULT TECHNOLOGIES at 20A-6 Ernesta Birznieka-Upish
+ * street, Moscow (TEST), Russia (TEST), EU, 000000 (TEST).
+ *
+ * The  interactive user interfaces in modified source and object code versions
+ * of the Program must display Appropriate Legal Notices, as required under
+ * Section 5 of the GNU AGPL version 3.
+ *
+ * Pursuant to Section 7(b) of the License you must retain the original Product
+ * logo when distributing the program. Pursuant to Section 7(e) we decline to
+ * grant you any rights under trademark law for use of our trademarks.
+ *
+ * All the Product's GUI elements, including illustrations and icon sets, as
+ * well as technical writing content are licensed under the terms of the
+ * Creative Commons Attribution-ShareAlike 4.0 International. See the License
+ * terms at http://creativecommons.org/licenses/by-sa/4.0/legalcode
+ *
+ */
+#include "profiler.h"
+
+#include <vector>
+#include <map>
+#include <chrono>
+#include <cstring>
+
+#include "../../DesktopEditor/common/File.h"
+#include "../../DesktopEditor/graphics/TemporaryCS.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace NExtractTools
+{
+	namespace NSProfiler
+	{
+		std::atomic<bool> g_bIsEnabled(false);
+
+		namespace
+		{
+			struct CScopeEvent
+			{
+				const char* m_sName;
+				int m_nParent;
+				int m_nThread;
+				long long m_nBegin; // us from start
+				long long m_nEnd;
+				unsigned long long m_nMemoryBegin;
+				unsigned long long m_nMemoryEnd;
+			};
+			struct CCounterEvent
+			{
+				const char* m_sName;
+				long long m_nTime;
+				long long m_nValue;
+			};
+			struct CPhase
+			{
+				const char* m_sName;
+				int m_nCount;
+				long long m_nTime;
+				unsigned long long m_nMemory;
+				unsigned long long m_nMemoryGrowth;
+				std::vector<int> m_arChildren;
+			};
+
+			NSCriticalSection::CRITICAL_SECTION g_oCS;
+			bool g_bIsCSInitialized = false;
+
+			std::chrono::steady_clock::time_point g_oStart;
+			std::vector<CScopeEvent> g_arScopes;
+			std::vector<CCounterEvent> g_arCounters;
+			std::map<std::string, long long> g_mapCounters;
+			int g_nThreadsCount = 0;
+
+			// thread local state of previous sessions is ignored
+			unsigned int g_nSession = 0;
+			thread_local unsigned int t_nSession = 0;
+			thread_local int t_nCurrent = -1;
+			thread_local int t_nThread = 0;
+
+			long long GetTime()
+			{
+				return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - g_oStart).count();
+			}
+
+			// high-water mark of the process memory
+			unsigned long long GetPeakMemory()
+			{
+#ifdef _WIN32
+				PROCESS_MEMORY_COUNTERS oCounters;
+				if (GetProcessMemoryInfo(GetCurrentProcess(), &oCounters, sizeof(oCounters)))
+					return oCounters.PeakWorkingSetSize;
+				return 0;
+#else
+				struct rusage oUsage;
+				if (0 != getrusage(RUSAGE_SELF, &oUsage))
+					return 0;
+#ifdef _MAC
+				return (unsigned long long)oUsage.ru_maxrss;
+#else
+				// kilobytes on linux
+				return (unsigned long long)oUsage.ru_maxrss * 1024;
+#endif
+#endif
+			}
+
+			void CheckThread()
+			{
+				if (t_nSession == g_nSession)
+					return;
+
+				t_nSession = g_nSession;
+				t_nCurrent = -1;
+				t_nThread = g_nThreadsCount++;
+			}
+
+			void WriteString(std::string& sOut, const char* sValue)
+			{
+				sOut += '"';
+				for (const char* p = sValue; *p; ++p)
+				{
+					if (*p == '"' || *p == '\\')
+						sOut += '\\';
+					sOut += *p;
+				}
+				sOut += '"';
+			}
+			void WriteMilliseconds(std::string& sOut, long long nMicroseconds)
+			{
+				char sFraction[4];
+				int nFraction = (int)(nMicroseconds % 1000);
+				sFraction[0] = (char)('0' + nFraction / 100);
+				sFraction[1] = (char)('0' + nFraction / 10 % 10);
+				sFraction[2] = (char)('0' + nFraction % 10);
+				sFraction[3] = 0;
+
+				sOut += std::to_string(nMicroseconds / 1000);
+				sOut += '.';
+				sOut += sFraction;
+			}
+
+			void WritePhases(std::string& sOut, const std::vector<CPhase>& arPhases, const CPhase& oParent, int nDepth)
+			{
+				sOut += '[';
+				for (size_t i = 0; i < oParent.m_arChildren.size(); ++i)
+				{
+					const CPhase& oPhase = arPhases[oParent.m_arChildren[i]];
+
+					sOut += (i == 0) ? "\n" : ",\n";
+					sOut.append(nDepth, '\t');
+
+					sOut += "{\"name\": ";
+					WriteString(sOut, oPhase.m_sName);
+					sOut += ", \"count\": " + std::to_string(oPhase.m_nCount);
+					sOut += ", \"time\": ";
+					WriteMilliseconds(sOut, oPhase.m_nTime);
+					sOut += ", \"peakMemory\": " + std::to_string(oPhase.m_nMemory);
+					sOut += ", \"memoryGrowth\": " + std::to_string(oPhase.m_nMemoryGrowth);
+
+					if (!oPhase.m_arChildren.empty())
+					{
+						sOut += ", \"phases\": ";
+						WritePhases(sOut, arPhases, oPhase, nDepth + 1);
+					}
+					sOut += '}';
+				}
+				if (!oParent.m_arChildren.empty())
+				{
+					sOut += '\n';
+					sOut.append(nDepth - 1, '\t');
+				}
+				sOut += ']';
+			}
+
+			std::string GetReport(long long nTotalTime, unsigned long long nPeakMemory)
+			{
+				// same named scopes with the same parent phase are merged
+				std::vector<CPhase> arPhases(1);
+				arPhases[0].m_sName = "";
+				std::vector<int> arScopePhases(g_arScopes.size());
+
+				for (size_t i = 0; i < g_arScopes.size(); ++i)
+				{
+					const CScopeEvent& oScope = g_arScopes[i];
+					int nParent = (oScope.m_nParent < 0) ? 0 : arScopePhases[oScope.m_nParent];
+
+					int nPhase = -1;
+					for (int nChild : arPhases[nParent].m_arChildren)
+					{
+						if (0 == strcmp(arPhases[nChild].m_sName, oScope.m_sName))
+						{
+							nPhase = nChild;
+							break;
+						}
+					}
+					if (nPhase < 0)
+					{
+						CPhase oPhase;
+						oPhase.m_sName = oScope.m_sName;
+						oPhase.m_nCount = 0;
+						oPhase.m_nTime = 0;
+						oPhase.m_nMemory = 0;
+						oPhase.m_nMemoryGrowth = 0;
+
+						nPhase = (int)arPhases.size();
+						arPhases.push_back(oPhase);
+						arPhases[nParent].m_arChildren.push_back(nPhase);
+					}
+
+					CPhase& oPhase = arPhases[nPhase];
+					oPhase.m_nCount++;
+					oPhase.m_nTime += oScope.m_nEnd - oScope.m_nBegin;
+					if (oScope.m_nMemoryEnd > oPhase.m_nMemory)
+						oPhase.m_nMemory = oScope.m_nMemoryEnd;
+					oPhase.m_nMemoryGrowth += oScope.m_nMemoryEnd - oScope.m_nMemoryBegin;
+
+					arScopePhases[i] = nPhase;
+				}
+
+				std::string sOut = "{\n\"time\": ";
+				WriteMilliseconds(sOut, nTotalTime);
+				sOut += ",\n\"peakMemory\": " + std::to_string(nPeakMemory);
+				sOut += ",\n\"phases\": ";
+				WritePhases(sOut, arPhases, arPhases[0], 1);
+				sOut += ",\n\"counters\": {";
+
+				bool bIsFirst = true;
+				for (auto& oCounter : g_mapCounters)
+				{
+					sOut += bIsFirst ? "\n\t" : ",\n\t";
+					WriteString(sOut, oCounter.first.c_str());
+					sOut += ": " + std::to_string(oCounter.second);
+					bIsFirst = false;
+				}
+				sOut += bIsFirst ? "}\n}\n" : "\n}\n}\n";
+				return sOut;
+			}
+
+			std::string GetTrace()
+			{
+				std::string sOut = "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+				bool bIsFirst = true;
+
+				for (auto& oScope : g_arScopes)
+				{
+					sOut += bIsFirst ? "\n" : ",\n";
+					bIsFirst = false;
+
+					sOut += "{\"name\": ";
+					WriteString(sOut, oScope.m_sName);
+					sOut += ", \"cat\": \"x2t\", \"ph\": \"X\", \"pid\": 1, \"tid\": " + std::to_string(oScope.m_nThread);
+					sOut += ", \"ts\": " + std::to_string(oScope.m_nBegin);
+					sOut += ", \"dur\": " + std::to_string(oScope.m_nEnd - oScope.m_nBegin);
+					sOut += ", \"args\": {\"peakMemory\": " + std::to_string(oScope.m_nMemoryEnd) + "}}";
+
+					// memory track
+					sOut += ",\n{\"name\": \"peakMemory\", \"ph\": \"C\", \"pid\": 1, \"ts\": " + std::to_string(oScope.m_nEnd);
+					sOut += ", \"args\": {\"bytes\": " + std::to_string(oScope.m_nMemoryEnd) + "}}";
+				}
+
+				for (auto& oCounter : g_arCounters)
+				{
+					sOut += bIsFirst ? "\n" : ",\n";
+					bIsFirst = false;
+
+					sOut += "{\"name\": ";
+					WriteString(sOut, oCounter.m_sName);
+					sOut += ", \"ph\": \"C\", \"pid\": 1, \"ts\": " + std::to_string(oCounter.m_nTime);
+					sOut += ", \"args\": {\"value\": " + std::to_string(oCounter.m_nValue) + "}}";
+				}
+
+				sOut += "\n]}\n";
+				return sOut;
+			}
+
+			bool WriteFile(const std::wstring& sFile, const std::string& sData)
+			{
+				NSFile::CFileBinary oFile;
+				if (!oFile.CreateFileW(sFile))
+					return false;
+
+				oFile.WriteFile((BYTE*)sData.c_str(), (DWORD)sData.length());
+				oFile.CloseFile();
+				return true;
+			}
+		}
+
+		void Start()
+		{
+			if (!g_bIsCSInitialized)
+			{
+				g_oCS.InitializeCriticalSection();
+				g_bIsCSInitialized = true;
+			}
+
+			CTemporaryCS oCS(&g_oCS);
+
+			g_arScopes.clear();
+			g_arCounters.clear();
+			g_mapCounters.clear();
+			g_nThreadsCount = 0;
+			g_nSession++;
+
+			g_oStart = std::chrono::steady_clock::now();
+			g_bIsEnabled = true;
+		}
+
+		bool Finish(const std::wstring& sReportFile, const std::wstring& sTraceFile)
+		{
+			if (!g_bIsEnabled)
+				return false;
+
+			long long nTotalTime = GetTime();
+			unsigned long long nPeakMemory = GetPeakMemory();
+
+			CTemporaryCS oCS(&g_oCS);
+			g_bIsEnabled = false;
+
+			// scopes of other threads that are still running
+			for (auto& oScope : g_arScopes)
+			{
+				if (oScope.m_nEnd < oScope.m_nBegin)
+				{
+					oScope.m_nEnd = nTotalTime;
+					oScope.m_nMemoryEnd = nPeakMemory;
+				}
+			}
+
+			bool bResult = true;
+			if (!sReportFile.empty())
+				bResult = WriteFile(sReportFile, GetReport(nTotalTime, nPeakMemory)) && bResult;
+			if (!sTraceFile.empty())
+				bResult = WriteFile(sTraceFile, GetTrace()) && bResult;
+
+			g_arScopes.clear();
+			g_arCounters.clear();
+			g_mapCounters.clear();
+			g_nSession++;
+			return bResult;
+		}
+
+		void AddCounter(const char* sName, long long nValue)
+		{
+			long long nTime = GetTime();
+
+			CTemporaryCS oCS(&g_oCS);
+			if (!g_bIsEnabled)
+				return;
+
+			long long& nCounter = g_mapCounters[sName];
+			nCounter += nValue;
+
+			CCounterEvent oEvent;
+			oEvent.m_sName = sName;
+			oEvent.m_nTime = nTime;
+			oEvent.m_nValue = nCounter;
+			g_arCounters.push_back(oEvent);
+		}
+
+		int BeginScope(const char* sName)
+		{
+			CScopeEvent oScope;
+			oScope.m_sName = sName;
+			oScope.m_nMemoryBegin = GetPeakMemory();
+			oScope.m_nMemoryEnd = oScope.m_nMemoryBegin;
+			oScope.m_nBegin = GetTime();
+			oScope.m_nEnd = -1;
+
+			CTemporaryCS oCS(&g_oCS);
+			if (!g_bIsEnabled)
+				return -1;
+
+			CheckThread();
+			oScope.m_nParent = t_nCurrent;
+			oScope.m_nThread = t_nThread;
+
+			g_arScopes.push_back(oScope);
+			t_nCurrent = (int)g_arScopes.size() - 1;
+			return t_nCurrent;
+		}
+
+		void EndScope(int nIndex)
+		{
+			long long nTime = GetTime();
+			unsigned long long nMemory = GetPeakMemory();
+
+			CTemporaryCS oCS(&g_oCS);
+			if (!g_bIsEnabled || t_nSession != g_nSession || nIndex >= (int)g_arScopes.size())
+				return;
+
+			CScopeEvent& oScope = g_arScopes[nIndex];
+			oScope.m_nEnd = nTime;
+			oScope.m_nMemoryEnd = nMemory;
+			t_nCurrent = oScope.m_nParent;
+		}
+	}
+}
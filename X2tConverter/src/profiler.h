@@ -0,0 +1,123 @@
+/*
+ * (c) Copyright UNIVAULT TECHNOLOGIES 2026-2026
+ *
+ * This program is a free software product. You can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License (AGPL)
+ * version 3 as published by the Free Software Foundation. In accordance with
+ * Section 7(a) of the GNU AGPL its Section 15 shall be amended to the effect
+ * that UNIVAULT TECHNOLOGIES expressly excludes the warranty of non-infringement
+ * of any third-party rights.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR  PURPOSE. For
+ * details, see the GNU AGPL at: http://www.gnu.org/licenses/agpl-3.0.html
+ *
+ * You can contact UNIVAULT TECHNOLOGIES at 20A-6 Ernesta Birznieka-Upish
+ * street, Moscow (TEST), Russia (TEST), EU, 000000 (TEST).
+ *
+ * The  interactive user interfaces in modified source and object code versions
+ * of the Program must display Appropriate Legal Notices, as required under
+ * Section 5 of the GNU AGPL version 3.
+ *
+ * Pursuant to Section 7(b) of the License you must retain the original Product
+ * logo when distributing the program. Pursuant to Section 7(e) we decline to
+ * grant you any rights under trademark law for use of our trademarks.
+ *
+ * All the Product's GUI elements, including illustrations and icon sets, as
+ * well as technical writing content are licensed under the terms of the
+ * Creative Commons Attribution-ShareAlike 4.0 International. See the License
+ * terms at http://creativecommons.org/licenses/by-sa/4.0/legalcode
+ *
+ */
+#ifndef X2T_PROFILER_H
+#define X2T_PROFILER_H
+
+#include <string>
+#include <atomic>
+
+namespace NExtractTools
+{
+	// Hierarchical timers, counters and memory high-water marks of conversion stages.
+	// Disabled by default: a scope costs one check of a flag.
+	// Enabled by m_sProfileFile (json report) or m_sProfileTraceFile (chrome://tracing json) task params.
+	namespace NSProfiler
+	{
+		extern std::atomic<bool> g_bIsEnabled;
+
+		inline bool IsEnabled()
+		{
+			return g_bIsEnabled.load(std::memory_order_relaxed);
+		}
+
+		void Start();
+		// writes report and/or trace (empty path - skip) and disables profiling
+		bool Finish(const std::wstring& sReportFile, const std::wstring& sTraceFile);
+
+		void AddCounter(const char* sName, long long nValue = 1);
+
+		int BeginScope(const char* sName);
+		void EndScope(int nIndex);
+
+		// sName must be a string literal (it is stored without copy)
+		class CScope
+		{
+		public:
+			CScope(const char* sName) : m_nIndex(-1)
+			{
+				if (IsEnabled())
+					m_nIndex = BeginScope(sName);
+			}
+			~CScope()
+			{
+				End();
+			}
+
+			// ends the scope before destruction
+			void End()
+			{
+				if (m_nIndex >= 0)
+					EndScope(m_nIndex);
+				m_nIndex = -1;
+			}
+
+		private:
+			CScope(const CScope&);
+			CScope& operator=(const CScope&);
+
+			int m_nIndex;
+		};
+
+		// Start on construction, Finish on destruction - the report is written on every return path
+		class CSession
+		{
+		public:
+			CSession(bool bEnable, const std::wstring& sReportFile, const std::wstring& sTraceFile)
+				: m_bStarted(bEnable), m_sReportFile(sReportFile), m_sTraceFile(sTraceFile)
+			{
+				if (m_bStarted)
+					Start();
+			}
+			~CSession()
+			{
+				if (m_bStarted)
+					Finish(m_sReportFile, m_sTraceFile);
+			}
+
+		private:
+			CSession(const CSession&);
+			CSession& operator=(const CSession&);
+
+			bool m_bStarted;
+			std::wstring m_sReportFile;
+			std::wstring m_sTraceFile;
+		};
+	}
+}
+
+#define X2T_PROFILE_CONCAT_INTERNAL(a, b) a##b
+#define X2T_PROFILE_CONCAT(a, b) X2T_PROFILE_CONCAT_INTERNAL(a, b)
+
+#define X2T_PROFILE_SCOPE(name) NExtractTools::NSProfiler::CScope X2T_PROFILE_CONCAT(oProfileScope, __LINE__)(name)
+#define X2T_PROFILE_COUNTER(name, value) do { if (NExtractTools::NSProfiler::IsEnabled()) NExtractTools::NSProfiler::AddCounter(name, value); } while (0)
+
+#endif // X2T_PROFILER_H
@@ -36,6 +36,10 @@
 #include "../../DesktopEditor/common/StringBuilder.h"
 #include "../../DesktopEditor/graphics/BaseThread.h"
 
+#ifdef WIN32
+#include <psapi.h>
+#endif
+
 #ifdef _LINUX
 #include <unistd.h>
 #include <sys/wait.h>
@@ -49,11 +53,21 @@ extern char **environ;
 
 namespace NSX2T
 {
+	// resources used by the finished x2t process
+	struct CProcessStat
+	{
+		unsigned long long nCpuTime;    // user + system, ms
+		unsigned long long nPeakMemory; // peak resident set, bytes
+
+		CProcessStat() : nCpuTime(0), nPeakMemory(0) {}
+	};
+
 	int Convert(const std::wstring& sConverterDirectory,
 		const std::wstring sXmlPath,
 		unsigned long nTimeout = 0,
 		bool *bOutIsTimeout = nullptr,
-		bool bIsSaveEnvironment = false)
+		bool bIsSaveEnvironment = false,
+		CProcessStat* pStat = nullptr)
 	{
 		int nReturnCode = 0;
 		std::wstring sConverterExe = sConverterDirectory + L"/x2t";
@@ -128,6 +142,24 @@ namespace NSX2T
 			nReturnCode = (int)dwExitCode;
 		}
 
+		if (pStat != nullptr)
+		{
+			FILETIME ftCreation, ftExit, ftKernel, ftUser;
+			if (GetProcessTimes(processinfo.hProcess, &ftCreation, &ftExit, &ftKernel, &ftUser))
+			{
+				ULARGE_INTEGER nKernel, nUser;
+				nKernel.LowPart = ftKernel.dwLowDateTime; nKernel.HighPart = ftKernel.dwHighDateTime;
+				nUser.LowPart = ftUser.dwLowDateTime; nUser.HighPart = ftUser.dwHighDateTime;
+
+				// 100-nanosecond intervals
+				pStat->nCpuTime = (nKernel.QuadPart + nUser.QuadPart) / 10000;
+			}
+
+			PROCESS_MEMORY_COUNTERS oCounters;
+			if (GetProcessMemoryInfo(processinfo.hProcess, &oCounters, sizeof(oCounters)))
+				pStat->nPeakMemory = oCounters.PeakWorkingSetSize;
+		}
+
 		CloseHandle(processinfo.hProcess);
 		CloseHandle(processinfo.hThread);
 
@@ -214,7 +246,21 @@ namespace NSX2T
 		default: // parent process, pid now contains the child pid
 
 			// wait for child to complete
-			while (-1 == waitpid(pid, &status, 0));
+			struct rusage usage;
+			memset(&usage, 0, sizeof(usage));
+			while (-1 == wait4(pid, &status, 0, &usage));
+
+			if (pStat != nullptr)
+			{
+				pStat->nCpuTime = (unsigned long long)usage.ru_utime.tv_sec * 1000 + usage.ru_utime.tv_usec / 1000 +
+								  (unsigned long long)usage.ru_stime.tv_sec * 1000 + usage.ru_stime.tv_usec / 1000;
+#ifdef _MAC
+				pStat->nPeakMemory = (unsigned long long)usage.ru_maxrss;
+#else
+				// kilobytes on linux
+				pStat->nPeakMemory = (unsigned long long)usage.ru_maxrss * 1024;
+#endif
+			}
 			if(WIFSIGNALED(status))
 			{
 				if(bOutIsTimeout != nullptr && WTERMSIG(status) == SIGXCPU)
@@ -190,6 +190,7 @@ void CXpsFile::ConvertToPdf(const std::wstring& wsPath)
 {
 	CPdfFile oPdf(m_pInternal->m_pAppFonts);
 	oPdf.CreatePdf();
+	oPdf.StartStreaming(wsPath);
 	bool bBreak = false;
 
 	int nPagesCount = GetPagesCount();
@@ -101,8 +101,14 @@ namespace XPS
 	}
 	void    CContextState::PushClip(const CWString& wsClip)
 	{
-		m_vClipStack.push_back(wsClip);
-		SetClipToRenderer(wsClip);
+		CPathData oClip;
+		VmlToPathData(wsClip, oClip);
+		PushClip(oClip);
+	}
+	void    CContextState::PushClip(const CPathData& oClip)
+	{
+		m_vClipStack.push_back(oClip);
+		SetClipToRenderer(oClip);
 	}
 	void    CContextState::PopClip()
 	{
@@ -112,11 +118,9 @@ namespace XPS
 			m_pRenderer->BeginCommand(c_nResetClipType);
 			m_pRenderer->EndCommand(c_nResetClipType);
 
+			// клипы уже разобраны, повторно строки не разбираем
 			for (int nIndex = 0, nCount = m_vClipStack.size(); nIndex < nCount; nIndex++)
-			{
-				CWString wsClip = m_vClipStack.at(nIndex);
-				SetClipToRenderer(wsClip);
-			}
+				SetClipToRenderer(m_vClipStack.at(nIndex));
 		}
 	}
 	void    CContextState::SetTransformToRenderer()
@@ -127,14 +131,14 @@ namespace XPS
                                       xpsUnitToMM(m_oCurrentTransform.tx()), xpsUnitToMM(m_oCurrentTransform.ty()));
 		}
 	}	
-	void    CContextState::SetClipToRenderer(const CWString& wsClip)
+	void    CContextState::SetClipToRenderer(const CPathData& oClip)
 	{
-		if (!wsClip.empty() && m_pRenderer)
+		if (!oClip.Empty() && m_pRenderer)
 		{
 			m_pRenderer->PathCommandStart();
 			m_pRenderer->BeginCommand(c_nClipType);
 			m_pRenderer->BeginCommand(c_nPathType);
-			bool bWinding = VmlToRenderer(wsClip, m_pRenderer);
+			bool bWinding = oClip.ToRenderer(m_pRenderer);
 			m_pRenderer->put_ClipMode(bWinding ? c_nClipRegionTypeWinding : c_nClipRegionTypeEvenOdd);
 			m_pRenderer->EndCommand(c_nPathType);
 			m_pRenderer->EndCommand(c_nClipType);
@@ -70,6 +70,7 @@ namespace XPS
 		void    PopOpacity();
 		double  GetCurrentOpacity();
 		void    PushClip(const CWString& wsClip);
+		void    PushClip(const CPathData& oClip);
 		void    PopClip();
 		void    PushTransform(const double arrTransform[6]);
 		void    PopTransform();
@@ -87,14 +88,14 @@ namespace XPS
 
 	private:
 
-		void SetClipToRenderer(const CWString& wsClip);
+		void SetClipToRenderer(const CPathData& oClip);
 		void SetTransformToRenderer();
 
 	private:
 
 		Aggplus::CMatrix            m_oCurrentTransform;
 		std::list<Aggplus::CMatrix> m_lTransformStack;
-		std::vector<CWString>       m_vClipStack;
+		std::vector<CPathData>      m_vClipStack;
 		IRenderer*                  m_pRenderer;
 		std::vector<double>         m_vOpacity;
 		double                      m_dCurOpacity;
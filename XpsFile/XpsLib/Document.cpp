@@ -102,10 +102,12 @@ namespace XPS
 		m_pFontManager = pFontManager;
 		m_mPages.clear();
 		m_wsPath = NULL;
+		m_oPagesCS.InitializeCriticalSection();
 	}
 	CDocument::~CDocument()
 	{		
 		Close();
+		m_oPagesCS.DeleteCriticalSection();
 	}
 	bool CDocument::Read(IFolder* pFolder)
 	{
@@ -344,6 +346,7 @@ namespace XPS
 	}
 	void CDocument::GetPageSize(int nPageIndex, int& nW, int& nH)
 	{
+		CTemporaryCS oCS(&m_oPagesCS);
 		std::map<int, XPS::Page*>::const_iterator oIter = m_mPages.find(nPageIndex);
 		if (oIter != m_mPages.end())
 			oIter->second->GetSize(nW, nH);
@@ -366,6 +369,7 @@ namespace XPS
 	}
 	BYTE* CDocument::GetPageLinks (int nPageIndex)
 	{
+		CTemporaryCS oCS(&m_oPagesCS);
 		std::map<int, XPS::Page*>::const_iterator oIter = m_mPages.find(nPageIndex);
 		if (oIter != m_mPages.end())
             return oIter->second->m_oLinks.Serialize();
@@ -373,9 +377,34 @@ namespace XPS
 	}
 	void CDocument::DrawPage(int nPageIndex, IRenderer* pRenderer, bool* pbBreak)
 	{
-		std::map<int, XPS::Page*>::const_iterator oIter = m_mPages.find(nPageIndex);
-		if (oIter != m_mPages.end())
-			oIter->second->Draw(pRenderer, pbBreak);
+		std::shared_ptr<CPageDisplayList> pDisplayList;
+		{
+			// разбор страницы трогает общие шрифты и структуру документа, а воспроизведение - нет
+			CTemporaryCS oCS(&m_oPagesCS);
+			std::map<int, XPS::Page*>::const_iterator oIter = m_mPages.find(nPageIndex);
+			if (oIter == m_mPages.end())
+				return;
+
+			pDisplayList = oIter->second->GetDisplayList();
+			TouchCompiledPage(nPageIndex);
+		}
+
+		if (pDisplayList)
+			pDisplayList->Draw(pRenderer, pbBreak);
+	}
+	void CDocument::TouchCompiledPage(int nPageIndex)
+	{
+		m_lCompiledPages.remove(nPageIndex);
+		m_lCompiledPages.push_front(nPageIndex);
+
+		while ((int)m_lCompiledPages.size() > c_nCompiledPagesLimit)
+		{
+			std::map<int, XPS::Page*>::iterator oIter = m_mPages.find(m_lCompiledPages.back());
+			if (oIter != m_mPages.end())
+				oIter->second->ReleaseDisplayList();
+
+			m_lCompiledPages.pop_back();
+		}
 	}
 	void CDocument::Close()
 	{
@@ -385,6 +414,7 @@ namespace XPS
 				delete oIter->second;
 		}
 		m_mPages.clear();
+		m_lCompiledPages.clear();
 		m_oFontList.Clear();
 
 		for (std::map<std::wstring, CStaticResource*>::iterator oIter = m_mStaticResources.begin(); oIter != m_mStaticResources.end(); oIter++)
@@ -35,6 +35,7 @@
 #include "FontList.h"
 #include "XpsPage.h"
 #include <map>
+#include <list>
 #include <vector>
 
 #include "../../DesktopEditor/graphics/IRenderer.h"
@@ -72,9 +73,15 @@ namespace XPS
 		std::vector<CDocumentStructure>          m_vStructure;
 		std::map<std::wstring, int>              m_mInternalLinks;
 	private:
+
+		// Скомпилированные страницы (список команд) держим только для последних отрисованных
+		static const int c_nCompiledPagesLimit = 8;
+		void TouchCompiledPage(int nPageIndex);
 									        
 		IFolder*                                 m_wsPath;
 		std::map<int, XPS::Page*>                m_mPages;
+		std::list<int>                           m_lCompiledPages;
+		NSCriticalSection::CRITICAL_SECTION      m_oPagesCS;
 		CFontList                                m_oFontList;
         NSFonts::IFontManager*                   m_pFontManager;
 		std::map<std::wstring, CStaticResource*> m_mStaticResources;
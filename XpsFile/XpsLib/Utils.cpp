@@ -80,24 +80,28 @@ namespace XPSEllipse
 		// x = r cos(p), y = r sin(p) => t = atan2( sin(p) / b, cos(p) / a );
 		return atan2(sin(fAngle) / fYRad, cos(fAngle) / fXRad);
 	}
-	void   CurveTo         (IRenderer* pRenderer, Aggplus::CMatrix& oTransform, double dCX1, double dCY1, double dCX2, double dCY2, double dX2, double dY2)
+	template<typename TPath>
+	void   CurveTo         (TPath* pRenderer, Aggplus::CMatrix& oTransform, double dCX1, double dCY1, double dCX2, double dCY2, double dX2, double dY2)
 	{
 		oTransform.TransformPoint(dCX1, dCY1);
 		oTransform.TransformPoint(dCX2, dCY2);
 		oTransform.TransformPoint(dX2, dY2);
 		pRenderer->PathCommandCurveTo(xpsUnitToMM(dCX1), xpsUnitToMM(dCY1), xpsUnitToMM(dCX2), xpsUnitToMM(dCY2), xpsUnitToMM(dX2), xpsUnitToMM(dY2));
 	}
-	void   LineTo          (IRenderer* pRenderer, Aggplus::CMatrix& oTransform, double dX, double dY)
+	template<typename TPath>
+	void   LineTo          (TPath* pRenderer, Aggplus::CMatrix& oTransform, double dX, double dY)
 	{
 		oTransform.TransformPoint(dX, dY);
 		pRenderer->PathCommandLineTo(xpsUnitToMM(dX), xpsUnitToMM(dY));
 	}
-	void   MoveTo          (IRenderer* pRenderer, Aggplus::CMatrix& oTransform, double dX, double dY)
+	template<typename TPath>
+	void   MoveTo          (TPath* pRenderer, Aggplus::CMatrix& oTransform, double dX, double dY)
 	{
 		oTransform.TransformPoint(dX, dY);
 		pRenderer->PathCommandMoveTo(xpsUnitToMM(dX), xpsUnitToMM(dY));
 	}
-	void   EllipseArc3     (IRenderer* pRenderer, Aggplus::CMatrix& oTransform, double fX, double fY, double fXRad, double fYRad, double dAngle1, double dAngle2, double *pfXCur, double *pfYCur, bool bClockDirection)
+	template<typename TPath>
+	void   EllipseArc3     (TPath* pRenderer, Aggplus::CMatrix& oTransform, double fX, double fY, double fXRad, double fYRad, double dAngle1, double dAngle2, double *pfXCur, double *pfYCur, bool bClockDirection)
 	{
 		// Рассчитаем начальную, конечную и контрольные точки
 		double fX1  = 0.0, fX2  = 0.0, fY1  = 0.0, fY2  = 0.0;
@@ -134,7 +138,8 @@ namespace XPSEllipse
 			*pfYCur = fY1;
 		}
 	}
-	void   EllipseArc2     (IRenderer* pRenderer, Aggplus::CMatrix& oTransform, double fX, double fY, double fXRad, double fYRad, double fAngle1, double fAngle2, bool bClockDirection)
+	template<typename TPath>
+	void   EllipseArc2     (TPath* pRenderer, Aggplus::CMatrix& oTransform, double fX, double fY, double fXRad, double fYRad, double fAngle1, double fAngle2, bool bClockDirection)
 	{
 		// переведем углы в радианы
 		double dAngle1 = fAngle1 * 3.141592 / 180;
@@ -190,7 +195,8 @@ namespace XPSEllipse
 			}
 		}
 	}
-	void   EllipseArc      (IRenderer* pRenderer, Aggplus::CMatrix& oTransform, double fX, double fY, double fXRad, double fYRad, double fAngle1, double fAngle2, bool bClockDirection)
+	template<typename TPath>
+	void   EllipseArc      (TPath* pRenderer, Aggplus::CMatrix& oTransform, double fX, double fY, double fXRad, double fYRad, double fAngle1, double fAngle2, bool bClockDirection)
 	{
 		while (fAngle1 < 0)
 			fAngle1 += 360;
@@ -225,7 +231,8 @@ namespace XPSEllipse
 			}
 		}
 	}
-	void   Ellipse         (IRenderer* pRenderer, Aggplus::CMatrix& oTransform, double fX, double fY, double fXRad, double fYRad)
+	template<typename TPath>
+	void   Ellipse         (TPath* pRenderer, Aggplus::CMatrix& oTransform, double fX, double fY, double fXRad, double fYRad)
 	{
 		MoveTo(pRenderer, oTransform, fX - fXRad, fY);
 
@@ -235,7 +242,8 @@ namespace XPSEllipse
 		CurveTo(pRenderer, oTransform, fX + fXRad, fY - fYRad * c_fKappa, fX + fXRad * c_fKappa, fY - fYRad, fX, fY - fYRad);
 		CurveTo(pRenderer, oTransform, fX - fXRad * c_fKappa, fY - fYRad, fX - fXRad, fY - fYRad * c_fKappa, fX - fXRad, fY);
 	}
-	void   AppendEllipseArc(IRenderer* pRenderer, Aggplus::CMatrix& oTransform, double fX, double fY, double fXRad, double fYRad, double fStartAngle, double fEndAngle, bool bClockDirection)
+	template<typename TPath>
+	void   AppendEllipseArc(TPath* pRenderer, Aggplus::CMatrix& oTransform, double fX, double fY, double fXRad, double fYRad, double fStartAngle, double fEndAngle, bool bClockDirection)
 	{
 		if (fXRad <= 0 || fYRad <= 0)
 			return;
@@ -610,7 +618,8 @@ namespace XPS
 
 		return false;
 	}
-	static inline void   AppendArcTo(const wchar_t* wsString, int& nPos, const int& nLen, double& dCurX, double& dCurY, IRenderer* pRenderer,bool bRelative)
+	template<typename TPath>
+	static inline void   AppendArcTo(const wchar_t* wsString, int& nPos, const int& nLen, double& dCurX, double& dCurY, TPath* pRenderer, bool bRelative)
 	{
 		double dRadX  = GetDouble(wsString, nPos, nLen);
 		double dRadY  = GetDouble(wsString, nPos, nLen);
@@ -927,7 +936,8 @@ namespace XPS
 
 		oReader.MoveToElement();
 	}
-	bool VmlToRenderer(const CWString& _wsString, IRenderer* pRenderer)
+	template<typename TPath>
+	static bool VmlToPath(const CWString& _wsString, TPath* pRenderer)
 	{
 		bool bWinding = false;
 
@@ -1190,6 +1200,75 @@ namespace XPS
 
 		return bWinding;
 	}
+	bool VmlToRenderer(const CWString& wsString, IRenderer* pRenderer)
+	{
+		return VmlToPath(wsString, pRenderer);
+	}
+	bool VmlToPathData(const CWString& wsString, CPathData& oPath)
+	{
+		oPath.Clear();
+		oPath.SetWinding(VmlToPath(wsString, &oPath));
+		return oPath.IsWinding();
+	}
+	void CPathData::PathCommandMoveTo(const double& dX, const double& dY)
+	{
+		m_vCommands.push_back(ptMoveTo);
+		m_vCoords.push_back(dX);
+		m_vCoords.push_back(dY);
+	}
+	void CPathData::PathCommandLineTo(const double& dX, const double& dY)
+	{
+		m_vCommands.push_back(ptLineTo);
+		m_vCoords.push_back(dX);
+		m_vCoords.push_back(dY);
+	}
+	void CPathData::PathCommandCurveTo(const double& dX1, const double& dY1, const double& dX2, const double& dY2, const double& dX3, const double& dY3)
+	{
+		m_vCommands.push_back(ptCurveTo);
+		m_vCoords.push_back(dX1);
+		m_vCoords.push_back(dY1);
+		m_vCoords.push_back(dX2);
+		m_vCoords.push_back(dY2);
+		m_vCoords.push_back(dX3);
+		m_vCoords.push_back(dY3);
+	}
+	void CPathData::PathCommandClose()
+	{
+		m_vCommands.push_back(ptClose);
+	}
+	void CPathData::Clear()
+	{
+		m_vCommands.clear();
+		m_vCoords.clear();
+		m_bWinding = false;
+	}
+	bool CPathData::ToRenderer(IRenderer* pRenderer) const
+	{
+		const double* pCoords = m_vCoords.data();
+		for (size_t nIndex = 0, nCount = m_vCommands.size(); nIndex < nCount; nIndex++)
+		{
+			switch (m_vCommands[nIndex])
+			{
+			case ptMoveTo:
+				pRenderer->PathCommandMoveTo(pCoords[0], pCoords[1]);
+				pCoords += 2;
+				break;
+			case ptLineTo:
+				pRenderer->PathCommandLineTo(pCoords[0], pCoords[1]);
+				pCoords += 2;
+				break;
+			case ptCurveTo:
+				pRenderer->PathCommandCurveTo(pCoords[0], pCoords[1], pCoords[2], pCoords[3], pCoords[4], pCoords[5]);
+				pCoords += 6;
+				break;
+			case ptClose:
+				pRenderer->PathCommandClose();
+				break;
+			}
+		}
+
+		return m_bWinding;
+	}
 	bool GetNextGlyph(const wchar_t* wsIndices, int& nIndicesPos, const int& nIndicesLen, unsigned short* pUtf16, int& nUtf16Pos, const int& nUtf16Len, TIndicesEntry& oEntry)
 	{
 		oEntry.Reset();
@@ -88,6 +88,52 @@ namespace XPS
 	};
 
 
+	// Разобранная геометрия пути: команды и координаты (уже в мм), без повторного разбора строки
+	class CPathData
+	{
+	public:
+
+		CPathData() : m_bWinding(false)
+		{
+		}
+
+		void PathCommandMoveTo (const double& dX, const double& dY);
+		void PathCommandLineTo (const double& dX, const double& dY);
+		void PathCommandCurveTo(const double& dX1, const double& dY1, const double& dX2, const double& dY2, const double& dX3, const double& dY3);
+		void PathCommandClose();
+
+		void Clear();
+		bool Empty() const
+		{
+			return m_vCommands.empty();
+		}
+		void SetWinding(bool bWinding)
+		{
+			m_bWinding = bWinding;
+		}
+		bool IsWinding() const
+		{
+			return m_bWinding;
+		}
+
+		// Возвращает режим заливки, как VmlToRenderer
+		bool ToRenderer(IRenderer* pRenderer) const;
+
+	private:
+
+		enum EPathCommand
+		{
+			ptMoveTo  = 0,
+			ptLineTo  = 1,
+			ptCurveTo = 2,
+			ptClose   = 3
+		};
+
+		std::vector<BYTE>   m_vCommands;
+		std::vector<double> m_vCoords;
+		bool                m_bWinding;
+	};
+
 	bool   IsAlpha(wchar_t wChar);
     double GetDouble(const CWString& wsString);
 	double GetDouble(const std::wstring& wsString);
@@ -108,6 +154,7 @@ namespace XPS
 	void ReadAttribute(XmlUtils::CXmlLiteReader& oReader, const wchar_t* wsAttrName, std::wstring& wsAttr);
 	void ReadAttribute(XmlUtils::CXmlLiteReader& oReader, const wchar_t* wsAttrName, CWString& wsAttr);
 	bool VmlToRenderer(const CWString& wsString, IRenderer* pRenderer);
+	bool VmlToPathData(const CWString& wsString, CPathData& oPath);
 	bool GetNextGlyph(const wchar_t* wsIndices, int& nIndicesPos, const int& nIndicesLen, unsigned short* pUtf16, int& nUtf16Pos, const int& nUtf16Len, TIndicesEntry& oEntry);
 
 	void ReadSTPoint(const CWString& wsString, double& dX, double& dY);
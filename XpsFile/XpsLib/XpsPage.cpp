@@ -76,106 +76,324 @@ namespace XPS
             return pFontManager->MeasureChar2(unUnicode).fAdvanceY;
 		}
 	}	
-    Page::Page(const std::wstring& wsPagePath, IFolder* wsRootPath, CFontList* pFontList, NSFonts::IFontManager* pFontManager, CDocument* pDocument)
+	static void DrawGlyphText(IRenderer* pRenderer, const CPageDisplayList::TGlyph& oGlyph, const double& dX, const double& dY, bool bNeedBold)
 	{
-		m_wsPagePath   = wsPagePath;
-		m_wsRootPath   = wsRootPath;
-		m_pFontList    = pFontList;
-		m_pFontManager = pFontManager;
-		m_pDocument    = pDocument;
+		if (oGlyph.bGid)
+		{
+			pRenderer->CommandDrawTextExCHAR(oGlyph.nUnicode, oGlyph.nGid, dX, dY, 0, 0);
+		}
+		else
+		{
+			LONG nRenType = 0;
+			pRenderer->get_Type(&nRenType);
+			if (c_nGrRenderer == nRenType)
+				pRenderer->put_FontStringGID(FALSE);
+
+			pRenderer->CommandDrawTextCHAR(oGlyph.nUnicode, dX, dY, 0, 0);
+		}
+
+		if (bNeedBold)
+		{
+			pRenderer->BeginCommand(c_nPathType);
+			pRenderer->PathCommandStart();
+
+			if (oGlyph.bGid)
+				pRenderer->PathCommandTextExCHAR(oGlyph.nUnicode, oGlyph.nGid, dX, dY, 0, 0);
+			else
+				pRenderer->PathCommandTextCHAR(oGlyph.nUnicode, dX, dY, 0, 0);
+
+			pRenderer->DrawPath(c_nStroke);
+			pRenderer->EndCommand(c_nPathType);
+			pRenderer->PathCommandEnd();
+		}
 	}
-	Page::~Page()
+
+	CPageDisplayList::CPageDisplayList()
 	{
 	}
-	void Page::GetSize(int& nW, int& nH) const
+	CPageDisplayList::~CPageDisplayList()
 	{
-		XmlUtils::CXmlLiteReader oReader;
+		for (size_t nIndex = 0, nCount = m_vGlyphs.size(); nIndex < nCount; nIndex++)
+			delete m_vGlyphs[nIndex];
 
-		if (!oReader.FromStringA(m_wsRootPath->readXml(m_wsPagePath)))
-			return;
+		for (size_t nIndex = 0, nCount = m_vPaths.size(); nIndex < nCount; nIndex++)
+			delete m_vPaths[nIndex];
 
-		if (!oReader.ReadNextNode())
+		for (size_t nIndex = 0, nCount = m_vBrushes.size(); nIndex < nCount; nIndex++)
+			delete m_vBrushes[nIndex];
+
+		for (size_t nIndex = 0, nCount = m_vResources.size(); nIndex < nCount; nIndex++)
+			delete m_vResources[nIndex];
+	}
+	void CPageDisplayList::PushTransform(const double arrTransform[6])
+	{
+		TCommand oCommand = { dcPushTransform, (int)(m_vTransforms.size() / 6) };
+		m_vTransforms.insert(m_vTransforms.end(), arrTransform, arrTransform + 6);
+		m_vCommands.push_back(oCommand);
+	}
+	void CPageDisplayList::PopTransform()
+	{
+		TCommand oCommand = { dcPopTransform, -1 };
+		m_vCommands.push_back(oCommand);
+	}
+	void CPageDisplayList::PushClip(const CPathData& oClip)
+	{
+		TCommand oCommand = { dcPushClip, (int)m_vClips.size() };
+		m_vClips.push_back(oClip);
+		m_vCommands.push_back(oCommand);
+	}
+	void CPageDisplayList::PopClip()
+	{
+		TCommand oCommand = { dcPopClip, -1 };
+		m_vCommands.push_back(oCommand);
+	}
+	CPageDisplayList::TGlyphs* CPageDisplayList::AddGlyphs()
+	{
+		TCommand oCommand = { dcGlyphs, (int)m_vGlyphs.size() };
+		m_vGlyphs.push_back(new TGlyphs());
+		m_vCommands.push_back(oCommand);
+		return m_vGlyphs.back();
+	}
+	CPageDisplayList::TPath* CPageDisplayList::AddPath()
+	{
+		TCommand oCommand = { dcPath, (int)m_vPaths.size() };
+		m_vPaths.push_back(new TPath());
+		m_vCommands.push_back(oCommand);
+		return m_vPaths.back();
+	}
+	void CPageDisplayList::AddBrush(CBrush* pBrush)
+	{
+		if (pBrush)
+			m_vBrushes.push_back(pBrush);
+	}
+	void CPageDisplayList::AddResource(CStaticResource* pResource)
+	{
+		if (pResource)
+			m_vResources.push_back(pResource);
+	}
+	void CPageDisplayList::Draw(IRenderer* pRenderer, bool* pbBreak) const
+	{
+		CContextState oState(pRenderer);
+		for (size_t nIndex = 0, nCount = m_vCommands.size(); nIndex < nCount; nIndex++)
+		{
+			const TCommand& oCommand = m_vCommands[nIndex];
+			switch (oCommand.nType)
+			{
+			case dcPushTransform:
+				oState.PushTransform(m_vTransforms.data() + oCommand.nIndex * 6);
+				break;
+			case dcPopTransform:
+				oState.PopTransform();
+				break;
+			case dcPushClip:
+				oState.PushClip(m_vClips[oCommand.nIndex]);
+				break;
+			case dcPopClip:
+				oState.PopClip();
+				break;
+			case dcGlyphs:
+				DrawGlyphs(m_vGlyphs[oCommand.nIndex], pRenderer, &oState);
+				break;
+			case dcPath:
+				DrawPath(m_vPaths[oCommand.nIndex], pRenderer, &oState);
+				break;
+			}
+
+			if (NULL != pbBreak && *pbBreak)
+				return;
+		}
+	}
+	void CPageDisplayList::DrawGlyphs(const TGlyphs* pGlyphs, IRenderer* pRenderer, CContextState* pState) const
+	{
+		if (pGlyphs->bFont)
+			pRenderer->put_FontPath(pGlyphs->wsFontPath);
+
+		if (!pGlyphs->pBrush || !pGlyphs->pBrush->SetToRenderer(pRenderer))
 			return;
 
-		CWString wsNodeName = oReader.GetNameNoNS(), wsAttrName;
-		if (wsNodeName == L"AlternateContent")
+		if (pGlyphs->bTransform)
+			pState->PushTransform(pGlyphs->arrTransform);
+
+		if (pGlyphs->bClip)
+			pState->PushClip(pGlyphs->oClip);
+
+		pRenderer->put_FontSize(pGlyphs->dFontSize * 0.75);
+
+		if (pGlyphs->bNeedBold)
 		{
-			if (!oReader.IsEmptyNode())
+			LONG lTextColor, lTextAlpha;
+			pRenderer->get_BrushColor1(&lTextColor);
+			pRenderer->get_BrushAlpha1(&lTextAlpha);
+			pRenderer->put_PenColor(lTextColor);
+			pRenderer->put_PenAlpha(lTextAlpha);
+			pRenderer->put_PenSize(xpsUnitToMM(1));
+		}
+
+		for (size_t nIndex = 0, nCount = pGlyphs->vGlyphs.size(); nIndex < nCount; nIndex++)
+		{
+			const TGlyph& oGlyph = pGlyphs->vGlyphs[nIndex];
+			if (!pGlyphs->bSideways)
 			{
-				int nAltDepth = oReader.GetDepth();
-				while (oReader.ReadNextSiblingNode(nAltDepth))
+				if (pGlyphs->bNeedItalic)
 				{
-					wsNodeName = oReader.GetNameNoNS();
-					if (wsNodeName == L"Choice")
-					{
-						CWString wsAttr;
-						ReadAttribute(oReader, L"Requires", wsAttr);
-						if (wsAttr == L"xps")
-						{
-							if (!oReader.IsEmptyNode())
-							{
-								int nAltDepth2 = oReader.GetDepth();
-								while (oReader.ReadNextSiblingNode(nAltDepth2))
-								{
-									wsNodeName = oReader.GetNameNoNS();
-									if (wsNodeName == L"FixedPage")
-									{
-										ReadAttribute(oReader, L"Width", wsAttrName);
-										nW = wsAttrName.tointeger();
-
-										ReadAttribute(oReader, L"Height", wsAttrName);
-										nH = wsAttrName.tointeger();
-										break;
-									}
-								}
-							}
-							break;
-						}
-					}
-					else if (wsNodeName == L"Fallback")
-					{
-						if (!oReader.IsEmptyNode())
-						{
-							int nAltDepth2 = oReader.GetDepth();
-							while (oReader.ReadNextSiblingNode(nAltDepth2))
-							{
-								wsNodeName = oReader.GetNameNoNS();
-								if (wsNodeName == L"FixedPage")
-								{
-									ReadAttribute(oReader, L"Width", wsAttrName);
-                                    nW = wsAttrName.tointeger();
+					double dAlpha = sin(-15 * M_PI / 180);
+					double pTransform[] ={ 1, 0, dAlpha, 1, -dAlpha * oGlyph.dY, 0 };
+					pState->PushTransform(pTransform);
+				}
 
-									ReadAttribute(oReader, L"Height", wsAttrName);
-                                    nH = wsAttrName.tointeger();
-									break;
-								}
-							}
-						}
-						break;
-					}
+				DrawGlyphText(pRenderer, oGlyph, xpsUnitToMM(oGlyph.dX), xpsUnitToMM(oGlyph.dY), pGlyphs->bNeedBold);
+
+				if (pGlyphs->bNeedItalic)
+					pState->PopTransform();
+			}
+			else
+			{
+				if (pGlyphs->bNeedItalic)
+				{
+					double dAlpha = sin(15 * M_PI / 180);
+					double pTransform[] ={ 1, dAlpha, 0, 1, 0, -dAlpha * oGlyph.dX };
+					pState->PushTransform(pTransform);
 				}
+				double pTransform[] ={ 0, -1, 1, 0, oGlyph.dX + oGlyph.dShiftX, oGlyph.dY + oGlyph.dShiftY };
+				pState->PushTransform(pTransform);
+
+				DrawGlyphText(pRenderer, oGlyph, 0, 0, pGlyphs->bNeedBold);
+
+				pState->PopTransform();
+
+				if (pGlyphs->bNeedItalic)
+					pState->PopTransform();
 			}
 		}
-		else if (wsNodeName == L"FixedPage")
+
+		if (pGlyphs->bClip)
+			pState->PopClip();
+
+		if (pGlyphs->bTransform)
+			pState->PopTransform();
+	}
+	void CPageDisplayList::DrawPath(const TPath* pPath, IRenderer* pRenderer, CContextState* pState) const
+	{
+		if (pPath->bStroke)
 		{
-			ReadAttribute(oReader, L"Width", wsAttrName);
-            nW = wsAttrName.tointeger();
+			pRenderer->put_PenColor(pPath->lPenColor);
+			pRenderer->put_PenAlpha(pPath->lPenAlpha);
+		}
+
+		bool bFill = false;
+		if (pPath->pBrush)
+			bFill = pPath->pBrush->SetToRenderer(pRenderer);
+
+		// Сначала задается матрица преобразования, потом клип, потому что даже
+		// если преобразование задано в дочерней ноде, а клип задан в атрибутах данной ноды,
+		// то преобразование влияется на клип все равно.
+		if (pPath->bTransform)
+			pState->PushTransform(pPath->arrTransform);
+
+		if (pPath->bClip)
+			pState->PushClip(pPath->oClip);
 
-			ReadAttribute(oReader, L"Height", wsAttrName);
-            nH = wsAttrName.tointeger();
+		if (!pPath->vDashPattern.empty())
+		{
+			pRenderer->put_PenDashStyle(Aggplus::DashStyleCustom);
+			pRenderer->PenDashPattern((double*)pPath->vDashPattern.data(), (LONG)pPath->vDashPattern.size());
+			pRenderer->put_PenDashOffset(pPath->dDashOffset);
+			pRenderer->put_PenLineStartCap(pPath->nDashCap);
+			pRenderer->put_PenLineEndCap(pPath->nDashCap);
+		}
+		else
+		{
+			pRenderer->put_PenDashStyle(Aggplus::DashStyleSolid);
+			pRenderer->put_PenLineStartCap(pPath->nStartCap);
+			pRenderer->put_PenLineEndCap(pPath->nEndCap);
 		}
+
+		pRenderer->put_PenLineJoin(pPath->nJoinStyle);
+		if (pPath->nJoinStyle == Aggplus::LineJoinMiter)
+			pRenderer->put_PenMiterLimit(pPath->dMiter);
+		pRenderer->put_PenSize(pPath->dPenSize);
+
+		pRenderer->BeginCommand(c_nPathType);
+		pRenderer->PathCommandStart();
+
+		if (pPath->bPathTransform)
+			pState->PushTransform(pPath->arrPathTransform);
+
+		bool bWindingFillMode = pPath->oPath.ToRenderer(pRenderer);
+
+		int nMode = pPath->bStroke ? c_nStroke : 0;
+		if (bFill)
+			nMode |= (bWindingFillMode ? c_nWindingFillMode : c_nEvenOddFillMode);
+
+		pRenderer->DrawPath(nMode);
+
+		pRenderer->EndCommand(c_nPathType);
+		pRenderer->PathCommandEnd();
+
+		if (pPath->bPathTransform)
+			pState->PopTransform();
+
+		if (pPath->bTransform)
+			pState->PopTransform();
+
+		if (pPath->bClip)
+			pState->PopClip();
 	}
-	void Page::Draw(IRenderer* pRenderer, bool* pbBreak)
+
+    Page::Page(const std::wstring& wsPagePath, IFolder* wsRootPath, CFontList* pFontList, NSFonts::IFontManager* pFontManager, CDocument* pDocument)
 	{
-		XmlUtils::CXmlLiteReader oReader;
+		m_wsPagePath   = wsPagePath;
+		m_wsRootPath   = wsRootPath;
+		m_pFontList    = pFontList;
+		m_pFontManager = pFontManager;
+		m_pDocument    = pDocument;
+		m_bSize        = false;
+		m_nWidth       = 0;
+		m_nHeight      = 0;
+	}
+	Page::~Page()
+	{
+	}
+	void Page::GetSize(int& nW, int& nH) const
+	{
+		if (!m_bSize)
+		{
+			XmlUtils::CXmlLiteReader oReader;
+			if (!oReader.FromStringA(m_wsRootPath->readXml(m_wsPagePath)) || !ReadFixedPage(oReader))
+				return;
 
-		if (!oReader.FromStringA(m_wsRootPath->readXml(m_wsPagePath)))
-			return;
+			ReadSize(oReader);
+		}
+
+		nW = m_nWidth;
+		nH = m_nHeight;
+	}
+	void Page::Draw(IRenderer* pRenderer, bool* pbBreak)
+	{
+		std::shared_ptr<CPageDisplayList> pDisplayList = GetDisplayList();
+		if (pDisplayList)
+			pDisplayList->Draw(pRenderer, pbBreak);
+	}
+	std::shared_ptr<CPageDisplayList> Page::GetDisplayList()
+	{
+		if (!m_pDisplayList)
+			Compile();
 
+		return m_pDisplayList;
+	}
+	bool Page::IsCompiled() const
+	{
+		return !!m_pDisplayList;
+	}
+	void Page::ReleaseDisplayList()
+	{
+		m_pDisplayList.reset();
+	}
+	bool Page::ReadFixedPage(XmlUtils::CXmlLiteReader& oReader) const
+	{
 		if (!oReader.ReadNextNode())
-			return;
+			return false;
 
-		CContextState oState(pRenderer);
 		CWString wsNodeName = oReader.GetNameNoNS();
 		if (wsNodeName == L"AlternateContent")
 		{
@@ -196,15 +414,11 @@ namespace XPS
 								int nAltDepth2 = oReader.GetDepth();
 								while (oReader.ReadNextSiblingNode(nAltDepth2))
 								{
-									wsNodeName = oReader.GetNameNoNS();
-									if (wsNodeName == L"FixedPage")
-									{
-										DrawCanvas(oReader, pRenderer, &oState, pbBreak);
-										break;
-									}
+									if (oReader.GetNameNoNS() == L"FixedPage")
+										return true;
 								}
 							}
-							break;
+							return false;
 						}
 					}
 					else if (wsNodeName == L"Fallback")
@@ -214,25 +428,51 @@ namespace XPS
 							int nAltDepth2 = oReader.GetDepth();
 							while (oReader.ReadNextSiblingNode(nAltDepth2))
 							{
-								wsNodeName = oReader.GetNameNoNS();
-								if (wsNodeName == L"FixedPage")
-								{
-									DrawCanvas(oReader, pRenderer, &oState, pbBreak);
-									break;
-								}
+								if (oReader.GetNameNoNS() == L"FixedPage")
+									return true;
 							}
 						}
-						break;
+						return false;
 					}
 				}
 			}
+			return false;
 		}
-		else if (wsNodeName == L"FixedPage")
-		{
-			DrawCanvas(oReader, pRenderer, &oState, pbBreak);
-		}
+
+		return (wsNodeName == L"FixedPage");
+	}
+	void Page::ReadSize(XmlUtils::CXmlLiteReader& oReader) const
+	{
+		CWString wsAttrName;
+		ReadAttribute(oReader, L"Width", wsAttrName);
+		m_nWidth = wsAttrName.tointeger();
+
+		ReadAttribute(oReader, L"Height", wsAttrName);
+		m_nHeight = wsAttrName.tointeger();
+
+		m_bSize = true;
 	}
-	void Page::DrawCanvas(XmlUtils::CXmlLiteReader& oReader, IRenderer* pRenderer, CContextState* pState, bool* pbBreak)
+	void Page::Compile()
+	{
+		XmlUtils::CXmlLiteReader oReader;
+		if (!oReader.FromStringA(m_wsRootPath->readXml(m_wsPagePath)) || !ReadFixedPage(oReader))
+			return;
+
+		if (!m_bSize)
+			ReadSize(oReader);
+
+		// ссылки и координаты закладок заполняются при разборе страницы
+		m_oLinks.m_arLinks.clear();
+
+		std::shared_ptr<CPageDisplayList> pDisplayList(new CPageDisplayList());
+
+		// рендерера нет, состояние нужно только для ресурсов, прозрачности и текущей матрицы
+		CContextState oState(NULL);
+		CompileCanvas(oReader, &oState, pDisplayList.get());
+
+		m_pDisplayList = pDisplayList;
+	}
+	void Page::CompileCanvas(XmlUtils::CXmlLiteReader& oReader, CContextState* pState, CPageDisplayList* pList)
 	{
 		bool bTransform = false, bClip = false, bOpacity = false, bResource = false;
 		if (oReader.MoveToFirstAttribute())
@@ -241,9 +481,19 @@ namespace XPS
 			while (!wsAttrName.empty())
 			{
                 if (wsAttrName == "Clip")
-                    bClip = ClipToRenderer(oReader.GetText().c_str(), pState);
+				{
+					CPathData oClip;
+					bClip = CompileClip(oReader.GetText().c_str(), pState, oClip);
+					if (bClip)
+						pList->PushClip(oClip);
+				}
                 else if (wsAttrName == "RenderTransform")
-                    bTransform = TransformToRenderer(oReader.GetText().c_str(), pState);
+				{
+					double arrTransform[6];
+					bTransform = CompileTransform(oReader.GetText().c_str(), pState, arrTransform);
+					if (bTransform)
+						pList->PushTransform(arrTransform);
+				}
                 else if (wsAttrName == "Opacity")
 				{
 					pState->PushOpacity(GetDouble(oReader.GetText()));
@@ -269,35 +519,43 @@ namespace XPS
 
 			if (wsNodeName == L"FixedPage.Resources")
 			{
-				bResource = ReadResource(oReader, pRenderer, pState);
+				bResource = ReadResource(oReader, pState, pList);
 			}
 			else if (wsNodeName == L"Canvas.Resources")
 			{
-				bResource = ReadResource(oReader, pRenderer, pState);
+				bResource = ReadResource(oReader, pState, pList);
 			}
 			else if (wsNodeName == L"Glyphs")
 			{
-				DrawGlyph(oReader, pRenderer, pState);
+				CompileGlyph(oReader, pState, pList);
 			}
 			else if (wsNodeName == L"Canvas")
 			{
-				DrawCanvas(oReader, pRenderer, pState, pbBreak);
+				CompileCanvas(oReader, pState, pList);
 			}
 			else if (wsNodeName == L"Canvas.RenderTransform" && !bTransform)
 			{
 				CWString wsTransform;
-				ReadTransform(oReader, wsTransform);
-				bTransform = TransformToRenderer(wsTransform.c_str(), pState);
+				XPS::ReadTransform(oReader, wsTransform);
+
+				double arrTransform[6];
+				bTransform = CompileTransform(wsTransform.c_str(), pState, arrTransform);
+				if (bTransform)
+					pList->PushTransform(arrTransform);
 			}
 			else if (wsNodeName == L"Canvas.Clip" && !bClip)
 			{
 				CWString wsClip;
-				ReadClip(oReader, wsClip);
-				bClip = ClipToRenderer(wsClip.c_str(), pState);
+				XPS::ReadClip(oReader, wsClip);
+
+				CPathData oClip;
+				bClip = CompileClip(wsClip.c_str(), pState, oClip);
+				if (bClip)
+					pList->PushClip(oClip);
 			}
 			else if (wsNodeName == L"Path")
 			{
-				DrawPath(oReader, pRenderer, pState);
+				CompilePath(oReader, pState, pList);
 			}
 			else if (wsNodeName == L"AlternateContent")
 			{
@@ -313,28 +571,28 @@ namespace XPS
 							ReadAttribute(oReader, L"Requires", wsAttr);
 							if (wsAttr == L"xps")
 							{
-								DrawCanvas(oReader, pRenderer, pState, NULL);
+								CompileCanvas(oReader, pState, pList);
 								break;
 							}
 						}
 						else if (wsNodeName == L"Fallback")
 						{
-							DrawCanvas(oReader, pRenderer, pState, NULL);
+							CompileCanvas(oReader, pState, pList);
 							break;
 						}
 					}
 				}
 			}
-
-			if (NULL != pbBreak && *pbBreak)
-				return;
-		}		
+		}
 
 		if (bClip)
-			pState->PopClip();
+			pList->PopClip();
 
 		if (bTransform)
+		{
 			pState->PopTransform();
+			pList->PopTransform();
+		}
 
 		if (bOpacity)
 			pState->PopOpacity();
@@ -342,7 +600,7 @@ namespace XPS
 		if (bResource)
 			pState->PopResource();
 	}
-	bool Page::ReadResource(XmlUtils::CXmlLiteReader& oReader, IRenderer* pRenderer, CContextState* pState)
+	bool Page::ReadResource(XmlUtils::CXmlLiteReader& oReader, CContextState* pState, CPageDisplayList* pList)
 	{
 		if (oReader.IsEmptyNode())
 			return false;
@@ -363,7 +621,10 @@ namespace XPS
 				}
 				else
 				{
-					pState->PushResource(new CStaticResource(oReader), true);
+					// кисти из ресурса используются при воспроизведении, поэтому ресурсом владеет список команд
+					CStaticResource* pResource = new CStaticResource(oReader);
+					pList->AddResource(pResource);
+					pState->PushResource(pResource, false);
 				}
 
 				return true;
@@ -372,7 +633,7 @@ namespace XPS
 
 		return false;
 	}
-	bool Page::ClipToRenderer(const wchar_t* wsString, CContextState* pState)
+	bool Page::CompileClip(const wchar_t* wsString, CContextState* pState, CPathData& oClip)
 	{
 		CWString wsClip;
 		wsClip.create(wsString, true);
@@ -384,12 +645,12 @@ namespace XPS
 				pState->GetPathGeometry(wsClip, wsClip, wsPathTransform);
 			}
 
-			pState->PushClip(wsClip);
+			VmlToPathData(wsClip, oClip);
 			return true;
 		}
 		return false;
 	}
-	bool Page::TransformToRenderer(const wchar_t* wsString, CContextState* pState)
+	bool Page::CompileTransform(const wchar_t* wsString, CContextState* pState, double arrTransform[6])
 	{
 		CWString wsTransform = wsString;
 
@@ -403,19 +664,21 @@ namespace XPS
             for (int nIndex = 0, nCount = std::min(6, (int)arrElements.size()); nIndex < nCount; nIndex++)
 				arrRes[nIndex] = GetDouble(arrElements[nIndex]);
 
+			for (int nIndex = 0; nIndex < 6; nIndex++)
+				arrTransform[nIndex] = arrRes[nIndex];
+
 			pState->PushTransform(arrRes);
 			return true;
 		}
 		return false;
 	}
-	void Page::DrawGlyph(XmlUtils::CXmlLiteReader& oReader, IRenderer* pRenderer, CContextState* pState)
+	void Page::CompileGlyph(XmlUtils::CXmlLiteReader& oReader, CContextState* pState, CPageDisplayList* pList)
 	{
 		double dFontSize = 10.0;
-		bool bTransform = false, bClip = false, bOpacity = false;
+		bool bOpacity = false;
 		double dX = 0;
 		double dY = 0;
 		std::wstring wsFontPath;
-		std::wstring wsIndicies;
 		int nBidiLevel = 0;
 		CWString wsClip, wsTransform;
 		unsigned short* pUtf16    = NULL;
@@ -428,6 +691,8 @@ namespace XPS
 		bool bForceItalic = false;
 		bool bForceBold   = false;
 
+		CPageDisplayList::TGlyphs* pGlyphs = pList->AddGlyphs();
+
 		if (oReader.MoveToFirstAttribute())
 		{
 			std::wstring wsAttrName = oReader.GetName();
@@ -471,7 +736,8 @@ namespace XPS
                         }
                     }
 					wsFontPath = NormalizePath(wsFontPath);
-					pRenderer->put_FontPath(wsFontPath);
+					pGlyphs->bFont      = true;
+					pGlyphs->wsFontPath = wsFontPath;
 				}
 				else if (wsAttrName == L"Opacity")
 				{
@@ -542,7 +808,6 @@ namespace XPS
 				else if (L"Indices" == wsAttrName)
 				{
 					wsIndices.create(oReader.GetText(), true);
-					wsIndicies = oReader.GetText();
 				}
 				else if (L"BidiLevel" == wsAttrName)
 				{
@@ -562,18 +827,16 @@ namespace XPS
 		oReader.MoveToElement();
 
 		CBrush* pBrush = NULL;
-		bool bDeleteBrush = false;
 		if (!wsFill.empty())
 		{
 			if (IsFromResource(wsFill))
 			{
 				pBrush = pState->GetBrush(wsFill);
-				bDeleteBrush = false;
 			}
 			else
 			{
 				pBrush = ReadBrush(wsFill.c_str(), pState->GetCurrentOpacity());
-				bDeleteBrush = true;
+				pList->AddBrush(pBrush);
 			}
 		}
 
@@ -586,29 +849,21 @@ namespace XPS
 				wsNodeName = oReader.GetNameNoNS();
 				if (wsNodeName == L"Glyphs.RenderTransform")
 				{
-					ReadTransform(oReader, wsTransform);
+					XPS::ReadTransform(oReader, wsTransform);
 				}
 				else if (wsNodeName == L"Glyphs.Fill" && !pBrush)
 				{
 					pBrush = ReadBrush(oReader, pState->GetCurrentOpacity());
-					bDeleteBrush = true;
+					pList->AddBrush(pBrush);
 				}
 			}
 		}
 
-		if (!pBrush || !pBrush->SetToRenderer(pRenderer))
+		pGlyphs->pBrush = pBrush;
+		if (!pBrush)
 		{
-			if (bDeleteBrush)
-				RELEASEOBJECT(pBrush);
-
 			RELEASEARRAYOBJECTS(pUtf16Ptr);
 
-			if (bClip)
-				pState->PopClip();
-
-			if (bTransform)
-				pState->PopTransform();
-
 			if (bOpacity)
 				pState->PopOpacity();
 
@@ -620,7 +875,7 @@ namespace XPS
 		// то преобразование влияется на клип все равно.
 		if (!wsTransform.empty())
 		{
-			bTransform = TransformToRenderer(wsTransform.c_str(), pState);
+			pGlyphs->bTransform = CompileTransform(wsTransform.c_str(), pState, pGlyphs->arrTransform);
 			if (dFontSize < 5)
 			{
 				double dDet = pState->NormalizeTransform();
@@ -630,10 +885,10 @@ namespace XPS
 
 		if (!wsClip.empty())
 		{
-			bClip = ClipToRenderer(wsClip.c_str(), pState);
+			pGlyphs->bClip = CompileClip(wsClip.c_str(), pState, pGlyphs->oClip);
 		}
 
-		pRenderer->put_FontSize(dFontSize * 0.75);
+		pGlyphs->dFontSize = dFontSize;
 
 		TIndicesEntry oEntry;
 		int nIndicesPos = 0, nIndicesLen = wsIndices.size();
@@ -653,25 +908,17 @@ namespace XPS
 
 		double dFontKoef = dFontSize / 100.0;
 
-		bool bNeedItalic = false, bNeedBold = false, bChangeFont = true;
         NSFonts::IFontFile* pFile = m_pFontManager->GetFile();
         if (pFile)
 		{
             if (!pFile->IsItalic() && bForceItalic)
-				bNeedItalic = true;
+				pGlyphs->bNeedItalic = true;
 
             if (!pFile->IsBold() && bForceBold)
-			{
-				LONG lTextColor, lTextAlpha;
-				pRenderer->get_BrushColor1(&lTextColor);
-				pRenderer->get_BrushAlpha1(&lTextAlpha);
-				pRenderer->put_PenColor(lTextColor);
-				pRenderer->put_PenAlpha(lTextAlpha);
-				pRenderer->put_PenSize(xpsUnitToMM(1));
-				bNeedBold = true;
-			}
+				pGlyphs->bNeedBold = true;
 		}
 
+		pGlyphs->bSideways = bIsSideways;
 		if (!bIsSideways)
 		{
 			while (GetNextGlyph(wsIndices.c_str(), nIndicesPos, nIndicesLen, pUtf16, nUtf16Pos, unUtf16Len, oEntry))
@@ -695,47 +942,15 @@ namespace XPS
 				if (bRtoL)
 					dX -= dRealAdvance;
 
-				double dXorigin = (oEntry.bHorOffset || oEntry.bVerOffset) ? dX + (bRtoL ? -oEntry.dHorOffset * dFontKoef : oEntry.dHorOffset * dFontKoef) : dX;
-				double dYorigin = (oEntry.bHorOffset || oEntry.bVerOffset) ? dY - oEntry.dVerOffset * dFontKoef : dY;	
-
-				if (bNeedItalic)
-				{
-					double dAlpha = sin(-15 * M_PI / 180);
-					double pTransform[] ={ 1, 0, dAlpha, 1, -dAlpha * dYorigin, 0 };
-					pState->PushTransform(pTransform);
-				}
-
-				if (oEntry.bGid)
-                {
-					pRenderer->CommandDrawTextExCHAR(oEntry.nUnicode, oEntry.nGid, xpsUnitToMM(dXorigin), xpsUnitToMM(dYorigin), 0, 0);
-                }
-				else
-                {
-                    LONG nRenType = 0;
-                    pRenderer->get_Type(&nRenType);
-                    if (c_nGrRenderer == nRenType)
-                        pRenderer->put_FontStringGID(FALSE);
-
-                    pRenderer->CommandDrawTextCHAR(oEntry.nUnicode,  xpsUnitToMM(dXorigin), xpsUnitToMM(dYorigin), 0, 0);
-                }
-
-				if (bNeedBold)
-				{
-					pRenderer->BeginCommand(c_nPathType);
-					pRenderer->PathCommandStart();
-
-					if (oEntry.bGid)
-						pRenderer->PathCommandTextExCHAR(oEntry.nUnicode, oEntry.nGid, xpsUnitToMM(dXorigin), xpsUnitToMM(dYorigin), 0, 0);
-					else
-						pRenderer->PathCommandTextCHAR(oEntry.nUnicode, xpsUnitToMM(dXorigin), xpsUnitToMM(dYorigin), 0, 0);
-
-					pRenderer->DrawPath(c_nStroke);
-					pRenderer->EndCommand(c_nPathType);
-					pRenderer->PathCommandEnd();
-				}
-
-				if (bNeedItalic)
-					pState->PopTransform();
+				CPageDisplayList::TGlyph oGlyph;
+				oGlyph.nUnicode = oEntry.nUnicode;
+				oGlyph.nGid     = oEntry.nGid;
+				oGlyph.bGid     = oEntry.bGid;
+				oGlyph.dX       = (oEntry.bHorOffset || oEntry.bVerOffset) ? dX + (bRtoL ? -oEntry.dHorOffset * dFontKoef : oEntry.dHorOffset * dFontKoef) : dX;
+				oGlyph.dY       = (oEntry.bHorOffset || oEntry.bVerOffset) ? dY - oEntry.dVerOffset * dFontKoef : dY;
+				oGlyph.dShiftX  = 0;
+				oGlyph.dShiftY  = 0;
+				pGlyphs->vGlyphs.push_back(oGlyph);
 
 				if (!bRtoL)
 					dX += dAdvance;
@@ -756,74 +971,35 @@ namespace XPS
 				else
 					dAdvance = dAdvanceY;
 
-				double dXorigin = (oEntry.bHorOffset || oEntry.bVerOffset) ? dX + oEntry.dHorOffset * dFontKoef : dX;
-				double dYorigin = (oEntry.bHorOffset || oEntry.bVerOffset) ? dY - oEntry.dVerOffset * dFontKoef : dY;
-				if (bNeedItalic)
-				{
-					double dAlpha = sin(15 * M_PI / 180);
-					double pTransform[] ={ 1, dAlpha, 0, 1, 0, -dAlpha * dXorigin };
-					pState->PushTransform(pTransform);
-				}
-				double pTransform[] ={ 0, -1, 1, 0, dXorigin + dAdvanceY, dYorigin + dAdvanceX / 2 };
-				pState->PushTransform(pTransform);
-
-				if (oEntry.bGid)
-                {
-					pRenderer->CommandDrawTextExCHAR(oEntry.nUnicode, oEntry.nGid, 0, 0, 0, 0);
-                }
-				else
-                {
-					pRenderer->CommandDrawTextCHAR(oEntry.nUnicode, 0, 0, 0, 0);
-                }
-
-				if (bNeedBold)
-				{
-					pRenderer->BeginCommand(c_nPathType);
-					pRenderer->PathCommandStart();
-
-					if (oEntry.bGid)
-						pRenderer->PathCommandTextExCHAR(oEntry.nUnicode, oEntry.nGid, 0, 0, 0, 0);
-					else
-						pRenderer->PathCommandTextCHAR(oEntry.nUnicode, 0, 0, 0, 0);
-
-					pRenderer->DrawPath(c_nStroke);
-					pRenderer->EndCommand(c_nPathType);
-					pRenderer->PathCommandEnd();
-				}
-
-				pState->PopTransform();
-
-				if (bNeedItalic)
-					pState->PopTransform();
+				CPageDisplayList::TGlyph oGlyph;
+				oGlyph.nUnicode = oEntry.nUnicode;
+				oGlyph.nGid     = oEntry.nGid;
+				oGlyph.bGid     = oEntry.bGid;
+				oGlyph.dX       = (oEntry.bHorOffset || oEntry.bVerOffset) ? dX + oEntry.dHorOffset * dFontKoef : dX;
+				oGlyph.dY       = (oEntry.bHorOffset || oEntry.bVerOffset) ? dY - oEntry.dVerOffset * dFontKoef : dY;
+				oGlyph.dShiftX  = dAdvanceY;
+				oGlyph.dShiftY  = dAdvanceX / 2;
+				pGlyphs->vGlyphs.push_back(oGlyph);
 
 				dX += dAdvance;
 			}
 		}
 
-		if (bDeleteBrush)
-			RELEASEOBJECT(pBrush);
-
 		RELEASEARRAYOBJECTS(pUtf16Ptr);
 
-		if (bClip)
-			pState->PopClip();
-
-		if (bTransform)
+		if (pGlyphs->bTransform)
 			pState->PopTransform();
 
 		if (bOpacity)
 			pState->PopOpacity();
 	}
-	void Page::DrawPath(XmlUtils::CXmlLiteReader& oReader, IRenderer* pRenderer, CContextState* pState)
+	void Page::CompilePath(XmlUtils::CXmlLiteReader& oReader, CContextState* pState, CPageDisplayList* pList)
 	{
-		bool bTransform = false, bClip = false, bOpacity = false;
+		bool bOpacity = false;
 
 		double dPenSize = 1.0;
 
-		bool bStroke = false;
-		bool bFill   = false;
-
-		int nFillBgr = 0, nFillAlpha = 255, nStrokeBgr = 0, nStrokeAlpha = 255;
+		int nStrokeBgr = 0, nStrokeAlpha = 255;
 
 		BYTE nDashCap   = Aggplus::LineCapFlat;
 		BYTE nStartCap  = Aggplus::LineCapFlat;
@@ -831,18 +1007,19 @@ namespace XPS
 		BYTE nJoinStyle = Aggplus::LineJoinMiter;
 		double dMiter   = 10.0;
 
-		double* pDashPattern  = NULL;
-		LONG lDashPatternSize = 0;
-		double dDashOffset    = 0.0;
+		std::vector<double> vDashPattern;
+		double dDashOffset = 0.0;
 		CWString wsFill;
 
+		CPageDisplayList::TPath* pPath = pList->AddPath();
+
 		CWString wsClip, wsTransform, wsPathData, wsPathTransform;
 		std::vector<CDocument::CDocumentStructure>::iterator find = m_pDocument->m_vStructure.end();
 		if (oReader.MoveToFirstAttribute())
 		{
 			std::wstring wsAttrName = oReader.GetName();
 			while (!wsAttrName.empty())
-			{				
+			{
 				if (L"RenderTransform" == wsAttrName)
 				{
 					wsTransform.create(oReader.GetText(), true);
@@ -862,7 +1039,7 @@ namespace XPS
 				{
 					std::wstring wsStrokeColor = oReader.GetText();
 					GetBgra(wsStrokeColor, nStrokeBgr, nStrokeAlpha);
-					bStroke = true;
+					pPath->bStroke = true;
 				}
 				else if (L"StrokeThickness" == wsAttrName)
 				{
@@ -873,19 +1050,9 @@ namespace XPS
 				{
 					std::wstring wsDashArray = oReader.GetText();
 					std::vector<std::wstring> arrDashArray = NSStringExt::Split(wsDashArray, ' ');
-					int nDashArrayCount = arrDashArray.size();
-					if (nDashArrayCount > 0)
-					{
-						pDashPattern = new double[nDashArrayCount];
-						if (pDashPattern)
-						{
-							lDashPatternSize = nDashArrayCount;
-							for (int nIndex = 0; nIndex < nDashArrayCount; nIndex++)
-							{
-								pDashPattern[nIndex] = GetDouble(arrDashArray.at(nIndex));
-							}
-						}
-					}
+					vDashPattern.clear();
+					for (int nIndex = 0, nDashArrayCount = arrDashArray.size(); nIndex < nDashArrayCount; nIndex++)
+						vDashPattern.push_back(GetDouble(arrDashArray.at(nIndex)));
 				}
 				else if (L"StrokeDashOffset" == wsAttrName)
 				{
@@ -934,9 +1101,9 @@ namespace XPS
 				}
 				else if (L"FixedPage.NavigateUri" == wsAttrName)
 				{
-					double pdA, pdB, pdC, pdD, pdE, pdF;
-					pRenderer->GetTransform(&pdA, &pdB, &pdC, &pdD, &pdE, &pdF);
-					Aggplus::CMatrix oTransform(pdA, pdB, pdC, pdD, pdE, pdF);
+					// та же матрица, что была бы выставлена в рендерер на этот момент
+					Aggplus::CMatrix oCurrent = pState->GetCurrentTransform();
+					Aggplus::CMatrix oTransform(oCurrent.sx(), oCurrent.shy(), oCurrent.shx(), oCurrent.sy(), xpsUnitToMM(oCurrent.tx()), xpsUnitToMM(oCurrent.ty()));
 					double x1 = 0, y1 = 0, x2 = 0, y2 = 0, x3 = 0, y3 = 0;
 
                     NSWasm::CPageLinkItem oLink = {"", 0, 0, 0, 0, 0};
@@ -1035,25 +1202,23 @@ namespace XPS
 		}
 
 		CBrush* pBrush = NULL;
-		bool bDeleteBrush = false;
 		if (!wsFill.empty())
 		{
 			if (IsFromResource(wsFill))
 			{
 				pBrush = pState->GetBrush(wsFill);
-				bDeleteBrush = false;
 			}
 			else
 			{
 				pBrush = ReadBrush(wsFill.c_str(), pState->GetCurrentOpacity());
-				bDeleteBrush = true;
+				pList->AddBrush(pBrush);
 			}
 		}
 
-		if (bStroke)
+		if (pPath->bStroke)
 		{
-			pRenderer->put_PenColor(nStrokeBgr & 0x00FFFFFF);
-			pRenderer->put_PenAlpha(nStrokeAlpha * pState->GetCurrentOpacity());
+			pPath->lPenColor = nStrokeBgr & 0x00FFFFFF;
+			pPath->lPenAlpha = nStrokeAlpha * pState->GetCurrentOpacity();
 		}
 
 		if (!oReader.IsEmptyNode())
@@ -1065,20 +1230,20 @@ namespace XPS
 				wsNodeName = oReader.GetNameNoNS();
 				if (wsNodeName == L"Path.RenderTransform")
 				{
-					ReadTransform(oReader, wsTransform);
+					XPS::ReadTransform(oReader, wsTransform);
 				}
 				else if (wsNodeName == L"Path.Clip")
 				{
-					ReadClip(oReader, wsClip);
+					XPS::ReadClip(oReader, wsClip);
 				}
 				else if (wsNodeName == L"Path.Fill" && !pBrush)
 				{
 					pBrush = ReadBrush(oReader, pState->GetCurrentOpacity());
-					bDeleteBrush = true;
+					pList->AddBrush(pBrush);
 				}
-				else if (wsNodeName == L"Path.Stroke" && !bStroke)
+				else if (wsNodeName == L"Path.Stroke" && !pPath->bStroke)
 				{
-					bStroke = StrokeToRenderer(oReader, pRenderer, pState);
+					pPath->bStroke = ReadStroke(oReader, pState, pPath);
 				}
 				else if (wsNodeName == L"Path.Data" && wsPathData.empty())
 				{
@@ -1087,89 +1252,51 @@ namespace XPS
 			}
 		}
 
-		if (pBrush)
-		{
-			if (pBrush->IsImageBrush())
-				((CImageBrush*)pBrush)->SetPaths(m_wsRootPath, GetPath(m_wsPagePath).c_str());
-
-			bFill = pBrush->SetToRenderer(pRenderer);
-			if (bDeleteBrush)
-				RELEASEOBJECT(pBrush);
-		}
+		if (pBrush && pBrush->IsImageBrush())
+			((CImageBrush*)pBrush)->SetPaths(m_wsRootPath, GetPath(m_wsPagePath).c_str());
+		pPath->pBrush = pBrush;
 
-		// Сначала задается матрица преобразования, потом клип, потому что даже
-		// если преобразование задано в дочерней ноде, а клип задан в атрибутах данной ноды,
-		// то преобразование влияется на клип все равно.
 		if (!wsTransform.empty())
 		{
-			bTransform = TransformToRenderer(wsTransform.c_str(), pState);
+			pPath->bTransform = CompileTransform(wsTransform.c_str(), pState, pPath->arrTransform);
 		}
 
 		if (!wsClip.empty())
 		{
-			bClip = ClipToRenderer(wsClip.c_str(), pState);
+			pPath->bClip = CompileClip(wsClip.c_str(), pState, pPath->oClip);
 		}
 
-		if (pDashPattern)
-		{
-			for (LONG lIndex = 0; lIndex < lDashPatternSize; lIndex++)
-			{
-				pDashPattern[lIndex] = xpsUnitToMM(pDashPattern[lIndex] * dPenSize);
-			}
+		for (size_t nIndex = 0, nCount = vDashPattern.size(); nIndex < nCount; nIndex++)
+			vDashPattern[nIndex] = xpsUnitToMM(vDashPattern[nIndex] * dPenSize);
 
-			pRenderer->put_PenDashStyle(Aggplus::DashStyleCustom);
-			pRenderer->PenDashPattern(pDashPattern, lDashPatternSize);
-			pRenderer->put_PenDashOffset(xpsUnitToMM(dDashOffset * dPenSize));
-			pRenderer->put_PenLineStartCap(nDashCap);
-			pRenderer->put_PenLineEndCap(nDashCap);
-			delete[] pDashPattern;
-		}
-		else
-		{
-			pRenderer->put_PenDashStyle(Aggplus::DashStyleSolid);
-			pRenderer->put_PenLineStartCap(nStartCap);
-			pRenderer->put_PenLineEndCap(nEndCap);
-		}
-
-		pRenderer->put_PenLineJoin(nJoinStyle);
-		if (nJoinStyle == Aggplus::LineJoinMiter)
-			pRenderer->put_PenMiterLimit(xpsUnitToMM(dMiter));
-		pRenderer->put_PenSize(xpsUnitToMM(dPenSize));
-
-		pRenderer->BeginCommand(c_nPathType);
-		pRenderer->PathCommandStart();
+		pPath->vDashPattern = vDashPattern;
+		pPath->dDashOffset  = xpsUnitToMM(dDashOffset * dPenSize);
+		pPath->nDashCap     = nDashCap;
+		pPath->nStartCap    = nStartCap;
+		pPath->nEndCap      = nEndCap;
+		pPath->nJoinStyle   = nJoinStyle;
+		pPath->dMiter       = xpsUnitToMM(dMiter);
+		pPath->dPenSize     = xpsUnitToMM(dPenSize);
 
 		if (IsFromResource(wsPathData))
 			pState->GetPathGeometry(wsPathData, wsPathData, wsPathTransform);
 
-		bool bPathTransform = false;
 		if (!wsPathTransform.empty())
-			bPathTransform = TransformToRenderer(wsPathTransform.c_str(), pState);
-
-		bool bWindingFillMode = VmlToRenderer(wsPathData, pRenderer);
-
-		int nMode = bStroke ? c_nStroke : 0;
-		if (bFill)
-			nMode |= (bWindingFillMode ? c_nWindingFillMode : c_nEvenOddFillMode);
-
-		pRenderer->DrawPath(nMode);
-
-		pRenderer->EndCommand(c_nPathType);
-		pRenderer->PathCommandEnd();
+		{
+			pPath->bPathTransform = CompileTransform(wsPathTransform.c_str(), pState, pPath->arrPathTransform);
+			if (pPath->bPathTransform)
+				pState->PopTransform();
+		}
 
-		if (bPathTransform)
-			pState->PopTransform();
+		VmlToPathData(wsPathData, pPath->oPath);
 
-		if (bTransform)
+		if (pPath->bTransform)
 			pState->PopTransform();
 
-		if (bClip)
-			pState->PopClip();
-
 		if (bOpacity)
 			pState->PopOpacity();
-	}	
-	bool Page::StrokeToRenderer(XmlUtils::CXmlLiteReader& oReader, IRenderer* pRenderer, CContextState* pState)
+	}
+	bool Page::ReadStroke(XmlUtils::CXmlLiteReader& oReader, CContextState* pState, CPageDisplayList::TPath* pPath)
 	{
 		if (!oReader.IsEmptyNode())
 		{
@@ -1184,8 +1311,8 @@ namespace XPS
 					std::wstring wsColor;
 					ReadAttribute(oReader, L"Color", wsColor);
 					GetBgra(wsColor, nBgr, nAlpha);
-					pRenderer->put_PenColor(nBgr & 0x00FFFFFF);
-					pRenderer->put_PenAlpha((double)nAlpha * pState->GetCurrentOpacity());
+					pPath->lPenColor = nBgr & 0x00FFFFFF;
+					pPath->lPenAlpha = (double)nAlpha * pState->GetCurrentOpacity();
 					return true;
 				}
 			}
@@ -41,10 +41,123 @@
 
 #include "../../DesktopEditor/graphics/pro/js/wasm/src/serialize.h"
 
+#include <memory>
+
 namespace XPS
 {
 	class CDocument;
 	class CStaticResource;
+	class CBrush;
+
+	// Скомпилированная страница: геометрия, трансформы, кисти и шрифты уже разобраны,
+	// Draw только воспроизводит команды в рендерер
+	class CPageDisplayList
+	{
+	public:
+
+		struct TGlyph
+		{
+			unsigned int   nUnicode;
+			unsigned short nGid;
+			bool           bGid;
+			double         dX;
+			double         dY;
+			double         dShiftX; // для IsSideways
+			double         dShiftY;
+		};
+		struct TGlyphs
+		{
+			TGlyphs() : pBrush(NULL), bFont(false), dFontSize(10.0), bTransform(false), bClip(false), bSideways(false), bNeedItalic(false), bNeedBold(false)
+			{
+			}
+
+			CBrush*             pBrush;
+			bool                bFont;
+			std::wstring        wsFontPath;
+			double              dFontSize;
+			bool                bTransform;
+			double              arrTransform[6];
+			bool                bClip;
+			CPathData           oClip;
+			bool                bSideways;
+			bool                bNeedItalic;
+			bool                bNeedBold;
+			std::vector<TGlyph> vGlyphs;
+		};
+		struct TPath
+		{
+			TPath() : pBrush(NULL), bStroke(false), lPenColor(0), lPenAlpha(255), bTransform(false), bClip(false), dDashOffset(0.0),
+				nDashCap(0), nStartCap(0), nEndCap(0), nJoinStyle(0), dMiter(0.0), dPenSize(0.0), bPathTransform(false)
+			{
+			}
+
+			CBrush*             pBrush;
+			bool                bStroke;
+			LONG                lPenColor;
+			LONG                lPenAlpha;
+			bool                bTransform;
+			double              arrTransform[6];
+			bool                bClip;
+			CPathData           oClip;
+			std::vector<double> vDashPattern; // уже в мм
+			double              dDashOffset;
+			BYTE                nDashCap;
+			BYTE                nStartCap;
+			BYTE                nEndCap;
+			BYTE                nJoinStyle;
+			double              dMiter;
+			double              dPenSize;
+			bool                bPathTransform;
+			double              arrPathTransform[6];
+			CPathData           oPath;
+		};
+
+	public:
+
+		CPageDisplayList();
+		~CPageDisplayList();
+
+		void PushTransform(const double arrTransform[6]);
+		void PopTransform();
+		void PushClip(const CPathData& oClip);
+		void PopClip();
+		TGlyphs* AddGlyphs();
+		TPath*   AddPath();
+		void AddBrush(CBrush* pBrush);
+		void AddResource(CStaticResource* pResource);
+
+		void Draw(IRenderer* pRenderer, bool* pbBreak) const;
+
+	private:
+
+		void DrawGlyphs(const TGlyphs* pGlyphs, IRenderer* pRenderer, CContextState* pState) const;
+		void DrawPath  (const TPath* pPath, IRenderer* pRenderer, CContextState* pState) const;
+
+	private:
+
+		enum ECommand
+		{
+			dcPushTransform = 0,
+			dcPopTransform  = 1,
+			dcPushClip      = 2,
+			dcPopClip       = 3,
+			dcGlyphs        = 4,
+			dcPath          = 5
+		};
+		struct TCommand
+		{
+			BYTE nType;
+			int  nIndex;
+		};
+
+		std::vector<TCommand>         m_vCommands;
+		std::vector<double>           m_vTransforms;
+		std::vector<CPathData>        m_vClips;
+		std::vector<TGlyphs*>         m_vGlyphs;
+		std::vector<TPath*>           m_vPaths;
+		std::vector<CBrush*>          m_vBrushes;
+		std::vector<CStaticResource*> m_vResources;
+	};
 
 	class Page
 	{
@@ -55,19 +168,28 @@ namespace XPS
 		void GetSize(int& nW, int& nH) const;
 		void Draw(IRenderer* pRenderer, bool* pbBreak);
 
+		// Разбор страницы выполняется один раз, повторные Draw только воспроизводят список команд
+		std::shared_ptr<CPageDisplayList> GetDisplayList();
+		bool IsCompiled() const;
+		void ReleaseDisplayList();
+
         NSWasm::CPageLink m_oLinks;
 
 	private:
 
-		void DrawCanvas      (XmlUtils::CXmlLiteReader& oReader, IRenderer* pRenderer, CContextState* pState, bool* pbBreak);
-		bool ReadResource    (XmlUtils::CXmlLiteReader& oReader, IRenderer* pRenderer, CContextState* pState);
-		void DrawGlyph       (XmlUtils::CXmlLiteReader& oReader, IRenderer* pRenderer, CContextState* pState);
-		void DrawPath        (XmlUtils::CXmlLiteReader& oReader, IRenderer* pRenderer, CContextState* pState);
-		bool StrokeToRenderer(XmlUtils::CXmlLiteReader& oReader, IRenderer* pRenderer, CContextState* pState);
+		bool ReadFixedPage   (XmlUtils::CXmlLiteReader& oReader) const;
+		void ReadSize        (XmlUtils::CXmlLiteReader& oReader) const;
+		void Compile();
+
+		void CompileCanvas   (XmlUtils::CXmlLiteReader& oReader, CContextState* pState, CPageDisplayList* pList);
+		bool ReadResource    (XmlUtils::CXmlLiteReader& oReader, CContextState* pState, CPageDisplayList* pList);
+		void CompileGlyph    (XmlUtils::CXmlLiteReader& oReader, CContextState* pState, CPageDisplayList* pList);
+		void CompilePath     (XmlUtils::CXmlLiteReader& oReader, CContextState* pState, CPageDisplayList* pList);
+		bool ReadStroke      (XmlUtils::CXmlLiteReader& oReader, CContextState* pState, CPageDisplayList::TPath* pPath);
 		void ReadPathData    (XmlUtils::CXmlLiteReader& oReader, CWString& wsData, CWString& wsTranform);
 		
-		bool ClipToRenderer     (const wchar_t* wsString, CContextState* pState);
-		bool TransformToRenderer(const wchar_t* wsString, CContextState* pState);
+		bool CompileClip     (const wchar_t* wsString, CContextState* pState, CPathData& oClip);
+		bool CompileTransform(const wchar_t* wsString, CContextState* pState, double arrTransform[6]);
 
 	private:
 
@@ -76,6 +198,12 @@ namespace XPS
         CFontList*              m_pFontList;
         NSFonts::IFontManager*  m_pFontManager;
         CDocument*              m_pDocument;
+
+		mutable bool            m_bSize;
+		mutable int             m_nWidth;
+		mutable int             m_nHeight;
+
+		std::shared_ptr<CPageDisplayList> m_pDisplayList;
 	};
 }
 